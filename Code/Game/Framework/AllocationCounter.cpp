@@ -0,0 +1,95 @@
+//----------------------------------------------------------------------------------------------------
+// AllocationCounter.cpp
+// Per-thread heap allocation counter (opt-in global operator new replacement)
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/AllocationCounter.hpp"
+
+#if defined(GAME_COUNT_ALLOCATIONS)
+
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    thread_local uint64_t t_allocationCount = 0;
+
+    void* CountedAllocate(size_t const size)
+    {
+        ++t_allocationCount;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* CountedAllocateAligned(size_t const size, std::align_val_t const alignment)
+    {
+        ++t_allocationCount;
+        return _aligned_malloc(size == 0 ? 1 : size, static_cast<size_t>(alignment));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t AllocationCounter::GetThreadAllocationCount()
+{
+    return t_allocationCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replacement global allocation functions
+//----------------------------------------------------------------------------------------------------
+void* operator new(size_t const size)
+{
+    if (void* ptr = CountedAllocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t const size)
+{
+    if (void* ptr = CountedAllocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t const size, std::nothrow_t const&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](size_t const size, std::nothrow_t const&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void* operator new(size_t const size, std::align_val_t const alignment)
+{
+    if (void* ptr = CountedAllocateAligned(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t const size, std::align_val_t const alignment)
+{
+    if (void* ptr = CountedAllocateAligned(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::nothrow_t const&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { _aligned_free(ptr); }
+
+#else
+
+//----------------------------------------------------------------------------------------------------
+uint64_t AllocationCounter::GetThreadAllocationCount()
+{
+    return 0;
+}
+
+#endif
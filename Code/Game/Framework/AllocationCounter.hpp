@@ -0,0 +1,53 @@
+//----------------------------------------------------------------------------------------------------
+// AllocationCounter.hpp
+// Per-thread heap allocation counter (opt-in global operator new replacement)
+//
+// Purpose:
+//   Lets hot paths such as RenderEntities() verify they stay allocation-free. When built with
+//   GAME_COUNT_ALLOCATIONS, the replacement operator new in AllocationCounter.cpp bumps a
+//   thread_local counter and forwards to the CRT heap; callers sample GetThreadAllocationCount()
+//   before and after the section they want to measure.
+//
+// Notes:
+//   - Profiling builds only: add GAME_COUNT_ALLOCATIONS to the Game project's preprocessor
+//     definitions. Without it the process keeps the CRT operator new/delete and every count is 0
+//   - Counts C++ operator new only (malloc and V8's own heap allocations are not seen)
+//   - thread_local, so measurements on the main thread are not disturbed by the JS worker
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+namespace AllocationCounter
+{
+    // Number of operator new calls made by the calling thread since it started (0 when disabled)
+    uint64_t GetThreadAllocationCount();
+
+    // True when built with GAME_COUNT_ALLOCATIONS
+    constexpr bool IsEnabled()
+    {
+#if defined(GAME_COUNT_ALLOCATIONS)
+        return true;
+#else
+        return false;
+#endif
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// sScopedAllocationCount
+//
+// Usage: sScopedAllocationCount scope; ... ; uint64_t n = scope.GetCount();
+//----------------------------------------------------------------------------------------------------
+struct sScopedAllocationCount
+{
+    sScopedAllocationCount() : m_start(AllocationCounter::GetThreadAllocationCount()) {}
+
+    uint64_t GetCount() const { return AllocationCounter::GetThreadAllocationCount() - m_start; }
+
+private:
+    uint64_t m_start = 0;
+};
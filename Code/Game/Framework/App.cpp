@@ -10,8 +10,32 @@
 #include "Game/Framework/App.hpp"
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Resource/MeshCache.hpp"
+#include "Game/Framework/AllocationCounter.hpp"
+#include "Game/Framework/AsyncModelLoader.hpp"
+#include "Game/Framework/AudioSourceBatcher.hpp"
+#include "Game/Framework/BenchmarkRunner.hpp"
+#include "Game/Framework/BinaryLogger.hpp"
+#include "Game/Framework/CallbackResultRing.hpp"
+#include "Game/Framework/DebugLayerRenderer.hpp"
+#include "Game/Framework/EntityBatchRenderer.hpp"
+#include "Game/Framework/EntitySnapshot.hpp"
+#include "Game/Framework/EntityStore.hpp"
+#include "Game/Framework/ExternalCommandQueue.hpp"
+#include "Game/Framework/FixedTimestepScheduler.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/GenericCommandDispatcher.hpp"
+#include "Game/Framework/GpuMeshCache.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/JSFramePipeline.hpp"
+#include "Game/Framework/JSFrameWatchdog.hpp"
+#include "Game/Framework/JSGCScheduler.hpp"
 #include "Game/Framework/JSGameLogicJob.hpp"
+#include "Game/Framework/JSWorkerPool.hpp"
+#include "Game/Framework/MeshHandleTable.hpp"
+#include "Game/Framework/ScriptHotReloader.hpp"
+#include "Game/Framework/StartupTimeline.hpp"
+#include "Game/Framework/StateRecorder.hpp"
+#include "Game/Framework/TypedCommandBuffer.hpp"
 #include "Game/Gameplay/Game.hpp"
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Audio/AudioStateBuffer.hpp"
@@ -50,7 +74,13 @@
 #include "Engine/UI/ImGuiSubsystem.hpp"
 #include "ThirdParty/json/json.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
 #include <optional>
+#include <sstream>
+#include <thread>
 
 
 //----------------------------------------------------------------------------------------------------
@@ -89,6 +119,23 @@ static std::string EscapeJsonString(std::string const& input)
     return escaped;
 }
 
+//----------------------------------------------------------------------------------------------------
+// True when the process command line has `flag` as a separate argument (e.g. "-benchmark")
+//----------------------------------------------------------------------------------------------------
+static bool HasCommandLineFlag(char const* flag)
+{
+    std::istringstream arguments(GetCommandLineA());
+    std::string        argument;
+    while (arguments >> argument)
+    {
+        if (_stricmp(argument.c_str(), flag) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 //----------------------------------------------------------------------------------------------------
 // Helper: Validate .js file path for security (shared by file operation handlers)
 // Returns empty string on success, or error JSON string on failure.
@@ -156,6 +203,22 @@ static std::optional<uint64_t> RequireEntityId(nlohmann::json const& json)
     return json.value("entityId", static_cast<uint64_t>(0));
 }
 
+//----------------------------------------------------------------------------------------------------
+// Helper: Error for commands that need a Renderer/GPU while running headless
+//----------------------------------------------------------------------------------------------------
+static HandlerResult MakeHeadlessError(char const* commandName)
+{
+    return HandlerResult::Error(Stringf("ERR_HEADLESS: %s requires a renderer (running headless)", commandName));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Helper: CommandQueue.submitStructured() token (0 = deliver resultJson as usual)
+//----------------------------------------------------------------------------------------------------
+static uint32_t GetResultToken(nlohmann::json const& json)
+{
+    return json.value("resultToken", 0u);
+}
+
 //----------------------------------------------------------------------------------------------------
 // Helper: Configure orthographic screen camera state
 //----------------------------------------------------------------------------------------------------
@@ -176,6 +239,149 @@ static void ConfigureScreenCamera(CameraState& state)
     state.viewport    = AABB2(Vec2::ZERO, Vec2::ONE);
 }
 
+//----------------------------------------------------------------------------------------------------
+// Helper: One game.capture_screenshot file written by the Renderer
+//
+// Requests in the same frame with the same format and quality (and no explicit filename) share a
+// capture. The file is read back and base64-encoded at most once, by whichever request first wants
+// the image; the last reference deletes the file unless some requester asked to keep it.
+//----------------------------------------------------------------------------------------------------
+struct sScreenshotCapture
+{
+    std::string filePath;
+    std::string format;
+    int         quality     = 90;
+    uint64_t    frameNumber = 0;
+    bool        isKeepFile  = true;
+
+    std::once_flag encodeOnce;
+    std::string    imageBase64;
+
+    ~sScreenshotCapture()
+    {
+        if (!isKeepFile)
+        {
+            std::error_code ec;
+            std::filesystem::remove(filePath, ec);
+        }
+    }
+};
+
+using ScreenshotCapturePtr = std::shared_ptr<sScreenshotCapture>;
+
+//----------------------------------------------------------------------------------------------------
+// Helper: Capture the back buffer, or join this frame's capture (main thread; nullptr = failed)
+//----------------------------------------------------------------------------------------------------
+static ScreenshotCapturePtr CaptureScreenshot(nlohmann::json const& json, std::weak_ptr<sScreenshotCapture>& lastCapture,
+                                              bool& outIsCoalesced)
+{
+    std::string const format      = json.value("format", "png");
+    int const         quality     = json.value("quality", 90);
+    std::string       name        = json.value("filename", "");
+    bool const        isKeepFile  = json.value("keepFile", true);
+    uint64_t const    frameNumber = static_cast<uint64_t>(Clock::GetSystemClock().GetFrameCount());
+
+    outIsCoalesced = false;
+
+    // An explicit filename always gets its own file
+    if (name.empty())
+    {
+        ScreenshotCapturePtr const shared = lastCapture.lock();
+        if (shared && shared->frameNumber == frameNumber && shared->format == format && shared->quality == quality)
+        {
+            shared->isKeepFile = shared->isKeepFile || isKeepFile;
+            outIsCoalesced     = true;
+            return shared;
+        }
+    }
+
+    // Auto-generate filename if not provided
+    if (name.empty())
+    {
+        auto        now       = std::chrono::system_clock::now();
+        std::time_t nowTime   = std::chrono::system_clock::to_time_t(now);
+        std::tm     localTime = {};
+        localtime_s(&localTime, &nowTime);
+
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now.time_since_epoch()) % 1000;
+
+        std::ostringstream oss;
+        oss << "screenshot_"
+            << std::put_time(&localTime, "%Y-%m-%d_%H%M%S")
+            << "_" << std::setfill('0') << std::setw(3) << ms.count();
+        name = oss.str();
+    }
+
+    // Output directory: Run/Screenshots/
+    namespace fs = std::filesystem;
+    fs::path outputDir = fs::current_path() / "Screenshots";
+
+    std::string outFilePath;
+    if (!g_renderer->CaptureScreenshot(outputDir.string(), name, format, quality, outFilePath))
+    {
+        return nullptr;
+    }
+
+    auto capture         = std::make_shared<sScreenshotCapture>();
+    capture->filePath    = outFilePath;
+    capture->format      = format;
+    capture->quality     = quality;
+    capture->frameNumber = frameNumber;
+    capture->isKeepFile  = isKeepFile;
+
+    if (json.value("filename", "").empty())
+    {
+        lastCapture = capture;
+    }
+    return capture;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Helper: Read back and encode a capture into its resultJson (any thread)
+//----------------------------------------------------------------------------------------------------
+static std::string BuildScreenshotResultJson(sScreenshotCapture& capture, bool const isIncludeImage, bool const isCoalesced)
+{
+    if (isIncludeImage)
+    {
+        std::call_once(capture.encodeOnce, [&capture]()
+        {
+            std::ifstream file(capture.filePath, std::ios::binary);
+            if (file)
+            {
+                std::vector<unsigned char> fileData(
+                    (std::istreambuf_iterator<char>(file)),
+                    std::istreambuf_iterator<char>());
+                capture.imageBase64 = KADIAuthenticationUtility::Base64Encode(fileData);
+            }
+        });
+    }
+
+    std::error_code ec;
+    uintmax_t       fileSize = std::filesystem::file_size(capture.filePath, ec);
+    if (ec)
+    {
+        fileSize = 0;
+    }
+
+    std::string mimeType = (capture.format == "jpeg" || capture.format == "jpg")
+                               ? "image/jpeg"
+                               : "image/png";
+
+    std::ostringstream resultJson;
+    resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(capture.filePath)
+        << R"(","format":")" << capture.format
+        << R"(","fileSize":)" << fileSize
+        << R"(,"mimeType":")" << mimeType
+        << R"(","coalesced":)" << (isCoalesced ? "true" : "false");
+    if (isIncludeImage)
+    {
+        resultJson << R"(,"imageData":")" << capture.imageBase64 << R"(")";
+    }
+    resultJson << "}";
+    return resultJson.str();
+}
+
 //----------------------------------------------------------------------------------------------------
 App::App()
 {
@@ -191,22 +397,125 @@ App::~App()
 //----------------------------------------------------------------------------------------------------
 void App::Startup()
 {
+    m_startupTimeline = new StartupTimeline();
+    m_startupTimeline->BeginPhase("engine");
+
     GEngine::Get().Startup();
 
+    m_startupTimeline->BeginPhase("app.infrastructure");
+
     g_eventSystem->SubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
     g_eventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
 
+    // Headless mode: forced by Headless.json or -headless, or implied when Window/Renderer were
+    // removed from EngineSubsystems.json core.subsystems
+    bool forceHeadless = HasCommandLineFlag("-headless");
+    try
+    {
+        std::ifstream configFile("Data/Config/Headless.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            forceHeadless      = jsonConfig.value("headless", false) || forceHeadless;
+            m_headlessTickRate = jsonConfig.value("tickRate", 0.f);
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("Headless config parse error: %s - using defaults", e.what()));
+    }
+
+    m_isHeadless = forceHeadless || !g_window || !g_renderer;
+    if (m_isHeadless)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Display,
+                   Stringf("App::Startup - Headless mode (%s), tickRate=%s",
+                       forceHeadless ? "Headless.json / -headless" : "no Window/Renderer",
+                       (m_headlessTickRate > 0.f) ? Stringf("%.1f Hz", m_headlessTickRate).c_str() : "unthrottled"));
+        if (g_renderer)
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Display,
+                       "App::Startup - Window and Renderer still exist (DX11 device and swapchain); remove them from EngineSubsystems.json core.subsystems to skip them");
+        }
+    }
+
+    // Frame profiler (optional — off if file missing); configured before anything records a scope
+    bool                 profilerEnabled = false;
+    sFrameProfilerConfig profilerConfig;
+    try
+    {
+        std::ifstream configFile("Data/Config/Profiler.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            profilerEnabled                   = jsonConfig.value("enabled", profilerEnabled);
+            profilerConfig.windowFrames       = jsonConfig.value("windowFrames", profilerConfig.windowFrames);
+            profilerConfig.traceHistoryFrames = jsonConfig.value("traceHistoryFrames", profilerConfig.traceHistoryFrames);
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("Profiler config parse error: %s - using defaults", e.what()));
+    }
+
+    FrameProfiler::Configure(profilerConfig);
+    FrameProfiler::SetThreadName("Main");
+    FrameProfiler::SetEnabled(profilerEnabled);
+
+    // Deferred-format logging for DAEMON_LOG_FAST sites (optional keys next to the LogSubsystem's own)
+    sBinaryLoggerConfig binaryLogConfig;
+    try
+    {
+        std::ifstream configFile("Data/Config/LogConfig.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            binaryLogConfig.isEnabled          = jsonConfig.value("binaryLogging", binaryLogConfig.isEnabled);
+            binaryLogConfig.ringBytesPerThread = jsonConfig.value("binaryLogRingBytesPerThread", binaryLogConfig.ringBytesPerThread);
+            binaryLogConfig.flushIntervalMs    = jsonConfig.value("binaryLogFlushIntervalMs", binaryLogConfig.flushIntervalMs);
+            binaryLogConfig.minVerbosity       = jsonConfig.value("binaryLogMinVerbosity", binaryLogConfig.minVerbosity);
+            binaryLogConfig.disabledCategories = jsonConfig.value("binaryLogDisabledCategories", binaryLogConfig.disabledCategories);
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("Log config parse error: %s - binary logging off", e.what()));
+        binaryLogConfig = sBinaryLoggerConfig();
+    }
+
+    BinaryLogger::Configure(binaryLogConfig);
+    BinaryLogger::Start();
+
     // Initialize async architecture infrastructure
     m_callbackQueue   = new CallbackQueue();
     m_frameEventQueue = new FrameEventQueue();
 
     // Connect FrameEventQueue to InputSystem (C++ → JS event channel)
-    g_input->SetFrameEventQueue(m_frameEventQueue);
+    if (g_input)
+    {
+        g_input->SetFrameEventQueue(m_frameEventQueue);
+    }
 
     // Load GenericCommand configuration from JSON (optional — uses defaults if file missing)
     size_t   gcQueueCapacity     = 500;    // GenericCommandQueue::DEFAULT_CAPACITY
     uint32_t gcRateLimitPerAgent = 100;  // Default: 100 commands/sec per agent
     bool     gcAuditLogging      = false;
+    uint32_t gcTypedCapacity     = 4096;   // Records per JS frame in the typed fast path
+    uint32_t gcResultRingBytes   = 1u << 20;   // Structured result ring (0 = JSON results only)
+    uint32_t gcExternalCapacity  = ExternalCommandQueue::DEFAULT_CAPACITY;   // Native producer queue (0 = disabled)
+    uint32_t gcExternalRateLimit = 100;    // Admission commands/sec per external agent
+    bool     gcAsyncDispatch     = true;   // ANY_THREAD / IO handler affinity (false = all inline)
+
+    sGenericCommandDispatcherConfig dispatcherConfig;
     try
     {
         std::ifstream configFile("Data/Config/GenericCommand.json");
@@ -218,10 +527,18 @@ void App::Startup()
             gcQueueCapacity     = jsonConfig.value("queueCapacity", 500);
             gcRateLimitPerAgent = jsonConfig.value("rateLimitPerAgent", 100u);
             gcAuditLogging      = jsonConfig.value("enableAuditLogging", false);
+            gcTypedCapacity     = jsonConfig.value("typedBufferCapacity", 4096u);
+            gcResultRingBytes   = jsonConfig.value("resultRingBytes", gcResultRingBytes);
+            gcExternalCapacity  = jsonConfig.value("externalQueueCapacity", gcExternalCapacity);
+            gcExternalRateLimit = jsonConfig.value("externalRateLimitPerAgent", gcRateLimitPerAgent);
+            gcAsyncDispatch     = jsonConfig.value("asyncDispatch", gcAsyncDispatch);
+
+            dispatcherConfig.anyThreadConcurrency = jsonConfig.value("anyThreadConcurrency", dispatcherConfig.anyThreadConcurrency);
+            dispatcherConfig.ioConcurrency        = jsonConfig.value("ioConcurrency", dispatcherConfig.ioConcurrency);
 
             DAEMON_LOG(LogApp, eLogVerbosity::Log,
-                       Stringf("GenericCommand config loaded: capacity=%zu, rateLimit=%u/s, audit=%s",
-                           gcQueueCapacity, gcRateLimitPerAgent, gcAuditLogging ? "ON" : "OFF"));
+                       Stringf("GenericCommand config loaded: capacity=%zu, rateLimit=%u/s, audit=%s, typedCapacity=%u",
+                           gcQueueCapacity, gcRateLimitPerAgent, gcAuditLogging ? "ON" : "OFF", gcTypedCapacity));
         }
         else
         {
@@ -238,17 +555,230 @@ void App::Startup()
     m_genericCommandExecutor = new GenericCommandExecutor();
     m_genericCommandExecutor->SetRateLimitPerAgent(gcRateLimitPerAgent);
     m_genericCommandExecutor->SetAuditLoggingEnabled(gcAuditLogging);
+    m_genericCommandDispatcher = new GenericCommandDispatcher(m_genericCommandExecutor, dispatcherConfig);
+    m_isAsyncDispatchEnabled   = gcAsyncDispatch;
+    m_typedCommandBuffer = new TypedCommandBuffer(gcTypedCapacity > 0 ? gcTypedCapacity : 4096u);
+    if (gcResultRingBytes > 0)
+    {
+        m_callbackResultRing = new CallbackResultRing(std::max(gcResultRingBytes, 4096u));
+    }
+    if (gcExternalCapacity > 0)
+    {
+        m_externalCommandQueue = new ExternalCommandQueue(gcExternalCapacity, gcExternalRateLimit);
+        DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                   Stringf("ExternalCommandQueue: capacity=%u, rateLimit=%u/s per agent",
+                       m_externalCommandQueue->GetCapacity(), gcExternalRateLimit));
+    }
+
+    // Load JavaScript worker scheduling configuration (optional — lockstep if file missing)
+    String   jsFrameMode      = "lockstep";
+    uint32_t jsPipelineDepth  = JSFramePipeline::DEFAULT_DEPTH;
+    float    jsTargetTickRate = 60.f;
+    uint32_t jsPoolIsolates   = 0;      // 0 = worker pool disabled
+    String   jsPoolScript     = "Data/Scripts/Workers/ShardRuntime.js";
+    String   simulationMode   = "variable";
+    float    fixedTickRate    = 60.f;
+    uint32_t maxCatchUpTicks  = FixedTimestepScheduler::DEFAULT_MAX_CATCH_UP_TICKS;
+    bool     interpolate      = true;
+
+    bool                   watchdogEnabled = true;
+    sJSFrameWatchdogConfig watchdogConfig;
+    bool                   gcSchedulerEnabled = true;
+    sJSGCSchedulerConfig   gcSchedulerConfig;
+    try
+    {
+        std::ifstream configFile("Data/Config/JSWorker.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            jsFrameMode      = jsonConfig.value("frameMode", String("lockstep"));
+            jsPipelineDepth  = jsonConfig.value("pipelineDepth", JSFramePipeline::DEFAULT_DEPTH);
+            jsTargetTickRate = jsonConfig.value("targetTickRate", 60.f);
+            jsPoolIsolates   = jsonConfig.value("workerPoolIsolates", 0u);
+            jsPoolScript     = jsonConfig.value("workerPoolScript", jsPoolScript);
+            simulationMode   = jsonConfig.value("simulationMode", simulationMode);
+            fixedTickRate    = jsonConfig.value("fixedTickRate", fixedTickRate);
+            maxCatchUpTicks  = jsonConfig.value("maxCatchUpTicks", maxCatchUpTicks);
+            interpolate      = jsonConfig.value("interpolateTransforms", interpolate);
+
+            watchdogEnabled                       = jsonConfig.value("watchdogEnabled", watchdogEnabled);
+            watchdogConfig.frameBudgetMs          = jsonConfig.value("frameBudgetMs", watchdogConfig.frameBudgetMs);
+            watchdogConfig.overrunFramesToShed    = jsonConfig.value("shedAfterOverrunFrames", watchdogConfig.overrunFramesToShed);
+            watchdogConfig.restoreFramesToRecover = jsonConfig.value("restoreAfterInBudgetFrames", watchdogConfig.restoreFramesToRecover);
+            watchdogConfig.throttleInterval       = jsonConfig.value("throttleInterval", watchdogConfig.throttleInterval);
+            watchdogConfig.reducedInterval        = jsonConfig.value("reducedInterval", watchdogConfig.reducedInterval);
+            watchdogConfig.shedMinPriority        = jsonConfig.value("shedMinPriority", watchdogConfig.shedMinPriority);
+            watchdogConfig.hangTimeoutMs          = jsonConfig.value("hangTimeoutMs", watchdogConfig.hangTimeoutMs);
+
+            gcSchedulerEnabled                      = jsonConfig.value("gcSchedulerEnabled", gcSchedulerEnabled);
+            gcSchedulerConfig.minIdleMs             = jsonConfig.value("gcMinIdleMs", gcSchedulerConfig.minIdleMs);
+            gcSchedulerConfig.moderatePressureRatio = jsonConfig.value("gcModeratePressureRatio", gcSchedulerConfig.moderatePressureRatio);
+            gcSchedulerConfig.criticalPressureRatio = jsonConfig.value("gcCriticalPressureRatio", gcSchedulerConfig.criticalPressureRatio);
+            gcSchedulerConfig.maxCriticalDefers     = jsonConfig.value("gcMaxCriticalDefers", gcSchedulerConfig.maxCriticalDefers);
+            gcSchedulerConfig.logIntervalSeconds    = jsonConfig.value("gcLogIntervalSeconds", gcSchedulerConfig.logIntervalSeconds);
+
+            DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                       Stringf("JSWorker config loaded: frameMode=%s, pipelineDepth=%u, targetTickRate=%.1f, workerPoolIsolates=%u",
+                           jsFrameMode.c_str(), jsPipelineDepth, jsTargetTickRate, jsPoolIsolates));
+            DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                       Stringf("JSWorker config loaded: simulationMode=%s, fixedTickRate=%.1f, maxCatchUpTicks=%u, interpolateTransforms=%s",
+                           simulationMode.c_str(), fixedTickRate, maxCatchUpTicks, interpolate ? "true" : "false"));
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("JSWorker config parse error: %s - using defaults", e.what()));
+    }
+
+    if (jsFrameMode == "pipelined")
+    {
+        // Each completed worker frame carries its own copy of the typed records
+        m_jsFramePipeline = new JSFramePipeline(jsPipelineDepth);
+        m_jsFramePipeline->SetCaptureFunction([this](sJSFrameSlot& slot)
+        {
+            m_typedCommandBuffer->Capture(slot.typedCommands);
+        });
+    }
+    else if (jsFrameMode != "lockstep")
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("JSWorker config: unknown frameMode '%s' - using lockstep", jsFrameMode.c_str()));
+    }
+
+    if (watchdogEnabled)
+    {
+        m_jsFrameWatchdog = new JSFrameWatchdog(watchdogConfig);
+    }
+
+    if (gcSchedulerEnabled)
+    {
+        // Pressure reference is the isolate's configured heap limit, which the Engine reads from here
+        try
+        {
+            std::ifstream subsystemsFile("Data/Config/EngineSubsystems.json");
+            if (subsystemsFile.is_open())
+            {
+                nlohmann::json jsonConfig;
+                subsystemsFile >> jsonConfig;
+
+                nlohmann::json const scriptConfig = jsonConfig.value("subsystems", nlohmann::json::object())
+                                                              .value("script", nlohmann::json::object())
+                                                              .value("config", nlohmann::json::object());
+                gcSchedulerConfig.heapSizeLimitMB = scriptConfig.value("heapSizeLimit", gcSchedulerConfig.heapSizeLimitMB);
+            }
+        }
+        catch (nlohmann::json::exception const& e)
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                       Stringf("EngineSubsystems heapSizeLimit parse error: %s - GC scheduler uses %uMB", e.what(), gcSchedulerConfig.heapSizeLimitMB));
+        }
+
+        m_jsGCScheduler = new JSGCScheduler(gcSchedulerConfig);
+    }
+
+    if (simulationMode == "fixed")
+    {
+        // Pipelined workers already run on their own tick; fixed mode pins their delta to that tick
+        m_simulationScheduler = new FixedTimestepScheduler(m_jsFramePipeline ? jsTargetTickRate : fixedTickRate, maxCatchUpTicks);
+    }
+    else if (simulationMode != "variable")
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("JSWorker config: unknown simulationMode '%s' - using variable", simulationMode.c_str()));
+    }
+
+    // Load entity render configuration (optional — uses defaults if file missing)
+    uint32_t meshVramBudgetMB   = 256;
+    float    spatialCellSize    = 16.f;
+    String   modelPlaceholder   = "cube";
+    String   meshCacheDirectory = "Data/Cache/Meshes";
+    try
+    {
+        std::ifstream configFile("Data/Config/EntityRender.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            m_isEntityBatchingEnabled = jsonConfig.value("enableEntityBatching", true);
+            meshVramBudgetMB          = jsonConfig.value("meshVramBudgetMB", 256u);
+            m_isFrustumCullingEnabled = jsonConfig.value("enableFrustumCulling", true);
+            spatialCellSize           = jsonConfig.value("spatialCellSize", 16.f);
+            modelPlaceholder          = jsonConfig.value("modelPlaceholder", modelPlaceholder);
+            meshCacheDirectory        = jsonConfig.value("meshCacheDirectory", meshCacheDirectory);
+
+            DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                       Stringf("EntityRender config loaded: batching=%s, culling=%s, meshVramBudget=%uMB, cellSize=%.1f",
+                           m_isEntityBatchingEnabled ? "ON" : "OFF", m_isFrustumCullingEnabled ? "ON" : "OFF", meshVramBudgetMB, spatialCellSize));
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("EntityRender config parse error: %s - using defaults", e.what()));
+    }
 
     // Initialize state buffers with dirty tracking for O(d) swap optimization
-    m_entityStateBuffer = new EntityStateBuffer();
-    m_entityStateBuffer->EnableDirtyTracking(true);
+    // (entities use the Game-side SoA EntityStore; cameras/audio keep the Engine StateBuffers)
+    m_entityStore = new EntityStore(spatialCellSize);
+    m_entityStore->SetInterpolationEnabled(m_simulationScheduler && interpolate);
     m_cameraStateBuffer = new CameraStateBuffer();
     m_cameraStateBuffer->EnableDirtyTracking(true);
     m_audioStateBuffer = new AudioStateBuffer();
     m_audioStateBuffer->EnableDirtyTracking(true);
+    m_audioSourceBatcher = new AudioSourceBatcher();
+
+    // FMOD channel count the voice statistics are reported against
+    try
+    {
+        std::ifstream subsystemsFile("Data/Config/EngineSubsystems.json");
+        if (subsystemsFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            subsystemsFile >> jsonConfig;
+
+            nlohmann::json const audioConfig = jsonConfig.value("subsystems", nlohmann::json::object())
+                                                         .value("audio", nlohmann::json::object())
+                                                         .value("config", nlohmann::json::object());
+            m_audioMaxChannels = audioConfig.value("maxChannels", m_audioMaxChannels);
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("EngineSubsystems maxChannels parse error: %s - using %u", e.what(), m_audioMaxChannels));
+    }
 
-    // Initialize mesh cache
+    // Initialize mesh cache (CPU vertices), interned handles and their GPU-resident buffers
     m_meshCache = new MeshCache();
+    m_meshHandleTable = new MeshHandleTable();
+    m_entityBatchRenderer = new EntityBatchRenderer();
+
+    // OBJ models load on a worker (from a .dmesh entry when current); until then their entities draw
+    // as a unit placeholder primitive
+    m_modelLoader = new AsyncModelLoader(meshCacheDirectory);
+    m_meshHandleTable->SetModelRequestFunction([this](MeshHandle const handle, String const& meshType)
+    {
+        m_modelLoader->Request(meshType, [this, handle](sModelLoadResult const& result)
+        {
+            m_meshHandleTable->SetModel(handle, result.model, result.localBoundRadius);
+        });
+    });
+    if (!modelPlaceholder.empty())
+    {
+        m_meshHandleTable->SetPlaceholder(m_meshHandleTable->Intern(modelPlaceholder, 0.5f));
+    }
+    if (!m_isHeadless)
+    {
+        m_gpuMeshCache = new GpuMeshCache(g_renderer, static_cast<size_t>(meshVramBudgetMB) * 1024 * 1024);
+        m_debugLayerRenderer = new DebugLayerRenderer(g_renderer);
+    }
+
+    // Typed fast path for per-frame transform commands (JSON handlers below remain the fallback)
+    RegisterTypedCommandHandlers();
 
     // === GenericCommand handler: "create_mesh" (Task 8.3 — EntityScriptInterface migration) ===
     // Replaces EntityScriptInterface::ExecuteCreateMesh with GenericCommand pipeline.
@@ -280,7 +810,7 @@ void App::Startup()
                                                   static std::atomic<EntityID> s_nextEntityId{1};
                                                   EntityID                     entityId = s_nextEntityId++;
 
-                                                  // Write directly to EntityStateBuffer (Audio pattern — no RenderCommandQueue hop)
+                                                  // Write directly to EntityStore (Audio pattern — no RenderCommandQueue hop)
                                                   // Vertex data is created lazily by MeshCache on first render.
                                                   EntityState state;
                                                   state.position    = position;
@@ -292,9 +822,10 @@ void App::Startup()
                                                   state.cameraType  = "world";
                                                   state.textureId   = json.value("textureId", static_cast<uint64_t>(0));
 
-                                                  auto* backBuffer        = m_entityStateBuffer->GetBackBuffer();
-                                                  (*backBuffer)[entityId] = state;
-                                                  m_entityStateBuffer->MarkDirty(entityId);
+                                                  MeshHandle const meshHandle = m_meshHandleTable->Intern(state.meshType, state.radius);
+                                                  uint32_t const   slot       = m_entityStore->Create(entityId, state, meshHandle);
+                                                  m_entityStore->GetBack().boundRadii[slot] = m_meshHandleTable->GetBoundRadius(meshHandle, state.radius, *m_meshCache);
+                                                  MarkEntityDirty(slot);
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
                                                              Stringf("GenericCommand [create_mesh]: entityId=%llu, mesh=%s, pos=(%.1f,%.1f,%.1f), scale=%.1f",
@@ -352,7 +883,7 @@ void App::Startup()
 
                                                   auto* backBuffer        = m_cameraStateBuffer->GetBackBuffer();
                                                   (*backBuffer)[cameraId] = state;
-                                                  m_cameraStateBuffer->MarkDirty(cameraId);
+                                                  MarkCameraDirty(cameraId);
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
                                                              Stringf("GenericCommand [create_camera]: cameraId=%llu, type=%s, pos=(%.1f,%.1f,%.1f)",
@@ -379,6 +910,7 @@ void App::Startup()
 
                                                   // Write directly to CameraStateBuffer (Audio/Entity pattern — no RenderCommandQueue hop)
                                                   m_cameraStateBuffer->SetActiveCameraID(cameraId);
+                                                  MarkCameraDirty(cameraId);
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
                                                              Stringf("GenericCommand [set_active_camera]: cameraId=%llu", cameraId));
@@ -432,7 +964,7 @@ void App::Startup()
                                                       ConfigureScreenCamera(it->second);
                                                   }
 
-                                                  m_cameraStateBuffer->MarkDirty(cameraId);
+                                                  MarkCameraDirty(cameraId);
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
                                                              Stringf("GenericCommand [update_camera_type]: cameraId=%llu, type=%s", cameraId, type.c_str()));
@@ -462,7 +994,7 @@ void App::Startup()
                                                   if (it != backBuffer->end())
                                                   {
                                                       it->second.isActive = false;
-                                                      m_cameraStateBuffer->MarkDirty(cameraId);
+                                                      MarkCameraDirty(cameraId);
                                                   }
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
@@ -516,7 +1048,7 @@ void App::Startup()
                                                   state.isActive  = true;
 
                                                   (*m_audioStateBuffer->GetBackBuffer())[soundId] = state;
-                                                  m_audioStateBuffer->MarkDirty(soundId);
+                                                  MarkAudioDirty(soundId);
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
                                                              Stringf("GenericCommand [load_sound]: soundId=%llu, path=%s", soundId, soundPath.c_str()));
@@ -573,7 +1105,7 @@ void App::Startup()
                                                   it->second.isPlaying = true;
                                                   it->second.volume    = volume;
                                                   it->second.isLooped  = looped;
-                                                  m_audioStateBuffer->MarkDirty(soundId);
+                                                  MarkAudioDirty(soundId);
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
                                                              Stringf("GenericCommand [play_sound]: soundId=%llu, playbackId=%llu, vol=%.2f, looped=%d, 3D=%d",
@@ -602,11 +1134,14 @@ void App::Startup()
                                                   if (it != backBuffer->end())
                                                   {
                                                       it->second.isPlaying = false;
-                                                      m_audioStateBuffer->MarkDirty(soundId);
+                                                      MarkAudioDirty(soundId);
                                                   }
 
                                                   g_audio->StopSound(soundId);
 
+                                                  // Playback ended: drop staged updates and any entity attachment for it
+                                                  m_audioSourceBatcher->Forget(soundId);
+
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
                                                              Stringf("GenericCommand [stop_sound]: soundId=%llu", soundId));
 
@@ -635,7 +1170,7 @@ void App::Startup()
                                                   if (it != backBuffer->end())
                                                   {
                                                       it->second.volume = volume;
-                                                      m_audioStateBuffer->MarkDirty(soundId);
+                                                      MarkAudioDirty(soundId);
                                                   }
 
                                                   g_audio->SetSoundPlaybackVolume(soundId, volume);
@@ -663,67 +1198,151 @@ void App::Startup()
 
                                                   Vec3 position = ParseVec3(json, "position");
 
-                                                  auto* backBuffer = m_audioStateBuffer->GetBackBuffer();
-                                                  auto  it         = backBuffer->find(soundId);
-                                                  if (it != backBuffer->end())
-                                                  {
-                                                      it->second.position = position;
-                                                      m_audioStateBuffer->MarkDirty(soundId);
-                                                  }
-
-                                                  g_audio->SetSoundPosition(soundId, position);
+                                                  // Applied (AudioSystem + AudioStateBuffer) with the frame's audio batch
+                                                  m_audioSourceBatcher->StagePosition(soundId, position);
 
-                                                  DAEMON_LOG(LogApp, eLogVerbosity::Log,
-                                                             Stringf("GenericCommand [update_3d_position]: soundId=%llu, pos=(%.1f,%.1f,%.1f)",
-                                                                 soundId, position.x, position.y, position.z));
+                                                  DAEMON_LOG_FAST(LogApp, eLogVerbosity::Log,
+                                                                  "GenericCommand [update_3d_position]: soundId=%llu, pos=(%.1f,%.1f,%.1f)",
+                                                                  soundId, position.x, position.y, position.z);
 
                                                   return HandlerResult::Success({{"resultId", std::any(static_cast<uint64_t>(soundId))}});
                                               });
 
-    // === GenericCommand handler: "load_texture" (Task 8.1 — ResourceScriptInterface migration) ===
-    // Replaces ResourceScriptInterface::ExecuteLoadTexture with GenericCommand pipeline.
-    // Handler runs on main thread; calls g_resourceSubsystem->CreateOrGetTextureFromFile() directly.
-    // Returns opaque resourceId (Texture* cast to uint64_t) matching ResourceLoadJob pattern.
-    m_genericCommandExecutor->RegisterHandler("load_texture",
+    // === GenericCommand handler: "audio.update_sources" (batched 3D source / listener update) ===
+    // One command per JS frame for every moving sound; nothing reaches FMOD until ApplyAudioSourceBatch().
+    // Payload: {ids:[n]?, positions:[3n]?, volumes:[n]?, entityIds:[n]?, offsets:[3n]?,
+    //           listener:{position:[3], forward:[3]?, up:[3]?}?, listenerEntityId?}
+    //   entityIds attaches each source to an entity (0 = detach); offsets are added to the entity position
+    //   listenerEntityId follows an entity's position and orientation (0 = detach)
+    m_genericCommandExecutor->RegisterHandler("audio.update_sources",
                                               [this](std::any const& payload) -> HandlerResult
                                               {
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
 
-                                                  String path = json.value("path", "");
-                                                  if (path.empty())
+                                                  auto const idsIt = json.find("ids");
+                                                  if (idsIt != json.end() && !idsIt->is_array())
                                                   {
-                                                      return HandlerResult::Error("ERR_INVALID_PARAM: path is required");
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: ids must be an array");
                                                   }
+                                                  size_t const count = (idsIt != json.end()) ? idsIt->size() : 0;
 
-                                                  if (!g_resourceSubsystem)
+                                                  auto findArray = [&json](char const* key, size_t expected, nlohmann::json const*& out) -> bool
                                                   {
-                                                      return HandlerResult::Error("ERR_NOT_INITIALIZED: ResourceSubsystem is null");
-                                                  }
+                                                      out = nullptr;
+                                                      auto const it = json.find(key);
+                                                      if (it == json.end() || it->is_null()) return true;
+                                                      if (!it->is_array() || it->size() != expected) return false;
+                                                      out = &(*it);
+                                                      return true;
+                                                  };
 
-                                                  Texture* texture = g_resourceSubsystem->CreateOrGetTextureFromFile(path);
-                                                  if (!texture)
+                                                  nlohmann::json const* positions = nullptr;
+                                                  nlohmann::json const* volumes   = nullptr;
+                                                  nlohmann::json const* entityIds = nullptr;
+                                                  nlohmann::json const* offsets   = nullptr;
+                                                  if (!findArray("positions", count * 3, positions) ||
+                                                      !findArray("volumes", count, volumes) ||
+                                                      !findArray("entityIds", count, entityIds) ||
+                                                      !findArray("offsets", count * 3, offsets))
                                                   {
-                                                      DAEMON_LOG(LogApp, eLogVerbosity::Warning,
-                                                                 Stringf("GenericCommand [load_texture]: failed to load '%s'", path.c_str()));
-                                                      return HandlerResult::Error(Stringf("ERR_LOAD_FAILED: texture not found or invalid: %s", path.c_str()));
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: SoA array length does not match ids");
                                                   }
 
-                                                  uint64_t resourceId = reinterpret_cast<uint64_t>(texture);
+                                                  try
+                                                  {
+                                                      for (size_t i = 0; i < count; ++i)
+                                                      {
+                                                          SoundID const soundId = (*idsIt)[i].get<SoundID>();
+
+                                                          if (entityIds)
+                                                          {
+                                                              Vec3 const offset = offsets ? Vec3((*offsets)[i * 3].get<float>(),
+                                                                                                 (*offsets)[i * 3 + 1].get<float>(),
+                                                                                                 (*offsets)[i * 3 + 2].get<float>())
+                                                                                          : Vec3::ZERO;
+                                                              m_audioSourceBatcher->Attach(soundId, (*entityIds)[i].get<EntityID>(), offset);
+                                                          }
+                                                          if (positions)
+                                                          {
+                                                              m_audioSourceBatcher->StagePosition(soundId, Vec3((*positions)[i * 3].get<float>(),
+                                                                                                                (*positions)[i * 3 + 1].get<float>(),
+                                                                                                                (*positions)[i * 3 + 2].get<float>()));
+                                                          }
+                                                          if (volumes)
+                                                          {
+                                                              m_audioSourceBatcher->StageVolume(soundId, (*volumes)[i].get<float>());
+                                                          }
+                                                      }
 
-                                                  DAEMON_LOG(LogApp, eLogVerbosity::Log,
-                                                             Stringf("GenericCommand [load_texture]: resourceId=%llu, path=%s", resourceId, path.c_str()));
+                                                      auto const listenerIt = json.find("listener");
+                                                      if (listenerIt != json.end() && listenerIt->is_object())
+                                                      {
+                                                          sAudioListenerState listener;
+                                                          listener.position = ParseVec3(*listenerIt, "position");
+                                                          listener.forward  = ParseVec3(*listenerIt, "forward", listener.forward);
+                                                          listener.up       = ParseVec3(*listenerIt, "up", listener.up);
+                                                          m_audioSourceBatcher->StageListener(listener);
+                                                      }
+                                                      if (json.contains("listenerEntityId"))
+                                                      {
+                                                          m_audioSourceBatcher->AttachListener(json["listenerEntityId"].get<EntityID>());
+                                                      }
+                                                  }
+                                                  catch (nlohmann::json::exception const& e)
+                                                  {
+                                                      return HandlerResult::Error(Stringf("ERR_INVALID_PARAM: %s", e.what()));
+                                                  }
 
-                                                  return HandlerResult::Success({{"resultId", std::any(resourceId)}});
+                                                  return HandlerResult::Success();
                                               });
 
-    // === GenericCommand handler: "load_model" — Load OBJ model as entity ===
-    // Loads .obj file via MeshCache (lazy ObjModelLoader), creates entity in EntityStateBuffer.
-    // Rendering uses PCUTBN with indexed drawing (preserves normals for lighting).
-    m_genericCommandExecutor->RegisterHandler("load_model",
+    // === GenericCommand handler: "audio.get_source_stats" ===
+    // Batch counters plus voice usage against maxChannels. FMOD virtualizes the quietest voices once
+    // more than maxChannels play; estimatedVirtual is that overflow, counted from the AudioStateBuffer.
+    m_genericCommandExecutor->RegisterHandler("audio.get_source_stats",
+                                              [this](std::any const&) -> HandlerResult
+                                              {
+                                                  uint32_t playing = 0;
+                                                  uint32_t loaded  = 0;
+                                                  for (auto const& [soundId, state] : *m_audioStateBuffer->GetBackBuffer())
+                                                  {
+                                                      if (state.isLoaded) ++loaded;
+                                                      if (state.isPlaying) ++playing;
+                                                  }
+
+                                                  sAudioSourceBatchStats const stats = m_audioSourceBatcher->GetStats();
+
+                                                  std::ostringstream resultJson;
+                                                  resultJson << R"({"success":true,"maxChannels":)" << m_audioMaxChannels
+                                                             << R"(,"loadedSounds":)" << loaded
+                                                             << R"(,"playingSounds":)" << playing
+                                                             << R"(,"estimatedVirtual":)" << (playing > m_audioMaxChannels ? playing - m_audioMaxChannels : 0)
+                                                             << R"(,"trackedSources":)" << stats.trackedSources
+                                                             << R"(,"attachedSources":)" << stats.attachedSources
+                                                             << R"(,"listenerAttached":)" << (stats.isListenerAttached ? "true" : "false")
+                                                             << R"(,"lastFrameChanges":)" << stats.lastFrameChanges
+                                                             << R"(,"lastFrameUnchanged":)" << stats.lastFrameUnchanged
+                                                             << R"(,"totalStaged":)" << stats.totalStaged
+                                                             << R"(,"totalChanges":)" << stats.totalChanges
+                                                             << R"(,"totalUnchanged":)" << stats.totalUnchanged
+                                                             << R"(,"listenerUpdates":)" << stats.listenerUpdates
+                                                             << R"(,"entityDetaches":)" << stats.entityDetaches
+                                                             << R"(,"forgottenSources":)" << stats.forgottenSources << "}";
+
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // === GenericCommand handler: "load_texture" (Task 8.1 — ResourceScriptInterface migration) ===
+    // Replaces ResourceScriptInterface::ExecuteLoadTexture with GenericCommand pipeline.
+    // Handler runs on main thread; calls g_resourceSubsystem->CreateOrGetTextureFromFile() directly.
+    // Returns opaque resourceId (Texture* cast to uint64_t) matching ResourceLoadJob pattern.
+    m_genericCommandExecutor->RegisterHandler("load_texture",
                                               [this](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("load_texture");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -734,50 +1353,145 @@ void App::Startup()
                                                       return HandlerResult::Error("ERR_INVALID_PARAM: path is required");
                                                   }
 
-                                                  // Construct meshType with "obj:" prefix for MeshCache dispatch
-                                                  String meshType = "obj:" + path;
+                                                  if (!g_resourceSubsystem)
+                                                  {
+                                                      return HandlerResult::Error("ERR_NOT_INITIALIZED: ResourceSubsystem is null");
+                                                  }
 
-                                                  // Verify file can be loaded (eager load into cache)
-                                                  ModelMeshData const* model = m_meshCache->GetOrCreateModel(meshType);
-                                                  if (!model || model->vertices.empty())
+                                                  Texture* texture = g_resourceSubsystem->CreateOrGetTextureFromFile(path);
+                                                  if (!texture)
                                                   {
-                                                      return HandlerResult::Error(Stringf("ERR_LOAD_FAILED: could not load OBJ: %s", path.c_str()));
+                                                      DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                                                                 Stringf("GenericCommand [load_texture]: failed to load '%s'", path.c_str()));
+                                                      return HandlerResult::Error(Stringf("ERR_LOAD_FAILED: texture not found or invalid: %s", path.c_str()));
                                                   }
 
-                                                  Vec3  position = ParseVec3(json, "position");
-                                                  float scale    = json.value("scale", 1.0f);
-                                                  auto  colorArr = json.value("color", std::vector<int>{255, 255, 255, 255});
-                                                  Rgba8 color(
-                                                      static_cast<unsigned char>(colorArr.size() > 0 ? colorArr[0] : 255),
-                                                      static_cast<unsigned char>(colorArr.size() > 1 ? colorArr[1] : 255),
-                                                      static_cast<unsigned char>(colorArr.size() > 2 ? colorArr[2] : 255),
-                                                      static_cast<unsigned char>(colorArr.size() > 3 ? colorArr[3] : 255)
-                                                  );
+                                                  uint64_t resourceId = reinterpret_cast<uint64_t>(texture);
 
-                                                  // Use high offset to avoid collision with create_mesh entity IDs
-                                                  static std::atomic<EntityID> s_nextModelEntityId{10000};
-                                                  EntityID entityId = s_nextModelEntityId++;
+                                                  DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                                                             Stringf("GenericCommand [load_texture]: resourceId=%llu, path=%s", resourceId, path.c_str()));
 
-                                                  EntityState state;
-                                                  state.position    = position;
-                                                  state.orientation = EulerAngles::ZERO;
-                                                  state.color       = color;
-                                                  state.radius      = scale;
-                                                  state.meshType    = meshType;
-                                                  state.isActive    = true;
-                                                  state.cameraType  = "world";
-                                                  state.textureId   = json.value("textureId", static_cast<uint64_t>(0));
+                                                  return HandlerResult::Success({{"resultId", std::any(resourceId)}});
+                                              });
+
+    // === GenericCommand handler: "load_model" — Load OBJ model as entity ===
+    // The OBJ is parsed by AsyncModelLoader on a worker. The entity is created right away and drawn
+    // as the placeholder; the callback (resultId = entityId) fires once the model has been swapped in.
+    // Concurrent loads of one path share a single parse. A failed load destroys the entity again.
+    // Rendering uses PCUTBN with indexed drawing (preserves normals for lighting).
+    auto const spawnModelEntity = [this](nlohmann::json const& json, String const& meshType, MeshHandle& meshHandle) -> EntityID
+    {
+        Vec3  position = ParseVec3(json, "position");
+        float scale    = json.value("scale", 1.0f);
+        auto  colorArr = json.value("color", std::vector<int>{255, 255, 255, 255});
+        Rgba8 color(
+            static_cast<unsigned char>(colorArr.size() > 0 ? colorArr[0] : 255),
+            static_cast<unsigned char>(colorArr.size() > 1 ? colorArr[1] : 255),
+            static_cast<unsigned char>(colorArr.size() > 2 ? colorArr[2] : 255),
+            static_cast<unsigned char>(colorArr.size() > 3 ? colorArr[3] : 255)
+        );
+
+        // Use high offset to avoid collision with create_mesh entity IDs
+        static std::atomic<EntityID> s_nextModelEntityId{10000};
+        EntityID entityId = s_nextModelEntityId++;
+
+        EntityState state;
+        state.position    = position;
+        state.orientation = EulerAngles::ZERO;
+        state.color       = color;
+        state.radius      = scale;
+        state.meshType    = meshType;
+        state.isActive    = true;
+        state.cameraType  = "world";
+        state.textureId   = json.value("textureId", static_cast<uint64_t>(0));
+
+        // The bound radius is the scale until applyLoadedModel() knows the model's extent
+        meshHandle                                = m_meshHandleTable->Intern(state.meshType, state.radius);
+        uint32_t const slot                       = m_entityStore->Create(entityId, state, meshHandle);
+        m_entityStore->GetBack().boundRadii[slot] = state.radius;
+        MarkEntityDirty(slot);
+        return entityId;
+    };
 
-                                                  auto* backBuffer = m_entityStateBuffer->GetBackBuffer();
-                                                  (*backBuffer)[entityId] = state;
-                                                  m_entityStateBuffer->MarkDirty(entityId);
+    auto const applyLoadedModel = [this](EntityID const entityId, MeshHandle const meshHandle, sModelLoadResult const& loaded)
+    {
+        m_meshHandleTable->SetModel(meshHandle, loaded.model, loaded.localBoundRadius);
 
-                                                  DAEMON_LOG(LogApp, eLogVerbosity::Log,
-                                                             Stringf("GenericCommand [load_model]: entityId=%llu, path=%s, verts=%zu, pos=(%.1f,%.1f,%.1f), tex=%llu",
-                                                                 entityId, path.c_str(), model->vertices.size(), position.x, position.y, position.z, state.textureId));
+        uint32_t const slot = m_entityStore->FindSlot(entityId);
+        if (slot != EntityStore::INVALID_SLOT)
+        {
+            sEntityArrays& back   = m_entityStore->GetBack();
+            back.boundRadii[slot] = m_meshHandleTable->GetBoundRadius(meshHandle, back.radii[slot], *m_meshCache);
+            MarkEntityDirty(slot);
+        }
 
-                                                  return HandlerResult::Success({{"resultId", std::any(static_cast<uint64_t>(entityId))}});
-                                              });
+        DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                   Stringf("GenericCommand [load_model]: entityId=%llu, mesh=%s, verts=%zu, load=%.1fms",
+                       entityId, loaded.meshType.c_str(), loaded.model->vertices.size(), loaded.loadMs));
+    };
+
+    m_genericCommandDispatcher->RegisterDeferredHandler("load_model",
+                                                        [this, spawnModelEntity, applyLoadedModel](std::any const& payload, DeferredCommandToken const token)
+                                                        {
+                                                            nlohmann::json json;
+                                                            String         err = ParseJsonPayload(payload, json);
+                                                            String const   path = err.empty() ? json.value("path", "") : String();
+                                                            if (err.empty() && path.empty())
+                                                            {
+                                                                err = "ERR_INVALID_PARAM: path is required";
+                                                            }
+                                                            if (!err.empty())
+                                                            {
+                                                                m_genericCommandDispatcher->CompleteDeferred(token, HandlerResult::Error(err), 0.0);
+                                                                return;
+                                                            }
+
+                                                            MeshHandle     meshHandle = INVALID_MESH_HANDLE;
+                                                            EntityID const entityId   = spawnModelEntity(json, "obj:" + path, meshHandle);
+                                                            auto const     start      = std::chrono::steady_clock::now();
+
+                                                            m_modelLoader->Request("obj:" + path, [this, applyLoadedModel, token, entityId, meshHandle, path, start](sModelLoadResult const& loaded)
+                                                            {
+                                                                double const waitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                                                                if (!loaded.model)
+                                                                {
+                                                                    m_meshHandleTable->SetModel(meshHandle, nullptr, 0.f);
+                                                                    m_entityStore->Destroy(entityId);
+                                                                    m_genericCommandDispatcher->CompleteDeferred(
+                                                                        token, HandlerResult::Error(Stringf("ERR_LOAD_FAILED: could not load OBJ: %s", path.c_str())), waitMs);
+                                                                    return;
+                                                                }
+
+                                                                applyLoadedModel(entityId, meshHandle, loaded);
+                                                                m_genericCommandDispatcher->CompleteDeferred(
+                                                                    token, HandlerResult::Success({{"resultId", std::any(static_cast<uint64_t>(entityId))}}), waitMs);
+                                                            });
+                                                        },
+                                                        [this, spawnModelEntity, applyLoadedModel](std::any const& payload) -> HandlerResult
+                                                        {
+                                                            // Dispatcher bypassed (asyncDispatch off): parse inline, as before
+                                                            nlohmann::json json;
+                                                            String         err = ParseJsonPayload(payload, json);
+                                                            if (!err.empty()) return HandlerResult::Error(err);
+
+                                                            String path = json.value("path", "");
+                                                            if (path.empty())
+                                                            {
+                                                                return HandlerResult::Error("ERR_INVALID_PARAM: path is required");
+                                                            }
+
+                                                            sModelLoadResult const& loaded = m_modelLoader->LoadNow("obj:" + path);
+                                                            if (!loaded.model)
+                                                            {
+                                                                return HandlerResult::Error(Stringf("ERR_LOAD_FAILED: could not load OBJ: %s", path.c_str()));
+                                                            }
+
+                                                            MeshHandle     meshHandle = INVALID_MESH_HANDLE;
+                                                            EntityID const entityId   = spawnModelEntity(json, loaded.meshType, meshHandle);
+                                                            applyLoadedModel(entityId, meshHandle, loaded);
+
+                                                            return HandlerResult::Success({{"resultId", std::any(static_cast<uint64_t>(entityId))}});
+                                                        });
 
     // === GenericCommand handler: "load_shader" (Task 8.1 — ResourceScriptInterface migration) ===
     // Replaces ResourceScriptInterface::ExecuteLoadShader with GenericCommand pipeline.
@@ -786,6 +1500,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("load_shader",
                                               [this](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("load_shader");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -840,13 +1556,12 @@ void App::Startup()
 
                                                   Vec3 position(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
 
-                                                  // Write directly to EntityStateBuffer (Audio pattern — no RenderCommandQueue hop)
-                                                  auto* backBuffer = m_entityStateBuffer->GetBackBuffer();
-                                                  auto  it         = backBuffer->find(entityId);
-                                                  if (it != backBuffer->end())
+                                                  // Write directly to EntityStore (Audio pattern — no RenderCommandQueue hop)
+                                                  uint32_t const slot = m_entityStore->FindSlot(entityId);
+                                                  if (slot != EntityStore::INVALID_SLOT)
                                                   {
-                                                      it->second.position = position;
-                                                      m_entityStateBuffer->MarkDirty(entityId);
+                                                      m_entityStore->GetBack().positions[slot] = position;
+                                                      MarkEntityDirty(slot);
                                                   }
 
                                                   // Fire-and-forget: no callback result needed
@@ -876,14 +1591,13 @@ void App::Startup()
 
                                                   Vec3 delta(static_cast<float>(dx), static_cast<float>(dy), static_cast<float>(dz));
 
-                                                  // Write directly to EntityStateBuffer (Audio pattern — no RenderCommandQueue hop)
+                                                  // Write directly to EntityStore (Audio pattern — no RenderCommandQueue hop)
                                                   // Proper relative movement: read current position, add delta, write back
-                                                  auto* backBuffer = m_entityStateBuffer->GetBackBuffer();
-                                                  auto  it         = backBuffer->find(entityId);
-                                                  if (it != backBuffer->end())
+                                                  uint32_t const slot = m_entityStore->FindSlot(entityId);
+                                                  if (slot != EntityStore::INVALID_SLOT)
                                                   {
-                                                      it->second.position += delta;
-                                                      m_entityStateBuffer->MarkDirty(entityId);
+                                                      m_entityStore->GetBack().positions[slot] += delta;
+                                                      MarkEntityDirty(slot);
                                                   }
 
                                                   // Fire-and-forget: no callback result needed
@@ -909,13 +1623,12 @@ void App::Startup()
 
                                                   EulerAngles orientation(static_cast<float>(yaw), static_cast<float>(pitch), static_cast<float>(roll));
 
-                                                  // Write directly to EntityStateBuffer (Audio pattern — no RenderCommandQueue hop)
-                                                  auto* backBuffer = m_entityStateBuffer->GetBackBuffer();
-                                                  auto  it         = backBuffer->find(entityId);
-                                                  if (it != backBuffer->end())
+                                                  // Write directly to EntityStore (Audio pattern — no RenderCommandQueue hop)
+                                                  uint32_t const slot = m_entityStore->FindSlot(entityId);
+                                                  if (slot != EntityStore::INVALID_SLOT)
                                                   {
-                                                      it->second.orientation = orientation;
-                                                      m_entityStateBuffer->MarkDirty(entityId);
+                                                      m_entityStore->GetBack().orientations[slot] = orientation;
+                                                      MarkEntityDirty(slot);
                                                   }
 
                                                   return HandlerResult::Success();
@@ -936,15 +1649,168 @@ void App::Startup()
 
                                                   Rgba8 color = ParseRgba8(json);
 
-                                                  // Write directly to EntityStateBuffer (Audio pattern — no RenderCommandQueue hop)
-                                                  auto* backBuffer = m_entityStateBuffer->GetBackBuffer();
-                                                  auto  it         = backBuffer->find(entityId);
-                                                  if (it != backBuffer->end())
+                                                  // Write directly to EntityStore (Audio pattern — no RenderCommandQueue hop)
+                                                  uint32_t const slot = m_entityStore->FindSlot(entityId);
+                                                  if (slot != EntityStore::INVALID_SLOT)
+                                                  {
+                                                      m_entityStore->GetBack().colors[slot] = color;
+                                                      MarkEntityDirty(slot);
+                                                  }
+
+                                                  return HandlerResult::Success();
+                                              });
+
+    // === GenericCommand handler: "entity.update_transforms" (batched SoA transform update) ===
+    // One command per JS frame instead of one per entity per field — keeps the SPSC queue from overflowing.
+    // Payload: {ids:[n], mask:[n]?, positions:[3n]?, orientations:[3n]?, colors:[4n]?}
+    //   mask bit 1 = position, 2 = orientation, 4 = color (omitted mask: apply every array present, 0: skip the entry)
+    // Flow: EntityAPI.flushTransforms() → submit("entity.update_transforms") → single pass over EntityStore
+    m_genericCommandExecutor->RegisterHandler("entity.update_transforms",
+                                              [this](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  auto const idsIt = json.find("ids");
+                                                  if (idsIt == json.end() || !idsIt->is_array())
+                                                  {
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: ids array is required");
+                                                  }
+
+                                                  nlohmann::json const& ids   = *idsIt;
+                                                  size_t const          count = ids.size();
+
+                                                  // Resolve optional SoA arrays once; reject mismatched lengths up front
+                                                  auto findArray = [&json](char const* key, size_t expected, nlohmann::json const*& out) -> bool
+                                                  {
+                                                      out = nullptr;
+                                                      auto const it = json.find(key);
+                                                      if (it == json.end() || it->is_null()) return true;
+                                                      if (!it->is_array() || it->size() != expected) return false;
+                                                      out = &(*it);
+                                                      return true;
+                                                  };
+
+                                                  nlohmann::json const* mask         = nullptr;
+                                                  nlohmann::json const* positions    = nullptr;
+                                                  nlohmann::json const* orientations = nullptr;
+                                                  nlohmann::json const* colors       = nullptr;
+                                                  if (!findArray("mask", count, mask) ||
+                                                      !findArray("positions", count * 3, positions) ||
+                                                      !findArray("orientations", count * 3, orientations) ||
+                                                      !findArray("colors", count * 4, colors))
+                                                  {
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: SoA array length does not match ids");
+                                                  }
+
+                                                  try
+                                                  {
+                                                      sEntityArrays& back = m_entityStore->GetBack();
+                                                      for (size_t i = 0; i < count; ++i)
+                                                      {
+                                                          uint32_t const slot = m_entityStore->FindSlot(ids[i].get<EntityID>());
+                                                          if (slot == EntityStore::INVALID_SLOT) continue;
+
+                                                          int const bits = mask ? (*mask)[i].get<int>() : 0x7;
+                                                          if (bits == 0) continue;
+
+                                                          // Only values that differ are written, so unchanged entries stay off the dirty list
+                                                          bool isChanged = false;
+                                                          if (positions && (bits & 0x1))
+                                                          {
+                                                              Vec3 const position((*positions)[i * 3].get<float>(),
+                                                                                  (*positions)[i * 3 + 1].get<float>(),
+                                                                                  (*positions)[i * 3 + 2].get<float>());
+                                                              Vec3&      current = back.positions[slot];
+                                                              if (current.x != position.x || current.y != position.y || current.z != position.z)
+                                                              {
+                                                                  current   = position;
+                                                                  isChanged = true;
+                                                              }
+                                                          }
+                                                          if (orientations && (bits & 0x2))
+                                                          {
+                                                              EulerAngles const orientation((*orientations)[i * 3].get<float>(),
+                                                                                            (*orientations)[i * 3 + 1].get<float>(),
+                                                                                            (*orientations)[i * 3 + 2].get<float>());
+                                                              EulerAngles&      current = back.orientations[slot];
+                                                              if (current.m_yawDegrees != orientation.m_yawDegrees ||
+                                                                  current.m_pitchDegrees != orientation.m_pitchDegrees ||
+                                                                  current.m_rollDegrees != orientation.m_rollDegrees)
+                                                              {
+                                                                  current   = orientation;
+                                                                  isChanged = true;
+                                                              }
+                                                          }
+                                                          if (colors && (bits & 0x4))
+                                                          {
+                                                              Rgba8 const color(static_cast<unsigned char>((*colors)[i * 4].get<int>()),
+                                                                                static_cast<unsigned char>((*colors)[i * 4 + 1].get<int>()),
+                                                                                static_cast<unsigned char>((*colors)[i * 4 + 2].get<int>()),
+                                                                                static_cast<unsigned char>((*colors)[i * 4 + 3].get<int>()));
+                                                              Rgba8&      current = back.colors[slot];
+                                                              if (current.r != color.r || current.g != color.g || current.b != color.b || current.a != color.a)
+                                                              {
+                                                                  current   = color;
+                                                                  isChanged = true;
+                                                              }
+                                                          }
+
+                                                          if (isChanged) MarkEntityDirty(slot);
+                                                      }
+                                                  }
+                                                  catch (nlohmann::json::exception const& e)
+                                                  {
+                                                      return HandlerResult::Error(Stringf("ERR_INVALID_PARAM: %s", e.what()));
+                                                  }
+
+                                                  return HandlerResult::Success();
+                                              });
+
+    // === GenericCommand handler: "typed.flush" (TypedCommandBuffer overflow) ===
+    // CommandQueue.submitTyped() sends the records of a full typed buffer here and restarts it with a
+    // FLUSHED_RECORDS marker; the records are queued and applied when Drain()/Apply() reaches the marker.
+    // Payload: {records:[8n]} - opcode, targetId, v0..v5 per record
+    m_genericCommandExecutor->RegisterHandler("typed.flush",
+                                              [this](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  if (!m_typedCommandBuffer)
+                                                  {
+                                                      return HandlerResult::Error("ERR_NOT_AVAILABLE: typed command buffer not installed");
+                                                  }
+
+                                                  auto const recordsIt = json.find("records");
+                                                  if (recordsIt == json.end() || !recordsIt->is_array() || recordsIt->size() % 8 != 0)
+                                                  {
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: records must hold 8 values per record");
+                                                  }
+
+                                                  nlohmann::json const&            values = *recordsIt;
+                                                  std::vector<sTypedCommandRecord> records(values.size() / 8);
+                                                  try
                                                   {
-                                                      it->second.color = color;
-                                                      m_entityStateBuffer->MarkDirty(entityId);
+                                                      for (size_t i = 0; i < records.size(); ++i)
+                                                      {
+                                                          sTypedCommandRecord& record = records[i];
+                                                          record.opcode               = values[i * 8].get<uint32_t>();
+                                                          record.targetId             = values[i * 8 + 1].get<double>();
+                                                          for (size_t v = 0; v < 6; ++v)
+                                                          {
+                                                              record.values[v] = values[i * 8 + 2 + v].get<float>();
+                                                          }
+                                                      }
+                                                  }
+                                                  catch (nlohmann::json::exception const& e)
+                                                  {
+                                                      return HandlerResult::Error(Stringf("ERR_INVALID_PARAM: %s", e.what()));
                                                   }
 
+                                                  m_typedCommandBuffer->AddFlushedRecords(records.data(), static_cast<uint32_t>(records.size()));
                                                   return HandlerResult::Success();
                                               });
 
@@ -963,17 +1829,113 @@ void App::Startup()
                                                   uint64_t entityId  = *entityIdOpt;
                                                   uint64_t textureId = json.value("textureId", static_cast<uint64_t>(0));
 
-                                                  auto* backBuffer = m_entityStateBuffer->GetBackBuffer();
-                                                  auto  it         = backBuffer->find(entityId);
-                                                  if (it != backBuffer->end())
+                                                  uint32_t const slot = m_entityStore->FindSlot(entityId);
+                                                  if (slot != EntityStore::INVALID_SLOT)
+                                                  {
+                                                      m_entityStore->GetBack().textureIds[slot] = textureId;
+                                                      MarkEntityDirty(slot);
+                                                  }
+
+                                                  return HandlerResult::Success();
+                                              });
+
+    // === GenericCommand handler: "render.set_entity_batching" ===
+    // Toggles the cached static batches for primitive entities (EntityBatchRenderer). Default: enabled.
+    // Disable to compare against the per-entity draw path via game.get_engine_metrics.
+    m_genericCommandExecutor->RegisterHandler("render.set_entity_batching",
+                                              [this](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  if (!json.contains("enabled") || !json["enabled"].is_boolean())
+                                                  {
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: enabled (bool) is required");
+                                                  }
+
+                                                  m_isEntityBatchingEnabled = json["enabled"].get<bool>();
+
+                                                  DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                                                             Stringf("GenericCommand [render.set_entity_batching]: %s", m_isEntityBatchingEnabled ? "ON" : "OFF"));
+
+                                                  return HandlerResult::Success();
+                                              });
+
+    // === GenericCommand handler: "game.set_js_direct_calls" ===
+    // Selects how the worker thread invokes JSEngine.update/render: cached v8::Function handles
+    // (default) or the legacy per-frame eval strings. Compare jsWorker.avgDirectMs / avgEvalMs.
+    m_genericCommandExecutor->RegisterHandler("game.set_js_direct_calls",
+                                              [](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  if (!json.contains("enabled") || !json["enabled"].is_boolean())
                                                   {
-                                                      it->second.textureId = textureId;
-                                                      m_entityStateBuffer->MarkDirty(entityId);
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: enabled (bool) is required");
                                                   }
 
+                                                  if (g_game == nullptr)
+                                                  {
+                                                      return HandlerResult::Error("ERR_NOT_READY: Game not available");
+                                                  }
+
+                                                  bool const isEnabled = json["enabled"].get<bool>();
+                                                  g_game->SetDirectJSCallsEnabled(isEnabled);
+
+                                                  DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                                                             Stringf("GenericCommand [game.set_js_direct_calls]: %s", isEnabled ? "ON" : "OFF"));
+
                                                   return HandlerResult::Success();
                                               });
 
+    // === GenericCommand handler: "entity.set_worker_behavior" ===
+    // Hands an entity to its JSWorkerPool shard (EntityID % isolateCount), which runs the behavior in
+    // its own isolate from the entity's current back-buffer transform. behavior "" or "none" releases it.
+    // See JSWorkerPool.hpp for which writes are partition-safe.
+    m_genericCommandExecutor->RegisterHandler("entity.set_worker_behavior",
+                                              [this](std::any const& payload) -> HandlerResult
+                                              {
+                                                  if (!m_jsWorkerPool)
+                                                  {
+                                                      return HandlerResult::Error("ERR_NOT_INITIALIZED: worker pool disabled (JSWorker.json workerPoolIsolates)");
+                                                  }
+
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  auto entityIdOpt = RequireEntityId(json);
+                                                  if (!entityIdOpt) return HandlerResult::Error("ERR_INVALID_PARAM: entityId is required");
+                                                  uint64_t entityId = *entityIdOpt;
+
+                                                  uint32_t const slot = m_entityStore->FindSlot(entityId);
+                                                  if (slot == EntityStore::INVALID_SLOT)
+                                                  {
+                                                      return HandlerResult::Error(Stringf("ERR_INVALID_PARAM: entity %llu not found", entityId));
+                                                  }
+
+                                                  sShardAssignment assignment;
+                                                  assignment.entityId     = entityId;
+                                                  assignment.behaviorType = json.value("behavior", String());
+                                                  if (assignment.behaviorType == "none") assignment.behaviorType.clear();
+
+                                                  sEntityArrays const& back = m_entityStore->GetBack();
+                                                  assignment.position       = back.positions[slot];
+                                                  assignment.orientation    = back.orientations[slot];
+                                                  assignment.color          = back.colors[slot];
+
+                                                  uint32_t const shardIndex = m_jsWorkerPool->Assign(assignment);
+
+                                                  DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                                                             Stringf("GenericCommand [entity.set_worker_behavior]: entityId=%llu, behavior='%s', shard=%u",
+                                                                 entityId, assignment.behaviorType.c_str(), shardIndex));
+
+                                                  return HandlerResult::Success({{"resultId", std::any(static_cast<uint64_t>(shardIndex))}});
+                                              });
+
     // === GenericCommand handler: "entity.destroy" (Task 9.1.5) ===
     // Lifecycle operation with optional callback for confirmation.
     m_genericCommandExecutor->RegisterHandler("entity.destroy",
@@ -987,13 +1949,16 @@ void App::Startup()
                                                   if (!entityIdOpt) return HandlerResult::Error("ERR_INVALID_PARAM: entityId is required");
                                                   uint64_t entityId = *entityIdOpt;
 
-                                                  // Write directly to EntityStateBuffer (Audio pattern — no RenderCommandQueue hop)
-                                                  auto* backBuffer = m_entityStateBuffer->GetBackBuffer();
-                                                  auto  it         = backBuffer->find(entityId);
-                                                  if (it != backBuffer->end())
+                                                  // Deactivate in the EntityStore; the slot is recycled after the front buffer sees it
+                                                  if (m_entityStore->Destroy(entityId))
                                                   {
-                                                      it->second.isActive = false;
-                                                      m_entityStateBuffer->MarkDirty(entityId);
+                                                      // Stop any worker pool behavior (empty behaviorType = release)
+                                                      if (m_jsWorkerPool)
+                                                      {
+                                                          sShardAssignment release;
+                                                          release.entityId = entityId;
+                                                          m_jsWorkerPool->Assign(release);
+                                                      }
                                                   }
 
                                                   DAEMON_LOG(LogApp, eLogVerbosity::Log,
@@ -1031,7 +1996,7 @@ void App::Startup()
                                                   {
                                                       it->second.position    = Vec3(posX, posY, posZ);
                                                       it->second.orientation = EulerAngles(yaw, pitch, roll);
-                                                      m_cameraStateBuffer->MarkDirty(cameraId);
+                                                      MarkCameraDirty(cameraId);
                                                   }
 
                                                   return HandlerResult::Success();
@@ -1063,7 +2028,7 @@ void App::Startup()
                                                   if (it != backBuffer->end())
                                                   {
                                                       it->second.position = Vec3(x, y, z);
-                                                      m_cameraStateBuffer->MarkDirty(cameraId);
+                                                      MarkCameraDirty(cameraId);
                                                   }
 
                                                   return HandlerResult::Success();
@@ -1095,7 +2060,7 @@ void App::Startup()
                                                   if (it != backBuffer->end())
                                                   {
                                                       it->second.orientation = EulerAngles(yaw, pitch, roll);
-                                                      m_cameraStateBuffer->MarkDirty(cameraId);
+                                                      MarkCameraDirty(cameraId);
                                                   }
 
                                                   return HandlerResult::Success();
@@ -1126,7 +2091,7 @@ void App::Startup()
                                                   if (it != backBuffer->end())
                                                   {
                                                       it->second.position += Vec3(dx, dy, dz);
-                                                      m_cameraStateBuffer->MarkDirty(cameraId);
+                                                      MarkCameraDirty(cameraId);
                                                   }
 
                                                   return HandlerResult::Success();
@@ -1179,30 +2144,38 @@ void App::Startup()
     // --- Control handlers ---
 
     m_genericCommandExecutor->RegisterHandler("debug_render.set_visible",
-                                              [](std::any const& payload) -> HandlerResult
+                                              [this](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.set_visible");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
 
                                                   DebugRenderSetVisible();
+                                                  if (m_debugLayerRenderer) m_debugLayerRenderer->SetVisible(true);
                                                   return HandlerResult::Success();
                                               });
 
     m_genericCommandExecutor->RegisterHandler("debug_render.set_hidden",
-                                              [](std::any const& payload) -> HandlerResult
+                                              [this](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.set_hidden");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
 
                                                   DebugRenderSetHidden();
+                                                  if (m_debugLayerRenderer) m_debugLayerRenderer->SetVisible(false);
                                                   return HandlerResult::Success();
                                               });
 
     m_genericCommandExecutor->RegisterHandler("debug_render.clear",
                                               [](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.clear");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1212,13 +2185,16 @@ void App::Startup()
                                               });
 
     m_genericCommandExecutor->RegisterHandler("debug_render.clear_all",
-                                              [](std::any const& payload) -> HandlerResult
+                                              [this](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.clear_all");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
 
                                                   DebugRenderClear();
+                                                  if (m_debugLayerRenderer) m_debugLayerRenderer->ClearAllLayers();
                                                   return HandlerResult::Success();
                                               });
 
@@ -1227,6 +2203,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_world_point",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_world_point");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1244,6 +2222,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_world_line",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_world_line");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1262,6 +2242,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_world_cylinder",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_world_cylinder");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1281,6 +2263,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_world_wire_sphere",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_world_wire_sphere");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1298,6 +2282,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_world_arrow",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_world_arrow");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1316,6 +2302,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_world_text",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_world_text");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1348,6 +2336,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_billboard_text",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_billboard_text");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1368,6 +2358,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_world_basis",
                                               [parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_world_basis");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1397,6 +2389,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_screen_text",
                                               [](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_screen_text");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1416,6 +2410,8 @@ void App::Startup()
     m_genericCommandExecutor->RegisterHandler("debug_render.add_message",
                                               [](std::any const& payload) -> HandlerResult
                                               {
+                                                  if (IsHeadless()) return MakeHeadlessError("debug_render.add_message");
+
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
@@ -1428,212 +2424,495 @@ void App::Startup()
                                                   return HandlerResult::Success();
                                               });
 
-    //------------------------------------------------------------------------------------------------
-    // GameScriptInterface Migration: File Operations, Input Injection, FileWatcher Management
-    // These handlers replace the synchronous GameScriptInterface methods with async GenericCommand
-    // pipeline. Results are delivered via CallbackData.resultJson → CommandQueue.handleCallback.
-    //------------------------------------------------------------------------------------------------
-
-    // game.app_request_quit — Request application quit
-    m_genericCommandExecutor->RegisterHandler("game.app_request_quit",
-                                              [](std::any const& /*payload*/) -> HandlerResult
-                                              {
-                                                  App::RequestQuit();
-                                                  return HandlerResult::Success({{"resultJson", std::any(std::string(R"({"success":true})"))}});
-                                              });
-
-    // game.execute_command — Execute JavaScript command string
-    m_genericCommandExecutor->RegisterHandler("game.execute_command",
-                                              [](std::any const& payload) -> HandlerResult
-                                              {
-                                                  nlohmann::json json;
-                                                  String         err = ParseJsonPayload(payload, json);
-                                                  if (!err.empty()) return HandlerResult::Error(err);
-
-                                                  String command = json.value("command", "");
-                                                  if (command.empty()) return HandlerResult::Error("Missing 'command' field");
-
-                                                  if (g_game) g_game->ExecuteJavaScriptCommand(command);
-                                                  std::string resultJson = R"({"success":true,"command":")" + EscapeJsonString(command) + R"("})";
-                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson)}});
-                                              });
-
-    // game.execute_file — Execute JavaScript file
-    m_genericCommandExecutor->RegisterHandler("game.execute_file",
-                                              [](std::any const& payload) -> HandlerResult
+    // --- Batched and retained handlers ---
+
+    // === GenericCommand handler: "debug_render.add_batch" (packed primitives, one command per frame) ===
+    // Payload: {layer?, append?, duration?, mode?, r, g, b, a (default color),
+    //           lines:{positions:[6n], colors:[4n]?, radius?}, points:{positions:[3n], colors:[4n]?, radius?},
+    //           arrows:{positions:[6n], colors:[4n]?, radius?}, texts:{positions:[3n], strings:[n], colors:[4n]?, textHeight?}}
+    // Lines and points with duration 0 and USE_DEPTH are merged into one draw by DebugLayerRenderer;
+    // with a layer they replace (or append to) that retained layer instead. Any other duration/mode,
+    // and arrows/texts (never retained), go through the per-primitive DebugAdd* calls.
+    m_genericCommandExecutor->RegisterHandler("debug_render.add_batch",
+                                              [this, parseDebugRenderMode](std::any const& payload) -> HandlerResult
                                               {
-                                                  nlohmann::json json;
-                                                  String         err = ParseJsonPayload(payload, json);
-                                                  if (!err.empty()) return HandlerResult::Error(err);
-
-                                                  String filename = json.value("filename", "");
-                                                  if (filename.empty()) return HandlerResult::Error("Missing 'filename' field");
-
-                                                  if (g_game) g_game->ExecuteJavaScriptFile(filename);
-                                                  std::string resultJson = R"({"success":true,"filename":")" + EscapeJsonString(filename) + R"("})";
-                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson)}});
-                                              });
+                                                  if (IsHeadless() || !m_debugLayerRenderer) return MakeHeadlessError("debug_render.add_batch");
 
-    // game.create_script_file — Create/overwrite a .js file in Scripts directory
-    m_genericCommandExecutor->RegisterHandler("game.create_script_file",
-                                              [](std::any const& payload) -> HandlerResult
-                                              {
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
 
-                                                  std::string filePath  = json.value("filePath", "");
-                                                  std::string content   = json.value("content", "");
-                                                  bool        overwrite = json.value("overwrite", false);
+                                                  String           layerId      = json.value("layer", "");
+                                                  bool             isAppend     = json.value("append", false);
+                                                  float            duration     = json.value("duration", 0.0f);
+                                                  Rgba8            defaultColor = ParseRgba8(json);
+                                                  eDebugRenderMode mode         = parseDebugRenderMode(json.value("mode", "USE_DEPTH"));
+                                                  bool const       isRetained   = !layerId.empty();
+                                                  bool const       isMerged     = isRetained || (duration <= 0.f && mode == eDebugRenderMode::USE_DEPTH);
 
-                                                  std::string validationErr = ValidateJsFilePath(filePath);
-                                                  if (!validationErr.empty()) return HandlerResult::Success({{"resultJson", std::any(validationErr)}});
-
-                                                  try
+                                                  // Resolve each group's arrays once; reject mismatched lengths before drawing anything
+                                                  struct sGroup
                                                   {
-                                                      namespace fs = std::filesystem;
-                                                      fs::path scriptsDir = fs::current_path() / "Data" / "Scripts";
-                                                      fs::path fullPath   = scriptsDir / filePath;
-
-                                                      if (fs::exists(fullPath) && !overwrite)
+                                                      nlohmann::json const* positions = nullptr;
+                                                      nlohmann::json const* colors    = nullptr;
+                                                      nlohmann::json const* strings   = nullptr;
+                                                      size_t                count     = 0;
+                                                      float                 size      = 0.f;
+                                                  };
+                                                  auto findGroup = [&json](char const* key, size_t floatsPer, char const* sizeKey, float defaultSize,
+                                                                           bool hasStrings, sGroup& out) -> bool
+                                                  {
+                                                      auto const it = json.find(key);
+                                                      if (it == json.end() || it->is_null()) return true;
+                                                      if (!it->is_object()) return false;
+
+                                                      auto const positionsIt = it->find("positions");
+                                                      if (positionsIt == it->end() || !positionsIt->is_array() || positionsIt->size() % floatsPer != 0) return false;
+                                                      out.positions = &(*positionsIt);
+                                                      out.count     = positionsIt->size() / floatsPer;
+                                                      out.size      = it->value(sizeKey, defaultSize);
+
+                                                      auto const colorsIt = it->find("colors");
+                                                      if (colorsIt != it->end() && !colorsIt->is_null())
                                                       {
-                                                          std::string r = R"({"success":false,"error":"File already exists and overwrite=false: )" + EscapeJsonString(filePath) + R"("})";
-                                                          return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                          if (!colorsIt->is_array() || colorsIt->size() != out.count * 4) return false;
+                                                          out.colors = &(*colorsIt);
                                                       }
-
-                                                      fs::path parentDir = fullPath.parent_path();
-                                                      if (!fs::exists(parentDir)) fs::create_directories(parentDir);
-
-                                                      std::ofstream outFile(fullPath, std::ios::out | std::ios::trunc);
-                                                      if (!outFile.is_open())
+                                                      if (hasStrings)
                                                       {
-                                                          std::string r = R"({"success":false,"error":"Failed to open file for writing: )" + EscapeJsonString(filePath) + R"("})";
-                                                          return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                          auto const stringsIt = it->find("strings");
+                                                          if (stringsIt == it->end() || !stringsIt->is_array() || stringsIt->size() != out.count) return false;
+                                                          out.strings = &(*stringsIt);
                                                       }
+                                                      return true;
+                                                  };
 
-                                                      outFile << content;
-                                                      outFile.close();
-
-                                                      std::ostringstream resultJson;
-                                                      resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(fullPath.string())
-                                                          << R"(","bytesWritten":)" << content.length() << "}";
-                                                      return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                                  sGroup lines;
+                                                  sGroup points;
+                                                  sGroup arrows;
+                                                  sGroup texts;
+                                                  if (!findGroup("lines", 6, "radius", 0.02f, false, lines) ||
+                                                      !findGroup("points", 3, "radius", 0.1f, false, points) ||
+                                                      !findGroup("arrows", 6, "radius", 0.02f, false, arrows) ||
+                                                      !findGroup("texts", 3, "textHeight", 1.0f, true, texts))
+                                                  {
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: batch arrays must be positions:[6n] (lines, arrows) or [3n] (points, texts) with colors:[4n] and strings:[n]");
                                                   }
-                                                  catch (std::exception const& e)
+                                                  if (isRetained && (arrows.count > 0 || texts.count > 0))
                                                   {
-                                                      std::string r = R"({"success":false,"error":"Create script file exception: )" + EscapeJsonString(e.what()) + R"("})";
-                                                      return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: layers hold lines and points only");
                                                   }
-                                              });
 
-    // game.read_script_file — Read a .js file from Scripts directory
-    m_genericCommandExecutor->RegisterHandler("game.read_script_file",
-                                              [](std::any const& payload) -> HandlerResult
-                                              {
-                                                  nlohmann::json json;
-                                                  String         err = ParseJsonPayload(payload, json);
-                                                  if (!err.empty()) return HandlerResult::Error(err);
+                                                  // Convert every element before emitting any, so a malformed element late in the
+                                                  // payload rejects the whole batch instead of leaving it partially drawn
+                                                  struct sParsedGroup
+                                                  {
+                                                      std::vector<Vec3>   positions;
+                                                      std::vector<Rgba8>  colors;
+                                                      std::vector<String> strings;
+                                                  };
+                                                  auto parseGroup = [&defaultColor](sGroup const& group, size_t vec3sPer, sParsedGroup& out)
+                                                  {
+                                                      out.positions.reserve(group.count * vec3sPer);
+                                                      for (size_t i = 0; i < group.count * vec3sPer; ++i)
+                                                      {
+                                                          out.positions.emplace_back((*group.positions)[i * 3].get<float>(),
+                                                                                     (*group.positions)[i * 3 + 1].get<float>(),
+                                                                                     (*group.positions)[i * 3 + 2].get<float>());
+                                                      }
+                                                      out.colors.reserve(group.count);
+                                                      for (size_t i = 0; i < group.count; ++i)
+                                                      {
+                                                          out.colors.push_back(!group.colors ? defaultColor
+                                                                                             : Rgba8(static_cast<unsigned char>((*group.colors)[i * 4].get<int>()),
+                                                                                                     static_cast<unsigned char>((*group.colors)[i * 4 + 1].get<int>()),
+                                                                                                     static_cast<unsigned char>((*group.colors)[i * 4 + 2].get<int>()),
+                                                                                                     static_cast<unsigned char>((*group.colors)[i * 4 + 3].get<int>())));
+                                                      }
+                                                      if (group.strings)
+                                                      {
+                                                          out.strings.reserve(group.count);
+                                                          for (size_t i = 0; i < group.count; ++i)
+                                                          {
+                                                              out.strings.push_back((*group.strings)[i].get<String>());
+                                                          }
+                                                      }
+                                                  };
 
-                                                  std::string filePath = json.value("filePath", "");
+                                                  sParsedGroup parsedLines;
+                                                  sParsedGroup parsedPoints;
+                                                  sParsedGroup parsedArrows;
+                                                  sParsedGroup parsedTexts;
+                                                  try
+                                                  {
+                                                      parseGroup(lines, 2, parsedLines);
+                                                      parseGroup(points, 1, parsedPoints);
+                                                      parseGroup(arrows, 2, parsedArrows);
+                                                      parseGroup(texts, 1, parsedTexts);
+                                                  }
+                                                  catch (nlohmann::json::exception const& e)
+                                                  {
+                                                      return HandlerResult::Error(Stringf("ERR_INVALID_PARAM: %s", e.what()));
+                                                  }
 
-                                                  std::string validationErr = ValidateJsFilePath(filePath);
-                                                  if (!validationErr.empty()) return HandlerResult::Success({{"resultJson", std::any(validationErr)}});
+                                                  VertexList_PCU  layerVerts;
+                                                  VertexList_PCU& mergedVerts = isRetained ? layerVerts : m_debugLayerRenderer->GetFrameVerts();
+                                                  uint32_t        layerVertexCount = 0;
 
-                                                  try
+                                                  if (isMerged)
+                                                  {
+                                                      mergedVerts.reserve(mergedVerts.size() + lines.count * DEBUG_LINE_VERTS + points.count * DEBUG_POINT_VERTS);
+                                                  }
+                                                  for (size_t i = 0; i < lines.count; ++i)
                                                   {
-                                                      namespace fs = std::filesystem;
-                                                      fs::path scriptsDir = fs::current_path() / "Data" / "Scripts";
-                                                      fs::path fullPath   = scriptsDir / filePath;
+                                                      Vec3 const&  start = parsedLines.positions[i * 2];
+                                                      Vec3 const&  end   = parsedLines.positions[i * 2 + 1];
+                                                      Rgba8 const& color = parsedLines.colors[i];
+                                                      if (isMerged) AppendDebugLineVerts(mergedVerts, start, end, lines.size, color);
+                                                      else DebugAddWorldLine(start, end, lines.size, duration, color, color, mode);
+                                                  }
+                                                  for (size_t i = 0; i < points.count; ++i)
+                                                  {
+                                                      Vec3 const&  center = parsedPoints.positions[i];
+                                                      Rgba8 const& color  = parsedPoints.colors[i];
+                                                      if (isMerged) AppendDebugPointVerts(mergedVerts, center, points.size, color);
+                                                      else DebugAddWorldPoint(center, points.size, duration, color, color, mode);
+                                                  }
+                                                  for (size_t i = 0; i < arrows.count; ++i)
+                                                  {
+                                                      Rgba8 const& color = parsedArrows.colors[i];
+                                                      DebugAddWorldArrow(parsedArrows.positions[i * 2], parsedArrows.positions[i * 2 + 1], arrows.size, duration, color, color, mode);
+                                                  }
+                                                  for (size_t i = 0; i < texts.count; ++i)
+                                                  {
+                                                      Rgba8 const& color = parsedTexts.colors[i];
+                                                      DebugAddBillboardText(parsedTexts.strings[i], parsedTexts.positions[i], texts.size,
+                                                                            Vec2(0.5f, 0.5f), duration, color, color, mode);
+                                                  }
 
-                                                      if (!fs::exists(fullPath))
-                                                      {
-                                                          std::string r = R"({"success":false,"error":"File not found: )" + EscapeJsonString(filePath) + R"("})";
-                                                          return HandlerResult::Success({{"resultJson", std::any(r)}});
-                                                      }
+                                                  if (isRetained)
+                                                  {
+                                                      layerVertexCount = m_debugLayerRenderer->SetLayerGeometry(layerId, layerVerts, isAppend);
+                                                  }
+
+                                                  std::ostringstream resultJson;
+                                                  resultJson << R"({"success":true,"lines":)" << lines.count
+                                                             << R"(,"points":)" << points.count
+                                                             << R"(,"arrows":)" << arrows.count
+                                                             << R"(,"texts":)" << texts.count
+                                                             << R"(,"merged":)" << (isMerged ? "true" : "false");
+                                                  if (isRetained)
+                                                  {
+                                                      resultJson << R"(,"layer":")" << EscapeJsonString(layerId)
+                                                                 << R"(","layerVertexCount":)" << layerVertexCount;
+                                                  }
+                                                  resultJson << "}";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // --- Retained layer control: {layer} (ERR_NOT_FOUND for an unknown layer) ---
+
+    auto registerLayerHandler = [this](char const* commandType, std::function<bool(String const&)> action)
+    {
+        String const type = commandType;
+        m_genericCommandExecutor->RegisterHandler(type,
+                                                  [this, type, action](std::any const& payload) -> HandlerResult
+                                                  {
+                                                      if (IsHeadless() || !m_debugLayerRenderer) return MakeHeadlessError(type.c_str());
+
+                                                      nlohmann::json json;
+                                                      String         err = ParseJsonPayload(payload, json);
+                                                      if (!err.empty()) return HandlerResult::Error(err);
 
-                                                      std::ifstream inFile(fullPath, std::ios::in);
-                                                      if (!inFile.is_open())
+                                                      String const layerId = json.value("layer", "");
+                                                      if (layerId.empty()) return HandlerResult::Error("ERR_INVALID_PARAM: layer is required");
+                                                      if (!action(layerId))
                                                       {
-                                                          std::string r = R"({"success":false,"error":"Failed to open file for reading: )" + EscapeJsonString(filePath) + R"("})";
-                                                          return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                          return HandlerResult::Error(Stringf("ERR_NOT_FOUND: no debug layer '%s'", layerId.c_str()));
                                                       }
+                                                      return HandlerResult::Success();
+                                                  });
+    };
+    registerLayerHandler("debug_render.show_layer", [this](String const& layerId) { return m_debugLayerRenderer->SetLayerVisible(layerId, true); });
+    registerLayerHandler("debug_render.hide_layer", [this](String const& layerId) { return m_debugLayerRenderer->SetLayerVisible(layerId, false); });
+    registerLayerHandler("debug_render.clear_layer", [this](String const& layerId) { return m_debugLayerRenderer->ClearLayer(layerId); });
 
-                                                      std::stringstream buffer;
-                                                      buffer << inFile.rdbuf();
-                                                      inFile.close();
-
-                                                      std::string content   = buffer.str();
-                                                      size_t      lineCount = std::count(content.begin(), content.end(), '\n') + 1;
-                                                      size_t      byteSize  = content.length();
+    m_genericCommandExecutor->RegisterHandler("debug_render.list_layers",
+                                              [this](std::any const& /*payload*/) -> HandlerResult
+                                              {
+                                                  if (IsHeadless() || !m_debugLayerRenderer) return MakeHeadlessError("debug_render.list_layers");
 
-                                                      std::ostringstream resultJson;
-                                                      resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(fullPath.string())
-                                                          << R"(","content":")" << EscapeJsonString(content)
-                                                          << R"(","lineCount":)" << lineCount
-                                                          << R"(,"byteSize":)" << byteSize << "}";
-                                                      return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
-                                                  }
-                                                  catch (std::exception const& e)
+                                                  std::ostringstream resultJson;
+                                                  resultJson << R"({"success":true,"layers":[)";
+                                                  bool isFirst = true;
+                                                  for (sDebugLayerInfo const& info : m_debugLayerRenderer->GetLayerInfos())
                                                   {
-                                                      std::string r = R"({"success":false,"error":"Read script file exception: )" + EscapeJsonString(e.what()) + R"("})";
-                                                      return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                      resultJson << (isFirst ? "" : ",") << R"({"id":")" << EscapeJsonString(info.id)
+                                                                 << R"(","isVisible":)" << (info.isVisible ? "true" : "false")
+                                                                 << R"(,"vertexCount":)" << info.vertexCount
+                                                                 << R"(,"gpuBytes":)" << info.gpuBytes << "}";
+                                                      isFirst = false;
                                                   }
+                                                  resultJson << "]}";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
                                               });
 
-    // game.delete_script_file — Delete a .js file from Scripts directory
-    m_genericCommandExecutor->RegisterHandler("game.delete_script_file",
+    //------------------------------------------------------------------------------------------------
+    // GameScriptInterface Migration: File Operations, Input Injection, FileWatcher Management
+    // These handlers replace the synchronous GameScriptInterface methods with async GenericCommand
+    // pipeline. Results are delivered via CallbackData.resultJson → CommandQueue.handleCallback.
+    //------------------------------------------------------------------------------------------------
+
+    // game.app_request_quit — Request application quit
+    m_genericCommandExecutor->RegisterHandler("game.app_request_quit",
+                                              [](std::any const& /*payload*/) -> HandlerResult
+                                              {
+                                                  App::RequestQuit();
+                                                  return HandlerResult::Success({{"resultJson", std::any(std::string(R"({"success":true})"))}});
+                                              });
+
+    // game.execute_command — Execute JavaScript command string
+    m_genericCommandExecutor->RegisterHandler("game.execute_command",
                                               [](std::any const& payload) -> HandlerResult
                                               {
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
                                                   if (!err.empty()) return HandlerResult::Error(err);
 
-                                                  std::string filePath = json.value("filePath", "");
+                                                  String command = json.value("command", "");
+                                                  if (command.empty()) return HandlerResult::Error("Missing 'command' field");
 
-                                                  std::string validationErr = ValidateJsFilePath(filePath);
-                                                  if (!validationErr.empty()) return HandlerResult::Success({{"resultJson", std::any(validationErr)}});
+                                                  if (g_game) g_game->ExecuteJavaScriptCommand(command);
+                                                  std::string resultJson = R"({"success":true,"command":")" + EscapeJsonString(command) + R"("})";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson)}});
+                                              });
 
-                                                  // Protected files list
-                                                  static const std::vector<std::string> protectedFiles = {
-                                                      "JSEngine.js", "JSGame.js", "InputSystem.js", "main.js",
-                                                      "kadi/KADIGameControl.js", "kadi/GameControlHandler.js",
-                                                      "kadi/GameControlTools.js", "kadi/DevelopmentToolHandler.js",
-                                                      "kadi/DevelopmentTools.js", "core/Subsystem.js",
-                                                      "components/RendererSystem.js", "components/Prop.js"
-                                                  };
+    // game.execute_file — Execute JavaScript file
+    m_genericCommandExecutor->RegisterHandler("game.execute_file",
+                                              [](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
 
-                                                  std::string normalizedPath = filePath;
-                                                  std::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
+                                                  String filename = json.value("filename", "");
+                                                  if (filename.empty()) return HandlerResult::Error("Missing 'filename' field");
 
-                                                  for (auto const& pf : protectedFiles)
-                                                  {
-                                                      if (normalizedPath == pf || normalizedPath.find(pf) != std::string::npos)
-                                                      {
-                                                          std::string r = R"({"success":false,"error":"Cannot delete protected file: )" + EscapeJsonString(filePath) + R"("})";
-                                                          return HandlerResult::Success({{"resultJson", std::any(r)}});
-                                                      }
-                                                  }
+                                                  if (g_game) g_game->ExecuteJavaScriptFile(filename);
+                                                  std::string resultJson = R"({"success":true,"filename":")" + EscapeJsonString(filename) + R"("})";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson)}});
+                                              });
 
-                                                  try
-                                                  {
-                                                      namespace fs = std::filesystem;
-                                                      fs::path scriptsDir = fs::current_path() / "Data" / "Scripts";
-                                                      fs::path fullPath   = scriptsDir / filePath;
+    // Script files are written/read/deleted on the IO lane (GenericCommandDispatcher); executing one
+    // waits for file commands submitted before it
+    m_genericCommandDispatcher->RegisterBarrier("game.execute_file", eCommandAffinity::IO);
+
+    // game.create_script_file — Create/overwrite a .js file in Scripts directory
+    m_genericCommandDispatcher->RegisterHandler("game.create_script_file", eCommandAffinity::IO,
+                                                [](std::any const& payload) -> HandlerResult
+                                                {
+                                                    nlohmann::json json;
+                                                    String         err = ParseJsonPayload(payload, json);
+                                                    if (!err.empty()) return HandlerResult::Error(err);
+
+                                                    std::string filePath  = json.value("filePath", "");
+                                                    std::string content   = json.value("content", "");
+                                                    bool        overwrite = json.value("overwrite", false);
+
+                                                    std::string validationErr = ValidateJsFilePath(filePath);
+                                                    if (!validationErr.empty()) return HandlerResult::Success({{"resultJson", std::any(validationErr)}});
+
+                                                    try
+                                                    {
+                                                        namespace fs = std::filesystem;
+                                                        fs::path scriptsDir = fs::current_path() / "Data" / "Scripts";
+                                                        fs::path fullPath   = scriptsDir / filePath;
+
+                                                        if (fs::exists(fullPath) && !overwrite)
+                                                        {
+                                                            std::string r = R"({"success":false,"error":"File already exists and overwrite=false: )" + EscapeJsonString(filePath) + R"("})";
+                                                            return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                        }
+
+                                                        fs::path parentDir = fullPath.parent_path();
+                                                        if (!fs::exists(parentDir)) fs::create_directories(parentDir);
+
+                                                        std::ofstream outFile(fullPath, std::ios::out | std::ios::trunc);
+                                                        if (!outFile.is_open())
+                                                        {
+                                                            std::string r = R"({"success":false,"error":"Failed to open file for writing: )" + EscapeJsonString(filePath) + R"("})";
+                                                            return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                        }
+
+                                                        outFile << content;
+                                                        outFile.close();
+
+                                                        std::ostringstream resultJson;
+                                                        resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(fullPath.string())
+                                                            << R"(","bytesWritten":)" << content.length() << "}";
+                                                        return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                                    }
+                                                    catch (std::exception const& e)
+                                                    {
+                                                        std::string r = R"({"success":false,"error":"Create script file exception: )" + EscapeJsonString(e.what()) + R"("})";
+                                                        return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                    }
+                                                });
 
-                                                      bool existed = fs::exists(fullPath);
-                                                      if (existed) fs::remove(fullPath);
+    // game.read_script_file — Read a .js file from Scripts directory
+    m_genericCommandDispatcher->RegisterHandler("game.read_script_file", eCommandAffinity::IO,
+                                                [](std::any const& payload) -> HandlerResult
+                                                {
+                                                    nlohmann::json json;
+                                                    String         err = ParseJsonPayload(payload, json);
+                                                    if (!err.empty()) return HandlerResult::Error(err);
+
+                                                    std::string filePath = json.value("filePath", "");
+
+                                                    std::string validationErr = ValidateJsFilePath(filePath);
+                                                    if (!validationErr.empty()) return HandlerResult::Success({{"resultJson", std::any(validationErr)}});
+
+                                                    try
+                                                    {
+                                                        namespace fs = std::filesystem;
+                                                        fs::path scriptsDir = fs::current_path() / "Data" / "Scripts";
+                                                        fs::path fullPath   = scriptsDir / filePath;
+
+                                                        if (!fs::exists(fullPath))
+                                                        {
+                                                            std::string r = R"({"success":false,"error":"File not found: )" + EscapeJsonString(filePath) + R"("})";
+                                                            return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                        }
+
+                                                        std::ifstream inFile(fullPath, std::ios::in);
+                                                        if (!inFile.is_open())
+                                                        {
+                                                            std::string r = R"({"success":false,"error":"Failed to open file for reading: )" + EscapeJsonString(filePath) + R"("})";
+                                                            return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                        }
+
+                                                        std::stringstream buffer;
+                                                        buffer << inFile.rdbuf();
+                                                        inFile.close();
+
+                                                        std::string content   = buffer.str();
+                                                        size_t      lineCount = std::count(content.begin(), content.end(), '\n') + 1;
+                                                        size_t      byteSize  = content.length();
+
+                                                        std::ostringstream resultJson;
+                                                        resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(fullPath.string())
+                                                            << R"(","content":")" << EscapeJsonString(content)
+                                                            << R"(","lineCount":)" << lineCount
+                                                            << R"(,"byteSize":)" << byteSize << "}";
+                                                        return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                                    }
+                                                    catch (std::exception const& e)
+                                                    {
+                                                        std::string r = R"({"success":false,"error":"Read script file exception: )" + EscapeJsonString(e.what()) + R"("})";
+                                                        return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                    }
+                                                });
 
-                                                      std::ostringstream resultJson;
-                                                      resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(fullPath.string())
-                                                          << R"(","existed":)" << (existed ? "true" : "false") << "}";
-                                                      return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
-                                                  }
-                                                  catch (std::exception const& e)
-                                                  {
-                                                      std::string r = R"({"success":false,"error":"Delete script file exception: )" + EscapeJsonString(e.what()) + R"("})";
-                                                      return HandlerResult::Success({{"resultJson", std::any(r)}});
-                                                  }
-                                              });
+    // game.delete_script_file — Delete a .js file from Scripts directory
+    m_genericCommandDispatcher->RegisterHandler("game.delete_script_file", eCommandAffinity::IO,
+                                                [](std::any const& payload) -> HandlerResult
+                                                {
+                                                    nlohmann::json json;
+                                                    String         err = ParseJsonPayload(payload, json);
+                                                    if (!err.empty()) return HandlerResult::Error(err);
+
+                                                    std::string filePath = json.value("filePath", "");
+
+                                                    std::string validationErr = ValidateJsFilePath(filePath);
+                                                    if (!validationErr.empty()) return HandlerResult::Success({{"resultJson", std::any(validationErr)}});
+
+                                                    // Protected files list
+                                                    static const std::vector<std::string> protectedFiles = {
+                                                        "JSEngine.js", "JSGame.js", "InputSystem.js", "main.js",
+                                                        "kadi/KADIGameControl.js", "kadi/GameControlHandler.js",
+                                                        "kadi/GameControlTools.js", "kadi/DevelopmentToolHandler.js",
+                                                        "kadi/DevelopmentTools.js", "core/Subsystem.js",
+                                                        "components/RendererSystem.js", "components/Prop.js"
+                                                    };
+
+                                                    std::string normalizedPath = filePath;
+                                                    std::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
+
+                                                    for (auto const& pf : protectedFiles)
+                                                    {
+                                                        if (normalizedPath == pf || normalizedPath.find(pf) != std::string::npos)
+                                                        {
+                                                            std::string r = R"({"success":false,"error":"Cannot delete protected file: )" + EscapeJsonString(filePath) + R"("})";
+                                                            return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                        }
+                                                    }
+
+                                                    try
+                                                    {
+                                                        namespace fs = std::filesystem;
+                                                        fs::path scriptsDir = fs::current_path() / "Data" / "Scripts";
+                                                        fs::path fullPath   = scriptsDir / filePath;
+
+                                                        bool existed = fs::exists(fullPath);
+                                                        if (existed) fs::remove(fullPath);
+
+                                                        std::ostringstream resultJson;
+                                                        resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(fullPath.string())
+                                                            << R"(","existed":)" << (existed ? "true" : "false") << "}";
+                                                        return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                                    }
+                                                    catch (std::exception const& e)
+                                                    {
+                                                        std::string r = R"({"success":false,"error":"Delete script file exception: )" + EscapeJsonString(e.what()) + R"("})";
+                                                        return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                    }
+                                                });
+
+    // game.bake_meshes — Write .dmesh entries for every .obj under a directory (default: Data)
+    // so later runs skip OBJ parsing. Entries that already match their source are left alone
+    // unless force is set.
+    m_genericCommandDispatcher->RegisterHandler("game.bake_meshes", eCommandAffinity::IO,
+                                                [this](std::any const& payload) -> HandlerResult
+                                                {
+                                                    nlohmann::json json;
+                                                    String         err = ParseJsonPayload(payload, json);
+                                                    if (!err.empty()) return HandlerResult::Error(err);
+
+                                                    std::string directory = json.value("directory", "Data");
+                                                    bool        force     = json.value("force", false);
+
+                                                    BinaryMeshCache const& binaryCache = m_modelLoader->GetBinaryCache();
+                                                    if (!binaryCache.IsEnabled())
+                                                    {
+                                                        std::string r = R"({"success":false,"error":"Binary mesh cache is disabled (EntityRender.json meshCacheDirectory)"})";
+                                                        return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                    }
+
+                                                    namespace fs = std::filesystem;
+                                                    fs::path const directoryPath(directory);
+                                                    if (directory.empty() || directoryPath.is_absolute() || directory.find("..") != std::string::npos)
+                                                    {
+                                                        std::string r = R"({"success":false,"error":"directory must be relative to the working directory: )" + EscapeJsonString(directory) + R"("})";
+                                                        return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                    }
+
+                                                    sMeshBakeSummary const summary = binaryCache.BakeDirectory(directory, force);
+
+                                                    DAEMON_LOG(LogApp, eLogVerbosity::Log,
+                                                               Stringf("GenericCommand [game.bake_meshes]: %s baked=%u upToDate=%u failed=%u (%.1fms)",
+                                                                   directory.c_str(), summary.baked, summary.upToDate, summary.failed, summary.elapsedMs));
+
+                                                    std::ostringstream resultJson;
+                                                    resultJson << std::fixed << std::setprecision(1)
+                                                        << R"({"success":true,"directory":")" << EscapeJsonString(directory)
+                                                        << R"(","cacheDirectory":")" << EscapeJsonString(binaryCache.GetDirectory())
+                                                        << R"(","baked":)" << summary.baked
+                                                        << R"(,"upToDate":)" << summary.upToDate
+                                                        << R"(,"failed":)" << summary.failed
+                                                        << R"(,"bytes":)" << summary.bytes
+                                                        << R"(,"elapsedMs":)" << summary.elapsedMs << "}";
+                                                    return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                                });
 
     // game.inject_key_press — Inject a single key press with duration
     m_genericCommandExecutor->RegisterHandler("game.inject_key_press",
@@ -1811,8 +3090,9 @@ void App::Startup()
                                               });
 
     // game.add_watched_file — Add a .js file to hot-reload file watcher
+    // (event-driven hot reload watches every script; this undoes remove_watched_file)
     m_genericCommandExecutor->RegisterHandler("game.add_watched_file",
-                                              [](std::any const& payload) -> HandlerResult
+                                              [this](std::any const& payload) -> HandlerResult
                                               {
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
@@ -1829,7 +3109,14 @@ void App::Startup()
                                                   }
 
                                                   std::string relativePath = "Data/Scripts/" + filePath;
-                                                  g_scriptSubsystem->AddWatchedFile(relativePath);
+                                                  if (m_scriptHotReloader)
+                                                  {
+                                                      m_scriptHotReloader->SetFileIgnored(filePath, false);
+                                                  }
+                                                  else
+                                                  {
+                                                      g_scriptSubsystem->AddWatchedFile(relativePath);
+                                                  }
 
                                                   std::ostringstream resultJson;
                                                   resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(filePath)
@@ -1839,7 +3126,7 @@ void App::Startup()
 
     // game.remove_watched_file — Remove a .js file from hot-reload file watcher
     m_genericCommandExecutor->RegisterHandler("game.remove_watched_file",
-                                              [](std::any const& payload) -> HandlerResult
+                                              [this](std::any const& payload) -> HandlerResult
                                               {
                                                   nlohmann::json json;
                                                   String         err = ParseJsonPayload(payload, json);
@@ -1861,7 +3148,14 @@ void App::Startup()
                                                   }
 
                                                   std::string relativePath = "Data/Scripts/" + filePath;
-                                                  g_scriptSubsystem->RemoveWatchedFile(relativePath);
+                                                  if (m_scriptHotReloader)
+                                                  {
+                                                      m_scriptHotReloader->SetFileIgnored(filePath, true);
+                                                  }
+                                                  else
+                                                  {
+                                                      g_scriptSubsystem->RemoveWatchedFile(relativePath);
+                                                  }
 
                                                   std::ostringstream resultJson;
                                                   resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(filePath)
@@ -1869,82 +3163,118 @@ void App::Startup()
                                                   return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
                                               });
 
-
-    // game.capture_screenshot — Capture current frame as PNG or JPEG
-    m_genericCommandExecutor->RegisterHandler("game.capture_screenshot",
-                                              [](std::any const& payload) -> HandlerResult
+    // game.get_hot_reload_stats — Event-driven hot reload: module graph, reload counts, save-to-live latency
+    m_genericCommandExecutor->RegisterHandler("game.get_hot_reload_stats",
+                                              [this](std::any const& /*payload*/) -> HandlerResult
                                               {
-                                                  nlohmann::json json;
-                                                  String         err = ParseJsonPayload(payload, json);
-                                                  if (!err.empty()) return HandlerResult::Error(err);
-
-                                                  std::string format  = json.value("format", "png");
-                                                  int         quality = json.value("quality", 90);
-                                                  std::string name    = json.value("filename", "");
-
-                                                  // Auto-generate filename if not provided
-                                                  if (name.empty())
+                                                  if (!m_scriptHotReloader)
                                                   {
-                                                      auto        now       = std::chrono::system_clock::now();
-                                                      std::time_t nowTime   = std::chrono::system_clock::to_time_t(now);
-                                                      std::tm     localTime = {};
-                                                      localtime_s(&localTime, &nowTime);
-
-                                                      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                                          now.time_since_epoch()) % 1000;
-
-                                                      std::ostringstream oss;
-                                                      oss << "screenshot_"
-                                                          << std::put_time(&localTime, "%Y-%m-%d_%H%M%S")
-                                                          << "_" << std::setfill('0') << std::setw(3) << ms.count();
-                                                      name = oss.str();
+                                                      return HandlerResult::Success({{"resultJson", std::any(std::string(R"({"success":true,"mode":"polling"})"))}});
                                                   }
 
-                                                  // Output directory: Run/Screenshots/
-                                                  namespace fs = std::filesystem;
-                                                  fs::path outputDir = fs::current_path() / "Screenshots";
-
-                                                  std::string outFilePath;
-                                                  bool        success = g_renderer->CaptureScreenshot(
-                                                      outputDir.string(), name, format, quality, outFilePath);
-
-                                                  if (!success)
-                                                  {
-                                                      std::string r = R"({"success":false,"error":"Screenshot capture failed"})";
-                                                      return HandlerResult::Success({{"resultJson", std::any(r)}});
-                                                  }
+                                                  sScriptHotReloadStats const stats   = m_scriptHotReloader->GetStats();
+                                                  sScriptWatcherStats const   watcher = m_scriptHotReloader->GetWatcherStats();
+                                                  sScriptReloadRecord const&  last    = stats.last;
+                                                  double const                average = stats.reloads > 0 ? stats.totalSaveToLiveMs / static_cast<double>(stats.reloads) : 0.0;
 
-                                                  // Get file size and read file as binary for base64 encoding
-                                                  uintmax_t   fileSize = 0;
-                                                  std::string imageBase64;
-                                                  if (fs::exists(outFilePath))
+                                                  std::ostringstream resultJson;
+                                                  resultJson << std::fixed << std::setprecision(2)
+                                                      << R"({"success":true,"mode":"events")"
+                                                      << R"(,"modules":)" << stats.moduleCount
+                                                      << R"(,"reloadBoundaries":)" << stats.boundaryCount
+                                                      << R"(,"ignoredFiles":)" << stats.ignoredCount
+                                                      << R"(,"reloads":)" << stats.reloads
+                                                      << R"(,"fullReloads":)" << stats.fullReloads
+                                                      << R"(,"failures":)" << stats.failures
+                                                      << R"(,"modulesExecuted":)" << stats.modulesExecuted
+                                                      << R"(,"unchangedSaves":)" << stats.unchangedSaves
+                                                      << R"(,"skippedChanges":)" << stats.skippedChanges
+                                                      << R"(,"rescans":)" << stats.rescans
+                                                      << R"(,"avgSaveToLiveMs":)" << average
+                                                      << R"(,"maxSaveToLiveMs":)" << stats.maxSaveToLiveMs
+                                                      << R"(,"watcher":{"isRunning":)" << (watcher.isRunning ? "true" : "false")
+                                                      << R"(,"notifications":)" << watcher.notifications
+                                                      << R"(,"fileEvents":)" << watcher.fileEvents
+                                                      << R"(,"changesReady":)" << watcher.changesReady
+                                                      << R"(,"overflows":)" << watcher.overflows << "}";
+                                                  if (stats.reloads + stats.failures > 0)
                                                   {
-                                                      fileSize = fs::file_size(outFilePath);
-
-                                                      // Read file into binary buffer
-                                                      std::ifstream file(outFilePath, std::ios::binary);
-                                                      if (file)
-                                                      {
-                                                          std::vector<unsigned char> fileData(
-                                                              (std::istreambuf_iterator<char>(file)),
-                                                              std::istreambuf_iterator<char>());
-                                                          imageBase64 = KADIAuthenticationUtility::Base64Encode(fileData);
-                                                      }
+                                                      resultJson << R"(,"last":{"isSuccess":)" << (last.isSuccess ? "true" : "false")
+                                                          << R"(,"isFullReload":)" << (last.isFullReload ? "true" : "false")
+                                                          << R"(,"changed":")" << EscapeJsonString(last.firstChanged)
+                                                          << R"(","changedCount":)" << last.changedCount
+                                                          << R"(,"moduleCount":)" << last.moduleCount
+                                                          << R"(,"saveToDetectMs":)" << last.saveToDetectMs
+                                                          << R"(,"debounceMs":)" << last.debounceMs
+                                                          << R"(,"executeMs":)" << last.executeMs
+                                                          << R"(,"saveToLiveMs":)" << last.saveToLiveMs << "}";
                                                   }
-
-                                                  std::string mimeType = (format == "jpeg" || format == "jpg")
-                                                                             ? "image/jpeg"
-                                                                             : "image/png";
-
-                                                  std::ostringstream resultJson;
-                                                  resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(outFilePath)
-                                                      << R"(","format":")" << format
-                                                      << R"(","fileSize":)" << fileSize
-                                                      << R"(,"mimeType":")" << mimeType
-                                                      << R"(","imageData":")" << imageBase64 << R"("})";
+                                                  resultJson << "}";
                                                   return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
                                               });
 
+
+    // game.capture_screenshot — Capture current frame as PNG or JPEG
+    // The Renderer writes the file on the main thread; reading it back and base64-encoding it (tens
+    // of milliseconds for a 1080p PNG) runs on the IO lane. Same-frame requests share one capture.
+    auto const lastScreenshot = std::make_shared<std::weak_ptr<sScreenshotCapture>>();
+
+    m_genericCommandDispatcher->RegisterDeferredHandler("game.capture_screenshot",
+                                                        [this, lastScreenshot](std::any const& payload, DeferredCommandToken const token)
+                                                        {
+                                                            if (IsHeadless())
+                                                            {
+                                                                m_genericCommandDispatcher->CompleteDeferred(token, MakeHeadlessError("game.capture_screenshot"), 0.0);
+                                                                return;
+                                                            }
+
+                                                            nlohmann::json json;
+                                                            String         err = ParseJsonPayload(payload, json);
+                                                            if (!err.empty())
+                                                            {
+                                                                m_genericCommandDispatcher->CompleteDeferred(token, HandlerResult::Error(err), 0.0);
+                                                                return;
+                                                            }
+
+                                                            bool                       isCoalesced = false;
+                                                            ScreenshotCapturePtr const capture     = CaptureScreenshot(json, *lastScreenshot, isCoalesced);
+                                                            if (!capture)
+                                                            {
+                                                                std::string r = R"({"success":false,"error":"Screenshot capture failed"})";
+                                                                m_genericCommandDispatcher->CompleteDeferred(token, HandlerResult::Success({{"resultJson", std::any(r)}}), 0.0);
+                                                                return;
+                                                            }
+
+                                                            bool const isIncludeImage = json.value("includeImage", true);
+                                                            m_genericCommandDispatcher->ContinueDeferred(token, eCommandAffinity::IO,
+                                                                [capture, isIncludeImage, isCoalesced](std::any const&) -> HandlerResult
+                                                                {
+                                                                    std::string const r = BuildScreenshotResultJson(*capture, isIncludeImage, isCoalesced);
+                                                                    return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                                },
+                                                                std::any());
+                                                        },
+                                                        [lastScreenshot](std::any const& payload) -> HandlerResult
+                                                        {
+                                                            // Dispatcher bypassed (asyncDispatch off): encode inline, as before
+                                                            if (IsHeadless()) return MakeHeadlessError("game.capture_screenshot");
+
+                                                            nlohmann::json json;
+                                                            String         err = ParseJsonPayload(payload, json);
+                                                            if (!err.empty()) return HandlerResult::Error(err);
+
+                                                            bool                       isCoalesced = false;
+                                                            ScreenshotCapturePtr const capture     = CaptureScreenshot(json, *lastScreenshot, isCoalesced);
+                                                            if (!capture)
+                                                            {
+                                                                std::string r = R"({"success":false,"error":"Screenshot capture failed"})";
+                                                                return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                            }
+
+                                                            std::string const r = BuildScreenshotResultJson(*capture, json.value("includeImage", true), isCoalesced);
+                                                            return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                        });
+
     // game.validate_script — Parse JS source via V8 without execution, return syntax errors
     m_genericCommandExecutor->RegisterHandler("game.validate_script",
                                               [](std::any const& payload) -> HandlerResult
@@ -2024,47 +3354,270 @@ void App::Startup()
                                                   return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
                                               });
 
-    // game.get_entity_list — Enumerate all active entities with type, position, and ID
+    // game.get_entity_list — Active entities with type, transform, color and ID, as versioned pages
+    // (EntitySnapshot.hpp): sinceVersion / cursor / limit / fields / encoding "json" | "binary". A
+    // structured request gets the same page as an ENTITY_LIST ring record (all fields, no encoding)
     m_genericCommandExecutor->RegisterHandler("game.get_entity_list",
-                                              [this](std::any const&) -> HandlerResult
+                                              [this](std::any const& payload) -> HandlerResult
                                               {
-                                                  if (!m_entityStateBuffer)
+                                                  // The payload is optional here; only a structured request needs one
+                                                  nlohmann::json json;
+                                                  uint32_t const resultToken  = ParseJsonPayload(payload, json).empty() ? GetResultToken(json) : 0u;
+                                                  bool const     isStructured = resultToken != 0 && m_callbackResultRing && m_callbackResultRing->IsInstalled();
+
+                                                  if (!m_entityStore)
                                                   {
+                                                      if (isStructured)
+                                                      {
+                                                          m_callbackResultRing->WriteError(resultToken, eCallbackResultError::NOT_AVAILABLE);
+                                                          return HandlerResult::Success();
+                                                      }
                                                       return HandlerResult::Success({{"resultJson", std::any(std::string(
-                                                          R"({"success":false,"error":"EntityStateBuffer not available"})"))}});
+                                                          R"({"success":false,"error":"EntityStore not available"})"))}});
+                                                  }
+
+                                                  // Versioned page: entities changed since sinceVersion (0 = all), resumable with cursor
+                                                  if (!json.is_object()) json = nlohmann::json::object();
+
+                                                  uint64_t const sinceVersion = json.value("sinceVersion", static_cast<uint64_t>(0));
+                                                  uint32_t const pageLimit    = static_cast<uint32_t>(std::max(json.value("limit", 1000), 1));
+                                                  String const   cursorText   = json.value("cursor", String());
+                                                  String const   encoding     = json.value("encoding", String("json"));
+
+                                                  sEntityChangeCursor cursor;
+                                                  if (!cursorText.empty() && !ParseEntityChangeCursor(cursorText, cursor))
+                                                  {
+                                                      if (isStructured) m_callbackResultRing->WriteError(resultToken, eCallbackResultError::INVALID_PARAM);
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: malformed cursor");
+                                                  }
+
+                                                  if (isStructured)
+                                                  {
+                                                      sEntitySnapshotPage page;
+                                                      CollectEntitySnapshotPage(*m_entityStore, sinceVersion, cursor, pageLimit, page);
+
+                                                      SyncResultRingMeshTypes();
+                                                      m_resultRingScratch.clear();
+
+                                                      sEntityArrays const& front        = m_entityStore->GetFront();
+                                                      uint32_t             count        = 0;
+                                                      uint32_t             removedCount = 0;
+                                                      for (sEntityChange const& change : page.changes)
+                                                      {
+                                                          if (change.isRemoved)
+                                                          {
+                                                              ++removedCount;
+                                                              continue;
+                                                          }
+
+                                                          uint32_t const     slot        = change.slot;
+                                                          Vec3 const&        position    = front.positions[slot];
+                                                          EulerAngles const& orientation = front.orientations[slot];
+                                                          Rgba8 const&       color       = front.colors[slot];
+                                                          uint32_t const     packedColor = static_cast<uint32_t>(color.r) | (static_cast<uint32_t>(color.g) << 8) |
+                                                                                           (static_cast<uint32_t>(color.b) << 16) | (static_cast<uint32_t>(color.a) << 24);
+
+                                                          m_resultRingScratch.insert(m_resultRingScratch.end(), {
+                                                              static_cast<double>(change.entityId),
+                                                              position.x, position.y, position.z,
+                                                              orientation.m_yawDegrees, orientation.m_pitchDegrees, orientation.m_rollDegrees,
+                                                              front.radii[slot],
+                                                              static_cast<double>(packedColor),
+                                                              static_cast<double>(front.meshHandles[slot]),
+                                                              static_cast<double>(static_cast<uint8_t>(front.cameraTypeIds[slot]))});
+                                                          ++count;
+                                                      }
+
+                                                      // Page trailer (CallbackResultRing.hpp ENTITY_LIST), then the removed IDs
+                                                      m_resultRingScratch.insert(m_resultRingScratch.end(), {
+                                                          static_cast<double>(page.version),
+                                                          static_cast<double>(page.sinceVersion),
+                                                          static_cast<double>((page.isFullSnapshot ? ENTITY_LIST_FLAG_FULL_SNAPSHOT : 0u) |
+                                                                              (page.hasMore ? ENTITY_LIST_FLAG_HAS_MORE : 0u)),
+                                                          static_cast<double>(page.nextCursor.version),
+                                                          static_cast<double>(page.nextCursor.slot),
+                                                          static_cast<double>(removedCount)});
+                                                      for (sEntityChange const& change : page.changes)
+                                                      {
+                                                          if (change.isRemoved) m_resultRingScratch.push_back(static_cast<double>(change.entityId));
+                                                      }
+
+                                                      m_callbackResultRing->WriteRecord(resultToken, eCallbackResultKind::ENTITY_LIST, count,
+                                                                                        m_resultRingScratch.data(), static_cast<uint32_t>(m_resultRingScratch.size()));
+                                                      return HandlerResult::Success();
+                                                  }
+
+                                                  if (encoding != "json" && encoding != "binary")
+                                                  {
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: encoding must be 'json' or 'binary'");
+                                                  }
+
+                                                  uint32_t fieldMask = ENTITY_FIELD_ALL;
+                                                  if (json.contains("fields") && json["fields"].is_array())
+                                                  {
+                                                      fieldMask = 0;
+                                                      for (nlohmann::json const& field : json["fields"])
+                                                      {
+                                                          uint32_t const bit = field.is_string() ? ParseEntityFieldName(field.get<String>()) : 0u;
+                                                          if (bit == 0)
+                                                          {
+                                                              return HandlerResult::Error(Stringf("ERR_INVALID_PARAM: unknown field %s", field.dump().c_str()));
+                                                          }
+                                                          fieldMask |= bit;
+                                                      }
                                                   }
 
-                                                  EntityStateMap const* frontBuffer = m_entityStateBuffer->GetFrontBuffer();
-                                                  if (!frontBuffer)
+                                                  sEntitySnapshotPage page;
+                                                  CollectEntitySnapshotPage(*m_entityStore, sinceVersion, cursor, pageLimit, page);
+
+                                                  return HandlerResult::Success({{"resultJson", std::any(WriteEntitySnapshotJson(*m_entityStore, page, fieldMask, encoding == "binary"))}});
+                                              });
+
+    // game.query_entities_radius — Entities whose bounding sphere overlaps a sphere (spatial grid, front buffer)
+    m_genericCommandExecutor->RegisterHandler("game.query_entities_radius",
+                                              [this](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  uint32_t const resultToken  = GetResultToken(json);
+                                                  bool const     isStructured = resultToken != 0 && m_callbackResultRing && m_callbackResultRing->IsInstalled();
+
+                                                  if (!m_entityStore)
                                                   {
+                                                      if (isStructured)
+                                                      {
+                                                          m_callbackResultRing->WriteError(resultToken, eCallbackResultError::NOT_AVAILABLE);
+                                                          return HandlerResult::Success();
+                                                      }
                                                       return HandlerResult::Success({{"resultJson", std::any(std::string(
-                                                          R"({"success":true,"entities":[],"count":0})"))}});
+                                                          R"({"success":false,"error":"EntityStore not available"})"))}});
+                                                  }
+
+                                                  Vec3  center = ParseVec3(json, "center");
+                                                  float radius = json.value("radius", 10.f);
+                                                  int   limit  = json.value("limit", 1000);
+                                                  if (radius < 0.f)
+                                                  {
+                                                      if (isStructured) m_callbackResultRing->WriteError(resultToken, eCallbackResultError::INVALID_PARAM);
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: radius must be >= 0");
+                                                  }
+
+                                                  std::vector<uint32_t> slots;
+                                                  m_entityStore->GetSpatialGrid().QueryRadius(center, radius, slots);
+
+                                                  sEntityArrays const& front = m_entityStore->GetFront();
+
+                                                  if (isStructured)
+                                                  {
+                                                      SyncResultRingMeshTypes();
+                                                      m_resultRingScratch.clear();
+
+                                                      uint32_t count = 0;
+                                                      for (uint32_t const slot : slots)
+                                                      {
+                                                          if (static_cast<int>(count) >= limit) break;
+
+                                                          Vec3 const& position = front.positions[slot];
+                                                          m_resultRingScratch.insert(m_resultRingScratch.end(), {
+                                                              static_cast<double>(front.ids[slot]),
+                                                              position.x, position.y, position.z,
+                                                              (position - center).GetLength(),
+                                                              static_cast<double>(front.meshHandles[slot])});
+                                                          ++count;
+                                                      }
+                                                      m_resultRingScratch.push_back(static_cast<double>(slots.size()));
+
+                                                      m_callbackResultRing->WriteRecord(resultToken, eCallbackResultKind::ENTITY_QUERY, count,
+                                                                                        m_resultRingScratch.data(), static_cast<uint32_t>(m_resultRingScratch.size()));
+                                                      return HandlerResult::Success();
                                                   }
 
                                                   std::ostringstream resultJson;
                                                   resultJson << R"({"success":true,"entities":[)";
 
                                                   int count = 0;
-                                                  int limit = 1000;
-                                                  for (auto const& [entityId, state] : *frontBuffer)
+                                                  for (uint32_t const slot : slots)
                                                   {
-                                                      if (!state.isActive) continue;
                                                       if (count >= limit) break;
 
+                                                      Vec3 const& position = front.positions[slot];
                                                       if (count > 0) resultJson << ",";
-                                                      resultJson << R"({"entityId":)" << entityId
-                                                                 << R"(,"type":")" << EscapeJsonString(state.meshType)
-                                                                 << R"(","position":[)"
-                                                                 << state.position.x << "," << state.position.y << "," << state.position.z
-                                                                 << R"(],"orientation":[)"
-                                                                 << state.orientation.m_yawDegrees << "," << state.orientation.m_pitchDegrees << "," << state.orientation.m_rollDegrees
-                                                                 << R"(],"scale":)" << state.radius
-                                                                 << R"(,"color":[)" << (int)state.color.r << "," << (int)state.color.g << "," << (int)state.color.b << "," << (int)state.color.a
-                                                                 << R"(],"cameraType":")" << EscapeJsonString(state.cameraType) << R"("})";
+                                                      resultJson << R"({"entityId":)" << front.ids[slot]
+                                                                 << R"(,"type":")" << EscapeJsonString(front.meshTypes[slot])
+                                                                 << R"(","position":[)" << position.x << "," << position.y << "," << position.z
+                                                                 << R"(],"distance":)" << (position - center).GetLength() << "}";
                                                       ++count;
                                                   }
 
-                                                  resultJson << R"(],"count":)" << count << "}";
+                                                  resultJson << R"(],"count":)" << count << R"(,"totalMatches":)" << slots.size() << "}";
+
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // game.raycast_entities — Nearest entity bounding sphere hit along a ray (spatial grid, front buffer)
+    m_genericCommandExecutor->RegisterHandler("game.raycast_entities",
+                                              [this](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  uint32_t const resultToken  = GetResultToken(json);
+                                                  bool const     isStructured = resultToken != 0 && m_callbackResultRing && m_callbackResultRing->IsInstalled();
+
+                                                  if (!m_entityStore)
+                                                  {
+                                                      if (isStructured)
+                                                      {
+                                                          m_callbackResultRing->WriteError(resultToken, eCallbackResultError::NOT_AVAILABLE);
+                                                          return HandlerResult::Success();
+                                                      }
+                                                      return HandlerResult::Success({{"resultJson", std::any(std::string(
+                                                          R"({"success":false,"error":"EntityStore not available"})"))}});
+                                                  }
+
+                                                  Vec3  origin      = ParseVec3(json, "origin");
+                                                  Vec3  direction   = ParseVec3(json, "direction", Vec3(1.f, 0.f, 0.f));
+                                                  float maxDistance = json.value("maxDistance", 1000.f);
+                                                  if (direction.GetLengthSquared() <= 0.f)
+                                                  {
+                                                      if (isStructured) m_callbackResultRing->WriteError(resultToken, eCallbackResultError::INVALID_PARAM);
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: direction must be non-zero");
+                                                  }
+                                                  direction = direction.GetNormalized();
+
+                                                  sSpatialRayHit hit;
+                                                  if (!m_entityStore->GetSpatialGrid().Raycast(origin, direction, maxDistance, hit))
+                                                  {
+                                                      if (isStructured)
+                                                      {
+                                                          m_callbackResultRing->WriteRecord(resultToken, eCallbackResultKind::RAYCAST, 0, nullptr, 0);
+                                                          return HandlerResult::Success();
+                                                      }
+                                                      return HandlerResult::Success({{"resultJson", std::any(std::string(
+                                                          R"({"success":true,"hit":false})"))}});
+                                                  }
+
+                                                  sEntityArrays const& front = m_entityStore->GetFront();
+                                                  Vec3 const           point = origin + direction * hit.distance;
+
+                                                  if (isStructured)
+                                                  {
+                                                      SyncResultRingMeshTypes();
+
+                                                      double const values[RAYCAST_STRIDE] = {static_cast<double>(front.ids[hit.slot]), hit.distance, point.x, point.y, point.z,
+                                                                                             static_cast<double>(front.meshHandles[hit.slot])};
+                                                      m_callbackResultRing->WriteRecord(resultToken, eCallbackResultKind::RAYCAST, 1, values, RAYCAST_STRIDE);
+                                                      return HandlerResult::Success();
+                                                  }
+
+                                                  std::ostringstream resultJson;
+                                                  resultJson << R"({"success":true,"hit":true,"entityId":)" << front.ids[hit.slot]
+                                                             << R"(,"type":")" << EscapeJsonString(front.meshTypes[hit.slot])
+                                                             << R"(","distance":)" << hit.distance
+                                                             << R"(,"point":[)" << point.x << "," << point.y << "," << point.z << "]}";
 
                                                   return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
                                               });
@@ -2077,12 +3630,11 @@ void App::Startup()
                                                   double deltaSeconds = Clock::GetSystemClock().GetDeltaSeconds();
                                                   double fps = (deltaSeconds > 0.0) ? (1.0 / deltaSeconds) : 0.0;
 
-                                                  // Entity count from EntityStateBuffer
+                                                  // Entity count from EntityStore (live slots)
                                                   int entityCount = 0;
-                                                  if (m_entityStateBuffer)
+                                                  if (m_entityStore)
                                                   {
-                                                      EntityStateMap const* frontBuffer = m_entityStateBuffer->GetFrontBuffer();
-                                                      if (frontBuffer) entityCount = static_cast<int>(frontBuffer->size());
+                                                      entityCount = static_cast<int>(m_entityStore->GetLiveCount());
                                                   }
 
                                                   // Memory usage via Windows API
@@ -2099,12 +3651,430 @@ void App::Startup()
                                                              << R"(,"entityCount":)" << entityCount
                                                              << R"(,"memoryUsageMB":)" << memoryMB
                                                              << R"(,"frameCount":)" << Clock::GetSystemClock().GetFrameCount()
+                                                             << R"(,"headless":)" << (m_isHeadless ? "true" : "false");
+
+                                                  auto appendSwapStats = [&resultJson](char const* name, sStateBufferSwapStats const& stats)
+                                                  {
+                                                      resultJson << R"(")" << name << R"(":{"lastSwapMs":)" << std::setprecision(3) << stats.lastSwapMs
+                                                                 << R"(,"maxSwapMs":)" << stats.maxSwapMs << std::setprecision(1)
+                                                                 << R"(,"lastEntriesCopied":)" << stats.lastEntriesCopied
+                                                                 << R"(,"totalEntriesCopied":)" << stats.totalEntriesCopied
+                                                                 << R"(,"swaps":)" << stats.swapCount
+                                                                 << R"(,"skippedSwaps":)" << stats.skippedSwapCount
+                                                                 << "}";
+                                                  };
+                                                  resultJson << R"(,"stateBufferSwap":{)";
+                                                  appendSwapStats("entity", m_entitySwapStats);
+                                                  resultJson << ",";
+                                                  appendSwapStats("camera", m_cameraSwapStats);
+                                                  resultJson << ",";
+                                                  appendSwapStats("audio", m_audioSwapStats);
+                                                  resultJson << "}";
+
+                                                  resultJson << R"(,"renderEntities":{"lastDrawn":)" << m_entityRenderStats.lastDrawnEntities
+                                                             << R"(,"lastCulled":)" << m_entityRenderStats.lastCulledEntities
+                                                             << R"(,"culling":)" << (m_isFrustumCullingEnabled ? "true" : "false")
+                                                             << R"(,"lastDrawCalls":)" << m_entityRenderStats.lastDrawCalls
+                                                             << R"(,"lastBatchedEntities":)" << m_entityRenderStats.lastBatchedEntities
+                                                             << R"(,"batching":)" << (m_isEntityBatchingEnabled ? "true" : "false")
+                                                             << R"(,"staticBatches":)" << (m_entityBatchRenderer ? m_entityBatchRenderer->GetBatchCount() : 0u)
+                                                             << R"(,"batchBuilds":)" << (m_entityBatchRenderer ? m_entityBatchRenderer->GetBuildCount() : 0u)
+                                                             << R"(,"batchInvalidations":)" << (m_entityBatchRenderer ? m_entityBatchRenderer->GetInvalidationCount() : 0u)
+                                                             << R"(,"allocationCounting":)" << (AllocationCounter::IsEnabled() ? "true" : "false")
+                                                             << R"(,"lastAllocations":)" << m_entityRenderStats.lastAllocations
+                                                             << R"(,"maxAllocations":)" << m_entityRenderStats.maxAllocations
+                                                             << R"(,"meshHandles":)" << (m_meshHandleTable ? m_meshHandleTable->GetCount() : 0u)
                                                              << "}";
 
-                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
-                                              });
+                                                  if (m_gpuMeshCache)
+                                                  {
+                                                      resultJson << R"(,"gpuMeshCache":{"hits":)" << m_gpuMeshCache->GetHitCount()
+                                                                 << R"(,"misses":)" << m_gpuMeshCache->GetMissCount()
+                                                                 << R"(,"evictions":)" << m_gpuMeshCache->GetEvictionCount()
+                                                                 << R"(,"residentMeshes":)" << m_gpuMeshCache->GetResidentCount()
+                                                                 << R"(,"residentBytes":)" << m_gpuMeshCache->GetResidentBytes()
+                                                                 << R"(,"budgetBytes":)" << m_gpuMeshCache->GetBudgetBytes()
+                                                                 << "}";
+                                                  }
 
-    // game.list_scripts — Return all loaded scripts with path, name, and active status
+                                                  if (g_game)
+                                                  {
+                                                      sJSWorkerCallStats const jsStats = g_game->GetJSWorkerCallStats();
+                                                      double const savingsMs = (jsStats.directFrames > 0 && jsStats.evalFrames > 0) ? (jsStats.avgEvalMs - jsStats.avgDirectMs) : 0.0;
+
+                                                      resultJson << std::setprecision(3)
+                                                                 << R"(,"jsWorker":{"directCalls":)" << (jsStats.isDirectEnabled ? "true" : "false")
+                                                                 << R"(,"bound":)" << (jsStats.isBound ? "true" : "false")
+                                                                 << R"(,"lastUpdateMs":)" << jsStats.lastUpdateMs
+                                                                 << R"(,"lastRenderMs":)" << jsStats.lastRenderMs
+                                                                 << R"(,"avgDirectMs":)" << jsStats.avgDirectMs
+                                                                 << R"(,"avgEvalMs":)" << jsStats.avgEvalMs
+                                                                 << R"(,"savingsMs":)" << savingsMs
+                                                                 << R"(,"directFrames":)" << jsStats.directFrames
+                                                                 << R"(,"evalFrames":)" << jsStats.evalFrames
+                                                                 << R"(,"rebinds":)" << jsStats.rebindCount
+                                                                 << "}" << std::setprecision(1);
+                                                  }
+
+                                                  resultJson << R"(,"jsPipeline":{"mode":")" << (m_jsFramePipeline ? "pipelined" : "lockstep")
+                                                             << R"(","workerFrames":)" << (m_jsGameLogicJob ? m_jsGameLogicJob->GetTotalFrames() : 0ull);
+                                                  if (m_jsFramePipeline)
+                                                  {
+                                                      sJSFramePipelineStats const pipelineStats = m_jsFramePipeline->GetStats();
+                                                      resultJson << R"(,"depth":)" << pipelineStats.depth
+                                                                 << R"(,"occupancy":)" << pipelineStats.occupancy
+                                                                 << R"(,"published":)" << pipelineStats.publishedFrames
+                                                                 << R"(,"consumed":)" << pipelineStats.consumedFrames
+                                                                 << R"(,"workerStalls":)" << pipelineStats.workerStalls
+                                                                 << std::setprecision(3)
+                                                                 << R"(,"lastLatencyMs":)" << pipelineStats.lastLatencyMs
+                                                                 << R"(,"avgLatencyMs":)" << pipelineStats.avgLatencyMs
+                                                                 << R"(,"maxLatencyMs":)" << pipelineStats.maxLatencyMs
+                                                                 << std::setprecision(1);
+                                                  }
+                                                  resultJson << "}";
+
+                                                  resultJson << R"(,"watchdog":{"enabled":)" << (m_jsFrameWatchdog ? "true" : "false");
+                                                  if (m_jsFrameWatchdog)
+                                                  {
+                                                      sJSFrameWatchdogStats const watchdogStats = m_jsFrameWatchdog->GetStats();
+                                                      resultJson << R"(,"level":")" << GetJSWorkShedLevelName(watchdogStats.level)
+                                                                 << R"(","interval":)" << watchdogStats.interval
+                                                                 << R"(,"minPriority":)" << m_jsFrameWatchdog->GetMinPriority()
+                                                                 << std::setprecision(3)
+                                                                 << R"(,"budgetMs":)" << m_jsFrameWatchdog->GetFrameBudgetMs()
+                                                                 << R"(,"lastFrameMs":)" << watchdogStats.lastFrameMs
+                                                                 << R"(,"avgFrameMs":)" << watchdogStats.avgFrameMs
+                                                                 << R"(,"maxFrameMs":)" << watchdogStats.maxFrameMs
+                                                                 << std::setprecision(1)
+                                                                 << R"(,"consecutiveOverruns":)" << watchdogStats.consecutiveOverruns
+                                                                 << R"(,"overrunFrames":)" << watchdogStats.overrunFrames
+                                                                 << R"(,"throttledFrames":)" << watchdogStats.throttledFrames
+                                                                 << R"(,"reducedFrames":)" << watchdogStats.reducedFrames
+                                                                 << R"(,"escalations":)" << watchdogStats.escalations
+                                                                 << R"(,"recoveries":)" << watchdogStats.recoveries
+                                                                 << R"(,"terminations":)" << watchdogStats.terminations;
+                                                  }
+                                                  resultJson << "}";
+
+                                                  sBinaryLoggerStats const binaryLogStats = BinaryLogger::GetStats();
+                                                  resultJson << R"(,"binaryLog":{"running":)" << (binaryLogStats.isRunning ? "true" : "false")
+                                                             << R"(,"written":)" << binaryLogStats.written
+                                                             << R"(,"emitted":)" << binaryLogStats.emitted
+                                                             << R"(,"synchronous":)" << binaryLogStats.synchronous
+                                                             << R"(,"dropped":)" << binaryLogStats.dropped
+                                                             << R"(,"threadRings":)" << binaryLogStats.threadRings
+                                                             << R"(,"maxRingBytes":)" << binaryLogStats.maxRingBytes << "}";
+
+                                                  resultJson << R"(,"gc":{"enabled":)" << (m_jsGCScheduler ? "true" : "false");
+                                                  if (m_jsGCScheduler)
+                                                  {
+                                                      sJSGCStats const gcStats = m_jsGCScheduler->GetStats();
+                                                      resultJson << R"(,"heapUsedMB":)" << gcStats.heapUsedMB
+                                                                 << R"(,"heapTotalMB":)" << gcStats.heapTotalMB
+                                                                 << R"(,"heapSizeLimitMB":)" << gcStats.heapSizeLimitMB
+                                                                 << std::setprecision(3)
+                                                                 << R"(,"heapPressure":)" << gcStats.heapPressure
+                                                                 << R"(,"lastPauseMs":)" << gcStats.lastPauseMs
+                                                                 << R"(,"maxPauseMs":)" << gcStats.maxPauseMs
+                                                                 << R"(,"maxUnscheduledPauseMs":)" << gcStats.maxUnscheduledPauseMs
+                                                                 << R"(,"avgMajorPauseMs":)" << gcStats.avgMajorPauseMs
+                                                                 << std::setprecision(1)
+                                                                 << R"(,"totalPauseMs":)" << gcStats.totalPauseMs
+                                                                 << R"(,"pressureLevel":)" << gcStats.pressureLevel
+                                                                 << R"(,"pressureNotifications":)" << gcStats.pressureNotifications
+                                                                 << R"(,"criticalDefers":)" << gcStats.criticalDefers
+                                                                 << R"(,"idleWindows":)" << gcStats.idleWindows
+                                                                 << R"(,"skippedWindows":)" << gcStats.skippedWindows
+                                                                 << R"(,"idleMsOffered":)" << gcStats.idleMsOffered
+                                                                 << R"(,"idleMsUsed":)" << gcStats.idleMsUsed
+                                                                 << R"(,"idleCollections":)" << gcStats.idleCollections
+                                                                 << R"(,"markingStarts":)" << gcStats.markingStarts
+                                                                 << R"(,"minorGCs":)" << gcStats.minorGCs
+                                                                 << R"(,"majorGCs":)" << gcStats.majorGCs
+                                                                 << R"(,"scheduledGCs":)" << gcStats.scheduledGCs
+                                                                 << R"(,"unscheduledGCs":)" << gcStats.unscheduledGCs
+                                                                 << R"(,"pauseHistogram":{)";
+                                                      for (uint32_t bucket = 0; bucket < sJSGCStats::PAUSE_BUCKETS; ++bucket)
+                                                      {
+                                                          resultJson << (bucket > 0 ? "," : "") << R"(")" << sJSGCStats::GetPauseBucketLabel(bucket)
+                                                                     << R"(":)" << gcStats.pauseHistogram[bucket];
+                                                      }
+                                                      resultJson << "}";
+                                                  }
+                                                  resultJson << "}";
+
+                                                  resultJson << R"(,"simulation":{"mode":")" << (m_simulationScheduler ? "fixed" : "variable") << R"(")";
+                                                  if (m_simulationScheduler)
+                                                  {
+                                                      sFixedTimestepStats const simStats = m_simulationScheduler->GetStats();
+                                                      resultJson << R"(,"tickRate":)" << simStats.tickRate
+                                                                 << R"(,"maxCatchUp":)" << simStats.maxCatchUpTicks
+                                                                 << R"(,"lastTicks":)" << simStats.lastTicks
+                                                                 << R"(,"totalTicks":)" << simStats.totalTicks
+                                                                 << R"(,"droppedTicks":)" << simStats.droppedTicks
+                                                                 << std::setprecision(3)
+                                                                 << R"(,"accumulatorMs":)" << simStats.accumulatorMs
+                                                                 << R"(,"alpha":)" << m_simulationScheduler->GetInterpolationAlpha()
+                                                                 << std::setprecision(1)
+                                                                 << R"(,"interpolation":)" << (m_entityStore->IsInterpolationEnabled() ? "true" : "false");
+                                                  }
+                                                  resultJson << "}";
+
+                                                  if (m_jsWorkerPool)
+                                                  {
+                                                      sJSWorkerPoolStats const poolStats = m_jsWorkerPool->GetStats();
+                                                      resultJson << R"(,"jsWorkerPool":{"isolates":)" << poolStats.shardCount
+                                                                 << R"(,"readyIsolates":)" << poolStats.readyShards
+                                                                 << R"(,"frames":)" << poolStats.frames
+                                                                 << std::setprecision(3)
+                                                                 << R"(,"lastFrameMs":)" << poolStats.lastFrameMs
+                                                                 << std::setprecision(1)
+                                                                 << R"(,"lastRecords":)" << poolStats.lastRecords
+                                                                 << R"(,"totalRecords":)" << poolStats.totalRecords
+                                                                 << R"(,"partitionViolations":)" << poolStats.partitionViolations
+                                                                 << R"(,"overflows":)" << poolStats.overflows
+                                                                 << R"(,"exceptions":)" << poolStats.exceptions
+                                                                 << R"(,"slowestInitMs":)" << poolStats.slowestInitMs
+                                                                 << "}";
+                                                  }
+
+                                                  if (m_typedCommandBuffer)
+                                                  {
+                                                      resultJson << R"(,"typedCommands":{"capacity":)" << m_typedCommandBuffer->GetCapacity()
+                                                                 << R"(,"lastFrame":)" << m_typedCommandBuffer->GetLastDrainCount()
+                                                                 << R"(,"total":)" << m_typedCommandBuffer->GetTotalRecords()
+                                                                 << R"(,"overflows":)" << m_typedCommandBuffer->GetTotalOverflows()
+                                                                 << R"(,"flushed":)" << m_typedCommandBuffer->GetTotalFlushed()
+                                                                 << R"(,"invalid":)" << m_typedCommandBuffer->GetTotalInvalid()
+                                                                 << "}";
+                                                  }
+                                                  if (m_callbackResultRing && m_callbackResultRing->IsInstalled())
+                                                  {
+                                                      sCallbackResultRingStats const ringStats = m_callbackResultRing->GetStats();
+                                                      resultJson << R"(,"resultRing":{"capacityBytes":)" << m_callbackResultRing->GetCapacityBytes()
+                                                                 << R"(,"lastFrame":)" << ringStats.lastPublished
+                                                                 << R"(,"staged":)" << ringStats.stagedRecords
+                                                                 << R"(,"total":)" << ringStats.totalRecords
+                                                                 << R"(,"totalBytes":)" << ringStats.totalBytes
+                                                                 << R"(,"deferredFrames":)" << ringStats.deferredFrames
+                                                                 << R"(,"oversized":)" << ringStats.oversized
+                                                                 << "}";
+                                                  }
+                                                  if (m_modelLoader)
+                                                  {
+                                                      sModelLoaderStats const loadStats = m_modelLoader->GetStats();
+                                                      resultJson << R"(,"modelLoads":{"requests":)" << loadStats.requests
+                                                                 << R"(,"dedupHits":)" << loadStats.dedupHits
+                                                                 << R"(,"residentHits":)" << loadStats.residentHits
+                                                                 << R"(,"loaded":)" << loadStats.loaded
+                                                                 << R"(,"failed":)" << loadStats.failed
+                                                                 << R"(,"binaryHits":)" << loadStats.binaryHits
+                                                                 << R"(,"binaryWrites":)" << loadStats.binaryWrites
+                                                                 << R"(,"queued":)" << loadStats.queued
+                                                                 << R"(,"inFlight":)" << loadStats.inFlight
+                                                                 << R"(,"resident":)" << loadStats.resident
+                                                                 << R"(,"pendingCommands":)" << (m_genericCommandDispatcher ? m_genericCommandDispatcher->GetPendingDeferredCount() : 0u)
+                                                                 << std::setprecision(3)
+                                                                 << R"(,"lastLoadMs":)" << loadStats.lastLoadMs
+                                                                 << R"(,"maxLoadMs":)" << loadStats.maxLoadMs
+                                                                 << R"(,"avgLoadMs":)" << (loadStats.loaded > 0 ? loadStats.totalLoadMs / static_cast<double>(loadStats.loaded) : 0.0)
+                                                                 << R"(,"lastLatencyMs":)" << loadStats.lastLatencyMs
+                                                                 << R"(,"maxLatencyMs":)" << loadStats.maxLatencyMs
+                                                                 << std::setprecision(1)
+                                                                 << "}";
+                                                  }
+                                                  if (m_genericCommandDispatcher)
+                                                  {
+                                                      resultJson << R"(,"commandLanes":{"enabled":)" << (m_isAsyncDispatchEnabled ? "true" : "false");
+                                                      for (eCommandAffinity const affinity : {eCommandAffinity::ANY_THREAD, eCommandAffinity::IO})
+                                                      {
+                                                          sCommandLaneStats const laneStats = m_genericCommandDispatcher->GetLaneStats(affinity);
+                                                          resultJson << R"(,")" << GetCommandAffinityName(affinity) << R"(":{"concurrency":)" << laneStats.concurrency
+                                                                     << R"(,"inFlight":)" << laneStats.inFlight
+                                                                     << R"(,"queued":)" << laneStats.queued
+                                                                     << R"(,"dispatched":)" << laneStats.dispatched
+                                                                     << R"(,"completed":)" << laneStats.completed
+                                                                     << R"(,"barriers":)" << laneStats.barriers
+                                                                     << std::setprecision(3)
+                                                                     << R"(,"lastWorkMs":)" << laneStats.lastWorkMs
+                                                                     << R"(,"maxWorkMs":)" << laneStats.maxWorkMs
+                                                                     << R"(,"maxQueueMs":)" << laneStats.maxQueueMs
+                                                                     << std::setprecision(1)
+                                                                     << "}";
+                                                      }
+                                                      resultJson << "}";
+                                                  }
+                                                  if (m_externalCommandQueue)
+                                                  {
+                                                      sExternalCommandQueueStats const externalStats = m_externalCommandQueue->GetStats();
+                                                      resultJson << R"(,"externalCommands":{"capacity":)" << externalStats.capacity
+                                                                 << R"(,"rateLimitPerAgent":)" << externalStats.ratePerSecond
+                                                                 << R"(,"depth":)" << externalStats.depth
+                                                                 << R"(,"maxDepth":)" << externalStats.maxDepth
+                                                                 << R"(,"lastFrame":)" << externalStats.lastConsumed
+                                                                 << R"(,"total":)" << externalStats.totalConsumed
+                                                                 << R"(,"agents":[)";
+                                                      for (size_t index = 0; index < externalStats.agents.size(); ++index)
+                                                      {
+                                                          sExternalAgentStats const& agent = externalStats.agents[index];
+                                                          resultJson << (index > 0 ? "," : "")
+                                                                     << R"({"agentId":")" << EscapeJsonString(agent.agentId)
+                                                                     << R"(","producers":)" << agent.producers
+                                                                     << R"(,"accepted":)" << agent.accepted
+                                                                     << R"(,"consumed":)" << agent.consumed
+                                                                     << R"(,"backpressure":)" << agent.queueFull
+                                                                     << R"(,"dropped":)" << agent.rateLimited
+                                                                     << "}";
+                                                      }
+                                                      resultJson << "]}";
+                                                  }
+
+                                                  resultJson << "}";
+
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // game.get_profile — FrameProfiler scope percentiles; "enabled" toggles the profiler, "reset" clears it
+    m_genericCommandExecutor->RegisterHandler("game.get_profile",
+                                              [](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  if (json.contains("enabled"))
+                                                  {
+                                                      FrameProfiler::SetEnabled(json.value("enabled", false));
+                                                  }
+                                                  if (json.value("reset", false))
+                                                  {
+                                                      FrameProfiler::Reset();
+                                                  }
+
+                                                  std::vector<sProfileScopeStats> const scopes = FrameProfiler::GetScopeStats();
+
+                                                  std::ostringstream resultJson;
+                                                  resultJson << std::fixed << std::setprecision(3);
+                                                  resultJson << R"({"success":true,"enabled":)" << (FrameProfiler::IsEnabled() ? "true" : "false")
+                                                             << R"(,"frame":)" << FrameProfiler::GetFrameNumber()
+                                                             << R"(,"traceFrames":)" << FrameProfiler::GetHistoryFrames()
+                                                             << R"(,"scopes":[)";
+                                                  for (size_t i = 0; i < scopes.size(); ++i)
+                                                  {
+                                                      sProfileScopeStats const& scope = scopes[i];
+                                                      resultJson << (i > 0 ? "," : "")
+                                                                 << R"({"name":")" << EscapeJsonString(scope.name)
+                                                                 << R"(","parent":)" << (scope.parent ? "\"" + EscapeJsonString(scope.parent) + "\"" : std::string("null"))
+                                                                 << R"(,"thread":")" << EscapeJsonString(scope.threadName)
+                                                                 << R"(","samples":)" << scope.samples
+                                                                 << R"(,"callsPerFrame":)" << scope.callsPerFrame
+                                                                 << R"(,"lastMs":)" << scope.lastMs
+                                                                 << R"(,"p50Ms":)" << scope.p50Ms
+                                                                 << R"(,"p95Ms":)" << scope.p95Ms
+                                                                 << R"(,"p99Ms":)" << scope.p99Ms
+                                                                 << R"(,"maxMs":)" << scope.maxMs
+                                                                 << "}";
+                                                  }
+                                                  resultJson << "]}";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // game.write_profile_trace — Chrome trace_event file for a window of profiled frames
+    // Payload: {"frames": N (last N frames, default: all kept)} or {"firstFrame": a, "lastFrame": b},
+    // optional "filename". Events are copied on the main thread; the file is written on the IO lane.
+    auto const snapshotProfileTrace = [](nlohmann::json const& json, sProfileTrace& outTrace, String& outFilePath) -> String
+    {
+        uint64_t const currentFrame = FrameProfiler::GetFrameNumber();
+        uint64_t const frames       = json.value("frames", static_cast<uint64_t>(FrameProfiler::GetHistoryFrames()));
+        uint64_t const lastFrame    = json.value("lastFrame", currentFrame > 0 ? currentFrame - 1 : 0);
+        uint64_t const firstFrame   = json.value("firstFrame", lastFrame + 1 > frames ? lastFrame + 1 - frames : 0);
+
+        if (!FrameProfiler::SnapshotTrace(firstFrame, lastFrame, outTrace))
+        {
+            return Stringf("no profiled frames in [%llu, %llu] (enable the profiler with game.get_profile)", firstFrame, lastFrame);
+        }
+
+        String name = json.value("filename", "");
+        if (name.empty())
+        {
+            name = Stringf("trace_%llu-%llu", outTrace.firstFrame, outTrace.lastFrame);
+        }
+        if (name.find("..") != String::npos || name.find_first_of("/\\:") != String::npos)
+        {
+            return "invalid filename: path separators and '..' are not allowed";
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::current_path() / "Profiles", ec);
+        outFilePath = (std::filesystem::current_path() / "Profiles" / (name + ".json")).string();
+        return String();
+    };
+
+    auto const writeProfileTrace = [](sProfileTrace const& trace, String const& filePath) -> HandlerResult
+    {
+        uint64_t const bytes = FrameProfiler::WriteChromeTrace(trace, filePath);
+        if (bytes == 0)
+        {
+            std::string r = R"({"success":false,"error":"could not write )" + EscapeJsonString(filePath) + R"("})";
+            return HandlerResult::Success({{"resultJson", std::any(r)}});
+        }
+
+        std::ostringstream resultJson;
+        resultJson << R"({"success":true,"filePath":")" << EscapeJsonString(filePath)
+                   << R"(","firstFrame":)" << trace.firstFrame
+                   << R"(,"lastFrame":)" << trace.lastFrame
+                   << R"(,"events":)" << trace.events.size()
+                   << R"(,"bytes":)" << bytes << "}";
+        return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+    };
+
+    m_genericCommandDispatcher->RegisterDeferredHandler("game.write_profile_trace",
+                                                        [this, snapshotProfileTrace, writeProfileTrace](std::any const& payload, DeferredCommandToken const token)
+                                                        {
+                                                            nlohmann::json json;
+                                                            String         err = ParseJsonPayload(payload, json);
+                                                            if (!err.empty())
+                                                            {
+                                                                m_genericCommandDispatcher->CompleteDeferred(token, HandlerResult::Error(err), 0.0);
+                                                                return;
+                                                            }
+
+                                                            auto   trace = std::make_shared<sProfileTrace>();
+                                                            String filePath;
+                                                            err = snapshotProfileTrace(json, *trace, filePath);
+                                                            if (!err.empty())
+                                                            {
+                                                                std::string r = R"({"success":false,"error":")" + EscapeJsonString(err) + R"("})";
+                                                                m_genericCommandDispatcher->CompleteDeferred(token, HandlerResult::Success({{"resultJson", std::any(r)}}), 0.0);
+                                                                return;
+                                                            }
+
+                                                            m_genericCommandDispatcher->ContinueDeferred(token, eCommandAffinity::IO,
+                                                                [writeProfileTrace, trace, filePath](std::any const&) -> HandlerResult
+                                                                {
+                                                                    return writeProfileTrace(*trace, filePath);
+                                                                },
+                                                                std::any());
+                                                        },
+                                                        [snapshotProfileTrace, writeProfileTrace](std::any const& payload) -> HandlerResult
+                                                        {
+                                                            nlohmann::json json;
+                                                            String         err = ParseJsonPayload(payload, json);
+                                                            if (!err.empty()) return HandlerResult::Error(err);
+
+                                                            sProfileTrace trace;
+                                                            String        filePath;
+                                                            err = snapshotProfileTrace(json, trace, filePath);
+                                                            if (!err.empty())
+                                                            {
+                                                                std::string r = R"({"success":false,"error":")" + EscapeJsonString(err) + R"("})";
+                                                                return HandlerResult::Success({{"resultJson", std::any(r)}});
+                                                            }
+                                                            return writeProfileTrace(trace, filePath);
+                                                        });
+
+    // game.list_scripts — Return all loaded scripts with path, name, and active status
     m_genericCommandExecutor->RegisterHandler("game.list_scripts",
                                               [](std::any const&) -> HandlerResult
                                               {
@@ -2161,6 +4131,139 @@ void App::Startup()
                                                   return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
                                               });
 
+    // game.get_startup_timing — Startup phase breakdown (ms since process creation) up to the first
+    // ready frame; phases keep growing until isComplete. Includes shard isolate init time.
+    m_genericCommandExecutor->RegisterHandler("game.get_startup_timing",
+                                              [this](std::any const&) -> HandlerResult
+                                              {
+                                                  std::ostringstream resultJson;
+                                                  resultJson << R"({"success":true,)" << m_startupTimeline->ToJsonFields();
+
+                                                  if (m_jsWorkerPool)
+                                                  {
+                                                      sJSWorkerPoolStats const poolStats = m_jsWorkerPool->GetStats();
+                                                      resultJson << std::fixed << std::setprecision(2)
+                                                                 << R"(,"jsWorkerPool":{"isolates":)" << poolStats.shardCount
+                                                                 << R"(,"readyIsolates":)" << poolStats.readyShards
+                                                                 << R"(,"slowestInitMs":)" << poolStats.slowestInitMs << "}";
+                                                  }
+
+                                                  resultJson << "}";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // game.start_recording — Record every state-buffer swap (and the GenericCommand stream) to a .drec
+    // file for -replay. Optional: path (default Recording.json path), recordCommands (default true).
+    m_genericCommandExecutor->RegisterHandler("game.start_recording",
+                                              [this](std::any const& payload) -> HandlerResult
+                                              {
+                                                  nlohmann::json json;
+                                                  String         err = ParseJsonPayload(payload, json);
+                                                  if (!err.empty()) return HandlerResult::Error(err);
+
+                                                  if (m_stateRecorder && m_stateRecorder->IsRecording())
+                                                  {
+                                                      return HandlerResult::Error(Stringf("ERR_BUSY: already recording to %s", m_stateRecorder->GetPath().c_str()));
+                                                  }
+
+                                                  String const path = json.value("path", m_recordingPath);
+                                                  if (path.empty())
+                                                  {
+                                                      return HandlerResult::Error("ERR_INVALID_PARAM: path must not be empty");
+                                                  }
+                                                  if (m_stateReplayer && path == m_stateReplayer->GetStats().path)
+                                                  {
+                                                      return HandlerResult::Error(Stringf("ERR_INVALID_PARAM: %s is being replayed", path.c_str()));
+                                                  }
+
+                                                  delete m_stateRecorder;
+                                                  m_stateRecorder = new StateRecorder(path, json.value("recordCommands", true));
+                                                  if (!m_stateRecorder->Start())
+                                                  {
+                                                      delete m_stateRecorder;
+                                                      m_stateRecorder = nullptr;
+                                                      return HandlerResult::Error(Stringf("ERR_IO: cannot create %s", path.c_str()));
+                                                  }
+
+                                                  std::ostringstream resultJson;
+                                                  resultJson << R"({"success":true,"path":")" << EscapeJsonString(path) << R"("})";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // game.stop_recording — Finish the recording (frame index + truncate) and report what was written
+    m_genericCommandExecutor->RegisterHandler("game.stop_recording",
+                                              [this](std::any const& /*payload*/) -> HandlerResult
+                                              {
+                                                  if (!m_stateRecorder)
+                                                  {
+                                                      return HandlerResult::Error("ERR_NOT_RECORDING: no recording in progress");
+                                                  }
+
+                                                  m_stateRecorder->Stop();
+                                                  sStateRecorderStats const stats = m_stateRecorder->GetStats();
+                                                  delete m_stateRecorder;
+                                                  m_stateRecorder = nullptr;
+
+                                                  std::ostringstream resultJson;
+                                                  resultJson << R"({"success":true,"path":")" << EscapeJsonString(stats.path)
+                                                             << R"(","frames":)" << stats.frames
+                                                             << R"(,"records":)" << stats.records
+                                                             << R"(,"bytes":)" << stats.bytes
+                                                             << R"(,"isFailed":)" << (stats.isFailed ? "true" : "false") << "}";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
+    // game.get_recording_stats — State recorder and replayer counters (either may be absent)
+    m_genericCommandExecutor->RegisterHandler("game.get_recording_stats",
+                                              [this](std::any const& /*payload*/) -> HandlerResult
+                                              {
+                                                  std::ostringstream resultJson;
+                                                  resultJson << std::fixed << std::setprecision(3) << R"({"success":true)";
+
+                                                  if (m_stateRecorder)
+                                                  {
+                                                      sStateRecorderStats const stats = m_stateRecorder->GetStats();
+                                                      resultJson << R"(,"recorder":{"isRecording":)" << (stats.isRecording ? "true" : "false")
+                                                                 << R"(,"isFailed":)" << (stats.isFailed ? "true" : "false")
+                                                                 << R"(,"path":")" << EscapeJsonString(stats.path)
+                                                                 << R"(","frames":)" << stats.frames
+                                                                 << R"(,"records":)" << stats.records
+                                                                 << R"(,"bytes":)" << stats.bytes
+                                                                 << R"(,"entityRecords":)" << stats.entityRecords
+                                                                 << R"(,"removedRecords":)" << stats.removedRecords
+                                                                 << R"(,"cameraRecords":)" << stats.cameraRecords
+                                                                 << R"(,"meshRecords":)" << stats.meshRecords
+                                                                 << R"(,"commandRecords":)" << stats.commandRecords
+                                                                 << R"(,"fullSnapshots":)" << stats.fullSnapshots
+                                                                 << R"(,"lastRecordMs":)" << stats.lastRecordMs
+                                                                 << R"(,"maxRecordMs":)" << stats.maxRecordMs << "}";
+                                                  }
+
+                                                  if (m_stateReplayer)
+                                                  {
+                                                      sStateReplayStats const stats = m_stateReplayer->GetStats();
+                                                      resultJson << R"(,"replayer":{"isFinished":)" << (stats.isFinished ? "true" : "false")
+                                                                 << R"(,"isRealTime":)" << (stats.isRealTime ? "true" : "false")
+                                                                 << R"(,"isFileComplete":)" << (stats.isFileComplete ? "true" : "false")
+                                                                 << R"(,"path":")" << EscapeJsonString(stats.path)
+                                                                 << R"(","frameCount":)" << stats.frameCount
+                                                                 << R"(,"nextFrame":)" << stats.nextFrame
+                                                                 << R"(,"framesApplied":)" << stats.framesApplied
+                                                                 << R"(,"recordsApplied":)" << stats.recordsApplied
+                                                                 << R"(,"commandsSkipped":)" << stats.commandsSkipped
+                                                                 << R"(,"loops":)" << stats.loops
+                                                                 << R"(,"appFrames":)" << stats.appFrames
+                                                                 << R"(,"elapsedMs":)" << stats.elapsedMs
+                                                                 << R"(,"recordedMs":)" << stats.recordedMs
+                                                                 << R"(,"lastApplyMs":)" << stats.lastApplyMs
+                                                                 << R"(,"maxApplyMs":)" << stats.maxApplyMs
+                                                                 << R"(,"maxAppFrameMs":)" << stats.maxAppFrameMs << "}";
+                                                  }
+
+                                                  resultJson << "}";
+                                                  return HandlerResult::Success({{"resultJson", std::any(resultJson.str())}});
+                                              });
+
     // input.set_cursor_mode — Set cursor mode (POINTER=0, FPS=1)
     // Migrated from InputScriptInterface to GenericCommand pipeline
     m_genericCommandExecutor->RegisterHandler("input.set_cursor_mode",
@@ -2176,19 +4279,188 @@ void App::Startup()
                                                       return HandlerResult::Error("Invalid cursor mode (0=POINTER, 1=FPS)");
                                                   }
 
+                                                  if (!g_input)
+                                                  {
+                                                      return HandlerResult::Error("ERR_NOT_INITIALIZED: InputSystem is null");
+                                                  }
+
                                                   g_input->SetCursorMode(static_cast<eCursorMode>(mode));
                                                   return HandlerResult::Success({});
                                               });
 
     DAEMON_LOG(LogApp, eLogVerbosity::Display, "XXXXXApp::Startup - Async architecture initialized");
 
+    m_startupTimeline->BeginPhase("game.bindings");
     g_game = new Game();
     SetupScriptingBindings();
+
+    // main.js and its module graph are compiled and evaluated here
+    m_startupTimeline->BeginPhase("js.framework");
     g_game->PostInit();
 
-    // Submit JavaScript worker thread job after game and script initialization
-    m_jsGameLogicJob = new JSGameLogicJob(g_game, m_entityStateBuffer, m_callbackQueue);
-    g_jobSystem->SubmitJob(m_jsGameLogicJob);
+    m_startupTimeline->BeginPhase("app.workers");
+
+    // State recording / replay (optional — -record / -replay on the command line, or Recording.json)
+    sStateRecordingConfig recordingConfig;
+    recordingConfig.isRecording = HasCommandLineFlag("-record");
+    recordingConfig.isReplaying = HasCommandLineFlag("-replay");
+    try
+    {
+        std::ifstream configFile("Data/Config/Recording.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            recordingConfig.path                = jsonConfig.value("path", recordingConfig.path);
+            recordingConfig.isRecording         = recordingConfig.isRecording || jsonConfig.value("record", false);
+            recordingConfig.isRecordingCommands = jsonConfig.value("recordCommands", recordingConfig.isRecordingCommands);
+            recordingConfig.isReplaying         = recordingConfig.isReplaying || jsonConfig.value("replay", false);
+            recordingConfig.isRealTime          = jsonConfig.value("replaySpeed", String("realtime")) != "unthrottled";
+            recordingConfig.isLooping           = jsonConfig.value("loop", recordingConfig.isLooping);
+            recordingConfig.isQuitWhenDone      = jsonConfig.value("quitWhenDone", recordingConfig.isQuitWhenDone);
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("Recording config parse error: %s - using defaults", e.what()));
+    }
+    m_recordingPath = recordingConfig.path;
+
+    if (recordingConfig.isReplaying)
+    {
+        m_stateReplayer = new StateReplayer(recordingConfig);
+        if (!m_stateReplayer->Start())
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning, "App::Startup - State replay unavailable, running the JS worker");
+            delete m_stateReplayer;
+            m_stateReplayer = nullptr;
+        }
+    }
+    else if (recordingConfig.isRecording)
+    {
+        m_stateRecorder = new StateRecorder(recordingConfig.path, recordingConfig.isRecordingCommands);
+        if (!m_stateRecorder->Start())
+        {
+            delete m_stateRecorder;
+            m_stateRecorder = nullptr;
+        }
+    }
+
+    // Submit JavaScript worker thread job after game and script initialization. A replay never
+    // triggers a JS frame, so the worker is not started at all (main.js has still run in PostInit)
+    if (!m_stateReplayer)
+    {
+        m_jsGameLogicJob = new JSGameLogicJob(g_game, m_entityStore, m_callbackQueue);
+        if (m_jsFramePipeline)
+        {
+            m_jsGameLogicJob->SetFramePipeline(m_jsFramePipeline, jsTargetTickRate);
+
+            if (m_simulationScheduler)
+            {
+                m_jsGameLogicJob->SetFixedTimestep(m_simulationScheduler->GetTickSeconds());
+            }
+        }
+        if (m_jsGCScheduler)
+        {
+            m_jsGameLogicJob->SetGCScheduler(m_jsGCScheduler, watchdogConfig.frameBudgetMs);
+        }
+        if (m_callbackResultRing && m_callbackResultRing->IsInstalled())
+        {
+            m_jsGameLogicJob->SetCallbackResultRing(m_callbackResultRing);
+        }
+        g_jobSystem->SubmitJob(m_jsGameLogicJob);
+    }
+
+    // Sharded behavior isolates; each holds a JobSystem thread for its lifetime, so leave at least
+    // two generic threads for JSGameLogicJob and resource loading
+    if (jsPoolIsolates > 0)
+    {
+        uint32_t const hardwareThreads = std::thread::hardware_concurrency();
+        uint32_t const maxIsolates     = (hardwareThreads > 4) ? std::min(hardwareThreads - 4, JSWorkerPool::MAX_SHARDS) : 1u;
+        if (jsPoolIsolates > maxIsolates)
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                       Stringf("JSWorker config: workerPoolIsolates=%u exceeds %u available threads - clamped", jsPoolIsolates, maxIsolates));
+            jsPoolIsolates = maxIsolates;
+        }
+
+        m_jsWorkerPool = new JSWorkerPool(jsPoolIsolates, jsPoolScript, gcTypedCapacity > 0 ? gcTypedCapacity : 4096u, m_externalCommandQueue);
+        m_jsWorkerPool->Start();
+    }
+
+    // Benchmark mode (optional — -benchmark on the command line, or Benchmark.json "enabled": true)
+    bool             benchmarkEnabled = HasCommandLineFlag("-benchmark");
+    sBenchmarkConfig benchmarkConfig;
+    try
+    {
+        std::ifstream configFile("Data/Config/Benchmark.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            benchmarkEnabled                = jsonConfig.value("enabled", false) || benchmarkEnabled;
+            benchmarkConfig.frameRate       = jsonConfig.value("frameRate", benchmarkConfig.frameRate);
+            benchmarkConfig.outputDirectory = jsonConfig.value("outputDirectory", benchmarkConfig.outputDirectory);
+            benchmarkConfig.isProfiled      = jsonConfig.value("profile", benchmarkConfig.isProfiled);
+            benchmarkConfig.isQuitWhenDone  = jsonConfig.value("quitWhenDone", benchmarkConfig.isQuitWhenDone);
+
+            for (nlohmann::json const& sceneJson : jsonConfig.value("scenes", nlohmann::json::array()))
+            {
+                sBenchmarkScene scene;
+                scene.name           = sceneJson.value("name", Stringf("scene%zu", benchmarkConfig.scenes.size()));
+                scene.primitiveCount = sceneJson.value("primitiveCount", scene.primitiveCount);
+                scene.primitiveMesh  = sceneJson.value("primitiveMesh", scene.primitiveMesh);
+                scene.modelCount     = sceneJson.value("modelCount", scene.modelCount);
+                scene.modelPaths     = sceneJson.value("modelPaths", scene.modelPaths);
+                scene.warmupFrames   = sceneJson.value("warmupFrames", scene.warmupFrames);
+                scene.measureFrames  = sceneJson.value("measureFrames", scene.measureFrames);
+
+                for (auto const& [type, perSecond] : sceneJson.value("commandRates", nlohmann::json::object()).items())
+                {
+                    scene.commandRates.push_back({type, perSecond.get<float>()});
+                }
+                benchmarkConfig.scenes.push_back(std::move(scene));
+            }
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("Benchmark config parse error: %s - using defaults", e.what()));
+    }
+
+    if (benchmarkEnabled)
+    {
+        // Spawned ids are read straight from the back buffers the spawn handlers just wrote
+        auto const listEntities = [this](std::vector<uint64_t>& outIds)
+        {
+            sEntityArrays const& back = m_entityStore->GetBack();
+            for (uint32_t slot = 0; slot < back.GetSlotCount(); ++slot)
+            {
+                if (m_entityStore->FindSlot(back.ids[slot]) == slot)
+                {
+                    outIds.push_back(back.ids[slot]);
+                }
+            }
+        };
+        auto const listCameras = [this](std::vector<uint64_t>& outIds)
+        {
+            for (auto const& [cameraId, state] : *m_cameraStateBuffer->GetBackBuffer())
+            {
+                outIds.push_back(cameraId);
+            }
+        };
+
+        m_benchmarkRunner = new BenchmarkRunner(std::move(benchmarkConfig),
+                                                [this](GenericCommand const& cmd) { DispatchGenericCommand(cmd); },
+                                                listEntities, listCameras);
+    }
+
+    // Closed by RunFrame() once the first JS frame has been presented
+    m_startupTimeline->BeginPhase("frame1");
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -2196,6 +4468,59 @@ void App::Startup()
 //----------------------------------------------------------------------------------------------------
 void App::Shutdown()
 {
+    // A benchmark cut short (window closed, quit command) still writes what it measured
+    if (m_benchmarkRunner)
+    {
+        m_benchmarkRunner->Shutdown();
+        delete m_benchmarkRunner;
+        m_benchmarkRunner = nullptr;
+    }
+
+    delete m_startupTimeline;
+    m_startupTimeline = nullptr;
+
+    // Writes the frame index; a recording cut short by a crash is still readable without it
+    delete m_stateRecorder;
+    m_stateRecorder = nullptr;
+
+    delete m_stateReplayer;
+    m_stateReplayer = nullptr;
+
+    // Joins the watcher's I/O thread
+    delete m_scriptHotReloader;
+    m_scriptHotReloader = nullptr;
+
+    // Finish async GenericCommand handlers while the JobSystem and every subsystem are still alive
+    // (model loads first: their waiters complete deferred load_model commands)
+    if (m_modelLoader)
+    {
+        m_modelLoader->Shutdown();
+    }
+    if (m_genericCommandDispatcher)
+    {
+        m_genericCommandDispatcher->Shutdown();
+    }
+
+    // Shutdown worker pool shards (their isolates are disposed on their own threads)
+    if (m_jsWorkerPool)
+    {
+        m_jsWorkerPool->RequestShutdown();
+
+        constexpr int kMaxWaitIterations = 500;
+        constexpr int kWaitMilliseconds  = 10;
+        int           waitCount          = 0;
+        while (!m_jsWorkerPool->IsShutdownComplete() && waitCount < kMaxWaitIterations)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kWaitMilliseconds));
+            ++waitCount;
+        }
+
+        if (!m_jsWorkerPool->IsShutdownComplete())
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning, "App::Shutdown - Worker pool shutdown timeout!");
+        }
+    }
+
     // Shutdown async job first
     if (m_jsGameLogicJob)
     {
@@ -2225,7 +4550,11 @@ void App::Shutdown()
         Job* retrievedJob = g_jobSystem->RetrieveCompletedJob();
         while (retrievedJob != nullptr && retrievedJob != m_jsGameLogicJob)
         {
-            delete retrievedJob;
+            // Pool shard jobs are owned (and deleted) by JSWorkerPool
+            if (!m_jsWorkerPool || !m_jsWorkerPool->OwnsJob(retrievedJob))
+            {
+                delete retrievedJob;
+            }
             retrievedJob = g_jobSystem->RetrieveCompletedJob();
         }
 
@@ -2233,6 +4562,9 @@ void App::Shutdown()
         m_jsGameLogicJob = nullptr;
     }
 
+    delete m_jsWorkerPool;
+    m_jsWorkerPool = nullptr;
+
     // Clear V8::Persistent callbacks before V8 isolate destruction
     if (m_kadiScriptInterface)
     {
@@ -2244,21 +4576,62 @@ void App::Shutdown()
     // Cleanup APIs (before state buffers)
 
 
+    delete m_entityBatchRenderer;
+    m_entityBatchRenderer = nullptr;
+
+    delete m_debugLayerRenderer;
+    m_debugLayerRenderer = nullptr;
+
+    delete m_gpuMeshCache;
+    m_gpuMeshCache = nullptr;
+
+    delete m_meshHandleTable;
+    m_meshHandleTable = nullptr;
+
+    delete m_modelLoader;
+    m_modelLoader = nullptr;
+
     delete m_meshCache;
     m_meshCache = nullptr;
 
     // Cleanup state buffers
-    delete m_entityStateBuffer;
-    m_entityStateBuffer = nullptr;
+    delete m_entityStore;
+    m_entityStore = nullptr;
 
     delete m_cameraStateBuffer;
     m_cameraStateBuffer = nullptr;
 
 
+    delete m_audioSourceBatcher;
+    m_audioSourceBatcher = nullptr;
+
     delete m_audioStateBuffer;
     m_audioStateBuffer = nullptr;
 
     // Cleanup command queues
+    delete m_jsFrameWatchdog;
+    m_jsFrameWatchdog = nullptr;
+
+    delete m_jsGCScheduler;
+    m_jsGCScheduler = nullptr;
+
+    delete m_simulationScheduler;
+    m_simulationScheduler = nullptr;
+
+    delete m_jsFramePipeline;
+    m_jsFramePipeline = nullptr;
+
+    delete m_typedCommandBuffer;
+    m_typedCommandBuffer = nullptr;
+
+    delete m_callbackResultRing;
+    m_callbackResultRing = nullptr;
+
+    delete m_externalCommandQueue;
+    m_externalCommandQueue = nullptr;
+
+    delete m_genericCommandDispatcher;
+    m_genericCommandDispatcher = nullptr;
 
     delete m_genericCommandExecutor;
     m_genericCommandExecutor = nullptr;
@@ -2277,6 +4650,9 @@ void App::Shutdown()
     delete m_frameEventQueue;
     m_frameEventQueue = nullptr;
 
+    // Every thread that logs has stopped; emit what is still queued while the LogSubsystem is alive
+    BinaryLogger::Shutdown();
+
     GEngine::Get().Shutdown();
 }
 
@@ -2285,24 +4661,69 @@ void App::Shutdown()
 //
 void App::RunFrame()
 {
-    BeginFrame();   // Engine pre-frame stuff
-    Update();       // Game updates / moves / spawns / hurts / kills stuff
-    Render();       // Game draws current state of things
-    EndFrame();     // Engine post-frame stuff
-}
+    {
+        ProfileScope const frameScope("App::RunFrame");
 
-//----------------------------------------------------------------------------------------------------
-void App::RunMainLoop()
+        BeginFrame();   // Engine pre-frame stuff
+        Update();       // Game updates / moves / spawns / hurts / kills stuff
+        if (!m_isHeadless)
+        {
+            Render();   // Game draws current state of things
+        }
+        EndFrame();     // Engine post-frame stuff
+    }
+
+    FrameProfiler::EndFrame();
+
+    // Frame 1 is "ready" once the JS worker has completed a frame and it has been presented
+    if (m_startupTimeline && !m_startupTimeline->IsComplete() && (!m_jsGameLogicJob || m_jsGameLogicJob->GetTotalFrames() > 0))
+    {
+        m_startupTimeline->MarkFirstFrame();
+    }
+
+    if (m_benchmarkRunner && !m_benchmarkRunner->IsFinished())
+    {
+        sBenchmarkFrameCounters counters;
+        counters.workerFrames  = m_jsGameLogicJob ? m_jsGameLogicJob->GetTotalFrames() : 0;
+        counters.workerFrameMs = m_jsGameLogicJob ? m_jsGameLogicJob->GetLastFrameMs() : 0.0;
+        counters.swapCount     = m_entitySwapStats.swapCount;
+        counters.swapMs        = m_entitySwapStats.lastSwapMs;
+        m_benchmarkRunner->EndFrame(counters);
+
+        if (m_benchmarkRunner->IsFinished() && m_benchmarkRunner->IsQuitWhenDone())
+        {
+            RequestQuit();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void App::RunMainLoop()
 {
+    // Headless runs are paced by Headless.json tickRate (0 = as fast as the worker and command
+    // pipeline allow); windowed runs are paced by the swapchain
+    bool const isPaced       = m_isHeadless && m_headlessTickRate > 0.f;
+    auto const frameInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(isPaced ? 1.0 / static_cast<double>(m_headlessTickRate) : 0.0));
+    auto nextFrame = std::chrono::steady_clock::now();
+
     // Program main loop; keep running frames until it's time to quit
     while (!m_isQuitting)
     {
         // Sleep(16); // Temporary code to "slow down" our app to ~60Hz until we have proper frame timing in
         RunFrame();
+
+        if (isPaced)
+        {
+            // Late frames do not burst to catch up
+            nextFrame = std::max(nextFrame + frameInterval, std::chrono::steady_clock::now());
+            std::this_thread::sleep_until(nextFrame);
+        }
     }
 }
 
 STATIC bool App::m_isQuitting = false;
+STATIC bool App::m_isHeadless = false;
 
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::OnCloseButtonClicked(EventArgs& args)
@@ -2323,37 +4744,136 @@ STATIC void App::RequestQuit()
 //----------------------------------------------------------------------------------------------------
 void App::BeginFrame() const
 {
+    ProfileScope const scope("App::BeginFrame");
+
     g_eventSystem->BeginFrame();
-    g_window->BeginFrame();
-    g_renderer->BeginFrame();
-    DebugRenderBeginFrame();
-    g_devConsole->BeginFrame();
-    g_input->BeginFrame();
-    g_audio->BeginFrame();
+
+    // A forced-headless instance still owns its window: keep pumping its messages so it stays
+    // responsive and OnCloseButtonClicked / quit still arrive
+    if (g_window) g_window->BeginFrame();
+    if (!m_isHeadless)
+    {
+        g_renderer->BeginFrame();
+        DebugRenderBeginFrame();
+        if (g_devConsole) g_devConsole->BeginFrame();
+    }
+    if (g_input) g_input->BeginFrame();
+    if (g_audio) g_audio->BeginFrame();
     g_kadiSubsystem->BeginFrame();
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::Update()
 {
+    ProfileScope const scope("App::Update");
+
     Clock::TickSystemClock();
-    UpdateCursorMode();
 
-    g_imgui->Update();
+    if (!m_isHeadless)
+    {
+        UpdateCursorMode();
+        g_imgui->Update();
+    }
     g_scriptSubsystem->Update();
+    ProcessScriptHotReload();
+
+    // Benchmark commands go first, in the same frame as the producers they stand in for
+    if (m_benchmarkRunner)
+    {
+        m_benchmarkRunner->Update();
+    }
 
     // ProcessRenderCommands();
     ProcessGenericCommands();
 
+    // Fixed timestep: bank this frame's real time; ticks are handed out when the worker is free
+    if (m_simulationScheduler && !m_jsFramePipeline)
+    {
+        m_simulationScheduler->Accumulate(Clock::GetSystemClock().GetDeltaSeconds());
+    }
+
+    // Worker pool: apply the merged shard frame (published by this tick's swap) and start the next one
+    if (m_jsWorkerPool && !m_stateReplayer && m_jsWorkerPool->IsFrameComplete())
+    {
+        m_jsWorkerPool->Drain(*m_typedCommandBuffer);
+        m_jsWorkerPool->TriggerNextFrame(static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds()));
+    }
+
+    // Frame budget watchdog: account finished worker frames, shed work or cut off a hung frame
+    if (m_jsFrameWatchdog && m_jsGameLogicJob)
+    {
+        UpdateJSFrameWatchdog();
+    }
+
+    // Replay: the recorded frames that are due stand in for JS frames (the worker was never started)
+    if (m_stateReplayer)
+    {
+        UpdateStateReplay();
+    }
+    // Pipelined mode: apply every JS frame the worker completed since the last tick (oldest first),
+    // then swap once so rendering sees the newest completed snapshot. JSON commands are consumed as
+    // they arrive, so they may run ahead of the typed records of an older, still-queued frame. A
+    // frame that overflowed its typed buffer waits for its typed.flush commands, which keep its
+    // records in write order (TypedCommandBuffer.hpp, Overflow).
+    else if (m_jsFramePipeline)
+    {
+        uint32_t appliedFrames = 0;
+        while (sJSFrameSlot const* slot = m_jsFramePipeline->PeekCompleted())
+        {
+            if (appliedFrames == 0 || m_typedCommandBuffer->IsAwaitingFlushedRecords(slot->typedCommands))
+            {
+                ProcessGenericCommands();
+            }
+
+            m_typedCommandBuffer->Apply(slot->typedCommands);
+            m_jsFramePipeline->ReleaseCompleted();
+            ++appliedFrames;
+        }
+
+        if (appliedFrames > 0)
+        {
+            SwapStateBuffers();
+
+            if (m_simulationScheduler && m_entitySwapStats.lastEntriesCopied > 0)
+            {
+                m_simulationScheduler->PublishTicks(appliedFrames);
+            }
+        }
+    }
     // Async Frame Synchronization: Check if worker thread completed previous JavaScript frame
-    if (m_jsGameLogicJob && m_jsGameLogicJob->IsFrameComplete())
+    else if (m_jsGameLogicJob && m_jsGameLogicJob->IsFrameComplete())
     {
-        // Swap state buffers (copy back buffer to front buffer)
-        if (m_entityStateBuffer) m_entityStateBuffer->SwapBuffers();
-        if (m_cameraStateBuffer) m_cameraStateBuffer->SwapBuffers();
-        if (m_audioStateBuffer) m_audioStateBuffer->SwapBuffers();
+        // Apply typed commands from the finished JS frame. Consume JSON first so commands submitted
+        // after the earlier ProcessGenericCommands() (e.g. entity.set_texture) keep submission order;
+        // this also queues the frame's typed.flush records ahead of its FLUSHED_RECORDS marker.
+        if (m_typedCommandBuffer && m_typedCommandBuffer->IsInstalled())
+        {
+            ProcessGenericCommands();
+            m_typedCommandBuffer->Drain();
+        }
+
+        // Swap state buffers (dirty keys only; untouched buffers are skipped)
+        SwapStateBuffers();
 
-        m_jsGameLogicJob->TriggerNextFrame();
+        if (!m_simulationScheduler)
+        {
+            m_jsGameLogicJob->TriggerNextFrame();
+        }
+        else
+        {
+            // Interpolate over the ticks just published; a swap that moved nothing keeps the old span
+            if (m_simTicksInFlight > 0 && m_entitySwapStats.lastEntriesCopied > 0)
+            {
+                m_simulationScheduler->PublishTicks(m_simTicksInFlight);
+            }
+
+            // No tick owed yet (render faster than tick rate): leave the worker idle this frame
+            m_simTicksInFlight = m_simulationScheduler->ConsumeTicks();
+            if (m_simTicksInFlight > 0)
+            {
+                m_jsGameLogicJob->TriggerFixedTicks(m_simTicksInFlight, m_simulationScheduler->GetTickSeconds());
+            }
+        }
     }
     else if (m_jsGameLogicJob)
     {
@@ -2361,20 +4881,24 @@ void App::Update()
         static uint64_t frameSkipCount = 0;
         if (frameSkipCount % 60 == 0)
         {
-            DAEMON_LOG(LogApp, eLogVerbosity::Warning,
-                       Stringf("App::Update - JavaScript frame skip (worker still executing) - Total skips: %llu",
-                           frameSkipCount));
+            DAEMON_LOG_FAST(LogApp, eLogVerbosity::Warning,
+                            "App::Update - JavaScript frame skip (worker still executing) - Total skips: %llu", frameSkipCount);
         }
         ++frameSkipCount;
     }
 
     // Execute pending callbacks from APIs
     if (m_genericCommandExecutor) m_genericCommandExecutor->ExecutePendingCallbacks(m_callbackQueue);
+
+    // After this frame's commands and swap, before AudioSystem::EndFrame() runs the FMOD update
+    ApplyAudioSourceBatch();
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::Render() const
 {
+    ProfileScope const scope("App::Render");
+
     g_renderer->ClearScreen(Rgba8::BLACK, Rgba8::BLACK);
 
     // Render entities only in GAME mode
@@ -2395,7 +4919,13 @@ void App::Render() const
     }
 
     // Render 3D debug visualization (world space) - only in GAME mode
-    if (worldCamera && g_game && !g_game->IsAttractMode())
+    bool const isGameMode = g_game && !g_game->IsAttractMode();
+    if (m_debugLayerRenderer)
+    {
+        // Always called so the frame batch is dropped even when nothing could be drawn
+        m_debugLayerRenderer->Render(isGameMode ? worldCamera : nullptr);
+    }
+    if (worldCamera && isGameMode)
     {
         DebugRenderWorld(*worldCamera);
     }
@@ -2431,13 +4961,18 @@ void App::Render() const
 //----------------------------------------------------------------------------------------------------
 void App::EndFrame() const
 {
+    ProfileScope const scope("App::EndFrame");
+
     g_eventSystem->EndFrame();
-    g_window->EndFrame();
-    g_renderer->EndFrame();
-    DebugRenderEndFrame();
-    g_devConsole->EndFrame();
-    g_input->EndFrame();
-    g_audio->EndFrame();
+    if (g_window) g_window->EndFrame();
+    if (!m_isHeadless)
+    {
+        g_renderer->EndFrame();
+        DebugRenderEndFrame();
+        if (g_devConsole) g_devConsole->EndFrame();
+    }
+    if (g_input) g_input->EndFrame();
+    if (g_audio) g_audio->EndFrame();
     g_kadiSubsystem->EndFrame();
 }
 
@@ -2513,8 +5048,44 @@ void App::SetupScriptingBindings()
 
     DAEMON_LOG(LogApp, eLogVerbosity::Log, "App::SetupScriptingBindings - start");
 
-    // Initialize hot-reload system
-    if (g_scriptSubsystem->InitializeHotReload("../"))
+    // Hot reload: OS change notifications + incremental module reload, or the Engine FileWatcher
+    sScriptHotReloadConfig hotReloadConfig;
+    try
+    {
+        std::ifstream configFile("Data/Config/HotReload.json");
+        if (configFile.is_open())
+        {
+            nlohmann::json jsonConfig;
+            configFile >> jsonConfig;
+
+            hotReloadConfig.isEventDriven    = jsonConfig.value("eventDriven", hotReloadConfig.isEventDriven);
+            hotReloadConfig.scriptsDirectory = jsonConfig.value("scriptsDirectory", hotReloadConfig.scriptsDirectory);
+            hotReloadConfig.entryModule      = jsonConfig.value("entryModule", hotReloadConfig.entryModule);
+            hotReloadConfig.debounceMs       = jsonConfig.value("debounceMs", hotReloadConfig.debounceMs);
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("HotReload config parse error: %s - using defaults", e.what()));
+    }
+
+    if (hotReloadConfig.isEventDriven)
+    {
+        m_scriptHotReloader = new ScriptHotReloader(hotReloadConfig);
+        if (!m_scriptHotReloader->Start())
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning, "App::SetupScriptingBindings - Event-driven hot reload unavailable, using Engine FileWatcher");
+            delete m_scriptHotReloader;
+            m_scriptHotReloader = nullptr;
+        }
+    }
+
+    if (m_scriptHotReloader)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Log, "App::SetupScriptingBindings - Event-driven hot reload initialized successfully");
+    }
+    else if (g_scriptSubsystem->InitializeHotReload("../"))
     {
         DAEMON_LOG(LogApp, eLogVerbosity::Log, "App::SetupScriptingBindings - Hot-reload system initialized successfully");
     }
@@ -2560,6 +5131,18 @@ void App::SetupScriptingBindings()
         g_scriptSubsystem->RegisterScriptableObject("commandQueue", m_genericCommandScriptInterface);
     }
 
+    // Expose typed command buffer (CommandQueue.js submitTyped() falls back to JSON if absent)
+    if (m_typedCommandBuffer)
+    {
+        m_typedCommandBuffer->InstallScriptBuffer(g_scriptSubsystem->GetIsolate(), "typedCommandBuffer");
+    }
+
+    // Expose structured result ring (CommandQueue.js submitStructured() falls back to JSON if absent)
+    if (m_callbackResultRing)
+    {
+        m_callbackResultRing->InstallScriptBuffer(g_scriptSubsystem->GetIsolate(), "callbackResultRing");
+    }
+
     // Register global functions
     g_scriptSubsystem->RegisterGlobalFunction("print", OnPrint);
     g_scriptSubsystem->RegisterGlobalFunction("debug", OnDebug);
@@ -2573,7 +5156,8 @@ void App::SetupScriptingBindings()
 //
 // Consumes all pending GenericCommands from the queue and dispatches them to registered handlers
 // via GenericCommandExecutor. Follows the same ConsumeAll pattern as ProcessRenderCommands and
-// ProcessAudioCommands.
+// ProcessAudioCommands. Commands from native producer threads (ExternalCommandQueue) run after the
+// JavaScript ones, in per-producer submission order.
 //
 // Called from Update() on the main render thread, after ProcessAudioCommands().
 //----------------------------------------------------------------------------------------------------
@@ -2584,21 +5168,508 @@ void App::ProcessGenericCommands()
         return;
     }
 
+    ProfileScope const scope("App::ProcessGenericCommands");
+
     m_genericCommandQueue->ConsumeAll([this](GenericCommand const& cmd)
     {
-        m_genericCommandExecutor->ExecuteCommand(cmd);
+        DispatchGenericCommand(cmd);
     });
+
+    if (m_externalCommandQueue)
+    {
+        m_externalCommandQueue->ConsumeAll([this](GenericCommand const& cmd, sExternalCommandInfo const&)
+        {
+            DispatchGenericCommand(cmd);
+        });
+    }
+
+    // Finished model loads complete their deferred load_model commands before the dispatcher delivers
+    if (m_modelLoader)
+    {
+        m_modelLoader->Update();
+    }
+
+    // Deliver finished async handlers through the executor (their callbacks go out with this frame's)
+    m_genericCommandDispatcher->Update();
+    ReclaimCompletedJobs();
+}
+
+//----------------------------------------------------------------------------------------------------
+// DispatchGenericCommand
+//
+// ANY_THREAD / IO handlers are handed to the dispatcher; everything else runs inline. Shared by the
+// JS queue, the external queue and the benchmark runner.
+//----------------------------------------------------------------------------------------------------
+void App::DispatchGenericCommand(GenericCommand const& command)
+{
+    ProfileScope const commandScope(FrameProfiler::IsEnabled() ? FrameProfiler::InternName(command.type) : nullptr);
+
+    if (m_stateRecorder)
+    {
+        m_stateRecorder->RecordCommand(command);
+    }
+
+    if (m_isAsyncDispatchEnabled && m_genericCommandDispatcher->TryDispatch(command))
+    {
+        return;
+    }
+    m_genericCommandExecutor->ExecuteCommand(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+// ReclaimCompletedJobs
+//
+// Only the fire-and-forget jobs Game submitted (GenericCommandDispatcher, AsyncModelLoader) are
+// deleted here. The JobSystem is shared with the Engine (ResourceSubsystem) and a retrieved job
+// cannot be handed back, so the completed queue is only read while one of those is outstanding.
+// Anything else that comes out of it is kept, never deleted: long-lived Game jobs belong to their
+// owners (JSGameLogicJob to Shutdown(), pool shards to JSWorkerPool), unknown jobs to the Engine.
+//----------------------------------------------------------------------------------------------------
+void App::ReclaimCompletedJobs()
+{
+    auto const hasSubmittedJobs = [this]()
+    {
+        return m_genericCommandDispatcher->HasSubmittedJobs() || (m_modelLoader && m_modelLoader->HasSubmittedJobs());
+    };
+
+    while (hasSubmittedJobs())
+    {
+        Job* const job = g_jobSystem->RetrieveCompletedJob();
+        if (job == nullptr)
+        {
+            return;
+        }
+
+        if (m_genericCommandDispatcher->ReleaseJob(job) || (m_modelLoader && m_modelLoader->ReleaseJob(job)))
+        {
+            delete job;
+            continue;
+        }
+
+        bool const isGameJob = job == m_jsGameLogicJob || (m_jsWorkerPool && m_jsWorkerPool->OwnsJob(job));
+        if (!isGameJob && m_unclaimedJobs.empty())
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning, "App: Retrieved a completed job Game did not submit; it is kept, not deleted");
+        }
+        if (!isGameJob)
+        {
+            m_unclaimedJobs.push_back(job);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Helper: Swap one state buffer and record its per-frame swap counters
+//
+// StateBuffer copies only the keys passed to MarkDirty(), but its buffer-level dirty flag is raised
+// by every GetBackBuffer() call (including lookups that miss), so a frame with no real writes still
+// pays for a swap. The App-side mark count lets us skip those swaps entirely. EntityStore tracks its
+// own dirty slots and pending releases (Create() and Destroy() mark themselves), so it decides.
+//----------------------------------------------------------------------------------------------------
+template <typename TStateBuffer>
+static void SwapStateBufferWithStats(TStateBuffer* buffer, sStateBufferSwapStats& stats)
+{
+    if (!buffer)
+    {
+        return;
+    }
+
+    bool isDirty = stats.pendingDirtyMarks != 0;
+    if constexpr (requires { buffer->HasPendingChanges(); })
+    {
+        isDirty = buffer->HasPendingChanges();
+    }
+
+    if (!isDirty)
+    {
+        stats.lastSwapMs        = 0.0;
+        stats.lastEntriesCopied = 0;
+        stats.pendingDirtyMarks = 0;     // Marks the buffer rejected (unknown slots)
+        ++stats.skippedSwapCount;
+        return;
+    }
+
+    uint64_t copiesBefore = 0;
+    if constexpr (requires { buffer->GetCopyCount(); })
+    {
+        copiesBefore = static_cast<uint64_t>(buffer->GetCopyCount());
+    }
+
+    auto const swapStart = std::chrono::steady_clock::now();
+    buffer->SwapBuffers();
+    auto const swapEnd = std::chrono::steady_clock::now();
+
+    stats.lastSwapMs = std::chrono::duration<double, std::milli>(swapEnd - swapStart).count();
+    if (stats.lastSwapMs > stats.maxSwapMs) stats.maxSwapMs = stats.lastSwapMs;
+
+    if constexpr (requires { buffer->GetCopyCount(); })
+    {
+        stats.lastEntriesCopied = static_cast<uint64_t>(buffer->GetCopyCount()) - copiesBefore;
+    }
+    else
+    {
+        stats.lastEntriesCopied = stats.pendingDirtyMarks;  // Upper bound (repeat marks of one key)
+    }
+
+    stats.totalEntriesCopied += stats.lastEntriesCopied;
+    stats.pendingDirtyMarks = 0;
+    ++stats.swapCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// UpdateJSFrameWatchdog
+//
+// Frames are detected through GetTotalFrames(), so lockstep and pipelined workers are measured the
+// same way (a pipelined worker that finished several frames since the last tick reports its latest).
+//----------------------------------------------------------------------------------------------------
+void App::UpdateJSFrameWatchdog()
+{
+    bool isPolicyChanged = false;
+
+    uint64_t const workerFrames = m_jsGameLogicJob->GetTotalFrames();
+    if (workerFrames != m_watchdogFrameCount)
+    {
+        m_watchdogFrameCount = workerFrames;
+        isPolicyChanged      = m_jsFrameWatchdog->OnFrameCompleted(m_jsGameLogicJob->GetLastFrameMs(), m_jsGameLogicJob->GetLastFrameTicks());
+    }
+    else if (m_jsFrameWatchdog->CheckHang(m_jsGameLogicJob->GetRunningFrameMs()))
+    {
+        m_jsGameLogicJob->TerminateRunningFrame();
+        isPolicyChanged = true;
+    }
+
+    if (isPolicyChanged)
+    {
+        m_jsGameLogicJob->SetWorkShedPolicy(static_cast<uint32_t>(m_jsFrameWatchdog->GetLevel()),
+                                            m_jsFrameWatchdog->GetInterval(),
+                                            m_jsFrameWatchdog->GetMinPriority());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// SyncResultRingMeshTypes
+//
+// Structured entity results carry MeshHandles; JS resolves them to meshType names it was sent once.
+// Only handles interned since the last sync (or everything, after a JS reload) are staged.
+//----------------------------------------------------------------------------------------------------
+void App::SyncResultRingMeshTypes()
+{
+    uint32_t const firstHandle = m_callbackResultRing->GetMeshTypesSent();
+    uint32_t const handleCount = m_meshHandleTable ? m_meshHandleTable->GetCount() : 0;
+    if (firstHandle >= handleCount)
+    {
+        return;
+    }
+
+    std::vector<char> names;
+    for (MeshHandle handle = firstHandle; handle < handleCount; ++handle)
+    {
+        sMeshHandleEntry const* entry = m_meshHandleTable->Find(handle);
+        if (entry)
+        {
+            names.insert(names.end(), entry->meshType.begin(), entry->meshType.end());
+        }
+        names.push_back('\0');
+    }
+
+    m_callbackResultRing->WriteMeshTypes(firstHandle, handleCount - firstHandle, names);
+}
+
+//----------------------------------------------------------------------------------------------------
+// SwapStateBuffers
+//
+// Called once per completed JavaScript frame, right before TriggerNextFrame().
+//----------------------------------------------------------------------------------------------------
+void App::SwapStateBuffers()
+{
+    ProfileScope const scope("App::SwapStateBuffers");
+
+    SwapStateBufferWithStats(m_entityStore, m_entitySwapStats);
+    SwapStateBufferWithStats(m_cameraStateBuffer, m_cameraSwapStats);
+    SwapStateBufferWithStats(m_audioStateBuffer, m_audioSwapStats);
+
+    if (m_stateRecorder)
+    {
+        m_stateRecorder->RecordSwap(*m_entityStore, *m_cameraStateBuffer, *m_meshHandleTable, m_cameraSwapStats.lastEntriesCopied > 0);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// UpdateStateReplay
+//
+// The replayer writes the back buffers directly, like the GenericCommand handlers; its camera marks
+// go into the same swap counter so SwapStateBuffers() skips nothing it wrote.
+//----------------------------------------------------------------------------------------------------
+void App::UpdateStateReplay()
+{
+    ProfileScope const scope("App::UpdateStateReplay");
+
+    sStateReplayTick tick;
+    m_stateReplayer->Update(*m_entityStore, *m_cameraStateBuffer, *m_meshHandleTable, tick);
+    if (tick.frames > 0)
+    {
+        m_cameraSwapStats.pendingDirtyMarks += tick.cameraMarks;
+        SwapStateBuffers();
+    }
+
+    if (m_stateReplayer->IsFinished() && m_stateReplayer->IsQuitWhenDone())
+    {
+        RequestQuit();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void App::MarkEntityDirty(uint32_t const slot)
+{
+    m_entityStore->MarkDirty(slot);     // EntityStore::HasPendingChanges() decides its swap
+}
+
+//----------------------------------------------------------------------------------------------------
+void App::MarkCameraDirty(EntityID const cameraId)
+{
+    m_cameraStateBuffer->MarkDirty(cameraId);
+    ++m_cameraSwapStats.pendingDirtyMarks;
+}
+
+//----------------------------------------------------------------------------------------------------
+void App::MarkAudioDirty(SoundID const soundId)
+{
+    m_audioStateBuffer->MarkDirty(soundId);
+    ++m_audioSwapStats.pendingDirtyMarks;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ProcessScriptHotReload
+//
+// Runs on the main thread like game.execute_command; ScriptSubsystem serializes with the worker.
+// After an incremental reload JSEngine upgrades live system instances immediately, so the reported
+// latency ends with the new code live rather than at the next worker frame. A full reload re-runs
+// main.js, which replaces JSEngine itself.
+//----------------------------------------------------------------------------------------------------
+void App::ProcessScriptHotReload()
+{
+    if (!m_scriptHotReloader)
+    {
+        return;
+    }
+
+    // The watcher thread ends when the OS stops accepting its reads; fall back to polling
+    if (!m_scriptHotReloader->IsWatching())
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning, "App::ProcessScriptHotReload - Script watcher stopped, using Engine FileWatcher");
+        delete m_scriptHotReloader;
+        m_scriptHotReloader = nullptr;
+
+        if (!g_scriptSubsystem->InitializeHotReload("../"))
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning, "App::ProcessScriptHotReload - Hot-reload system initialization failed");
+        }
+        return;
+    }
+
+    sScriptReloadPlan plan;
+    if (!m_scriptHotReloader->Poll(plan))
+    {
+        return;
+    }
+
+    ProfileScope const scope("App::ProcessScriptHotReload");
+
+    bool isSuccess = true;
+    for (String const& module : plan.modules)
+    {
+        String const modulePath = m_scriptHotReloader->GetScriptsDirectory() + "/" + module;
+        if (!g_scriptSubsystem->ExecuteModule(modulePath))
+        {
+            isSuccess = false;
+            DAEMON_LOG(LogScript, eLogVerbosity::Error,
+                       Stringf("App::ProcessScriptHotReload - %s failed: %s", modulePath.c_str(),
+                           g_scriptSubsystem->HasError() ? g_scriptSubsystem->GetLastError().c_str() : "unknown error"));
+            break;
+        }
+    }
+
+    if (isSuccess && !plan.isFullReload)
+    {
+        g_scriptSubsystem->ExecuteScript("if (globalThis.JSEngine) { globalThis.JSEngine.checkForHotReloads(); }");
+    }
+
+    m_scriptHotReloader->CompleteReload(plan, isSuccess);
+}
+
+//----------------------------------------------------------------------------------------------------
+// ApplyAudioSourceBatch
+//
+// Only sources whose position / volume actually changed reach FMOD; the AudioStateBuffer mirrors
+// them like the per-sound handlers did.
+//----------------------------------------------------------------------------------------------------
+void App::ApplyAudioSourceBatch()
+{
+    if (!m_audioSourceBatcher)
+    {
+        return;
+    }
+
+    ProfileScope const scope("App::ApplyAudioSourceBatch");
+
+    std::vector<sAudioSourceChange> const& changes    = m_audioSourceBatcher->Collect(m_entityStore);
+    auto*                                  backBuffer = m_audioStateBuffer->GetBackBuffer();
+    for (sAudioSourceChange const& change : changes)
+    {
+        if (g_audio)
+        {
+            if (change.hasPosition) g_audio->SetSoundPosition(change.soundId, change.position);
+            if (change.hasVolume) g_audio->SetSoundPlaybackVolume(change.soundId, change.volume);
+        }
+
+        auto it = backBuffer->find(change.soundId);
+        if (it != backBuffer->end())
+        {
+            if (change.hasPosition) it->second.position = change.position;
+            if (change.hasVolume) it->second.volume = change.volume;
+            MarkAudioDirty(change.soundId);
+        }
+    }
+
+    if (g_audio && m_audioSourceBatcher->IsListenerChanged())
+    {
+        sAudioListenerState const& listener = m_audioSourceBatcher->GetListener();
+        g_audio->UpdateListener(0, listener.position, listener.forward, listener.up);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// RegisterTypedCommandHandlers
+//
+// POD counterparts of the fire-and-forget entity.*, camera.* and update_3d_position JSON handlers.
+// Records are applied by TypedCommandBuffer::Drain() once per completed JavaScript frame and write
+// the same state buffer fields as their JSON equivalents, so both paths are interchangeable.
+//----------------------------------------------------------------------------------------------------
+void App::RegisterTypedCommandHandlers()
+{
+    if (!m_typedCommandBuffer)
+    {
+        return;
+    }
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::ENTITY_UPDATE_POSITION,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint32_t const slot = m_entityStore->FindSlot(static_cast<EntityID>(record.targetId));
+                                              if (slot != EntityStore::INVALID_SLOT)
+                                              {
+                                                  m_entityStore->GetBack().positions[slot] = Vec3(record.values[0], record.values[1], record.values[2]);
+                                                  MarkEntityDirty(slot);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::ENTITY_MOVE_BY,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint32_t const slot = m_entityStore->FindSlot(static_cast<EntityID>(record.targetId));
+                                              if (slot != EntityStore::INVALID_SLOT)
+                                              {
+                                                  m_entityStore->GetBack().positions[slot] += Vec3(record.values[0], record.values[1], record.values[2]);
+                                                  MarkEntityDirty(slot);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::ENTITY_UPDATE_ORIENTATION,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint32_t const slot = m_entityStore->FindSlot(static_cast<EntityID>(record.targetId));
+                                              if (slot != EntityStore::INVALID_SLOT)
+                                              {
+                                                  m_entityStore->GetBack().orientations[slot] = EulerAngles(record.values[0], record.values[1], record.values[2]);
+                                                  MarkEntityDirty(slot);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::ENTITY_UPDATE_COLOR,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint32_t const slot = m_entityStore->FindSlot(static_cast<EntityID>(record.targetId));
+                                              if (slot != EntityStore::INVALID_SLOT)
+                                              {
+                                                  auto toByte = [](float const v) { return static_cast<unsigned char>(v < 0.f ? 0.f : (v > 255.f ? 255.f : v)); };
+                                                  m_entityStore->GetBack().colors[slot] = Rgba8(toByte(record.values[0]), toByte(record.values[1]), toByte(record.values[2]), toByte(record.values[3]));
+                                                  MarkEntityDirty(slot);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::CAMERA_UPDATE,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint64_t const cameraId   = static_cast<uint64_t>(record.targetId);
+                                              auto*          backBuffer = m_cameraStateBuffer->GetBackBuffer();
+                                              auto           it         = backBuffer->find(cameraId);
+                                              if (it != backBuffer->end())
+                                              {
+                                                  it->second.position    = Vec3(record.values[0], record.values[1], record.values[2]);
+                                                  it->second.orientation = EulerAngles(record.values[3], record.values[4], record.values[5]);
+                                                  MarkCameraDirty(cameraId);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::CAMERA_UPDATE_POSITION,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint64_t const cameraId   = static_cast<uint64_t>(record.targetId);
+                                              auto*          backBuffer = m_cameraStateBuffer->GetBackBuffer();
+                                              auto           it         = backBuffer->find(cameraId);
+                                              if (it != backBuffer->end())
+                                              {
+                                                  it->second.position = Vec3(record.values[0], record.values[1], record.values[2]);
+                                                  MarkCameraDirty(cameraId);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::CAMERA_UPDATE_ORIENTATION,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint64_t const cameraId   = static_cast<uint64_t>(record.targetId);
+                                              auto*          backBuffer = m_cameraStateBuffer->GetBackBuffer();
+                                              auto           it         = backBuffer->find(cameraId);
+                                              if (it != backBuffer->end())
+                                              {
+                                                  it->second.orientation = EulerAngles(record.values[0], record.values[1], record.values[2]);
+                                                  MarkCameraDirty(cameraId);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::CAMERA_MOVE_BY,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              uint64_t const cameraId   = static_cast<uint64_t>(record.targetId);
+                                              auto*          backBuffer = m_cameraStateBuffer->GetBackBuffer();
+                                              auto           it         = backBuffer->find(cameraId);
+                                              if (it != backBuffer->end())
+                                              {
+                                                  it->second.position += Vec3(record.values[0], record.values[1], record.values[2]);
+                                                  MarkCameraDirty(cameraId);
+                                              }
+                                          });
+
+    m_typedCommandBuffer->RegisterHandler(eTypedCommand::AUDIO_UPDATE_3D_POSITION,
+                                          [this](sTypedCommandRecord const& record)
+                                          {
+                                              SoundID const soundId = static_cast<SoundID>(record.targetId);
+                                              m_audioSourceBatcher->StagePosition(soundId, Vec3(record.values[0], record.values[1], record.values[2]));
+                                          });
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::RenderEntities() const
 {
-    EntityStateMap const* frontBuffer = m_entityStateBuffer->GetFrontBuffer();
-    if (!frontBuffer)
+    ProfileScope const scope("App::RenderEntities");
+
+    if (!m_entityStore || !m_meshHandleTable || !m_gpuMeshCache || !m_entityBatchRenderer)
     {
         return;
     }
 
+    sEntityArrays const& front = m_entityStore->GetFront();
+
     // Get active camera from camera state buffer
     Camera const* worldCamera = nullptr;
     if (m_cameraStateBuffer)
@@ -2616,48 +5687,138 @@ void App::RenderEntities() const
         return;
     }
 
+    // Mesh and camera types were interned on create; in steady state the loop below is allocation-free
+    // (a handle does its one MeshCache lookup the first frame it is drawn)
+    sScopedAllocationCount allocationScope;
+    uint32_t               drawnEntities = 0;
+    uint32_t               drawCalls     = 0;
+    uint64_t const         frameNumber   = static_cast<uint64_t>(Clock::GetSystemClock().GetFrameCount());
+
     g_renderer->BeginCamera(*worldCamera);
 
-    for (auto const& [entityId, state] : *frontBuffer)
+    // Candidate slots: frustum-culled through the spatial grid for perspective cameras, else every slot
+    bool isCulling = false;
+    if (m_isFrustumCullingEnabled)
+    {
+        CameraStateMap const* cameraFront = m_cameraStateBuffer->GetFrontBuffer();
+        if (cameraFront)
+        {
+            auto const cameraIt = cameraFront->find(m_cameraStateBuffer->GetActiveCameraID());
+            if (cameraIt != cameraFront->end() && cameraIt->second.mode == Camera::eMode_Perspective)
+            {
+                CameraState const& cameraState = cameraIt->second;
+                sViewFrustum const frustum     = sViewFrustum::MakePerspective(cameraState.position, cameraState.orientation,
+                                                                               cameraState.perspectiveFOV, cameraState.perspectiveAspect,
+                                                                               cameraState.perspectiveNear, cameraState.perspectiveFar);
+                m_entityStore->GetSpatialGrid().QueryFrustum(frustum, m_visibleEntitySlots);
+                isCulling = true;
+            }
+        }
+    }
+
+    // Fixed-timestep mode: blend between the last two simulation states (culling uses the newest)
+    bool const  isInterpolating    = m_simulationScheduler && m_entityStore->IsInterpolationEnabled();
+    float const interpolationAlpha = isInterpolating ? m_simulationScheduler->GetInterpolationAlpha() : 1.f;
+
+    // Static primitives are drawn from cached batches; batches with a changed member are released here
+    if (m_isEntityBatchingEnabled)
+    {
+        m_entityBatchRenderer->BeginFrame(*m_entityStore, frameNumber);
+    }
+    else
+    {
+        m_entityBatchRenderer->ReleaseAll();
+    }
+
+    uint32_t const candidateCount = isCulling ? static_cast<uint32_t>(m_visibleEntitySlots.size()) : front.GetSlotCount();
+    for (uint32_t candidate = 0; candidate < candidateCount; ++candidate)
     {
-        if (!state.isActive) continue;
-        if (state.cameraType != "world") continue;
+        uint32_t const slot = isCulling ? m_visibleEntitySlots[candidate] : candidate;
+
+        if (!front.activeFlags[slot]) continue;
+        if (front.cameraTypeIds[slot] != eEntityCameraType::WORLD) continue;
+
+        // OBJ models still loading are drawn as the placeholder primitive under its own handle
+        MeshHandle              meshHandle    = front.meshHandles[slot];
+        bool                    isPlaceholder = false;
+        sMeshHandleEntry const* mesh          = m_meshHandleTable->ResolveForDraw(meshHandle, *m_meshCache, isPlaceholder);
+        if (!mesh) continue;
 
         Mat44 modelMatrix;
-        modelMatrix.SetTranslation3D(state.position);
-        modelMatrix.Append(state.orientation.GetAsMatrix_IFwd_JLeft_KUp());
+        if (isInterpolating)
+        {
+            modelMatrix.SetTranslation3D(m_entityStore->GetInterpolatedPosition(slot, interpolationAlpha));
+            modelMatrix.Append(m_entityStore->GetInterpolatedOrientation(slot, interpolationAlpha).GetAsMatrix_IFwd_JLeft_KUp());
+        }
+        else
+        {
+            modelMatrix.SetTranslation3D(front.positions[slot]);
+            modelMatrix.Append(front.orientations[slot].GetAsMatrix_IFwd_JLeft_KUp());
+        }
 
-        // Apply uniform scale for OBJ models (primitives bake scale into vertices via MeshCache)
-        if (state.meshType.size() > 4 && state.meshType.substr(0, 4) == "obj:")
+        // Apply uniform scale for OBJ models and their placeholder (primitives bake scale into vertices via MeshCache)
+        if (mesh->isModel || isPlaceholder)
         {
-            modelMatrix.AppendScaleUniform3D(state.radius);
+            modelMatrix.AppendScaleUniform3D(front.radii[slot]);
         }
 
-        g_renderer->SetModelConstants(modelMatrix, state.color);
-        Texture* tex = (state.textureId != 0)
-                           ? reinterpret_cast<Texture*>(state.textureId)
-                           : nullptr;
-        g_renderer->BindTexture(tex);
+        ++drawnEntities;
 
-        if (state.meshType.size() > 4 && state.meshType.substr(0, 4) == "obj:")
+        // Primitives already in a cached batch are drawn by Flush(); the rest draw per entity below and
+        // are offered for batching. A slot changed by the latest swap may still be mid-interpolation,
+        // so it is not offered until a later swap settles it.
+        if (m_isEntityBatchingEnabled && !mesh->isModel)
         {
-            // OBJ model — PCUTBN with indexed rendering (preserves normals for lighting)
-            ModelMeshData const* model = m_meshCache->GetOrCreateModel(state.meshType);
-            if (model && !model->vertices.empty())
+            if (m_entityBatchRenderer->IsBatched(slot)) continue;
+
+            uint64_t const slotVersion = m_entityStore->GetSlotVersion(slot);
+            if (!isInterpolating || slotVersion != m_entityStore->GetVersion())
             {
-                g_renderer->DrawVertexArray(model->vertices, model->indices);
+                m_entityBatchRenderer->Offer(slot, slotVersion, meshHandle, *mesh, front.textureIds[slot], modelMatrix, front.colors[slot]);
             }
         }
+
+        g_renderer->SetModelConstants(modelMatrix, front.colors[slot]);
+        Texture* tex = (front.textureIds[slot] != 0)
+                           ? reinterpret_cast<Texture*>(front.textureIds[slot])
+                           : nullptr;
+        g_renderer->BindTexture(tex);
+
+        // Resident GPU buffers (OBJ models: PCUTBN indexed, primitives: PCU); stream from the CPU
+        // copy only if the upload failed
+        sGpuMesh const* gpuMesh = m_gpuMeshCache->Acquire(meshHandle, *mesh, frameNumber);
+        if (gpuMesh)
+        {
+            m_gpuMeshCache->Draw(*gpuMesh);
+        }
+        else if (mesh->isModel)
+        {
+            g_renderer->DrawVertexArray(mesh->model->vertices, mesh->model->indices);
+        }
         else
         {
-            // Primitive — PCU
-            VertexList_PCU const* verts = m_meshCache->GetOrCreate(state.meshType, state.radius, Rgba8::WHITE);
-            if (verts && !verts->empty())
-            {
-                g_renderer->DrawVertexArray(static_cast<int>(verts->size()), verts->data());
-            }
+            g_renderer->DrawVertexArray(static_cast<int>(mesh->primitive->size()), mesh->primitive->data());
         }
+
+        ++drawCalls;
+    }
+
+    if (m_isEntityBatchingEnabled)
+    {
+        drawCalls += m_entityBatchRenderer->Flush(*g_renderer);
     }
 
     g_renderer->EndCamera(*worldCamera);
+
+    m_gpuMeshCache->EnforceBudget(frameNumber);
+
+    m_entityRenderStats.lastDrawnEntities   = drawnEntities;
+    m_entityRenderStats.lastCulledEntities  = isCulling ? m_entityStore->GetSpatialGrid().GetEntryCount() - candidateCount : 0;
+    m_entityRenderStats.lastDrawCalls       = drawCalls;
+    m_entityRenderStats.lastBatchedEntities = m_isEntityBatchingEnabled ? m_entityBatchRenderer->GetLastBatchedEntities() : 0;
+    m_entityRenderStats.lastAllocations     = allocationScope.GetCount();
+    if (m_entityRenderStats.lastAllocations > m_entityRenderStats.maxAllocations)
+    {
+        m_entityRenderStats.maxAllocations = m_entityRenderStats.lastAllocations;
+    }
 }
@@ -4,25 +4,76 @@
 #pragma once
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/GenericCommand.hpp"
 #include "Engine/Entity/EntityStateBuffer.hpp"
 #include "Engine/Audio/AudioStateBuffer.hpp"
 //----------------------------------------------------------------------------------------------------
 #include <any>
+#include <vector>
 
 //----------------------------------------------------------------------------------------------------
 // Forward Declarations
 //----------------------------------------------------------------------------------------------------
+class AsyncModelLoader;
+class AudioSourceBatcher;
+class BenchmarkRunner;
 class CameraStateBuffer;
 class CallbackQueue;
 class CallbackQueueScriptInterface;
+class CallbackResultRing;
+class DebugLayerRenderer;
+class EntityBatchRenderer;
+class EntityStore;
+class ExternalCommandQueue;
+class FixedTimestepScheduler;
 class FrameEventQueue;
 class FrameEventQueueScriptInterface;
+class GenericCommandDispatcher;
 class GenericCommandExecutor;
 class GenericCommandQueue;
 class GenericCommandScriptInterface;
+class GpuMeshCache;
+class Job;
+class JSFramePipeline;
+class JSFrameWatchdog;
+class JSGCScheduler;
 class JSGameLogicJob;
+class JSWorkerPool;
 class KADIScriptInterface;
 class MeshCache;
+class MeshHandleTable;
+class ScriptHotReloader;
+class StartupTimeline;
+class StateRecorder;
+class StateReplayer;
+class TypedCommandBuffer;
+
+//----------------------------------------------------------------------------------------------------
+// Per-buffer swap counters (reported by game.get_engine_metrics)
+//----------------------------------------------------------------------------------------------------
+struct sStateBufferSwapStats
+{
+    uint64_t pendingDirtyMarks  = 0;      // MarkDirty() calls since the last swap (not kept for EntityStore, which tracks its own)
+    uint64_t lastEntriesCopied  = 0;      // Entries copied by the most recent swap
+    uint64_t totalEntriesCopied = 0;
+    uint64_t swapCount          = 0;
+    uint64_t skippedSwapCount   = 0;      // Frames where nothing was dirty
+    double   lastSwapMs         = 0.0;
+    double   maxSwapMs          = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// RenderEntities() counters (allocations are measured with AllocationCounter; 0 unless it is enabled)
+//----------------------------------------------------------------------------------------------------
+struct sEntityRenderStats
+{
+    uint32_t lastDrawnEntities   = 0;
+    uint32_t lastCulledEntities  = 0;      // Grid entries rejected by the frustum test
+    uint32_t lastDrawCalls       = 0;
+    uint32_t lastBatchedEntities = 0;      // Static primitives drawn from EntityBatchRenderer batches
+    uint64_t lastAllocations     = 0;      // operator new calls inside the last RenderEntities()
+    uint64_t maxAllocations      = 0;
+};
 
 //----------------------------------------------------------------------------------------------------
 class App
@@ -41,6 +92,15 @@ public:
     static void RequestQuit();
     static bool m_isQuitting;
 
+    // No Window/Renderer (or Headless.json "headless": true): no Render/DebugRender/ImGui/DevConsole
+    // calls, GPU-dependent commands fail with ERR_HEADLESS
+    static bool IsHeadless() { return m_isHeadless; }
+    static bool m_isHeadless;
+
+    // Entry point for native producer threads (JSWorkerPool shards' submitCommand; KADI, inspector,
+    // network); nullptr when disabled. Producers must stop submitting before App::Shutdown()
+    ExternalCommandQueue* GetExternalCommandQueue() const { return m_externalCommandQueue; }
+
 private:
     void BeginFrame() const;
     void Update();
@@ -54,8 +114,32 @@ private:
     void UpdateCursorMode();
     void SetupScriptingBindings();
 
+    // Script hot reload: re-run the modules ScriptHotReloader picked for this frame's saves
+    void ProcessScriptHotReload();
+
     // Command Processing
     void ProcessGenericCommands();
+    void DispatchGenericCommand(GenericCommand const& command);
+    void ReclaimCompletedJobs();
+    void RegisterTypedCommandHandlers();
+
+    // Worker frame budget watchdog (JSFrameWatchdog.hpp)
+    void UpdateJSFrameWatchdog();
+
+    // Stage meshType names for MeshHandles the structured result ring has not sent yet
+    void SyncResultRingMeshTypes();
+
+    // State Buffer Swap (dirty-only, with per-frame counters)
+    void SwapStateBuffers();
+    void MarkEntityDirty(uint32_t slot);
+    void MarkCameraDirty(EntityID cameraId);
+    void MarkAudioDirty(SoundID soundId);
+
+    // Audio: apply the frame's audio.update_sources / entity-attached source changes in one pass
+    void ApplyAudioSourceBatch();
+
+    // State replay: apply the recorded frames that are due, in place of a JS frame
+    void UpdateStateReplay();
 
     // Rendering
     void RenderEntities() const;
@@ -75,17 +159,60 @@ private:
     FrameEventQueue*        m_frameEventQueue        = nullptr;
     GenericCommandQueue*    m_genericCommandQueue    = nullptr;
     GenericCommandExecutor* m_genericCommandExecutor = nullptr;
+    ExternalCommandQueue*   m_externalCommandQueue   = nullptr;     // MPSC queue for native threads (GenericCommand.json)
     JSGameLogicJob*         m_jsGameLogicJob         = nullptr;
+    JSFramePipeline*        m_jsFramePipeline        = nullptr;     // Pipelined worker mode only (JSWorker.json)
+    JSWorkerPool*           m_jsWorkerPool           = nullptr;     // Sharded behavior isolates (JSWorker.json)
+    FixedTimestepScheduler* m_simulationScheduler    = nullptr;     // simulationMode "fixed" only (JSWorker.json)
+    JSFrameWatchdog*        m_jsFrameWatchdog        = nullptr;     // Frame budget / work shedding (JSWorker.json)
+    JSGCScheduler*          m_jsGCScheduler          = nullptr;     // Idle-time GC between worker frames (JSWorker.json)
+    uint64_t                m_watchdogFrameCount     = 0;           // Worker frames already reported to the watchdog
+    uint32_t                m_simTicksInFlight       = 0;           // Ticks of the running lockstep worker frame
+    TypedCommandBuffer*     m_typedCommandBuffer     = nullptr;
+    CallbackResultRing*     m_callbackResultRing     = nullptr;     // Structured query results (GenericCommand.json)
+    std::vector<double>     m_resultRingScratch;                    // Handler scratch (keeps capacity)
+
+    GenericCommandDispatcher* m_genericCommandDispatcher = nullptr;     // Handler thread affinity (GenericCommand.json)
+    bool                      m_isAsyncDispatchEnabled   = true;        // false = every handler runs inline
+    std::vector<Job*>         m_unclaimedJobs;                          // Engine jobs ReclaimCompletedJobs() retrieved (never deleted)
 
     //------------------------------------------------------------------------------------------------
     // State Buffers (Double-buffered for async updates)
     //------------------------------------------------------------------------------------------------
-    EntityStateBuffer* m_entityStateBuffer = nullptr;
+    EntityStore*       m_entityStore       = nullptr;     // SoA slot map (replaces EntityStateBuffer)
     CameraStateBuffer* m_cameraStateBuffer = nullptr;
     AudioStateBuffer*  m_audioStateBuffer  = nullptr;
 
+    sStateBufferSwapStats m_entitySwapStats;
+    sStateBufferSwapStats m_cameraSwapStats;
+    sStateBufferSwapStats m_audioSwapStats;
+
+    AudioSourceBatcher* m_audioSourceBatcher = nullptr;     // 3D source / listener updates, applied once per frame
+    uint32_t            m_audioMaxChannels   = 128;         // EngineSubsystems.json subsystems.audio.config.maxChannels
+
     //------------------------------------------------------------------------------------------------
     // APIs (Direct management interfaces)
     //------------------------------------------------------------------------------------------------
-    MeshCache* m_meshCache = nullptr;
+    MeshCache*           m_meshCache           = nullptr;
+    MeshHandleTable*     m_meshHandleTable     = nullptr;     // Interned meshType → MeshHandle
+    GpuMeshCache*        m_gpuMeshCache        = nullptr;     // Resident VBO/IBO per MeshHandle
+    EntityBatchRenderer* m_entityBatchRenderer = nullptr;     // Cached batches for static primitive entities
+    AsyncModelLoader*    m_modelLoader         = nullptr;     // OBJ parsing off the main thread
+    DebugLayerRenderer*  m_debugLayerRenderer  = nullptr;     // debug_render.add_batch frame batch + layers
+
+    bool                          m_isEntityBatchingEnabled = true;
+    bool                          m_isFrustumCullingEnabled = true;
+    mutable sEntityRenderStats    m_entityRenderStats;
+    mutable std::vector<uint32_t> m_visibleEntitySlots;     // RenderEntities() scratch (keeps capacity)
+
+    float m_headlessTickRate = 0.f;     // Headless main loop rate in Hz (0 = unthrottled)
+
+    BenchmarkRunner* m_benchmarkRunner = nullptr;     // -benchmark / Benchmark.json "enabled" only
+    StartupTimeline* m_startupTimeline = nullptr;     // Startup phase timing up to the first ready frame
+
+    ScriptHotReloader* m_scriptHotReloader = nullptr;     // HotReload.json eventDriven only (else Engine FileWatcher)
+
+    StateRecorder* m_stateRecorder = nullptr;     // -record / Recording.json / game.start_recording
+    StateReplayer* m_stateReplayer = nullptr;     // -replay / Recording.json "replay" (the JS worker is not started)
+    String         m_recordingPath;               // Recording.json path (default for game.start_recording)
 };
@@ -0,0 +1,331 @@
+//----------------------------------------------------------------------------------------------------
+// AsyncModelLoader.cpp
+// OBJ model loads on a JobSystem worker with per-path deduplication
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/AsyncModelLoader.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------
+// How long Shutdown() waits for the load in flight before abandoning it
+static int constexpr SHUTDOWN_WAIT_ITERATIONS   = 500;
+static int constexpr SHUTDOWN_WAIT_MILLISECONDS = 10;
+
+//----------------------------------------------------------------------------------------------------
+struct sModelLoadChannel
+{
+    explicit sModelLoadChannel(String const& binaryCacheDirectory)
+        : binaryCache(binaryCacheDirectory)
+    {
+    }
+
+    BinaryMeshCache const binaryCache;
+
+    std::mutex                cacheMutex;       // Held for the whole parse; guards meshCache and binaryMeshes
+    MeshCache                 meshCache;
+    std::deque<ModelMeshData> binaryMeshes;     // Loaded from .dmesh entries (deque: stable addresses)
+
+    std::mutex                    mutex;
+    std::vector<sModelLoadResult> completions;
+};
+
+//----------------------------------------------------------------------------------------------------
+static double GetElapsedMs(std::chrono::steady_clock::time_point const since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+static sModelLoadResult LoadModel(sModelLoadChannel& channel, String const& meshType)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    sModelLoadResult result;
+    result.meshType = meshType;
+
+    // meshType is "obj:<path>"; the binary cache is keyed by the path alone
+    String const sourcePath = meshType.substr(4);
+
+    ModelMeshData binaryMesh;
+    if (channel.binaryCache.TryLoad(sourcePath, binaryMesh, result.localBoundRadius))
+    {
+        std::lock_guard lock(channel.cacheMutex);
+        channel.binaryMeshes.push_back(std::move(binaryMesh));
+        result.model             = &channel.binaryMeshes.back();
+        result.isFromBinaryCache = true;
+        result.loadMs            = GetElapsedMs(start);
+        return result;
+    }
+
+    {
+        std::lock_guard lock(channel.cacheMutex);
+        result.model = channel.meshCache.GetOrCreateModel(meshType);
+    }
+
+    if (result.model && result.model->vertices.empty())
+    {
+        result.model = nullptr;
+    }
+
+    if (result.model)
+    {
+        result.localBoundRadius = ComputeModelBoundRadius(*result.model);
+        result.loadMs           = GetElapsedMs(start);
+
+        // Written outside the lock: the parsed model is immutable and its address stable
+        result.binaryBytesWritten = channel.binaryCache.Write(sourcePath, *result.model, result.localBoundRadius);
+        return result;
+    }
+
+    result.loadMs = GetElapsedMs(start);
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ModelLoadJob
+//
+// Deleted by App::ReclaimCompletedJobs() once ReleaseJob() recognises it.
+//----------------------------------------------------------------------------------------------------
+class ModelLoadJob : public Job
+{
+public:
+    ModelLoadJob(String meshType, std::shared_ptr<sModelLoadChannel> channel)
+        : m_meshType(std::move(meshType)),
+          m_channel(std::move(channel))
+    {
+    }
+
+    void Execute() override
+    {
+        sModelLoadResult result = LoadModel(*m_channel, m_meshType);
+
+        std::lock_guard lock(m_channel->mutex);
+        m_channel->completions.push_back(std::move(result));
+    }
+
+private:
+    String                             m_meshType;
+    std::shared_ptr<sModelLoadChannel> m_channel;
+};
+
+//----------------------------------------------------------------------------------------------------
+AsyncModelLoader::AsyncModelLoader(String const& binaryCacheDirectory)
+    : m_channel(std::make_shared<sModelLoadChannel>(binaryCacheDirectory))
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+AsyncModelLoader::~AsyncModelLoader()
+{
+    if (!m_isShutdown)
+    {
+        Shutdown();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AsyncModelLoader::Request(String const& meshType, CompletionFunction onLoaded)
+{
+    ++m_stats.requests;
+
+    auto const resident = m_resident.find(meshType);
+    if (resident != m_resident.end())
+    {
+        ++m_stats.residentHits;
+        onLoaded(resident->second);
+        return;
+    }
+
+    if (m_isShutdown)
+    {
+        sModelLoadResult failed;
+        failed.meshType = meshType;
+        onLoaded(failed);
+        return;
+    }
+
+    auto const pending = m_pending.find(meshType);
+    if (pending != m_pending.end())
+    {
+        ++m_stats.dedupHits;
+        pending->second.waiters.push_back(std::move(onLoaded));
+        return;
+    }
+
+    sPendingLoad& load = m_pending[meshType];
+    load.requestTime   = std::chrono::steady_clock::now();
+    load.waiters.push_back(std::move(onLoaded));
+    m_queue.push_back(meshType);
+
+    StartNextLoad();
+}
+
+//----------------------------------------------------------------------------------------------------
+// LoadNow
+//
+// A load of the same path already queued or in flight is not cancelled: the worker finds the model
+// in the loader's MeshCache, and its waiters are served from the resident entry recorded here.
+//----------------------------------------------------------------------------------------------------
+sModelLoadResult const& AsyncModelLoader::LoadNow(String const& meshType)
+{
+    ++m_stats.requests;
+
+    auto const resident = m_resident.find(meshType);
+    if (resident != m_resident.end())
+    {
+        ++m_stats.residentHits;
+        return resident->second;
+    }
+
+    Deliver(LoadModel(*m_channel, meshType));
+    return m_resident.at(meshType);
+}
+
+//----------------------------------------------------------------------------------------------------
+void AsyncModelLoader::StartNextLoad()
+{
+    while (!m_isLoadInFlight && !m_queue.empty())
+    {
+        String const meshType = std::move(m_queue.front());
+        m_queue.pop_front();
+
+        // Finished by LoadNow() while it waited
+        auto const resident = m_resident.find(meshType);
+        if (resident != m_resident.end())
+        {
+            Deliver(resident->second);
+            continue;
+        }
+
+        m_isLoadInFlight = true;
+        Job* const job   = new ModelLoadJob(meshType, m_channel);
+        m_submittedJobs.insert(job);
+        g_jobSystem->SubmitJob(job);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Deliver
+//
+// Records a result the first time a path finishes, then hands the resident entry to every waiter.
+//----------------------------------------------------------------------------------------------------
+void AsyncModelLoader::Deliver(sModelLoadResult const& result)
+{
+    auto [resident, isNew] = m_resident.emplace(result.meshType, result);
+    if (isNew)
+    {
+        if (result.model)
+        {
+            ++m_stats.loaded;
+            m_stats.binaryHits   += result.isFromBinaryCache ? 1u : 0u;
+            m_stats.binaryWrites += result.binaryBytesWritten > 0 ? 1u : 0u;
+            m_stats.lastLoadMs    = result.loadMs;
+            m_stats.maxLoadMs     = std::max(m_stats.maxLoadMs, result.loadMs);
+            m_stats.totalLoadMs  += result.loadMs;
+        }
+        else
+        {
+            ++m_stats.failed;
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                       Stringf("AsyncModelLoader: Failed to load '%s'", result.meshType.c_str()));
+        }
+    }
+
+    auto const pending = m_pending.find(result.meshType);
+    if (pending == m_pending.end())
+    {
+        return;
+    }
+
+    std::vector<CompletionFunction> const waiters = std::move(pending->second.waiters);
+    double const                          latency = GetElapsedMs(pending->second.requestTime);
+    m_pending.erase(pending);
+
+    m_stats.lastLatencyMs = latency;
+    m_stats.maxLatencyMs  = std::max(m_stats.maxLatencyMs, latency);
+
+    sModelLoadResult const delivered = resident->second;
+    for (CompletionFunction const& waiter : waiters)
+    {
+        waiter(delivered);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AsyncModelLoader::Update()
+{
+    std::vector<sModelLoadResult> completions;
+    {
+        std::lock_guard lock(m_channel->mutex);
+        completions.swap(m_channel->completions);
+    }
+
+    for (sModelLoadResult const& completion : completions)
+    {
+        m_isLoadInFlight = false;
+        Deliver(completion);
+    }
+
+    if (!m_isShutdown)
+    {
+        StartNextLoad();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AsyncModelLoader::Shutdown()
+{
+    m_isShutdown = true;
+
+    for (int wait = 0; wait < SHUTDOWN_WAIT_ITERATIONS && m_isLoadInFlight; ++wait)
+    {
+        Update();
+        if (m_isLoadInFlight)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SHUTDOWN_WAIT_MILLISECONDS));
+        }
+    }
+
+    if (m_isLoadInFlight)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning, "AsyncModelLoader: Shutdown timed out with a load in flight, its waiters are failed");
+    }
+
+    // Queued (and abandoned) loads fail without being recorded as resident
+    std::unordered_map<String, sPendingLoad> pending;
+    pending.swap(m_pending);
+    m_queue.clear();
+
+    for (auto const& [meshType, load] : pending)
+    {
+        sModelLoadResult failed;
+        failed.meshType = meshType;
+        for (CompletionFunction const& waiter : load.waiters)
+        {
+            waiter(failed);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sModelLoaderStats AsyncModelLoader::GetStats() const
+{
+    sModelLoaderStats stats = m_stats;
+    stats.queued            = static_cast<uint32_t>(m_queue.size());
+    stats.inFlight          = m_isLoadInFlight ? 1u : 0u;
+    stats.resident          = static_cast<uint32_t>(m_resident.size());
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+BinaryMeshCache const& AsyncModelLoader::GetBinaryCache() const
+{
+    return m_channel->binaryCache;
+}
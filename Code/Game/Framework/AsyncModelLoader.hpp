@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------------------------------
+// AsyncModelLoader.hpp
+// OBJ model loads on a JobSystem worker with per-path deduplication
+//
+// Purpose:
+//   load_model used to call MeshCache::GetOrCreateModel() inside its handler, and an entity whose
+//   model was not cached yet made RenderEntities() parse the OBJ mid-frame. ObjModelLoader takes
+//   hundreds of milliseconds on a large file, all of it on the main thread. The loader moves the parse
+//   onto a JobSystem worker; the main thread only learns about finished models in Update().
+//
+// Design:
+//   - Models are parsed into a MeshCache owned by the loader, not App's. App's MeshCache keeps serving
+//     primitives on the main thread without a lock, and the loader's cache is touched by one job at a
+//     time (plus LoadNow(), under the same mutex). Cached pointers stay valid while the loader lives
+//   - One load in flight, the rest queued FIFO: a parse is I/O plus one long CPU pass, and running
+//     several would only block more JobSystem workers behind the loader's cache mutex
+//   - Request() deduplicates by meshType: requests for a path that is queued or loading join its
+//     waiter list, requests for a finished path complete immediately. Failures are kept too, so a
+//     missing file is not re-parsed every frame
+//   - The local bounding radius is computed on the worker, so delivery does no per-vertex work
+//   - With a BinaryMeshCache directory, a current .dmesh entry replaces the OBJ parse (the mesh is
+//     then owned by the loader, not MeshCache); a parsed OBJ writes its entry from the same job
+//
+// Thread Safety Model:
+//   - Request(), LoadNow(), Update(), Shutdown(), GetStats(): main thread
+//   - ModelLoadJob runs on a JobSystem worker and publishes through a mutex-guarded channel that it
+//     shares with the loader, so a job that outlives Shutdown() never touches freed memory
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Resource/MeshCache.hpp"
+#include "Game/Framework/BinaryMeshCache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class Job;
+struct sModelLoadChannel;
+
+//----------------------------------------------------------------------------------------------------
+struct sModelLoadResult
+{
+    String               meshType;
+    ModelMeshData const* model              = nullptr;     // nullptr = load failed
+    float                localBoundRadius   = 0.f;         // Max vertex distance from the origin
+    double               loadMs             = 0.0;         // Parse (or .dmesh read) time on the worker
+    bool                 isFromBinaryCache  = false;
+    uint64_t             binaryBytesWritten = 0;           // .dmesh entry written after an OBJ parse
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sModelLoaderStats
+{
+    uint64_t requests      = 0;
+    uint64_t dedupHits     = 0;      // Joined a load already queued or in flight
+    uint64_t residentHits  = 0;      // Served by an earlier load
+    uint64_t loaded        = 0;
+    uint64_t failed        = 0;
+    uint64_t binaryHits    = 0;      // Loaded from a .dmesh entry instead of parsing the OBJ
+    uint64_t binaryWrites  = 0;
+    uint32_t queued        = 0;
+    uint32_t inFlight      = 0;
+    uint32_t resident      = 0;
+    double   lastLoadMs    = 0.0;
+    double   maxLoadMs     = 0.0;
+    double   totalLoadMs   = 0.0;
+    double   lastLatencyMs = 0.0;    // First request to delivery, including queue wait
+    double   maxLatencyMs  = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class AsyncModelLoader
+{
+public:
+    using CompletionFunction = std::function<void(sModelLoadResult const& result)>;
+
+    // binaryCacheDirectory: .dmesh entries (empty = always parse the OBJ)
+    explicit AsyncModelLoader(String const& binaryCacheDirectory);
+    ~AsyncModelLoader();
+
+    AsyncModelLoader(AsyncModelLoader const&)            = delete;
+    AsyncModelLoader& operator=(AsyncModelLoader const&) = delete;
+
+    // onLoaded runs on the main thread: from Update() once the worker finishes, or before Request()
+    // returns if meshType already finished loading
+    void Request(String const& meshType, CompletionFunction onLoaded);
+
+    // Parse on the calling thread (dispatcher bypassed); shares residency with Request()
+    sModelLoadResult const& LoadNow(String const& meshType);
+
+    // Deliver finished loads to their waiters and start the next queued one
+    void Update();
+
+    // Wait for the load in flight, then fail every queued request
+    void Shutdown();
+
+    sModelLoaderStats      GetStats() const;
+    BinaryMeshCache const& GetBinaryCache() const;
+
+    // Jobs this loader submitted that App::ReclaimCompletedJobs() has not deleted yet (see
+    // GenericCommandDispatcher::ReleaseJob)
+    bool HasSubmittedJobs() const { return !m_submittedJobs.empty(); }
+    bool ReleaseJob(Job const* job) { return m_submittedJobs.erase(job) > 0; }
+
+private:
+    struct sPendingLoad
+    {
+        std::vector<CompletionFunction>       waiters;
+        std::chrono::steady_clock::time_point requestTime;
+    };
+
+    void StartNextLoad();
+    void Deliver(sModelLoadResult const& result);
+
+    std::shared_ptr<sModelLoadChannel>           m_channel;
+    std::unordered_map<String, sModelLoadResult> m_resident;     // Finished loads, failed ones included
+    std::unordered_map<String, sPendingLoad>     m_pending;      // Queued or in flight
+    std::deque<String>                           m_queue;
+    bool                                         m_isLoadInFlight = false;
+    bool                                         m_isShutdown     = false;
+    std::unordered_set<Job const*>               m_submittedJobs;
+    sModelLoaderStats                            m_stats;
+};
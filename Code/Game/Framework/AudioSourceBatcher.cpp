@@ -0,0 +1,246 @@
+//----------------------------------------------------------------------------------------------------
+// AudioSourceBatcher.cpp
+// Per-frame batch of 3D audio source / listener updates, with sources that follow entities
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/AudioSourceBatcher.hpp"
+
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Game/Framework/EntityStore.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+AudioSourceBatcher::sSource& AudioSourceBatcher::GetSource(SoundID const soundId)
+{
+    sSource& source = m_sources[soundId];
+    if (!source.isInStagedOrder)
+    {
+        source.isInStagedOrder = true;
+        m_stagedOrder.push_back(soundId);
+    }
+    return source;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AudioSourceBatcher::StagePosition(SoundID const soundId, Vec3 const& position)
+{
+    sSource& source         = GetSource(soundId);
+    source.stagedPosition   = position;
+    source.isPositionStaged = true;
+    ++m_stats.totalStaged;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AudioSourceBatcher::StageVolume(SoundID const soundId, float const volume)
+{
+    sSource& source       = GetSource(soundId);
+    source.stagedVolume   = volume;
+    source.isVolumeStaged = true;
+    ++m_stats.totalStaged;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AudioSourceBatcher::Attach(SoundID const soundId, EntityID const entityId, Vec3 const& offset)
+{
+    sSource&   source      = m_sources[soundId];
+    bool const wasAttached = source.attachedEntity != 0;
+
+    source.attachedEntity = entityId;
+    source.attachOffset   = offset;
+
+    if (entityId != 0 && !wasAttached)
+    {
+        m_attached.push_back(soundId);
+    }
+    else if (entityId == 0 && wasAttached)
+    {
+        m_attached.erase(std::remove(m_attached.begin(), m_attached.end(), soundId), m_attached.end());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AudioSourceBatcher::StageListener(sAudioListenerState const& listener)
+{
+    m_stagedListener   = listener;
+    m_isListenerStaged = true;
+    m_listenerEntity   = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AudioSourceBatcher::AttachListener(EntityID const entityId)
+{
+    m_listenerEntity = entityId;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AudioSourceBatcher::Forget(SoundID const soundId)
+{
+    auto const it = m_sources.find(soundId);
+    if (it == m_sources.end())
+    {
+        return;
+    }
+
+    if (it->second.attachedEntity != 0)
+    {
+        m_attached.erase(std::remove(m_attached.begin(), m_attached.end(), soundId), m_attached.end());
+    }
+    if (it->second.isInStagedOrder)
+    {
+        m_stagedOrder.erase(std::remove(m_stagedOrder.begin(), m_stagedOrder.end(), soundId), m_stagedOrder.end());
+    }
+    m_sources.erase(it);
+    ++m_stats.forgottenSources;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ResolveEntity
+//
+// False if the entity has no front-buffer state this frame. outSlot is INVALID_SLOT only when the
+// entity no longer exists (created-but-not-yet-swapped entities simply wait a frame).
+//----------------------------------------------------------------------------------------------------
+bool AudioSourceBatcher::ResolveEntity(EntityStore const* entities, EntityID const entityId, uint32_t& outSlot) const
+{
+    outSlot = entities ? entities->FindSlot(entityId) : EntityStore::INVALID_SLOT;
+    if (outSlot == EntityStore::INVALID_SLOT)
+    {
+        return false;
+    }
+
+    sEntityArrays const& front = entities->GetFront();
+    return outSlot < front.GetSlotCount() && front.ids[outSlot] == entityId && front.activeFlags[outSlot] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Collect
+//
+// Attached sources are staged from their entities first, so an explicit position staged for an
+// attached source this frame is overwritten. A source whose entity was destroyed is dropped unless
+// it was also staged explicitly this frame.
+//----------------------------------------------------------------------------------------------------
+std::vector<sAudioSourceChange> const& AudioSourceBatcher::Collect(EntityStore const* entities)
+{
+    m_changes.clear();
+    m_isListenerChanged        = false;
+    m_stats.lastFrameChanges   = 0;
+    m_stats.lastFrameUnchanged = 0;
+
+    for (size_t i = 0; i < m_attached.size();)
+    {
+        SoundID const soundId = m_attached[i];
+        sSource&      source  = m_sources[soundId];
+
+        uint32_t slot = EntityStore::INVALID_SLOT;
+        if (ResolveEntity(entities, source.attachedEntity, slot))
+        {
+            sSource& staged         = GetSource(soundId);
+            staged.stagedPosition   = entities->GetFront().positions[slot] + source.attachOffset;
+            staged.isPositionStaged = true;
+        }
+        else if (slot == EntityStore::INVALID_SLOT)
+        {
+            // The sound rode a destroyed entity; keep the entry only if it was staged explicitly
+            if (!source.isInStagedOrder)
+            {
+                m_sources.erase(soundId);
+            }
+            else
+            {
+                source.attachedEntity = 0;
+            }
+            m_attached[i] = m_attached.back();
+            m_attached.pop_back();
+            ++m_stats.entityDetaches;
+            continue;
+        }
+        ++i;
+    }
+
+    for (SoundID const soundId : m_stagedOrder)
+    {
+        sSource& source        = m_sources[soundId];
+        source.isInStagedOrder = false;
+
+        sAudioSourceChange change;
+        change.soundId = soundId;
+
+        if (source.isPositionStaged && (!source.hasAppliedPosition || !(source.appliedPosition == source.stagedPosition)))
+        {
+            change.position           = source.stagedPosition;
+            change.hasPosition        = true;
+            source.appliedPosition    = source.stagedPosition;
+            source.hasAppliedPosition = true;
+        }
+        if (source.isVolumeStaged && (!source.hasAppliedVolume || source.appliedVolume != source.stagedVolume))
+        {
+            change.volume           = source.stagedVolume;
+            change.hasVolume        = true;
+            source.appliedVolume    = source.stagedVolume;
+            source.hasAppliedVolume = true;
+        }
+        source.isPositionStaged = false;
+        source.isVolumeStaged   = false;
+
+        if (change.hasPosition || change.hasVolume)
+        {
+            m_changes.push_back(change);
+            ++m_stats.lastFrameChanges;
+        }
+        else
+        {
+            ++m_stats.lastFrameUnchanged;
+        }
+    }
+    m_stagedOrder.clear();
+
+    m_stats.totalChanges += m_stats.lastFrameChanges;
+    m_stats.totalUnchanged += m_stats.lastFrameUnchanged;
+
+    if (m_listenerEntity != 0)
+    {
+        uint32_t slot = EntityStore::INVALID_SLOT;
+        if (ResolveEntity(entities, m_listenerEntity, slot))
+        {
+            sEntityArrays const& front = entities->GetFront();
+            Mat44 const          basis = front.orientations[slot].GetAsMatrix_IFwd_JLeft_KUp();
+
+            m_stagedListener.position = front.positions[slot];
+            m_stagedListener.forward  = basis.GetIBasis3D();
+            m_stagedListener.up       = basis.GetKBasis3D();
+            m_isListenerStaged        = true;
+        }
+        else if (slot == EntityStore::INVALID_SLOT)
+        {
+            m_listenerEntity = 0;
+            ++m_stats.entityDetaches;
+        }
+    }
+
+    if (m_isListenerStaged)
+    {
+        m_isListenerStaged = false;
+
+        bool const isSame = m_hasListener && m_listener.position == m_stagedListener.position &&
+                            m_listener.forward == m_stagedListener.forward && m_listener.up == m_stagedListener.up;
+        if (!isSame)
+        {
+            m_listener          = m_stagedListener;
+            m_hasListener       = true;
+            m_isListenerChanged = true;
+            ++m_stats.listenerUpdates;
+        }
+    }
+    return m_changes;
+}
+
+//----------------------------------------------------------------------------------------------------
+sAudioSourceBatchStats AudioSourceBatcher::GetStats() const
+{
+    sAudioSourceBatchStats stats = m_stats;
+    stats.trackedSources         = static_cast<uint32_t>(m_sources.size());
+    stats.attachedSources        = static_cast<uint32_t>(m_attached.size());
+    stats.isListenerAttached     = m_listenerEntity != 0;
+    return stats;
+}
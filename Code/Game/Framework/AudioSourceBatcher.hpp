@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------------------------------
+// AudioSourceBatcher.hpp
+// Per-frame batch of 3D audio source / listener updates, with sources that follow entities
+//
+// Purpose:
+//   Moving 3D sounds used to send one update_3d_position command per sound per frame, each calling
+//   AudioSystem immediately - a sound moved twice in a frame went to FMOD twice, and a sound riding
+//   an entity cost JS traffic every frame even though the entity position was already in the
+//   EntityStore. audio.update_sources stages any number of sources (and the listener) in one
+//   command; sources may instead be attached to an entity and follow its front-buffer position.
+//   App::ApplyAudioSourceBatch() collects the frame's net changes once, right before
+//   AudioSystem::EndFrame() runs the FMOD update.
+//
+// Design:
+//   - Staging keeps the last value per sound (last write wins within a frame)
+//   - Collect() emits a change only when the value differs from what was last applied, so
+//     stationary attached sources and repeated identical updates never reach FMOD
+//   - Attachment wins over staged positions for the same sound; an attached source whose entity no
+//     longer exists is detached (counted in entityDetaches) and, unless staged this frame, dropped
+//   - Forget() drops a sound whose playback ended (stop_sound), so trackedSources stays bounded by
+//     the sounds actually in use
+//   - The listener is either set explicitly or attached to an entity (position + orientation basis)
+//   - Engine-free apart from plain types: App performs the AudioSystem calls for the collected
+//     changes and mirrors them into the AudioStateBuffer
+//
+// Thread Safety Model:
+//   - Main thread only (GenericCommand handlers, TypedCommandBuffer::Drain() and App::EndFrame())
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Entity/EntityStateBuffer.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class EntityStore;
+
+//----------------------------------------------------------------------------------------------------
+struct sAudioSourceChange
+{
+    SoundID soundId     = 0;
+    Vec3    position;
+    float   volume      = 1.f;
+    bool    hasPosition = false;
+    bool    hasVolume   = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sAudioListenerState
+{
+    Vec3 position;
+    Vec3 forward = Vec3(1.f, 0.f, 0.f);
+    Vec3 up      = Vec3(0.f, 0.f, 1.f);
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sAudioSourceBatchStats
+{
+    uint32_t trackedSources     = 0;     // Sounds staged or attached and not yet forgotten
+    uint32_t attachedSources    = 0;
+    bool     isListenerAttached = false;
+    uint32_t lastFrameChanges   = 0;     // Sounds changed by the last Collect()
+    uint32_t lastFrameUnchanged = 0;     // Staged or attached sounds skipped (same as last applied)
+    uint64_t totalStaged        = 0;     // StagePosition() / StageVolume() calls
+    uint64_t totalChanges       = 0;
+    uint64_t totalUnchanged     = 0;
+    uint64_t listenerUpdates    = 0;
+    uint64_t entityDetaches     = 0;     // Attachments dropped because the entity was destroyed
+    uint64_t forgottenSources   = 0;     // Forget() calls that dropped a tracked sound
+};
+
+//----------------------------------------------------------------------------------------------------
+class AudioSourceBatcher
+{
+public:
+    AudioSourceBatcher() = default;
+
+    AudioSourceBatcher(AudioSourceBatcher const&)            = delete;
+    AudioSourceBatcher& operator=(AudioSourceBatcher const&) = delete;
+
+    void StagePosition(SoundID soundId, Vec3 const& position);
+    void StageVolume(SoundID soundId, float volume);
+
+    // entityId 0 detaches; the source keeps its last applied position
+    void Attach(SoundID soundId, EntityID entityId, Vec3 const& offset);
+    void StageListener(sAudioListenerState const& listener);     // Also detaches the listener
+    void AttachListener(EntityID entityId);                      // 0 = detach
+
+    // Drop all state for a sound whose playback ended (staged values, attachment, last applied values)
+    void Forget(SoundID soundId);
+
+    // Net changes since the last call, in staging order (valid until the next call)
+    std::vector<sAudioSourceChange> const& Collect(EntityStore const* entities);
+
+    // True if the last Collect() changed the listener
+    bool                       IsListenerChanged() const { return m_isListenerChanged; }
+    sAudioListenerState const& GetListener() const { return m_listener; }
+
+    sAudioSourceBatchStats GetStats() const;
+
+private:
+    struct sSource
+    {
+        Vec3     appliedPosition;
+        float    appliedVolume      = 1.f;
+        bool     hasAppliedPosition = false;
+        bool     hasAppliedVolume   = false;
+        Vec3     stagedPosition;
+        float    stagedVolume       = 1.f;
+        bool     isPositionStaged   = false;
+        bool     isVolumeStaged     = false;
+        bool     isInStagedOrder    = false;
+        EntityID attachedEntity     = 0;
+        Vec3     attachOffset;
+    };
+
+    sSource& GetSource(SoundID soundId);
+    bool     ResolveEntity(EntityStore const* entities, EntityID entityId, uint32_t& outSlot) const;
+
+    std::unordered_map<SoundID, sSource> m_sources;
+    std::vector<SoundID>                 m_stagedOrder;     // Sounds staged this frame
+    std::vector<SoundID>                 m_attached;        // Sounds with attachedEntity != 0
+    std::vector<sAudioSourceChange>      m_changes;         // Collect() result (keeps capacity)
+
+    sAudioListenerState m_listener;
+    sAudioListenerState m_stagedListener;
+    bool                m_isListenerStaged  = false;
+    bool                m_isListenerChanged = false;
+    bool                m_hasListener       = false;     // m_listener was applied at least once
+    EntityID            m_listenerEntity    = 0;
+
+    sAudioSourceBatchStats m_stats;
+};
@@ -0,0 +1,538 @@
+//----------------------------------------------------------------------------------------------------
+// BenchmarkRunner.cpp
+// Scripted benchmark scenes driven through the GenericCommand pipeline (-benchmark)
+//----------------------------------------------------------------------------------------------------
+
+// Prevent Windows.h min/max macros from conflicting with the standard library
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "Game/Framework/BenchmarkRunner.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#include <Psapi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+//----------------------------------------------------------------------------------------------------
+static char const* const BENCHMARK_AGENT_ID = "benchmark";
+
+// Spawn grid: GRID_SIDE x GRID_SIDE entities per layer, GRID_SPACING apart
+static uint32_t constexpr GRID_SIDE    = 32;
+static float constexpr    GRID_SPACING = 2.f;
+
+//----------------------------------------------------------------------------------------------------
+static bool IsSupportedCommand(String const& type)
+{
+    return type == "entity.update_position" || type == "entity.update_orientation" || type == "entity.update_color" ||
+           type == "camera.update" || type == "debug_render.add_world_point" || type == "debug_render.add_world_line";
+}
+
+//----------------------------------------------------------------------------------------------------
+static void GetGridPosition(uint32_t const index, float& outX, float& outY, float& outZ)
+{
+    outX = static_cast<float>(index % GRID_SIDE) * GRID_SPACING;
+    outY = static_cast<float>((index / GRID_SIDE) % GRID_SIDE) * GRID_SPACING;
+    outZ = static_cast<float>(index / (GRID_SIDE * GRID_SIDE)) * GRID_SPACING;
+}
+
+//----------------------------------------------------------------------------------------------------
+static double GetElapsedMs(std::chrono::steady_clock::time_point const since, std::chrono::steady_clock::time_point const now)
+{
+    return std::chrono::duration<double, std::milli>(now - since).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+// {"count":n,"avg":..,"p50":..,"p95":..,"p99":..,"max":..} (nearest-rank percentiles)
+//----------------------------------------------------------------------------------------------------
+static void WriteDistribution(std::ostream& out, std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    auto const percentile = [&samples](double const p) -> double
+    {
+        if (samples.empty()) return 0.0;
+        size_t const rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    };
+
+    double total = 0.0;
+    for (double const sample : samples)
+    {
+        total += sample;
+    }
+
+    out << R"({"count":)" << samples.size()
+        << R"(,"avg":)" << (samples.empty() ? 0.0 : total / static_cast<double>(samples.size()))
+        << R"(,"p50":)" << percentile(0.50)
+        << R"(,"p95":)" << percentile(0.95)
+        << R"(,"p99":)" << percentile(0.99)
+        << R"(,"max":)" << (samples.empty() ? 0.0 : samples.back())
+        << "}";
+}
+
+//----------------------------------------------------------------------------------------------------
+static String EscapeJson(String const& text)
+{
+    String escaped;
+    escaped.reserve(text.size());
+    for (char const c : text)
+    {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+    }
+    return escaped;
+}
+
+//----------------------------------------------------------------------------------------------------
+BenchmarkRunner::BenchmarkRunner(sBenchmarkConfig config, SubmitFunction submit, ListFunction listEntities, ListFunction listCameras)
+    : m_config(std::move(config)),
+      m_submit(std::move(submit)),
+      m_listEntities(std::move(listEntities)),
+      m_listCameras(std::move(listCameras))
+{
+    m_config.frameRate = (m_config.frameRate > 0.f) ? m_config.frameRate : 60.f;
+
+    for (sBenchmarkScene& scene : m_config.scenes)
+    {
+        auto const unsupported = std::remove_if(scene.commandRates.begin(), scene.commandRates.end(),
+                                                [&scene](sBenchmarkCommandRate const& rate)
+                                                {
+                                                    if (IsSupportedCommand(rate.type)) return false;
+                                                    DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                                                               Stringf("BenchmarkRunner: scene '%s' ignores unsupported command '%s'",
+                                                                   scene.name.c_str(), rate.type.c_str()));
+                                                    return true;
+                                                });
+        scene.commandRates.erase(unsupported, scene.commandRates.end());
+    }
+
+    std::time_t const now       = std::time(nullptr);
+    std::tm           localTime = {};
+    localtime_s(&localTime, &now);
+
+    std::ostringstream name;
+    name << "benchmark_" << std::put_time(&localTime, "%Y-%m-%d_%H%M%S") << ".json";
+
+    std::error_code ec;
+    fs::create_directories(m_config.outputDirectory, ec);
+    m_resultsPath = (fs::path(m_config.outputDirectory) / name.str()).string();
+
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("BenchmarkRunner: %zu scenes, results -> %s", m_config.scenes.size(), m_resultsPath.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::Submit(String const& type, String const& payload)
+{
+    m_submit(GenericCommand(type, std::any(payload), BENCHMARK_AGENT_ID, 0, std::any()));
+}
+
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::Update()
+{
+    if (m_isFinished || m_sceneIndex >= m_config.scenes.size())
+    {
+        return;
+    }
+
+    sBenchmarkScene const& scene = m_config.scenes[m_sceneIndex];
+    switch (m_phase)
+    {
+    case ePhase::SPAWN:
+        SpawnScene(scene);
+        break;
+
+    case ePhase::WARMUP:
+    case ePhase::MEASURE:
+        IssueCommands(scene);
+        break;
+
+    case ePhase::TEARDOWN:
+        for (uint64_t const entityId : m_entityIds)
+        {
+            Submit("entity.destroy", Stringf(R"({"entityId":%llu})", entityId));
+        }
+        for (uint64_t const cameraId : m_cameraIds)
+        {
+            Submit("destroy_camera", Stringf(R"({"cameraId":%llu})", cameraId));
+        }
+        m_entityIds.clear();
+        m_cameraIds.clear();
+        break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// SpawnScene
+//
+// The spawn commands run inline on the main thread (load_model spawns its placeholder entity before
+// the OBJ loads), so the ids that appear between the two listings belong to this scene.
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::SpawnScene(sBenchmarkScene const& scene)
+{
+    std::vector<uint64_t> before;
+    std::vector<uint64_t> after;
+
+    m_listEntities(before);
+    for (uint32_t i = 0; i < scene.primitiveCount; ++i)
+    {
+        float x, y, z;
+        GetGridPosition(i, x, y, z);
+        Submit("create_mesh", Stringf(R"({"meshType":"%s","position":[%.2f,%.2f,%.2f],"scale":0.5,"color":[%u,%u,200,255]})",
+                                      EscapeJson(scene.primitiveMesh).c_str(), x, y, z, (i * 37u) % 256u, (i * 91u) % 256u));
+    }
+    for (uint32_t i = 0; i < scene.modelCount && !scene.modelPaths.empty(); ++i)
+    {
+        float x, y, z;
+        GetGridPosition(scene.primitiveCount + i, x, y, z);
+        Submit("load_model", Stringf(R"({"path":"%s","position":[%.2f,%.2f,%.2f],"scale":1.0})",
+                                     EscapeJson(scene.modelPaths[i % scene.modelPaths.size()]).c_str(), x, y, z));
+    }
+    m_listEntities(after);
+
+    std::sort(before.begin(), before.end());
+    std::sort(after.begin(), after.end());
+    m_entityIds.clear();
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(m_entityIds));
+
+    bool const isCameraDriven = std::any_of(scene.commandRates.begin(), scene.commandRates.end(),
+                                            [](sBenchmarkCommandRate const& rate) { return rate.type == "camera.update"; });
+    if (isCameraDriven)
+    {
+        before.clear();
+        after.clear();
+
+        m_listCameras(before);
+        Submit("create_camera", R"({"position":[-20,32,24],"orientation":[0,30,0],"type":"world"})");
+        m_listCameras(after);
+
+        std::sort(before.begin(), before.end());
+        std::sort(after.begin(), after.end());
+        m_cameraIds.clear();
+        std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(m_cameraIds));
+
+        if (!m_cameraIds.empty())
+        {
+            Submit("set_active_camera", Stringf(R"({"cameraId":%llu})", m_cameraIds.front()));
+        }
+    }
+
+    m_rateAccumulators.assign(scene.commandRates.size(), 0.f);
+    m_rateCursors.assign(scene.commandRates.size(), 0u);
+    m_sceneFrame = 0;
+
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("BenchmarkRunner: scene '%s' spawned %zu entities (%u requested), %zu cameras",
+                   scene.name.c_str(), m_entityIds.size(), scene.primitiveCount + scene.modelCount, m_cameraIds.size()));
+}
+
+//----------------------------------------------------------------------------------------------------
+// IssueCommands
+//
+// Payloads depend only on the scene frame and the target's index, so every run replays the same
+// command stream. Their cost is timed here, around the submit calls.
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::IssueCommands(sBenchmarkScene const& scene)
+{
+    auto const  start    = std::chrono::steady_clock::now();
+    float const time     = static_cast<float>(m_sceneFrame) / m_config.frameRate;
+    size_t      commands = 0;
+
+    for (size_t rateIndex = 0; rateIndex < scene.commandRates.size(); ++rateIndex)
+    {
+        sBenchmarkCommandRate const& rate = scene.commandRates[rateIndex];
+
+        m_rateAccumulators[rateIndex] += rate.perSecond / m_config.frameRate;
+        uint32_t const count = static_cast<uint32_t>(m_rateAccumulators[rateIndex]);
+        m_rateAccumulators[rateIndex] -= static_cast<float>(count);
+
+        for (uint32_t n = 0; n < count; ++n)
+        {
+            uint32_t const cursor = m_rateCursors[rateIndex]++;
+            float const    phase  = time + static_cast<float>(cursor % 64u) * 0.1f;
+
+            if (rate.type == "camera.update")
+            {
+                if (m_cameraIds.empty()) break;
+                Submit(rate.type, Stringf(R"({"cameraId":%llu,"posX":%.3f,"posY":%.3f,"posZ":24,"yaw":%.3f,"pitch":30,"roll":0})",
+                                          m_cameraIds.front(), 32.f + 48.f * std::cos(time), 32.f + 48.f * std::sin(time),
+                                          time * 57.2958f + 180.f));
+            }
+            else if (rate.type == "debug_render.add_world_point")
+            {
+                Submit(rate.type, Stringf(R"({"x":%.3f,"y":%.3f,"z":%.3f,"radius":0.1,"duration":0})",
+                                          static_cast<float>(cursor % 64u), 8.f * std::sin(phase), 4.f));
+            }
+            else if (rate.type == "debug_render.add_world_line")
+            {
+                Submit(rate.type, Stringf(R"({"x1":%.3f,"y1":0,"z1":0,"x2":%.3f,"y2":%.3f,"z2":4,"radius":0.02,"duration":0})",
+                                          static_cast<float>(cursor % 64u), static_cast<float>(cursor % 64u), 8.f * std::cos(phase)));
+            }
+            else if (!m_entityIds.empty())
+            {
+                uint32_t const index    = cursor % static_cast<uint32_t>(m_entityIds.size());
+                uint64_t const entityId = m_entityIds[index];
+
+                if (rate.type == "entity.update_position")
+                {
+                    float x, y, z;
+                    GetGridPosition(index, x, y, z);
+                    Submit(rate.type, Stringf(R"({"entityId":%llu,"x":%.3f,"y":%.3f,"z":%.3f})", entityId, x, y, z + std::sin(phase)));
+                }
+                else if (rate.type == "entity.update_orientation")
+                {
+                    Submit(rate.type, Stringf(R"({"entityId":%llu,"yaw":%.3f,"pitch":0,"roll":0})", entityId, std::fmod(phase * 90.f, 360.f)));
+                }
+                else
+                {
+                    Submit(rate.type, Stringf(R"({"entityId":%llu,"r":%u,"g":%u,"b":200,"a":255})",
+                                              entityId, (cursor * 37u) % 256u, static_cast<uint32_t>((m_sceneFrame * 3u) % 256u)));
+                }
+            }
+            ++commands;
+        }
+    }
+
+    m_frameCommands  = static_cast<uint32_t>(commands);
+    m_frameCommandMs = GetElapsedMs(start, std::chrono::steady_clock::now());
+}
+
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::EndFrame(sBenchmarkFrameCounters const& counters)
+{
+    if (m_isFinished)
+    {
+        return;
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+
+    if (m_phase == ePhase::MEASURE && !m_results.empty())
+    {
+        sSceneResult& result = m_results.back();
+        result.mainFrameMs.push_back(GetElapsedMs(m_lastFrameEnd, now));
+        if (counters.workerFrames != m_lastWorkerFrames)
+        {
+            result.workerFrameMs.push_back(counters.workerFrameMs);
+        }
+        if (counters.swapCount != m_lastSwapCount)
+        {
+            result.swapMs.push_back(counters.swapMs);
+        }
+        if (m_frameCommands > 0)
+        {
+            result.commandUs.push_back(m_frameCommandMs * 1000.0 / static_cast<double>(m_frameCommands));
+        }
+        result.commands += m_frameCommands;
+        ++result.frames;
+    }
+
+    m_lastFrameEnd     = now;
+    m_lastWorkerFrames = counters.workerFrames;
+    m_lastSwapCount    = counters.swapCount;
+    m_frameCommands    = 0;
+    m_frameCommandMs   = 0.0;
+    ++m_sceneFrame;
+
+    if (m_sceneIndex >= m_config.scenes.size())
+    {
+        WriteResults(true);
+        return;
+    }
+
+    sBenchmarkScene const& scene = m_config.scenes[m_sceneIndex];
+    switch (m_phase)
+    {
+    case ePhase::SPAWN:
+        m_phase      = ePhase::WARMUP;
+        m_phaseFrame = 0;
+        break;
+
+    case ePhase::WARMUP:
+        if (++m_phaseFrame < scene.warmupFrames)
+        {
+            break;
+        }
+
+        m_results.emplace_back();
+        m_results.back().name     = scene.name;
+        m_results.back().entities = static_cast<uint32_t>(m_entityIds.size());
+        m_results.back().cameras  = static_cast<uint32_t>(m_cameraIds.size());
+        m_measureStart            = now;
+        m_phase                   = ePhase::MEASURE;
+        m_phaseFrame              = 0;
+
+        if (m_config.isProfiled)
+        {
+            m_isProfilerWasOn = FrameProfiler::IsEnabled();
+            FrameProfiler::SetEnabled(true);
+            FrameProfiler::Reset();
+            m_profileFirstFrame = FrameProfiler::GetFrameNumber();
+        }
+        break;
+
+    case ePhase::MEASURE:
+        if (++m_phaseFrame < std::max(scene.measureFrames, 1u))
+        {
+            break;
+        }
+
+        m_results.back().measureSeconds = GetElapsedMs(m_measureStart, now) / 1000.0;
+        FinishScene();
+        m_phase = ePhase::TEARDOWN;
+        break;
+
+    case ePhase::TEARDOWN:
+        ++m_sceneIndex;
+        m_phase = ePhase::SPAWN;
+        if (m_sceneIndex >= m_config.scenes.size())
+        {
+            WriteResults(true);
+        }
+        break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// FinishScene
+//
+// Memory is sampled while the scene is still alive; the profiler session (if any) ends here.
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::FinishScene()
+{
+    sSceneResult& result = m_results.back();
+
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    {
+        result.workingSetMB     = static_cast<double>(pmc.WorkingSetSize) / (1024.0 * 1024.0);
+        result.peakWorkingSetMB = static_cast<double>(pmc.PeakWorkingSetSize) / (1024.0 * 1024.0);
+    }
+
+    if (!m_config.isProfiled)
+    {
+        return;
+    }
+
+    std::ostringstream profile;
+    profile << std::fixed << std::setprecision(3) << "[";
+
+    std::vector<sProfileScopeStats> const scopes = FrameProfiler::GetScopeStats();
+    for (size_t i = 0; i < scopes.size(); ++i)
+    {
+        sProfileScopeStats const& scope = scopes[i];
+        profile << (i > 0 ? "," : "")
+                << R"({"name":")" << EscapeJson(scope.name)
+                << R"(","parent":)" << (scope.parent ? "\"" + EscapeJson(scope.parent) + "\"" : String("null"))
+                << R"(,"thread":")" << EscapeJson(scope.threadName)
+                << R"(","callsPerFrame":)" << scope.callsPerFrame
+                << R"(,"p50Ms":)" << scope.p50Ms
+                << R"(,"p95Ms":)" << scope.p95Ms
+                << R"(,"p99Ms":)" << scope.p99Ms
+                << R"(,"maxMs":)" << scope.maxMs << "}";
+    }
+    profile << "]";
+    result.profileJson = profile.str();
+
+    sProfileTrace trace;
+    uint64_t const lastFrame = FrameProfiler::GetFrameNumber();
+    if (lastFrame > 0 && FrameProfiler::SnapshotTrace(m_profileFirstFrame, lastFrame - 1, trace))
+    {
+        fs::path tracePath = fs::path(m_resultsPath);
+        tracePath.replace_extension();
+        String const traceFile = tracePath.string() + "_" + result.name + ".trace.json";
+        if (FrameProfiler::WriteChromeTrace(trace, traceFile) > 0)
+        {
+            result.traceFile = traceFile;
+        }
+    }
+
+    FrameProfiler::SetEnabled(m_isProfilerWasOn);
+}
+
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::Shutdown()
+{
+    if (!m_isFinished)
+    {
+        WriteResults(false);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void BenchmarkRunner::WriteResults(bool const isComplete)
+{
+    m_isFinished = true;
+
+    std::ofstream file(m_resultsPath, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Error,
+                   Stringf("BenchmarkRunner: could not write %s", m_resultsPath.c_str()));
+        return;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << R"({"formatVersion":1,"complete":)" << (isComplete ? "true" : "false")
+         << R"(,"frameRate":)" << m_config.frameRate
+         << R"(,"scenes":[)";
+
+    for (size_t i = 0; i < m_results.size(); ++i)
+    {
+        sSceneResult const& result = m_results[i];
+        double const        seconds = std::max(result.measureSeconds, 1.0e-9);
+
+        file << (i > 0 ? "," : "")
+             << R"({"name":")" << EscapeJson(result.name)
+             << R"(","entities":)" << result.entities
+             << R"(,"cameras":)" << result.cameras
+             << R"(,"frames":)" << result.frames
+             << R"(,"seconds":)" << result.measureSeconds
+             << R"(,"commands":)" << result.commands
+             << R"(,"commandsPerSecond":)" << static_cast<double>(result.commands) / seconds
+             << R"(,"mainFrameMs":)";
+        WriteDistribution(file, result.mainFrameMs);
+        file << R"(,"workerFrameMs":)";
+        WriteDistribution(file, result.workerFrameMs);
+        file << R"(,"swapMs":)";
+        WriteDistribution(file, result.swapMs);
+        file << R"(,"commandCostUs":)";
+        WriteDistribution(file, result.commandUs);
+        file << R"(,"workingSetMB":)" << result.workingSetMB
+             << R"(,"peakWorkingSetMB":)" << result.peakWorkingSetMB;
+        if (!result.profileJson.empty())
+        {
+            file << R"(,"profile":)" << result.profileJson;
+        }
+        if (!result.traceFile.empty())
+        {
+            file << R"(,"traceFile":")" << EscapeJson(result.traceFile) << R"(")";
+        }
+        file << "}";
+    }
+    file << "]}";
+    file.close();
+
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("BenchmarkRunner: %s results for %zu scenes written to %s",
+                   isComplete ? "complete" : "partial", m_results.size(), m_resultsPath.c_str()));
+}
@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------------------------------
+// BenchmarkRunner.hpp
+// Scripted benchmark scenes driven through the GenericCommand pipeline (-benchmark)
+//
+// Purpose:
+//   Nothing measured the command pipeline and renderer hot paths between Engine updates, so a
+//   regression only showed up as "feels slower". The runner plays a fixed list of scenes from
+//   Data/Config/Benchmark.json: each spawns N primitive and OBJ entities, issues commands at fixed
+//   per-frame rates, and records main/worker frame times, command cost, swap cost and memory. The
+//   results go to one JSON file per run for comparison across runs (and across perf CI boxes, where
+//   it runs headless like any other Headless.json configuration).
+//
+// Design:
+//   - Commands go through App's normal dispatch path (dispatcher, then executor), the same one JS
+//     and external producers use, so handler and dispatch costs are both included
+//   - Rates are commands per second of a nominal frameRate, not of wall time: every run issues the
+//     same commands on the same frame, whatever the machine's speed. Payloads are a deterministic
+//     function of frame and entity index
+//   - Spawned entity and camera ids are found by diffing the live ids before and after the spawn
+//     commands, which run in one call on the main thread
+//   - Phases per scene: spawn (one frame), warmup (warmupFrames, also covers async OBJ loads),
+//     measure (measureFrames), teardown (one frame: destroy everything the scene spawned)
+//   - Optional per-scene FrameProfiler session: its p50/p95/p99 scope table is embedded in the
+//     results, and a Chrome trace of the measured frames is written next to them
+//
+// Thread Safety Model:
+//   - Main thread only
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/GenericCommand.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sBenchmarkCommandRate
+{
+    String type;                  // entity.update_position / _orientation / _color, camera.update, debug_render.add_world_point / _line
+    float  perSecond = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sBenchmarkScene
+{
+    String                             name;
+    uint32_t                           primitiveCount = 1000;
+    String                             primitiveMesh  = "cube";
+    uint32_t                           modelCount     = 0;
+    std::vector<String>                modelPaths;                 // OBJ paths for load_model, used round-robin
+    uint32_t                           warmupFrames   = 120;
+    uint32_t                           measureFrames  = 600;
+    std::vector<sBenchmarkCommandRate> commandRates;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sBenchmarkConfig
+{
+    std::vector<sBenchmarkScene> scenes;
+    float                        frameRate       = 60.f;            // Nominal rate that turns perSecond into per-frame counts
+    String                       outputDirectory = "Benchmarks";
+    bool                         isProfiled      = false;           // FrameProfiler session per scene
+    bool                         isQuitWhenDone  = true;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counters App hands over once per frame; the runner samples whatever changed since the last frame
+//----------------------------------------------------------------------------------------------------
+struct sBenchmarkFrameCounters
+{
+    uint64_t workerFrames  = 0;       // JSGameLogicJob::GetTotalFrames()
+    double   workerFrameMs = 0.0;     // JSGameLogicJob::GetLastFrameMs()
+    uint64_t swapCount     = 0;       // Entity swaps
+    double   swapMs        = 0.0;     // Last entity swap
+};
+
+//----------------------------------------------------------------------------------------------------
+class BenchmarkRunner
+{
+public:
+    using SubmitFunction = std::function<void(GenericCommand const& command)>;
+    using ListFunction   = std::function<void(std::vector<uint64_t>& outIds)>;
+
+    // submit: App's dispatch path; listEntities / listCameras: live ids in the back buffers
+    BenchmarkRunner(sBenchmarkConfig config, SubmitFunction submit, ListFunction listEntities, ListFunction listCameras);
+
+    BenchmarkRunner(BenchmarkRunner const&)            = delete;
+    BenchmarkRunner& operator=(BenchmarkRunner const&) = delete;
+
+    // Before the frame's ProcessGenericCommands(): issue this frame's spawn / load / teardown commands
+    void Update();
+
+    // After the frame: sample timings, advance the phase, write results after the last scene
+    void EndFrame(sBenchmarkFrameCounters const& counters);
+
+    // Write partial results if the run is cut short
+    void Shutdown();
+
+    bool          IsFinished() const { return m_isFinished; }
+    bool          IsQuitWhenDone() const { return m_config.isQuitWhenDone; }
+    String const& GetResultsPath() const { return m_resultsPath; }
+
+private:
+    enum class ePhase : uint8_t
+    {
+        SPAWN,
+        WARMUP,
+        MEASURE,
+        TEARDOWN
+    };
+
+    struct sSceneResult
+    {
+        String              name;
+        uint32_t            entities       = 0;
+        uint32_t            cameras        = 0;
+        uint32_t            frames         = 0;
+        uint64_t            commands       = 0;
+        double              measureSeconds = 0.0;
+        std::vector<double> mainFrameMs;
+        std::vector<double> workerFrameMs;
+        std::vector<double> swapMs;
+        std::vector<double> commandUs;          // Per-frame average cost of one benchmark command
+        double              workingSetMB     = 0.0;
+        double              peakWorkingSetMB = 0.0;
+        String              profileJson;        // FrameProfiler scope table ("" = not profiled)
+        String              traceFile;
+    };
+
+    void Submit(String const& type, String const& payload);
+    void SpawnScene(sBenchmarkScene const& scene);
+    void IssueCommands(sBenchmarkScene const& scene);
+    void FinishScene();
+    void WriteResults(bool isComplete);
+
+    sBenchmarkConfig m_config;
+    SubmitFunction   m_submit;
+    ListFunction     m_listEntities;
+    ListFunction     m_listCameras;
+
+    size_t                m_sceneIndex  = 0;
+    ePhase                m_phase       = ePhase::SPAWN;
+    uint32_t              m_phaseFrame  = 0;
+    uint64_t              m_sceneFrame  = 0;              // Frames since the scene spawned (payload input)
+    std::vector<uint64_t> m_entityIds;                    // Spawned by the current scene
+    std::vector<uint64_t> m_cameraIds;
+    std::vector<float>    m_rateAccumulators;             // Per commandRates entry
+    std::vector<uint32_t> m_rateCursors;                  // Round-robin entity index per entry
+    uint32_t              m_frameCommands  = 0;
+    double                m_frameCommandMs = 0.0;
+
+    std::chrono::steady_clock::time_point m_lastFrameEnd;
+    std::chrono::steady_clock::time_point m_measureStart;
+    uint64_t                              m_lastWorkerFrames  = 0;
+    uint64_t                              m_lastSwapCount     = 0;
+    uint64_t                              m_profileFirstFrame = 0;
+    bool                                  m_isProfilerWasOn   = false;     // Restored after each profiled scene
+
+    std::vector<sSceneResult> m_results;
+    String                    m_resultsPath;
+    bool                      m_isFinished = false;
+};
@@ -0,0 +1,424 @@
+//----------------------------------------------------------------------------------------------------
+// BinaryLogger.cpp
+// Deferred-format logging for hot paths: call sites store raw arguments, a background thread formats
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/BinaryLogger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // Ring layout: records are 8-byte aligned and never wrap; a record that would cross the end is
+    // preceded by a padding record covering the rest of the ring
+    struct sRecordHeader
+    {
+        uint32_t                totalBytes = 0;     // Header + payload, rounded up to 8
+        uint32_t                isPadding  = 0;
+        uint64_t                sequence   = 0;
+        sBinaryLogSite const*   site       = nullptr;
+        BinaryLogFormatFunction formatter  = nullptr;
+        char const*             format     = nullptr;
+    };
+
+    size_t constexpr RECORD_HEADER_BYTES = (sizeof(sRecordHeader) + 7u) & ~static_cast<size_t>(7u);
+
+    //------------------------------------------------------------------------------------------------
+    struct sThreadRing
+    {
+        explicit sThreadRing(size_t const capacityBytes)
+            : bytes(capacityBytes),
+              mask(capacityBytes - 1)
+        {
+        }
+
+        std::vector<uint8_t> bytes;
+        uint64_t             mask        = 0;
+        uint64_t             pendingHead = 0;     // Producer only: end of the record being written
+
+        alignas(64) std::atomic<uint64_t> head{0};             // Written by the owning thread
+        alignas(64) std::atomic<uint64_t> tail{0};             // Written by the logger thread
+        std::atomic<uint64_t>             written{0};          // Owning thread only, read by GetStats()
+        std::atomic<uint64_t>             dropped{0};
+        std::atomic<uint32_t>             maxUsedBytes{0};
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sPendingEntry
+    {
+        uint64_t              sequence = 0;
+        sBinaryLogSite const* site     = nullptr;
+        String                text;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sLoggerState
+    {
+        std::atomic<bool>     isRunning{false};
+        std::atomic<uint32_t> filterGeneration{1};     // 0 is reserved for "unresolved" sites
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> synchronous{0};
+        std::atomic<uint64_t> emitted{0};
+
+        std::mutex                                mutex;      // rings, config, minSeverity
+        std::vector<std::unique_ptr<sThreadRing>> rings;
+        sBinaryLoggerConfig                       config;
+        int                                       minSeverity = 0;
+
+        std::mutex              wakeMutex;
+        std::condition_variable wakeCV;
+        bool                    isStopRequested = false;     // Guarded by wakeMutex
+        std::thread             thread;
+
+        // Logger thread only
+        std::vector<sPendingEntry> pending;
+        uint64_t                   reportedDrops = 0;
+    };
+
+    sLoggerState s_state;
+
+    thread_local sThreadRing* t_ring = nullptr;
+
+    //------------------------------------------------------------------------------------------------
+    size_t RoundUpToPowerOfTwo(size_t const value)
+    {
+        size_t result = 1024;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sThreadRing* GetThreadRing()
+    {
+        if (t_ring == nullptr)
+        {
+            std::lock_guard lock(s_state.mutex);
+            s_state.rings.push_back(std::make_unique<sThreadRing>(RoundUpToPowerOfTwo(s_state.config.ringBytesPerThread)));
+            t_ring = s_state.rings.back().get();
+        }
+        return t_ring;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Formats every committed record of one ring into s_state.pending (payloads are only valid until
+    // the tail moves past them, so formatting happens here)
+    void DrainRing(sThreadRing& ring)
+    {
+        uint64_t const head = ring.head.load(std::memory_order_acquire);
+        uint64_t       tail = ring.tail.load(std::memory_order_relaxed);
+
+        while (tail < head)
+        {
+            sRecordHeader header;
+            std::memcpy(&header.totalBytes, ring.bytes.data() + (tail & ring.mask), sizeof(header.totalBytes));
+            std::memcpy(&header.isPadding, ring.bytes.data() + (tail & ring.mask) + sizeof(header.totalBytes), sizeof(header.isPadding));
+
+            if (!header.isPadding)
+            {
+                std::memcpy(&header, ring.bytes.data() + (tail & ring.mask), sizeof(header));
+
+                sPendingEntry entry;
+                entry.sequence = header.sequence;
+                entry.site     = header.site;
+                entry.text     = header.formatter(header.format, ring.bytes.data() + (tail & ring.mask) + RECORD_HEADER_BYTES);
+                s_state.pending.push_back(std::move(entry));
+            }
+            tail += header.totalBytes;
+        }
+
+        ring.tail.store(tail, std::memory_order_release);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Drains every ring and emits in sequence order; returns the number of entries emitted
+    size_t Flush()
+    {
+        {
+            std::lock_guard lock(s_state.mutex);
+            for (std::unique_ptr<sThreadRing> const& ring : s_state.rings)
+            {
+                DrainRing(*ring);
+            }
+        }
+
+        std::sort(s_state.pending.begin(), s_state.pending.end(),
+                  [](sPendingEntry const& a, sPendingEntry const& b) { return a.sequence < b.sequence; });
+
+        for (sPendingEntry const& entry : s_state.pending)
+        {
+            entry.site->emit(entry.text);
+        }
+
+        size_t const count = s_state.pending.size();
+        s_state.emitted.fetch_add(count, std::memory_order_relaxed);
+        s_state.pending.clear();
+
+        uint64_t const drops = BinaryLogger::GetStats().dropped;
+        if (drops > s_state.reportedDrops)
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                       Stringf("BinaryLogger: dropped %llu entries (thread ring full) - raise binaryLogRingBytesPerThread",
+                           drops - s_state.reportedDrops));
+            s_state.reportedDrops = drops;
+        }
+        return count;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void LoggerThreadMain()
+    {
+        std::chrono::milliseconds const interval(std::max<uint32_t>(1, s_state.config.flushIntervalMs));
+
+        std::unique_lock lock(s_state.wakeMutex);
+        while (!s_state.isStopRequested)
+        {
+            s_state.wakeCV.wait_for(lock, interval);
+
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Ranks for the filter; the Engine enumerator values are not assumed to be ordered. Anything else
+// ranks with Log, so it is filtered like Log and never silently above it
+//----------------------------------------------------------------------------------------------------
+int GetBinaryLogSeverity(eLogVerbosity const verbosity)
+{
+    switch (verbosity)
+    {
+    case eLogVerbosity::Log:     return 1;
+    case eLogVerbosity::Display: return 2;
+    case eLogVerbosity::Warning: return 3;
+    case eLogVerbosity::Error:   return 4;
+    default:                     return 1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetBinaryLogSeverity(String const& verbosityName)
+{
+    if (verbosityName == "Log")     return 1;
+    if (verbosityName == "Display") return 2;
+    if (verbosityName == "Warning") return 3;
+    if (verbosityName == "Error")   return 4;
+    return -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+sBinaryLogSite::sBinaryLogSite(char const* categoryName_, eLogVerbosity const verbosity, char const* file_, int const line_,
+                               BinaryLogEmitFunction const emit_)
+    : categoryName(categoryName_),
+      severity(GetBinaryLogSeverity(verbosity)),
+      file(file_),
+      line(line_),
+      emit(emit_)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sBinaryLogSite::IsEnabled() const
+{
+    uint32_t const state = m_state.load(std::memory_order_relaxed);
+    if ((state >> 1) == s_state.filterGeneration.load(std::memory_order_relaxed))
+    {
+        return (state & 1u) != 0;
+    }
+    return Resolve();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sBinaryLogSite::Resolve() const
+{
+    std::lock_guard lock(s_state.mutex);
+
+    bool isEnabled = severity >= s_state.minSeverity;
+    for (String const& disabled : s_state.config.disabledCategories)
+    {
+        if (disabled == categoryName)
+        {
+            isEnabled = false;
+            break;
+        }
+    }
+
+    uint32_t const generation = s_state.filterGeneration.load(std::memory_order_relaxed);
+    m_state.store((generation << 1) | (isEnabled ? 1u : 0u), std::memory_order_relaxed);
+    return isEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t* BinaryLogDetail::BeginRecord(sBinaryLogSite const& site, BinaryLogFormatFunction const formatter, char const* format,
+                                      size_t const payloadBytes)
+{
+    sThreadRing*   ring       = GetThreadRing();
+    size_t const   capacity   = ring->bytes.size();
+    size_t const   totalBytes = (RECORD_HEADER_BYTES + payloadBytes + 7u) & ~static_cast<size_t>(7u);
+    uint64_t       head       = ring->head.load(std::memory_order_relaxed);
+    uint64_t const tail       = ring->tail.load(std::memory_order_acquire);
+
+    size_t const offset     = static_cast<size_t>(head & ring->mask);
+    size_t const contiguous = capacity - offset;
+    size_t const padding    = (contiguous < totalBytes) ? contiguous : 0;
+
+    if (totalBytes > capacity / 2 || head + padding + totalBytes - tail > capacity)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    if (padding > 0)
+    {
+        uint32_t const paddingHeader[2] = {static_cast<uint32_t>(padding), 1u};
+        std::memcpy(ring->bytes.data() + offset, paddingHeader, sizeof(paddingHeader));
+        head += padding;
+    }
+
+    sRecordHeader header;
+    header.totalBytes = static_cast<uint32_t>(totalBytes);
+    header.sequence   = s_state.sequence.fetch_add(1, std::memory_order_relaxed);
+    header.site       = &site;
+    header.formatter  = formatter;
+    header.format     = format;
+
+    uint8_t* record = ring->bytes.data() + (head & ring->mask);
+    std::memcpy(record, &header, sizeof(header));
+    ring->pendingHead = head + totalBytes;
+
+    uint32_t const usedBytes = static_cast<uint32_t>(ring->pendingHead - tail);
+    if (usedBytes > ring->maxUsedBytes.load(std::memory_order_relaxed))
+    {
+        ring->maxUsedBytes.store(usedBytes, std::memory_order_relaxed);
+    }
+    return record + RECORD_HEADER_BYTES;
+}
+
+//----------------------------------------------------------------------------------------------------
+void BinaryLogDetail::CommitRecord()
+{
+    sThreadRing* ring = t_ring;
+    ring->head.store(ring->pendingHead, std::memory_order_release);
+    ring->written.store(ring->written.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // Past half full: do not wait out the flush interval
+    if (ring->pendingHead - ring->tail.load(std::memory_order_relaxed) > ring->bytes.size() / 2)
+    {
+        s_state.wakeCV.notify_one();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool BinaryLogDetail::IsRunning()
+{
+    return s_state.isRunning.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------
+void BinaryLogDetail::CountSynchronous()
+{
+    s_state.synchronous.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Configure
+//
+// Bumping the generation makes every site re-resolve its filter on its next call. Ring size and
+// flush interval apply to rings created / a logger started afterwards.
+//----------------------------------------------------------------------------------------------------
+void BinaryLogger::Configure(sBinaryLoggerConfig const& config)
+{
+    std::lock_guard lock(s_state.mutex);
+    s_state.config = config;
+
+    int const minSeverity = GetBinaryLogSeverity(config.minVerbosity);
+    if (minSeverity < 0)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("BinaryLogger: unknown binaryLogMinVerbosity '%s' - using Log", config.minVerbosity.c_str()));
+    }
+    s_state.minSeverity = std::max(minSeverity, 1);
+
+    // Generation 0 is "unresolved" and the site state keeps 31 bits of it
+    uint32_t generation = (s_state.filterGeneration.load(std::memory_order_relaxed) + 1) & 0x7FFFFFFFu;
+    s_state.filterGeneration.store(generation == 0 ? 1 : generation, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+void BinaryLogger::Start()
+{
+    if (s_state.isRunning.load(std::memory_order_relaxed) || !s_state.config.isEnabled)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(s_state.wakeMutex);
+        s_state.isStopRequested = false;
+    }
+    s_state.thread = std::thread(LoggerThreadMain);
+    s_state.isRunning.store(true, std::memory_order_release);
+
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("BinaryLogger: started (ring %u bytes/thread, flush every %u ms, min verbosity %s)",
+                   static_cast<uint32_t>(RoundUpToPowerOfTwo(s_state.config.ringBytesPerThread)), s_state.config.flushIntervalMs,
+                   s_state.config.minVerbosity.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Shutdown
+//
+// New entries are formatted synchronously from here on; the final Flush() after the join picks up
+// whatever was committed before isRunning dropped.
+//----------------------------------------------------------------------------------------------------
+void BinaryLogger::Shutdown()
+{
+    if (!s_state.isRunning.exchange(false, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(s_state.wakeMutex);
+        s_state.isStopRequested = true;
+    }
+    s_state.wakeCV.notify_one();
+    s_state.thread.join();
+
+    Flush();
+
+    sBinaryLoggerStats const stats = GetStats();
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("BinaryLogger: stopped (%llu emitted, %llu dropped, %u thread rings, peak %u bytes)",
+                   stats.emitted, stats.dropped, stats.threadRings, stats.maxRingBytes));
+}
+
+//----------------------------------------------------------------------------------------------------
+sBinaryLoggerStats BinaryLogger::GetStats()
+{
+    sBinaryLoggerStats stats;
+    stats.isRunning   = s_state.isRunning.load(std::memory_order_relaxed);
+    stats.synchronous = s_state.synchronous.load(std::memory_order_relaxed);
+    stats.emitted     = s_state.emitted.load(std::memory_order_relaxed);
+
+    std::lock_guard lock(s_state.mutex);
+    stats.threadRings = static_cast<uint32_t>(s_state.rings.size());
+    for (std::unique_ptr<sThreadRing> const& ring : s_state.rings)
+    {
+        stats.written += ring->written.load(std::memory_order_relaxed);
+        stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+        stats.maxRingBytes = std::max(stats.maxRingBytes, ring->maxUsedBytes.load(std::memory_order_relaxed));
+    }
+    return stats;
+}
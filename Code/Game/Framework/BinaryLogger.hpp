@@ -0,0 +1,264 @@
+//----------------------------------------------------------------------------------------------------
+// BinaryLogger.hpp
+// Deferred-format logging for hot paths: call sites store raw arguments, a background thread formats
+//
+// Purpose:
+//   DAEMON_LOG formats on the calling thread: Stringf() runs and a String is allocated before the
+//   LogSubsystem even looks at the entry, and the calling thread may be holding a lock (e.g.
+//   JSGameLogicJob::TriggerNextFrame) or be mid-frame. DAEMON_LOG_FAST has the same shape as
+//   DAEMON_LOG(category, verbosity, Stringf(format, args...)) but the caller only copies the
+//   arguments into a per-thread ring; the logger thread formats them and hands the text to
+//   DAEMON_LOG, so every LogSubsystem sink and the LogRotation.json policy keep working unchanged.
+//
+// Design:
+//   - Each call site owns a static sBinaryLogSite (category, verbosity, file, line). The
+//     filter (LogConfig.json binaryLogMinVerbosity / binaryLogDisabledCategories) is resolved per
+//     site once per filter generation, and a filtered-out call returns before any argument is
+//     evaluated: one relaxed load and a compare
+//   - Arguments: arithmetic values are stored as-is; char const* and String are copied inline
+//     (NUL-terminated). Other pointers are rejected at compile time - a pointer may not outlive the
+//     call. The record stores a decoder instantiated for the exact argument types, so the format
+//     string is never parsed on the hot path
+//   - One single-producer ring per thread, allocated on the thread's first entry and owned by the
+//     logger for the process lifetime (threads come and go, the rings stay). A full ring drops the
+//     entry and counts it; drops are reported by the logger at Warning
+//   - Records carry a process-wide sequence number; the logger drains every ring and emits in
+//     sequence order, so cross-thread order is preserved. The time and thread id written by the
+//     LogSubsystem are the logger thread's (entries are at most flushIntervalMs late)
+//   - Not started (binaryLogging false, or before Start / after Shutdown): entries are formatted
+//     and logged synchronously, exactly like DAEMON_LOG
+//
+// Thread Safety Model:
+//   - DAEMON_LOG_FAST, Write(), sBinaryLogSite::IsEnabled(), GetStats(): any thread
+//   - Configure(), Start(), Shutdown(): main thread (Configure() may be called while running)
+//   - Ring: lock-free single producer (owning thread) / single consumer (logger thread)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sBinaryLoggerConfig
+{
+    bool                isEnabled          = false;     // false = DAEMON_LOG_FAST formats synchronously
+    uint32_t            ringBytesPerThread = 65536;     // Rounded up to a power of two
+    uint32_t            flushIntervalMs    = 5;
+    String              minVerbosity       = "Log";     // "Log" / "Display" / "Warning" / "Error"
+    std::vector<String> disabledCategories;             // e.g. "LogScript"
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sBinaryLoggerStats
+{
+    bool     isRunning    = false;
+    uint64_t written      = 0;      // Entries queued to a ring
+    uint64_t synchronous  = 0;      // Entries formatted on the calling thread (logger not running)
+    uint64_t emitted      = 0;      // Entries formatted and logged by the logger thread
+    uint64_t dropped      = 0;      // Ring full
+    uint32_t threadRings  = 0;
+    uint32_t maxRingBytes = 0;      // High-water mark of any ring
+};
+
+//----------------------------------------------------------------------------------------------------
+using BinaryLogEmitFunction   = void (*)(String const& text);
+using BinaryLogFormatFunction = String (*)(char const* format, uint8_t const* payload);
+
+//----------------------------------------------------------------------------------------------------
+struct sBinaryLogSite
+{
+    sBinaryLogSite(char const* categoryName, eLogVerbosity verbosity, char const* file, int line, BinaryLogEmitFunction emit);
+
+    bool IsEnabled() const;
+
+    char const*           categoryName = nullptr;
+    int                   severity     = 0;            // GetBinaryLogSeverity(verbosity)
+    char const*           file         = nullptr;
+    int                   line         = 0;
+    BinaryLogEmitFunction emit         = nullptr;      // DAEMON_LOG(category, verbosity, text)
+
+private:
+    bool Resolve() const;
+
+    mutable std::atomic<uint32_t> m_state = 0;     // (filter generation << 1) | isEnabled; 0 = unresolved
+};
+
+//----------------------------------------------------------------------------------------------------
+int GetBinaryLogSeverity(eLogVerbosity verbosity);
+int GetBinaryLogSeverity(String const& verbosityName);      // -1 if unknown
+
+//----------------------------------------------------------------------------------------------------
+namespace BinaryLogDetail
+{
+    //------------------------------------------------------------------------------------------------
+    template <typename T>
+    struct sArgTraits
+    {
+        using Decayed = std::decay_t<T>;
+
+        static bool constexpr IS_STRING = std::is_same_v<Decayed, char const*> || std::is_same_v<Decayed, char*> ||
+                                          std::is_same_v<Decayed, String>;
+
+        static_assert(IS_STRING || std::is_arithmetic_v<Decayed>,
+                      "DAEMON_LOG_FAST arguments must be arithmetic values, char const* or String");
+
+        // What the decoder hands to Stringf (strings decode to a pointer into the record)
+        using Decoded = std::conditional_t<IS_STRING, char const*, Decayed>;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    inline char const* GetStringData(char const* value) { return value ? value : "(null)"; }
+    inline char const* GetStringData(String const& value) { return value.c_str(); }
+
+    //------------------------------------------------------------------------------------------------
+    // Encoded size: values are stored unaligned (memcpy); strings as uint32 length + bytes + NUL
+    //------------------------------------------------------------------------------------------------
+    template <typename T>
+    size_t GetEncodedSize(T const& value)
+    {
+        if constexpr (sArgTraits<T>::IS_STRING)
+        {
+            return sizeof(uint32_t) + std::strlen(GetStringData(value)) + 1;
+        }
+        else
+        {
+            return sizeof(std::decay_t<T>);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    template <typename T>
+    void Encode(uint8_t*& cursor, T const& value)
+    {
+        if constexpr (sArgTraits<T>::IS_STRING)
+        {
+            char const*    text   = GetStringData(value);
+            uint32_t const length = static_cast<uint32_t>(std::strlen(text));
+            std::memcpy(cursor, &length, sizeof(length));
+            std::memcpy(cursor + sizeof(length), text, length + 1);
+            cursor += sizeof(length) + length + 1;
+        }
+        else
+        {
+            std::memcpy(cursor, &value, sizeof(value));
+            cursor += sizeof(value);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    template <typename T>
+    typename sArgTraits<T>::Decoded Decode(uint8_t const*& cursor)
+    {
+        if constexpr (sArgTraits<T>::IS_STRING)
+        {
+            uint32_t length = 0;
+            std::memcpy(&length, cursor, sizeof(length));
+            char const* text = reinterpret_cast<char const*>(cursor + sizeof(length));
+            cursor += sizeof(length) + length + 1;
+            return text;
+        }
+        else
+        {
+            typename sArgTraits<T>::Decoded value;
+            std::memcpy(&value, cursor, sizeof(value));
+            cursor += sizeof(value);
+            return value;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Instantiated per argument-type list; the braced initializer decodes left to right
+    //------------------------------------------------------------------------------------------------
+    template <typename... Args>
+    String FormatPayload(char const* format, uint8_t const* payload)
+    {
+        uint8_t const* cursor = payload;
+        std::tuple<typename sArgTraits<Args>::Decoded...> const values{Decode<Args>(cursor)...};
+        (void)cursor;
+
+        return std::apply([format](auto const... decoded) { return Stringf(format, decoded...); }, values);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Synchronous path: the value Stringf receives for an argument
+    //------------------------------------------------------------------------------------------------
+    template <typename T>
+    typename sArgTraits<T>::Decoded ToFormatArg(T const& value)
+    {
+        if constexpr (sArgTraits<T>::IS_STRING)
+        {
+            return GetStringData(value);
+        }
+        else
+        {
+            return value;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Reserves a record in the calling thread's ring; nullptr if the ring is full (counted as a drop)
+    //------------------------------------------------------------------------------------------------
+    uint8_t* BeginRecord(sBinaryLogSite const& site, BinaryLogFormatFunction formatter, char const* format, size_t payloadBytes);
+    void     CommitRecord();
+    bool     IsRunning();
+    void     CountSynchronous();
+}
+
+//----------------------------------------------------------------------------------------------------
+namespace BinaryLogger
+{
+    void Configure(sBinaryLoggerConfig const& config);
+    void Start();
+    void Shutdown();     // Drains every ring, then joins the logger thread
+
+    sBinaryLoggerStats GetStats();
+
+    //------------------------------------------------------------------------------------------------
+    // The format must be a literal: the record keeps the pointer until the logger formats it
+    //------------------------------------------------------------------------------------------------
+    template <size_t N, typename... Args>
+    void Write(sBinaryLogSite const& site, char const (&format)[N], Args const&... args)
+    {
+        if (BinaryLogDetail::IsRunning())
+        {
+            size_t const payloadBytes = (size_t{0} + ... + BinaryLogDetail::GetEncodedSize(args));
+            uint8_t*     cursor       = BinaryLogDetail::BeginRecord(site, &BinaryLogDetail::FormatPayload<Args...>, format, payloadBytes);
+            if (cursor)
+            {
+                (BinaryLogDetail::Encode(cursor, args), ...);
+                BinaryLogDetail::CommitRecord();
+            }
+            return;
+        }
+
+        BinaryLogDetail::CountSynchronous();
+        site.emit(Stringf(format, BinaryLogDetail::ToFormatArg(args)...));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// DAEMON_LOG_FAST(LogApp, eLogVerbosity::Warning, "skips: %llu", count)
+//
+// Same as DAEMON_LOG(LogApp, eLogVerbosity::Warning, Stringf("skips: %llu", count)), formatted on the
+// logger thread. Arguments are evaluated only if the site passes the filter. The format (first
+// variadic argument) must be a string literal.
+//----------------------------------------------------------------------------------------------------
+#define DAEMON_LOG_FAST(category, verbosity, ...)                                                                         \
+    do                                                                                                                    \
+    {                                                                                                                     \
+        static sBinaryLogSite const daemonLogFastSite(#category, verbosity, __FILE__, __LINE__,                           \
+                                                      [](String const& text) { DAEMON_LOG(category, verbosity, text); }); \
+        if (daemonLogFastSite.IsEnabled())                                                                                \
+        {                                                                                                                 \
+            BinaryLogger::Write(daemonLogFastSite, __VA_ARGS__);                                                          \
+        }                                                                                                                 \
+    } while (0)
@@ -0,0 +1,365 @@
+//----------------------------------------------------------------------------------------------------
+// BinaryMeshCache.cpp
+// Preprocessed .dmesh files that replace OBJ parsing after the first load
+//----------------------------------------------------------------------------------------------------
+
+// Prevent Windows.h min/max macros from conflicting with the standard library
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "Game/Framework/BinaryMeshCache.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Resource/MeshCache.hpp"
+
+//----------------------------------------------------------------------------------------------------
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t constexpr DMESH_MAGIC = 0x48534D44u;     // "DMSH", little-endian
+
+//----------------------------------------------------------------------------------------------------
+struct sBinaryMeshHeader
+{
+    uint32_t magic            = DMESH_MAGIC;
+    uint32_t version          = BinaryMeshCache::FORMAT_VERSION;
+    uint32_t vertexStride     = 0;
+    uint32_t indexStride      = 0;
+    uint64_t vertexCount      = 0;
+    uint64_t indexCount       = 0;
+    uint64_t sourcePathHash   = 0;
+    uint64_t sourceSize       = 0;
+    int64_t  sourceWriteTime  = 0;
+    float    localBoundRadius = 0.f;
+    uint32_t reserved         = 0;
+};
+
+static_assert(sizeof(sBinaryMeshHeader) == 64, "dmesh header layout changed, bump FORMAT_VERSION");
+
+//----------------------------------------------------------------------------------------------------
+using MeshIndex = decltype(ModelMeshData::indices)::value_type;
+
+//----------------------------------------------------------------------------------------------------
+// Read-only view of a whole file; unmapped on destruction
+//----------------------------------------------------------------------------------------------------
+struct sMappedFile
+{
+    HANDLE      file    = INVALID_HANDLE_VALUE;
+    HANDLE      mapping = nullptr;
+    void const* view    = nullptr;
+    uint64_t    size    = 0;
+
+    explicit sMappedFile(fs::path const& path)
+    {
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) return;
+        size = static_cast<uint64_t>(fileSize.QuadPart);
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return;
+
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+
+    ~sMappedFile()
+    {
+        if (view) UnmapViewOfFile(view);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    }
+
+    sMappedFile(sMappedFile const&)            = delete;
+    sMappedFile& operator=(sMappedFile const&) = delete;
+};
+
+//----------------------------------------------------------------------------------------------------
+static String NormalizeSourcePath(String const& sourcePath)
+{
+    String normalized = fs::path(sourcePath).lexically_normal().generic_string();
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                   [](unsigned char const c) { return static_cast<char>(std::tolower(c)); });
+    return normalized;
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t HashSourcePath(String const& normalizedPath)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char const c : normalizedPath)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The source's identity as recorded in the header; false if the source cannot be stat'ed
+//----------------------------------------------------------------------------------------------------
+static bool GetSourceStamp(String const& sourcePath, uint64_t& outSize, int64_t& outWriteTime)
+{
+    std::error_code error;
+    uintmax_t const size = fs::file_size(sourcePath, error);
+    if (error) return false;
+
+    fs::file_time_type const writeTime = fs::last_write_time(sourcePath, error);
+    if (error) return false;
+
+    outSize      = static_cast<uint64_t>(size);
+    outWriteTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ReadCurrentHeader
+//
+// Every header field and the file size are checked before anything is copied, so a stale, truncated
+// or foreign file is a plain miss.
+//----------------------------------------------------------------------------------------------------
+static bool ReadCurrentHeader(sMappedFile const& mapped, String const& sourcePath, sBinaryMeshHeader& outHeader)
+{
+    if (!mapped.view || mapped.size < sizeof(sBinaryMeshHeader))
+    {
+        return false;
+    }
+
+    uint64_t sourceSize      = 0;
+    int64_t  sourceWriteTime = 0;
+    if (!GetSourceStamp(sourcePath, sourceSize, sourceWriteTime))
+    {
+        return false;
+    }
+
+    std::memcpy(&outHeader, mapped.view, sizeof(outHeader));
+
+    bool const isCurrent = outHeader.magic == DMESH_MAGIC &&
+                           outHeader.version == BinaryMeshCache::FORMAT_VERSION &&
+                           outHeader.vertexStride == sizeof(Vertex_PCUTBN) &&
+                           outHeader.indexStride == sizeof(MeshIndex) &&
+                           outHeader.sourcePathHash == HashSourcePath(NormalizeSourcePath(sourcePath)) &&
+                           outHeader.sourceSize == sourceSize &&
+                           outHeader.sourceWriteTime == sourceWriteTime &&
+                           outHeader.vertexCount > 0;
+
+    uint64_t const payloadBytes = outHeader.vertexCount * outHeader.vertexStride + outHeader.indexCount * outHeader.indexStride;
+    return isCurrent && mapped.size == sizeof(sBinaryMeshHeader) + payloadBytes;
+}
+
+//----------------------------------------------------------------------------------------------------
+float ComputeModelBoundRadius(ModelMeshData const& mesh)
+{
+    float maxLengthSquared = 0.f;
+    for (Vertex_PCUTBN const& vert : mesh.vertices)
+    {
+        maxLengthSquared = std::max(maxLengthSquared, vert.m_position.GetLengthSquared());
+    }
+    return std::sqrt(maxLengthSquared);
+}
+
+//----------------------------------------------------------------------------------------------------
+BinaryMeshCache::BinaryMeshCache(String const& directory)
+    : m_directory(directory)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+String BinaryMeshCache::GetEntryPath(String const& sourcePath) const
+{
+    String const normalized = NormalizeSourcePath(sourcePath);
+    String const stem       = fs::path(normalized).stem().string();
+    return (fs::path(m_directory) / Stringf("%s_%016llx.dmesh", stem.c_str(), HashSourcePath(normalized))).generic_string();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool BinaryMeshCache::TryLoad(String const& sourcePath, ModelMeshData& outMesh, float& outLocalBoundRadius) const
+{
+    if (!IsEnabled())
+    {
+        return false;
+    }
+
+    sMappedFile const mapped(GetEntryPath(sourcePath));
+    sBinaryMeshHeader header;
+    if (!ReadCurrentHeader(mapped, sourcePath, header))
+    {
+        return false;
+    }
+
+    uint64_t const vertexBytes = header.vertexCount * header.vertexStride;
+    uint64_t const indexBytes  = header.indexCount * header.indexStride;
+
+    unsigned char const* const data = static_cast<unsigned char const*>(mapped.view) + sizeof(sBinaryMeshHeader);
+
+    outMesh.vertices.resize(static_cast<size_t>(header.vertexCount));
+    std::memcpy(static_cast<void*>(outMesh.vertices.data()), data, static_cast<size_t>(vertexBytes));
+
+    outMesh.indices.resize(static_cast<size_t>(header.indexCount));
+    if (indexBytes > 0)
+    {
+        std::memcpy(outMesh.indices.data(), data + vertexBytes, static_cast<size_t>(indexBytes));
+    }
+
+    outLocalBoundRadius = header.localBoundRadius;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool BinaryMeshCache::IsEntryCurrent(String const& sourcePath) const
+{
+    if (!IsEnabled())
+    {
+        return false;
+    }
+
+    sMappedFile const mapped(GetEntryPath(sourcePath));
+    sBinaryMeshHeader header;
+    return ReadCurrentHeader(mapped, sourcePath, header);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t BinaryMeshCache::Write(String const& sourcePath, ModelMeshData const& mesh, float const localBoundRadius) const
+{
+    if (!IsEnabled() || mesh.vertices.empty())
+    {
+        return 0;
+    }
+
+    sBinaryMeshHeader header;
+    header.vertexStride     = sizeof(Vertex_PCUTBN);
+    header.indexStride      = sizeof(MeshIndex);
+    header.vertexCount      = mesh.vertices.size();
+    header.indexCount       = mesh.indices.size();
+    header.sourcePathHash   = HashSourcePath(NormalizeSourcePath(sourcePath));
+    header.localBoundRadius = localBoundRadius;
+    if (!GetSourceStamp(sourcePath, header.sourceSize, header.sourceWriteTime))
+    {
+        return 0;
+    }
+
+    fs::path const entryPath = GetEntryPath(sourcePath);
+
+    // Unique per writer thread so two writers never share a temporary
+    std::ostringstream tempName;
+    tempName << entryPath.filename().string() << ".tmp" << std::this_thread::get_id();
+    fs::path const tempPath = entryPath.parent_path() / tempName.str();
+
+    std::error_code error;
+    fs::create_directories(entryPath.parent_path(), error);
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                       Stringf("BinaryMeshCache: Cannot write '%s'", tempPath.generic_string().c_str()));
+            return 0;
+        }
+
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(mesh.vertices.data()), static_cast<std::streamsize>(mesh.vertices.size() * sizeof(Vertex_PCUTBN)));
+        file.write(reinterpret_cast<char const*>(mesh.indices.data()), static_cast<std::streamsize>(mesh.indices.size() * sizeof(MeshIndex)));
+        if (!file.good())
+        {
+            file.close();
+            fs::remove(tempPath, error);
+            return 0;
+        }
+    }
+
+    fs::rename(tempPath, entryPath, error);
+    if (error)
+    {
+        fs::remove(tempPath, error);
+        return 0;
+    }
+
+    return sizeof(header) + mesh.vertices.size() * sizeof(Vertex_PCUTBN) + mesh.indices.size() * sizeof(MeshIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+eMeshBakeResult BinaryMeshCache::Bake(String const& sourcePath, bool const force, uint64_t* outBytes) const
+{
+    if (!IsEnabled())
+    {
+        return eMeshBakeResult::FAILED;
+    }
+
+    if (!force && IsEntryCurrent(sourcePath))
+    {
+        return eMeshBakeResult::UP_TO_DATE;
+    }
+
+    // A private cache frees each parsed model as soon as its entry is written
+    MeshCache            meshCache;
+    ModelMeshData const* model = meshCache.GetOrCreateModel("obj:" + sourcePath);
+    if (!model || model->vertices.empty())
+    {
+        return eMeshBakeResult::FAILED;
+    }
+
+    uint64_t const bytes = Write(sourcePath, *model, ComputeModelBoundRadius(*model));
+    if (outBytes) *outBytes = bytes;
+    return bytes > 0 ? eMeshBakeResult::BAKED : eMeshBakeResult::FAILED;
+}
+
+//----------------------------------------------------------------------------------------------------
+sMeshBakeSummary BinaryMeshCache::BakeDirectory(String const& directory, bool const force) const
+{
+    auto const       start = std::chrono::steady_clock::now();
+    sMeshBakeSummary summary;
+
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, error), end; it != end; it.increment(error))
+    {
+        if (error) break;
+        if (!it->is_regular_file(error)) continue;
+
+        String extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char const c) { return static_cast<char>(std::tolower(c)); });
+        if (extension != ".obj") continue;
+
+        uint64_t              bytes  = 0;
+        String const          path   = it->path().generic_string();
+        eMeshBakeResult const result = Bake(path, force, &bytes);
+        if (result == eMeshBakeResult::BAKED)
+        {
+            ++summary.baked;
+            summary.bytes += bytes;
+        }
+        else if (result == eMeshBakeResult::UP_TO_DATE)
+        {
+            ++summary.upToDate;
+        }
+        else
+        {
+            ++summary.failed;
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning, Stringf("BinaryMeshCache: Failed to bake '%s'", path.c_str()));
+        }
+    }
+
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
@@ -0,0 +1,93 @@
+//----------------------------------------------------------------------------------------------------
+// BinaryMeshCache.hpp
+// Preprocessed .dmesh files that replace OBJ parsing after the first load
+//
+// Purpose:
+//   ObjModelLoader re-parses every .obj text file on every process start, the first time load_model
+//   asks for it. A .dmesh file holds the parser's output (interleaved Vertex_PCUTBN vertices and
+//   32-bit indices) exactly as GpuMeshCache uploads it, so a later run maps the file and copies two
+//   arrays instead of tokenizing text.
+//
+// Design:
+//   - One file per source, named <stem>_<hash>.dmesh in the cache directory, where hash is FNV-1a of
+//     the normalized, lower-cased source path. The header repeats the hash plus the source's size
+//     and last-write time; any mismatch (or a different vertex/index stride or format version)
+//     makes the entry stale and the OBJ is parsed again
+//   - Layout: 64-byte header, vertices, indices. Header and strides keep both arrays 4-byte aligned,
+//     so the mapped view could be handed to a buffer upload directly
+//   - Written by whichever thread parsed the OBJ, through a temporary file and a rename, so a crash
+//     or a concurrent reader never sees a partial entry
+//   - TryLoad() maps the file read-only and copies into ModelMeshData, which is what the render path
+//     and GpuMeshCache consume
+//   - Bake() refreshes the entry for one source, BakeDirectory() for every .obj under a directory
+//     (game.bake_meshes)
+//
+// Thread Safety Model:
+//   - Stateless apart from the directory set at construction: every method may run on any thread
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+struct ModelMeshData;
+
+//----------------------------------------------------------------------------------------------------
+enum class eMeshBakeResult : uint8_t
+{
+    BAKED,
+    UP_TO_DATE,
+    FAILED
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sMeshBakeSummary
+{
+    uint32_t baked     = 0;
+    uint32_t upToDate  = 0;
+    uint32_t failed    = 0;
+    uint64_t bytes     = 0;      // Size of the entries written
+    double   elapsedMs = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Max vertex distance from the model origin (MeshHandleTable::GetBoundRadius() scales it)
+float ComputeModelBoundRadius(ModelMeshData const& mesh);
+
+//----------------------------------------------------------------------------------------------------
+class BinaryMeshCache
+{
+public:
+    static uint32_t constexpr FORMAT_VERSION = 1;
+
+    // Empty directory = disabled (TryLoad() misses, Write() does nothing)
+    explicit BinaryMeshCache(String const& directory);
+
+    bool          IsEnabled() const { return !m_directory.empty(); }
+    String const& GetDirectory() const { return m_directory; }
+
+    // Cache file for an OBJ path ("Data/Models/Foo.obj", no "obj:" prefix)
+    String GetEntryPath(String const& sourcePath) const;
+
+    // True (and outMesh filled) if a current entry exists for sourcePath
+    bool TryLoad(String const& sourcePath, ModelMeshData& outMesh, float& outLocalBoundRadius) const;
+
+    // Entry exists and matches the source (header only, nothing is copied)
+    bool IsEntryCurrent(String const& sourcePath) const;
+
+    // Replace the entry for sourcePath; returns the bytes written (0 on failure)
+    uint64_t Write(String const& sourcePath, ModelMeshData const& mesh, float localBoundRadius) const;
+
+    // Parse sourcePath with a private MeshCache and write its entry unless one is current (or force)
+    eMeshBakeResult Bake(String const& sourcePath, bool force, uint64_t* outBytes = nullptr) const;
+
+    // Bake every .obj under directory, recursively
+    sMeshBakeSummary BakeDirectory(String const& directory, bool force) const;
+
+private:
+    String m_directory;
+};
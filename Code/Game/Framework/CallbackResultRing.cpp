@@ -0,0 +1,238 @@
+//----------------------------------------------------------------------------------------------------
+// CallbackResultRing.cpp
+// Binary result channel for high-frequency GenericCommand queries (C++ → JS)
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/CallbackResultRing.hpp"
+
+#include "Game/Framework/BinaryLogger.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+// Suppress V8 header warnings (unreferenced formal parameters, etc.)
+#pragma warning(push)
+#pragma warning(disable: 4100)  // 'identifier': unreferenced formal parameter
+#pragma warning(disable: 4127)  // conditional expression is constant
+#pragma warning(disable: 4324)  // 'structname': structure was padded due to alignment specifier
+#include <v8.h>
+#pragma warning(pop)
+
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------
+CallbackResultRing::CallbackResultRing(uint32_t const capacityBytes)
+    : m_capacityBytes(capacityBytes & ~7u)
+{
+    if (m_capacityBytes < RECORD_HEADER_BYTES * 4)
+    {
+        ERROR_AND_DIE("CallbackResultRing: capacityBytes must be at least 64");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+CallbackResultRing::~CallbackResultRing()
+{
+    // BackingStore releases the memory once the JS ArrayBuffer is also collected
+    m_data = nullptr;
+    m_backingStore.reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+// InstallScriptBuffer
+//
+// Same allocation scheme as TypedCommandBuffer::InstallScriptBuffer(): V8 owns the bytes (sandbox
+// safe), C++ keeps the BackingStore alive and writes through m_data.
+//----------------------------------------------------------------------------------------------------
+bool CallbackResultRing::InstallScriptBuffer(v8::Isolate* isolate, char const* globalName)
+{
+    if (isolate == nullptr || globalName == nullptr)
+    {
+        return false;
+    }
+
+    v8::Locker                   locker(isolate);
+    v8::Isolate::Scope           isolateScope(isolate);
+    v8::HandleScope              handleScope(isolate);
+    v8::Local<v8::Context> const context = isolate->GetCurrentContext();
+
+    if (context.IsEmpty())
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, "CallbackResultRing::InstallScriptBuffer - No V8 context, structured results disabled");
+        return false;
+    }
+
+    v8::Context::Scope contextScope(context);
+
+    size_t const                     byteLength  = HEADER_SIZE_BYTES + m_capacityBytes;
+    v8::Local<v8::ArrayBuffer> const arrayBuffer = v8::ArrayBuffer::New(isolate, byteLength);
+
+    m_backingStore = arrayBuffer->GetBackingStore();
+    m_data         = static_cast<uint8_t*>(m_backingStore->Data());
+
+    std::memset(m_data, 0, byteLength);
+    uint32_t* header = GetHeader();
+    header[0]        = CALLBACK_RESULT_RING_VERSION;
+    header[3]        = m_capacityBytes;
+
+    v8::Local<v8::String> const name = v8::String::NewFromUtf8(isolate, globalName).ToLocalChecked();
+    if (context->Global()->Set(context, name, arrayBuffer).IsNothing())
+    {
+        m_data = nullptr;
+        m_backingStore.reset();
+        return false;
+    }
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log, Stringf("CallbackResultRing: globalThis.%s installed (%u bytes)", globalName, m_capacityBytes));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void CallbackResultRing::WriteRecord(uint32_t const token, eCallbackResultKind const kind, uint32_t const count,
+                                     double const* values, uint32_t const valueCount)
+{
+    StageRecord(token, kind, count, values, static_cast<size_t>(valueCount) * sizeof(double));
+}
+
+//----------------------------------------------------------------------------------------------------
+void CallbackResultRing::WriteError(uint32_t const token, eCallbackResultError const error)
+{
+    double const value = static_cast<double>(static_cast<uint32_t>(error));
+    StageRecord(token, eCallbackResultKind::ERROR, 1, &value, sizeof(double));
+}
+
+//----------------------------------------------------------------------------------------------------
+void CallbackResultRing::WriteMeshTypes(uint32_t const firstHandle, uint32_t const nameCount, std::vector<char> const& names)
+{
+    if (nameCount == 0)
+    {
+        return;
+    }
+
+    StageRecord(firstHandle, eCallbackResultKind::MESH_TYPES, nameCount, names.data(), names.size());
+
+    std::lock_guard lock(m_mutex);
+    m_meshTypesSent = std::max(m_meshTypesSent, firstHandle + nameCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t CallbackResultRing::GetMeshTypesSent() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_meshTypesSent;
+}
+
+//----------------------------------------------------------------------------------------------------
+// StageRecord
+//
+// Payloads are zero-padded to 8 bytes so every record (and every float64 view JS creates on one)
+// stays aligned.
+//----------------------------------------------------------------------------------------------------
+void CallbackResultRing::StageRecord(uint32_t const token, eCallbackResultKind const kind, uint32_t const count,
+                                     void const* payload, size_t const payloadBytes)
+{
+    size_t const paddedBytes = (payloadBytes + 7u) & ~static_cast<size_t>(7u);
+
+    if (RECORD_HEADER_BYTES + paddedBytes > m_capacityBytes)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_stats.oversized;
+        }
+
+        DAEMON_LOG_FAST(LogScript, eLogVerbosity::Warning,
+                        "CallbackResultRing: result for token %u is %zu bytes (ring holds %u) - sending ERROR", token, paddedBytes, m_capacityBytes);
+        WriteError(token, eCallbackResultError::TOO_LARGE);
+        return;
+    }
+
+    uint32_t const recordHeader[4] = {token, static_cast<uint32_t>(kind), count, static_cast<uint32_t>(paddedBytes)};
+
+    std::lock_guard lock(m_mutex);
+    size_t const    offset = m_staged.size();
+    m_staged.resize(offset + RECORD_HEADER_BYTES + paddedBytes, 0);
+    std::memcpy(m_staged.data() + offset, recordHeader, RECORD_HEADER_BYTES);
+    if (payloadBytes > 0)
+    {
+        std::memcpy(m_staged.data() + offset + RECORD_HEADER_BYTES, payload, payloadBytes);
+    }
+    ++m_stagedRecords;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Publish
+//
+// Whole records only, oldest first; what does not fit stays staged for the next frame. usedBytes is
+// clamped like TypedCommandBuffer::Drain() clamps recordCount: a corrupted header written by
+// JavaScript must never make C++ write past the BackingStore.
+//----------------------------------------------------------------------------------------------------
+uint32_t CallbackResultRing::Publish()
+{
+    if (m_data == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t*       header = GetHeader();
+    std::lock_guard lock(m_mutex);
+
+    // Everything sent so far was consumed, so JS's name cache is authoritative (empty after a reload)
+    if (header[1] == 0)
+    {
+        header[2]       = 0;
+        m_meshTypesSent = std::min(m_meshTypesSent, header[6]);
+    }
+
+    uint32_t usedBytes = std::min(header[2], m_capacityBytes);
+    size_t   offset    = 0;
+    uint32_t published = 0;
+
+    while (offset < m_staged.size())
+    {
+        uint32_t recordHeader[4];
+        std::memcpy(recordHeader, m_staged.data() + offset, RECORD_HEADER_BYTES);
+
+        size_t const recordBytes = RECORD_HEADER_BYTES + recordHeader[3];
+        if (usedBytes + recordBytes > m_capacityBytes)
+        {
+            break;
+        }
+
+        std::memcpy(m_data + HEADER_SIZE_BYTES + usedBytes, m_staged.data() + offset, recordBytes);
+        usedBytes += static_cast<uint32_t>(recordBytes);
+        offset += recordBytes;
+        ++published;
+    }
+
+    if (published > 0)
+    {
+        m_staged.erase(m_staged.begin(), m_staged.begin() + static_cast<std::ptrdiff_t>(offset));
+        m_stagedRecords -= published;
+
+        header[1] += published;
+        header[2] = usedBytes;
+        ++header[4];
+
+        m_stats.totalRecords += published;
+        m_stats.totalBytes += offset;
+    }
+
+    header[5] = m_stagedRecords;
+
+    if (m_stagedRecords > 0)
+    {
+        ++m_stats.deferredFrames;
+    }
+    m_stats.lastPublished = published;
+    m_stats.stagedRecords = m_stagedRecords;
+    return published;
+}
+
+//----------------------------------------------------------------------------------------------------
+sCallbackResultRingStats CallbackResultRing::GetStats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------------------------------
+// CallbackResultRing.hpp
+// Binary result channel for high-frequency GenericCommand queries (C++ → JS)
+//
+// Purpose:
+//   GenericCommand results normally travel as a resultJson string: the handler builds it with
+//   std::ostringstream, CallbackQueue.dequeueAll() materializes an array of callback objects and
+//   CommandQueue.handleCallback() JSON.parse()s the string into a fresh object graph. For per-frame
+//   queries (entity lists, radius queries, raycasts) that is the largest source of JS garbage. This
+//   ring is the reverse of TypedCommandBuffer: handlers append packed float64 records into a shared
+//   ArrayBuffer and CommandQueue.js decodes them into pooled objects with typed-array views. No
+//   string is built, nothing is parsed and no callback array is allocated.
+//
+// Opt-in:
+//   CommandQueue.submitStructured() puts "resultToken" in front of the payload and submits without a
+//   callback, so the executor queues nothing on the CallbackQueue. Handlers that support the ring
+//   check the token (App::RegisterHandlers()) and answer every outcome - errors included - with a
+//   record; a submission dropped before any handler saw it fails in JS after a frame timeout.
+//   Commands without a token keep the resultJson path unchanged.
+//
+// Memory Layout (little-endian, mirrored in Run/Data/Scripts/Interface/CommandQueue.js):
+//   Header (32 bytes):
+//     uint32 [0] version         - CALLBACK_RESULT_RING_VERSION (written by C++)
+//     uint32 [1] recordCount     - Records available (appended by C++, reset to 0 by JS once read)
+//     uint32 [2] usedBytes       - Bytes of record data in use (appended by C++, reset by JS)
+//     uint32 [3] capacityBytes   - Size of the record area (written by C++)
+//     uint32 [4] publishSerial   - Incremented by every Publish() that appended records
+//     uint32 [5] pendingRecords  - Records still staged because the ring was full
+//     uint32 [6] meshTypesKnown  - Mesh type names JS has cached (written by JS; 0 after hot reload)
+//     uint32 [7] reserved
+//   Records (8-byte aligned, starting at byte 32):
+//     uint32 token      @ +0     - resultToken from the payload
+//     uint32 kind       @ +4     - eCallbackResultKind (fixes the element layout)
+//     uint32 count      @ +8     - Elements
+//     uint32 byteLength @ +12    - Payload bytes that follow, multiple of 8
+//     payload           @ +16    - count * stride float64 values (MESH_TYPES: ASCII bytes)
+//
+// Thread Safety Model:
+//   - Main thread: handlers Write*() into a staging vector (m_mutex)
+//   - Worker thread: Publish() at the start of every JS frame with the v8::Locker held appends the
+//     staged records after whatever JS has not consumed yet; JS reads and resets the header in the
+//     same frame. The shared bytes are only touched under the Locker, so lockstep and pipelined
+//     modes behave the same.
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Forward Declarations
+//----------------------------------------------------------------------------------------------------
+namespace v8
+{
+class BackingStore;
+class Isolate;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t constexpr CALLBACK_RESULT_RING_VERSION = 2;
+
+//----------------------------------------------------------------------------------------------------
+// eCallbackResultKind
+//
+// Values and element layouts are part of the JS contract (CommandQueue.js ResultKind) — append only.
+//----------------------------------------------------------------------------------------------------
+enum class eCallbackResultKind : uint32_t
+{
+    ERROR        = 0,     // 1 element: eCallbackResultError
+    ENTITY_LIST  = 1,     // Elements: entityId, x, y, z, yaw, pitch, roll, scale, rgba, meshHandle, cameraTypeId;
+                          // then 6 values: version, sinceVersion, flags, cursorVersion, cursorSlot, removedCount;
+                          // then removedCount entityIds (a game.get_entity_list page, EntitySnapshot.hpp)
+    ENTITY_QUERY = 2,     // Elements: entityId, x, y, z, distance, meshHandle; then 1 value: totalMatches
+    RAYCAST      = 3,     // 0 elements (miss) or 1: entityId, distance, pointX, pointY, pointZ, meshHandle
+    MESH_TYPES   = 4,     // token = first mesh handle, count = names; payload: ASCII names, '\0'-terminated
+    COUNT
+};
+
+uint32_t constexpr ERROR_STRIDE        = 1;
+uint32_t constexpr ENTITY_LIST_STRIDE  = 11;
+uint32_t constexpr ENTITY_QUERY_STRIDE = 6;
+uint32_t constexpr RAYCAST_STRIDE      = 6;
+
+uint32_t constexpr ENTITY_LIST_FLAG_FULL_SNAPSHOT = 1u << 0;     // Drop the local mirror, then apply
+uint32_t constexpr ENTITY_LIST_FLAG_HAS_MORE      = 1u << 1;     // Fetch the next page with the cursor
+
+//----------------------------------------------------------------------------------------------------
+enum class eCallbackResultError : uint32_t
+{
+    NOT_AVAILABLE = 1,     // Subsystem missing (e.g. EntityStore)
+    INVALID_PARAM = 2,
+    TOO_LARGE     = 3      // Result exceeds the ring capacity
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sCallbackResultRingStats
+{
+    uint32_t lastPublished  = 0;      // Records appended by the most recent Publish()
+    uint32_t stagedRecords  = 0;
+    uint64_t totalRecords   = 0;
+    uint64_t totalBytes     = 0;
+    uint64_t deferredFrames = 0;      // Publish() calls that left records staged (ring full)
+    uint64_t oversized      = 0;      // Records that could never fit, replaced by ERROR
+};
+
+//----------------------------------------------------------------------------------------------------
+class CallbackResultRing
+{
+public:
+    static size_t constexpr HEADER_SIZE_BYTES   = 32;
+    static size_t constexpr RECORD_HEADER_BYTES = 16;
+
+    explicit CallbackResultRing(uint32_t capacityBytes);
+    ~CallbackResultRing();
+
+    CallbackResultRing(CallbackResultRing const&)            = delete;
+    CallbackResultRing& operator=(CallbackResultRing const&) = delete;
+
+    // Allocate the ArrayBuffer inside the V8 heap and publish it as globalThis[globalName]
+    // Thread Safety: Main thread only, before JSGameLogicJob is submitted
+    bool InstallScriptBuffer(v8::Isolate* isolate, char const* globalName);
+
+    // Stage a record of valueCount float64 values describing count elements (main thread). Records
+    // larger than the whole ring are replaced by an ERROR record so the JS callback still fires.
+    void WriteRecord(uint32_t token, eCallbackResultKind kind, uint32_t count, double const* values, uint32_t valueCount);
+    void WriteError(uint32_t token, eCallbackResultError error);
+
+    // Stage '\0'-terminated names for mesh handles firstHandle.. (JS caches them by handle). Call
+    // before the first record that references a handle >= GetMeshTypesSent().
+    void     WriteMeshTypes(uint32_t firstHandle, uint32_t nameCount, std::vector<char> const& names);
+    uint32_t GetMeshTypesSent() const;
+
+    // Append staged records to the shared ring (worker thread, v8::Locker held)
+    uint32_t Publish();
+
+    bool                     IsInstalled() const { return m_data != nullptr; }
+    uint32_t                 GetCapacityBytes() const { return m_capacityBytes; }
+    sCallbackResultRingStats GetStats() const;
+
+private:
+    void StageRecord(uint32_t token, eCallbackResultKind kind, uint32_t count, void const* payload, size_t payloadBytes);
+
+    uint32_t* GetHeader() const { return reinterpret_cast<uint32_t*>(m_data); }
+
+    std::shared_ptr<v8::BackingStore> m_backingStore;     // Keeps the JS-visible memory alive
+    uint8_t*                          m_data          = nullptr;
+    uint32_t                          m_capacityBytes = 0;
+
+    mutable std::mutex       m_mutex;                     // Guards everything below
+    std::vector<uint8_t>     m_staged;                    // Whole records, same layout as the ring
+    uint32_t                 m_stagedRecords  = 0;
+    uint32_t                 m_meshTypesSent  = 0;        // Mesh handles whose names were staged
+    sCallbackResultRingStats m_stats;
+};
@@ -0,0 +1,233 @@
+//----------------------------------------------------------------------------------------------------
+// DebugLayerRenderer.cpp
+// Batched one-frame debug lines/points and retained, GPU-resident debug layers (debug_render.add_batch)
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/DebugLayerRenderer.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+// Triangles are wound counter-clockwise seen from outside, like the Engine's primitive meshes
+//----------------------------------------------------------------------------------------------------
+static void AppendTriangle(VertexList_PCU& verts, Vec3 const& a, Vec3 const& b, Vec3 const& c, Rgba8 const& color)
+{
+    verts.emplace_back(a, color, Vec2::ZERO);
+    verts.emplace_back(b, color, Vec2::ZERO);
+    verts.emplace_back(c, color, Vec2::ZERO);
+}
+
+//----------------------------------------------------------------------------------------------------
+// AppendDebugLineVerts
+//
+// Square prism around start → end, side faces only (the caps are never seen at debug radii). The
+// cross-section corners u, v, -u, -v turn counter-clockwise about the line direction.
+//----------------------------------------------------------------------------------------------------
+void AppendDebugLineVerts(VertexList_PCU& verts, Vec3 const& start, Vec3 const& end, float const radius, Rgba8 const& color)
+{
+    Vec3 const  delta  = end - start;
+    float const length = delta.GetLength();
+    if (length <= 1.0e-6f)
+    {
+        AppendDebugPointVerts(verts, start, radius, color);
+        return;
+    }
+
+    Vec3 const direction = delta * (1.f / length);
+    Vec3 const reference = (std::fabs(direction.z) < 0.99f) ? Vec3(0.f, 0.f, 1.f) : Vec3(0.f, 1.f, 0.f);
+    Vec3 const u         = CrossProduct3D(direction, reference).GetNormalized() * radius;
+    Vec3 const v         = CrossProduct3D(direction, u);
+
+    Vec3 const corners[4] = {u, v, Vec3::ZERO - u, Vec3::ZERO - v};
+    for (int side = 0; side < 4; ++side)
+    {
+        Vec3 const& from = corners[side];
+        Vec3 const& to   = corners[(side + 1) % 4];
+
+        AppendTriangle(verts, start + from, start + to, end + to, color);
+        AppendTriangle(verts, start + from, end + to, end + from, color);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Octahedron: one face per octant; octants with an odd number of negative axes swap two corners to
+// keep the winding outward
+//----------------------------------------------------------------------------------------------------
+void AppendDebugPointVerts(VertexList_PCU& verts, Vec3 const& center, float const radius, Rgba8 const& color)
+{
+    for (int octant = 0; octant < 8; ++octant)
+    {
+        float const signX = (octant & 1) ? -1.f : 1.f;
+        float const signY = (octant & 2) ? -1.f : 1.f;
+        float const signZ = (octant & 4) ? -1.f : 1.f;
+
+        Vec3 const x = center + Vec3(signX * radius, 0.f, 0.f);
+        Vec3 const y = center + Vec3(0.f, signY * radius, 0.f);
+        Vec3 const z = center + Vec3(0.f, 0.f, signZ * radius);
+
+        if (signX * signY * signZ > 0.f)
+        {
+            AppendTriangle(verts, x, y, z, color);
+        }
+        else
+        {
+            AppendTriangle(verts, x, z, y, color);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+DebugLayerRenderer::DebugLayerRenderer(Renderer* renderer)
+    : m_renderer(renderer)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+DebugLayerRenderer::~DebugLayerRenderer()
+{
+    ClearAllLayers();
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t DebugLayerRenderer::SetLayerGeometry(String const& layerId, VertexList_PCU const& verts, bool const isAppend)
+{
+    sLayer& layer = m_layers[layerId];
+    if (!isAppend)
+    {
+        layer.verts.clear();
+    }
+    layer.verts.insert(layer.verts.end(), verts.begin(), verts.end());
+    layer.isDirty = true;
+
+    return static_cast<uint32_t>(layer.verts.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+bool DebugLayerRenderer::SetLayerVisible(String const& layerId, bool const isVisible)
+{
+    auto const it = m_layers.find(layerId);
+    if (it == m_layers.end())
+    {
+        return false;
+    }
+
+    it->second.isVisible = isVisible;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool DebugLayerRenderer::ClearLayer(String const& layerId)
+{
+    auto const it = m_layers.find(layerId);
+    if (it == m_layers.end())
+    {
+        return false;
+    }
+
+    Release(it->second);
+    m_layers.erase(it);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugLayerRenderer::ClearAllLayers()
+{
+    for (auto& [layerId, layer] : m_layers)
+    {
+        Release(layer);
+    }
+    m_layers.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sDebugLayerInfo> DebugLayerRenderer::GetLayerInfos() const
+{
+    std::vector<sDebugLayerInfo> infos;
+    infos.reserve(m_layers.size());
+    for (auto const& [layerId, layer] : m_layers)
+    {
+        sDebugLayerInfo info;
+        info.id          = layerId;
+        info.isVisible   = layer.isVisible;
+        info.vertexCount = static_cast<uint32_t>(layer.verts.size());
+        info.gpuBytes    = layer.vertexBuffer ? layer.uploadedVerts * sizeof(Vertex_PCU) : 0;
+        infos.push_back(std::move(info));
+    }
+    return infos;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Render
+//
+// Hidden layers are not uploaded until they are shown again, so editing a hidden layer is free.
+//----------------------------------------------------------------------------------------------------
+uint32_t DebugLayerRenderer::Render(Camera const* worldCamera)
+{
+    uint32_t drawCalls = 0;
+
+    if (worldCamera && m_isVisible && m_renderer)
+    {
+        m_renderer->BeginCamera(*worldCamera);
+        m_renderer->SetModelConstants(Mat44(), Rgba8::WHITE);
+        m_renderer->BindTexture(nullptr);
+
+        for (auto& [layerId, layer] : m_layers)
+        {
+            if (!layer.isVisible) continue;
+
+            if (layer.isDirty)
+            {
+                Upload(layer);
+            }
+            if (layer.vertexBuffer)
+            {
+                m_renderer->DrawVertexBuffer(layer.vertexBuffer, layer.uploadedVerts);
+                ++drawCalls;
+            }
+        }
+
+        for (size_t first = 0; first < m_frameVerts.size(); first += MAX_FRAME_VERTS)
+        {
+            size_t const count = std::min<size_t>(MAX_FRAME_VERTS, m_frameVerts.size() - first);
+            m_renderer->DrawVertexArray(static_cast<int>(count), m_frameVerts.data() + first);
+            ++drawCalls;
+        }
+
+        m_renderer->EndCamera(*worldCamera);
+    }
+
+    m_frameVerts.clear();
+    return drawCalls;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugLayerRenderer::Upload(sLayer& layer)
+{
+    Release(layer);
+    layer.isDirty = false;
+
+    if (layer.verts.empty())
+    {
+        return;
+    }
+
+    unsigned int const vertexBytes = static_cast<unsigned int>(layer.verts.size() * sizeof(Vertex_PCU));
+    layer.vertexBuffer             = m_renderer->CreateVertexBuffer(vertexBytes, sizeof(Vertex_PCU));
+    m_renderer->CopyCPUToGPU(layer.verts.data(), vertexBytes, layer.vertexBuffer);
+    layer.uploadedVerts = static_cast<uint32_t>(layer.verts.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugLayerRenderer::Release(sLayer& layer)
+{
+    delete layer.vertexBuffer;
+    layer.vertexBuffer  = nullptr;
+    layer.uploadedVerts = 0;
+}
@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------------------------------
+// DebugLayerRenderer.hpp
+// Batched one-frame debug lines/points and retained, GPU-resident debug layers (debug_render.add_batch)
+//
+// Purpose:
+//   Every debug_render.add_world_line/point is its own GenericCommand and its own DebugAdd* object,
+//   so a path visualization drawing 2,000 segments per frame floods both the command queue and the
+//   debug renderer. debug_render.add_batch carries packed arrays instead: its one-frame lines and
+//   points are appended to a vertex list here and drawn in one call. A named layer keeps its
+//   geometry in a vertex buffer uploaded once (and again only after an edit), so a static overlay
+//   costs one draw per frame and no commands at all.
+//
+// Design:
+//   - A line is a 4-sided prism and a point an octahedron (24 vertices each), colors baked into the
+//     vertices; at debug radii they read the same as the debug renderer's cylinders and spheres at a
+//     fraction of the vertices
+//   - Layers are keyed by id and drawn in id order; hiding a layer keeps its buffer, clearing it
+//     releases the buffer. SetVisible(false) (debug_render.set_hidden) hides everything drawn here
+//   - Drawn with the world camera after entities under the renderer's default depth-tested state;
+//     other debug render modes stay on the DebugAdd* path
+//
+// Thread Safety Model:
+//   - Main thread only (GenericCommand handlers and App::Render())
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class Camera;
+class Renderer;
+class VertexBuffer;
+
+//----------------------------------------------------------------------------------------------------
+uint32_t constexpr DEBUG_LINE_VERTS  = 24;
+uint32_t constexpr DEBUG_POINT_VERTS = 24;
+
+void AppendDebugLineVerts(VertexList_PCU& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color);
+void AppendDebugPointVerts(VertexList_PCU& verts, Vec3 const& center, float radius, Rgba8 const& color);
+
+//----------------------------------------------------------------------------------------------------
+struct sDebugLayerInfo
+{
+    String   id;
+    bool     isVisible   = true;
+    uint32_t vertexCount = 0;
+    size_t   gpuBytes    = 0;     // 0 until the first Render() after an edit
+};
+
+//----------------------------------------------------------------------------------------------------
+class DebugLayerRenderer
+{
+public:
+    // Largest frame-batch vertex array per draw; bigger batches are split into several draws
+    static uint32_t constexpr MAX_FRAME_VERTS = 65536;
+
+    explicit DebugLayerRenderer(Renderer* renderer);
+    ~DebugLayerRenderer();
+
+    DebugLayerRenderer(DebugLayerRenderer const&)            = delete;
+    DebugLayerRenderer& operator=(DebugLayerRenderer const&) = delete;
+
+    // This frame's batched geometry (dropped by Render())
+    VertexList_PCU& GetFrameVerts() { return m_frameVerts; }
+
+    // Replace (or append to) a layer's geometry, creating it visible; uploaded on the next Render().
+    // Returns the layer's vertex count.
+    uint32_t SetLayerGeometry(String const& layerId, VertexList_PCU const& verts, bool isAppend);
+
+    // false if the layer does not exist
+    bool SetLayerVisible(String const& layerId, bool isVisible);
+    bool ClearLayer(String const& layerId);
+    void ClearAllLayers();
+
+    std::vector<sDebugLayerInfo> GetLayerInfos() const;
+
+    void SetVisible(bool const isVisible) { m_isVisible = isVisible; }
+
+    // Draw visible layers, then this frame's batch, with the world camera (nullptr = draw nothing);
+    // the frame batch is dropped either way. Returns the draw calls issued.
+    uint32_t Render(Camera const* worldCamera);
+
+private:
+    struct sLayer
+    {
+        VertexList_PCU verts;
+        VertexBuffer*  vertexBuffer  = nullptr;
+        uint32_t       uploadedVerts = 0;
+        bool           isVisible     = true;
+        bool           isDirty       = true;     // verts changed since the last upload
+    };
+
+    void Upload(sLayer& layer);
+    void Release(sLayer& layer);
+
+    Renderer*                m_renderer  = nullptr;
+    std::map<String, sLayer> m_layers;
+    VertexList_PCU           m_frameVerts;               // Keeps its capacity across frames
+    bool                     m_isVisible = true;
+};
@@ -0,0 +1,276 @@
+//----------------------------------------------------------------------------------------------------
+// EntityBatchRenderer.cpp
+// Cached merged vertex buffers for static primitive entities that share a texture
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/EntityBatchRenderer.hpp"
+
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Framework/EntityStore.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    unsigned char ModulateChannel(unsigned char const a, unsigned char const b)
+    {
+        return static_cast<unsigned char>((static_cast<uint32_t>(a) * static_cast<uint32_t>(b) + 127u) / 255u);
+    }
+
+    Rgba8 ModulateColor(Rgba8 const& a, Rgba8 const& b)
+    {
+        return Rgba8(ModulateChannel(a.r, b.r), ModulateChannel(a.g, b.g), ModulateChannel(a.b, b.b), ModulateChannel(a.a, b.a));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+EntityBatchRenderer::~EntityBatchRenderer()
+{
+    ReleaseAll();
+}
+
+//----------------------------------------------------------------------------------------------------
+// BeginFrame
+//
+// Validation is one version compare per batched entity; no vertices are touched unless a batch is
+// rebuilt in Flush().
+//----------------------------------------------------------------------------------------------------
+void EntityBatchRenderer::BeginFrame(EntityStore const& store, uint64_t const frameNumber)
+{
+    m_frameNumber = frameNumber;
+    m_candidates.clear();
+
+    uint32_t const slotCount = store.GetSlotCount();
+    if (m_slotStates.size() < slotCount)
+    {
+        m_slotStates.resize(slotCount);
+    }
+
+    for (uint32_t batchIndex = 0; batchIndex < static_cast<uint32_t>(m_batches.size()); ++batchIndex)
+    {
+        sStaticBatch const& batch = m_batches[batchIndex];
+        if (!batch.vertexBuffer) continue;
+
+        for (sBatchMember const& member : batch.members)
+        {
+            if (member.slot >= slotCount || store.GetSlotVersion(member.slot) != member.version)
+            {
+                ReleaseBatch(batchIndex);
+                ++m_invalidationCount;
+                break;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool EntityBatchRenderer::IsBatched(uint32_t const slot) const
+{
+    return slot < m_slotStates.size() && m_slotStates[slot].batchIndex != INVALID_BATCH;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityBatchRenderer::Offer(uint32_t const          slot,
+                                uint64_t const          slotVersion,
+                                MeshHandle const        meshHandle,
+                                sMeshHandleEntry const& mesh,
+                                uint64_t const          textureId,
+                                Mat44 const&            modelMatrix,
+                                Rgba8 const&            tint)
+{
+    if (slot >= m_slotStates.size())
+    {
+        return;
+    }
+
+    sSlotState& state = m_slotStates[slot];
+    if (state.version != slotVersion)
+    {
+        state.version          = slotVersion;
+        state.stableSinceFrame = m_frameNumber;
+        return;
+    }
+
+    if (m_frameNumber - state.stableSinceFrame < STATIC_FRAMES)
+    {
+        return;
+    }
+
+    sCandidate candidate;
+    candidate.slot        = slot;
+    candidate.version     = slotVersion;
+    candidate.textureId   = textureId;
+    candidate.meshHandle  = meshHandle;
+    candidate.verts       = mesh.primitive;
+    candidate.modelMatrix = modelMatrix;
+    candidate.tint        = tint;
+    m_candidates.push_back(candidate);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t EntityBatchRenderer::Flush(Renderer& renderer)
+{
+    uint32_t drawCalls = 0;
+
+    if (m_batchCount > 0)
+    {
+        // Per-entity transform and tint are baked into the vertices
+        renderer.SetModelConstants(Mat44(), Rgba8::WHITE);
+
+        for (sStaticBatch const& batch : m_batches)
+        {
+            if (!batch.vertexBuffer) continue;
+
+            Texture* tex = (batch.textureId != 0) ? reinterpret_cast<Texture*>(batch.textureId) : nullptr;
+            renderer.BindTexture(tex);
+            renderer.DrawVertexBuffer(batch.vertexBuffer, batch.vertexCount);
+            ++drawCalls;
+        }
+    }
+
+    m_lastBatchedEntities = m_batchedEntities;
+
+    if (!m_candidates.empty())
+    {
+        BuildBatches(renderer);
+        m_candidates.clear();
+    }
+
+    return drawCalls;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityBatchRenderer::ReleaseAll()
+{
+    for (uint32_t batchIndex = 0; batchIndex < static_cast<uint32_t>(m_batches.size()); ++batchIndex)
+    {
+        if (m_batches[batchIndex].vertexBuffer)
+        {
+            ReleaseBatch(batchIndex);
+        }
+    }
+    m_candidates.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// BuildBatches
+//
+// Candidates are sorted so each batch holds one texture and identical meshes sit next to each other;
+// a texture group is cut into MAX_BATCH_VERTS chunks, and chunks under MIN_BATCH_ENTITIES are left
+// on the per-entity path.
+//----------------------------------------------------------------------------------------------------
+void EntityBatchRenderer::BuildBatches(Renderer& renderer)
+{
+    std::sort(m_candidates.begin(), m_candidates.end(),
+              [](sCandidate const& a, sCandidate const& b)
+              {
+                  if (a.textureId != b.textureId) return a.textureId < b.textureId;
+                  return a.meshHandle < b.meshHandle;
+              });
+
+    size_t firstCandidate = 0;
+    size_t chunkVerts     = 0;
+
+    for (size_t index = 0; index < m_candidates.size(); ++index)
+    {
+        sCandidate const& candidate      = m_candidates[index];
+        bool const        textureChanged = candidate.textureId != m_candidates[firstCandidate].textureId;
+        bool const        batchFull      = chunkVerts + candidate.verts->size() > MAX_BATCH_VERTS;
+
+        if ((textureChanged || batchFull) && index > firstCandidate)
+        {
+            BuildBatch(renderer, firstCandidate, index);
+            firstCandidate = index;
+            chunkVerts     = 0;
+        }
+        chunkVerts += candidate.verts->size();
+    }
+
+    BuildBatch(renderer, firstCandidate, m_candidates.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityBatchRenderer::BuildBatch(Renderer& renderer, size_t const firstCandidate, size_t const endCandidate)
+{
+    if (endCandidate - firstCandidate < MIN_BATCH_ENTITIES)
+    {
+        return;
+    }
+
+    m_mergedVerts.clear();
+    for (size_t index = firstCandidate; index < endCandidate; ++index)
+    {
+        sCandidate const& candidate = m_candidates[index];
+        for (Vertex_PCU const& vert : *candidate.verts)
+        {
+            m_mergedVerts.emplace_back(candidate.modelMatrix.TransformPosition3D(vert.m_position),
+                                       ModulateColor(vert.m_color, candidate.tint),
+                                       vert.m_uvTexCoords);
+        }
+    }
+
+    unsigned int const vertexBytes  = static_cast<unsigned int>(m_mergedVerts.size() * sizeof(Vertex_PCU));
+    VertexBuffer*      vertexBuffer = renderer.CreateVertexBuffer(vertexBytes, sizeof(Vertex_PCU));
+    if (!vertexBuffer)
+    {
+        // Keep drawing these per entity and retry once they have been stable for another STATIC_FRAMES
+        for (size_t index = firstCandidate; index < endCandidate; ++index)
+        {
+            m_slotStates[m_candidates[index].slot].stableSinceFrame = m_frameNumber;
+        }
+        return;
+    }
+    renderer.CopyCPUToGPU(m_mergedVerts.data(), vertexBytes, vertexBuffer);
+
+    uint32_t batchIndex;
+    if (!m_freeBatches.empty())
+    {
+        batchIndex = m_freeBatches.back();
+        m_freeBatches.pop_back();
+    }
+    else
+    {
+        batchIndex = static_cast<uint32_t>(m_batches.size());
+        m_batches.emplace_back();
+    }
+
+    sStaticBatch& batch = m_batches[batchIndex];
+    batch.vertexBuffer  = vertexBuffer;
+    batch.vertexCount   = static_cast<uint32_t>(m_mergedVerts.size());
+    batch.textureId     = m_candidates[firstCandidate].textureId;
+    batch.members.clear();
+
+    for (size_t index = firstCandidate; index < endCandidate; ++index)
+    {
+        sCandidate const& candidate = m_candidates[index];
+        batch.members.push_back({candidate.slot, candidate.version});
+        m_slotStates[candidate.slot].batchIndex = batchIndex;
+    }
+
+    ++m_batchCount;
+    ++m_buildCount;
+    m_batchedEntities += static_cast<uint32_t>(batch.members.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityBatchRenderer::ReleaseBatch(uint32_t const batchIndex)
+{
+    sStaticBatch& batch = m_batches[batchIndex];
+
+    delete batch.vertexBuffer;
+    batch.vertexBuffer = nullptr;
+    batch.vertexCount  = 0;
+
+    for (sBatchMember const& member : batch.members)
+    {
+        m_slotStates[member.slot].batchIndex = INVALID_BATCH;
+    }
+    m_batchedEntities -= static_cast<uint32_t>(batch.members.size());
+    batch.members.clear();
+
+    --m_batchCount;
+    m_freeBatches.push_back(batchIndex);
+}
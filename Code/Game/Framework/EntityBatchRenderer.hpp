@@ -0,0 +1,131 @@
+//----------------------------------------------------------------------------------------------------
+// EntityBatchRenderer.hpp
+// Cached merged vertex buffers for static primitive entities that share a texture
+//
+// Purpose:
+//   RenderEntities() issues SetModelConstants + BindTexture + Draw per entity from the resident
+//   GpuMeshCache buffers. Scenery that never moves still pays that per frame, so primitive entities
+//   whose EntityStore slot version has not changed for STATIC_FRAMES frames are pre-transformed once
+//   into an immutable per-texture vertex buffer and drawn with identity model constants — one draw
+//   per batch until a member changes.
+//
+// Dirty keying:
+//   - Each batch records its members' slot versions; BeginFrame() compares them with the store (no
+//     vertex work) and releases any batch with a moved, recoloured, re-meshed or destroyed member
+//   - Released members return to the per-entity path and rejoin a rebuilt batch once stable again,
+//     so moving entities never go through the CPU transform and never stream vertices per frame
+//   - A batch is built only from entities offered this frame (visible), but is drawn whole while
+//     valid; members that leave the frustum are clipped by the GPU
+//
+// Notes:
+//   - Out of scope: true GPU instancing. The Renderer exposes no instance-buffer / per-instance input
+//     layout API, so changing entities keep the per-entity resident-buffer draw
+//   - OBJ models (PCUTBN, indexed) always draw per entity so normals stay in model space for lighting
+//   - Scratch vectors keep their capacity across frames; a steady scene does not allocate or upload
+//
+// Thread Safety Model:
+//   - Main thread only (RenderEntities() and App::Shutdown())
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/Mat44.hpp"
+#include "Game/Framework/MeshHandleTable.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class EntityStore;
+class Renderer;
+class VertexBuffer;
+
+//----------------------------------------------------------------------------------------------------
+class EntityBatchRenderer
+{
+public:
+    static uint32_t constexpr MAX_BATCH_VERTS    = 65536;     // Vertices per cached batch buffer
+    static uint32_t constexpr MIN_BATCH_ENTITIES = 8;         // Smaller static groups stay per entity
+    static uint64_t constexpr STATIC_FRAMES      = 60;        // Unchanged frames before an entity is batched
+
+    EntityBatchRenderer() = default;
+    ~EntityBatchRenderer();
+
+    EntityBatchRenderer(EntityBatchRenderer const&)            = delete;
+    EntityBatchRenderer& operator=(EntityBatchRenderer const&) = delete;
+
+    // Once per frame before the render loop: release batches whose members changed since they were built
+    void BeginFrame(EntityStore const& store, uint64_t frameNumber);
+
+    // True when the slot is drawn by a cached batch this frame (skip its per-entity draw)
+    bool IsBatched(uint32_t slot) const;
+
+    // Report a primitive entity drawn per entity this frame (mesh must be a resolved, non-model entry).
+    // Once its slot version has been stable for STATIC_FRAMES it becomes a batch candidate.
+    void Offer(uint32_t slot, uint64_t slotVersion, MeshHandle meshHandle, sMeshHandleEntry const& mesh,
+               uint64_t textureId, Mat44 const& modelMatrix, Rgba8 const& tint);
+
+    // Draw the cached batches, then build new ones from this frame's candidates (drawn from the next
+    // frame on; the candidates were already drawn per entity). Returns the draw call count.
+    // Requires the world camera to be active (call between BeginCamera and EndCamera).
+    uint32_t Flush(Renderer& renderer);
+
+    void ReleaseAll();
+
+    uint32_t GetLastBatchedEntities() const { return m_lastBatchedEntities; }
+    uint32_t GetBatchCount() const { return m_batchCount; }
+    uint64_t GetBuildCount() const { return m_buildCount; }
+    uint64_t GetInvalidationCount() const { return m_invalidationCount; }
+
+private:
+    static uint32_t constexpr INVALID_BATCH = 0xFFFFFFFFu;
+
+    struct sSlotState
+    {
+        uint64_t version          = 0;
+        uint64_t stableSinceFrame = 0;
+        uint32_t batchIndex       = INVALID_BATCH;
+    };
+
+    struct sCandidate
+    {
+        uint32_t              slot       = 0;
+        uint64_t              version    = 0;
+        uint64_t              textureId  = 0;
+        MeshHandle            meshHandle = INVALID_MESH_HANDLE;
+        VertexList_PCU const* verts      = nullptr;
+        Mat44                 modelMatrix;
+        Rgba8                 tint;
+    };
+
+    struct sBatchMember
+    {
+        uint32_t slot    = 0;
+        uint64_t version = 0;
+    };
+
+    struct sStaticBatch
+    {
+        VertexBuffer*             vertexBuffer = nullptr;     // nullptr = free entry
+        uint32_t                  vertexCount  = 0;
+        uint64_t                  textureId    = 0;
+        std::vector<sBatchMember> members;
+    };
+
+    void BuildBatches(Renderer& renderer);
+    void BuildBatch(Renderer& renderer, size_t firstCandidate, size_t endCandidate);
+    void ReleaseBatch(uint32_t batchIndex);
+
+    std::vector<sSlotState>   m_slotStates;               // Indexed by EntityStore slot
+    std::vector<sCandidate>   m_candidates;
+    std::vector<sStaticBatch> m_batches;
+    std::vector<uint32_t>     m_freeBatches;
+    VertexList_PCU            m_mergedVerts;
+    uint64_t                  m_frameNumber         = 0;
+    uint32_t                  m_batchCount          = 0;
+    uint32_t                  m_batchedEntities     = 0;     // Members of all cached batches
+    uint32_t                  m_lastBatchedEntities = 0;
+    uint64_t                  m_buildCount          = 0;
+    uint64_t                  m_invalidationCount   = 0;
+};
@@ -0,0 +1,236 @@
+//----------------------------------------------------------------------------------------------------
+// EntitySnapshot.cpp
+// Versioned, paginated entity snapshots for game.get_entity_list (JSON or compact binary)
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/EntitySnapshot.hpp"
+
+#include "Engine/Network/KADIAuthenticationUtility.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+//----------------------------------------------------------------------------------------------------
+static String EscapeJson(String const& text)
+{
+    String escaped;
+    escaped.reserve(text.size());
+    for (char const c : text)
+    {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+    }
+    return escaped;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+static void AppendBytes(std::vector<unsigned char>& out, T const& value)
+{
+    size_t const offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+//----------------------------------------------------------------------------------------------------
+static void AppendString(std::vector<unsigned char>& out, String const& text)
+{
+    uint16_t const length = static_cast<uint16_t>(std::min<size_t>(text.size(), 0xFFFFu));
+    AppendBytes(out, length);
+    out.insert(out.end(), text.begin(), text.begin() + length);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t ParseEntityFieldName(String const& name)
+{
+    if (name == "position") return ENTITY_FIELD_POSITION;
+    if (name == "orientation") return ENTITY_FIELD_ORIENTATION;
+    if (name == "scale") return ENTITY_FIELD_SCALE;
+    if (name == "color") return ENTITY_FIELD_COLOR;
+    if (name == "type") return ENTITY_FIELD_TYPE;
+    if (name == "cameraType") return ENTITY_FIELD_CAMERA_TYPE;
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+String FormatEntityChangeCursor(sEntityChangeCursor const& cursor)
+{
+    return Stringf("%llu.%u", cursor.version, cursor.slot);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ParseEntityChangeCursor(String const& text, sEntityChangeCursor& outCursor)
+{
+    unsigned long long version = 0;
+    unsigned int       slot    = 0;
+    char               tail    = 0;
+    if (std::sscanf(text.c_str(), "%llu.%u%c", &version, &slot, &tail) != 2)
+    {
+        return false;
+    }
+
+    outCursor.version = version;
+    outCursor.slot    = slot;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void CollectEntitySnapshotPage(EntityStore const& store, uint64_t const sinceVersion, sEntityChangeCursor const& cursor,
+                               uint32_t const limit, sEntitySnapshotPage& outPage)
+{
+    outPage.version      = store.GetVersion();
+    outPage.sinceVersion = sinceVersion;
+    outPage.changes.clear();
+
+    if (!store.CollectChanges(sinceVersion, cursor, limit, outPage.changes, outPage.hasMore))
+    {
+        outPage.sinceVersion = 0;
+        store.CollectChanges(0, sEntityChangeCursor(), limit, outPage.changes, outPage.hasMore);
+    }
+
+    outPage.isFullSnapshot = outPage.sinceVersion == 0;
+    if (outPage.hasMore && !outPage.changes.empty())
+    {
+        outPage.nextCursor.version = outPage.changes.back().version;
+        outPage.nextCursor.slot    = outPage.changes.back().slot;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// WriteEntitySnapshotJson
+//
+// JSON entities keep the pre-versioning object layout (plus "version"), minus unrequested fields.
+//----------------------------------------------------------------------------------------------------
+String WriteEntitySnapshotJson(EntityStore const& store, sEntitySnapshotPage const& page, uint32_t const fieldMask, bool const isBinary)
+{
+    sEntityArrays const& front = store.GetFront();
+
+    uint32_t removedCount = 0;
+    for (sEntityChange const& change : page.changes)
+    {
+        removedCount += change.isRemoved ? 1 : 0;
+    }
+    uint32_t const entityCount = static_cast<uint32_t>(page.changes.size()) - removedCount;
+
+    std::ostringstream resultJson;
+    resultJson << R"({"success":true,"version":)" << page.version
+               << R"(,"sinceVersion":)" << page.sinceVersion
+               << R"(,"isFullSnapshot":)" << (page.isFullSnapshot ? "true" : "false")
+               << R"(,"hasMore":)" << (page.hasMore ? "true" : "false");
+    if (page.hasMore)
+    {
+        resultJson << R"(,"cursor":")" << FormatEntityChangeCursor(page.nextCursor) << R"(")";
+    }
+    resultJson << R"(,"count":)" << entityCount << R"(,"removedCount":)" << removedCount;
+
+    if (isBinary)
+    {
+        std::vector<unsigned char> data;
+        data.reserve(12 + removedCount * 8 + entityCount * 64);
+        AppendBytes(data, fieldMask);
+        AppendBytes(data, entityCount);
+        AppendBytes(data, removedCount);
+
+        for (sEntityChange const& change : page.changes)
+        {
+            if (change.isRemoved) AppendBytes(data, static_cast<uint64_t>(change.entityId));
+        }
+        for (sEntityChange const& change : page.changes)
+        {
+            if (change.isRemoved) continue;
+
+            uint32_t const slot = change.slot;
+            AppendBytes(data, static_cast<uint64_t>(change.entityId));
+            AppendBytes(data, change.version);
+            if (fieldMask & ENTITY_FIELD_POSITION)
+            {
+                AppendBytes(data, front.positions[slot].x);
+                AppendBytes(data, front.positions[slot].y);
+                AppendBytes(data, front.positions[slot].z);
+            }
+            if (fieldMask & ENTITY_FIELD_ORIENTATION)
+            {
+                AppendBytes(data, front.orientations[slot].m_yawDegrees);
+                AppendBytes(data, front.orientations[slot].m_pitchDegrees);
+                AppendBytes(data, front.orientations[slot].m_rollDegrees);
+            }
+            if (fieldMask & ENTITY_FIELD_SCALE)
+            {
+                AppendBytes(data, front.radii[slot]);
+            }
+            if (fieldMask & ENTITY_FIELD_COLOR)
+            {
+                Rgba8 const& color = front.colors[slot];
+                AppendBytes(data, static_cast<uint32_t>(color.r) | (static_cast<uint32_t>(color.g) << 8) |
+                                  (static_cast<uint32_t>(color.b) << 16) | (static_cast<uint32_t>(color.a) << 24));
+            }
+            if (fieldMask & ENTITY_FIELD_TYPE)
+            {
+                AppendString(data, front.meshTypes[slot]);
+            }
+            if (fieldMask & ENTITY_FIELD_CAMERA_TYPE)
+            {
+                AppendString(data, front.cameraTypes[slot]);
+            }
+        }
+
+        resultJson << R"(,"encoding":"binary","fieldMask":)" << fieldMask
+                   << R"(,"data":")" << KADIAuthenticationUtility::Base64Encode(data) << R"("})";
+        return resultJson.str();
+    }
+
+    resultJson << R"(,"entities":[)";
+    bool isFirst = true;
+    for (sEntityChange const& change : page.changes)
+    {
+        if (change.isRemoved) continue;
+
+        uint32_t const slot = change.slot;
+        resultJson << (isFirst ? "" : ",") << R"({"entityId":)" << change.entityId << R"(,"version":)" << change.version;
+        isFirst = false;
+
+        if (fieldMask & ENTITY_FIELD_TYPE)
+        {
+            resultJson << R"(,"type":")" << EscapeJson(front.meshTypes[slot]) << R"(")";
+        }
+        if (fieldMask & ENTITY_FIELD_POSITION)
+        {
+            Vec3 const& position = front.positions[slot];
+            resultJson << R"(,"position":[)" << position.x << "," << position.y << "," << position.z << "]";
+        }
+        if (fieldMask & ENTITY_FIELD_ORIENTATION)
+        {
+            EulerAngles const& orientation = front.orientations[slot];
+            resultJson << R"(,"orientation":[)"
+                       << orientation.m_yawDegrees << "," << orientation.m_pitchDegrees << "," << orientation.m_rollDegrees << "]";
+        }
+        if (fieldMask & ENTITY_FIELD_SCALE)
+        {
+            resultJson << R"(,"scale":)" << front.radii[slot];
+        }
+        if (fieldMask & ENTITY_FIELD_COLOR)
+        {
+            Rgba8 const& color = front.colors[slot];
+            resultJson << R"(,"color":[)" << (int)color.r << "," << (int)color.g << "," << (int)color.b << "," << (int)color.a << "]";
+        }
+        if (fieldMask & ENTITY_FIELD_CAMERA_TYPE)
+        {
+            resultJson << R"(,"cameraType":")" << EscapeJson(front.cameraTypes[slot]) << R"(")";
+        }
+        resultJson << "}";
+    }
+
+    resultJson << R"(],"removed":[)";
+    isFirst = true;
+    for (sEntityChange const& change : page.changes)
+    {
+        if (!change.isRemoved) continue;
+
+        resultJson << (isFirst ? "" : ",") << change.entityId;
+        isFirst = false;
+    }
+    resultJson << "]}";
+    return resultJson.str();
+}
@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------------------------------------
+// EntitySnapshot.hpp
+// Versioned, paginated entity snapshots for game.get_entity_list (JSON or compact binary)
+//
+// Purpose:
+//   game.get_entity_list used to serialize the whole front buffer on every poll, capped at 1000
+//   entities. Agents poll it repeatedly, so a page is now built from EntityStore::CollectChanges():
+//   only entities changed (or removed) since the caller's last version, in pages of `limit`, and
+//   only the requested fields.
+//
+// Design:
+//   - Protocol: request with sinceVersion 0 for a full snapshot, keep fetching with the returned
+//     cursor while hasMore, then poll with sinceVersion = the last page's version. When the store
+//     can no longer answer a delta (sinceVersion too old or unknown) the page is a full snapshot
+//     with isFullSnapshot true: drop the local mirror and rebuild it. Apply removed before entities
+//   - Binary encoding (little-endian, base64 in the result's "data" field):
+//       uint32 fieldMask, uint32 entityCount, uint32 removedCount
+//       removedCount x uint64 entityId
+//       entityCount  x { uint64 entityId, uint64 version, then each field in fieldMask in bit order:
+//                        POSITION 3 x f32 | ORIENTATION 3 x f32 (yaw, pitch, roll) | SCALE f32 |
+//                        COLOR u32 (r | g << 8 | b << 16 | a << 24) |
+//                        TYPE u16 length + bytes | CAMERA_TYPE u16 length + bytes }
+//
+// Thread Safety Model:
+//   - Main thread only (reads the EntityStore front buffer)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Framework/EntityStore.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Field mask bits ("fields" names in parentheses); entityId and version are always included
+//----------------------------------------------------------------------------------------------------
+uint32_t constexpr ENTITY_FIELD_POSITION    = 1u << 0;     // "position"
+uint32_t constexpr ENTITY_FIELD_ORIENTATION = 1u << 1;     // "orientation"
+uint32_t constexpr ENTITY_FIELD_SCALE       = 1u << 2;     // "scale"
+uint32_t constexpr ENTITY_FIELD_COLOR       = 1u << 3;     // "color"
+uint32_t constexpr ENTITY_FIELD_TYPE        = 1u << 4;     // "type"
+uint32_t constexpr ENTITY_FIELD_CAMERA_TYPE = 1u << 5;     // "cameraType"
+uint32_t constexpr ENTITY_FIELD_ALL         = 0x3Fu;
+
+// 0 = unknown name
+uint32_t ParseEntityFieldName(String const& name);
+
+// Opaque to callers: "<version>.<slot>" of the last change on the previous page
+String FormatEntityChangeCursor(sEntityChangeCursor const& cursor);
+bool   ParseEntityChangeCursor(String const& text, sEntityChangeCursor& outCursor);
+
+//----------------------------------------------------------------------------------------------------
+struct sEntitySnapshotPage
+{
+    uint64_t                   version        = 0;         // Store version the page was read at
+    uint64_t                   sinceVersion   = 0;         // As answered (0 after a forced resync)
+    bool                       isFullSnapshot = false;
+    bool                       hasMore        = false;
+    sEntityChangeCursor        nextCursor;                 // Valid when hasMore
+    std::vector<sEntityChange> changes;
+};
+
+// Falls back to a full snapshot (cursor ignored) when the store cannot answer sinceVersion
+void CollectEntitySnapshotPage(EntityStore const& store, uint64_t sinceVersion, sEntityChangeCursor const& cursor,
+                               uint32_t limit, sEntitySnapshotPage& outPage);
+
+// The handler's resultJson; isBinary puts entities and removals in base64 "data"
+String WriteEntitySnapshotJson(EntityStore const& store, sEntitySnapshotPage const& page, uint32_t fieldMask, bool isBinary);
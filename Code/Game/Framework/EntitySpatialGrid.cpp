@@ -0,0 +1,561 @@
+//----------------------------------------------------------------------------------------------------
+// EntitySpatialGrid.cpp
+// Uniform hash grid over entity bounding spheres (front buffer), plus view-frustum sphere tests
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/EntitySpatialGrid.hpp"
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    int constexpr CELL_COORD_BIAS = 1 << 20;     // 21 bits per axis in the packed key
+
+    uint64_t PackCellKey(int const x, int const y, int const z)
+    {
+        uint64_t const ux = static_cast<uint64_t>(x + CELL_COORD_BIAS) & 0x1FFFFFull;
+        uint64_t const uy = static_cast<uint64_t>(y + CELL_COORD_BIAS) & 0x1FFFFFull;
+        uint64_t const uz = static_cast<uint64_t>(z + CELL_COORD_BIAS) & 0x1FFFFFull;
+        return (ux << 42) | (uy << 21) | uz;
+    }
+
+    // Distance along the ray to the first intersection with the sphere (0 when the origin is inside)
+    bool RaycastSphere(Vec3 const& origin, Vec3 const& direction, Vec3 const& center, float radius, float& out_distance)
+    {
+        Vec3 const  toCenter      = center - origin;
+        float const alongRay      = DotProduct3D(toCenter, direction);
+        float const distSquared   = toCenter.GetLengthSquared();
+        float const radiusSquared = radius * radius;
+
+        if (distSquared <= radiusSquared)
+        {
+            out_distance = 0.f;
+            return true;
+        }
+
+        if (alongRay < 0.f)
+        {
+            return false;
+        }
+
+        float const perpSquared = distSquared - alongRay * alongRay;
+        if (perpSquared > radiusSquared)
+        {
+            return false;
+        }
+
+        out_distance = alongRay - std::sqrt(radiusSquared - perpSquared);
+        return true;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sViewFrustum sViewFrustum::MakePerspective(Vec3 const&        position,
+                                           EulerAngles const& orientation,
+                                           float const        fovDegrees,
+                                           float const        aspect,
+                                           float const        nearDistance,
+                                           float const        farDistance)
+{
+    Mat44 const basis = orientation.GetAsMatrix_IFwd_JLeft_KUp();
+
+    sViewFrustum frustum;
+    frustum.position     = position;
+    frustum.forward      = basis.GetIBasis3D();
+    frustum.left         = basis.GetJBasis3D();
+    frustum.up           = basis.GetKBasis3D();
+    frustum.tanHalfFovV  = std::tan(fovDegrees * 0.5f * (3.14159265f / 180.f));
+    frustum.tanHalfFovH  = frustum.tanHalfFovV * aspect;
+    frustum.secHalfFovV  = std::sqrt(1.f + frustum.tanHalfFovV * frustum.tanHalfFovV);
+    frustum.secHalfFovH  = std::sqrt(1.f + frustum.tanHalfFovH * frustum.tanHalfFovH);
+    frustum.nearDistance = nearDistance;
+    frustum.farDistance  = farDistance;
+    return frustum;
+}
+
+//----------------------------------------------------------------------------------------------------
+// IsSphereVisible
+//
+// Works in camera space: each side plane passes through the eye, so the signed distance from the
+// sphere center to e.g. the top plane is (up - forward * tanHalfFovV) / secHalfFovV.
+//----------------------------------------------------------------------------------------------------
+bool sViewFrustum::IsSphereVisible(Vec3 const& center, float const radius) const
+{
+    Vec3 const  toCenter = center - position;
+    float const depth    = DotProduct3D(toCenter, forward);
+
+    if (depth + radius < nearDistance || depth - radius > farDistance)
+    {
+        return false;
+    }
+
+    float const side   = std::fabs(DotProduct3D(toCenter, left));
+    float const height = std::fabs(DotProduct3D(toCenter, up));
+
+    if (side - depth * tanHalfFovH > radius * secHalfFovH)
+    {
+        return false;
+    }
+
+    return height - depth * tanHalfFovV <= radius * secHalfFovV;
+}
+
+//----------------------------------------------------------------------------------------------------
+EntitySpatialGrid::EntitySpatialGrid(float const cellSize)
+    : m_cellSize(cellSize > 0.f ? cellSize : 16.f)
+{
+    m_cellHalfDiagonal = m_cellSize * 0.5f * std::sqrt(3.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntitySpatialGrid::Update(uint32_t const slot, Vec3 const& center, float const boundRadius, bool const isActive)
+{
+    if (slot >= m_slotEntries.size())
+    {
+        m_slotEntries.resize(slot + 1);
+    }
+
+    if (!isActive)
+    {
+        RemoveFromCell(slot);
+        return;
+    }
+
+    int const x = static_cast<int>(std::floor(center.x / m_cellSize));
+    int const y = static_cast<int>(std::floor(center.y / m_cellSize));
+    int const z = static_cast<int>(std::floor(center.z / m_cellSize));
+
+    sSlotEntry& entry = m_slotEntries[slot];
+    if (entry.cellIndex != 0xFFFFFFFFu)
+    {
+        sCell const& current = m_cells[entry.cellIndex];
+        if (current.x != x || current.y != y || current.z != z)
+        {
+            RemoveFromCell(slot);
+        }
+    }
+
+    if (entry.cellIndex == 0xFFFFFFFFu)
+    {
+        uint32_t const cellIndex = GetOrCreateCell(x, y, z);
+        sCell&         cell      = m_cells[cellIndex];
+        entry.cellIndex          = cellIndex;
+        entry.indexInCell        = static_cast<uint32_t>(cell.slots.size());
+        cell.slots.push_back(slot);
+        ++m_entryCount;
+    }
+
+    entry.center      = center;
+    entry.boundRadius = boundRadius;
+
+    sCell& cell = m_cells[entry.cellIndex];
+    if (boundRadius > cell.maxBoundRadius)
+    {
+        cell.maxBoundRadius = boundRadius;
+    }
+    if (boundRadius > m_maxBoundRadius)
+    {
+        m_maxBoundRadius = boundRadius;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// QueryFrustum
+//
+// Walks the cells of the bounding box of the frustum with every plane pushed out by m_maxBoundRadius
+// (IsSphereVisible() accepts any sphere within its radius of each plane, corners included). Each
+// cell is tested against the frustum before it is looked up, so only reachable cells cost a lookup.
+//----------------------------------------------------------------------------------------------------
+void EntitySpatialGrid::QueryFrustum(sViewFrustum const& frustum, std::vector<uint32_t>& out_slots) const
+{
+    out_slots.clear();
+    if (m_entryCount == 0)
+    {
+        return;
+    }
+
+    // Cross-section half extents are linear in depth, so the box is spanned by the two end sections
+    // (a negative extent near the pushed-out apex only widens the box, which stays conservative)
+    float const reach = m_maxBoundRadius;
+    Vec3        mins  = frustum.position;
+    Vec3        maxs  = frustum.position;
+    for (float const depth : {frustum.nearDistance - reach, frustum.farDistance + reach})
+    {
+        Vec3 const  planeCenter = frustum.position + frustum.forward * depth;
+        float const halfWidth   = std::fabs(depth * frustum.tanHalfFovH + reach * frustum.secHalfFovH);
+        float const halfHeight  = std::fabs(depth * frustum.tanHalfFovV + reach * frustum.secHalfFovV);
+        for (float const sideSign : {-1.f, 1.f})
+        {
+            for (float const upSign : {-1.f, 1.f})
+            {
+                Vec3 const corner = planeCenter + frustum.left * (sideSign * halfWidth) + frustum.up * (upSign * halfHeight);
+                mins = Vec3(std::min(mins.x, corner.x), std::min(mins.y, corner.y), std::min(mins.z, corner.z));
+                maxs = Vec3(std::max(maxs.x, corner.x), std::max(maxs.y, corner.y), std::max(maxs.z, corner.z));
+            }
+        }
+    }
+
+    sCellRange range;
+    if (!GetCellRange(mins, maxs, 0.f, range))
+    {
+        for (sCell const& cell : m_cells)
+        {
+            if (!cell.slots.empty()) CollectFrustumCell(cell, frustum, out_slots);
+        }
+        return;
+    }
+
+    float const cellReach = m_cellHalfDiagonal + reach;
+    for (int z = range.minZ; z <= range.maxZ; ++z)
+    {
+        for (int y = range.minY; y <= range.maxY; ++y)
+        {
+            for (int x = range.minX; x <= range.maxX; ++x)
+            {
+                Vec3 const cellCenter((static_cast<float>(x) + 0.5f) * m_cellSize, (static_cast<float>(y) + 0.5f) * m_cellSize,
+                                      (static_cast<float>(z) + 0.5f) * m_cellSize);
+                if (!frustum.IsSphereVisible(cellCenter, cellReach)) continue;
+
+                if (sCell const* cell = FindCell(x, y, z))
+                {
+                    CollectFrustumCell(*cell, frustum, out_slots);
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntitySpatialGrid::QueryRadius(Vec3 const& center, float const radius, std::vector<uint32_t>& out_slots) const
+{
+    out_slots.clear();
+    if (m_entryCount == 0)
+    {
+        return;
+    }
+
+    Vec3 const reach(radius, radius, radius);
+    sCellRange range;
+    if (!GetCellRange(center - reach, center + reach, m_maxBoundRadius, range))
+    {
+        for (sCell const& cell : m_cells)
+        {
+            if (!cell.slots.empty()) CollectRadiusCell(cell, center, radius, out_slots);
+        }
+        return;
+    }
+
+    for (int z = range.minZ; z <= range.maxZ; ++z)
+    {
+        for (int y = range.minY; y <= range.maxY; ++y)
+        {
+            for (int x = range.minX; x <= range.maxX; ++x)
+            {
+                if (sCell const* cell = FindCell(x, y, z))
+                {
+                    CollectRadiusCell(*cell, center, radius, out_slots);
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Raycast
+//
+// 3D DDA (Amanatides-Woo) over the cells the ray passes through. A sphere hit at distance t has its
+// center within m_maxBoundRadius of the point at t, so the cells within `reach` of every stepped cell
+// are tested: the whole block around the first cell, then per step only the face the block gained.
+// Every hit nearer than the entry distance of the current cell has then been seen, so the walk stops
+// as soon as the nearest hit is no farther than that.
+//----------------------------------------------------------------------------------------------------
+bool EntitySpatialGrid::Raycast(Vec3 const& origin, Vec3 const& direction, float const maxDistance, sSpatialRayHit& out_hit) const
+{
+    if (m_entryCount == 0 || !(maxDistance >= 0.f))
+    {
+        return false;
+    }
+
+    // Cells a walk would look up at most, against a scan of every occupied cell
+    int const    reach      = static_cast<int>(m_maxBoundRadius / m_cellSize) + 1;
+    double const blockSide  = 2.0 * reach + 1.0;
+    double const maxSteps   = (std::fabs(direction.x) + std::fabs(direction.y) + std::fabs(direction.z)) * maxDistance / m_cellSize + 3.0;
+    double const maxLookups = blockSide * blockSide * (blockSide + maxSteps);
+    double const farCell    = std::max({std::fabs(origin.x), std::fabs(origin.y), std::fabs(origin.z)}) / m_cellSize + maxSteps + reach;
+    if (!(maxLookups <= static_cast<double>(m_occupiedCellCount)) || !(farCell < static_cast<double>(CELL_COORD_BIAS)))
+    {
+        return RaycastAllCells(origin, direction, maxDistance, out_hit);
+    }
+
+    float const components[3] = {direction.x, direction.y, direction.z};
+    float const starts[3]     = {origin.x, origin.y, origin.z};
+    int         cellCoord[3];
+    int         step[3];
+    float       nextBoundary[3];     // Ray distance to the next cell boundary per axis
+    float       boundaryDelta[3];    // Ray distance between boundaries per axis
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        cellCoord[axis] = static_cast<int>(std::floor(starts[axis] / m_cellSize));
+        if (components[axis] > 0.f)
+        {
+            step[axis]          = 1;
+            nextBoundary[axis]  = ((static_cast<float>(cellCoord[axis]) + 1.f) * m_cellSize - starts[axis]) / components[axis];
+            boundaryDelta[axis] = m_cellSize / components[axis];
+        }
+        else if (components[axis] < 0.f)
+        {
+            step[axis]          = -1;
+            nextBoundary[axis]  = (static_cast<float>(cellCoord[axis]) * m_cellSize - starts[axis]) / components[axis];
+            boundaryDelta[axis] = -m_cellSize / components[axis];
+        }
+        else
+        {
+            step[axis]          = 0;
+            nextBoundary[axis]  = INFINITY;
+            boundaryDelta[axis] = INFINITY;
+        }
+    }
+
+    bool  hasHit      = false;
+    float nearestDist = maxDistance;
+    float entryDist   = 0.f;
+
+    // First cell: the whole block around it
+    for (int z = cellCoord[2] - reach; z <= cellCoord[2] + reach; ++z)
+    {
+        for (int y = cellCoord[1] - reach; y <= cellCoord[1] + reach; ++y)
+        {
+            for (int x = cellCoord[0] - reach; x <= cellCoord[0] + reach; ++x)
+            {
+                if (sCell const* cell = FindCell(x, y, z)) RaycastCell(*cell, origin, direction, nearestDist, out_hit, hasHit);
+            }
+        }
+    }
+
+    for (;;)
+    {
+        int const axis = (nextBoundary[0] <= nextBoundary[1]) ? ((nextBoundary[0] <= nextBoundary[2]) ? 0 : 2)
+                                                              : ((nextBoundary[1] <= nextBoundary[2]) ? 1 : 2);
+        entryDist = nextBoundary[axis];
+        if (entryDist > maxDistance || (hasHit && nearestDist <= entryDist))
+        {
+            break;
+        }
+
+        cellCoord[axis] += step[axis];
+        nextBoundary[axis] += boundaryDelta[axis];
+
+        // The face of the block that entered range: fixed on `axis`, full extent on the other two
+        int const faceAxisA = (axis + 1) % 3;
+        int const faceAxisB = (axis + 2) % 3;
+        int       coord[3];
+        coord[axis] = cellCoord[axis] + step[axis] * reach;
+        for (coord[faceAxisA] = cellCoord[faceAxisA] - reach; coord[faceAxisA] <= cellCoord[faceAxisA] + reach; ++coord[faceAxisA])
+        {
+            for (coord[faceAxisB] = cellCoord[faceAxisB] - reach; coord[faceAxisB] <= cellCoord[faceAxisB] + reach; ++coord[faceAxisB])
+            {
+                if (sCell const* cell = FindCell(coord[0], coord[1], coord[2])) RaycastCell(*cell, origin, direction, nearestDist, out_hit, hasHit);
+            }
+        }
+    }
+
+    return hasHit;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Ray against every occupied cell (a walk along the ray would hash more cells than exist)
+//----------------------------------------------------------------------------------------------------
+bool EntitySpatialGrid::RaycastAllCells(Vec3 const& origin, Vec3 const& direction, float const maxDistance, sSpatialRayHit& out_hit) const
+{
+    bool  hasHit      = false;
+    float nearestDist = maxDistance;
+
+    for (sCell const& cell : m_cells)
+    {
+        if (cell.slots.empty()) continue;
+        RaycastCell(cell, origin, direction, nearestDist, out_hit, hasHit);
+    }
+
+    return hasHit;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntitySpatialGrid::CollectFrustumCell(sCell const& cell, sViewFrustum const& frustum, std::vector<uint32_t>& out_slots) const
+{
+    if (!frustum.IsSphereVisible(GetCellCenter(cell), GetCellBoundRadius(cell))) return;
+
+    for (uint32_t const slot : cell.slots)
+    {
+        sSlotEntry const& entry = m_slotEntries[slot];
+        if (frustum.IsSphereVisible(entry.center, entry.boundRadius))
+        {
+            out_slots.push_back(slot);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntitySpatialGrid::CollectRadiusCell(sCell const& cell, Vec3 const& center, float const radius, std::vector<uint32_t>& out_slots) const
+{
+    float const cellReach = radius + GetCellBoundRadius(cell);
+    if ((GetCellCenter(cell) - center).GetLengthSquared() > cellReach * cellReach) return;
+
+    for (uint32_t const slot : cell.slots)
+    {
+        sSlotEntry const& entry = m_slotEntries[slot];
+        float const       reach = radius + entry.boundRadius;
+        if ((entry.center - center).GetLengthSquared() <= reach * reach)
+        {
+            out_slots.push_back(slot);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntitySpatialGrid::RaycastCell(sCell const&    cell,
+                                    Vec3 const&     origin,
+                                    Vec3 const&     direction,
+                                    float&          inout_nearest,
+                                    sSpatialRayHit& out_hit,
+                                    bool&           inout_hasHit) const
+{
+    float cellDist = 0.f;
+    if (!RaycastSphere(origin, direction, GetCellCenter(cell), GetCellBoundRadius(cell), cellDist)) return;
+    if (cellDist > inout_nearest) return;
+
+    for (uint32_t const slot : cell.slots)
+    {
+        sSlotEntry const& entry = m_slotEntries[slot];
+        float             dist  = 0.f;
+        if (RaycastSphere(origin, direction, entry.center, entry.boundRadius, dist) && dist <= inout_nearest)
+        {
+            inout_nearest    = dist;
+            out_hit.slot     = slot;
+            out_hit.distance = dist;
+            inout_hasHit     = true;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool EntitySpatialGrid::GetCellRange(Vec3 const& mins, Vec3 const& maxs, float const reach, sCellRange& out_range) const
+{
+    double cellCount = 1.0;
+
+    // NaN fails every comparison, so a degenerate query falls back to the scan as well
+    auto const getAxisRange = [this, reach, &cellCount](float const low, float const high, int& out_min, int& out_max)
+    {
+        double const first = std::floor((static_cast<double>(low) - reach) / m_cellSize);
+        double const last  = std::floor((static_cast<double>(high) + reach) / m_cellSize);
+        if (!(first > -CELL_COORD_BIAS && last < CELL_COORD_BIAS && last >= first))
+        {
+            return false;
+        }
+
+        cellCount *= last - first + 1.0;
+        out_min = static_cast<int>(first);
+        out_max = static_cast<int>(last);
+        return true;
+    };
+
+    if (!getAxisRange(mins.x, maxs.x, out_range.minX, out_range.maxX) ||
+        !getAxisRange(mins.y, maxs.y, out_range.minY, out_range.maxY) ||
+        !getAxisRange(mins.z, maxs.z, out_range.minZ, out_range.maxZ))
+    {
+        return false;
+    }
+
+    return cellCount <= static_cast<double>(m_occupiedCellCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t EntitySpatialGrid::GetOrCreateCell(int const x, int const y, int const z)
+{
+    uint64_t const key = PackCellKey(x, y, z);
+    auto const     it  = m_cellLookup.find(key);
+    if (it != m_cellLookup.end())
+    {
+        return it->second;
+    }
+
+    uint32_t cellIndex;
+    if (!m_freeCells.empty())
+    {
+        cellIndex = m_freeCells.back();
+        m_freeCells.pop_back();
+    }
+    else
+    {
+        cellIndex = static_cast<uint32_t>(m_cells.size());
+        m_cells.emplace_back();
+    }
+
+    sCell& cell         = m_cells[cellIndex];
+    cell.x              = x;
+    cell.y              = y;
+    cell.z              = z;
+    cell.maxBoundRadius = 0.f;
+
+    m_cellLookup.emplace(key, cellIndex);
+    ++m_occupiedCellCount;
+    return cellIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+EntitySpatialGrid::sCell const* EntitySpatialGrid::FindCell(int const x, int const y, int const z) const
+{
+    auto const it = m_cellLookup.find(PackCellKey(x, y, z));
+    return (it != m_cellLookup.end()) ? &m_cells[it->second] : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntitySpatialGrid::RemoveFromCell(uint32_t const slot)
+{
+    sSlotEntry& entry = m_slotEntries[slot];
+    if (entry.cellIndex == 0xFFFFFFFFu)
+    {
+        return;
+    }
+
+    sCell& cell = m_cells[entry.cellIndex];
+
+    // Swap-remove, fixing up the moved slot's back-reference
+    uint32_t const movedSlot = cell.slots.back();
+    cell.slots[entry.indexInCell]        = movedSlot;
+    m_slotEntries[movedSlot].indexInCell = entry.indexInCell;
+    cell.slots.pop_back();
+    --m_entryCount;
+    if (m_entryCount == 0)
+    {
+        m_maxBoundRadius = 0.f;
+    }
+
+    if (cell.slots.empty())
+    {
+        m_cellLookup.erase(PackCellKey(cell.x, cell.y, cell.z));
+        m_freeCells.push_back(entry.cellIndex);
+        --m_occupiedCellCount;
+    }
+
+    entry.cellIndex   = 0xFFFFFFFFu;
+    entry.indexInCell = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 EntitySpatialGrid::GetCellCenter(sCell const& cell) const
+{
+    return Vec3((static_cast<float>(cell.x) + 0.5f) * m_cellSize,
+                (static_cast<float>(cell.y) + 0.5f) * m_cellSize,
+                (static_cast<float>(cell.z) + 0.5f) * m_cellSize);
+}
+
+//----------------------------------------------------------------------------------------------------
+float EntitySpatialGrid::GetCellBoundRadius(sCell const& cell) const
+{
+    return m_cellHalfDiagonal + cell.maxBoundRadius;
+}
@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------------------------------
+// EntitySpatialGrid.hpp
+// Uniform hash grid over entity bounding spheres (front buffer), plus view-frustum sphere tests
+//
+// Purpose:
+//   RenderEntities() submitted every active world entity, and KADI radius/ray queries would have to
+//   scan the whole store. The grid buckets EntityStore slots by the cell containing their bounding
+//   sphere center. Each cell keeps the largest bound radius it holds, so whole cells are rejected with
+//   one sphere test before any entity in them is touched.
+//
+// Design:
+//   - Sparse: only occupied cells exist (hashed by integer cell coordinate); empty cells are recycled
+//   - Incremental: EntityStore::SwapBuffers() calls Update() for each dirty slot only
+//   - Conservative: a cell's maxBoundRadius only shrinks when the cell empties, so cell tests never
+//     reject a visible entity (they may accept a few extra)
+//   - Local queries: sphere centers are bucketed, so an entity overlapping a region sits in a cell at
+//     most m_maxBoundRadius (largest radius in the grid, reset when it empties) outside it. Radius and
+//     frustum queries hash only the cells of their bounds grown by that reach; raycasts step cell by
+//     cell along the ray (3D DDA) and stop once no unvisited cell can hold a nearer hit. When that
+//     walk would touch more cells than are occupied, the query scans the occupied cells instead, so a
+//     query never costs more than the older whole-grid scan
+//
+// Thread Safety Model:
+//   - Main thread only (updated in SwapBuffers(), queried by RenderEntities() and command handlers)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// sViewFrustum
+//
+// Perspective frustum in game space (+X forward, +Y left, +Z up); vertical FOV in degrees
+//----------------------------------------------------------------------------------------------------
+struct sViewFrustum
+{
+    Vec3  position;
+    Vec3  forward;
+    Vec3  left;
+    Vec3  up;
+    float tanHalfFovV  = 1.f;
+    float tanHalfFovH  = 1.f;
+    float secHalfFovV  = 1.f;     // 1 / cos(halfFov) — scales the sphere radius against side planes
+    float secHalfFovH  = 1.f;
+    float nearDistance = 0.1f;
+    float farDistance  = 100.f;
+
+    static sViewFrustum MakePerspective(Vec3 const& position, EulerAngles const& orientation, float fovDegrees, float aspect, float nearDistance, float farDistance);
+
+    bool IsSphereVisible(Vec3 const& center, float radius) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sSpatialRayHit
+{
+    uint32_t slot     = 0xFFFFFFFFu;
+    float    distance = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+class EntitySpatialGrid
+{
+public:
+    explicit EntitySpatialGrid(float cellSize = 16.f);
+
+    //------------------------------------------------------------------------------------------------
+    // Maintenance (EntityStore::SwapBuffers)
+    //------------------------------------------------------------------------------------------------
+
+    // Insert, move or remove (isActive == false) one slot
+    void Update(uint32_t slot, Vec3 const& center, float boundRadius, bool isActive);
+
+    //------------------------------------------------------------------------------------------------
+    // Queries — results are slot indices; out vectors are cleared first and keep their capacity
+    //------------------------------------------------------------------------------------------------
+    void QueryFrustum(sViewFrustum const& frustum, std::vector<uint32_t>& out_slots) const;
+    void QueryRadius(Vec3 const& center, float radius, std::vector<uint32_t>& out_slots) const;
+
+    // Nearest bounding sphere hit along a normalized direction within maxDistance
+    bool Raycast(Vec3 const& origin, Vec3 const& direction, float maxDistance, sSpatialRayHit& out_hit) const;
+
+    float    GetCellSize() const { return m_cellSize; }
+    uint32_t GetOccupiedCellCount() const { return m_occupiedCellCount; }
+    uint32_t GetEntryCount() const { return m_entryCount; }
+
+private:
+    struct sCell
+    {
+        int                   x              = 0;
+        int                   y              = 0;
+        int                   z              = 0;
+        float                 maxBoundRadius = 0.f;
+        std::vector<uint32_t> slots;
+    };
+
+    // Inclusive cell coordinate range
+    struct sCellRange
+    {
+        int minX = 0;
+        int minY = 0;
+        int minZ = 0;
+        int maxX = -1;
+        int maxY = -1;
+        int maxZ = -1;
+    };
+
+    struct sSlotEntry
+    {
+        uint32_t cellIndex   = 0xFFFFFFFFu;
+        uint32_t indexInCell = 0;
+        Vec3     center;
+        float    boundRadius = 0.f;
+    };
+
+    uint32_t     GetOrCreateCell(int x, int y, int z);
+    sCell const* FindCell(int x, int y, int z) const;
+    void         RemoveFromCell(uint32_t slot);
+    Vec3         GetCellCenter(sCell const& cell) const;
+    float        GetCellBoundRadius(sCell const& cell) const;
+
+    // Cells covering [mins, maxs] grown by reach. False when the range holds more
+    // cells than are occupied (or leaves the packed coordinate space): scan m_cells instead.
+    bool GetCellRange(Vec3 const& mins, Vec3 const& maxs, float reach, sCellRange& out_range) const;
+
+    void CollectFrustumCell(sCell const& cell, sViewFrustum const& frustum, std::vector<uint32_t>& out_slots) const;
+    void CollectRadiusCell(sCell const& cell, Vec3 const& center, float radius, std::vector<uint32_t>& out_slots) const;
+    void RaycastCell(sCell const& cell, Vec3 const& origin, Vec3 const& direction, float& inout_nearest, sSpatialRayHit& out_hit, bool& inout_hasHit) const;
+    bool RaycastAllCells(Vec3 const& origin, Vec3 const& direction, float maxDistance, sSpatialRayHit& out_hit) const;
+
+    float m_cellSize         = 16.f;
+    float m_cellHalfDiagonal = 0.f;
+    float m_maxBoundRadius   = 0.f;     // Largest bound radius inserted since the grid was last empty
+
+    std::vector<sCell>                     m_cells;
+    std::unordered_map<uint64_t, uint32_t> m_cellLookup;     // Packed cell coordinate → m_cells index
+    std::vector<uint32_t>                  m_freeCells;
+    std::vector<sSlotEntry>                m_slotEntries;    // Indexed by EntityStore slot
+
+    uint32_t m_occupiedCellCount = 0;
+    uint32_t m_entryCount        = 0;
+};
@@ -0,0 +1,387 @@
+//----------------------------------------------------------------------------------------------------
+// EntityStore.cpp
+// Dense, generation-indexed entity storage (slot map + structure-of-arrays, double-buffered)
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/EntityStore.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+eEntityCameraType ParseEntityCameraType(String const& cameraType)
+{
+    if (cameraType == "world") return eEntityCameraType::WORLD;
+    if (cameraType == "screen") return eEntityCameraType::SCREEN;
+    return eEntityCameraType::OTHER;
+}
+
+//----------------------------------------------------------------------------------------------------
+void sEntityArrays::Resize(uint32_t const slotCount)
+{
+    ids.resize(slotCount, 0);
+    positions.resize(slotCount, Vec3::ZERO);
+    orientations.resize(slotCount, EulerAngles::ZERO);
+    colors.resize(slotCount, Rgba8::WHITE);
+    radii.resize(slotCount, 1.f);
+    boundRadii.resize(slotCount, 1.f);
+    textureIds.resize(slotCount, 0);
+    activeFlags.resize(slotCount, 0);
+    meshHandles.resize(slotCount, 0xFFFFFFFFu);
+    cameraTypeIds.resize(slotCount, eEntityCameraType::WORLD);
+    meshTypes.resize(slotCount);
+    cameraTypes.resize(slotCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+void sEntityArrays::CopySlotFrom(sEntityArrays const& other, uint32_t const slot)
+{
+    ids[slot]          = other.ids[slot];
+    positions[slot]    = other.positions[slot];
+    orientations[slot] = other.orientations[slot];
+    colors[slot]       = other.colors[slot];
+    radii[slot]        = other.radii[slot];
+    boundRadii[slot]   = other.boundRadii[slot];
+    textureIds[slot]   = other.textureIds[slot];
+    activeFlags[slot]  = other.activeFlags[slot];
+    meshHandles[slot]   = other.meshHandles[slot];
+    cameraTypeIds[slot] = other.cameraTypeIds[slot];
+
+    // Cold strings only change on create; skip the copy when already equal
+    if (meshTypes[slot] != other.meshTypes[slot]) meshTypes[slot] = other.meshTypes[slot];
+    if (cameraTypes[slot] != other.cameraTypes[slot]) cameraTypes[slot] = other.cameraTypes[slot];
+}
+
+//----------------------------------------------------------------------------------------------------
+EntityStore::EntityStore(float const spatialCellSize)
+    : m_spatialGrid(spatialCellSize)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t EntityStore::Create(EntityID const entityId, EntityState const& state, uint32_t const meshHandle)
+{
+    uint32_t slot = FindSlot(entityId);
+    if (slot == INVALID_SLOT)
+    {
+        slot                 = AllocateSlot();
+        m_idToSlot[entityId] = slot;
+    }
+
+    m_back.ids[slot]          = entityId;
+    m_back.positions[slot]    = state.position;
+    m_back.orientations[slot] = state.orientation;
+    m_back.colors[slot]       = state.color;
+    m_back.radii[slot]        = state.radius;
+    m_back.boundRadii[slot]   = state.radius;
+    m_back.textureIds[slot]   = state.textureId;
+    m_back.activeFlags[slot]  = state.isActive ? 1 : 0;
+    m_back.meshHandles[slot]   = meshHandle;
+    m_back.cameraTypeIds[slot] = ParseEntityCameraType(state.cameraType);
+    m_back.meshTypes[slot]    = state.meshType;
+    m_back.cameraTypes[slot]  = state.cameraType;
+
+    MarkDirty(slot);
+    return slot;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool EntityStore::Destroy(EntityID const entityId)
+{
+    auto const it = m_idToSlot.find(entityId);
+    if (it == m_idToSlot.end())
+    {
+        return false;
+    }
+
+    uint32_t const slot = it->second;
+    m_idToSlot.erase(it);
+
+    m_back.activeFlags[slot] = 0;
+    MarkDirty(slot);
+
+    // Front buffer must observe the deactivation before the slot can be reused
+    m_pendingRelease.push_back(slot);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t EntityStore::FindSlot(EntityID const entityId) const
+{
+    auto const it = m_idToSlot.find(entityId);
+    return (it != m_idToSlot.end()) ? it->second : INVALID_SLOT;
+}
+
+//----------------------------------------------------------------------------------------------------
+sEntityHandle EntityStore::GetHandle(EntityID const entityId) const
+{
+    sEntityHandle  handle;
+    uint32_t const slot = FindSlot(entityId);
+    if (slot != INVALID_SLOT)
+    {
+        handle.index      = slot;
+        handle.generation = m_generations[slot];
+    }
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool EntityStore::IsHandleValid(sEntityHandle const& handle) const
+{
+    return handle.index < m_generations.size() && m_generations[handle.index] == handle.generation &&
+           m_back.activeFlags[handle.index] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityStore::MarkDirty(uint32_t const slot)
+{
+    if (slot >= m_dirtyFlags.size() || m_dirtyFlags[slot] != 0)
+    {
+        return;
+    }
+
+    m_dirtyFlags[slot] = 1;
+    m_dirtySlots.push_back(slot);
+}
+
+//----------------------------------------------------------------------------------------------------
+// SwapBuffers
+//
+// O(dirty) copy: only slots marked since the last swap are written to the front arrays. Slots are
+// walked in ascending order so the copy stays a forward memory walk even when handlers touched
+// entities out of order. The spatial grid and the change log are kept in sync from the same dirty
+// set; slots about to be released are flagged first so they are logged as tombstones.
+//----------------------------------------------------------------------------------------------------
+void EntityStore::SwapBuffers()
+{
+    if (m_front.GetSlotCount() != m_back.GetSlotCount())
+    {
+        m_front.Resize(m_back.GetSlotCount());
+    }
+
+    if (m_isInterpolationEnabled)
+    {
+        StorePreviousTransforms();
+    }
+
+    if (!m_dirtySlots.empty())
+    {
+        std::sort(m_dirtySlots.begin(), m_dirtySlots.end());
+
+        for (uint32_t const slot : m_pendingRelease)
+        {
+            m_dirtyFlags[slot] = 2;
+        }
+
+        ++m_version;
+        for (uint32_t const slot : m_dirtySlots)
+        {
+            m_front.CopySlotFrom(m_back, slot);
+
+            bool const isDestroyed = m_dirtyFlags[slot] == 2;
+            m_changeLog.push_back({m_version, m_front.ids[slot], slot, isDestroyed});
+            m_slotVersions[slot] = m_version;
+            m_tombstoneCount += isDestroyed ? 1 : 0;
+            m_dirtyFlags[slot] = 0;
+
+            m_spatialGrid.Update(slot, m_front.positions[slot], m_front.boundRadii[slot], m_front.activeFlags[slot] != 0);
+        }
+
+        m_copyCount += m_dirtySlots.size();
+        m_dirtySlots.clear();
+
+        if (m_changeLog.size() > 2 * (static_cast<size_t>(m_front.GetSlotCount()) + MAX_TOMBSTONES))
+        {
+            CompactChangeLog();
+        }
+    }
+
+    for (uint32_t const slot : m_pendingRelease)
+    {
+        ++m_generations[slot];
+        m_freeSlots.push_back(slot);
+    }
+    m_pendingRelease.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// CompactChangeLog
+//
+// Drops entries superseded by a later change of the same slot and the oldest tombstones beyond
+// MAX_TOMBSTONES. Afterwards the log holds at most one entry per slot plus the kept tombstones, and
+// compaction runs again only once the log has doubled, so logging stays amortized O(1) per change.
+//----------------------------------------------------------------------------------------------------
+void EntityStore::CompactChangeLog()
+{
+    uint32_t tombstonesToDrop = (m_tombstoneCount > MAX_TOMBSTONES) ? m_tombstoneCount - MAX_TOMBSTONES : 0;
+
+    auto const kept = std::remove_if(m_changeLog.begin(), m_changeLog.end(), [this, &tombstonesToDrop](sChangeLogEntry const& entry)
+    {
+        if (!entry.isDestroyed)
+        {
+            return m_slotVersions[entry.slot] != entry.version;
+        }
+        if (tombstonesToDrop == 0)
+        {
+            return false;
+        }
+
+        --tombstonesToDrop;
+        --m_tombstoneCount;
+        m_tombstoneFloor = entry.version;
+        return true;
+    });
+    m_changeLog.erase(kept, m_changeLog.end());
+}
+
+//----------------------------------------------------------------------------------------------------
+// CollectChanges
+//
+// The log is sorted by (version, slot), so the first entry of the page is a binary search away;
+// from there every entry is either reported or skipped as superseded.
+//----------------------------------------------------------------------------------------------------
+bool EntityStore::CollectChanges(uint64_t const sinceVersion, sEntityChangeCursor const& after, uint32_t const limit,
+                                 std::vector<sEntityChange>& outChanges, bool& outHasMore) const
+{
+    outHasMore = false;
+    if (sinceVersion > m_version || (sinceVersion > 0 && sinceVersion < m_tombstoneFloor))
+    {
+        return false;
+    }
+
+    bool const isFullSnapshot = sinceVersion == 0;
+
+    auto const first = std::partition_point(m_changeLog.begin(), m_changeLog.end(), [sinceVersion, &after](sChangeLogEntry const& entry)
+    {
+        return entry.version <= sinceVersion || entry.version < after.version ||
+               (entry.version == after.version && entry.slot <= after.slot);
+    });
+
+    for (auto it = first; it != m_changeLog.end(); ++it)
+    {
+        bool isRemoved = true;
+        if (!it->isDestroyed)
+        {
+            if (m_slotVersions[it->slot] != it->version) continue;
+            isRemoved = m_front.activeFlags[it->slot] == 0;
+        }
+        if (isRemoved && isFullSnapshot) continue;
+
+        if (outChanges.size() >= limit)
+        {
+            outHasMore = true;
+            break;
+        }
+        outChanges.push_back({it->version, it->entityId, it->slot, isRemoved});
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// StorePreviousTransforms
+//
+// Runs before the dirty copy. Slots blended by the previous swap are settled first (previous = front),
+// so only slots that actually change in this swap interpolate. A slot that was inactive in the front
+// (new or recycled entity) starts from its new transform instead of flying in from a stale one.
+//----------------------------------------------------------------------------------------------------
+void EntityStore::StorePreviousTransforms()
+{
+    uint32_t const slotCount = m_front.GetSlotCount();
+    if (m_previousPositions.size() != slotCount)
+    {
+        m_previousPositions.resize(slotCount);
+        m_previousOrientations.resize(slotCount);
+    }
+
+    for (uint32_t const slot : m_interpolatedSlots)
+    {
+        m_previousPositions[slot]    = m_front.positions[slot];
+        m_previousOrientations[slot] = m_front.orientations[slot];
+    }
+    m_interpolatedSlots.clear();
+
+    for (uint32_t const slot : m_dirtySlots)
+    {
+        bool const wasActive = m_front.activeFlags[slot] != 0;
+
+        m_previousPositions[slot]    = wasActive ? m_front.positions[slot] : m_back.positions[slot];
+        m_previousOrientations[slot] = wasActive ? m_front.orientations[slot] : m_back.orientations[slot];
+        m_interpolatedSlots.push_back(slot);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityStore::SetInterpolationEnabled(bool const isEnabled)
+{
+    m_isInterpolationEnabled = isEnabled;
+
+    if (!isEnabled)
+    {
+        m_previousPositions.clear();
+        m_previousOrientations.clear();
+        m_interpolatedSlots.clear();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 EntityStore::GetInterpolatedPosition(uint32_t const slot, float const alpha) const
+{
+    Vec3 const& current = m_front.positions[slot];
+    if (slot >= m_previousPositions.size())
+    {
+        return current;
+    }
+
+    Vec3 const& previous = m_previousPositions[slot];
+    return previous + (current - previous) * alpha;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Per-axis blend along the shorter arc, so 359° → 1° moves 2° instead of spinning back through 180°
+//----------------------------------------------------------------------------------------------------
+static float LerpDegreesShortest(float const from, float const to, float const alpha)
+{
+    float delta = std::fmod(to - from, 360.f);
+    if (delta > 180.f)
+    {
+        delta -= 360.f;
+    }
+    else if (delta < -180.f)
+    {
+        delta += 360.f;
+    }
+    return from + delta * alpha;
+}
+
+//----------------------------------------------------------------------------------------------------
+EulerAngles EntityStore::GetInterpolatedOrientation(uint32_t const slot, float const alpha) const
+{
+    EulerAngles const& current = m_front.orientations[slot];
+    if (slot >= m_previousOrientations.size())
+    {
+        return current;
+    }
+
+    EulerAngles const& previous = m_previousOrientations[slot];
+    return EulerAngles(LerpDegreesShortest(previous.m_yawDegrees, current.m_yawDegrees, alpha),
+                       LerpDegreesShortest(previous.m_pitchDegrees, current.m_pitchDegrees, alpha),
+                       LerpDegreesShortest(previous.m_rollDegrees, current.m_rollDegrees, alpha));
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t EntityStore::AllocateSlot()
+{
+    if (!m_freeSlots.empty())
+    {
+        uint32_t const slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+
+    uint32_t const slot = m_back.GetSlotCount();
+    m_back.Resize(slot + 1);
+    m_generations.push_back(0);
+    m_dirtyFlags.push_back(0);
+    m_slotVersions.push_back(0);
+    return slot;
+}
@@ -0,0 +1,233 @@
+//----------------------------------------------------------------------------------------------------
+// EntityStore.hpp
+// Dense, generation-indexed entity storage (slot map + structure-of-arrays, double-buffered)
+//
+// Purpose:
+//   Replaces the std::unordered_map<EntityID, EntityState> EntityStateBuffer for game entities.
+//   Hot per-entity fields live in parallel arrays indexed by slot, so RenderEntities() and
+//   game.get_entity_list walk contiguous memory instead of chasing hash-map nodes, and swap cost
+//   is a linear copy of the dirty slots only.
+//
+// Design:
+//   - Slot map: EntityID → slot index (O(1) lookup for handlers); freed slots are recycled through
+//     a free list and their generation is bumped, so a stale sEntityHandle never aliases a new entity
+//   - SoA: positions / orientations / colors / radii / textureIds / activeFlags are separate arrays;
+//     meshTypes / cameraTypes are kept apart as cold data
+//   - Interned types: meshHandles (MeshHandleTable) and cameraTypeIds are resolved once on Create(),
+//     so the render loop never compares or slices strings
+//   - Double-buffer: handlers write GetBack(), rendering reads GetFront(); SwapBuffers() copies the
+//     dirty slots back → front (release of destroyed slots is deferred until the front has seen it)
+//   - Spatial index: SwapBuffers() also moves each dirty slot in an EntitySpatialGrid built over the
+//     front positions / boundRadii, used for frustum culling and radius/ray queries
+//   - Interpolation (fixed-timestep mode): SwapBuffers() keeps the pre-swap front transform of each
+//     dirty slot, so rendering can blend previous → current with GetInterpolatedPosition/Orientation()
+//   - Versions: every swap that copies dirty slots bumps the store version and stamps those slots
+//     with it. A change log (one entry per stamped slot, plus a tombstone per destroyed entity) lets
+//     CollectChanges() answer "what changed since version N" in O(changes), not O(entities);
+//     superseded entries are compacted away, tombstones are kept up to MAX_TOMBSTONES
+//
+// Thread Safety Model:
+//   - Main thread only: GenericCommand handlers, TypedCommandBuffer::Drain(), SwapBuffers() and
+//     RenderEntities() all run on the main thread, so no locking is required
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Entity/EntityStateBuffer.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Game/Framework/EntitySpatialGrid.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+enum class eEntityCameraType : uint8_t
+{
+    WORLD  = 0,
+    SCREEN = 1,
+    OTHER  = 2
+};
+
+eEntityCameraType ParseEntityCameraType(String const& cameraType);
+
+//----------------------------------------------------------------------------------------------------
+struct sEntityHandle
+{
+    uint32_t index      = 0xFFFFFFFFu;
+    uint32_t generation = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// sEntityChange / sEntityChangeCursor
+//
+// A front-buffer change reported by EntityStore::CollectChanges(). Changes are ordered by
+// (version, slot); a cursor is the last change of the previous page.
+//----------------------------------------------------------------------------------------------------
+struct sEntityChange
+{
+    uint64_t version   = 0;         // Swap that made the change visible in the front buffer
+    EntityID entityId  = 0;
+    uint32_t slot      = 0;
+    bool     isRemoved = false;     // Destroyed, or deactivated (no longer in the active list)
+};
+
+struct sEntityChangeCursor
+{
+    uint64_t version = 0;     // 0 = start from the first change
+    uint32_t slot    = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// sEntityArrays
+//
+// One complete copy of entity state in structure-of-arrays form. All arrays share the same length;
+// slot i of every array describes the same entity.
+//----------------------------------------------------------------------------------------------------
+struct sEntityArrays
+{
+    // Hot data (touched by the render loop every frame)
+    std::vector<EntityID>          ids;
+    std::vector<Vec3>              positions;
+    std::vector<EulerAngles>       orientations;
+    std::vector<Rgba8>             colors;
+    std::vector<float>             radii;
+    std::vector<float>             boundRadii;       // World-space bounding sphere radius (culling/queries)
+    std::vector<uint64_t>          textureIds;
+    std::vector<uint8_t>           activeFlags;
+    std::vector<uint32_t>          meshHandles;      // MeshHandle (see MeshHandleTable.hpp)
+    std::vector<eEntityCameraType> cameraTypeIds;
+
+    // Cold data
+    std::vector<String> meshTypes;
+    std::vector<String> cameraTypes;
+
+    uint32_t GetSlotCount() const { return static_cast<uint32_t>(ids.size()); }
+    void     Resize(uint32_t slotCount);
+    void     CopySlotFrom(sEntityArrays const& other, uint32_t slot);
+};
+
+//----------------------------------------------------------------------------------------------------
+class EntityStore
+{
+public:
+    static uint32_t constexpr INVALID_SLOT   = 0xFFFFFFFFu;
+    static uint32_t constexpr MAX_TOMBSTONES = 16384;     // Destroyed-entity entries kept for deltas
+
+    explicit EntityStore(float spatialCellSize = 16.f);
+    ~EntityStore() = default;
+
+    EntityStore(EntityStore const&)            = delete;
+    EntityStore& operator=(EntityStore const&) = delete;
+
+    //------------------------------------------------------------------------------------------------
+    // Lifecycle (back buffer)
+    //------------------------------------------------------------------------------------------------
+
+    // Insert (or overwrite) an entity and mark its slot dirty. Returns the slot index.
+    // meshHandle is interned by the caller (MeshHandleTable::Intern) from state.meshType / state.radius.
+    uint32_t Create(EntityID entityId, EntityState const& state, uint32_t meshHandle);
+
+    // Deactivate the entity and release its slot after the next swap. Returns false if unknown.
+    bool Destroy(EntityID entityId);
+
+    //------------------------------------------------------------------------------------------------
+    // Lookup
+    //------------------------------------------------------------------------------------------------
+    uint32_t      FindSlot(EntityID entityId) const;
+    sEntityHandle GetHandle(EntityID entityId) const;
+    bool          IsHandleValid(sEntityHandle const& handle) const;
+
+    //------------------------------------------------------------------------------------------------
+    // Double-buffer access
+    //------------------------------------------------------------------------------------------------
+    sEntityArrays&       GetBack() { return m_back; }
+    sEntityArrays const& GetFront() const { return m_front; }
+
+    void MarkDirty(uint32_t slot);
+
+    // Copy dirty slots back → front and update the spatial grid, then recycle slots destroyed before this swap
+    void SwapBuffers();
+
+    // Dirty slots or releases waiting for SwapBuffers() (Create() / Destroy() / MarkDirty() since the last swap)
+    bool HasPendingChanges() const { return !m_dirtySlots.empty() || !m_pendingRelease.empty(); }
+
+    // Spatial index over the front buffer (valid after SwapBuffers())
+    EntitySpatialGrid const& GetSpatialGrid() const { return m_spatialGrid; }
+
+    //------------------------------------------------------------------------------------------------
+    // Versioned change tracking (front buffer)
+    //------------------------------------------------------------------------------------------------
+
+    // Version of the last swap that changed anything (0 = nothing swapped yet)
+    uint64_t GetVersion() const { return m_version; }
+    uint64_t GetSlotVersion(uint32_t const slot) const { return m_slotVersions[slot]; }
+
+    // Up to `limit` changes with version > sinceVersion that come after `after`, oldest first; a slot
+    // changed several times is reported once, at its latest version. sinceVersion 0 is a full
+    // snapshot: active entities only, no removals. Returns false (and collects nothing) when
+    // sinceVersion is unknown or older than the oldest kept tombstone; the caller resyncs from 0.
+    bool CollectChanges(uint64_t sinceVersion, sEntityChangeCursor const& after, uint32_t limit,
+                        std::vector<sEntityChange>& outChanges, bool& outHasMore) const;
+
+    //------------------------------------------------------------------------------------------------
+    // Render interpolation (front buffer)
+    //------------------------------------------------------------------------------------------------
+    void SetInterpolationEnabled(bool isEnabled);
+    bool IsInterpolationEnabled() const { return m_isInterpolationEnabled; }
+
+    // alpha 0 = transform before the last swap, 1 = front buffer. Returns the front value when disabled.
+    Vec3        GetInterpolatedPosition(uint32_t slot, float alpha) const;
+    EulerAngles GetInterpolatedOrientation(uint32_t slot, float alpha) const;
+
+    //------------------------------------------------------------------------------------------------
+    // Statistics
+    //------------------------------------------------------------------------------------------------
+    uint32_t GetLiveCount() const { return static_cast<uint32_t>(m_idToSlot.size()); }
+    uint32_t GetSlotCount() const { return m_back.GetSlotCount(); }
+    uint32_t GetFreeSlotCount() const { return static_cast<uint32_t>(m_freeSlots.size()); }
+    size_t   GetDirtyCount() const { return m_dirtySlots.size(); }
+    size_t   GetCopyCount() const { return m_copyCount; }   // Total slots copied by SwapBuffers()
+
+private:
+    uint32_t AllocateSlot();
+    void     StorePreviousTransforms();
+    void     CompactChangeLog();
+
+    struct sChangeLogEntry
+    {
+        uint64_t version     = 0;
+        EntityID entityId    = 0;
+        uint32_t slot        = 0;
+        bool     isDestroyed = false;     // Tombstone: the slot was released in this swap
+    };
+
+    sEntityArrays     m_back;
+    sEntityArrays     m_front;
+    EntitySpatialGrid m_spatialGrid;
+
+    std::unordered_map<EntityID, uint32_t> m_idToSlot;
+    std::vector<uint32_t>                  m_generations;     // Per slot, bumped on release
+    std::vector<uint32_t>                  m_freeSlots;
+    std::vector<uint32_t>                  m_pendingRelease;  // Destroyed, released after next swap
+
+    std::vector<uint32_t> m_dirtySlots;
+    std::vector<uint8_t>  m_dirtyFlags;                       // Per slot, dedupes m_dirtySlots
+
+    bool                     m_isInterpolationEnabled = false;
+    std::vector<Vec3>        m_previousPositions;             // Per slot, front value before the last swap
+    std::vector<EulerAngles> m_previousOrientations;
+    std::vector<uint32_t>    m_interpolatedSlots;             // Slots whose previous != front
+
+    uint64_t                     m_version             = 0;
+    std::vector<uint64_t>        m_slotVersions;                 // Per slot, version of its last front change
+    std::vector<sChangeLogEntry> m_changeLog;                    // Sorted by (version, slot)
+    uint32_t                     m_tombstoneCount      = 0;
+    uint64_t                     m_tombstoneFloor      = 0;      // Newest version whose tombstones were trimmed
+
+    size_t m_copyCount = 0;
+};
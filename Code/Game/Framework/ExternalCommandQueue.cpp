@@ -0,0 +1,276 @@
+//----------------------------------------------------------------------------------------------------
+// ExternalCommandQueue.cpp
+// Bounded lock-free MPSC GenericCommand queue for native producer threads
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/ExternalCommandQueue.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+#include <any>
+#include <chrono>
+
+//----------------------------------------------------------------------------------------------------
+static int64_t constexpr NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+//----------------------------------------------------------------------------------------------------
+static int64_t GetSteadyNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t GetTimestampMs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+//----------------------------------------------------------------------------------------------------
+ExternalCommandQueue::ExternalCommandQueue(uint32_t const capacity, uint32_t const ratePerSecond)
+    : m_ratePerSecond(ratePerSecond)
+{
+    m_capacity = 2;
+    while (m_capacity < capacity && m_capacity < (1u << 20))
+    {
+        m_capacity <<= 1;
+    }
+    m_mask = m_capacity - 1;
+
+    m_cells = std::make_unique<sCell[]>(m_capacity);
+    for (uint32_t index = 0; index < m_capacity; ++index)
+    {
+        m_cells[index].sequence.store(index, std::memory_order_relaxed);
+    }
+
+    m_agents    = std::make_unique<sAgent[]>(MAX_AGENTS);
+    m_producers = std::make_unique<sProducer[]>(MAX_PRODUCERS);
+
+    if (ratePerSecond > 0)
+    {
+        m_emissionIntervalNs = NANOSECONDS_PER_SECOND / static_cast<int64_t>(ratePerSecond);
+        m_burstToleranceNs   = NANOSECONDS_PER_SECOND - m_emissionIntervalNs;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ExternalCommandQueue::~ExternalCommandQueue()
+{
+    uint64_t const pending = m_enqueuePos.load(std::memory_order_acquire) - m_dequeuePos;
+    if (pending > 0)
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("ExternalCommandQueue: Destroyed with %llu unconsumed command(s)", pending));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ExternalProducerHandle ExternalCommandQueue::RegisterProducer(String const& agentId)
+{
+    std::lock_guard lock(m_registrationMutex);
+
+    uint32_t const producerCount = m_producerCount.load(std::memory_order_relaxed);
+    if (producerCount >= MAX_PRODUCERS || agentId.empty())
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                   Stringf("ExternalCommandQueue: Cannot register producer for agent '%s' (%u/%u producers)",
+                       agentId.c_str(), producerCount, MAX_PRODUCERS));
+        return INVALID_EXTERNAL_PRODUCER;
+    }
+
+    uint32_t const agentCount = m_agentCount.load(std::memory_order_relaxed);
+    uint32_t       agentIndex = 0;
+    while (agentIndex < agentCount && m_agents[agentIndex].agentId != agentId)
+    {
+        ++agentIndex;
+    }
+
+    if (agentIndex == agentCount)
+    {
+        if (agentCount >= MAX_AGENTS)
+        {
+            DAEMON_LOG(LogApp, eLogVerbosity::Warning,
+                       Stringf("ExternalCommandQueue: Cannot register agent '%s' (%u agents max)", agentId.c_str(), MAX_AGENTS));
+            return INVALID_EXTERNAL_PRODUCER;
+        }
+
+        m_agents[agentIndex].agentId = agentId;
+        m_agentCount.store(agentCount + 1, std::memory_order_release);
+    }
+
+    ++m_agents[agentIndex].producers;
+    m_producers[producerCount].agentIndex   = agentIndex;
+    m_producers[producerCount].nextSequence = 1;
+    m_producerCount.store(producerCount + 1, std::memory_order_release);
+
+    DAEMON_LOG(LogApp, eLogVerbosity::Log,
+               Stringf("ExternalCommandQueue: Producer %u registered for agent '%s'", producerCount, agentId.c_str()));
+    return producerCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// TryConsumeToken
+//
+// GCRA form of a token bucket: the bucket is full when the theoretical arrival time (TAT) is in the
+// past, and each command pushes TAT forward by one emission interval. A command is admitted while
+// TAT stays within the burst tolerance of now.
+//----------------------------------------------------------------------------------------------------
+bool ExternalCommandQueue::TryConsumeToken(sAgent& agent) const
+{
+    if (m_emissionIntervalNs == 0)
+    {
+        return true;
+    }
+
+    int64_t const now = GetSteadyNanoseconds();
+    int64_t       tat = agent.theoreticalArrivalNs.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        int64_t const start = std::max(tat, now);
+        if (start - now > m_burstToleranceNs)
+        {
+            return false;
+        }
+
+        if (agent.theoreticalArrivalNs.compare_exchange_weak(tat, start + m_emissionIntervalNs, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Submit
+//
+// A full queue refunds the token it took, so backpressure does not also eat the agent's rate budget.
+//----------------------------------------------------------------------------------------------------
+eExternalSubmitResult ExternalCommandQueue::Submit(ExternalProducerHandle const producer, String const& type, String const& payloadJson)
+{
+    if (producer >= m_producerCount.load(std::memory_order_acquire))
+    {
+        return eExternalSubmitResult::INVALID_PRODUCER;
+    }
+
+    sProducer& producerState = m_producers[producer];
+    sAgent&    agent         = m_agents[producerState.agentIndex];
+
+    if (!TryConsumeToken(agent))
+    {
+        agent.rateLimited.fetch_add(1, std::memory_order_relaxed);
+        return eExternalSubmitResult::RATE_LIMITED;
+    }
+
+    uint64_t position = m_enqueuePos.load(std::memory_order_relaxed);
+    sCell*   cell     = nullptr;
+
+    for (;;)
+    {
+        cell                      = &m_cells[position & m_mask];
+        uint64_t const sequence   = cell->sequence.load(std::memory_order_acquire);
+        int64_t const  difference = static_cast<int64_t>(sequence - position);
+
+        if (difference == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            if (m_emissionIntervalNs > 0)
+            {
+                agent.theoreticalArrivalNs.fetch_sub(m_emissionIntervalNs, std::memory_order_relaxed);
+            }
+            agent.queueFull.fetch_add(1, std::memory_order_relaxed);
+            return eExternalSubmitResult::QUEUE_FULL;
+        }
+        else
+        {
+            position = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // The claimed cell is exclusively ours until the sequence store publishes it
+    cell->command = GenericCommand(type, std::any(payloadJson), agent.agentId, GetTimestampMs(), std::any());
+    cell->info    = {producer, producerState.nextSequence++};
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    agent.accepted.fetch_add(1, std::memory_order_relaxed);
+    return eExternalSubmitResult::ACCEPTED;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ConsumeAll
+//
+// At most one capacity's worth per call, so producers that keep submitting cannot hold the main
+// thread here. Cells are released before the command runs, letting producers refill during execution.
+//----------------------------------------------------------------------------------------------------
+uint32_t ExternalCommandQueue::ConsumeAll(ConsumeFunction const& consume)
+{
+    uint32_t consumed = 0;
+
+    while (consumed < m_capacity)
+    {
+        sCell&         cell     = m_cells[m_dequeuePos & m_mask];
+        uint64_t const sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<int64_t>(sequence - (m_dequeuePos + 1)) < 0)
+        {
+            break;
+        }
+
+        GenericCommand const       command = std::move(cell.command);
+        sExternalCommandInfo const info    = cell.info;
+        cell.command                       = GenericCommand();
+        cell.sequence.store(m_dequeuePos + m_capacity, std::memory_order_release);
+        ++m_dequeuePos;
+        ++consumed;
+
+        m_agents[m_producers[info.producer].agentIndex].consumed.fetch_add(1, std::memory_order_relaxed);
+        consume(command, info);
+    }
+
+    m_lastConsumed.store(consumed, std::memory_order_relaxed);
+    m_totalConsumed.fetch_add(consumed, std::memory_order_relaxed);
+    if (consumed > m_maxDepth.load(std::memory_order_relaxed))
+    {
+        m_maxDepth.store(consumed, std::memory_order_relaxed);
+    }
+    return consumed;
+}
+
+//----------------------------------------------------------------------------------------------------
+sExternalCommandQueueStats ExternalCommandQueue::GetStats() const
+{
+    sExternalCommandQueueStats stats;
+    stats.capacity      = m_capacity;
+    stats.ratePerSecond = m_ratePerSecond;
+    stats.maxDepth      = m_maxDepth.load(std::memory_order_relaxed);
+    stats.lastConsumed  = m_lastConsumed.load(std::memory_order_relaxed);
+    stats.totalConsumed = m_totalConsumed.load(std::memory_order_relaxed);
+
+    uint64_t const enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+    stats.depth             = static_cast<uint32_t>(std::min<uint64_t>(enqueued - std::min(enqueued, stats.totalConsumed), m_capacity));
+
+    std::lock_guard lock(m_registrationMutex);
+    uint32_t const  agentCount = m_agentCount.load(std::memory_order_relaxed);
+    stats.agents.reserve(agentCount);
+
+    for (uint32_t index = 0; index < agentCount; ++index)
+    {
+        sAgent const&       agent = m_agents[index];
+        sExternalAgentStats agentStats;
+        agentStats.agentId     = agent.agentId;
+        agentStats.producers   = agent.producers;
+        agentStats.accepted    = agent.accepted.load(std::memory_order_relaxed);
+        agentStats.consumed    = agent.consumed.load(std::memory_order_relaxed);
+        agentStats.queueFull   = agent.queueFull.load(std::memory_order_relaxed);
+        agentStats.rateLimited = agent.rateLimited.load(std::memory_order_relaxed);
+        stats.agents.push_back(std::move(agentStats));
+    }
+
+    return stats;
+}
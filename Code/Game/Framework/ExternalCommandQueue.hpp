@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------------------------------
+// ExternalCommandQueue.hpp
+// Bounded lock-free MPSC GenericCommand queue for native producer threads
+//
+// Purpose:
+//   GenericCommandQueue is a single-producer ring owned by the JavaScript worker, so anything that
+//   originates on another thread (KADI tool calls, the DevTools inspector, future network clients)
+//   has to hop into JS or into a main-thread handler before it can become a command. This queue
+//   accepts complete GenericCommands from any number of native threads and is drained by
+//   App::ProcessGenericCommands() right after the JS queue, through the same executor. In tree, the
+//   JSWorkerPool shard isolates submit through it (one producer per shard, see JSWorkerPool.hpp).
+//
+// Design:
+//   - Vyukov bounded MPSC ring: each cell carries a sequence number, producers claim a position with
+//     one CAS, the single consumer needs no atomic read-modify-write. Capacity is a power of two
+//   - Producers register once (RegisterProducer) and get a handle. Commands of one producer are
+//     consumed in submission order and carry a per-producer sequence number; there is no ordering
+//     between different producers
+//   - Admission is rate limited per agent with a lock-free token bucket (GCRA: one atomic
+//     "theoretical arrival time" per agent, burst = one second of tokens), so several producers of
+//     one agent share its budget. GenericCommandExecutor still applies its own per-agent limit
+//   - A rejected Submit() never blocks: QUEUE_FULL is backpressure (retry later), RATE_LIMITED is a
+//     drop; both are counted per agent for game.get_engine_metrics
+//   - Commands are fire-and-forget (no JS callback exists for them); producers that need results
+//     query them with a follow-up command or through their own channel
+//
+// Thread Safety Model:
+//   - RegisterProducer(): any thread (m_registrationMutex, rare)
+//   - Submit(): any thread, lock-free; a producer handle must not be used by two threads at once
+//   - ConsumeAll(): main thread only
+//   - GetStats(): any thread (relaxed atomic snapshot)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/GenericCommand.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+using ExternalProducerHandle = uint32_t;
+
+ExternalProducerHandle constexpr INVALID_EXTERNAL_PRODUCER = 0xFFFFFFFFu;
+
+//----------------------------------------------------------------------------------------------------
+enum class eExternalSubmitResult : uint8_t
+{
+    ACCEPTED,
+    QUEUE_FULL,           // Backpressure: the main thread has not drained yet, retry later
+    RATE_LIMITED,         // Dropped: agent exceeded its token bucket
+    INVALID_PRODUCER
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sExternalCommandInfo
+{
+    ExternalProducerHandle producer = INVALID_EXTERNAL_PRODUCER;
+    uint64_t               sequence = 0;      // 1-based, per producer
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sExternalAgentStats
+{
+    String   agentId;
+    uint32_t producers   = 0;
+    uint64_t accepted    = 0;
+    uint64_t consumed    = 0;
+    uint64_t queueFull   = 0;      // Backpressure rejections
+    uint64_t rateLimited = 0;      // Drops
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sExternalCommandQueueStats
+{
+    uint32_t                         capacity      = 0;
+    uint32_t                         ratePerSecond = 0;
+    uint32_t                         depth         = 0;      // Approximate, at snapshot time
+    uint32_t                         maxDepth      = 0;
+    uint32_t                         lastConsumed  = 0;      // Commands drained by the last ConsumeAll()
+    uint64_t                         totalConsumed = 0;
+    std::vector<sExternalAgentStats> agents;
+};
+
+//----------------------------------------------------------------------------------------------------
+class ExternalCommandQueue
+{
+public:
+    using ConsumeFunction = std::function<void(GenericCommand const& command, sExternalCommandInfo const& info)>;
+
+    static uint32_t constexpr MAX_PRODUCERS    = 64;
+    static uint32_t constexpr MAX_AGENTS       = 32;
+    static uint32_t constexpr DEFAULT_CAPACITY = 256;
+
+    // capacity is rounded up to a power of two; ratePerSecond 0 = unlimited
+    ExternalCommandQueue(uint32_t capacity, uint32_t ratePerSecond);
+    ~ExternalCommandQueue();
+
+    ExternalCommandQueue(ExternalCommandQueue const&)            = delete;
+    ExternalCommandQueue& operator=(ExternalCommandQueue const&) = delete;
+
+    // Returns INVALID_EXTERNAL_PRODUCER when MAX_PRODUCERS / MAX_AGENTS are exhausted
+    ExternalProducerHandle RegisterProducer(String const& agentId);
+
+    // payloadJson is delivered to handlers exactly like a JS CommandQueue.submit() payload
+    eExternalSubmitResult Submit(ExternalProducerHandle producer, String const& type, String const& payloadJson);
+
+    // Drain everything visible; returns the number of commands consumed
+    uint32_t ConsumeAll(ConsumeFunction const& consume);
+
+    uint32_t                   GetCapacity() const { return m_capacity; }
+    sExternalCommandQueueStats GetStats() const;
+
+private:
+    struct sCell
+    {
+        std::atomic<uint64_t> sequence{0};
+        GenericCommand        command;
+        sExternalCommandInfo  info;
+    };
+
+    struct sAgent
+    {
+        String                agentId;
+        uint32_t              producers = 0;
+        std::atomic<int64_t>  theoreticalArrivalNs{0};     // GCRA token bucket state
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> consumed{0};
+        std::atomic<uint64_t> queueFull{0};
+        std::atomic<uint64_t> rateLimited{0};
+    };
+
+    struct sProducer
+    {
+        uint32_t agentIndex   = 0;
+        uint64_t nextSequence = 1;     // Owned by the producer thread
+    };
+
+    bool TryConsumeToken(sAgent& agent) const;
+
+    uint32_t                 m_capacity = 0;
+    uint64_t                 m_mask     = 0;
+    std::unique_ptr<sCell[]> m_cells;
+
+    std::atomic<uint64_t> m_enqueuePos{0};
+    uint64_t              m_dequeuePos = 0;     // Consumer only
+
+    uint32_t m_ratePerSecond      = 0;
+    int64_t  m_emissionIntervalNs = 0;     // 1s / ratePerSecond (0 = unlimited)
+    int64_t  m_burstToleranceNs   = 0;
+
+    mutable std::mutex           m_registrationMutex;     // Guards agent/producer registration
+    std::unique_ptr<sAgent[]>    m_agents;
+    std::unique_ptr<sProducer[]> m_producers;
+    std::atomic<uint32_t>        m_agentCount{0};
+    std::atomic<uint32_t>        m_producerCount{0};
+
+    std::atomic<uint32_t> m_maxDepth{0};
+    std::atomic<uint32_t> m_lastConsumed{0};
+    std::atomic<uint64_t> m_totalConsumed{0};
+};
@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------------------------------
+// FixedTimestepScheduler.cpp
+// Fixed-rate simulation ticks decoupled from the render frame rate
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/FixedTimestepScheduler.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+FixedTimestepScheduler::FixedTimestepScheduler(float const tickRate, uint32_t const maxCatchUpTicks)
+    : m_tickSeconds(1.0 / static_cast<double>((tickRate > 0.f) ? tickRate : 60.f)),
+      m_maxCatchUpTicks((maxCatchUpTicks > 0) ? maxCatchUpTicks : 1u),
+      m_publishTime(std::chrono::steady_clock::now())
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void FixedTimestepScheduler::Accumulate(double const frameSeconds)
+{
+    if (frameSeconds > 0.0)
+    {
+        m_accumulator += frameSeconds;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// ConsumeTicks
+//
+// Whole ticks only; the remainder carries over. If more than maxCatchUpTicks are owed (long stall,
+// debugger break), the surplus is dropped rather than queued, so the simulation slows down instead
+// of trying to catch up forever.
+//----------------------------------------------------------------------------------------------------
+uint32_t FixedTimestepScheduler::ConsumeTicks()
+{
+    uint64_t const owedTicks = static_cast<uint64_t>(m_accumulator / m_tickSeconds);
+    uint32_t const ticks     = static_cast<uint32_t>(std::min<uint64_t>(owedTicks, m_maxCatchUpTicks));
+
+    if (owedTicks > ticks)
+    {
+        m_droppedTicks += owedTicks - ticks;
+        m_accumulator -= static_cast<double>(owedTicks) * m_tickSeconds;
+    }
+    else
+    {
+        m_accumulator -= static_cast<double>(ticks) * m_tickSeconds;
+    }
+
+    m_lastTicks = ticks;
+    m_totalTicks += ticks;
+    return ticks;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FixedTimestepScheduler::PublishTicks(uint32_t const tickCount)
+{
+    m_publishTime        = std::chrono::steady_clock::now();
+    m_publishSpanSeconds = static_cast<double>(tickCount) * m_tickSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+float FixedTimestepScheduler::GetInterpolationAlpha() const
+{
+    if (m_publishSpanSeconds <= 0.0)
+    {
+        return 1.f;
+    }
+
+    double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_publishTime).count();
+    return static_cast<float>(std::clamp(elapsed / m_publishSpanSeconds, 0.0, 1.0));
+}
+
+//----------------------------------------------------------------------------------------------------
+sFixedTimestepStats FixedTimestepScheduler::GetStats() const
+{
+    sFixedTimestepStats stats;
+    stats.tickRate        = static_cast<float>(1.0 / m_tickSeconds);
+    stats.maxCatchUpTicks = m_maxCatchUpTicks;
+    stats.lastTicks       = m_lastTicks;
+    stats.totalTicks      = m_totalTicks;
+    stats.droppedTicks    = m_droppedTicks;
+    stats.accumulatorMs   = m_accumulator * 1000.0;
+    return stats;
+}
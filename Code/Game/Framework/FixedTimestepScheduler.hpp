@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------------------------------
+// FixedTimestepScheduler.hpp
+// Fixed-rate simulation ticks decoupled from the render frame rate
+//
+// Purpose:
+//   In the default (variable) mode JSEngine.update() receives whatever Clock measured when the worker
+//   was triggered, so frame skips and App::Update() jitter leak into the simulation. In fixed mode
+//   the main thread accumulates real time every frame and, whenever the worker is free, hands it a
+//   whole number of ticks of exactly 1 / tickRate seconds each. Replays, load tests and headless
+//   runs then see the same sequence of deltas regardless of render rate.
+//
+// Design:
+//   - Accumulate() every main frame (including frames where the worker is still busy)
+//   - ConsumeTicks() when the worker can take a frame: 0..maxCatchUpTicks ticks; time beyond the
+//     cap is dropped (spiral-of-death guard) and counted
+//   - PublishTicks() when the resulting state is swapped to the front buffer; GetInterpolationAlpha()
+//     then reports how far the render frame is into that span, for EntityStore interpolation
+//
+// Thread Safety Model:
+//   - Main thread only (App::Update() and RenderEntities())
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+struct sFixedTimestepStats
+{
+    float    tickRate        = 0.f;
+    uint32_t maxCatchUpTicks = 0;
+    uint32_t lastTicks       = 0;      // Ticks handed to the worker by the last ConsumeTicks()
+    uint64_t totalTicks      = 0;
+    uint64_t droppedTicks    = 0;      // Ticks discarded by the catch-up cap
+    double   accumulatorMs   = 0.0;    // Real time not yet simulated
+};
+
+//----------------------------------------------------------------------------------------------------
+class FixedTimestepScheduler
+{
+public:
+    static uint32_t constexpr DEFAULT_MAX_CATCH_UP_TICKS = 5;
+
+    FixedTimestepScheduler(float tickRate, uint32_t maxCatchUpTicks);
+
+    void     Accumulate(double frameSeconds);
+    uint32_t ConsumeTicks();
+    void     PublishTicks(uint32_t tickCount);
+
+    float GetTickSeconds() const { return static_cast<float>(m_tickSeconds); }
+    float GetInterpolationAlpha() const;   // 0 = previous sim state, 1 = newest
+
+    sFixedTimestepStats GetStats() const;
+
+private:
+    double   m_tickSeconds;
+    uint32_t m_maxCatchUpTicks;
+    double   m_accumulator = 0.0;
+
+    std::chrono::steady_clock::time_point m_publishTime;
+    double                                m_publishSpanSeconds = 0.0;
+
+    uint32_t m_lastTicks    = 0;
+    uint64_t m_totalTicks   = 0;
+    uint64_t m_droppedTicks = 0;
+};
@@ -0,0 +1,488 @@
+//----------------------------------------------------------------------------------------------------
+// FrameProfiler.cpp
+// Hierarchical CPU scope timers with rolling percentiles and Chrome trace_event export
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/FrameProfiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    struct sRecordedScope
+    {
+        char const* name    = nullptr;
+        char const* parent  = nullptr;
+        int64_t     startNs = 0;
+        int64_t     endNs   = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sThreadBuffer
+    {
+        std::mutex                  mutex;
+        std::vector<sRecordedScope> scopes;     // Guarded by mutex, swapped out by EndFrame()
+        String                      name;       // Guarded by sProfilerState::registryMutex
+        uint32_t                    index = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sScopeKey
+    {
+        char const* name        = nullptr;
+        char const* parent      = nullptr;
+        uint32_t    threadIndex = 0;
+
+        bool operator==(sScopeKey const& other) const
+        {
+            return name == other.name && parent == other.parent && threadIndex == other.threadIndex;
+        }
+    };
+
+    struct sScopeKeyHash
+    {
+        size_t operator()(sScopeKey const& key) const
+        {
+            size_t const nameHash   = std::hash<char const*>()(key.name);
+            size_t const parentHash = std::hash<char const*>()(key.parent);
+            return nameHash ^ (parentHash * 31u) ^ (static_cast<size_t>(key.threadIndex) << 48);
+        }
+    };
+
+    //------------------------------------------------------------------------------------------------
+    // Ring of per-frame samples for one scope
+    struct sScopeHistory
+    {
+        std::vector<float>    samplesMs;
+        std::vector<uint32_t> calls;
+        uint32_t              head  = 0;
+        uint32_t              count = 0;
+
+        int64_t  frameNs      = 0;     // Accumulated for the frame being collected
+        uint32_t frameCalls   = 0;
+        uint64_t touchedFrame = UINT64_MAX;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sTraceFrame
+    {
+        uint64_t                        frameNumber = 0;
+        std::vector<sProfileTraceEvent> events;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sProfilerState
+    {
+        std::atomic<bool>    isEnabled{false};
+        sFrameProfilerConfig config;
+
+        std::mutex                                  registryMutex;
+        std::vector<std::shared_ptr<sThreadBuffer>> threads;
+
+        std::mutex                 internMutex;
+        std::unordered_set<String> internedNames;     // Node-based: c_str() stays valid
+
+        // Main thread only
+        uint64_t                                                    frameNumber = 0;
+        std::vector<sRecordedScope>                                 collected;
+        std::unordered_map<sScopeKey, sScopeHistory, sScopeKeyHash> histories;
+        std::vector<sScopeHistory*>                                 touched;
+        std::deque<sTraceFrame>                                     traceFrames;
+        std::vector<std::vector<sProfileTraceEvent>>                spareTraceEvents;
+    };
+
+    sProfilerState s_state;
+
+    thread_local sThreadBuffer* t_buffer       = nullptr;
+    thread_local char const*    t_currentScope = nullptr;
+
+    //------------------------------------------------------------------------------------------------
+    int64_t GetNowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sThreadBuffer& GetThreadBuffer()
+    {
+        if (t_buffer == nullptr)
+        {
+            auto buffer = std::make_shared<sThreadBuffer>();
+
+            std::lock_guard lock(s_state.registryMutex);
+            buffer->index = static_cast<uint32_t>(s_state.threads.size());
+            buffer->name  = Stringf("Thread %u", buffer->index);
+            s_state.threads.push_back(buffer);
+            t_buffer = buffer.get();
+        }
+        return *t_buffer;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    // Nearest-rank percentile of an ascending sample set
+    double GetPercentile(std::vector<float> const& sorted, double const percentile)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        size_t const rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(sorted.size())));
+        return static_cast<double>(sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1]);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void WriteJsonString(std::ostream& out, char const* text)
+    {
+        out << '"';
+        for (char const* c = text; c && *c; ++c)
+        {
+            if (*c == '"' || *c == '\\') out << '\\' << *c;
+            else if (static_cast<unsigned char>(*c) >= 0x20) out << *c;
+        }
+        out << '"';
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameProfiler::Configure(sFrameProfilerConfig const& config)
+{
+    s_state.config              = config;
+    s_state.config.windowFrames = std::max(config.windowFrames, 1u);
+    Reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FrameProfiler::IsEnabled()
+{
+    return s_state.isEnabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+// SetEnabled
+//
+// Turning the profiler on starts from empty histories: scopes still buffered from an earlier
+// session would otherwise land in the first new frame.
+//----------------------------------------------------------------------------------------------------
+void FrameProfiler::SetEnabled(bool const isEnabled)
+{
+    if (isEnabled && !IsEnabled())
+    {
+        Reset();
+    }
+    s_state.isEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameProfiler::Reset()
+{
+    {
+        std::lock_guard lock(s_state.registryMutex);
+        for (std::shared_ptr<sThreadBuffer> const& buffer : s_state.threads)
+        {
+            std::lock_guard bufferLock(buffer->mutex);
+            buffer->scopes.clear();
+        }
+    }
+
+    s_state.histories.clear();
+    s_state.touched.clear();
+    s_state.traceFrames.clear();
+    s_state.spareTraceEvents.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* FrameProfiler::InternName(String const& name)
+{
+    std::lock_guard lock(s_state.internMutex);
+    return s_state.internedNames.insert(name).first->c_str();
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameProfiler::SetThreadName(char const* name)
+{
+    sThreadBuffer& buffer = GetThreadBuffer();
+
+    std::lock_guard lock(s_state.registryMutex);
+    buffer.name = name;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameProfiler::Record(char const* name, char const* parent, int64_t const startNs, int64_t const endNs)
+{
+    sThreadBuffer& buffer = GetThreadBuffer();
+
+    std::lock_guard lock(buffer.mutex);
+    buffer.scopes.push_back({name, parent, startNs, endNs});
+}
+
+//----------------------------------------------------------------------------------------------------
+// EndFrame
+//
+// Every buffer is swapped with the (cleared, capacity-keeping) collection vector, so a steady state
+// neither allocates on the recording threads nor here.
+//----------------------------------------------------------------------------------------------------
+void FrameProfiler::EndFrame()
+{
+    uint64_t const frameNumber = s_state.frameNumber++;
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    sTraceFrame* traceFrame = nullptr;
+    if (s_state.config.traceHistoryFrames > 0)
+    {
+        if (s_state.traceFrames.size() >= s_state.config.traceHistoryFrames)
+        {
+            s_state.spareTraceEvents.push_back(std::move(s_state.traceFrames.front().events));
+            s_state.traceFrames.pop_front();
+        }
+
+        sTraceFrame& frame = s_state.traceFrames.emplace_back();
+        frame.frameNumber  = frameNumber;
+        if (!s_state.spareTraceEvents.empty())
+        {
+            frame.events = std::move(s_state.spareTraceEvents.back());
+            frame.events.clear();
+            s_state.spareTraceEvents.pop_back();
+        }
+        traceFrame = &frame;
+    }
+
+    std::lock_guard registryLock(s_state.registryMutex);
+    for (std::shared_ptr<sThreadBuffer> const& buffer : s_state.threads)
+    {
+        {
+            std::lock_guard bufferLock(buffer->mutex);
+            s_state.collected.swap(buffer->scopes);
+        }
+
+        for (sRecordedScope const& scope : s_state.collected)
+        {
+            sScopeHistory& history = s_state.histories[{scope.name, scope.parent, buffer->index}];
+            if (history.touchedFrame != frameNumber)
+            {
+                history.touchedFrame = frameNumber;
+                s_state.touched.push_back(&history);
+            }
+            history.frameNs += scope.endNs - scope.startNs;
+            ++history.frameCalls;
+
+            if (traceFrame)
+            {
+                traceFrame->events.push_back({scope.name, scope.startNs, scope.endNs - scope.startNs, buffer->index});
+            }
+        }
+        s_state.collected.clear();
+    }
+
+    uint32_t const windowFrames = s_state.config.windowFrames;
+    for (sScopeHistory* history : s_state.touched)
+    {
+        if (history->samplesMs.empty())
+        {
+            history->samplesMs.resize(windowFrames);
+            history->calls.resize(windowFrames);
+        }
+
+        history->samplesMs[history->head] = static_cast<float>(static_cast<double>(history->frameNs) / 1.0e6);
+        history->calls[history->head]     = history->frameCalls;
+        history->head                     = (history->head + 1) % windowFrames;
+        history->count                    = std::min(history->count + 1, windowFrames);
+        history->frameNs                  = 0;
+        history->frameCalls               = 0;
+    }
+    s_state.touched.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t FrameProfiler::GetFrameNumber()
+{
+    return s_state.frameNumber;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t FrameProfiler::GetHistoryFrames()
+{
+    return static_cast<uint32_t>(s_state.traceFrames.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sProfileScopeStats> FrameProfiler::GetScopeStats()
+{
+    std::vector<String> threadNames;
+    {
+        std::lock_guard lock(s_state.registryMutex);
+        for (std::shared_ptr<sThreadBuffer> const& buffer : s_state.threads)
+        {
+            threadNames.push_back(buffer->name);
+        }
+    }
+
+    std::vector<std::pair<uint32_t, sProfileScopeStats>> indexed;     // Thread index, stats
+    std::vector<float>                                   sorted;
+    indexed.reserve(s_state.histories.size());
+
+    for (auto const& [key, history] : s_state.histories)
+    {
+        if (history.count == 0)
+        {
+            continue;
+        }
+
+        uint32_t const windowFrames = static_cast<uint32_t>(history.samplesMs.size());
+        uint32_t const last         = (history.head + windowFrames - 1) % windowFrames;
+        uint64_t       totalCalls   = 0;
+
+        sorted.clear();
+        for (uint32_t i = 0; i < history.count; ++i)
+        {
+            uint32_t const slot = (history.head + windowFrames - 1 - i) % windowFrames;
+            sorted.push_back(history.samplesMs[slot]);
+            totalCalls += history.calls[slot];
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        sProfileScopeStats stats;
+        stats.name          = key.name;
+        stats.parent        = key.parent;
+        stats.threadName    = key.threadIndex < threadNames.size() ? threadNames[key.threadIndex] : String();
+        stats.samples       = history.count;
+        stats.callsPerFrame = static_cast<double>(totalCalls) / static_cast<double>(history.count);
+        stats.lastMs        = static_cast<double>(history.samplesMs[last]);
+        stats.p50Ms         = GetPercentile(sorted, 0.50);
+        stats.p95Ms         = GetPercentile(sorted, 0.95);
+        stats.p99Ms         = GetPercentile(sorted, 0.99);
+        stats.maxMs         = static_cast<double>(sorted.back());
+        indexed.emplace_back(key.threadIndex, std::move(stats));
+    }
+
+    std::sort(indexed.begin(), indexed.end(), [](auto const& a, auto const& b)
+    {
+        if (a.first != b.first) return a.first < b.first;
+        return a.second.p95Ms > b.second.p95Ms;
+    });
+
+    std::vector<sProfileScopeStats> result;
+    result.reserve(indexed.size());
+    for (auto& [threadIndex, stats] : indexed)
+    {
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FrameProfiler::SnapshotTrace(uint64_t const firstFrame, uint64_t const lastFrame, sProfileTrace& outTrace)
+{
+    outTrace = sProfileTrace();
+
+    bool isFound = false;
+    for (sTraceFrame const& frame : s_state.traceFrames)
+    {
+        if (frame.frameNumber < firstFrame || frame.frameNumber > lastFrame)
+        {
+            continue;
+        }
+
+        outTrace.firstFrame = isFound ? outTrace.firstFrame : frame.frameNumber;
+        outTrace.lastFrame  = frame.frameNumber;
+        outTrace.events.insert(outTrace.events.end(), frame.events.begin(), frame.events.end());
+        isFound = true;
+    }
+
+    std::lock_guard lock(s_state.registryMutex);
+    for (std::shared_ptr<sThreadBuffer> const& buffer : s_state.threads)
+    {
+        outTrace.threadNames.push_back(buffer->name);
+    }
+    return isFound;
+}
+
+//----------------------------------------------------------------------------------------------------
+// WriteChromeTrace
+//
+// Timestamps are microseconds from the earliest event, as trace_event expects; "X" events nest by
+// time on their thread, so the viewer rebuilds the scope hierarchy without explicit parents.
+//----------------------------------------------------------------------------------------------------
+uint64_t FrameProfiler::WriteChromeTrace(sProfileTrace const& trace, String const& filePath)
+{
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return 0;
+    }
+
+    int64_t baseNs = INT64_MAX;
+    for (sProfileTraceEvent const& event : trace.events)
+    {
+        baseNs = std::min(baseNs, event.startNs);
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << R"({"displayTimeUnit":"ms","otherData":{"firstFrame":)" << trace.firstFrame
+        << R"(,"lastFrame":)" << trace.lastFrame << R"(},"traceEvents":[)";
+
+    bool isFirst = true;
+    for (size_t i = 0; i < trace.threadNames.size(); ++i)
+    {
+        file << (isFirst ? "" : ",") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << i << R"(,"args":{"name":)";
+        WriteJsonString(file, trace.threadNames[i].c_str());
+        file << "}}";
+        isFirst = false;
+    }
+
+    for (sProfileTraceEvent const& event : trace.events)
+    {
+        file << (isFirst ? "" : ",") << R"({"name":)";
+        WriteJsonString(file, event.name);
+        file << R"(,"cat":"cpu","ph":"X","pid":1,"tid":)" << event.threadIndex
+            << R"(,"ts":)" << static_cast<double>(event.startNs - baseNs) / 1000.0
+            << R"(,"dur":)" << static_cast<double>(event.durationNs) / 1000.0 << "}";
+        isFirst = false;
+    }
+    file << "]}";
+
+    std::streamoff const bytes = file.tellp();
+    file.close();
+    return (file && bytes > 0) ? static_cast<uint64_t>(bytes) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+ProfileScope::ProfileScope(char const* name)
+{
+    if (name == nullptr || !FrameProfiler::IsEnabled())
+    {
+        return;
+    }
+
+    m_name         = name;
+    m_parent       = t_currentScope;
+    t_currentScope = name;
+    m_startNs      = GetNowNs();
+}
+
+//----------------------------------------------------------------------------------------------------
+ProfileScope::~ProfileScope()
+{
+    if (m_name == nullptr)
+    {
+        return;
+    }
+
+    int64_t const endNs = GetNowNs();
+    t_currentScope      = m_parent;
+    FrameProfiler::Record(m_name, m_parent, m_startNs, endNs);
+}
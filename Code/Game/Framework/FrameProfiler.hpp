@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------------------------------
+// FrameProfiler.hpp
+// Hierarchical CPU scope timers with rolling percentiles and Chrome trace_event export
+//
+// Purpose:
+//   game.get_engine_metrics reports FPS from a single Clock delta, which says a frame was slow but
+//   not where the time went. ProfileScope times a section of code on any thread; once per main
+//   frame EndFrame() folds every finished scope into per-scope histories (p50 / p95 / p99 over the
+//   last windowFrames frames) and, optionally, a raw event history that WriteChromeTrace() turns
+//   into a chrome://tracing / Perfetto file (game.get_profile, game.write_profile_trace).
+//
+// Design:
+//   - A scope is keyed by (name, parent scope, thread): the same function reached from two callers
+//     is reported twice, which is what makes the stats hierarchical. Names must outlive the
+//     profiler (string literals, or InternName() for runtime strings such as command types)
+//   - One sample per scope per main frame: the summed inclusive time of every call that finished
+//     during the frame, plus the call count. Worker scopes land in the main frame that collected
+//     them; their trace events keep real timestamps
+//   - Each thread appends to its own buffer (its mutex is contended only by EndFrame()'s swap), so
+//     recording never allocates once the buffers have grown to a frame's worth of events
+//   - Disabled (the default): ProfileScope is one relaxed atomic load, and InternName() is never
+//     reached because call sites check IsEnabled() first
+//
+// Thread Safety Model:
+//   - ProfileScope, IsEnabled(), InternName(), SetThreadName(): any thread
+//   - Configure(), SetEnabled(), Reset(), EndFrame(), GetScopeStats(), SnapshotTrace(): main thread
+//   - WriteChromeTrace(): any thread, on a snapshot
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sFrameProfilerConfig
+{
+    uint32_t windowFrames       = 300;     // Frames kept per scope for percentiles
+    uint32_t traceHistoryFrames = 600;     // Frames of raw events kept for traces (0 = no traces)
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sProfileScopeStats
+{
+    char const* name          = nullptr;
+    char const* parent        = nullptr;     // nullptr = outermost scope on its thread
+    String      threadName;
+    uint32_t    samples       = 0;           // Frames in the window where the scope ran
+    double      callsPerFrame = 0.0;
+    double      lastMs        = 0.0;
+    double      p50Ms         = 0.0;
+    double      p95Ms         = 0.0;
+    double      p99Ms         = 0.0;
+    double      maxMs         = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sProfileTraceEvent
+{
+    char const* name        = nullptr;
+    int64_t     startNs     = 0;            // steady_clock
+    int64_t     durationNs  = 0;
+    uint32_t    threadIndex = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sProfileTrace
+{
+    uint64_t                        firstFrame = 0;
+    uint64_t                        lastFrame  = 0;
+    std::vector<sProfileTraceEvent> events;
+    std::vector<String>             threadNames;     // Indexed by sProfileTraceEvent::threadIndex
+};
+
+//----------------------------------------------------------------------------------------------------
+namespace FrameProfiler
+{
+    void Configure(sFrameProfilerConfig const& config);
+
+    bool IsEnabled();
+    void SetEnabled(bool isEnabled);
+
+    // Drop every history and buffered event (frame numbers keep counting)
+    void Reset();
+
+    // Stable copy of a runtime name (only call while enabled: it takes a mutex)
+    char const* InternName(String const& name);
+
+    // Label for the calling thread in stats and traces ("Thread <n>" until set)
+    void SetThreadName(char const* name);
+
+    // Called by ~ProfileScope
+    void Record(char const* name, char const* parent, int64_t startNs, int64_t endNs);
+
+    // Close the current main frame: collect every thread's events and advance the frame number
+    void     EndFrame();
+    uint64_t GetFrameNumber();
+    uint32_t GetHistoryFrames();
+
+    // Sorted by thread, then by p95 descending
+    std::vector<sProfileScopeStats> GetScopeStats();
+
+    // Events of frames [firstFrame, lastFrame] still in the history; false if none are
+    bool SnapshotTrace(uint64_t firstFrame, uint64_t lastFrame, sProfileTrace& outTrace);
+
+    // trace_event JSON ("X" complete events plus thread_name metadata); returns the bytes written
+    uint64_t WriteChromeTrace(sProfileTrace const& trace, String const& filePath);
+}
+
+//----------------------------------------------------------------------------------------------------
+// ProfileScope
+//
+// Usage: ProfileScope const scope("App::Update");
+//        ProfileScope const scope(FrameProfiler::IsEnabled() ? FrameProfiler::InternName(type) : nullptr);
+// A nullptr name records nothing.
+//----------------------------------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+    explicit ProfileScope(char const* name);
+    ~ProfileScope();
+
+    ProfileScope(ProfileScope const&)            = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+private:
+    char const* m_name    = nullptr;     // nullptr = profiler was off when the scope opened
+    char const* m_parent  = nullptr;
+    int64_t     m_startNs = 0;
+};
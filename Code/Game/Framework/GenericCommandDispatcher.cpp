@@ -0,0 +1,433 @@
+//----------------------------------------------------------------------------------------------------
+// GenericCommandDispatcher.cpp
+// Thread affinity for GenericCommand handlers (main thread / any thread / I/O)
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/GenericCommandDispatcher.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// How long Shutdown() waits for in-flight jobs before abandoning their results
+static int constexpr SHUTDOWN_WAIT_ITERATIONS   = 500;
+static int constexpr SHUTDOWN_WAIT_MILLISECONDS = 10;
+
+//----------------------------------------------------------------------------------------------------
+struct sCommandCompletion
+{
+    eCommandAffinity      affinity = eCommandAffinity::MAIN_THREAD;
+    GenericCommand        command;
+    AsyncCommandResultPtr result;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sCommandCompletionChannel
+{
+    std::mutex                      mutex;
+    std::vector<sCommandCompletion> completions;
+};
+
+//----------------------------------------------------------------------------------------------------
+static double GetElapsedMs(std::chrono::steady_clock::time_point const since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+static HandlerResult RunWork(GenericCommandDispatcher::WorkFunction const& work, GenericCommand const& command)
+{
+    try
+    {
+        return work(command.payload);
+    }
+    catch (std::exception const& e)
+    {
+        return HandlerResult::Error(Stringf("ERR_HANDLER_EXCEPTION: %s threw: %s", command.type.c_str(), e.what()));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// GenericCommandJob
+//
+// Runs one command's work function on a JobSystem worker. The job is deleted by
+// App::ReclaimCompletedJobs() once ReleaseJob() recognises it; everything the main thread needs
+// travels through the completion channel.
+//----------------------------------------------------------------------------------------------------
+class GenericCommandJob : public Job
+{
+public:
+    GenericCommandJob(eCommandAffinity const affinity, GenericCommand const& command, GenericCommandDispatcher::WorkFunction work,
+                      std::shared_ptr<sCommandCompletionChannel> channel)
+        : m_affinity(affinity),
+          m_command(command),
+          m_work(std::move(work)),
+          m_channel(std::move(channel))
+    {
+    }
+
+    void Execute() override
+    {
+        auto const          start  = std::chrono::steady_clock::now();
+        HandlerResult const result = RunWork(m_work, m_command);
+
+        auto completedResult = std::make_shared<sAsyncCommandResult const>(sAsyncCommandResult{result, GetElapsedMs(start)});
+
+        std::lock_guard lock(m_channel->mutex);
+        m_channel->completions.push_back({m_affinity, std::move(m_command), std::move(completedResult)});
+    }
+
+private:
+    eCommandAffinity                           m_affinity;
+    GenericCommand                             m_command;
+    GenericCommandDispatcher::WorkFunction     m_work;
+    std::shared_ptr<sCommandCompletionChannel> m_channel;
+};
+
+//----------------------------------------------------------------------------------------------------
+char const* GetCommandAffinityName(eCommandAffinity const affinity)
+{
+    switch (affinity)
+    {
+    case eCommandAffinity::MAIN_THREAD: return "main";
+    case eCommandAffinity::ANY_THREAD:  return "anyThread";
+    case eCommandAffinity::IO:          return "io";
+    default:                            return "invalid";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+GenericCommandDispatcher::GenericCommandDispatcher(GenericCommandExecutor* executor, sGenericCommandDispatcherConfig const& config)
+    : m_executor(executor),
+      m_channel(std::make_shared<sCommandCompletionChannel>())
+{
+    m_lanes[static_cast<size_t>(eCommandAffinity::ANY_THREAD)].concurrency = std::max(config.anyThreadConcurrency, 1u);
+    m_lanes[static_cast<size_t>(eCommandAffinity::IO)].concurrency         = std::max(config.ioConcurrency, 1u);
+}
+
+//----------------------------------------------------------------------------------------------------
+GenericCommandDispatcher::~GenericCommandDispatcher()
+{
+    if (!m_isShutdown)
+    {
+        Shutdown();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// RegisterHandler
+//
+// The trampoline is what GenericCommandExecutor calls: with a delivered sAsyncCommandResult it just
+// returns the stored result, with the original payload it runs the work inline.
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::RegisterHandler(String const& type, eCommandAffinity const affinity, WorkFunction work)
+{
+    sHandler& handler = m_handlers[type];
+    handler.affinity      = affinity;
+    handler.isBarrier     = false;
+    handler.work          = work;
+    handler.deferredStart = nullptr;
+
+    m_executor->RegisterHandler(type, [work](std::any const& payload) -> HandlerResult
+    {
+        if (AsyncCommandResultPtr const* completed = std::any_cast<AsyncCommandResultPtr>(&payload))
+        {
+            return (*completed)->result;
+        }
+        return work(payload);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::RegisterBarrier(String const& type, eCommandAffinity const lane)
+{
+    sHandler& handler = m_handlers[type];
+    handler.affinity      = lane;
+    handler.isBarrier     = true;
+    handler.work          = nullptr;
+    handler.deferredStart = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::RegisterDeferredHandler(String const& type, DeferredStartFunction start, WorkFunction inlineWork)
+{
+    sHandler& handler     = m_handlers[type];
+    handler.affinity      = eCommandAffinity::MAIN_THREAD;
+    handler.isBarrier     = false;
+    handler.work          = nullptr;
+    handler.deferredStart = std::move(start);
+
+    m_executor->RegisterHandler(type, [inlineWork](std::any const& payload) -> HandlerResult
+    {
+        if (AsyncCommandResultPtr const* completed = std::any_cast<AsyncCommandResultPtr>(&payload))
+        {
+            return (*completed)->result;
+        }
+        return inlineWork(payload);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::CompleteDeferred(DeferredCommandToken const token, HandlerResult const& result, double const workMs)
+{
+    if (m_deferredCommands.find(token) == m_deferredCommands.end())
+    {
+        return;
+    }
+
+    m_deferredCompletions.push_back({token, std::make_shared<sAsyncCommandResult const>(sAsyncCommandResult{result, workMs})});
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::ContinueDeferred(DeferredCommandToken const token, eCommandAffinity const lane, WorkFunction work,
+                                                std::any payload)
+{
+    auto const found = m_deferredCommands.find(token);
+    if (found == m_deferredCommands.end())
+    {
+        return;
+    }
+
+    GenericCommand command = std::move(found->second);
+    m_deferredCommands.erase(found);
+    command.payload = std::move(payload);
+
+    if (lane == eCommandAffinity::MAIN_THREAD || m_isShutdown)
+    {
+        auto const          start  = std::chrono::steady_clock::now();
+        HandlerResult const result = RunWork(work, command);
+        DeliverResult(std::move(command), result, GetElapsedMs(start));
+        return;
+    }
+
+    m_lanes[static_cast<size_t>(lane)].queue.push_back({std::move(command), std::move(work), std::chrono::steady_clock::now()});
+    StartJobs(lane);
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::DeliverResult(GenericCommand command, HandlerResult const& result, double const workMs)
+{
+    command.payload = std::any(std::make_shared<sAsyncCommandResult const>(sAsyncCommandResult{result, workMs}));
+    m_executor->ExecuteCommand(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool GenericCommandDispatcher::TryDispatch(GenericCommand const& command)
+{
+    if (m_isShutdown)
+    {
+        return false;
+    }
+
+    auto const found = m_handlers.find(command.type);
+    if (found == m_handlers.end())
+    {
+        return false;
+    }
+
+    sHandler const& handler = found->second;
+
+    // The command is parked before start runs, so start may complete its token immediately
+    if (handler.deferredStart)
+    {
+        DeferredCommandToken const token = m_nextDeferredToken++;
+        m_deferredCommands.emplace(token, command);
+        handler.deferredStart(command.payload, token);
+        return true;
+    }
+
+    if (handler.affinity == eCommandAffinity::MAIN_THREAD)
+    {
+        return false;
+    }
+
+    sLane& lane = m_lanes[static_cast<size_t>(handler.affinity)];
+
+    // A barrier behind an idle lane has nothing to wait for
+    if (handler.isBarrier && lane.queue.empty() && lane.inFlight == 0)
+    {
+        return false;
+    }
+
+    lane.queue.push_back({command, handler.isBarrier ? WorkFunction() : handler.work, std::chrono::steady_clock::now()});
+    StartJobs(handler.affinity);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// StartJobs
+//
+// Strict FIFO per lane: a barrier at the head blocks later work until the lane has drained, and
+// work never starts ahead of an earlier barrier.
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::StartJobs(eCommandAffinity const affinity)
+{
+    sLane& lane = m_lanes[static_cast<size_t>(affinity)];
+
+    while (!lane.queue.empty())
+    {
+        sTask& task = lane.queue.front();
+
+        if (!task.work)
+        {
+            if (lane.inFlight > 0)
+            {
+                break;
+            }
+
+            GenericCommand const command = std::move(task.command);
+            lane.queue.pop_front();
+            ++lane.stats.barriers;
+            m_executor->ExecuteCommand(command);
+            continue;
+        }
+
+        if (lane.inFlight >= lane.concurrency)
+        {
+            break;
+        }
+
+        lane.stats.maxQueueMs = std::max(lane.stats.maxQueueMs, GetElapsedMs(task.queuedTime));
+        ++lane.inFlight;
+        ++lane.stats.dispatched;
+
+        Job* const job = new GenericCommandJob(affinity, task.command, std::move(task.work), m_channel);
+        m_submittedJobs.insert(job);
+        g_jobSystem->SubmitJob(job);
+        lane.queue.pop_front();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::Update()
+{
+    std::vector<sCommandCompletion> completions;
+    {
+        std::lock_guard lock(m_channel->mutex);
+        completions.swap(m_channel->completions);
+    }
+
+    for (sCommandCompletion& completion : completions)
+    {
+        sLane& lane = m_lanes[static_cast<size_t>(completion.affinity)];
+        --lane.inFlight;
+        ++lane.stats.completed;
+        lane.stats.lastWorkMs = completion.result->workMs;
+        lane.stats.maxWorkMs  = std::max(lane.stats.maxWorkMs, completion.result->workMs);
+
+        GenericCommand delivered = std::move(completion.command);
+        delivered.payload        = std::any(completion.result);
+        m_executor->ExecuteCommand(delivered);
+    }
+
+    DeliverDeferred();
+
+    StartJobs(eCommandAffinity::ANY_THREAD);
+    StartJobs(eCommandAffinity::IO);
+}
+
+//----------------------------------------------------------------------------------------------------
+// DeliverDeferred
+//
+// Completions raised while delivering (or by a later start) wait for the next call.
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::DeliverDeferred()
+{
+    std::vector<sDeferredCompletion> completions;
+    completions.swap(m_deferredCompletions);
+
+    for (sDeferredCompletion& completion : completions)
+    {
+        auto const found = m_deferredCommands.find(completion.token);
+        if (found == m_deferredCommands.end())
+        {
+            continue;
+        }
+
+        GenericCommand delivered = std::move(found->second);
+        m_deferredCommands.erase(found);
+        delivered.payload = std::any(completion.result);
+        m_executor->ExecuteCommand(delivered);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenericCommandDispatcher::Shutdown()
+{
+    auto const hasInFlight = [this]()
+    {
+        return m_lanes[static_cast<size_t>(eCommandAffinity::ANY_THREAD)].inFlight > 0 ||
+               m_lanes[static_cast<size_t>(eCommandAffinity::IO)].inFlight > 0;
+    };
+
+    for (int wait = 0; wait < SHUTDOWN_WAIT_ITERATIONS && hasInFlight(); ++wait)
+    {
+        Update();
+        if (hasInFlight())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SHUTDOWN_WAIT_MILLISECONDS));
+        }
+    }
+
+    if (hasInFlight())
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Warning, "GenericCommandDispatcher: Shutdown timed out with jobs in flight, their results are dropped");
+    }
+
+    m_isShutdown = true;
+
+    // Deferred commands whose owner never completed them still get a callback
+    DeliverDeferred();
+    for (auto const& [token, command] : m_deferredCommands)
+    {
+        CompleteDeferred(token, HandlerResult::Error(Stringf("ERR_SHUTDOWN: %s did not complete before shutdown", command.type.c_str())), 0.0);
+    }
+    DeliverDeferred();
+
+    // Whatever never got a job runs inline so its callback still fires, in lane order. The work runs
+    // here rather than through the trampoline because a continued deferred command no longer carries
+    // its original payload
+    for (sLane& lane : m_lanes)
+    {
+        while (!lane.queue.empty())
+        {
+            sTask task = std::move(lane.queue.front());
+            lane.queue.pop_front();
+
+            if (!task.work)
+            {
+                m_executor->ExecuteCommand(task.command);
+                continue;
+            }
+
+            auto const          start  = std::chrono::steady_clock::now();
+            HandlerResult const result = RunWork(task.work, task.command);
+            DeliverResult(std::move(task.command), result, GetElapsedMs(start));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+eCommandAffinity GenericCommandDispatcher::GetAffinity(String const& type) const
+{
+    auto const found = m_handlers.find(type);
+    return (found == m_handlers.end() || found->second.isBarrier) ? eCommandAffinity::MAIN_THREAD : found->second.affinity;
+}
+
+//----------------------------------------------------------------------------------------------------
+sCommandLaneStats GenericCommandDispatcher::GetLaneStats(eCommandAffinity const affinity) const
+{
+    sLane const&      lane  = m_lanes[static_cast<size_t>(affinity)];
+    sCommandLaneStats stats = lane.stats;
+    stats.concurrency       = lane.concurrency;
+    stats.inFlight          = lane.inFlight;
+    stats.queued            = static_cast<uint32_t>(lane.queue.size());
+    return stats;
+}
@@ -0,0 +1,205 @@
+//----------------------------------------------------------------------------------------------------
+// GenericCommandDispatcher.hpp
+// Thread affinity for GenericCommand handlers (main thread / any thread / I/O)
+//
+// Purpose:
+//   App::ProcessGenericCommands() runs every handler serially on the main thread, so one command
+//   that reads a file or walks a directory delays every entity/camera command queued behind it and
+//   the frame that follows. Handlers whose work does not touch main-thread state can instead declare
+//   ANY_THREAD or IO affinity; the dispatcher runs them as JobSystem jobs and the main thread only
+//   delivers the finished HandlerResult.
+//
+// Design:
+//   - MAIN_THREAD (default): executed inline by GenericCommandExecutor, exactly as before
+//   - ANY_THREAD / IO: TryDispatch() keeps a copy of the command and queues it on its affinity lane;
+//     Update() starts jobs up to the lane's concurrency limit. IO defaults to one job in flight so
+//     disk commands stay in submission order and never occupy more than one worker
+//   - Delivery: Update() re-submits each finished command to GenericCommandExecutor with its payload
+//     replaced by the sAsyncCommandResult. The trampoline installed by RegisterHandler() returns the
+//     stored result, so callbacks, audit logging and statistics all take the executor's normal path.
+//     The executor's per-agent rate limit is therefore applied at delivery, after the work ran
+//   - A command that reaches the trampoline with its original payload (dispatcher disabled, lane
+//     shut down) runs synchronously, so registering through the dispatcher never changes results
+//   - Results of async commands can overtake later main-thread commands. A main-thread command that
+//     must observe a lane's effects (game.execute_file after game.create_script_file) is registered
+//     as a barrier: it still runs on the main thread, but only once everything queued on that lane
+//     before it has finished (immediately when the lane is idle)
+//   - Deferred handlers (load_model) start on the main thread and finish whenever their owner calls
+//     CompleteDeferred(), typically from another system's completion callback. The command is held
+//     until then and delivered on the next Update() like a lane result; inlineWork is the
+//     synchronous fallback used when the dispatcher is bypassed. ContinueDeferred() instead hands the
+//     rest of the work to a lane (game.capture_screenshot: capture on the main thread, read back and
+//     encode on IO)
+//
+// Thread Safety Model:
+//   - RegisterHandler(), TryDispatch(), CompleteDeferred(), Update(), Shutdown(), GetLaneStats():
+//     main thread
+//   - Jobs run a handler's work function on a JobSystem worker and publish the result through a
+//     mutex-guarded completion channel
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/GenericCommand.hpp"
+#include "Engine/Core/GenericCommandExecutor.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <any>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class Job;
+struct sCommandCompletionChannel;
+
+//----------------------------------------------------------------------------------------------------
+enum class eCommandAffinity : uint8_t
+{
+    MAIN_THREAD,
+    ANY_THREAD,      // CPU work (parsing, encoding) on any JobSystem worker
+    IO,              // File system work, serialized per lane
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+char const* GetCommandAffinityName(eCommandAffinity affinity);
+
+//----------------------------------------------------------------------------------------------------
+// Payload of a command re-submitted by GenericCommandDispatcher::Update()
+//----------------------------------------------------------------------------------------------------
+struct sAsyncCommandResult
+{
+    HandlerResult result;
+    double        workMs = 0.0;
+};
+
+using AsyncCommandResultPtr = std::shared_ptr<sAsyncCommandResult const>;
+
+using DeferredCommandToken = uint64_t;
+
+//----------------------------------------------------------------------------------------------------
+struct sCommandLaneStats
+{
+    uint32_t concurrency = 0;
+    uint32_t inFlight    = 0;
+    uint32_t queued      = 0;
+    uint64_t dispatched  = 0;
+    uint64_t completed   = 0;
+    uint64_t barriers    = 0;      // Main-thread commands that waited for this lane
+    double   lastWorkMs  = 0.0;
+    double   maxWorkMs   = 0.0;
+    double   maxQueueMs  = 0.0;      // Longest wait between TryDispatch() and job start
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sGenericCommandDispatcherConfig
+{
+    uint32_t anyThreadConcurrency = 2;
+    uint32_t ioConcurrency        = 1;
+};
+
+//----------------------------------------------------------------------------------------------------
+class GenericCommandDispatcher
+{
+public:
+    using WorkFunction          = std::function<HandlerResult(std::any const& payload)>;
+    using DeferredStartFunction = std::function<void(std::any const& payload, DeferredCommandToken token)>;
+
+    GenericCommandDispatcher(GenericCommandExecutor* executor, sGenericCommandDispatcherConfig const& config);
+    ~GenericCommandDispatcher();
+
+    GenericCommandDispatcher(GenericCommandDispatcher const&)            = delete;
+    GenericCommandDispatcher& operator=(GenericCommandDispatcher const&) = delete;
+
+    // Register with the executor. ANY_THREAD / IO work must only touch thread-safe state
+    void RegisterHandler(String const& type, eCommandAffinity affinity, WorkFunction work);
+
+    // Keep an inline (main-thread) handler ordered behind the given lane
+    void RegisterBarrier(String const& type, eCommandAffinity lane);
+
+    // Main-thread handler whose result arrives later through CompleteDeferred(token). start must
+    // eventually complete its token (immediately for validation errors)
+    void RegisterDeferredHandler(String const& type, DeferredStartFunction start, WorkFunction inlineWork);
+
+    // Deliver a deferred command's result on the next Update()
+    void CompleteDeferred(DeferredCommandToken token, HandlerResult const& result, double workMs);
+
+    // Finish a deferred command on a lane: work(payload) runs as a job and its result is delivered
+    // like any lane result
+    void ContinueDeferred(DeferredCommandToken token, eCommandAffinity lane, WorkFunction work, std::any payload);
+
+    // True if the command was taken over (ANY_THREAD / IO, deferred, or a barrier behind a busy
+    // lane); false = execute inline
+    bool TryDispatch(GenericCommand const& command);
+
+    // Start queued jobs and deliver finished results through the executor
+    void Update();
+
+    // Wait for in-flight jobs, run still-queued commands inline and deliver everything; later
+    // commands execute inline
+    void Shutdown();
+
+    eCommandAffinity  GetAffinity(String const& type) const;
+    sCommandLaneStats GetLaneStats(eCommandAffinity affinity) const;
+    uint32_t          GetPendingDeferredCount() const { return static_cast<uint32_t>(m_deferredCommands.size()); }
+
+    // Jobs this dispatcher submitted that App::ReclaimCompletedJobs() has not deleted yet.
+    // ReleaseJob() returns true (and forgets the job) only for those; the caller then deletes it
+    bool HasSubmittedJobs() const { return !m_submittedJobs.empty(); }
+    bool ReleaseJob(Job const* job) { return m_submittedJobs.erase(job) > 0; }
+
+private:
+    struct sTask
+    {
+        GenericCommand                        command;
+        WorkFunction                          work;           // Empty for barriers
+        std::chrono::steady_clock::time_point queuedTime;
+    };
+
+    struct sLane
+    {
+        uint32_t          concurrency = 1;
+        uint32_t          inFlight    = 0;
+        std::deque<sTask> queue;
+        sCommandLaneStats stats;
+    };
+
+    struct sHandler
+    {
+        eCommandAffinity      affinity  = eCommandAffinity::MAIN_THREAD;
+        bool                  isBarrier = false;
+        WorkFunction          work;
+        DeferredStartFunction deferredStart;      // Set for deferred handlers
+    };
+
+    struct sDeferredCompletion
+    {
+        DeferredCommandToken  token = 0;
+        AsyncCommandResultPtr result;
+    };
+
+    void StartJobs(eCommandAffinity affinity);
+    void DeliverDeferred();
+    void DeliverResult(GenericCommand command, HandlerResult const& result, double workMs);
+
+    GenericCommandExecutor*              m_executor = nullptr;
+    std::unordered_map<String, sHandler> m_handlers;
+    sLane                                m_lanes[static_cast<size_t>(eCommandAffinity::COUNT)];
+    bool                                 m_isShutdown = false;
+
+    std::unordered_map<DeferredCommandToken, GenericCommand> m_deferredCommands;     // Started, not yet completed
+    std::vector<sDeferredCompletion>                         m_deferredCompletions;
+    DeferredCommandToken                                     m_nextDeferredToken = 1;
+    std::unordered_set<Job const*>                           m_submittedJobs;
+
+    // Finished jobs (GenericCommandDispatcher.cpp); shared so a job that outlives a Shutdown()
+    // timeout still publishes into valid memory
+    std::shared_ptr<sCommandCompletionChannel> m_channel;
+};
@@ -0,0 +1,198 @@
+//----------------------------------------------------------------------------------------------------
+// GpuMeshCache.cpp
+// Immutable GPU vertex/index buffers per MeshHandle, evicted under a VRAM budget
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/GpuMeshCache.hpp"
+
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+GpuMeshCache::GpuMeshCache(Renderer* renderer, size_t const budgetBytes)
+    : m_renderer(renderer),
+      m_budgetBytes(budgetBytes)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+GpuMeshCache::~GpuMeshCache()
+{
+    ReleaseAll();
+}
+
+//----------------------------------------------------------------------------------------------------
+sGpuMesh const* GpuMeshCache::Acquire(MeshHandle const handle, sMeshHandleEntry const& mesh, uint64_t const frameNumber)
+{
+    if (!m_renderer || handle == INVALID_MESH_HANDLE)
+    {
+        return nullptr;
+    }
+
+    if (handle >= m_meshes.size())
+    {
+        m_meshes.resize(handle + 1);
+    }
+
+    sGpuMesh& gpuMesh = m_meshes[handle];
+    if (gpuMesh.IsResident())
+    {
+        ++m_hitCount;
+    }
+    else
+    {
+        ++m_missCount;
+        Upload(gpuMesh, mesh);
+        if (!gpuMesh.IsResident())
+        {
+            return nullptr;
+        }
+    }
+
+    gpuMesh.lastUsedFrame = frameNumber;
+    return &gpuMesh;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GpuMeshCache::Draw(sGpuMesh const& gpuMesh) const
+{
+    if (gpuMesh.indexBuffer)
+    {
+        m_renderer->DrawIndexedVertexBuffer(gpuMesh.vertexBuffer, gpuMesh.indexBuffer, gpuMesh.indexCount);
+    }
+    else
+    {
+        m_renderer->DrawVertexBuffer(gpuMesh.vertexBuffer, gpuMesh.vertexCount);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// EnforceBudget
+//
+// Candidates are sorted oldest-first only when the budget is exceeded, so the common in-budget case
+// is a single comparison per frame.
+//----------------------------------------------------------------------------------------------------
+void GpuMeshCache::EnforceBudget(uint64_t const frameNumber)
+{
+    if (m_budgetBytes == 0 || m_residentBytes <= m_budgetBytes)
+    {
+        return;
+    }
+
+    m_evictionCandidates.clear();
+    for (sGpuMesh& gpuMesh : m_meshes)
+    {
+        if (gpuMesh.IsResident() && gpuMesh.lastUsedFrame != frameNumber)
+        {
+            m_evictionCandidates.push_back(&gpuMesh);
+        }
+    }
+
+    std::sort(m_evictionCandidates.begin(), m_evictionCandidates.end(),
+              [](sGpuMesh const* a, sGpuMesh const* b) { return a->lastUsedFrame < b->lastUsedFrame; });
+
+    for (sGpuMesh* gpuMesh : m_evictionCandidates)
+    {
+        if (m_residentBytes <= m_budgetBytes) break;
+
+        Release(*gpuMesh);
+        ++m_evictionCount;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void GpuMeshCache::ReleaseAll()
+{
+    for (sGpuMesh& gpuMesh : m_meshes)
+    {
+        Release(gpuMesh);
+    }
+    m_meshes.clear();
+    m_evictionCandidates.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Upload
+//
+// Nothing is copied into a buffer that failed to create; on any failure the mesh stays non-resident
+// (a created vertex buffer is deleted again) so Acquire() hands the draw to the streamed path.
+//----------------------------------------------------------------------------------------------------
+void GpuMeshCache::Upload(sGpuMesh& gpuMesh, sMeshHandleEntry const& mesh)
+{
+    if (mesh.isModel)
+    {
+        if (!mesh.model || mesh.model->vertices.empty())
+        {
+            return;
+        }
+
+        unsigned int const  vertexBytes  = static_cast<unsigned int>(mesh.model->vertices.size() * sizeof(Vertex_PCUTBN));
+        VertexBuffer* const vertexBuffer = m_renderer->CreateVertexBuffer(vertexBytes, sizeof(Vertex_PCUTBN));
+        if (!vertexBuffer)
+        {
+            return;
+        }
+
+        IndexBuffer*       indexBuffer = nullptr;
+        unsigned int const indexBytes  = static_cast<unsigned int>(mesh.model->indices.size() * sizeof(unsigned int));
+        if (!mesh.model->indices.empty())
+        {
+            indexBuffer = m_renderer->CreateIndexBuffer(indexBytes, sizeof(unsigned int));
+            if (!indexBuffer)
+            {
+                delete vertexBuffer;
+                return;
+            }
+            m_renderer->CopyCPUToGPU(mesh.model->indices.data(), indexBytes, indexBuffer);
+        }
+        m_renderer->CopyCPUToGPU(mesh.model->vertices.data(), vertexBytes, vertexBuffer);
+
+        gpuMesh.vertexBuffer = vertexBuffer;
+        gpuMesh.indexBuffer  = indexBuffer;
+        gpuMesh.vertexCount  = static_cast<unsigned int>(mesh.model->vertices.size());
+        gpuMesh.indexCount   = static_cast<unsigned int>(mesh.model->indices.size());
+        gpuMesh.byteSize     = vertexBytes + indexBytes;
+    }
+    else
+    {
+        if (!mesh.primitive || mesh.primitive->empty())
+        {
+            return;
+        }
+
+        unsigned int const  vertexBytes  = static_cast<unsigned int>(mesh.primitive->size() * sizeof(Vertex_PCU));
+        VertexBuffer* const vertexBuffer = m_renderer->CreateVertexBuffer(vertexBytes, sizeof(Vertex_PCU));
+        if (!vertexBuffer)
+        {
+            return;
+        }
+        m_renderer->CopyCPUToGPU(mesh.primitive->data(), vertexBytes, vertexBuffer);
+
+        gpuMesh.vertexBuffer = vertexBuffer;
+        gpuMesh.vertexCount  = static_cast<unsigned int>(mesh.primitive->size());
+        gpuMesh.byteSize     = vertexBytes;
+    }
+
+    m_residentBytes += gpuMesh.byteSize;
+    ++m_residentCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GpuMeshCache::Release(sGpuMesh& gpuMesh)
+{
+    if (!gpuMesh.IsResident())
+    {
+        return;
+    }
+
+    delete gpuMesh.vertexBuffer;
+    delete gpuMesh.indexBuffer;
+
+    m_residentBytes -= gpuMesh.byteSize;
+    --m_residentCount;
+
+    gpuMesh = sGpuMesh();
+}
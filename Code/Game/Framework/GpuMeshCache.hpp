@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------------------------------
+// GpuMeshCache.hpp
+// Immutable GPU vertex/index buffers per MeshHandle, evicted under a VRAM budget
+//
+// Purpose:
+//   DrawVertexArray() streams the CPU-side MeshCache vertices to the GPU on every draw. This cache
+//   uploads each MeshHandle once — per (meshType, radius) for primitives, per OBJ path for models —
+//   and the render loop only binds and draws the resident buffers.
+//
+// Eviction:
+//   - Each entry records the frame it was last drawn; after the frame, if resident bytes exceed the
+//     budget, least-recently-used entries not drawn this frame are released (MeshCache keeps the CPU
+//     copy, so an evicted mesh is simply re-uploaded on its next draw)
+//   - A budget of 0 disables eviction
+//
+// Notes:
+//   - A failed buffer creation leaves the mesh non-resident: Acquire() returns nullptr and the caller
+//     streams the CPU vertices for that draw; the upload is retried on the next draw
+//
+// Thread Safety Model:
+//   - Main thread only (RenderEntities() and App::Shutdown())
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/MeshHandleTable.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class IndexBuffer;
+class Renderer;
+class VertexBuffer;
+
+//----------------------------------------------------------------------------------------------------
+struct sGpuMesh
+{
+    VertexBuffer* vertexBuffer  = nullptr;
+    IndexBuffer*  indexBuffer   = nullptr;     // Models only
+    unsigned int  vertexCount   = 0;
+    unsigned int  indexCount    = 0;
+    size_t        byteSize      = 0;
+    uint64_t      lastUsedFrame = 0;
+
+    bool IsResident() const { return vertexBuffer != nullptr; }
+};
+
+//----------------------------------------------------------------------------------------------------
+class GpuMeshCache
+{
+public:
+    GpuMeshCache(Renderer* renderer, size_t budgetBytes);
+    ~GpuMeshCache();
+
+    GpuMeshCache(GpuMeshCache const&)            = delete;
+    GpuMeshCache& operator=(GpuMeshCache const&) = delete;
+
+    // Return the resident buffers for a resolved MeshHandleTable entry, uploading on a miss
+    sGpuMesh const* Acquire(MeshHandle handle, sMeshHandleEntry const& mesh, uint64_t frameNumber);
+
+    // Draw a mesh returned by Acquire() with the currently bound model constants and texture
+    void Draw(sGpuMesh const& gpuMesh) const;
+
+    // Release least-recently-used meshes (not used this frame) until within budget
+    void EnforceBudget(uint64_t frameNumber);
+
+    void ReleaseAll();
+
+    size_t   GetBudgetBytes() const { return m_budgetBytes; }
+    size_t   GetResidentBytes() const { return m_residentBytes; }
+    uint32_t GetResidentCount() const { return m_residentCount; }
+    uint64_t GetHitCount() const { return m_hitCount; }
+    uint64_t GetMissCount() const { return m_missCount; }
+    uint64_t GetEvictionCount() const { return m_evictionCount; }
+
+private:
+    void Upload(sGpuMesh& gpuMesh, sMeshHandleEntry const& mesh);
+    void Release(sGpuMesh& gpuMesh);
+
+    Renderer*              m_renderer      = nullptr;
+    std::vector<sGpuMesh>  m_meshes;                   // Indexed by MeshHandle
+    std::vector<sGpuMesh*> m_evictionCandidates;       // EnforceBudget() scratch (keeps capacity)
+    size_t                 m_budgetBytes   = 0;
+    size_t                 m_residentBytes = 0;
+    uint32_t               m_residentCount = 0;
+
+    uint64_t m_hitCount      = 0;
+    uint64_t m_missCount     = 0;
+    uint64_t m_evictionCount = 0;
+};
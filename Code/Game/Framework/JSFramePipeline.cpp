@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------------------------------
+// JSFramePipeline.cpp
+// Fixed-depth ring of completed JavaScript frames (pipelined worker mode)
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/JSFramePipeline.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+// Smoothing factor for the latency moving average (~20 frame window)
+static double constexpr LATENCY_EMA_ALPHA = 0.05;
+
+//----------------------------------------------------------------------------------------------------
+JSFramePipeline::JSFramePipeline(uint32_t const depth)
+    : m_slots(std::clamp(depth, MIN_DEPTH, MAX_DEPTH))
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JSFramePipeline::BeginWrite()
+{
+    std::unique_lock lock(m_mutex);
+
+    if (!m_isShutdown && m_completedCount == m_slots.size())
+    {
+        ++m_workerStalls;
+        m_slotFreeCV.wait(lock, [this]()
+        {
+            return m_isShutdown || m_completedCount < m_slots.size();
+        });
+    }
+
+    return !m_isShutdown;
+}
+
+//----------------------------------------------------------------------------------------------------
+// EndWrite
+//
+// The write slot is never visible to the main thread until m_completedCount includes it, so the
+// capture function runs without the mutex.
+//----------------------------------------------------------------------------------------------------
+void JSFramePipeline::EndWrite()
+{
+    sJSFrameSlot& slot = m_slots[m_writeIndex];
+
+    if (m_captureFunction)
+    {
+        m_captureFunction(slot);
+    }
+
+    std::lock_guard lock(m_mutex);
+    slot.frameIndex  = m_nextFrameIndex++;
+    slot.publishTime = std::chrono::steady_clock::now();
+
+    m_writeIndex = (m_writeIndex + 1) % static_cast<uint32_t>(m_slots.size());
+    ++m_completedCount;
+    ++m_publishedFrames;
+}
+
+//----------------------------------------------------------------------------------------------------
+sJSFrameSlot const* JSFramePipeline::PeekCompleted()
+{
+    std::lock_guard lock(m_mutex);
+    return (m_completedCount > 0) ? &m_slots[m_readIndex] : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSFramePipeline::ReleaseCompleted()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_completedCount == 0)
+        {
+            return;
+        }
+
+        double const latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_slots[m_readIndex].publishTime).count();
+
+        m_lastLatencyMs = latencyMs;
+        m_avgLatencyMs  = (m_consumedFrames == 0) ? latencyMs : m_avgLatencyMs + LATENCY_EMA_ALPHA * (latencyMs - m_avgLatencyMs);
+        m_maxLatencyMs  = std::max(m_maxLatencyMs, latencyMs);
+
+        m_readIndex = (m_readIndex + 1) % static_cast<uint32_t>(m_slots.size());
+        --m_completedCount;
+        ++m_consumedFrames;
+    }
+
+    m_slotFreeCV.notify_one();
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSFramePipeline::Shutdown()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_isShutdown = true;
+    }
+
+    m_slotFreeCV.notify_all();
+}
+
+//----------------------------------------------------------------------------------------------------
+sJSFramePipelineStats JSFramePipeline::GetStats() const
+{
+    std::lock_guard lock(m_mutex);
+
+    sJSFramePipelineStats stats;
+    stats.depth           = static_cast<uint32_t>(m_slots.size());
+    stats.occupancy       = m_completedCount;
+    stats.publishedFrames = m_publishedFrames;
+    stats.consumedFrames  = m_consumedFrames;
+    stats.workerStalls    = m_workerStalls;
+    stats.lastLatencyMs   = m_lastLatencyMs;
+    stats.avgLatencyMs    = m_avgLatencyMs;
+    stats.maxLatencyMs    = m_maxLatencyMs;
+    return stats;
+}
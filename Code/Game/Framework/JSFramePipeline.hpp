@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------------------------------
+// JSFramePipeline.hpp
+// Fixed-depth ring of completed JavaScript frames (pipelined worker mode)
+//
+// Purpose:
+//   In lockstep mode the worker only starts frame N+1 after the main thread saw frame N complete and
+//   called TriggerNextFrame(), so JS throughput is capped by the main loop's polling cadence. In
+//   pipelined mode the worker runs continuously at a target tick rate and publishes each finished
+//   frame's output into this ring; the main thread applies every completed frame (oldest first) and
+//   swaps once, so it always renders the newest completed snapshot.
+//
+// Design:
+//   - Single producer (JSGameLogicJob worker) / single consumer (App::Update), depth 2..8 slots
+//   - A slot holds what a JS frame leaves behind for the main thread: the typed command records.
+//     JSON GenericCommands keep flowing through GenericCommandQueue as before
+//   - A full ring blocks the worker (backpressure), counted as a worker stall
+//   - Latency = time from frame publish on the worker to ReleaseCompleted() on the main thread
+//
+// Thread Safety Model:
+//   - Worker Thread: BeginWrite() / EndWrite(); owns the write slot between the two calls
+//   - Main Thread: PeekCompleted() / ReleaseCompleted(); owns the read slot between the two calls
+//   - Indices and counters are protected by m_mutex; slot contents are never touched by both sides
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/TypedCommandBuffer.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sJSFrameSlot
+{
+    uint64_t                              frameIndex = 0;
+    std::chrono::steady_clock::time_point publishTime;
+    sTypedCommandFrame                    typedCommands;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sJSFramePipelineStats
+{
+    uint32_t depth           = 0;
+    uint32_t occupancy       = 0;      // Completed frames waiting for the main thread
+    uint64_t publishedFrames = 0;
+    uint64_t consumedFrames  = 0;
+    uint64_t workerStalls    = 0;      // BeginWrite() calls that found the ring full
+    double   lastLatencyMs   = 0.0;
+    double   avgLatencyMs    = 0.0;    // Exponential moving average
+    double   maxLatencyMs    = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class JSFramePipeline
+{
+public:
+    using CaptureFunction = std::function<void(sJSFrameSlot& slot)>;
+
+    static uint32_t constexpr MIN_DEPTH     = 2;
+    static uint32_t constexpr MAX_DEPTH     = 8;
+    static uint32_t constexpr DEFAULT_DEPTH = 3;
+
+    explicit JSFramePipeline(uint32_t depth);
+    ~JSFramePipeline() = default;
+
+    JSFramePipeline(JSFramePipeline const&)            = delete;
+    JSFramePipeline& operator=(JSFramePipeline const&) = delete;
+
+    // Fills a slot from the frame that just finished (e.g. TypedCommandBuffer::Capture)
+    // Thread Safety: Main thread only, before JSGameLogicJob is submitted
+    void SetCaptureFunction(CaptureFunction captureFunction) { m_captureFunction = std::move(captureFunction); }
+
+    //------------------------------------------------------------------------------------------------
+    // Worker Thread API
+    //------------------------------------------------------------------------------------------------
+
+    // Wait for a free slot; returns false once Shutdown() was called
+    bool BeginWrite();
+
+    // Run the capture function on the write slot and publish it to the main thread
+    void EndWrite();
+
+    //------------------------------------------------------------------------------------------------
+    // Main Thread API
+    //------------------------------------------------------------------------------------------------
+
+    // Oldest completed frame, or nullptr when none is waiting
+    sJSFrameSlot const* PeekCompleted();
+
+    // Hand the slot returned by PeekCompleted() back to the worker
+    void ReleaseCompleted();
+
+    //------------------------------------------------------------------------------------------------
+    // Lifecycle / Statistics
+    //------------------------------------------------------------------------------------------------
+
+    // Wake a worker blocked in BeginWrite(); Thread Safety: Any thread
+    void Shutdown();
+
+    uint32_t              GetDepth() const { return static_cast<uint32_t>(m_slots.size()); }
+    sJSFramePipelineStats GetStats() const;
+
+private:
+    mutable std::mutex        m_mutex;
+    std::condition_variable   m_slotFreeCV;
+    std::vector<sJSFrameSlot> m_slots;
+    CaptureFunction           m_captureFunction;
+
+    uint32_t m_writeIndex     = 0;
+    uint32_t m_readIndex      = 0;
+    uint32_t m_completedCount = 0;
+    uint64_t m_nextFrameIndex = 1;
+    bool     m_isShutdown     = false;
+
+    uint64_t m_publishedFrames = 0;
+    uint64_t m_consumedFrames  = 0;
+    uint64_t m_workerStalls    = 0;
+    double   m_lastLatencyMs   = 0.0;
+    double   m_avgLatencyMs    = 0.0;
+    double   m_maxLatencyMs    = 0.0;
+};
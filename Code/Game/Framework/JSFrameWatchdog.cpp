@@ -0,0 +1,152 @@
+//----------------------------------------------------------------------------------------------------
+// JSFrameWatchdog.cpp
+// Worker frame budget watchdog with staged JavaScript work shedding
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/JSFrameWatchdog.hpp"
+
+#include "Game/Framework/BinaryLogger.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+// Smoothing factor for the frame time moving average (~20 frame window)
+static double constexpr FRAME_EMA_ALPHA = 0.05;
+
+//----------------------------------------------------------------------------------------------------
+char const* GetJSWorkShedLevelName(eJSWorkShedLevel const level)
+{
+    switch (level)
+    {
+    case eJSWorkShedLevel::THROTTLE: return "throttle";
+    case eJSWorkShedLevel::REDUCE:   return "reduce";
+    default:                         return "none";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+JSFrameWatchdog::JSFrameWatchdog(sJSFrameWatchdogConfig const& config)
+    : m_config(config)
+{
+    m_config.frameBudgetMs          = std::max(m_config.frameBudgetMs, 0.1f);
+    m_config.overrunFramesToShed    = std::max(m_config.overrunFramesToShed, 1u);
+    m_config.restoreFramesToRecover = std::max(m_config.restoreFramesToRecover, 1u);
+    m_config.throttleInterval       = std::max(m_config.throttleInterval, 2u);
+    m_config.reducedInterval        = std::max(m_config.reducedInterval, m_config.throttleInterval);
+}
+
+//----------------------------------------------------------------------------------------------------
+// OnFrameCompleted
+//
+// One stage per streak: after escalating, the streak restarts so the next stage only kicks in if the
+// overrun persists with the lighter workload.
+//----------------------------------------------------------------------------------------------------
+bool JSFrameWatchdog::OnFrameCompleted(double const frameMs, uint32_t const tickCount)
+{
+    eJSWorkShedLevel const previousLevel = m_level;
+
+    m_isRunningFrameTerminated = false;
+    m_lastFrameMs              = frameMs;
+    m_avgFrameMs               = (m_avgFrameMs == 0.0) ? frameMs : m_avgFrameMs + (frameMs - m_avgFrameMs) * FRAME_EMA_ALPHA;
+    m_maxFrameMs               = std::max(m_maxFrameMs, frameMs);
+
+    if (m_level == eJSWorkShedLevel::THROTTLE) ++m_throttledFrames;
+    if (m_level == eJSWorkShedLevel::REDUCE) ++m_reducedFrames;
+
+    double const budgetMs = static_cast<double>(m_config.frameBudgetMs) * static_cast<double>(std::max(tickCount, 1u));
+    if (frameMs > budgetMs)
+    {
+        ++m_overrunFrames;
+        ++m_consecutiveOverruns;
+        m_consecutiveInBudget = 0;
+
+        if (m_consecutiveOverruns >= m_config.overrunFramesToShed && m_level != eJSWorkShedLevel::REDUCE)
+        {
+            SetLevel(static_cast<eJSWorkShedLevel>(static_cast<uint8_t>(m_level) + 1));
+            ++m_escalations;
+            m_consecutiveOverruns = 0;
+        }
+    }
+    else
+    {
+        ++m_consecutiveInBudget;
+        m_consecutiveOverruns = 0;
+
+        if (m_consecutiveInBudget >= m_config.restoreFramesToRecover && m_level != eJSWorkShedLevel::NONE)
+        {
+            SetLevel(static_cast<eJSWorkShedLevel>(static_cast<uint8_t>(m_level) - 1));
+            ++m_recoveries;
+            m_consecutiveInBudget = 0;
+        }
+    }
+
+    return m_level != previousLevel;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JSFrameWatchdog::CheckHang(double const runningFrameMs)
+{
+    if (m_config.hangTimeoutMs <= 0.f || m_isRunningFrameTerminated || runningFrameMs <= static_cast<double>(m_config.hangTimeoutMs))
+    {
+        return false;
+    }
+
+    m_isRunningFrameTerminated = true;
+    ++m_terminations;
+
+    DAEMON_LOG_FAST(LogScript, eLogVerbosity::Error,
+                    "JSFrameWatchdog: worker frame running %.1fms (limit %.1fms) - terminating execution (#%llu)",
+                    runningFrameMs, m_config.hangTimeoutMs, m_terminations);
+
+    if (m_level != eJSWorkShedLevel::REDUCE)
+    {
+        SetLevel(eJSWorkShedLevel::REDUCE);
+        ++m_escalations;
+    }
+    m_consecutiveOverruns = 0;
+    m_consecutiveInBudget = 0;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t JSFrameWatchdog::GetInterval() const
+{
+    switch (m_level)
+    {
+    case eJSWorkShedLevel::THROTTLE: return m_config.throttleInterval;
+    case eJSWorkShedLevel::REDUCE:   return m_config.reducedInterval;
+    default:                         return 1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSFrameWatchdog::SetLevel(eJSWorkShedLevel const level)
+{
+    bool const isEscalation = static_cast<uint8_t>(level) > static_cast<uint8_t>(m_level);
+    m_level                 = level;
+
+    DAEMON_LOG(LogScript, isEscalation ? eLogVerbosity::Warning : eLogVerbosity::Log,
+               Stringf("JSFrameWatchdog: work shedding -> %s (priority >= %d every %u frames, avg %.2fms / budget %.2fms)",
+                   GetJSWorkShedLevelName(level), m_config.shedMinPriority, GetInterval(), m_avgFrameMs, m_config.frameBudgetMs));
+}
+
+//----------------------------------------------------------------------------------------------------
+sJSFrameWatchdogStats JSFrameWatchdog::GetStats() const
+{
+    sJSFrameWatchdogStats stats;
+    stats.level               = m_level;
+    stats.interval            = GetInterval();
+    stats.lastFrameMs         = m_lastFrameMs;
+    stats.avgFrameMs          = m_avgFrameMs;
+    stats.maxFrameMs          = m_maxFrameMs;
+    stats.consecutiveOverruns = m_consecutiveOverruns;
+    stats.overrunFrames       = m_overrunFrames;
+    stats.throttledFrames     = m_throttledFrames;
+    stats.reducedFrames       = m_reducedFrames;
+    stats.escalations         = m_escalations;
+    stats.recoveries          = m_recoveries;
+    stats.terminations        = m_terminations;
+    return stats;
+}
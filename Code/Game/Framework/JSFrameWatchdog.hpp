@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------------------------------
+// JSFrameWatchdog.hpp
+// Worker frame budget watchdog with staged JavaScript work shedding
+//
+// Purpose:
+//   A JS frame that runs over budget used to show up only as the throttled frame-skip warning in
+//   App::Update(), and a hung frame stalled the simulation forever. The watchdog measures every
+//   completed worker frame against a budget and, on sustained overrun, sheds work in stages:
+//
+//     NONE      - every system runs every frame
+//     THROTTLE  - systems with priority >= shedMinPriority run every throttleInterval frames
+//     REDUCE    - the same systems run every reducedInterval frames
+//     TERMINATE - a frame still running after hangTimeoutMs is cut off with
+//                 v8::Isolate::TerminateExecution(); the job reports it through HandleV8Exception()
+//                 and the next frame starts normally, with shedding left at REDUCE
+//
+//   Skipped systems receive the accumulated delta when they next run (see JSEngine.update()), so
+//   shedding lowers their frequency without slowing their simulated time.
+//
+// Design:
+//   - Escalate one stage after overrunFramesToShed consecutive over-budget frames; restore one stage
+//     after restoreFramesToRecover consecutive in-budget frames
+//   - Budget scales with the tick count of a fixed-timestep catch-up frame
+//   - The shed policy reaches JS as globalThis.__workShed = {level, interval, minPriority}
+//
+// Thread Safety Model:
+//   - Main thread only (App::Update() and game.get_engine_metrics)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+enum class eJSWorkShedLevel : uint8_t
+{
+    NONE     = 0,
+    THROTTLE = 1,
+    REDUCE   = 2
+};
+
+char const* GetJSWorkShedLevelName(eJSWorkShedLevel level);
+
+//----------------------------------------------------------------------------------------------------
+struct sJSFrameWatchdogConfig
+{
+    float    frameBudgetMs          = 16.67f;
+    uint32_t overrunFramesToShed    = 30;      // Consecutive over-budget frames per escalation
+    uint32_t restoreFramesToRecover = 120;     // Consecutive in-budget frames per de-escalation
+    uint32_t throttleInterval       = 2;
+    uint32_t reducedInterval        = 4;
+    int32_t  shedMinPriority        = 90;      // JSEngine priorities 0-100, lower = earlier / more critical
+    float    hangTimeoutMs          = 500.f;   // 0 = never terminate
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sJSFrameWatchdogStats
+{
+    eJSWorkShedLevel level               = eJSWorkShedLevel::NONE;
+    uint32_t         interval            = 1;
+    double           lastFrameMs         = 0.0;
+    double           avgFrameMs          = 0.0;    // Exponential moving average
+    double           maxFrameMs          = 0.0;
+    uint32_t         consecutiveOverruns = 0;
+    uint64_t         overrunFrames       = 0;
+    uint64_t         throttledFrames     = 0;      // Frames completed at THROTTLE
+    uint64_t         reducedFrames       = 0;      // Frames completed at REDUCE
+    uint64_t         escalations         = 0;
+    uint64_t         recoveries          = 0;
+    uint64_t         terminations        = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class JSFrameWatchdog
+{
+public:
+    explicit JSFrameWatchdog(sJSFrameWatchdogConfig const& config);
+
+    // A worker frame finished; returns true when the shed level changed
+    bool OnFrameCompleted(double frameMs, uint32_t tickCount);
+
+    // Worker frame still running; returns true (once per frame) when it should be terminated.
+    // Termination also moves shedding straight to REDUCE.
+    bool CheckHang(double runningFrameMs);
+
+    eJSWorkShedLevel GetLevel() const { return m_level; }
+    uint32_t         GetInterval() const;
+    int32_t          GetMinPriority() const { return m_config.shedMinPriority; }
+    float            GetFrameBudgetMs() const { return m_config.frameBudgetMs; }
+
+    sJSFrameWatchdogStats GetStats() const;
+
+private:
+    void SetLevel(eJSWorkShedLevel level);
+
+    sJSFrameWatchdogConfig m_config;
+    eJSWorkShedLevel       m_level                    = eJSWorkShedLevel::NONE;
+    uint32_t               m_consecutiveOverruns      = 0;
+    uint32_t               m_consecutiveInBudget      = 0;
+    bool                   m_isRunningFrameTerminated = false;
+
+    double   m_lastFrameMs     = 0.0;
+    double   m_avgFrameMs      = 0.0;
+    double   m_maxFrameMs      = 0.0;
+    uint64_t m_overrunFrames   = 0;
+    uint64_t m_throttledFrames = 0;
+    uint64_t m_reducedFrames   = 0;
+    uint64_t m_escalations     = 0;
+    uint64_t m_recoveries      = 0;
+    uint64_t m_terminations    = 0;
+};
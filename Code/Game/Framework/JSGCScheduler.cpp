@@ -0,0 +1,335 @@
+//----------------------------------------------------------------------------------------------------
+// JSGCScheduler.cpp
+// Idle-time V8 garbage collection scheduling for the JavaScript worker
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/JSGCScheduler.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+// Suppress V8 header warnings (unreferenced formal parameters, etc.)
+#pragma warning(push)
+#pragma warning(disable: 4100)  // 'identifier': unreferenced formal parameter
+#pragma warning(disable: 4127)  // conditional expression is constant
+#pragma warning(disable: 4324)  // 'structname': structure was padded due to alignment specifier
+#include <v8.h>
+#include <v8-version.h>
+#pragma warning(pop)
+
+#include <algorithm>
+#include <sstream>
+
+//----------------------------------------------------------------------------------------------------
+// Upper bounds of the pause histogram buckets (the last bucket is open-ended)
+static double constexpr PAUSE_BUCKET_LIMITS_MS[sJSGCStats::PAUSE_BUCKETS - 1] = {0.5, 1.0, 2.0, 5.0, 10.0, 20.0};
+
+// Smoothing factor for the major pause moving average (~10 collection window)
+static double constexpr MAJOR_PAUSE_EMA_ALPHA = 0.1;
+
+static double constexpr BYTES_PER_MB = 1024.0 * 1024.0;
+
+// Only scavenges and full mark-compacts are timed; incremental marking steps are already sliced
+static v8::GCType constexpr TIMED_GC_TYPES = static_cast<v8::GCType>(v8::kGCTypeScavenge | v8::kGCTypeMarkSweepCompact);
+
+//----------------------------------------------------------------------------------------------------
+static void OnV8GCPrologue(v8::Isolate* isolate, v8::GCType const type, v8::GCCallbackFlags const flags, void* data)
+{
+    UNUSED(isolate)
+    UNUSED(flags)
+    static_cast<JSGCScheduler*>(data)->OnGCStarted(type == v8::kGCTypeMarkSweepCompact);
+}
+
+//----------------------------------------------------------------------------------------------------
+static void OnV8GCEpilogue(v8::Isolate* isolate, v8::GCType const type, v8::GCCallbackFlags const flags, void* data)
+{
+    UNUSED(isolate)
+    UNUSED(flags)
+    static_cast<JSGCScheduler*>(data)->OnGCFinished(type == v8::kGCTypeMarkSweepCompact);
+}
+
+//----------------------------------------------------------------------------------------------------
+static v8::MemoryPressureLevel ToMemoryPressureLevel(uint32_t const level)
+{
+    switch (level)
+    {
+    case 1:  return v8::MemoryPressureLevel::kModerate;
+    case 2:  return v8::MemoryPressureLevel::kCritical;
+    default: return v8::MemoryPressureLevel::kNone;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* sJSGCStats::GetPauseBucketLabel(uint32_t const bucket)
+{
+    static char const* const labels[PAUSE_BUCKETS] = {"lt0_5ms", "lt1ms", "lt2ms", "lt5ms", "lt10ms", "lt20ms", "ge20ms"};
+    return (bucket < PAUSE_BUCKETS) ? labels[bucket] : "invalid";
+}
+
+//----------------------------------------------------------------------------------------------------
+JSGCScheduler::JSGCScheduler(sJSGCSchedulerConfig const& config)
+    : m_config(config),
+      m_lastLogTime(std::chrono::steady_clock::now())
+{
+    m_config.heapSizeLimitMB       = std::max(m_config.heapSizeLimitMB, 16u);
+    m_config.minIdleMs             = std::max(m_config.minIdleMs, 0.f);
+    m_config.moderatePressureRatio = std::clamp(m_config.moderatePressureRatio, 0.05f, 1.f);
+    m_config.criticalPressureRatio = std::clamp(m_config.criticalPressureRatio, m_config.moderatePressureRatio, 1.f);
+
+    m_stats.heapSizeLimitMB = m_config.heapSizeLimitMB;
+}
+
+//----------------------------------------------------------------------------------------------------
+JSGCScheduler::~JSGCScheduler()
+{
+    if (m_isolate)
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, "JSGCScheduler: Destroyed while attached (call Detach() on the worker thread)");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSGCScheduler::Attach(v8::Isolate* isolate)
+{
+    m_isolate = isolate;
+    m_isolate->AddGCPrologueCallback(OnV8GCPrologue, this, TIMED_GC_TYPES);
+    m_isolate->AddGCEpilogueCallback(OnV8GCEpilogue, this, TIMED_GC_TYPES);
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log,
+               Stringf("JSGCScheduler: Attached (heapSizeLimit %uMB, pressure moderate %.0f%% / critical %.0f%%, idle >= %.1fms)",
+                   m_config.heapSizeLimitMB, m_config.moderatePressureRatio * 100.f, m_config.criticalPressureRatio * 100.f,
+                   m_config.minIdleMs));
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSGCScheduler::Detach()
+{
+    if (!m_isolate)
+    {
+        return;
+    }
+
+    SendPressureLevel(0);
+    m_isolate->RemoveGCPrologueCallback(OnV8GCPrologue, this);
+    m_isolate->RemoveGCEpilogueCallback(OnV8GCEpilogue, this);
+    m_isolate = nullptr;
+
+    LogSummary(GetStats());
+}
+
+//----------------------------------------------------------------------------------------------------
+// RunIdleTime
+//
+// V8 only acts on a pressure notification that raises the level (to kCritical, or kNone ->
+// kModerate), so each unit of work re-arms the level through kNone:
+//   - critical: a full collection, run synchronously here when the window is at least the average
+//     major pause (or after maxCriticalDefers windows that were too short, so a busy game cannot
+//     starve it). The level is then lowered to at most moderate, so collections V8 starts on its
+//     own mid-frame are not all memory-reducing full ones
+//   - moderate: incremental marking is (re)started here, at most once per major GC cycle, so the
+//     cycle begins between frames instead of at an allocation limit mid-update
+//----------------------------------------------------------------------------------------------------
+void JSGCScheduler::RunIdleTime(std::chrono::steady_clock::time_point const deadline)
+{
+    if (!m_isolate)
+    {
+        return;
+    }
+
+    auto const   now      = std::chrono::steady_clock::now();
+    double const idleMs   = std::chrono::duration<double, std::milli>(deadline - now).count();
+    double       pressure = SampleHeap();
+
+    bool const isIdleWindow = idleMs >= static_cast<double>(m_config.minIdleMs);
+    {
+        std::lock_guard lock(m_statsMutex);
+        if (isIdleWindow)
+        {
+            ++m_stats.idleWindows;
+            m_stats.idleMsOffered += idleMs;
+        }
+        else
+        {
+            ++m_stats.skippedWindows;
+        }
+    }
+
+    if (isIdleWindow)
+    {
+        m_isInIdleWindow = true;
+
+#if V8_MAJOR_VERSION < 12
+        // IdleNotificationDeadline() compares against the platform's MonotonicallyIncreasingTime(),
+        // which shares steady_clock's QueryPerformanceCounter time base on Windows
+        double const deadlineSeconds = std::chrono::duration<double>(deadline.time_since_epoch()).count();
+        m_isolate->IdleNotificationDeadline(deadlineSeconds);
+#endif
+
+        uint32_t const level = GetPressureLevel(pressure);
+        if (level == 2)
+        {
+            double const expectedPauseMs = GetStats().avgMajorPauseMs;
+            if (idleMs >= expectedPauseMs || m_criticalDeferrals >= m_config.maxCriticalDefers)
+            {
+                SendPressureLevel(0);
+                SendPressureLevel(2);     // Full collection, inside this window
+                m_criticalDeferrals = 0;
+                pressure            = SampleHeap();
+
+                {
+                    std::lock_guard lock(m_statsMutex);
+                    ++m_stats.idleCollections;
+                }
+                SendPressureLevel(std::min(GetPressureLevel(pressure), 1u));
+            }
+            else
+            {
+                ++m_criticalDeferrals;
+                SendPressureLevel(1);
+
+                std::lock_guard lock(m_statsMutex);
+                ++m_stats.criticalDefers;
+            }
+        }
+        else if (level == 1)
+        {
+            m_criticalDeferrals = 0;
+            if (!m_isMarkingStarted)
+            {
+                SendPressureLevel(0);
+                SendPressureLevel(1);     // Starts incremental marking if V8 is not already marking
+                m_isMarkingStarted = true;
+
+                std::lock_guard lock(m_statsMutex);
+                ++m_stats.markingStarts;
+            }
+        }
+        else
+        {
+            m_criticalDeferrals = 0;
+            SendPressureLevel(0);
+        }
+
+        m_isInIdleWindow = false;
+
+        std::lock_guard lock(m_statsMutex);
+        m_stats.idleMsUsed += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - now).count();
+    }
+
+    if (m_config.logIntervalSeconds > 0.f &&
+        std::chrono::duration<float>(now - m_lastLogTime).count() >= m_config.logIntervalSeconds)
+    {
+        m_lastLogTime = now;
+        LogSummary(GetStats());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Refresh the heap figures in the stats; returns used heap / heapSizeLimit
+//----------------------------------------------------------------------------------------------------
+double JSGCScheduler::SampleHeap()
+{
+    v8::HeapStatistics heapStatistics;
+    m_isolate->GetHeapStatistics(&heapStatistics);
+
+    double const heapUsedMB = static_cast<double>(heapStatistics.used_heap_size()) / BYTES_PER_MB;
+    double const pressure   = heapUsedMB / static_cast<double>(m_config.heapSizeLimitMB);
+
+    std::lock_guard lock(m_statsMutex);
+    m_stats.heapUsedMB   = heapUsedMB;
+    m_stats.heapTotalMB  = static_cast<double>(heapStatistics.total_heap_size()) / BYTES_PER_MB;
+    m_stats.heapPressure = pressure;
+    return pressure;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t JSGCScheduler::GetPressureLevel(double const pressure) const
+{
+    if (pressure >= static_cast<double>(m_config.criticalPressureRatio)) return 2;
+    if (pressure >= static_cast<double>(m_config.moderatePressureRatio)) return 1;
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSGCScheduler::SendPressureLevel(uint32_t const level)
+{
+    if (level == m_appliedLevel)
+    {
+        return;
+    }
+
+    m_isolate->MemoryPressureNotification(ToMemoryPressureLevel(level));
+    m_appliedLevel = level;
+
+    std::lock_guard lock(m_statsMutex);
+    m_stats.pressureLevel = level;
+    ++m_stats.pressureNotifications;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSGCScheduler::OnGCStarted(bool const isMajor)
+{
+    (isMajor ? m_majorStart : m_minorStart) = std::chrono::steady_clock::now();
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSGCScheduler::OnGCFinished(bool const isMajor)
+{
+    double const pauseMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - (isMajor ? m_majorStart : m_minorStart)).count();
+
+    uint32_t bucket = 0;
+    while (bucket < sJSGCStats::PAUSE_BUCKETS - 1 && pauseMs >= PAUSE_BUCKET_LIMITS_MS[bucket])
+    {
+        ++bucket;
+    }
+
+    std::lock_guard lock(m_statsMutex);
+    ++m_stats.pauseHistogram[bucket];
+    ++(isMajor ? m_stats.majorGCs : m_stats.minorGCs);
+    m_stats.lastPauseMs = pauseMs;
+    m_stats.maxPauseMs  = std::max(m_stats.maxPauseMs, pauseMs);
+    m_stats.totalPauseMs += pauseMs;
+
+    if (isMajor)
+    {
+        m_isMarkingStarted      = false;     // Cycle finished; moderate pressure may start the next one
+        m_stats.avgMajorPauseMs = (m_stats.majorGCs == 1) ? pauseMs : m_stats.avgMajorPauseMs + (pauseMs - m_stats.avgMajorPauseMs) * MAJOR_PAUSE_EMA_ALPHA;
+    }
+
+    if (m_isInIdleWindow)
+    {
+        ++m_stats.scheduledGCs;
+    }
+    else
+    {
+        ++m_stats.unscheduledGCs;
+        m_stats.maxUnscheduledPauseMs = std::max(m_stats.maxUnscheduledPauseMs, pauseMs);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sJSGCStats JSGCScheduler::GetStats() const
+{
+    std::lock_guard lock(m_statsMutex);
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSGCScheduler::LogSummary(sJSGCStats const& stats) const
+{
+    std::ostringstream histogram;
+    for (uint32_t bucket = 0; bucket < sJSGCStats::PAUSE_BUCKETS; ++bucket)
+    {
+        histogram << (bucket > 0 ? " " : "") << sJSGCStats::GetPauseBucketLabel(bucket) << "=" << stats.pauseHistogram[bucket];
+    }
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log,
+               Stringf("JSGCScheduler: heap %.1f/%.1fMB (limit %uMB, %.0f%%), GCs minor=%llu major=%llu scheduled=%llu unscheduled=%llu, idle collections=%llu marking starts=%llu, idle %.0f/%.0fms used, max pause %.2fms (unscheduled %.2fms)",
+                   stats.heapUsedMB, stats.heapTotalMB, stats.heapSizeLimitMB, stats.heapPressure * 100.0,
+                   stats.minorGCs, stats.majorGCs, stats.scheduledGCs, stats.unscheduledGCs,
+                   stats.idleCollections, stats.markingStarts, stats.idleMsUsed, stats.idleMsOffered,
+                   stats.maxPauseMs, stats.maxUnscheduledPauseMs));
+    DAEMON_LOG(LogScript, eLogVerbosity::Log,
+               Stringf("JSGCScheduler: pause histogram %s", histogram.str().c_str()));
+}
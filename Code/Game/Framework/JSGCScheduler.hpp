@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------------------------------
+// JSGCScheduler.hpp
+// Idle-time V8 garbage collection scheduling for the JavaScript worker
+//
+// Purpose:
+//   The only GC control used to be the `gc` global (App::OnGarbageCollection), a full blocking
+//   collection. Otherwise V8 collects whenever an allocation crosses its own limits, which lands in
+//   the middle of JSEngine.update() as a 5-15ms frame spike. The scheduler moves that work into the
+//   gap between worker frames: when a frame finishes under budget and heap pressure relative to
+//   heapSizeLimit (EngineSubsystems.json) is high enough, the collection work is started or run in
+//   that gap instead of being left to an allocation mid-update.
+//
+// Design:
+//   - RunIdleTime(deadline) after every worker frame; windows shorter than minIdleMs are skipped
+//   - Heap pressure = used heap / heapSizeLimit:
+//       < moderatePressureRatio  -> kNone
+//       < criticalPressureRatio  -> moderate: incremental marking is started in the window, once
+//                                   per major GC cycle
+//       otherwise                -> critical: a full collection runs inside the window when it is
+//                                   at least the average major pause, else after maxCriticalDefers
+//                                   windows that were too short
+//   - V8 13 has no deadline-based idle GC, and MemoryPressureNotification only acts when the level
+//     rises, so each of those is sent as kNone followed by the level (see RunIdleTime). V8 < 12
+//     additionally receives IdleNotificationDeadline()
+//   - idleMsUsed is the part of idleMsOffered actually spent in that GC work
+//   - GC prologue/epilogue callbacks time every scavenge / mark-compact into a pause histogram,
+//     split by whether it ran inside an idle window (scheduled) or during a frame (unscheduled)
+//   - Heap size and histogram are logged every logIntervalSeconds
+//
+// Thread Safety Model:
+//   - Attach(), Detach(), RunIdleTime(): worker thread with v8::Locker held
+//   - GC callbacks: whichever thread holds the isolate (worker, or main during hot reload)
+//   - GetStats(): any thread (m_statsMutex)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+//----------------------------------------------------------------------------------------------------
+namespace v8
+{
+class Isolate;
+}
+
+//----------------------------------------------------------------------------------------------------
+struct sJSGCSchedulerConfig
+{
+    uint32_t heapSizeLimitMB       = 256;      // EngineSubsystems.json subsystems.script.config.heapSizeLimit
+    float    minIdleMs             = 2.f;      // Shorter idle windows are left alone
+    float    moderatePressureRatio = 0.6f;
+    float    criticalPressureRatio = 0.85f;
+    uint32_t maxCriticalDefers     = 30;       // Idle windows a critical collection may wait for a long enough gap
+    float    logIntervalSeconds    = 30.f;     // 0 = no periodic log
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sJSGCStats
+{
+    static uint32_t constexpr PAUSE_BUCKETS = 7;     // <0.5, <1, <2, <5, <10, <20, >=20 ms
+
+    double   heapUsedMB             = 0.0;
+    double   heapTotalMB            = 0.0;
+    uint32_t heapSizeLimitMB        = 0;
+    double   heapPressure           = 0.0;    // heapUsedMB / heapSizeLimitMB
+    uint32_t pressureLevel          = 0;      // 0 = none, 1 = moderate, 2 = critical (last sent to V8)
+    uint64_t idleWindows            = 0;
+    uint64_t skippedWindows         = 0;      // Shorter than minIdleMs
+    double   idleMsOffered          = 0.0;
+    double   idleMsUsed             = 0.0;    // Spent collecting / starting marking inside idle windows
+    uint64_t idleCollections        = 0;      // Full collections run inside an idle window (critical)
+    uint64_t markingStarts          = 0;      // Incremental marking cycles started in an idle window (moderate)
+    uint64_t pressureNotifications  = 0;
+    uint64_t criticalDefers         = 0;      // Critical windows too short for a full collection
+    uint64_t minorGCs               = 0;
+    uint64_t majorGCs               = 0;
+    uint64_t scheduledGCs           = 0;      // Ran inside RunIdleTime()
+    uint64_t unscheduledGCs         = 0;      // Ran during a frame (the spikes this class exists for)
+    double   lastPauseMs            = 0.0;
+    double   maxPauseMs             = 0.0;
+    double   maxUnscheduledPauseMs  = 0.0;
+    double   avgMajorPauseMs        = 0.0;    // Exponential moving average
+    double   totalPauseMs           = 0.0;
+    std::array<uint64_t, PAUSE_BUCKETS> pauseHistogram = {};
+
+    static char const* GetPauseBucketLabel(uint32_t bucket);
+};
+
+//----------------------------------------------------------------------------------------------------
+class JSGCScheduler
+{
+public:
+    explicit JSGCScheduler(sJSGCSchedulerConfig const& config);
+    ~JSGCScheduler();
+
+    JSGCScheduler(JSGCScheduler const&)            = delete;
+    JSGCScheduler& operator=(JSGCScheduler const&) = delete;
+
+    // Register / remove the GC pause callbacks (v8::Locker must be held)
+    void Attach(v8::Isolate* isolate);
+    void Detach();
+
+    // Spend the time until deadline on GC work matching the heap pressure (v8::Locker must be held)
+    void RunIdleTime(std::chrono::steady_clock::time_point deadline);
+
+    sJSGCStats GetStats() const;
+
+    // Entry points for the v8 GC prologue / epilogue callbacks (JSGCScheduler.cpp)
+    void OnGCStarted(bool isMajor);
+    void OnGCFinished(bool isMajor);
+
+private:
+    double   SampleHeap();
+    uint32_t GetPressureLevel(double pressure) const;
+    void     SendPressureLevel(uint32_t level);     // No-op when level is already applied
+    void LogSummary(sJSGCStats const& stats) const;
+
+    sJSGCSchedulerConfig m_config;
+    v8::Isolate*         m_isolate           = nullptr;
+    bool                 m_isInIdleWindow    = false;     // Set while RunIdleTime() runs
+    uint32_t             m_appliedLevel      = 0;
+    uint32_t             m_criticalDeferrals = 0;         // Consecutive deferred critical windows
+    bool                 m_isMarkingStarted  = false;     // Moderate cycle started, cleared by the next major GC
+
+    std::chrono::steady_clock::time_point m_minorStart;
+    std::chrono::steady_clock::time_point m_majorStart;
+    std::chrono::steady_clock::time_point m_lastLogTime;
+
+    mutable std::mutex m_statsMutex;
+    sJSGCStats         m_stats;
+};
@@ -5,6 +5,11 @@
 
 #include "Game/Framework/JSGameLogicJob.hpp"
 
+#include "Game/Framework/BinaryLogger.hpp"
+#include "Game/Framework/CallbackResultRing.hpp"
+#include "Game/Framework/FrameProfiler.hpp"
+#include "Game/Framework/JSFramePipeline.hpp"
+#include "Game/Framework/JSGCScheduler.hpp"
 #include "Engine/Script/IJSGameLogicContext.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/LogSubsystem.hpp"
@@ -20,6 +25,7 @@
 #include <v8.h>
 #pragma warning(pop)
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 
@@ -29,10 +35,10 @@
 // Initializes synchronization primitives and dependencies.
 //----------------------------------------------------------------------------------------------------
 JSGameLogicJob::JSGameLogicJob(IJSGameLogicContext* context,
-                               EntityStateBuffer*   entityBuffer,
+                               EntityStore*         entityStore,
                                CallbackQueue*       callbackQueue)
     : m_context(context),
-      m_entityBuffer(entityBuffer),
+      m_entityStore(entityStore),
       m_callbackQueue(callbackQueue),
       m_frameRequested(false),
       m_frameComplete(true),   // Initially complete (ready for first frame)
@@ -46,9 +52,9 @@ JSGameLogicJob::JSGameLogicJob(IJSGameLogicContext* context,
     {
         ERROR_AND_DIE("JSGameLogicJob: IJSGameLogicContext pointer cannot be null");
     }
-    if (!m_entityBuffer)
+    if (!m_entityStore)
     {
-        ERROR_AND_DIE("JSGameLogicJob: EntityStateBuffer pointer cannot be null");
+        ERROR_AND_DIE("JSGameLogicJob: EntityStore pointer cannot be null");
     }
     if (!m_callbackQueue)
     {
@@ -85,11 +91,12 @@ JSGameLogicJob::~JSGameLogicJob()
 //
 // Algorithm:
 //   1. Initialize V8 thread-local data
-//   2. Loop:
+//   2. Loop (RunLockstepFrames):
 //      a. Wait for frame trigger (conditional variable)
 //      b. Execute JavaScript frame
 //      c. Signal frame completion
 //      d. Check shutdown flag
+//      Pipelined mode (RunPipelinedFrames) waits for a free ring slot and the next tick instead of a trigger
 //   3. Clean up and exit
 //
 // Thread Safety:
@@ -100,11 +107,45 @@ JSGameLogicJob::~JSGameLogicJob()
 void JSGameLogicJob::Execute()
 {
     DAEMON_LOG(LogScript, eLogVerbosity::Display, "JSGameLogicJob: Worker thread started");
+    FrameProfiler::SetThreadName("JSWorker");
 
     // Initialize V8 thread-local state
     InitializeWorkerThreadV8();
 
     // Main worker loop
+    if (m_pipeline)
+    {
+        RunPipelinedFrames();
+    }
+    else
+    {
+        RunLockstepFrames();
+    }
+
+    if (m_gcScheduler)
+    {
+        v8::Locker locker(m_isolate);
+        m_gcScheduler->Detach();
+    }
+
+    // Signal shutdown complete
+    m_shutdownComplete.store(true, std::memory_order_release);
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Display,
+               Stringf("JSGameLogicJob: Worker thread exited - Total frames: %llu",
+                   m_totalFrames.load(std::memory_order_relaxed)));
+}
+
+//----------------------------------------------------------------------------------------------------
+// RunLockstepFrames (Worker Thread Implementation)
+//
+// One JavaScript frame per TriggerNextFrame(); the main thread swaps between frames.
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::RunLockstepFrames()
+{
+    uint32_t tickCount   = 0;
+    float    tickSeconds = 0.f;
+
     while (!m_shutdownRequested.load(std::memory_order_relaxed))
     {
         // Wait for frame trigger from main thread
@@ -125,10 +166,22 @@ void JSGameLogicJob::Execute()
             // Clear frame request flag
             m_frameRequested.store(false, std::memory_order_relaxed);
             m_frameComplete.store(false, std::memory_order_relaxed);
+
+            tickCount          = m_pendingTickCount;
+            tickSeconds        = m_pendingTickSeconds;
+            m_pendingTickCount = 0;
         }
 
         // Execute JavaScript frame (outside lock to avoid blocking main thread)
-        ExecuteJavaScriptFrame();
+        // Variable mode: deltaTime from system clock (matching UpdateJS() pattern)
+        if (tickCount > 0)
+        {
+            ExecuteJavaScriptFrame(tickSeconds, tickCount);
+        }
+        else
+        {
+            ExecuteJavaScriptFrame(static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds()));
+        }
 
         // Signal frame completion
         {
@@ -139,14 +192,104 @@ void JSGameLogicJob::Execute()
 
         // Increment frame counter
         m_totalFrames.fetch_add(1, std::memory_order_relaxed);
+
+        // Rest of the frame budget goes to GC; the main thread swaps meanwhile, and the next trigger
+        // waits at most until the budget would have ended anyway
+        if (m_gcScheduler)
+        {
+            double const idleMs = static_cast<double>(m_gcFrameBudgetMs) * static_cast<double>(std::max(tickCount, 1u)) -
+                m_lastFrameMs.load(std::memory_order_relaxed);
+            RunGCIdleTime(std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(idleMs)));
+        }
     }
+}
 
-    // Signal shutdown complete
-    m_shutdownComplete.store(true, std::memory_order_release);
+//----------------------------------------------------------------------------------------------------
+// RunPipelinedFrames (Worker Thread Implementation)
+//
+// Free-running loop paced to m_targetTickRate. The worker only blocks when the main thread is a full
+// pipeline depth behind (BeginWrite()). A late frame resets the schedule instead of bursting to catch
+// up. deltaTime is the worker's own frame-to-frame time, not the main thread's clock, unless
+// SetFixedTimestep() pinned it to a constant tick.
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::RunPipelinedFrames()
+{
+    auto const tickInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / static_cast<double>(m_targetTickRate)));
 
-    DAEMON_LOG(LogScript, eLogVerbosity::Display,
-               Stringf("JSGameLogicJob: Worker thread exited - Total frames: %llu",
-                   m_totalFrames.load(std::memory_order_relaxed)));
+    auto nextTick  = std::chrono::steady_clock::now();
+    auto lastStart = nextTick - tickInterval;
+
+    while (!m_shutdownRequested.load(std::memory_order_relaxed))
+    {
+        if (!m_pipeline->BeginWrite())
+        {
+            break;
+        }
+
+        std::this_thread::sleep_until(nextTick);
+
+        auto const frameStart = std::chrono::steady_clock::now();
+        nextTick              = (frameStart - nextTick > tickInterval) ? frameStart + tickInterval : nextTick + tickInterval;
+        float const deltaTime = std::chrono::duration<float>(frameStart - lastStart).count();
+        lastStart             = frameStart;
+
+        m_frameComplete.store(false, std::memory_order_relaxed);
+        ExecuteJavaScriptFrame((m_fixedTickSeconds > 0.f) ? m_fixedTickSeconds : deltaTime);
+
+        // Capture under the Locker: main-thread scripts (hot reload, execute_command) cannot write
+        // the shared typed buffer while the finished frame is copied out
+        {
+            v8::Locker locker(m_isolate);
+            m_pipeline->EndWrite();
+        }
+
+        m_frameComplete.store(true, std::memory_order_release);
+        m_totalFrames.fetch_add(1, std::memory_order_relaxed);
+
+        // Idle until the next tick goes to GC
+        if (m_gcScheduler)
+        {
+            RunGCIdleTime(nextTick);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// SetFramePipeline (Main Thread API)
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::SetFramePipeline(JSFramePipeline* pipeline, float const targetTickRate)
+{
+    m_pipeline       = pipeline;
+    m_targetTickRate = (targetTickRate > 0.f) ? targetTickRate : 60.f;
+
+    if (m_pipeline)
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Log,
+                   Stringf("JSGameLogicJob: Pipelined mode (depth %u, %.1f Hz)", m_pipeline->GetDepth(), m_targetTickRate));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// SetGCScheduler (Main Thread API)
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::SetGCScheduler(JSGCScheduler* scheduler, float const frameBudgetMs)
+{
+    m_gcScheduler     = scheduler;
+    m_gcFrameBudgetMs = (frameBudgetMs > 0.f) ? frameBudgetMs : 16.67f;
+}
+
+//----------------------------------------------------------------------------------------------------
+// RunGCIdleTime (Worker Thread Implementation)
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::RunGCIdleTime(std::chrono::steady_clock::time_point const deadline)
+{
+    ProfileScope const scope("JSGameLogicJob::RunGCIdleTime");
+
+    v8::Locker         locker(m_isolate);
+    v8::Isolate::Scope isolateScope(m_isolate);
+    m_gcScheduler->RunIdleTime(deadline);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -164,8 +307,8 @@ void JSGameLogicJob::TriggerNextFrame()
     // Warn if triggering before previous frame complete (indicates timing issue)
     if (!m_frameComplete.load(std::memory_order_relaxed))
     {
-        DAEMON_LOG(LogScript, eLogVerbosity::Warning,
-                   "JSGameLogicJob: TriggerNextFrame() called before previous frame complete (frame skip)");
+        DAEMON_LOG_FAST(LogScript, eLogVerbosity::Warning,
+                        "JSGameLogicJob: TriggerNextFrame() called before previous frame complete (frame skip)");
     }
 
     // Set frame request flag and wake worker thread
@@ -173,6 +316,23 @@ void JSGameLogicJob::TriggerNextFrame()
     m_frameStartCV.notify_one();
 }
 
+//----------------------------------------------------------------------------------------------------
+// TriggerFixedTicks (Main Thread API)
+//
+// Same handshake as TriggerNextFrame(); the tick count and duration ride along under m_mutex and are
+// consumed by the worker when it wakes.
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::TriggerFixedTicks(uint32_t const tickCount, float const tickSeconds)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_pendingTickCount   = tickCount;
+        m_pendingTickSeconds = tickSeconds;
+    }
+
+    TriggerNextFrame();
+}
+
 //----------------------------------------------------------------------------------------------------
 // IsFrameComplete (Main Thread API)
 //
@@ -205,6 +365,12 @@ void JSGameLogicJob::RequestShutdown()
         m_shutdownRequested.store(true, std::memory_order_relaxed);
         m_frameStartCV.notify_one();  // Wake worker if waiting
     }
+
+    // Wake a pipelined worker blocked on a full ring
+    if (m_pipeline)
+    {
+        m_pipeline->Shutdown();
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -239,9 +405,15 @@ bool JSGameLogicJob::IsShutdownComplete() const
 //   - Error isolation: JavaScript errors don't crash C++ worker thread
 //   - Stack trace extraction for debugging
 //   - Recovery: Signal frame complete, allow next frame to proceed
+//
+// Fixed Timestep:
+//   - updateCount > 1 runs JSEngine.update() that many times back to back (catch-up ticks), then
+//     JSEngine.render() once; an exception in one tick does not cancel the remaining ticks
 //----------------------------------------------------------------------------------------------------
-void JSGameLogicJob::ExecuteJavaScriptFrame()
+void JSGameLogicJob::ExecuteJavaScriptFrame(float const deltaTime, uint32_t const updateCount)
 {
+    ProfileScope const frameScope("JSGameLogicJob::ExecuteJavaScriptFrame");
+
     // CRITICAL: Acquire V8 lock before ANY V8 API calls
     // Without this lock, multi-threaded V8 access will crash
     v8::Locker         locker(m_isolate);
@@ -255,34 +427,70 @@ void JSGameLogicJob::ExecuteJavaScriptFrame()
     // This catches any V8 exceptions thrown during JavaScript execution
     v8::TryCatch tryCatch(m_isolate);
 
+    // Watchdog: from here until EndFrameTiming() the frame may be terminated by the main thread
+    auto const frameStart = std::chrono::steady_clock::now();
+    m_frameStartNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(frameStart.time_since_epoch()).count(),
+                         std::memory_order_release);
+
+    PublishWorkShedPolicy(context);
+
+    if (m_resultRing)
+    {
+        m_resultRing->Publish();
+    }
+
     // Execute JavaScript update logic
     // Phase 2.3: Call Game::UpdateJSWorkerThread() on worker thread to execute JavaScript
     // This calls JSEngine.update() which submits render commands
+    bool isTerminated = false;
     if (m_context)
     {
-        // Calculate deltaTime from system clock (matching UpdateJS() pattern)
-        float const deltaTime = static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds());
-
         // Execute JavaScript update on worker thread with proper parameters
-        m_context->UpdateJSWorkerThread(deltaTime);
-
-        // Phase 3.2: Check for JavaScript exceptions after update
-        if (tryCatch.HasCaught())
+        for (uint32_t tick = 0; tick < updateCount && !isTerminated; ++tick)
         {
-            HandleV8Exception(tryCatch, context, "UpdateJSWorkerThread");
-            tryCatch.Reset();  // Clear exception state for render phase
+            {
+                ProfileScope const updateScope("JSEngine.update");
+                m_context->UpdateJSWorkerThread(deltaTime);
+            }
+
+            // Phase 3.2: Check for JavaScript exceptions after update
+            if (tryCatch.HasCaught())
+            {
+                isTerminated = tryCatch.HasTerminated();
+                HandleV8Exception(tryCatch, context, "UpdateJSWorkerThread");
+                tryCatch.Reset();  // Clear exception state for next tick / render phase
+            }
         }
 
         // Execute JavaScript render logic on worker thread
         // This calls JSEngine.render() which submits render commands
-        m_context->RenderJSWorkerThread(deltaTime);
+        // (skipped after a watchdog termination: the isolate refuses to run JS until cancelled)
+        if (!isTerminated)
+        {
+            {
+                ProfileScope const renderScope("JSEngine.render");
+                m_context->RenderJSWorkerThread(deltaTime);
+            }
+
+            // Phase 3.2: Check for JavaScript exceptions after render
+            if (tryCatch.HasCaught())
+            {
+                isTerminated = tryCatch.HasTerminated();
+                HandleV8Exception(tryCatch, context, "RenderJSWorkerThread");
+                // No need to reset - we're done with this frame
+            }
+        }
+    }
 
-        // Phase 3.2: Check for JavaScript exceptions after render
-        if (tryCatch.HasCaught())
+    // A termination the TryCatch above did not see (e.g. swallowed by the eval path's own TryCatch,
+    // or issued between two calls) is still reported, then cancelled so the next frame can run
+    if (EndFrameTiming(frameStart, updateCount))
+    {
+        if (!isTerminated && m_context)
         {
-            HandleV8Exception(tryCatch, context, "RenderJSWorkerThread");
-            // No need to reset - we're done with this frame
+            m_context->HandleJSException("[JSFrameWatchdog] Execution terminated: frame exceeded hang timeout", "");
         }
+        m_isolate->CancelTerminateExecution();
     }
 
     // Phase 3.2: Frame continues even if exceptions occurred
@@ -290,6 +498,99 @@ void JSGameLogicJob::ExecuteJavaScriptFrame()
     // Next frame will retry JavaScript execution (hot-reload may fix issues)
 }
 
+//----------------------------------------------------------------------------------------------------
+// EndFrameTiming (Worker Thread Implementation)
+//
+// Clearing m_frameStartNs under m_terminateMutex closes the window for TerminateRunningFrame(): a
+// termination is either issued before this point (and reported here) or not at all.
+//----------------------------------------------------------------------------------------------------
+bool JSGameLogicJob::EndFrameTiming(std::chrono::steady_clock::time_point const frameStart, uint32_t const updateCount)
+{
+    m_lastFrameMs.store(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count(),
+                        std::memory_order_relaxed);
+    m_lastFrameTicks.store(updateCount, std::memory_order_relaxed);
+
+    std::lock_guard lock(m_terminateMutex);
+    m_frameStartNs.store(0, std::memory_order_relaxed);
+
+    bool const wasTerminated = m_isTerminateIssued;
+    m_isTerminateIssued      = false;
+    return wasTerminated;
+}
+
+//----------------------------------------------------------------------------------------------------
+// PublishWorkShedPolicy (Worker Thread Implementation)
+//
+// Only touches the global when SetWorkShedPolicy() changed something; JSEngine.update() and
+// JSEngine.render() read globalThis.__workShed every frame.
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::PublishWorkShedPolicy(v8::Local<v8::Context> const context)
+{
+    uint32_t const serial = m_shedSerial.load(std::memory_order_acquire);
+    if (serial == m_appliedShedSerial)
+    {
+        return;
+    }
+    m_appliedShedSerial = serial;
+
+    v8::Local<v8::Object> policy = v8::Object::New(m_isolate);
+    policy->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "level"),
+                v8::Integer::NewFromUnsigned(m_isolate, m_shedLevel.load(std::memory_order_relaxed))).Check();
+    policy->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "interval"),
+                v8::Integer::NewFromUnsigned(m_isolate, m_shedInterval.load(std::memory_order_relaxed))).Check();
+    policy->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "minPriority"),
+                v8::Integer::New(m_isolate, m_shedMinPriority.load(std::memory_order_relaxed))).Check();
+
+    context->Global()->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "__workShed"), policy).Check();
+}
+
+//----------------------------------------------------------------------------------------------------
+// GetRunningFrameMs (Main Thread API)
+//----------------------------------------------------------------------------------------------------
+double JSGameLogicJob::GetRunningFrameMs() const
+{
+    int64_t const startNs = m_frameStartNs.load(std::memory_order_acquire);
+    if (startNs == 0)
+    {
+        return 0.0;
+    }
+
+    int64_t const nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<double>(nowNs - startNs) / 1.0e6;
+}
+
+//----------------------------------------------------------------------------------------------------
+// TerminateRunningFrame (Main Thread API)
+//
+// v8::Isolate::TerminateExecution() is one of the few V8 calls that is safe without the Locker;
+// holding m_terminateMutex guarantees the frame it lands in is still the one that overran.
+//----------------------------------------------------------------------------------------------------
+bool JSGameLogicJob::TerminateRunningFrame()
+{
+    std::lock_guard lock(m_terminateMutex);
+
+    if (m_frameStartNs.load(std::memory_order_relaxed) == 0 || !m_isolate)
+    {
+        return false;
+    }
+
+    m_isolate->TerminateExecution();
+    m_isTerminateIssued = true;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// SetWorkShedPolicy (Main Thread API)
+//----------------------------------------------------------------------------------------------------
+void JSGameLogicJob::SetWorkShedPolicy(uint32_t const level, uint32_t const interval, int32_t const minPriority)
+{
+    m_shedLevel.store(level, std::memory_order_relaxed);
+    m_shedInterval.store(interval, std::memory_order_relaxed);
+    m_shedMinPriority.store(minPriority, std::memory_order_relaxed);
+    m_shedSerial.fetch_add(1, std::memory_order_release);
+}
+
 //----------------------------------------------------------------------------------------------------
 // InitializeWorkerThreadV8 (Worker Thread Implementation)
 //
@@ -310,6 +611,12 @@ void JSGameLogicJob::InitializeWorkerThreadV8()
         ERROR_AND_DIE("JSGameLogicJob: Failed to get V8 isolate from ScriptSubsystem");
     }
 
+    if (m_gcScheduler)
+    {
+        v8::Locker locker(m_isolate);
+        m_gcScheduler->Attach(m_isolate);
+    }
+
     DAEMON_LOG(LogScript, eLogVerbosity::Log,
                "JSGameLogicJob: V8 isolate initialized for worker thread");
 }
@@ -343,7 +650,12 @@ void JSGameLogicJob::HandleV8Exception(v8::TryCatch& tryCatch,
     // Extract exception message
     std::string errorMessage = "Unknown JavaScript error";
     v8::Local<v8::Value> exception = tryCatch.Exception();
-    if (!exception.IsEmpty())
+    if (tryCatch.HasTerminated())
+    {
+        // TerminateExecution() from JSFrameWatchdog; the exception value carries no message
+        errorMessage = "Execution terminated: frame exceeded hang timeout (JSFrameWatchdog)";
+    }
+    else if (!exception.IsEmpty())
     {
         v8::String::Utf8Value exceptionUtf8(m_isolate, exception);
         if (*exceptionUtf8)
@@ -479,7 +791,7 @@ void JSGameLogicJob::HandleV8Exception(v8::TryCatch& tryCatch,
 //   Lifetimes:
 //     - JSGameLogicJob: Created in App::Startup(), destroyed in App::Shutdown()
 //     - m_game: Outlives JSGameLogicJob (guaranteed by App lifecycle)
-//     - m_entityBuffer: Outlives JSGameLogicJob (created before, destroyed after)
+//     - m_entityStore: Outlives JSGameLogicJob (created before, destroyed after)
 //
 //   Dangling Pointer Prevention:
 //     - Main thread: Calls RequestShutdown(), waits for IsShutdownComplete()
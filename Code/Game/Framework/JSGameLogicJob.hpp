@@ -36,9 +36,9 @@
 
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Core/JobSystem.hpp"
-#include "Engine/Entity/EntityStateBuffer.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 
@@ -47,6 +47,10 @@
 //----------------------------------------------------------------------------------------------------
 class IJSGameLogicContext;  // Abstract interface for JavaScript execution context
 class CallbackQueue;        // Phase 2.3: Lock-free callback queue for async callback processing
+class CallbackResultRing;   // Binary GenericCommand results (published at frame start)
+class EntityStore;          // SoA entity slot map (double-buffered)
+class JSFramePipeline;      // Ring of completed frames (pipelined mode)
+class JSGCScheduler;        // Idle-time garbage collection between frames
 
 namespace v8 {
 class Isolate;
@@ -74,16 +78,20 @@ class Context;
 // Usage Pattern:
 //
 // Initialization (Main Thread):
-//   JSGameLogicJob* job = new JSGameLogicJob(gameContext, entityBuffer, callbackQueue);
+//   JSGameLogicJob* job = new JSGameLogicJob(gameContext, entityStore, callbackQueue);
 //   g_jobSystem->QueueJob(job);  // Submit to worker thread
 //
 // Frame Execution (Main Thread):
 //   if (job->IsFrameComplete()) {
-//       entityBuffer->SwapBuffers();  // Swap to new game state
+//       entityStore->SwapBuffers();   // Swap to new game state
 //       job->TriggerNextFrame();      // Start next JavaScript frame
 //   }
 //   // Continue rendering with current front buffer (60 FPS maintained)
 //
+// Pipelined Mode (optional, set before submission):
+//   job->SetFramePipeline(pipeline, 60.f);  // Worker free-runs at 60 Hz, up to pipeline depth ahead
+//   while (sJSFrameSlot const* slot = pipeline->PeekCompleted()) { apply; pipeline->ReleaseCompleted(); }
+//
 // Shutdown (Main Thread):
 //   job->RequestShutdown();           // Signal worker to exit
 //   while (!job->IsShutdownComplete()) {
@@ -106,11 +114,11 @@ public:
 	// Constructor
 	// Parameters:
 	//   - context: Interface to game-specific JavaScript execution context
-	//   - entityBuffer: Double-buffered entity state for rendering isolation
+	//   - entityStore: Double-buffered entity state for rendering isolation
 	//   - callbackQueue: Callback queue for async JavaScript callback processing (Phase 2.3)
 	//
 	// Thread Safety: Call from main thread only
-	JSGameLogicJob(IJSGameLogicContext* context, EntityStateBuffer* entityBuffer, CallbackQueue* callbackQueue);
+	JSGameLogicJob(IJSGameLogicContext* context, EntityStore* entityStore, CallbackQueue* callbackQueue);
 
 	// Destructor
 	// Ensures clean shutdown if not already performed
@@ -143,6 +151,32 @@ public:
 	// Thread Safety: Call from main thread only
 	void TriggerNextFrame();
 
+	// Fixed-timestep variant: the worker runs JSEngine.update() tickCount times with tickSeconds each,
+	// then JSEngine.render() once. tickCount must be > 0 (with no ticks owed, don't trigger at all).
+	//
+	// Precondition: Previous frame must be complete (check IsFrameComplete())
+	// Thread Safety: Call from main thread only
+	void TriggerFixedTicks(uint32_t tickCount, float tickSeconds);
+
+	// Switch the worker to pipelined mode: frames run continuously at targetTickRate (Hz) and are
+	// published into pipeline instead of waiting for TriggerNextFrame(). nullptr keeps lockstep mode.
+	//
+	// Thread Safety: Call from main thread only, before the job is submitted
+	void SetFramePipeline(JSFramePipeline* pipeline, float targetTickRate);
+	bool IsPipelined() const { return m_pipeline != nullptr; }
+
+	// Pipelined mode only: pass a constant tickSeconds to every frame instead of the measured
+	// worker frame time. 0 keeps measured deltas. Call before the job is submitted.
+	void SetFixedTimestep(float tickSeconds) { m_fixedTickSeconds = tickSeconds; }
+
+	// Hand the time left after each frame to scheduler (see JSGCScheduler.hpp). Lockstep frames get
+	// frameBudgetMs per tick; pipelined frames run until the next tick. Call before the job is submitted.
+	void SetGCScheduler(JSGCScheduler* scheduler, float frameBudgetMs);
+
+	// Publish ring's staged results at the start of every frame, before JSEngine.update() reads them
+	// (see CallbackResultRing.hpp). Call before the job is submitted.
+	void SetCallbackResultRing(CallbackResultRing* ring) { m_resultRing = ring; }
+
 	// Check if current frame execution is complete
 	// Returns:
 	//   true  - JavaScript finished, safe to swap buffers
@@ -175,6 +209,22 @@ public:
 	// Get worker thread execution state (for debugging)
 	bool IsWorkerIdle() const { return !m_frameRequested.load(std::memory_order_relaxed); }
 
+	//------------------------------------------------------------------------------------------------
+	// Watchdog / Work Shedding (Main Thread, see JSFrameWatchdog.hpp)
+	//------------------------------------------------------------------------------------------------
+
+	// Time the current worker frame has been running (0 when idle), and the last finished frame
+	double   GetRunningFrameMs() const;
+	double   GetLastFrameMs() const { return m_lastFrameMs.load(std::memory_order_relaxed); }
+	uint32_t GetLastFrameTicks() const { return m_lastFrameTicks.load(std::memory_order_relaxed); }
+
+	// v8::Isolate::TerminateExecution() on the running frame. The worker reports it through
+	// HandleV8Exception() and cancels the termination before the next frame. Returns false if idle.
+	bool TerminateRunningFrame();
+
+	// Published to JavaScript as globalThis.__workShed at the start of the next worker frame
+	void SetWorkShedPolicy(uint32_t level, uint32_t interval, int32_t minPriority);
+
 private:
 	//------------------------------------------------------------------------------------------------
 	// Worker Thread Implementation
@@ -184,7 +234,11 @@ private:
 	// Calls into JavaScript update/render systems
 	//
 	// Thread Safety: Protected by v8::Locker
-	void ExecuteJavaScriptFrame();
+	void ExecuteJavaScriptFrame(float deltaTime, uint32_t updateCount = 1);
+
+	// Worker loops: wait for TriggerNextFrame() (lockstep) or free-run into m_pipeline (pipelined)
+	void RunLockstepFrames();
+	void RunPipelinedFrames();
 
 	// Initialize V8 thread-local data (called once at worker thread startup)
 	// Thread Safety: Worker thread only, no locking needed
@@ -195,12 +249,27 @@ private:
 	// Thread Safety: Worker thread only, v8::Locker must be held
 	void HandleV8Exception(v8::TryCatch& tryCatch, v8::Local<v8::Context> context, char const* phase);
 
+	// Mirror the latest SetWorkShedPolicy() into globalThis.__workShed (v8::Locker must be held)
+	void PublishWorkShedPolicy(v8::Local<v8::Context> context);
+
+	// Clears the running-frame marker; returns true if the watchdog terminated this frame
+	bool EndFrameTiming(std::chrono::steady_clock::time_point frameStart, uint32_t updateCount);
+
+	// Offer the time until deadline to m_gcScheduler (takes the v8::Locker)
+	void RunGCIdleTime(std::chrono::steady_clock::time_point deadline);
+
 	//------------------------------------------------------------------------------------------------
 	// Dependencies (Injected via Constructor)
 	//------------------------------------------------------------------------------------------------
 	IJSGameLogicContext* m_context;         // Interface to JavaScript execution context
-	EntityStateBuffer*   m_entityBuffer;    // Entity state output buffer
+	EntityStore*         m_entityStore;     // Entity state output buffer
 	CallbackQueue*       m_callbackQueue;    // Callback queue for async callback processing (Phase 2.3)
+	JSFramePipeline*     m_pipeline         = nullptr;   // Pipelined mode only (not owned)
+	float                m_targetTickRate   = 60.f;      // Pipelined mode frame rate (Hz)
+	float                m_fixedTickSeconds = 0.f;       // Pipelined mode constant delta (0 = measured)
+	JSGCScheduler*       m_gcScheduler      = nullptr;   // Idle-time GC (not owned)
+	CallbackResultRing*  m_resultRing       = nullptr;   // Binary callback results (not owned)
+	float                m_gcFrameBudgetMs  = 16.67f;    // Lockstep idle window per tick
 
 	//------------------------------------------------------------------------------------------------
 	// Frame Synchronization (Main ↔ Worker Communication)
@@ -213,11 +282,28 @@ private:
 	std::atomic<bool>               m_frameComplete;      // Worker → Main: Frame finished
 	std::atomic<bool>               m_shutdownRequested;  // Main → Worker: Exit loop
 	std::atomic<bool>               m_shutdownComplete;   // Worker → Main: Thread exited
+	uint32_t                        m_pendingTickCount   = 0;     // Fixed ticks for next frame (0 = variable)
+	float                           m_pendingTickSeconds = 0.f;   // Guarded by m_mutex
 
 	//------------------------------------------------------------------------------------------------
 	// Statistics
 	//------------------------------------------------------------------------------------------------
 	std::atomic<uint64_t>           m_totalFrames;        // Total frames executed (profiling)
+	std::atomic<double>             m_lastFrameMs{0.0};
+	std::atomic<uint32_t>           m_lastFrameTicks{1};
+
+	//------------------------------------------------------------------------------------------------
+	// Watchdog / Work Shedding
+	//------------------------------------------------------------------------------------------------
+	std::mutex                      m_terminateMutex;             // Orders TerminateRunningFrame() against frame end
+	std::atomic<int64_t>            m_frameStartNs{0};            // Running frame start (steady_clock), 0 = idle
+	bool                            m_isTerminateIssued = false;  // Guarded by m_terminateMutex
+
+	std::atomic<uint32_t>           m_shedLevel{0};
+	std::atomic<uint32_t>           m_shedInterval{1};
+	std::atomic<int32_t>            m_shedMinPriority{0};
+	std::atomic<uint32_t>           m_shedSerial{0};              // Bumped by SetWorkShedPolicy()
+	uint32_t                        m_appliedShedSerial = 0;      // Worker thread only
 
 	//------------------------------------------------------------------------------------------------
 	// V8 Thread-Local State
@@ -257,10 +343,10 @@ private:
 //     - Worker thread: Signal completion, main polls IsFrameComplete()
 //     - Benefit: Main thread never blocks, stable 60 FPS
 //
-//   Phase 3 (Future - Timeout Detection):
-//     - Main thread: Detect hung worker (IsFrameComplete() false for > 500ms)
+//   Phase 3 (Timeout Detection - JSFrameWatchdog):
+//     - Main thread: Detect hung worker (GetRunningFrameMs() > hangTimeoutMs, default 500ms)
 //     - Fallback: Continue rendering with last known state
-//     - Recovery: Kill worker, restart with fresh isolate
+//     - Recovery: TerminateRunningFrame(); the same isolate resumes with the next frame
 //
 // V8 Thread Safety Requirements:
 //
@@ -295,9 +381,9 @@ private:
 //     - Recovery: Next frame attempts execution (hot-reload may fix)
 //
 //   JavaScript Hang:
-//     - Main thread: Detect timeout (IsFrameComplete() false for > 500ms)
-//     - Action: Log error, continue rendering last state
-//     - Recovery: Kill worker thread, restart with fresh isolate
+//     - Main thread: Detect timeout (GetRunningFrameMs() > hangTimeoutMs)
+//     - Action: Log error, TerminateExecution(), continue rendering last state
+//     - Recovery: Worker reports the termination, cancels it, next frame runs normally
 //
 //   Hot-Reload Failure:
 //     - Worker catches reload exception, rolls back to previous script
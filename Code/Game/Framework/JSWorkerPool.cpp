@@ -0,0 +1,636 @@
+//----------------------------------------------------------------------------------------------------
+// JSWorkerPool.cpp
+// Multi-isolate JavaScript worker pool for sharded entity behaviors
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/JSWorkerPool.hpp"
+
+#include "Game/Framework/ExternalCommandQueue.hpp"
+#include "Game/Framework/TypedCommandBuffer.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+
+// Suppress V8 header warnings (unreferenced formal parameters, etc.)
+#pragma warning(push)
+#pragma warning(disable: 4100)  // 'identifier': unreferenced formal parameter
+#pragma warning(disable: 4127)  // conditional expression is constant
+#pragma warning(disable: 4324)  // 'structname': structure was padded due to alignment specifier
+#include <v8.h>
+#pragma warning(pop)
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+//----------------------------------------------------------------------------------------------------
+// console.log for shard isolates (routed to LogScript)
+//----------------------------------------------------------------------------------------------------
+static void ShardConsoleLog(v8::FunctionCallbackInfo<v8::Value> const& info)
+{
+    v8::Isolate* isolate = info.GetIsolate();
+    String       message;
+
+    for (int i = 0; i < info.Length(); ++i)
+    {
+        v8::String::Utf8Value text(isolate, info[i]);
+        if (i > 0) message += ' ';
+        message += (*text != nullptr) ? *text : "<invalid>";
+    }
+
+    int32_t const shardIndex = info.Data()->Int32Value(isolate->GetCurrentContext()).FromMaybe(-1);
+    DAEMON_LOG(LogScript, eLogVerbosity::Log, Stringf("[JSShard %d] %s", shardIndex, message.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------
+// JSShardJob
+//
+// One isolate on one JobSystem thread. Mirrors JSGameLogicJob's trigger / complete handshake, but the
+// completion is reported to the pool's shared counter instead of a per-job flag.
+//----------------------------------------------------------------------------------------------------
+class JSShardJob : public Job
+{
+public:
+    JSShardJob(uint32_t shardIndex, uint32_t shardCount, String const& scriptPath, String const& scriptSource, uint32_t typedRecordCapacity,
+               std::atomic<uint32_t>* pendingShards, ExternalCommandQueue* commandQueue, ExternalProducerHandle commandProducer)
+        : m_shardIndex(shardIndex),
+          m_shardCount(shardCount),
+          m_scriptPath(scriptPath),
+          m_scriptSource(scriptSource),
+          m_typedBuffer(typedRecordCapacity),
+          m_pendingShards(pendingShards),
+          m_commandQueue(commandQueue),
+          m_commandProducer(commandProducer)
+    {
+    }
+
+    void Execute() override;
+
+    // Main thread
+    void QueueAssignment(sShardAssignment const& assignment)
+    {
+        std::lock_guard lock(m_mutex);
+        m_inbox.push_back(assignment);
+    }
+
+    void TriggerFrame(float const deltaSeconds)
+    {
+        std::lock_guard lock(m_mutex);
+        m_deltaSeconds   = deltaSeconds;
+        m_frameRequested = true;
+        m_frameStartCV.notify_one();
+    }
+
+    void RequestShutdown()
+    {
+        std::lock_guard lock(m_mutex);
+        m_shutdownRequested = true;
+        m_frameStartCV.notify_one();
+    }
+
+    bool IsShutdownComplete() const { return m_shutdownComplete.load(std::memory_order_acquire); }
+    bool IsReady() const { return m_isReady.load(std::memory_order_acquire); }
+
+    // Main thread, only while the pool frame is complete (shard idle)
+    TypedCommandBuffer& GetTypedBuffer() { return m_typedBuffer; }
+
+    uint32_t GetShardIndex() const { return m_shardIndex; }
+    double   GetLastFrameMs() const { return m_lastFrameMs.load(std::memory_order_relaxed); }
+    uint64_t GetExceptionCount() const { return m_exceptionCount.load(std::memory_order_relaxed); }
+
+    // Valid once IsReady()
+    double GetInitMs() const { return m_initMs; }
+
+private:
+    static void SubmitCommandCallback(v8::FunctionCallbackInfo<v8::Value> const& info);
+
+    bool InitializeIsolate();
+    bool CompileAndRunScript(v8::Local<v8::Context> const& context);
+    void DisposeIsolate();
+    void RunFrame(std::vector<sShardAssignment> const& assignments, float deltaSeconds);
+    void LogException(v8::TryCatch const& tryCatch, char const* phase);
+
+    uint32_t               m_shardIndex;
+    uint32_t               m_shardCount;
+    String                 m_scriptPath;
+    String                 m_scriptSource;
+    TypedCommandBuffer     m_typedBuffer;
+    std::atomic<uint32_t>* m_pendingShards;
+    ExternalCommandQueue*  m_commandQueue;        // nullptr = submitCommand unavailable
+    ExternalProducerHandle m_commandProducer;     // Used by this shard's thread only
+
+    // Frame synchronization (protected by m_mutex)
+    std::mutex                    m_mutex;
+    std::condition_variable       m_frameStartCV;
+    std::vector<sShardAssignment> m_inbox;
+    float                         m_deltaSeconds      = 0.f;
+    bool                          m_frameRequested    = false;
+    bool                          m_shutdownRequested = false;
+
+    std::atomic<bool>     m_isReady{false};
+    std::atomic<bool>     m_shutdownComplete{false};
+    std::atomic<double>   m_lastFrameMs{0.0};
+    std::atomic<uint64_t> m_exceptionCount{0};
+    double                m_initMs = 0.0;     // Published by m_isReady
+
+    // V8 state (shard thread only)
+    std::unique_ptr<v8::ArrayBuffer::Allocator> m_allocator;
+    v8::Isolate*                                m_isolate = nullptr;
+    v8::Global<v8::Context>                     m_context;
+    v8::Global<v8::Object>                      m_runtime;
+    v8::Global<v8::Function>                    m_assignFunction;
+    v8::Global<v8::Function>                    m_releaseFunction;
+    v8::Global<v8::Function>                    m_updateFunction;
+};
+
+//----------------------------------------------------------------------------------------------------
+void JSShardJob::Execute()
+{
+    auto const initStart = std::chrono::steady_clock::now();
+    if (InitializeIsolate())
+    {
+        m_initMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - initStart).count();
+        m_isReady.store(true, std::memory_order_release);
+    }
+
+    std::vector<sShardAssignment> assignments;
+
+    while (true)
+    {
+        float deltaSeconds = 0.f;
+        {
+            std::unique_lock lock(m_mutex);
+            m_frameStartCV.wait(lock, [this]() { return m_frameRequested || m_shutdownRequested; });
+
+            if (m_shutdownRequested)
+            {
+                break;
+            }
+
+            m_frameRequested = false;
+            deltaSeconds     = m_deltaSeconds;
+            assignments.swap(m_inbox);
+        }
+
+        auto const frameStart = std::chrono::steady_clock::now();
+
+        if (m_isReady.load(std::memory_order_relaxed))
+        {
+            RunFrame(assignments, deltaSeconds);
+        }
+        assignments.clear();
+
+        m_lastFrameMs.store(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count(), std::memory_order_relaxed);
+
+        // Merged completion: the last shard to finish completes the pool frame
+        m_pendingShards->fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    DisposeIsolate();
+    m_shutdownComplete.store(true, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------
+// SubmitCommandCallback (Shard Thread)
+//
+// submitCommand(type, payload) -> boolean. payload is an object (stringified here) or a JSON string.
+// The command goes through the ExternalCommandQueue under the "jsWorkerPool" agent and runs on the
+// main thread in ProcessGenericCommands(); false means it was rate limited or the queue was full.
+//----------------------------------------------------------------------------------------------------
+void JSShardJob::SubmitCommandCallback(v8::FunctionCallbackInfo<v8::Value> const& info)
+{
+    v8::Isolate*                 isolate = info.GetIsolate();
+    v8::Local<v8::Context> const context = isolate->GetCurrentContext();
+    JSShardJob const*            shard   = static_cast<JSShardJob const*>(info.Data().As<v8::External>()->Value());
+
+    if (info.Length() < 1 || !info[0]->IsString())
+    {
+        isolate->ThrowException(v8::Exception::TypeError(v8::String::NewFromUtf8Literal(isolate, "submitCommand(type, payload): type must be a string")));
+        return;
+    }
+
+    v8::Local<v8::String> payloadJson;
+    if (info.Length() < 2 || info[1]->IsUndefined())
+    {
+        payloadJson = v8::String::NewFromUtf8Literal(isolate, "{}");
+    }
+    else if (info[1]->IsString())
+    {
+        payloadJson = info[1].As<v8::String>();
+    }
+    else if (!v8::JSON::Stringify(context, info[1]).ToLocal(&payloadJson))
+    {
+        return;     // Stringify threw (e.g. a cyclic object)
+    }
+
+    v8::String::Utf8Value const type(isolate, info[0]);
+    v8::String::Utf8Value const payload(isolate, payloadJson);
+
+    eExternalSubmitResult const result = shard->m_commandQueue->Submit(shard->m_commandProducer, String(*type, type.length()),
+                                                                       String(*payload, payload.length()));
+    info.GetReturnValue().Set(result == eExternalSubmitResult::ACCEPTED);
+}
+
+//----------------------------------------------------------------------------------------------------
+// InitializeIsolate (Shard Thread)
+//
+// The V8 platform is already initialized by ScriptSubsystem; each shard only needs its own isolate,
+// context and the runtime script. Failure leaves the shard idle (frames complete immediately).
+//----------------------------------------------------------------------------------------------------
+bool JSShardJob::InitializeIsolate()
+{
+    m_allocator.reset(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+
+    v8::Isolate::CreateParams createParams;
+    createParams.array_buffer_allocator = m_allocator.get();
+    m_isolate                           = v8::Isolate::New(createParams);
+
+    v8::Locker         locker(m_isolate);
+    v8::Isolate::Scope isolateScope(m_isolate);
+    v8::HandleScope    handleScope(m_isolate);
+
+    v8::Local<v8::Context> const context = v8::Context::New(m_isolate);
+    m_context.Reset(m_isolate, context);
+    v8::Context::Scope contextScope(context);
+
+    v8::Local<v8::Object> const global  = context->Global();
+    v8::Local<v8::Object> const console = v8::Object::New(m_isolate);
+    v8::Local<v8::Function>     logFunction;
+    if (!v8::FunctionTemplate::New(m_isolate, ShardConsoleLog, v8::Integer::New(m_isolate, static_cast<int32_t>(m_shardIndex)))
+             ->GetFunction(context).ToLocal(&logFunction))
+    {
+        return false;
+    }
+
+    (void)console->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "log"), logFunction);
+    (void)global->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "console"), console);
+    (void)global->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "shardIndex"), v8::Integer::NewFromUnsigned(m_isolate, m_shardIndex));
+    (void)global->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "shardCount"), v8::Integer::NewFromUnsigned(m_isolate, m_shardCount));
+
+    if (m_commandQueue && m_commandProducer != INVALID_EXTERNAL_PRODUCER)
+    {
+        v8::Local<v8::Function> submitFunction;
+        if (!v8::FunctionTemplate::New(m_isolate, SubmitCommandCallback, v8::External::New(m_isolate, this))
+                 ->GetFunction(context).ToLocal(&submitFunction))
+        {
+            return false;
+        }
+        (void)global->Set(context, v8::String::NewFromUtf8Literal(m_isolate, "submitCommand"), submitFunction);
+    }
+
+    if (!m_typedBuffer.InstallScriptBuffer(m_isolate, "typedCommandBuffer"))
+    {
+        return false;
+    }
+
+    if (!CompileAndRunScript(context))
+    {
+        return false;
+    }
+
+    v8::Local<v8::Value> runtimeValue;
+    if (!global->Get(context, v8::String::NewFromUtf8Literal(m_isolate, "ShardRuntime")).ToLocal(&runtimeValue) || !runtimeValue->IsObject())
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Error, Stringf("(JSShardJob) shard %u: globalThis.ShardRuntime not defined by runtime script", m_shardIndex));
+        return false;
+    }
+
+    v8::Local<v8::Object> const runtime = runtimeValue.As<v8::Object>();
+    v8::Local<v8::Value>        assignValue;
+    v8::Local<v8::Value>        releaseValue;
+    v8::Local<v8::Value>        updateValue;
+    if (!runtime->Get(context, v8::String::NewFromUtf8Literal(m_isolate, "assign")).ToLocal(&assignValue) || !assignValue->IsFunction() ||
+        !runtime->Get(context, v8::String::NewFromUtf8Literal(m_isolate, "release")).ToLocal(&releaseValue) || !releaseValue->IsFunction() ||
+        !runtime->Get(context, v8::String::NewFromUtf8Literal(m_isolate, "update")).ToLocal(&updateValue) || !updateValue->IsFunction())
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Error, Stringf("(JSShardJob) shard %u: ShardRuntime must define assign/release/update", m_shardIndex));
+        return false;
+    }
+
+    m_runtime.Reset(m_isolate, runtime);
+    m_assignFunction.Reset(m_isolate, assignValue.As<v8::Function>());
+    m_releaseFunction.Reset(m_isolate, releaseValue.As<v8::Function>());
+    m_updateFunction.Reset(m_isolate, updateValue.As<v8::Function>());
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log, Stringf("(JSShardJob) shard %u/%u ready", m_shardIndex, m_shardCount));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// CompileAndRunScript (Shard Thread)
+//
+// The script path is the resource name, so exceptions and stack traces point at the runtime script.
+//----------------------------------------------------------------------------------------------------
+bool JSShardJob::CompileAndRunScript(v8::Local<v8::Context> const& context)
+{
+    v8::TryCatch          tryCatch(m_isolate);
+    v8::Local<v8::String> source;
+    v8::Local<v8::String> resourceName;
+    if (!v8::String::NewFromUtf8(m_isolate, m_scriptSource.c_str(), v8::NewStringType::kNormal, static_cast<int>(m_scriptSource.size())).ToLocal(&source) ||
+        !v8::String::NewFromUtf8(m_isolate, m_scriptPath.c_str()).ToLocal(&resourceName))
+    {
+        LogException(tryCatch, "load");
+        return false;
+    }
+
+    v8::ScriptOrigin const     origin(resourceName);
+    v8::ScriptCompiler::Source compileSource(source, origin);
+
+    v8::Local<v8::Script> script;
+    if (!v8::ScriptCompiler::Compile(context, &compileSource).ToLocal(&script) || script->Run(context).IsEmpty())
+    {
+        LogException(tryCatch, "load");
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSShardJob::DisposeIsolate()
+{
+    if (m_isolate == nullptr)
+    {
+        return;
+    }
+
+    {
+        v8::Locker         locker(m_isolate);
+        v8::Isolate::Scope isolateScope(m_isolate);
+
+        m_updateFunction.Reset();
+        m_releaseFunction.Reset();
+        m_assignFunction.Reset();
+        m_runtime.Reset();
+        m_context.Reset();
+    }
+
+    m_isolate->Dispose();
+    m_isolate = nullptr;
+    m_allocator.reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+// RunFrame (Shard Thread)
+//
+// Inbox first, so an entity assigned this frame is already updated by this frame's update().
+//----------------------------------------------------------------------------------------------------
+void JSShardJob::RunFrame(std::vector<sShardAssignment> const& assignments, float const deltaSeconds)
+{
+    v8::Locker                   locker(m_isolate);
+    v8::Isolate::Scope           isolateScope(m_isolate);
+    v8::HandleScope              handleScope(m_isolate);
+    v8::Local<v8::Context> const context = m_context.Get(m_isolate);
+    v8::Context::Scope           contextScope(context);
+    v8::TryCatch                 tryCatch(m_isolate);
+
+    v8::Local<v8::Object> const runtime = m_runtime.Get(m_isolate);
+
+    for (sShardAssignment const& assignment : assignments)
+    {
+        v8::Local<v8::Value> const entityId = v8::Number::New(m_isolate, static_cast<double>(assignment.entityId));
+
+        if (assignment.behaviorType.empty())
+        {
+            (void)m_releaseFunction.Get(m_isolate)->Call(context, runtime, 1, &entityId);
+        }
+        else
+        {
+            v8::Local<v8::Value> argv[] = {
+                entityId,
+                v8::String::NewFromUtf8(m_isolate, assignment.behaviorType.c_str()).ToLocalChecked(),
+                v8::Number::New(m_isolate, assignment.position.x),
+                v8::Number::New(m_isolate, assignment.position.y),
+                v8::Number::New(m_isolate, assignment.position.z),
+                v8::Number::New(m_isolate, assignment.orientation.m_yawDegrees),
+                v8::Number::New(m_isolate, assignment.orientation.m_pitchDegrees),
+                v8::Number::New(m_isolate, assignment.orientation.m_rollDegrees),
+                v8::Integer::NewFromUnsigned(m_isolate, assignment.color.r),
+                v8::Integer::NewFromUnsigned(m_isolate, assignment.color.g),
+                v8::Integer::NewFromUnsigned(m_isolate, assignment.color.b),
+                v8::Integer::NewFromUnsigned(m_isolate, assignment.color.a)
+            };
+            (void)m_assignFunction.Get(m_isolate)->Call(context, runtime, static_cast<int>(std::size(argv)), argv);
+        }
+
+        if (tryCatch.HasCaught())
+        {
+            LogException(tryCatch, "assign");
+            tryCatch.Reset();
+        }
+    }
+
+    v8::Local<v8::Value> argv[1] = {v8::Number::New(m_isolate, static_cast<double>(deltaSeconds))};
+    (void)m_updateFunction.Get(m_isolate)->Call(context, runtime, 1, argv);
+
+    if (tryCatch.HasCaught())
+    {
+        LogException(tryCatch, "update");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSShardJob::LogException(v8::TryCatch const& tryCatch, char const* phase)
+{
+    m_exceptionCount.fetch_add(1, std::memory_order_relaxed);
+
+    String message = "<unknown exception>";
+    if (tryCatch.HasCaught())
+    {
+        v8::String::Utf8Value exceptionText(m_isolate, tryCatch.Exception());
+        if (*exceptionText != nullptr) message = *exceptionText;
+    }
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Error, Stringf("(JSShardJob) shard %u %s failed: %s", m_shardIndex, phase, message.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------
+// JSWorkerPool
+//----------------------------------------------------------------------------------------------------
+JSWorkerPool::JSWorkerPool(uint32_t const shardCount, String const& runtimeScriptPath, uint32_t const typedRecordCapacity,
+                           ExternalCommandQueue* const commandQueue)
+{
+    if (shardCount == 0 || shardCount > MAX_SHARDS)
+    {
+        ERROR_AND_DIE(Stringf("JSWorkerPool: shardCount must be 1-%u (got %u)", MAX_SHARDS, shardCount));
+    }
+
+    std::ifstream     scriptFile(runtimeScriptPath);
+    std::stringstream scriptSource;
+    if (scriptFile.is_open())
+    {
+        scriptSource << scriptFile.rdbuf();
+    }
+    else
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Error, Stringf("JSWorkerPool: runtime script '%s' not found - shards will stay idle", runtimeScriptPath.c_str()));
+    }
+
+    m_shards.reserve(shardCount);
+    for (uint32_t i = 0; i < shardCount; ++i)
+    {
+        // One producer per shard thread; all shards share the "jsWorkerPool" agent's rate budget
+        ExternalProducerHandle const producer = commandQueue ? commandQueue->RegisterProducer("jsWorkerPool") : INVALID_EXTERNAL_PRODUCER;
+        if (commandQueue && producer == INVALID_EXTERNAL_PRODUCER)
+        {
+            DAEMON_LOG(LogScript, eLogVerbosity::Warning, Stringf("JSWorkerPool: no ExternalCommandQueue producer left for shard %u - submitCommand disabled", i));
+        }
+        m_shards.push_back(new JSShardJob(i, shardCount, runtimeScriptPath, scriptSource.str(), typedRecordCapacity, &m_pendingShards,
+                                          commandQueue, producer));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+JSWorkerPool::~JSWorkerPool()
+{
+    if (!IsShutdownComplete())
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, "JSWorkerPool: Destroyed without proper shutdown (call RequestShutdown() and wait for completion)");
+    }
+
+    for (JSShardJob* shard : m_shards)
+    {
+        delete shard;
+    }
+    m_shards.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSWorkerPool::Start()
+{
+    if (m_isStarted)
+    {
+        return;
+    }
+
+    for (JSShardJob* shard : m_shards)
+    {
+        g_jobSystem->SubmitJob(shard);
+    }
+    m_isStarted = true;
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Display, Stringf("JSWorkerPool: %u shard isolates submitted", GetShardCount()));
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t JSWorkerPool::Assign(sShardAssignment const& assignment)
+{
+    uint32_t const shardIndex = GetShardIndex(assignment.entityId);
+    m_shards[shardIndex]->QueueAssignment(assignment);
+    return shardIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSWorkerPool::TriggerNextFrame(float const deltaSeconds)
+{
+    if (!m_isStarted || !IsFrameComplete())
+    {
+        return;
+    }
+
+    m_pendingShards.store(GetShardCount(), std::memory_order_release);
+    for (JSShardJob* shard : m_shards)
+    {
+        shard->TriggerFrame(deltaSeconds);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Drain
+//
+// Partition check happens here, on the main thread, so a buggy shard script can never touch state
+// it does not own: only entity opcodes whose target maps to the writing shard are applied.
+//----------------------------------------------------------------------------------------------------
+uint32_t JSWorkerPool::Drain(TypedCommandBuffer& applyBuffer)
+{
+    if (!m_isStarted || !IsFrameComplete())
+    {
+        return 0;
+    }
+
+    sTypedCommandFrame frame;
+    uint32_t           appliedRecords = 0;
+
+    for (JSShardJob* shard : m_shards)
+    {
+        if (shard->GetTypedBuffer().Capture(frame) == 0 && frame.overflowCount == 0)
+        {
+            continue;
+        }
+
+        uint32_t const shardIndex = shard->GetShardIndex();
+        auto const     isForeign  = [this, shardIndex](sTypedCommandRecord const& record)
+        {
+            bool const isEntityOpcode = record.opcode >= static_cast<uint32_t>(eTypedCommand::ENTITY_UPDATE_POSITION) &&
+                                        record.opcode <= static_cast<uint32_t>(eTypedCommand::ENTITY_UPDATE_COLOR);
+            return !isEntityOpcode || GetShardIndex(static_cast<EntityID>(record.targetId)) != shardIndex;
+        };
+
+        auto const firstForeign = std::remove_if(frame.records.begin(), frame.records.end(), isForeign);
+        m_partitionViolations += static_cast<uint64_t>(frame.records.end() - firstForeign);
+        frame.records.erase(firstForeign, frame.records.end());
+
+        m_overflows += frame.overflowCount;
+        appliedRecords += applyBuffer.Apply(frame);
+    }
+
+    ++m_frames;
+    m_lastRecords = appliedRecords;
+    m_totalRecords += appliedRecords;
+    return appliedRecords;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JSWorkerPool::RequestShutdown()
+{
+    for (JSShardJob* shard : m_shards)
+    {
+        shard->RequestShutdown();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JSWorkerPool::IsShutdownComplete() const
+{
+    if (!m_isStarted)
+    {
+        return true;
+    }
+
+    return std::all_of(m_shards.begin(), m_shards.end(), [](JSShardJob const* shard) { return shard->IsShutdownComplete(); });
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JSWorkerPool::OwnsJob(Job const* job) const
+{
+    return std::find(m_shards.begin(), m_shards.end(), job) != m_shards.end();
+}
+
+//----------------------------------------------------------------------------------------------------
+sJSWorkerPoolStats JSWorkerPool::GetStats() const
+{
+    sJSWorkerPoolStats stats;
+    stats.shardCount          = GetShardCount();
+    stats.frames              = m_frames;
+    stats.lastRecords         = m_lastRecords;
+    stats.totalRecords        = m_totalRecords;
+    stats.partitionViolations = m_partitionViolations;
+    stats.overflows           = m_overflows;
+
+    for (JSShardJob const* shard : m_shards)
+    {
+        if (shard->IsReady())
+        {
+            ++stats.readyShards;
+            stats.slowestInitMs = std::max(stats.slowestInitMs, shard->GetInitMs());
+        }
+        stats.lastFrameMs = std::max(stats.lastFrameMs, shard->GetLastFrameMs());
+        stats.exceptions += shard->GetExceptionCount();
+    }
+
+    return stats;
+}
@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------------------------------
+// JSWorkerPool.hpp
+// Multi-isolate JavaScript worker pool for sharded entity behaviors
+//
+// Purpose:
+//   JSGameLogicJob runs all game logic in one V8 isolate on one JobSystem thread, so behavior-heavy
+//   scenes are capped by a single core. The pool runs N additional isolates, one per JobSystem
+//   worker, each executing Data/Scripts/Workers/ShardRuntime.js for the entities assigned to it.
+//   Entities are sharded by EntityID % N and each shard writes only its own partition.
+//
+// Design:
+//   - Shard isolates are independent of ScriptSubsystem: own isolate, own context, own typed command
+//     buffer (globalThis.typedCommandBuffer), and a minimal global surface (console.log, shardIndex,
+//     shardCount, submitCommand). No ES modules, no KADI, no callbacks
+//   - submitCommand(type, payload) sends a fire-and-forget GenericCommand through the
+//     ExternalCommandQueue: each shard thread is one producer of the "jsWorkerPool" agent, and the
+//     main thread runs the command in ProcessGenericCommands() like a JS CommandQueue.submit()
+//   - Assignment: entity.set_worker_behavior sends the entity's current back-buffer transform to the
+//     owning shard's inbox; the shard applies its inbox at the start of its next frame
+//   - One merged completion signal: TriggerNextFrame() arms a counter of N shards, each shard
+//     decrements it when done, IsFrameComplete() is true once it reaches zero
+//   - Drain(): copies each shard's typed records out (shards are idle) and applies them through the
+//     main TypedCommandBuffer handlers; the next state buffer swap publishes them with the main frame
+//   - The pool runs beside JSGameLogicJob, not in its handshake: a slow or stuck shard never stalls
+//     the main isolate, it only delays its own entities
+//
+// Partition Safety:
+//   - Safe:   ENTITY_UPDATE_POSITION, ENTITY_MOVE_BY, ENTITY_UPDATE_ORIENTATION, ENTITY_UPDATE_COLOR
+//             for an entity owned by the writing shard (EntityID % N == shard index)
+//   - Unsafe: camera / audio opcodes and records for entities owned by another shard; these are
+//             dropped and counted as partitionViolations
+//   - Writes outside the partition (audio, camera, entity create/destroy) go through submitCommand;
+//     they run on the main thread after the pool frame, with no ordering against typed records
+//   - Not available in shards: command results / callbacks, engine script APIs
+//   - An entity handed to the pool must not also be driven by the main isolate; pool records are
+//     drained before the main isolate's frame, so the main isolate wins for fields both sides write
+//
+// Thread Safety Model:
+//   - Main Thread: Start(), Assign(), TriggerNextFrame(), IsFrameComplete(), Drain(), shutdown
+//   - Shard Threads: each shard's isolate is touched only by its own JobSystem thread
+//   - Inboxes are mutex-protected; typed buffers are only read by Drain() after IsFrameComplete()
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Entity/EntityStateBuffer.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class ExternalCommandQueue;
+class Job;
+class JSShardJob;            // Defined in JSWorkerPool.cpp (owns the V8 handles)
+class TypedCommandBuffer;
+
+//----------------------------------------------------------------------------------------------------
+// Entity hand-off to a shard; an empty behaviorType releases the entity
+//----------------------------------------------------------------------------------------------------
+struct sShardAssignment
+{
+    EntityID    entityId = 0;
+    String      behaviorType;
+    Vec3        position;
+    EulerAngles orientation;
+    Rgba8       color = Rgba8::WHITE;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sJSWorkerPoolStats
+{
+    uint32_t shardCount          = 0;
+    uint32_t readyShards         = 0;      // Shards whose runtime script loaded
+    uint64_t frames              = 0;      // Merged pool frames drained
+    double   lastFrameMs         = 0.0;    // Slowest shard in the last frame
+    uint32_t lastRecords         = 0;
+    uint64_t totalRecords        = 0;
+    uint64_t partitionViolations = 0;
+    uint64_t overflows           = 0;
+    uint64_t exceptions          = 0;
+    double   slowestInitMs       = 0.0;    // Isolate + context + runtime script, slowest ready shard
+};
+
+//----------------------------------------------------------------------------------------------------
+class JSWorkerPool
+{
+public:
+    static uint32_t constexpr MAX_SHARDS = 16;
+
+    // commandQueue (optional) backs the shards' submitCommand; it must outlive the pool
+    JSWorkerPool(uint32_t shardCount, String const& runtimeScriptPath, uint32_t typedRecordCapacity, ExternalCommandQueue* commandQueue = nullptr);
+    ~JSWorkerPool();
+
+    JSWorkerPool(JSWorkerPool const&)            = delete;
+    JSWorkerPool& operator=(JSWorkerPool const&) = delete;
+
+    // Submit one long-running job per shard to g_jobSystem
+    void Start();
+
+    uint32_t GetShardCount() const { return static_cast<uint32_t>(m_shards.size()); }
+    uint32_t GetShardIndex(EntityID entityId) const { return static_cast<uint32_t>(entityId % m_shards.size()); }
+
+    // Queue an assignment (or release) for the owning shard; returns the shard index
+    uint32_t Assign(sShardAssignment const& assignment);
+
+    //------------------------------------------------------------------------------------------------
+    // Frame Synchronization (Main Thread)
+    //------------------------------------------------------------------------------------------------
+    void TriggerNextFrame(float deltaSeconds);
+    bool IsFrameComplete() const { return m_pendingShards.load(std::memory_order_acquire) == 0; }
+
+    // Apply every shard's records through applyBuffer's handlers; returns records applied
+    // Precondition: IsFrameComplete()
+    uint32_t Drain(TypedCommandBuffer& applyBuffer);
+
+    //------------------------------------------------------------------------------------------------
+    // Shutdown (Main Thread)
+    //------------------------------------------------------------------------------------------------
+    void RequestShutdown();
+    bool IsShutdownComplete() const;
+    bool OwnsJob(Job const* job) const;    // Lets App::Shutdown skip pool jobs while draining JobSystem
+
+    sJSWorkerPoolStats GetStats() const;
+
+private:
+    std::vector<JSShardJob*> m_shards;
+    std::atomic<uint32_t>    m_pendingShards{0};
+    bool                     m_isStarted = false;
+
+    uint64_t m_frames              = 0;
+    uint32_t m_lastRecords         = 0;
+    uint64_t m_totalRecords        = 0;
+    uint64_t m_partitionViolations = 0;
+    uint64_t m_overflows           = 0;
+};
@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------------------------------
+// MeshHandleTable.cpp
+// Interned mesh handles for the entity render loop
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/MeshHandleTable.hpp"
+
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+MeshHandle MeshHandleTable::Intern(String const& meshType, float const radius)
+{
+    bool const     isModel = meshType.size() > 4 && meshType.compare(0, 4, "obj:") == 0;
+    sKeyView const key{meshType, isModel ? 0.f : radius};
+
+    auto const it = m_lookup.find(key);
+    if (it != m_lookup.end())
+    {
+        return it->second;
+    }
+
+    MeshHandle const handle = static_cast<MeshHandle>(m_entries.size());
+
+    sMeshHandleEntry entry;
+    entry.meshType = meshType;
+    entry.radius   = radius;
+    entry.isModel  = isModel;
+    m_entries.push_back(entry);
+
+    m_lookup.emplace(sKey{meshType, key.radius}, handle);
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t MeshHandleTable::sKeyHash::operator()(sKeyView const& key) const
+{
+    size_t const typeHash   = std::hash<std::string_view>{}(key.meshType);
+    size_t const radiusHash = std::hash<float>{}(key.radius);
+    return typeHash ^ (radiusHash + 0x9e3779b97f4a7c15ull + (typeHash << 6) + (typeHash >> 2));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Resolve
+//
+// The MeshCache lookup happens once per handle; an unavailable mesh is retried on later frames so
+// a late-loading resource still appears. Models go through the request function when one is set.
+//----------------------------------------------------------------------------------------------------
+sMeshHandleEntry const* MeshHandleTable::Resolve(MeshHandle const handle, MeshCache& meshCache)
+{
+    if (handle >= m_entries.size())
+    {
+        return nullptr;
+    }
+
+    sMeshHandleEntry& entry = m_entries[handle];
+
+    if (entry.isModel)
+    {
+        if (!entry.model && m_modelRequest)
+        {
+            if (!entry.isModelRequested)
+            {
+                entry.isModelRequested = true;
+                m_modelRequest(handle, entry.meshType);
+            }
+            return nullptr;
+        }
+        if (!entry.model)
+        {
+            entry.model = meshCache.GetOrCreateModel(entry.meshType);
+        }
+        return (entry.model && !entry.model->vertices.empty()) ? &entry : nullptr;
+    }
+
+    if (!entry.primitive)
+    {
+        entry.primitive = meshCache.GetOrCreate(entry.meshType, entry.radius, Rgba8::WHITE);
+    }
+    return (entry.primitive && !entry.primitive->empty()) ? &entry : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+sMeshHandleEntry const* MeshHandleTable::ResolveForDraw(MeshHandle& handle, MeshCache& meshCache, bool& isPlaceholder)
+{
+    isPlaceholder = false;
+
+    sMeshHandleEntry const* entry = Resolve(handle, meshCache);
+    if (entry || m_placeholder == INVALID_MESH_HANDLE || !IsModelPending(handle))
+    {
+        return entry;
+    }
+
+    entry = Resolve(m_placeholder, meshCache);
+    if (entry)
+    {
+        handle        = m_placeholder;
+        isPlaceholder = true;
+    }
+    return entry;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MeshHandleTable::SetModel(MeshHandle const handle, ModelMeshData const* model, float const localBoundRadius)
+{
+    if (handle >= m_entries.size() || !m_entries[handle].isModel)
+    {
+        return;
+    }
+
+    sMeshHandleEntry& entry = m_entries[handle];
+    entry.isModelRequested  = true;
+    entry.isModelFailed     = model == nullptr || model->vertices.empty();
+    entry.model             = entry.isModelFailed ? nullptr : model;
+    entry.localBoundRadius  = entry.isModelFailed ? -1.f : localBoundRadius;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MeshHandleTable::IsModelPending(MeshHandle const handle) const
+{
+    if (handle >= m_entries.size())
+    {
+        return false;
+    }
+
+    sMeshHandleEntry const& entry = m_entries[handle];
+    return entry.isModel && !entry.model && !entry.isModelFailed;
+}
+
+//----------------------------------------------------------------------------------------------------
+float MeshHandleTable::GetBoundRadius(MeshHandle const handle, float const entityScale, MeshCache& meshCache)
+{
+    if (!Resolve(handle, meshCache))
+    {
+        return entityScale;
+    }
+
+    sMeshHandleEntry& entry = m_entries[handle];
+    if (entry.localBoundRadius < 0.f)
+    {
+        float maxLengthSquared = 0.f;
+        if (entry.isModel)
+        {
+            for (Vertex_PCUTBN const& vert : entry.model->vertices)
+            {
+                float const lengthSquared = vert.m_position.GetLengthSquared();
+                if (lengthSquared > maxLengthSquared) maxLengthSquared = lengthSquared;
+            }
+        }
+        else
+        {
+            for (Vertex_PCU const& vert : *entry.primitive)
+            {
+                float const lengthSquared = vert.m_position.GetLengthSquared();
+                if (lengthSquared > maxLengthSquared) maxLengthSquared = lengthSquared;
+            }
+        }
+        entry.localBoundRadius = std::sqrt(maxLengthSquared);
+    }
+
+    return entry.isModel ? entry.localBoundRadius * entityScale : entry.localBoundRadius;
+}
+
+//----------------------------------------------------------------------------------------------------
+sMeshHandleEntry const* MeshHandleTable::Find(MeshHandle const handle) const
+{
+    return (handle < m_entries.size()) ? &m_entries[handle] : nullptr;
+}
@@ -0,0 +1,134 @@
+//----------------------------------------------------------------------------------------------------
+// MeshHandleTable.hpp
+// Interned mesh handles for the entity render loop
+//
+// Purpose:
+//   Entities used to carry their mesh as a string ("cube", "obj:Data/Models/Foo.obj"), so every
+//   frame RenderEntities() re-tested the "obj:" prefix and looked the mesh up in MeshCache by string
+//   key. The table resolves (meshType, radius) to a dense integer handle once, at create_mesh /
+//   load_model time, and caches the MeshCache vertex pointers on first render. Per-frame access is
+//   a vector index with no string work and no allocation.
+//
+// Notes:
+//   - Primitives bake radius into their vertices, so each distinct (meshType, radius) pair gets its
+//     own handle; OBJ models are scaled through the model matrix and intern by meshType only
+//   - Cached pointers rely on MeshCache never evicting entries while the table is alive
+//   - With a model request function installed (App: AsyncModelLoader), Resolve() never parses an
+//     OBJ: an unloaded model is requested once and stays pending until SetModel(). ResolveForDraw()
+//     substitutes the placeholder mesh for pending models so the entity is visible while it loads
+//
+// Thread Safety Model:
+//   - Main thread only (GenericCommand handlers and RenderEntities())
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Resource/MeshCache.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+using MeshHandle = uint32_t;
+
+MeshHandle constexpr INVALID_MESH_HANDLE = 0xFFFFFFFFu;
+
+//----------------------------------------------------------------------------------------------------
+struct sMeshHandleEntry
+{
+    String meshType;
+    float  radius  = 1.f;
+    bool   isModel = false;        // "obj:" prefix — PCUTBN indexed draw, scaled by model matrix
+
+    // Resolved lazily on first render (vertex data is still created lazily by MeshCache)
+    VertexList_PCU const* primitive = nullptr;
+    ModelMeshData const*  model     = nullptr;
+
+    float localBoundRadius = -1.f;     // Max vertex distance from the origin; < 0 until computed
+
+    bool isModelRequested = false;     // Handed to the model request function, waiting for SetModel()
+    bool isModelFailed    = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+class MeshHandleTable
+{
+public:
+    using ModelRequestFunction = std::function<void(MeshHandle handle, String const& meshType)>;
+
+    // Return the existing handle for (meshType, radius) or create one. Allocates only for new keys
+    // (the lookup is heterogeneous, so a hit builds no key string).
+    MeshHandle Intern(String const& meshType, float radius);
+
+    // Return the entry with its MeshCache pointers resolved, or nullptr if the mesh is unavailable
+    sMeshHandleEntry const* Resolve(MeshHandle handle, MeshCache& meshCache);
+
+    // Resolve, drawing a model that is still loading as the placeholder. handle is replaced by the
+    // placeholder's so GPU buffers and batching key on the mesh actually drawn; isPlaceholder tells
+    // the caller to scale it like a model
+    sMeshHandleEntry const* ResolveForDraw(MeshHandle& handle, MeshCache& meshCache, bool& isPlaceholder);
+
+    // Route unloaded models to an asynchronous loader instead of loading them inside Resolve()
+    void SetModelRequestFunction(ModelRequestFunction request) { m_modelRequest = std::move(request); }
+
+    // Placeholder for pending models (INVALID_MESH_HANDLE = draw nothing until loaded)
+    void SetPlaceholder(MeshHandle placeholder) { m_placeholder = placeholder; }
+
+    // Publish a model loaded elsewhere; nullptr marks the load as failed
+    void SetModel(MeshHandle handle, ModelMeshData const* model, float localBoundRadius);
+
+    bool IsModelPending(MeshHandle handle) const;
+
+    // World-space bounding sphere radius for an entity using this mesh. Models scale by entityScale;
+    // primitives already bake their radius into the vertices. Falls back to entityScale if unresolved.
+    float GetBoundRadius(MeshHandle handle, float entityScale, MeshCache& meshCache);
+
+    sMeshHandleEntry const* Find(MeshHandle handle) const;
+    uint32_t                GetCount() const { return static_cast<uint32_t>(m_entries.size()); }
+
+private:
+    // Lookup key; models use radius 0. Probed through sKeyView so a hit builds no String.
+    struct sKey
+    {
+        String meshType;
+        float  radius = 0.f;
+    };
+
+    struct sKeyView
+    {
+        std::string_view meshType;
+        float            radius = 0.f;
+    };
+
+    struct sKeyHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(sKeyView const& key) const;
+        size_t operator()(sKey const& key) const { return (*this)(sKeyView{key.meshType, key.radius}); }
+    };
+
+    struct sKeyEqual
+    {
+        using is_transparent = void;
+
+        static sKeyView View(sKey const& key) { return sKeyView{key.meshType, key.radius}; }
+        static sKeyView View(sKeyView const& key) { return key; }
+
+        template <typename A, typename B>
+        bool operator()(A const& a, B const& b) const
+        {
+            return View(a).radius == View(b).radius && View(a).meshType == View(b).meshType;
+        }
+    };
+
+    std::vector<sMeshHandleEntry>                             m_entries;
+    std::unordered_map<sKey, MeshHandle, sKeyHash, sKeyEqual> m_lookup;
+    ModelRequestFunction                                      m_modelRequest;
+    MeshHandle                                                m_placeholder = INVALID_MESH_HANDLE;
+};
@@ -0,0 +1,347 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptDirectoryWatcher.cpp
+// OS change notifications for a script directory tree, debounced on a dedicated I/O thread
+//----------------------------------------------------------------------------------------------------
+
+// Prevent Windows.h min/max macros from conflicting with the standard library
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "Game/Framework/ScriptDirectoryWatcher.hpp"
+
+#include "Engine/Core/LogSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+//----------------------------------------------------------------------------------------------------
+static DWORD constexpr NOTIFY_BUFFER_BYTES = 64 * 1024;     // Network shares reject more than 64 KB
+static DWORD constexpr NOTIFY_FILTER       = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t ToTicks(FILETIME const& time)
+{
+    ULARGE_INTEGER ticks;
+    ticks.LowPart  = time.dwLowDateTime;
+    ticks.HighPart = time.dwHighDateTime;
+    return ticks.QuadPart;
+}
+
+//----------------------------------------------------------------------------------------------------
+static String ToUtf8(wchar_t const* text, int length)
+{
+    int const bytes = WideCharToMultiByte(CP_UTF8, 0, text, length, nullptr, 0, nullptr, nullptr);
+    if (bytes <= 0) return String();
+
+    String result(static_cast<size_t>(bytes), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text, length, result.data(), bytes, nullptr, nullptr);
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool HasExtension(String const& path, String const& extension)
+{
+    if (path.size() < extension.size()) return false;
+
+    return std::equal(extension.begin(), extension.end(), path.end() - static_cast<ptrdiff_t>(extension.size()),
+                      [](char const a, char const b) { return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b)); });
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t ScriptDirectoryWatcher::GetNowTicks()
+{
+    FILETIME now;
+    GetSystemTimePreciseAsFileTime(&now);
+    return ToTicks(now);
+}
+
+//----------------------------------------------------------------------------------------------------
+double ScriptDirectoryWatcher::TicksToMs(uint64_t const fromTicks, uint64_t const toTicks)
+{
+    return (toTicks > fromTicks) ? static_cast<double>(toTicks - fromTicks) / 10000.0 : 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptDirectoryWatcher::ScriptDirectoryWatcher(String const& directory, uint32_t const debounceMs, String const& extension)
+    : m_directory(directory),
+      m_extension(extension),
+      m_debounceMs(debounceMs)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptDirectoryWatcher::~ScriptDirectoryWatcher()
+{
+    Stop();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptDirectoryWatcher::Start()
+{
+    if (m_thread.joinable())
+    {
+        return m_isRunning.load();
+    }
+
+    HANDLE const directory = CreateFileW(fs::path(m_directory).c_str(), FILE_LIST_DIRECTORY,
+                                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                         FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (directory == INVALID_HANDLE_VALUE)
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning,
+                   Stringf("ScriptDirectoryWatcher: cannot open '%s' (error %lu)", m_directory.c_str(), GetLastError()));
+        return false;
+    }
+
+    m_directoryHandle = directory;
+    m_stopEvent       = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    m_isRunning.store(true);
+
+    std::promise<bool> firstReadIssued;
+    std::future<bool>  isFirstReadIssued = firstReadIssued.get_future();
+    m_thread = std::thread(&ScriptDirectoryWatcher::ThreadMain, this, &firstReadIssued);
+    if (!isFirstReadIssued.get())
+    {
+        Stop();
+        return false;
+    }
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log,
+               Stringf("ScriptDirectoryWatcher: watching '%s' for *%s changes (debounce %u ms)", m_directory.c_str(), m_extension.c_str(), m_debounceMs));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptDirectoryWatcher::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    SetEvent(static_cast<HANDLE>(m_stopEvent));
+    m_thread.join();
+
+    CloseHandle(static_cast<HANDLE>(m_stopEvent));
+    CloseHandle(static_cast<HANDLE>(m_directoryHandle));
+    m_stopEvent       = nullptr;
+    m_directoryHandle = nullptr;
+    m_isRunning.store(false);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptDirectoryWatcher::TakeReadyChanges(std::vector<sScriptFileChange>& outChanges)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_ready.empty())
+    {
+        return false;
+    }
+
+    outChanges.insert(outChanges.end(), std::make_move_iterator(m_ready.begin()), std::make_move_iterator(m_ready.end()));
+    m_ready.clear();
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptDirectoryWatcher::TakeRescanRequest()
+{
+    return m_isRescanNeeded.exchange(false);
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptWatcherStats ScriptDirectoryWatcher::GetStats() const
+{
+    sScriptWatcherStats stats;
+    stats.isRunning     = m_isRunning.load(std::memory_order_relaxed);
+    stats.notifications = m_notifications.load(std::memory_order_relaxed);
+    stats.fileEvents    = m_fileEvents.load(std::memory_order_relaxed);
+    stats.changesReady  = m_changesReady.load(std::memory_order_relaxed);
+    stats.overflows     = m_overflows.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ThreadMain
+//
+// One overlapped read is always outstanding. The wait timeout is the time until the oldest pending
+// path has been quiet for debounceMs, so the thread only wakes for notifications, debounce
+// deadlines and Stop(). The outcome of the first read is handed to Start(); any exit clears
+// m_isRunning.
+//----------------------------------------------------------------------------------------------------
+void ScriptDirectoryWatcher::ThreadMain(std::promise<bool>* const firstReadIssued)
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct sPendingChange
+    {
+        sScriptFileChange change;
+        std::wstring      fileName;     // As reported, for GetFileAttributesExW
+        Clock::time_point lastEvent;
+    };
+
+    HANDLE const directory = static_cast<HANDLE>(m_directoryHandle);
+    HANDLE const stopEvent = static_cast<HANDLE>(m_stopEvent);
+
+    std::vector<DWORD> buffer(NOTIFY_BUFFER_BYTES / sizeof(DWORD));     // DWORD-aligned, as required
+    OVERLAPPED         overlapped = {};
+    overlapped.hEvent             = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    std::unordered_map<String, sPendingChange> pending;
+    bool                                       isReadIssued = false;
+
+    auto const issueRead = [&]() -> bool
+    {
+        ResetEvent(overlapped.hEvent);
+        isReadIssued = ReadDirectoryChangesW(directory, buffer.data(), NOTIFY_BUFFER_BYTES, TRUE, NOTIFY_FILTER, nullptr, &overlapped, nullptr) != FALSE;
+        if (!isReadIssued)
+        {
+            DAEMON_LOG(LogScript, eLogVerbosity::Error,
+                       Stringf("ScriptDirectoryWatcher: ReadDirectoryChangesW failed (error %lu), watcher stopped", GetLastError()));
+        }
+        return isReadIssued;
+    };
+
+    auto const recordEvent = [&](String const& path, std::wstring const& fileName, bool const isRemoved)
+    {
+        m_fileEvents.fetch_add(1, std::memory_order_relaxed);
+
+        sPendingChange& entry = pending[path];
+        if (entry.change.eventCount == 0)
+        {
+            entry.change.path           = path;
+            entry.change.firstEventTime = GetNowTicks();
+            entry.fileName              = fileName;
+        }
+        entry.change.isRemoved = isRemoved;
+        ++entry.change.eventCount;
+        entry.lastEvent = Clock::now();
+    };
+
+    auto const parseNotifications = [&](DWORD const bytes)
+    {
+        uint8_t const* cursor = reinterpret_cast<uint8_t const*>(buffer.data());
+        uint8_t const* end    = cursor + bytes;
+        while (cursor < end)
+        {
+            FILE_NOTIFY_INFORMATION const* info = reinterpret_cast<FILE_NOTIFY_INFORMATION const*>(cursor);
+
+            std::wstring const fileName(info->FileName, info->FileNameLength / sizeof(wchar_t));
+            String             path = ToUtf8(fileName.c_str(), static_cast<int>(fileName.size()));
+            std::replace(path.begin(), path.end(), '\\', '/');
+            if (HasExtension(path, m_extension))
+            {
+                bool const isRemoved = info->Action == FILE_ACTION_REMOVED || info->Action == FILE_ACTION_RENAMED_OLD_NAME;
+                recordEvent(path, fileName, isRemoved);
+            }
+
+            if (info->NextEntryOffset == 0) break;
+            cursor += info->NextEntryOffset;
+        }
+    };
+
+    auto const promoteQuietChanges = [&]() -> DWORD
+    {
+        Clock::time_point const now     = Clock::now();
+        Clock::duration const   quiet   = std::chrono::milliseconds(m_debounceMs);
+        Clock::duration         nextDue = Clock::duration::max();
+
+        std::vector<sScriptFileChange> promoted;
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            Clock::duration const age = now - it->second.lastEvent;
+            if (age < quiet)
+            {
+                nextDue = std::min(nextDue, quiet - age);
+                ++it;
+                continue;
+            }
+
+            sScriptFileChange change = std::move(it->second.change);
+            change.readyTime         = GetNowTicks();
+            change.writeTime         = change.firstEventTime;
+
+            WIN32_FILE_ATTRIBUTE_DATA attributes;
+            if (!change.isRemoved && GetFileAttributesExW((fs::path(m_directory) / it->second.fileName).c_str(), GetFileExInfoStandard, &attributes))
+            {
+                change.writeTime = ToTicks(attributes.ftLastWriteTime);
+            }
+            promoted.push_back(std::move(change));
+            it = pending.erase(it);
+        }
+
+        if (!promoted.empty())
+        {
+            m_changesReady.fetch_add(promoted.size(), std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ready.insert(m_ready.end(), std::make_move_iterator(promoted.begin()), std::make_move_iterator(promoted.end()));
+        }
+
+        if (nextDue == Clock::duration::max()) return INFINITE;
+        return static_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(nextDue).count()) + 1;
+    };
+
+    firstReadIssued->set_value(issueRead());     // Start() returns after this; the promise dies with it
+
+    DWORD timeoutMs = INFINITE;
+    while (isReadIssued)
+    {
+        HANDLE const handles[2] = {stopEvent, overlapped.hEvent};
+        DWORD const  wait       = WaitForMultipleObjects(2, handles, FALSE, timeoutMs);
+
+        if (wait == WAIT_OBJECT_0)
+        {
+            break;
+        }
+        if (wait == WAIT_FAILED)
+        {
+            DAEMON_LOG(LogScript, eLogVerbosity::Error,
+                       Stringf("ScriptDirectoryWatcher: wait failed (error %lu), watcher stopped", GetLastError()));
+            break;
+        }
+
+        if (wait == WAIT_OBJECT_0 + 1)
+        {
+            DWORD bytes = 0;
+            m_notifications.fetch_add(1, std::memory_order_relaxed);
+
+            if (!GetOverlappedResult(directory, &overlapped, &bytes, FALSE) || bytes == 0)
+            {
+                // ERROR_NOTIFY_ENUM_DIR or a zero-length completion: the changes did not fit the buffer
+                m_overflows.fetch_add(1, std::memory_order_relaxed);
+                m_isRescanNeeded.store(true);
+                DAEMON_LOG(LogScript, eLogVerbosity::Warning, "ScriptDirectoryWatcher: notification buffer overflow, rescan requested");
+            }
+            else
+            {
+                parseNotifications(bytes);
+            }
+
+            if (!issueRead()) break;
+        }
+
+        timeoutMs = promoteQuietChanges();
+    }
+
+    if (isReadIssued)
+    {
+        DWORD bytes = 0;
+        CancelIoEx(directory, &overlapped);
+        GetOverlappedResult(directory, &overlapped, &bytes, TRUE);
+    }
+    CloseHandle(overlapped.hEvent);
+    m_isRunning.store(false);
+}
@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptDirectoryWatcher.hpp
+// OS change notifications for a script directory tree, debounced on a dedicated I/O thread
+//
+// Purpose:
+//   The Engine FileWatcher behind InitializeHotReload() checks its watched-file list every frame,
+//   which costs main-thread time per script and adds up to a frame of detection latency.
+//   ScriptDirectoryWatcher asks the OS instead: one ReadDirectoryChangesW on the whole tree, waited
+//   on by its own thread, so an unchanged tree costs nothing and a save is seen as soon as the OS
+//   reports it. ScriptHotReloader turns the debounced changes into module reloads.
+//
+// Design:
+//   - Overlapped ReadDirectoryChangesW (recursive) plus a stop event; the thread sleeps in
+//     WaitForMultipleObjects until a notification arrives, a debounce window closes, or Stop()
+//   - Debounce: editors write a file several times per save (truncate, write, attribute update,
+//     temp file + rename). A path becomes ready once it has been quiet for debounceMs
+//   - Only files with the watched extension are reported; removals and rename sources are reported
+//     with isRemoved so the module graph can drop them
+//   - Notification buffer overflow (too many changes at once) cannot say which files changed:
+//     TakeRescanRequest() asks the consumer to rescan the tree instead
+//   - Times are UTC FILETIME ticks (100 ns), comparable with file last-write times
+//   - Start() waits for the thread's first read, so a directory the OS will not watch fails
+//     Start(). A read that fails later ends the thread and clears IsRunning(); the consumer then
+//     falls back to polling (App::ProcessScriptHotReload)
+//
+// Thread Safety Model:
+//   - Start(), Stop(), destructor: main thread
+//   - TakeReadyChanges(), TakeRescanRequest(), IsRunning(), GetStats(): any thread (ready list
+//     under m_mutex)
+//   - Pending (not yet debounced) changes: I/O thread only
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptFileChange
+{
+    String   path;                     // Relative to the watched directory, '/' separators
+    bool     isRemoved      = false;
+    uint32_t eventCount     = 0;       // OS notifications coalesced into this change
+    uint64_t writeTime      = 0;       // File last-write time (firstEventTime if removed or unreadable)
+    uint64_t firstEventTime = 0;       // First notification of the burst
+    uint64_t readyTime      = 0;       // Debounce window closed
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptWatcherStats
+{
+    bool     isRunning     = false;     // False again once the I/O thread gave up
+    uint64_t notifications = 0;     // ReadDirectoryChangesW completions
+    uint64_t fileEvents    = 0;     // Matching-extension entries in those completions
+    uint64_t changesReady  = 0;     // Debounced changes handed out
+    uint64_t overflows     = 0;     // Buffer overflows (each forces a rescan)
+};
+
+//----------------------------------------------------------------------------------------------------
+class ScriptDirectoryWatcher
+{
+public:
+    ScriptDirectoryWatcher(String const& directory, uint32_t debounceMs, String const& extension = ".js");
+    ~ScriptDirectoryWatcher();
+
+    ScriptDirectoryWatcher(ScriptDirectoryWatcher const&)            = delete;
+    ScriptDirectoryWatcher& operator=(ScriptDirectoryWatcher const&) = delete;
+
+    bool Start();     // False if the directory cannot be opened or watched
+    void Stop();
+
+    bool IsRunning() const { return m_isRunning.load(); }     // Started and the I/O thread still watching
+
+    // Appends the changes whose debounce window has closed; false if there were none
+    bool TakeReadyChanges(std::vector<sScriptFileChange>& outChanges);
+    bool TakeRescanRequest();     // True once per overflow since the last call
+
+    sScriptWatcherStats GetStats() const;
+    String const&       GetDirectory() const { return m_directory; }
+    uint32_t            GetDebounceMs() const { return m_debounceMs; }
+
+    static uint64_t GetNowTicks();                                      // UTC FILETIME ticks
+    static double   TicksToMs(uint64_t fromTicks, uint64_t toTicks);     // 0 if toTicks < fromTicks
+
+private:
+    void ThreadMain(std::promise<bool>* firstReadIssued);
+
+    String   m_directory;
+    String   m_extension;
+    uint32_t m_debounceMs;
+
+    void*       m_directoryHandle = nullptr;     // HANDLE (Windows.h stays out of this header)
+    void*       m_stopEvent       = nullptr;     // HANDLE
+    std::thread m_thread;
+
+    mutable std::mutex             m_mutex;
+    std::vector<sScriptFileChange> m_ready;      // Protected by m_mutex
+
+    std::atomic<bool>     m_isRunning{false};       // Cleared by the I/O thread when it exits
+    std::atomic<bool>     m_isRescanNeeded{false};
+    std::atomic<uint64_t> m_notifications{0};
+    std::atomic<uint64_t> m_fileEvents{0};
+    std::atomic<uint64_t> m_changesReady{0};
+    std::atomic<uint64_t> m_overflows{0};
+};
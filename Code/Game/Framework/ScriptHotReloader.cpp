@@ -0,0 +1,542 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptHotReloader.cpp
+// Incremental JavaScript hot reload: OS change notifications in, the smallest module set out
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/ScriptHotReloader.hpp"
+
+#include "Engine/Core/LogSubsystem.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t HashContent(String const& content)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char const c : content)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool ReadFileText(String const& path, String& outText)
+{
+    std::ifstream file(fs::path(path), std::ios::binary);
+    if (!file.is_open()) return false;
+
+    std::ostringstream text;
+    text << file.rdbuf();
+    outText = text.str();
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsIdentifierChar(char const c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+//----------------------------------------------------------------------------------------------------
+// Reads a quoted specifier at source[pos] (pos is past it on return); empty if there is none
+//----------------------------------------------------------------------------------------------------
+static String ReadSpecifier(String const& source, size_t& pos)
+{
+    if (pos >= source.size() || (source[pos] != '\'' && source[pos] != '"')) return String();
+
+    char const   quote = source[pos];
+    size_t const close = source.find_first_of(String(1, quote) + "\n", pos + 1);
+    if (close == String::npos || source[close] != quote) return String();
+
+    String specifier = source.substr(pos + 1, close - pos - 1);
+    pos              = close + 1;
+    return specifier;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ParseImports
+//
+// Finds import './x.js', import ... from './x.js', export ... from './x.js' and import('./x.js').
+// Only relative specifiers are edges: bare and absolute specifiers are not files under the scripts
+// directory. Not a JS parser - an import written inside a comment or string also counts, which at
+// worst reloads one module more than needed.
+//----------------------------------------------------------------------------------------------------
+static void ParseImports(String const& importerPath, String const& source, std::vector<String>& outImports)
+{
+    fs::path const importerDirectory = fs::path(importerPath).parent_path();
+
+    auto const addImport = [&](String const& specifier)
+    {
+        if (specifier.empty() || specifier[0] != '.') return;
+
+        String const key = ScriptHotReloader::MakeModuleKey((importerDirectory / specifier).generic_string());
+        if (std::find(outImports.begin(), outImports.end(), key) == outImports.end())
+        {
+            outImports.push_back(key);
+        }
+    };
+
+    auto const skipSpace = [&](size_t pos)
+    {
+        while (pos < source.size() && std::isspace(static_cast<unsigned char>(source[pos]))) ++pos;
+        return pos;
+    };
+
+    for (char const* keyword : {"import", "export"})
+    {
+        size_t const keywordLength = std::strlen(keyword);
+        bool const   isImport      = keyword[0] == 'i';
+
+        for (size_t pos = source.find(keyword); pos != String::npos; pos = source.find(keyword, pos + 1))
+        {
+            size_t const after = pos + keywordLength;
+            if ((pos > 0 && (IsIdentifierChar(source[pos - 1]) || source[pos - 1] == '.')) ||
+                (after < source.size() && IsIdentifierChar(source[after])))
+            {
+                continue;
+            }
+
+            size_t cursor = skipSpace(after);
+            if (isImport && cursor < source.size() && source[cursor] == '(')
+            {
+                cursor = skipSpace(cursor + 1);
+                addImport(ReadSpecifier(source, cursor));
+                continue;
+            }
+            if (isImport && cursor < source.size() && (source[cursor] == '\'' || source[cursor] == '"'))
+            {
+                addImport(ReadSpecifier(source, cursor));
+                continue;
+            }
+
+            // The clause ends at the first quote (the specifier, if "from" precedes it) or ';'
+            size_t const quote = source.find_first_of("'\";", cursor);
+            if (quote == String::npos || source[quote] == ';') continue;
+
+            size_t fromEnd = quote;
+            while (fromEnd > cursor && std::isspace(static_cast<unsigned char>(source[fromEnd - 1]))) --fromEnd;
+            if (fromEnd - cursor >= 4 && source.compare(fromEnd - 4, 4, "from") == 0 &&
+                (fromEnd - cursor == 4 || !IsIdentifierChar(source[fromEnd - 5])))
+            {
+                size_t specifierPos = quote;
+                addImport(ReadSpecifier(source, specifierPos));
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Modules that register classes with HotReloadRegistry accept their own reload
+//----------------------------------------------------------------------------------------------------
+static bool IsReloadBoundary(String const& source)
+{
+    return source.find("hotReloadRegistry.register(") != String::npos;
+}
+
+//----------------------------------------------------------------------------------------------------
+String ScriptHotReloader::MakeModuleKey(String const& path)
+{
+    String key = fs::path(path).lexically_normal().generic_string();
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char const c) { return static_cast<char>(std::tolower(c)); });
+    return key;
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptHotReloader::ScriptHotReloader(sScriptHotReloadConfig const& config)
+    : m_config(config),
+      m_entryKey(MakeModuleKey(config.entryModule))
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptHotReloader::~ScriptHotReloader()
+{
+    Stop();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ScriptHotReloader::Start()
+{
+    ScanModules();
+
+    m_watcher = new ScriptDirectoryWatcher(m_config.scriptsDirectory, m_config.debounceMs);
+    if (!m_watcher->Start())
+    {
+        delete m_watcher;
+        m_watcher = nullptr;
+        return false;
+    }
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log,
+               Stringf("ScriptHotReloader: %u modules (%u reload boundaries) under '%s', entry '%s'",
+                   m_stats.moduleCount, m_stats.boundaryCount, m_config.scriptsDirectory.c_str(), m_config.entryModule.c_str()));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::Stop()
+{
+    delete m_watcher;
+    m_watcher = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::ScanModules()
+{
+    m_modules.clear();
+
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(m_config.scriptsDirectory, error), end; !error && it != end; it.increment(error))
+    {
+        if (!it->is_regular_file(error)) continue;
+
+        String const extension = MakeModuleKey(it->path().extension().generic_string());
+        if (extension != ".js") continue;
+
+        UpdateModule(fs::relative(it->path(), m_config.scriptsDirectory, error).generic_string());
+    }
+    RebuildImporters();
+}
+
+//----------------------------------------------------------------------------------------------------
+// UpdateModule
+//
+// Re-reads one module. A missing file removes the module; its importers keep the edge, so a later
+// PlanReload() still reaches them.
+//----------------------------------------------------------------------------------------------------
+bool ScriptHotReloader::UpdateModule(String const& path)
+{
+    String const key = MakeModuleKey(path);
+    auto const   it  = m_modules.find(key);
+
+    String source;
+    if (!ReadFileText(m_config.scriptsDirectory + "/" + path, source))
+    {
+        if (it == m_modules.end()) return false;
+
+        m_modules.erase(it);
+        return true;
+    }
+
+    uint64_t const hash = HashContent(source);
+    if (it != m_modules.end() && it->second.contentHash == hash)
+    {
+        return false;
+    }
+
+    sModule module;
+    module.path        = path;
+    module.contentHash = hash;
+    module.isBoundary  = IsReloadBoundary(source);
+    ParseImports(path, source, module.imports);
+
+    m_modules[key] = std::move(module);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::RebuildImporters()
+{
+    m_importers.clear();
+    m_stats.boundaryCount = 0;
+
+    for (auto const& [key, module] : m_modules)
+    {
+        for (String const& imported : module.imports)
+        {
+            m_importers[imported].push_back(key);
+        }
+        if (module.isBoundary) ++m_stats.boundaryCount;
+    }
+    m_stats.moduleCount = static_cast<uint32_t>(m_modules.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Keys reachable from key through imports (a removed module is reachable but not expanded)
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::CollectReachable(String const& key, std::unordered_set<String>& reachable) const
+{
+    std::vector<String> stack = {key};
+    while (!stack.empty())
+    {
+        String const current = std::move(stack.back());
+        stack.pop_back();
+        if (!reachable.insert(current).second) continue;
+
+        auto const it = m_modules.find(current);
+        if (it == m_modules.end()) continue;
+
+        for (String const& imported : it->second.imports)
+        {
+            if (reachable.find(imported) == reachable.end()) stack.push_back(imported);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Dependencies before importers; import cycles are visited once
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::CollectPostOrder(String const& key, std::unordered_set<String>& visited, std::vector<String>& order) const
+{
+    if (!visited.insert(key).second) return;
+
+    auto const it = m_modules.find(key);
+    if (it == m_modules.end()) return;
+
+    for (String const& imported : it->second.imports)
+    {
+        CollectPostOrder(imported, visited, order);
+    }
+    order.push_back(key);
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptReloadPlan ScriptHotReloader::PlanReload(std::vector<String> const& changedPaths) const
+{
+    sScriptReloadPlan plan;
+
+    std::unordered_set<String> reachable;
+    CollectReachable(m_entryKey, reachable);
+
+    std::unordered_set<String> boundaries;
+    std::unordered_set<String> visited;
+    std::vector<String>        frontier;
+
+    for (String const& path : changedPaths)
+    {
+        String const key = MakeModuleKey(path);
+        plan.changed.push_back(path);
+
+        if (reachable.find(key) == reachable.end())
+        {
+            plan.skipped.push_back(path);
+            continue;
+        }
+
+        frontier.push_back(key);
+        while (!frontier.empty() && !plan.isFullReload)
+        {
+            String const current = std::move(frontier.back());
+            frontier.pop_back();
+            if (!visited.insert(current).second) continue;
+
+            if (current == m_entryKey)
+            {
+                plan.isFullReload = true;
+                break;
+            }
+
+            auto const module = m_modules.find(current);
+            if (module != m_modules.end() && module->second.isBoundary)
+            {
+                boundaries.insert(current);
+                continue;
+            }
+
+            auto const importers = m_importers.find(current);
+            if (importers == m_importers.end()) continue;
+
+            for (String const& importer : importers->second)
+            {
+                if (reachable.find(importer) != reachable.end()) frontier.push_back(importer);
+            }
+        }
+    }
+
+    if (plan.isFullReload)
+    {
+        auto const entry = m_modules.find(m_entryKey);
+        plan.modules.push_back(entry != m_modules.end() ? entry->second.path : m_config.entryModule);
+        return plan;
+    }
+
+    std::unordered_set<String> orderVisited;
+    std::vector<String>        order;
+    CollectPostOrder(m_entryKey, orderVisited, order);
+
+    for (String const& key : order)
+    {
+        if (boundaries.find(key) != boundaries.end())
+        {
+            plan.modules.push_back(m_modules.at(key).path);
+        }
+    }
+    return plan;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Poll
+//
+// Drains the watcher, folds the changes into the module graph and plans one reload for all of
+// them (a save of three files in one debounce window is one reload).
+//----------------------------------------------------------------------------------------------------
+bool ScriptHotReloader::Poll(sScriptReloadPlan& outPlan)
+{
+    if (!m_watcher)
+    {
+        return false;
+    }
+
+    m_changes.clear();
+    std::vector<String> changedPaths;
+    uint64_t            saveTime   = UINT64_MAX;
+    uint64_t            detectTime = UINT64_MAX;
+    uint64_t            readyTime  = 0;
+
+    if (m_watcher->TakeRescanRequest())
+    {
+        // Overflow: compare every module's content with the graph instead
+        ++m_stats.rescans;
+
+        std::unordered_map<String, sModule> const previous = m_modules;
+        ScanModules();
+
+        for (auto const& [key, module] : m_modules)
+        {
+            auto const old = previous.find(key);
+            if (old == previous.end() || old->second.contentHash != module.contentHash) changedPaths.push_back(module.path);
+        }
+        for (auto const& [key, module] : previous)
+        {
+            if (m_modules.find(key) == m_modules.end()) changedPaths.push_back(module.path);
+        }
+
+        uint64_t const now = ScriptDirectoryWatcher::GetNowTicks();
+        saveTime           = now;
+        detectTime         = now;
+        readyTime          = now;
+    }
+
+    m_watcher->TakeReadyChanges(m_changes);
+
+    bool isGraphChanged = false;
+    for (sScriptFileChange const& change : m_changes)
+    {
+        if (m_ignored.find(MakeModuleKey(change.path)) != m_ignored.end()) continue;
+
+        if (!UpdateModule(change.path))
+        {
+            ++m_stats.unchangedSaves;
+            continue;
+        }
+        isGraphChanged = true;
+
+        if (std::find(changedPaths.begin(), changedPaths.end(), change.path) == changedPaths.end())
+        {
+            changedPaths.push_back(change.path);
+        }
+
+        // A write time far older than the notification is a copied or restored file, not a save
+        double const   skewMs      = ScriptDirectoryWatcher::TicksToMs(change.writeTime, change.firstEventTime);
+        bool const     isStampSane = change.writeTime != 0 && change.writeTime <= change.firstEventTime && skewMs <= MAX_WRITE_TIME_SKEW_MS;
+        uint64_t const changeSave  = isStampSane ? change.writeTime : change.firstEventTime;
+
+        saveTime   = std::min(saveTime, changeSave);
+        detectTime = std::min(detectTime, change.firstEventTime);
+        readyTime  = std::max(readyTime, change.readyTime);
+    }
+
+    if (isGraphChanged)
+    {
+        RebuildImporters();
+    }
+    if (changedPaths.empty())
+    {
+        return false;
+    }
+
+    outPlan            = PlanReload(changedPaths);
+    outPlan.saveTime   = saveTime;
+    outPlan.detectTime = detectTime;
+    outPlan.readyTime  = readyTime;
+
+    m_stats.skippedChanges += outPlan.skipped.size();
+    for (String const& skipped : outPlan.skipped)
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Log,
+                   Stringf("ScriptHotReloader: '%s' changed but is not imported from '%s', not reloaded", skipped.c_str(), m_config.entryModule.c_str()));
+    }
+    return !outPlan.modules.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::CompleteReload(sScriptReloadPlan const& plan, bool const isSuccess)
+{
+    uint64_t const liveTime = ScriptDirectoryWatcher::GetNowTicks();
+
+    sScriptReloadRecord record;
+    record.isSuccess      = isSuccess;
+    record.isFullReload   = plan.isFullReload;
+    record.changedCount   = static_cast<uint32_t>(plan.changed.size());
+    record.moduleCount    = static_cast<uint32_t>(plan.modules.size());
+    record.firstChanged   = plan.changed.empty() ? String() : plan.changed.front();
+    record.saveToDetectMs = ScriptDirectoryWatcher::TicksToMs(plan.saveTime, plan.detectTime);
+    record.debounceMs     = ScriptDirectoryWatcher::TicksToMs(plan.detectTime, plan.readyTime);
+    record.executeMs      = ScriptDirectoryWatcher::TicksToMs(plan.readyTime, liveTime);
+    record.saveToLiveMs   = ScriptDirectoryWatcher::TicksToMs(plan.saveTime, liveTime);
+    m_stats.last          = record;
+
+    if (!isSuccess)
+    {
+        ++m_stats.failures;
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning,
+                   Stringf("ScriptHotReloader: reload after '%s' failed, previous code stays live", record.firstChanged.c_str()));
+        return;
+    }
+
+    ++m_stats.reloads;
+    if (plan.isFullReload) ++m_stats.fullReloads;
+    m_stats.modulesExecuted += plan.modules.size();
+    m_stats.totalSaveToLiveMs += record.saveToLiveMs;
+    m_stats.maxSaveToLiveMs = std::max(m_stats.maxSaveToLiveMs, record.saveToLiveMs);
+
+    String modules;
+    for (String const& module : plan.modules)
+    {
+        modules += (modules.empty() ? "" : ", ") + module;
+    }
+    DAEMON_LOG(LogScript, eLogVerbosity::Display,
+               Stringf("ScriptHotReloader: '%s'%s -> %s%s live %.1f ms after save (detect %.1f, debounce %.1f, execute %.1f ms)",
+                   record.firstChanged.c_str(), record.changedCount > 1 ? Stringf(" (+%u)", record.changedCount - 1).c_str() : "",
+                   plan.isFullReload ? "full reload " : "", modules.c_str(),
+                   record.saveToLiveMs, record.saveToDetectMs, record.debounceMs, record.executeMs));
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptHotReloader::SetFileIgnored(String const& path, bool const isIgnored)
+{
+    String const key = MakeModuleKey(path);
+    if (isIgnored)
+    {
+        m_ignored.insert(key);
+    }
+    else
+    {
+        m_ignored.erase(key);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptHotReloadStats ScriptHotReloader::GetStats() const
+{
+    sScriptHotReloadStats stats = m_stats;
+    stats.ignoredCount          = static_cast<uint32_t>(m_ignored.size());
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+sScriptWatcherStats ScriptHotReloader::GetWatcherStats() const
+{
+    return m_watcher ? m_watcher->GetStats() : sScriptWatcherStats();
+}
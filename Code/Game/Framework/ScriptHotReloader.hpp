@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------------------------------
+// ScriptHotReloader.hpp
+// Incremental JavaScript hot reload: OS change notifications in, the smallest module set out
+//
+// Purpose:
+//   With the Engine's InitializeHotReload() every watched file is polled each frame and a change
+//   re-runs the whole framework from main.js, recreating the game. ScriptHotReloader replaces both
+//   halves (HotReload.json eventDriven): ScriptDirectoryWatcher reports saves from the OS, and an
+//   import graph of the scripts directory picks the modules that actually need to run again.
+//   App::ProcessScriptHotReload() executes them and records the save-to-live latency.
+//
+// Design:
+//   - Module graph: every .js under scriptsDirectory is scanned once at Start() for static
+//     imports / re-exports (import ... from './x.js', import './x.js', export ... from './x.js',
+//     import('./x.js')). Only relative specifiers are edges; keys are lower-case, '/'-separated
+//     paths relative to scriptsDirectory (Windows resolves '../Core/' and '../core/' to one file)
+//   - A changed module is re-read; a save whose content hash is unchanged reloads nothing
+//   - Reload boundaries are modules that call hotReloadRegistry.register(...): re-running one
+//     re-registers its classes, and JSGame / JSEngine upgrade live objects from HotReloadRegistry.
+//     A change propagates from the changed module through its importers and stops at the first
+//     boundary on each path. Reaching the entry module (main.js) means nothing on the way accepts
+//     the change: entry is re-run, i.e. the old full reload
+//   - Boundaries run dependencies first; changed modules outside the entry module's graph
+//     (Workers/ShardRuntime.js, ad-hoc scripts) are reported as skipped
+//   - Latency: save = file last-write time (the OS notification time when the file's own stamp is
+//     missing or more than MAX_WRITE_TIME_SKEW_MS older); live = CompleteReload()
+//
+// Thread Safety Model:
+//   - Main thread only (the watcher's I/O thread is internal to ScriptDirectoryWatcher)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ScriptDirectoryWatcher.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptHotReloadConfig
+{
+    bool     isEventDriven    = true;               // false = Engine FileWatcher polling (InitializeHotReload)
+    String   scriptsDirectory = "Data/Scripts";
+    String   entryModule      = "main.js";          // Relative to scriptsDirectory
+    uint32_t debounceMs       = 50;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptReloadPlan
+{
+    std::vector<String> changed;                // Modules whose content changed (scriptsDirectory-relative)
+    std::vector<String> modules;                // Modules to execute, dependencies first
+    std::vector<String> skipped;                // Changed modules outside the entry module's graph
+    bool                isFullReload = false;   // modules is just the entry module
+    uint64_t            saveTime     = 0;       // Earliest save of the changes (FILETIME ticks)
+    uint64_t            detectTime   = 0;       // Earliest OS notification
+    uint64_t            readyTime    = 0;       // Latest debounce close
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptReloadRecord
+{
+    bool     isSuccess      = false;
+    bool     isFullReload   = false;
+    uint32_t changedCount   = 0;
+    uint32_t moduleCount    = 0;       // Modules executed
+    String   firstChanged;
+    double   saveToDetectMs = 0.0;     // File write -> OS notification
+    double   debounceMs     = 0.0;     // Notification -> debounce window closed
+    double   executeMs      = 0.0;     // Debounce closed -> modules executed and instances upgraded
+    double   saveToLiveMs   = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sScriptHotReloadStats
+{
+    uint32_t            moduleCount       = 0;
+    uint32_t            boundaryCount     = 0;
+    uint32_t            ignoredCount      = 0;       // game.remove_watched_file
+    uint64_t            reloads           = 0;
+    uint64_t            fullReloads       = 0;
+    uint64_t            failures          = 0;
+    uint64_t            modulesExecuted   = 0;
+    uint64_t            unchangedSaves    = 0;       // Notifications whose content hash was unchanged
+    uint64_t            skippedChanges    = 0;
+    uint64_t            rescans           = 0;       // Watcher overflows answered with a full rescan
+    double              totalSaveToLiveMs = 0.0;
+    double              maxSaveToLiveMs   = 0.0;
+    sScriptReloadRecord last;
+};
+
+//----------------------------------------------------------------------------------------------------
+class ScriptHotReloader
+{
+public:
+    static double constexpr MAX_WRITE_TIME_SKEW_MS = 2000.0;
+
+    explicit ScriptHotReloader(sScriptHotReloadConfig const& config);
+    ~ScriptHotReloader();
+
+    ScriptHotReloader(ScriptHotReloader const&)            = delete;
+    ScriptHotReloader& operator=(ScriptHotReloader const&) = delete;
+
+    bool Start();     // Scans the module graph, then starts the watcher; false if it cannot watch
+    void Stop();
+
+    bool IsWatching() const { return m_watcher && m_watcher->IsRunning(); }     // False once the watcher failed
+
+    // Once per frame: false if no module needs to run again
+    bool Poll(sScriptReloadPlan& outPlan);
+    void CompleteReload(sScriptReloadPlan const& plan, bool isSuccess);
+
+    // game.add_watched_file / game.remove_watched_file (every script is watched unless ignored)
+    void SetFileIgnored(String const& path, bool isIgnored);
+
+    // Module graph (Poll() keeps it current; PlanReload() does not touch it)
+    void              ScanModules();
+    bool              UpdateModule(String const& path);     // True if added, removed or changed
+    sScriptReloadPlan PlanReload(std::vector<String> const& changedPaths) const;
+
+    String const&         GetScriptsDirectory() const { return m_config.scriptsDirectory; }
+    sScriptHotReloadStats GetStats() const;
+    sScriptWatcherStats   GetWatcherStats() const;
+
+    static String MakeModuleKey(String const& path);
+
+private:
+    struct sModule
+    {
+        String              path;                  // As found on disk
+        uint64_t            contentHash = 0;
+        bool                isBoundary  = false;
+        std::vector<String> imports;               // Module keys
+    };
+
+    void RebuildImporters();
+    void CollectReachable(String const& key, std::unordered_set<String>& reachable) const;
+    void CollectPostOrder(String const& key, std::unordered_set<String>& visited, std::vector<String>& order) const;
+
+    sScriptHotReloadConfig  m_config;
+    String                  m_entryKey;
+    ScriptDirectoryWatcher* m_watcher = nullptr;
+
+    std::unordered_map<String, sModule>             m_modules;       // Key -> module
+    std::unordered_map<String, std::vector<String>> m_importers;     // Key -> keys importing it
+    std::unordered_set<String>                      m_ignored;       // Keys
+
+    std::vector<sScriptFileChange> m_changes;                        // Poll() scratch
+    sScriptHotReloadStats          m_stats;
+};
@@ -0,0 +1,134 @@
+//----------------------------------------------------------------------------------------------------
+// StartupTimeline.cpp
+// Phase-by-phase startup timing, from process creation to the first ready frame
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/StartupTimeline.hpp"
+
+#include "Engine/Core/LogSubsystem.hpp"
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+
+#include <iomanip>
+#include <sstream>
+
+//----------------------------------------------------------------------------------------------------
+// Milliseconds between this process's creation and now (0 if the OS will not say)
+//----------------------------------------------------------------------------------------------------
+static double GetMsSinceProcessCreation()
+{
+    FILETIME creation;
+    FILETIME exitTime;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user))
+    {
+        return 0.0;
+    }
+
+    FILETIME now;
+    GetSystemTimePreciseAsFileTime(&now);
+
+    ULARGE_INTEGER creationTicks;
+    creationTicks.LowPart  = creation.dwLowDateTime;
+    creationTicks.HighPart = creation.dwHighDateTime;
+    ULARGE_INTEGER nowTicks;
+    nowTicks.LowPart  = now.dwLowDateTime;
+    nowTicks.HighPart = now.dwHighDateTime;
+
+    // FILETIME ticks are 100 ns
+    return (nowTicks.QuadPart > creationTicks.QuadPart) ? static_cast<double>(nowTicks.QuadPart - creationTicks.QuadPart) / 10000.0 : 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+StartupTimeline::StartupTimeline()
+    : m_origin(std::chrono::steady_clock::now()),
+      m_originMs(GetMsSinceProcessCreation())
+{
+    sStartupPhase process;
+    process.name       = "process";
+    process.durationMs = m_originMs;
+    m_phases.push_back(process);
+}
+
+//----------------------------------------------------------------------------------------------------
+double StartupTimeline::GetNowMs() const
+{
+    return m_originMs + std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_origin).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+void StartupTimeline::ClosePhase()
+{
+    if (m_isPhaseOpen)
+    {
+        m_phases.back().durationMs = GetNowMs() - m_phases.back().startMs;
+        m_isPhaseOpen              = false;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void StartupTimeline::BeginPhase(char const* name)
+{
+    if (m_isComplete)
+    {
+        return;
+    }
+
+    ClosePhase();
+
+    sStartupPhase phase;
+    phase.name    = name;
+    phase.startMs = GetNowMs();
+    m_phases.push_back(phase);
+    m_isPhaseOpen = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StartupTimeline::MarkFirstFrame()
+{
+    if (m_isComplete)
+    {
+        return;
+    }
+
+    ClosePhase();
+    m_isComplete         = true;
+    m_timeToFirstFrameMs = GetNowMs();
+
+    String breakdown;
+    for (sStartupPhase const& phase : m_phases)
+    {
+        breakdown += Stringf("%s%s %.1f", breakdown.empty() ? "" : ", ", phase.name.c_str(), phase.durationMs);
+    }
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("StartupTimeline: first frame ready %.1f ms after process start (%s ms)", m_timeToFirstFrameMs, breakdown.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------
+String StartupTimeline::ToJsonFields() const
+{
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(2)
+         << R"("isComplete":)" << (m_isComplete ? "true" : "false")
+         << R"(,"timeToFirstFrameMs":)" << m_timeToFirstFrameMs
+         << R"(,"phases":[)";
+
+    for (size_t i = 0; i < m_phases.size(); ++i)
+    {
+        sStartupPhase const& phase = m_phases[i];
+        // An open phase (timeline not complete yet) reports its duration so far
+        double const durationMs = (m_isPhaseOpen && i + 1 == m_phases.size()) ? GetNowMs() - phase.startMs : phase.durationMs;
+        json << (i > 0 ? "," : "") << R"({"name":")" << phase.name
+             << R"(","startMs":)" << phase.startMs
+             << R"(,"durationMs":)" << durationMs << "}";
+    }
+    json << "]";
+    return json.str();
+}
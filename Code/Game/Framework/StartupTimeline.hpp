@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------------------------------
+// StartupTimeline.hpp
+// Phase-by-phase startup timing, from process creation to the first ready frame
+//
+// Purpose:
+//   Time-to-first-frame matters when many instances are spun up per host, but the only signal was
+//   the log timestamps. App::Startup() opens one phase per stage (engine subsystems, command
+//   pipeline and handlers, Game + script bindings, the main.js module graph, worker jobs) and the
+//   first RunFrame() after the JS worker has finished a frame closes the timeline. The breakdown is
+//   logged once and returned by game.get_startup_timing.
+//
+// Design:
+//   - Phases are sequential: BeginPhase() closes the open one, so App::Startup() needs one line per
+//     stage. Times are milliseconds since process creation (GetProcessTimes), and the time before
+//     App::Startup() (loader, static initialization, WinMain) is reported as the "process" phase
+//   - MarkFirstFrame() closes the last phase ("frame1") and freezes the timeline
+//
+// Thread Safety Model:
+//   - Main thread only
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <chrono>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct sStartupPhase
+{
+    String name;
+    double startMs    = 0.0;      // Since process creation
+    double durationMs = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class StartupTimeline
+{
+public:
+    // Call first thing in App::Startup(); records the "process" phase up to now
+    StartupTimeline();
+
+    void BeginPhase(char const* name);
+    void MarkFirstFrame();
+
+    bool   IsComplete() const { return m_isComplete; }
+    double GetTimeToFirstFrameMs() const { return m_timeToFirstFrameMs; }     // 0 until complete
+
+    std::vector<sStartupPhase> const& GetPhases() const { return m_phases; }
+
+    // "isComplete":..,"timeToFirstFrameMs":..,"phases":[{"name","startMs","durationMs"}] for the
+    // game.get_startup_timing result object (no surrounding braces)
+    String ToJsonFields() const;
+
+private:
+    double GetNowMs() const;
+    void   ClosePhase();
+
+    std::chrono::steady_clock::time_point m_origin;                     // Construction
+    double                                m_originMs = 0.0;             // Process creation → m_origin
+    std::vector<sStartupPhase>            m_phases;
+    bool                                  m_isPhaseOpen        = false;
+    bool                                  m_isComplete         = false;
+    double                                m_timeToFirstFrameMs = 0.0;
+};
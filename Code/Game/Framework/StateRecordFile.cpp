@@ -0,0 +1,417 @@
+//----------------------------------------------------------------------------------------------------
+// StateRecordFile.cpp
+// Append-only, memory-mapped file of fixed-width state records with a frame index (.drec)
+//----------------------------------------------------------------------------------------------------
+
+// Prevent Windows.h min/max macros from conflicting with the standard library
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "Game/Framework/StateRecordFile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t constexpr RECORDS_OFFSET = sizeof(sStateRecordFileHeader);
+
+//----------------------------------------------------------------------------------------------------
+static sStateRecord* GetRecords(void* view)
+{
+    return reinterpret_cast<sStateRecord*>(static_cast<uint8_t*>(view) + RECORDS_OFFSET);
+}
+
+//----------------------------------------------------------------------------------------------------
+StateRecordWriter::~StateRecordWriter()
+{
+    Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool StateRecordWriter::Open(String const& path)
+{
+    Close();
+
+    fs::path const  filePath(path);
+    std::error_code error;
+    if (filePath.has_parent_path())
+    {
+        fs::create_directories(filePath.parent_path(), error);
+    }
+
+    HANDLE const file = CreateFileW(filePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    m_file        = file;
+    m_isFailed    = false;
+    m_recordCount = 0;
+    m_frameRecord = INVALID_RECORD;
+    m_frameIndex.clear();
+
+    if (!Grow(GROW_BYTES))
+    {
+        Close();
+        return false;
+    }
+
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+
+    sStateRecordFileHeader* header = GetHeader();
+    *header                        = sStateRecordFileHeader();
+    header->magic                  = MAGIC;
+    header->version                = FORMAT_VERSION;
+    header->recordSize             = sizeof(sStateRecord);
+    header->createdTime            = (static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Close
+//
+// An unfinished frame is dropped: its records were never published to the header.
+//----------------------------------------------------------------------------------------------------
+void StateRecordWriter::Close()
+{
+    if (!m_file)
+    {
+        return;
+    }
+
+    uint64_t fileBytes = 0;
+    if (m_view)
+    {
+        sStateRecordFileHeader const* header = GetHeader();
+        m_recordCount                        = header->recordCount;
+        m_frameRecord                        = INVALID_RECORD;
+
+        uint64_t const indexOffset = GetFileBytes();
+        uint64_t const indexBytes  = m_frameIndex.size() * sizeof(uint64_t);
+        fileBytes                  = indexOffset;
+
+        // Grow() can fail and unmap; the header already on disk then still describes every frame
+        if (indexOffset + indexBytes <= m_capacity || Grow(indexOffset + indexBytes))
+        {
+            std::memcpy(static_cast<uint8_t*>(m_view) + indexOffset, m_frameIndex.data(), indexBytes);
+
+            sStateRecordFileHeader* completeHeader = GetHeader();
+            completeHeader->indexOffset            = indexOffset;
+            completeHeader->isComplete             = 1;
+            fileBytes                              = indexOffset + indexBytes;
+            FlushViewOfFile(m_view, 0);
+        }
+    }
+    Unmap();
+
+    // Drop the unused tail of the last GROW_BYTES step
+    if (fileBytes > 0)
+    {
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(fileBytes);
+        if (SetFilePointerEx(static_cast<HANDLE>(m_file), size, nullptr, FILE_BEGIN))
+        {
+            SetEndOfFile(static_cast<HANDLE>(m_file));
+        }
+    }
+
+    CloseHandle(static_cast<HANDLE>(m_file));
+    m_file        = nullptr;
+    m_recordCount = 0;
+    m_frameRecord = INVALID_RECORD;
+    m_frameIndex.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Grow
+//
+// A mapping larger than the file extends the file (zero-filled), so growing is remap-only.
+//----------------------------------------------------------------------------------------------------
+bool StateRecordWriter::Grow(uint64_t const minimumBytes)
+{
+    uint64_t const capacity = std::max(m_capacity + GROW_BYTES, (minimumBytes + GROW_BYTES - 1) / GROW_BYTES * GROW_BYTES);
+
+    Unmap();
+
+    HANDLE const mapping = CreateFileMappingW(static_cast<HANDLE>(m_file), nullptr, PAGE_READWRITE, static_cast<DWORD>(capacity >> 32),
+                                              static_cast<DWORD>(capacity & 0xFFFFFFFFull), nullptr);
+    if (!mapping)
+    {
+        m_isFailed = true;
+        return false;
+    }
+
+    void* const view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        m_isFailed = true;
+        return false;
+    }
+
+    m_mapping  = mapping;
+    m_view     = view;
+    m_capacity = capacity;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StateRecordWriter::Unmap()
+{
+    if (m_view)
+    {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping)
+    {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        m_mapping = nullptr;
+    }
+    m_capacity = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sStateRecord* StateRecordWriter::Append()
+{
+    if (!m_view || m_isFailed)
+    {
+        return nullptr;
+    }
+
+    uint64_t const requiredBytes = RECORDS_OFFSET + (m_recordCount + 1) * sizeof(sStateRecord);
+    if (requiredBytes > m_capacity && !Grow(requiredBytes))
+    {
+        return nullptr;
+    }
+
+    sStateRecord* const record = GetRecords(m_view) + m_recordCount;
+    *record                    = sStateRecord();
+    ++m_recordCount;
+    return record;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t StateRecordWriter::AppendWithText(sStateRecord const& first, size_t const textOffset, String const& text)
+{
+    sStateRecord* const record = Append();
+    if (!record)
+    {
+        return 0;
+    }
+
+    size_t const inlineBytes = std::min(text.size(), sStateRecord::DATA_SIZE - textOffset);
+    *record                  = first;
+    std::memcpy(record->data + textOffset, text.data(), inlineBytes);
+
+    uint32_t recordsWritten = 1;
+    for (size_t offset = inlineBytes; offset < text.size(); offset += sStateRecord::DATA_SIZE)
+    {
+        sStateRecord* const blob = Append();
+        if (!blob)
+        {
+            return 0;
+        }
+
+        blob->type  = eStateRecordType::BLOB;
+        blob->frame = first.frame;
+        std::memcpy(blob->data, text.data() + offset, std::min(sStateRecord::DATA_SIZE, text.size() - offset));
+        ++recordsWritten;
+    }
+    return recordsWritten;
+}
+
+//----------------------------------------------------------------------------------------------------
+sStateRecord* StateRecordWriter::GetRecord(uint64_t const index)
+{
+    return (m_view && index < m_recordCount) ? GetRecords(m_view) + index : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+sStateRecord* StateRecordWriter::BeginFrame()
+{
+    sStateRecord* const record = Append();
+    if (!record)
+    {
+        return nullptr;
+    }
+
+    record->type  = eStateRecordType::FRAME;
+    record->frame = GetFrameNumber();
+    m_frameRecord = m_recordCount - 1;
+    return record;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StateRecordWriter::EndFrame()
+{
+    if (!IsFrameOpen() || !m_view || m_isFailed)
+    {
+        return;
+    }
+
+    m_frameIndex.push_back(m_frameRecord);
+    m_frameRecord = INVALID_RECORD;
+
+    sStateRecordFileHeader* header = GetHeader();
+    header->recordCount            = m_recordCount;
+    header->frameCount             = m_frameIndex.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t StateRecordWriter::GetFileBytes() const
+{
+    return RECORDS_OFFSET + m_recordCount * sizeof(sStateRecord);
+}
+
+//----------------------------------------------------------------------------------------------------
+StateRecordReader::~StateRecordReader()
+{
+    Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool StateRecordReader::Open(String const& path)
+{
+    Close();
+
+    HANDLE const file = CreateFileW(fs::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        m_error = Stringf("cannot open %s", path.c_str());
+        return false;
+    }
+    m_file = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(RECORDS_OFFSET))
+    {
+        Close();
+        m_error = Stringf("%s is not a state recording (too small)", path.c_str());
+        return false;
+    }
+    m_fileBytes = static_cast<uint64_t>(fileSize.QuadPart);
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_view    = m_mapping ? MapViewOfFile(static_cast<HANDLE>(m_mapping), FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!m_view)
+    {
+        Close();
+        m_error = Stringf("cannot map %s", path.c_str());
+        return false;
+    }
+
+    sStateRecordFileHeader const* header = static_cast<sStateRecordFileHeader const*>(m_view);
+    if (header->magic != StateRecordWriter::MAGIC || header->version != StateRecordWriter::FORMAT_VERSION ||
+        header->recordSize != sizeof(sStateRecord))
+    {
+        uint32_t const version = header->version;
+        Close();
+        m_error = Stringf("%s is not a version %u state recording (version %u)", path.c_str(), StateRecordWriter::FORMAT_VERSION, version);
+        return false;
+    }
+
+    m_records     = GetRecords(m_view);
+    m_recordCount = std::min(header->recordCount, (m_fileBytes - RECORDS_OFFSET) / sizeof(sStateRecord));
+
+    // The written index is trusted only if it fits the file and every entry is a FRAME record
+    uint64_t const indexBytes = header->frameCount * sizeof(uint64_t);
+    m_isComplete              = header->isComplete != 0 && header->recordCount == m_recordCount &&
+                                header->indexOffset >= RECORDS_OFFSET + m_recordCount * sizeof(sStateRecord) &&
+                                header->indexOffset + indexBytes <= m_fileBytes;
+    if (m_isComplete)
+    {
+        m_frameIndex.resize(header->frameCount);
+        std::memcpy(m_frameIndex.data(), static_cast<uint8_t const*>(m_view) + header->indexOffset, indexBytes);
+        m_isComplete = std::all_of(m_frameIndex.begin(), m_frameIndex.end(), [this](uint64_t const index)
+        {
+            return index < m_recordCount && m_records[index].type == eStateRecordType::FRAME;
+        });
+    }
+
+    if (!m_isComplete)
+    {
+        m_frameIndex.clear();
+        for (uint64_t index = 0; index < m_recordCount; ++index)
+        {
+            if (m_records[index].type == eStateRecordType::FRAME)
+            {
+                m_frameIndex.push_back(index);
+            }
+        }
+    }
+
+    m_error.clear();
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StateRecordReader::Close()
+{
+    if (m_view) UnmapViewOfFile(m_view);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+
+    m_view        = nullptr;
+    m_mapping     = nullptr;
+    m_file        = nullptr;
+    m_fileBytes   = 0;
+    m_records     = nullptr;
+    m_recordCount = 0;
+    m_isComplete  = false;
+    m_frameIndex.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+sStateRecord const* StateRecordReader::GetRecord(uint64_t const index) const
+{
+    return (index < m_recordCount) ? m_records + index : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t StateRecordReader::GetFrameEnd(uint64_t const frame) const
+{
+    return (frame + 1 < m_frameIndex.size()) ? m_frameIndex[frame + 1] : m_recordCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool StateRecordReader::ReadText(uint64_t& index, size_t const textOffset, uint32_t const length, String& outText) const
+{
+    sStateRecord const* record = GetRecord(index);
+    if (!record || textOffset > sStateRecord::DATA_SIZE)
+    {
+        return false;
+    }
+
+    size_t const inlineBytes = std::min(static_cast<size_t>(length), sStateRecord::DATA_SIZE - textOffset);
+    outText.assign(reinterpret_cast<char const*>(record->data + textOffset), inlineBytes);
+    ++index;
+
+    while (outText.size() < length)
+    {
+        record = GetRecord(index);
+        if (!record || record->type != eStateRecordType::BLOB)
+        {
+            return false;
+        }
+
+        size_t const chunkBytes = std::min(sStateRecord::DATA_SIZE, static_cast<size_t>(length) - outText.size());
+        outText.append(reinterpret_cast<char const*>(record->data), chunkBytes);
+        ++index;
+    }
+    return true;
+}
@@ -0,0 +1,197 @@
+//----------------------------------------------------------------------------------------------------
+// StateRecordFile.hpp
+// Append-only, memory-mapped file of fixed-width state records with a frame index (.drec)
+//
+// Purpose:
+//   StateRecorder writes what every EntityStore / CameraStateBuffer swap made visible, plus the
+//   GenericCommand stream that caused it, so StateReplayer can later drive the renderer from the
+//   file alone. This file only knows records and frames; what a record means is StateRecorder's.
+//
+// Design:
+//   - Layout: 64-byte header, then 64-byte records, then (once closed) the frame index: one uint64
+//     record number per frame, pointing at that frame's FRAME record
+//   - Fixed width: a record is type / flags / extra / frame plus 56 data bytes. Variable-length text
+//     (mesh types, command payloads) starts in the data of its owning record and continues in BLOB
+//     records, so every record stays addressable by number
+//   - Writer: the file is mapped read-write and grown in GROW_BYTES steps; Append() is a pointer bump
+//     into the view, and EndFrame() patches the frame's FRAME record and the header in place. Mapped
+//     pages belong to the file cache, so a crash loses only the frame in progress
+//   - Close() appends the frame index, marks the header complete and truncates the file to its used
+//     size. A file without an index (crashed recorder) is indexed by the reader with one scan
+//   - Reader: maps the whole file read-only; records are read in place, never copied
+//
+// Thread Safety Model:
+//   - Main thread only (one writer or reader per file per process)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/StringUtils.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+enum class eStateRecordType : uint8_t
+{
+    NONE           = 0,
+    FRAME          = 1,      // First record of every frame
+    ENTITY         = 2,      // Entity visible in the front buffer (created or changed)
+    ENTITY_REMOVED = 3,      // Entity destroyed or deactivated
+    MESH           = 4,      // Recorded MeshHandle -> (meshType, radius); before the first ENTITY using it
+    CAMERA         = 5,      // Camera transform and perspective parameters
+    CAMERA_VIEW    = 6,      // Orthographic parameters, viewport and type of the preceding CAMERA
+    COMMAND        = 7,      // GenericCommand type + JSON payload
+    BLOB           = 8       // Text continuation of the preceding MESH / CAMERA_VIEW / COMMAND
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sStateRecord
+{
+    static size_t constexpr DATA_SIZE = 56;
+
+    eStateRecordType type  = eStateRecordType::NONE;
+    uint8_t          flags = 0;
+    uint16_t         extra = 0;
+    uint32_t         frame = 0;
+    uint8_t          data[DATA_SIZE] = {};
+};
+
+static_assert(sizeof(sStateRecord) == 64, "drec record layout changed, bump StateRecordWriter::FORMAT_VERSION");
+
+//----------------------------------------------------------------------------------------------------
+// Typed access to record data (memcpy: data has no alignment guarantee beyond the record's)
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+void StoreRecordData(sStateRecord& record, T const& value, size_t const offset = 0)
+{
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sStateRecord::DATA_SIZE);
+    std::memcpy(record.data + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T LoadRecordData(sStateRecord const& record, size_t const offset = 0)
+{
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sStateRecord::DATA_SIZE);
+    T value;
+    std::memcpy(&value, record.data + offset, sizeof(T));
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+struct sStateRecordFileHeader
+{
+    uint32_t magic       = 0;
+    uint32_t version     = 0;
+    uint32_t recordSize  = 0;
+    uint32_t isComplete  = 0;       // Close() wrote the frame index
+    uint64_t recordCount = 0;       // Records up to the last completed frame
+    uint64_t frameCount  = 0;
+    uint64_t indexOffset = 0;       // Byte offset of the frame index (valid when isComplete)
+    uint64_t createdTime = 0;       // UTC FILETIME ticks
+    uint64_t reserved[2] = {};
+};
+
+static_assert(sizeof(sStateRecordFileHeader) == 64, "drec header layout changed, bump StateRecordWriter::FORMAT_VERSION");
+
+//----------------------------------------------------------------------------------------------------
+class StateRecordWriter
+{
+public:
+    static uint32_t constexpr MAGIC          = 0x43455244u;      // "DREC", little-endian
+    static uint32_t constexpr FORMAT_VERSION = 1;
+    static uint64_t constexpr GROW_BYTES     = 64ull << 20;
+
+    StateRecordWriter() = default;
+    ~StateRecordWriter();
+
+    StateRecordWriter(StateRecordWriter const&)            = delete;
+    StateRecordWriter& operator=(StateRecordWriter const&) = delete;
+
+    bool Open(String const& path);     // Creates (or truncates) the file; false if it cannot be mapped
+    void Close();                      // Frame index, complete header, truncate to the used size
+
+    // Next record slot, zeroed; nullptr once the file cannot grow (IsFailed()). The pointer is valid
+    // until the next Append(): growing remaps the view.
+    sStateRecord* Append();
+
+    // Writes `first` with text starting at data[textOffset], continued in BLOB records. The text
+    // length is the caller's to store in `first`. Returns the number of records written (0 = failed).
+    uint32_t AppendWithText(sStateRecord const& first, size_t textOffset, String const& text);
+
+    sStateRecord* GetRecord(uint64_t index);     // Written records only; invalidated by Append()
+
+    // Frame bookkeeping: BeginFrame() appends the FRAME record and returns it; EndFrame() indexes it and
+    // publishes every record written since to the header
+    sStateRecord* BeginFrame();
+    void          EndFrame();
+
+    bool     IsOpen() const { return m_view != nullptr; }
+    bool     IsFailed() const { return m_isFailed; }
+    bool     IsFrameOpen() const { return m_frameRecord != INVALID_RECORD; }
+    uint32_t GetFrameNumber() const { return static_cast<uint32_t>(m_frameIndex.size()); }
+    uint64_t GetRecordCount() const { return m_recordCount; }
+    uint64_t GetFileBytes() const;                // Header + records (the index is added by Close())
+    uint64_t GetFrameRecordIndex() const { return m_frameRecord; }
+
+private:
+    static uint64_t constexpr INVALID_RECORD = ~0ull;
+
+    bool Grow(uint64_t minimumBytes);
+    void Unmap();
+
+    sStateRecordFileHeader* GetHeader() { return static_cast<sStateRecordFileHeader*>(m_view); }
+
+    void*    m_file     = nullptr;     // HANDLE (Windows.h stays out of this header)
+    void*    m_mapping  = nullptr;     // HANDLE
+    void*    m_view     = nullptr;
+    uint64_t m_capacity = 0;           // Mapped bytes
+    bool     m_isFailed = false;
+
+    uint64_t              m_recordCount = 0;
+    uint64_t              m_frameRecord = INVALID_RECORD;     // FRAME record of the open frame
+    std::vector<uint64_t> m_frameIndex;
+};
+
+//----------------------------------------------------------------------------------------------------
+class StateRecordReader
+{
+public:
+    StateRecordReader() = default;
+    ~StateRecordReader();
+
+    StateRecordReader(StateRecordReader const&)            = delete;
+    StateRecordReader& operator=(StateRecordReader const&) = delete;
+
+    bool Open(String const& path);     // False (with GetError()) if missing, foreign or an unknown version
+    void Close();
+
+    uint64_t            GetRecordCount() const { return m_recordCount; }
+    uint64_t            GetFrameCount() const { return m_frameIndex.size(); }
+    sStateRecord const* GetRecord(uint64_t index) const;       // nullptr past the last record
+    uint64_t            GetFrameRecordIndex(uint64_t frame) const { return m_frameIndex[frame]; }
+    uint64_t            GetFrameEnd(uint64_t frame) const;     // One past the frame's last record
+
+    // Text written by AppendWithText(); index is advanced past the BLOB records. False if truncated.
+    bool ReadText(uint64_t& index, size_t textOffset, uint32_t length, String& outText) const;
+
+    bool          IsOpen() const { return m_view != nullptr; }
+    bool          IsComplete() const { return m_isComplete; }     // False: written by a recorder that did not Close()
+    uint64_t      GetFileBytes() const { return m_fileBytes; }
+    String const& GetError() const { return m_error; }
+
+private:
+    void*    m_file      = nullptr;     // HANDLE
+    void*    m_mapping   = nullptr;     // HANDLE
+    void*    m_view      = nullptr;
+    uint64_t m_fileBytes = 0;
+
+    sStateRecord const*   m_records     = nullptr;
+    uint64_t              m_recordCount = 0;
+    bool                  m_isComplete  = false;
+    std::vector<uint64_t> m_frameIndex;
+    String                m_error;
+};
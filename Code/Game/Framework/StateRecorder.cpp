@@ -0,0 +1,841 @@
+//----------------------------------------------------------------------------------------------------
+// StateRecorder.cpp
+// Records every state-buffer swap to a .drec file and replays it without running JavaScript
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/StateRecorder.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/CameraStateBuffer.hpp"
+#include "Game/Framework/MeshHandleTable.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+// Record payloads (sStateRecord::data)
+//----------------------------------------------------------------------------------------------------
+static uint8_t constexpr FRAME_FLAG_FULL_SNAPSHOT = 0x01;
+static uint8_t constexpr ENTITY_FLAG_ACTIVE       = 0x01;     // extra = eEntityCameraType
+static uint8_t constexpr CAMERA_FLAG_ACTIVE       = 0x01;     // extra = CameraState::mode
+static uint8_t constexpr COMMAND_FLAG_NO_PAYLOAD  = 0x01;     // Payload was not a JSON string
+
+static uint32_t constexpr CHANGE_PAGE_SIZE = 4096;
+
+struct sFrameRecordData
+{
+    uint64_t timeUs         = 0;     // Since StateRecorder::Start()
+    EntityID activeCameraId = 0;
+    uint32_t recordCount    = 0;     // Records after the FRAME record
+    uint32_t entityCount    = 0;
+    uint32_t removedCount   = 0;
+    uint32_t cameraCount    = 0;
+    uint32_t meshCount      = 0;
+    uint32_t commandCount   = 0;
+};
+
+struct sEntityRecordData
+{
+    EntityID entityId       = 0;
+    float    position[3]    = {};
+    float    orientation[3] = {};     // Yaw, pitch, roll (degrees)
+    uint8_t  color[4]       = {};
+    float    radius         = 1.f;
+    float    boundRadius    = 1.f;
+    uint32_t meshHandle     = INVALID_MESH_HANDLE;     // Recording process's; see MESH
+    uint64_t textureId      = 0;                       // Recording process's Texture pointer (not replayed)
+};
+
+struct sEntityRemovedRecordData
+{
+    EntityID entityId = 0;
+};
+
+struct sMeshRecordData     // extra = meshType length, text at MESH_TEXT_OFFSET
+{
+    uint32_t meshHandle = INVALID_MESH_HANDLE;
+    float    radius     = 1.f;
+};
+
+struct sCameraRecordData
+{
+    EntityID cameraId       = 0;
+    float    position[3]    = {};
+    float    orientation[3] = {};
+    float    perspective[4] = {};     // FOV, aspect, near, far
+};
+
+struct sCameraViewRecordData     // extra = type length, text at CAMERA_VIEW_TEXT_OFFSET
+{
+    float ortho[6]    = {};     // Left, bottom, right, top, near, far
+    float viewport[4] = {};     // Mins x/y, maxs x/y
+};
+
+struct sCommandRecordData     // extra = type length, text (type then payload) at COMMAND_TEXT_OFFSET
+{
+    uint32_t payloadLength = 0;
+};
+
+static_assert(sizeof(sFrameRecordData) <= sStateRecord::DATA_SIZE);
+static_assert(sizeof(sEntityRecordData) == sStateRecord::DATA_SIZE);
+static_assert(sizeof(sCameraRecordData) <= sStateRecord::DATA_SIZE);
+
+static size_t constexpr MESH_TEXT_OFFSET        = sizeof(sMeshRecordData);
+static size_t constexpr CAMERA_VIEW_TEXT_OFFSET = sizeof(sCameraViewRecordData);
+static size_t constexpr COMMAND_TEXT_OFFSET     = sizeof(sCommandRecordData);
+static size_t constexpr MAX_SHORT_TEXT          = 0xFFFF;     // Lengths stored in sStateRecord::extra
+
+//----------------------------------------------------------------------------------------------------
+static double GetElapsedMs(std::chrono::steady_clock::time_point const start, std::chrono::steady_clock::time_point const end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+static char const* GetCameraTypeName(eEntityCameraType const cameraType)
+{
+    switch (cameraType)
+    {
+    case eEntityCameraType::WORLD:  return "world";
+    case eEntityCameraType::SCREEN: return "screen";
+    default:                        return "other";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+StateRecorder::StateRecorder(String const& path, bool const isRecordingCommands)
+    : m_path(path),
+      m_isRecordingCommands(isRecordingCommands)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+StateRecorder::~StateRecorder()
+{
+    Stop();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool StateRecorder::Start()
+{
+    if (!m_writer.Open(m_path))
+    {
+        DAEMON_LOG(LogApp, eLogVerbosity::Error, Stringf("StateRecorder: cannot create %s", m_path.c_str()));
+        return false;
+    }
+
+    m_startTime       = std::chrono::steady_clock::now();
+    m_recordedVersion = 0;
+    m_activeCameraId  = 0;
+    m_hasFrame        = false;
+    m_recordedMeshes.clear();
+    m_recordedCameras.clear();
+
+    m_stats             = sStateRecorderStats();
+    m_stats.isRecording = true;
+    m_stats.path        = m_path;
+
+    DAEMON_LOG(LogApp, eLogVerbosity::Display, Stringf("StateRecorder: recording to %s", m_path.c_str()));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Stop
+//
+// Commands dispatched after the last swap are kept as one more (delta-free) frame.
+//----------------------------------------------------------------------------------------------------
+void StateRecorder::Stop()
+{
+    if (!m_writer.IsOpen())
+    {
+        return;
+    }
+
+    if (m_writer.IsFrameOpen())
+    {
+        CloseFrame(m_activeCameraId, false);
+    }
+
+    m_stats.records = m_writer.GetRecordCount();
+    m_stats.bytes   = m_writer.GetFileBytes() + m_writer.GetFrameNumber() * sizeof(uint64_t);     // Plus the frame index
+    m_writer.Close();
+    m_stats.isRecording = false;
+
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("StateRecorder: %llu frames, %llu records (%.1f MB) written to %s", m_stats.frames, m_stats.records,
+                   static_cast<double>(m_stats.bytes) / (1024.0 * 1024.0), m_path.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Fail
+//
+// The file could not grow. Close() keeps every completed frame; the recording is simply shorter.
+//----------------------------------------------------------------------------------------------------
+void StateRecorder::Fail()
+{
+    DAEMON_LOG(LogApp, eLogVerbosity::Error,
+               Stringf("StateRecorder: cannot grow %s after %llu frames - recording stopped", m_path.c_str(), m_stats.frames));
+
+    m_writer.Close();
+    m_stats.isRecording = false;
+    m_stats.isFailed    = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool StateRecorder::OpenFrame()
+{
+    if (m_writer.IsFrameOpen())
+    {
+        return true;
+    }
+
+    if (!m_writer.BeginFrame())
+    {
+        Fail();
+        return false;
+    }
+
+    m_frameEntities = 0;
+    m_frameRemoved  = 0;
+    m_frameCameras  = 0;
+    m_frameMeshes   = 0;
+    m_frameCommands = 0;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StateRecorder::CloseFrame(EntityID const activeCameraId, bool const isFullSnapshot)
+{
+    uint64_t const      frameIndex = m_writer.GetFrameRecordIndex();
+    sStateRecord* const frame      = m_writer.GetRecord(frameIndex);
+
+    sFrameRecordData data;
+    data.timeUs         = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startTime).count());
+    data.activeCameraId = activeCameraId;
+    data.recordCount    = static_cast<uint32_t>(m_writer.GetRecordCount() - frameIndex - 1);
+    data.entityCount    = m_frameEntities;
+    data.removedCount   = m_frameRemoved;
+    data.cameraCount    = m_frameCameras;
+    data.meshCount      = m_frameMeshes;
+    data.commandCount   = m_frameCommands;
+
+    frame->flags = isFullSnapshot ? FRAME_FLAG_FULL_SNAPSHOT : 0;
+    StoreRecordData(*frame, data);
+    m_writer.EndFrame();
+
+    ++m_stats.frames;
+    m_stats.records = m_writer.GetRecordCount();
+    m_stats.bytes   = m_writer.GetFileBytes();
+    if (isFullSnapshot) ++m_stats.fullSnapshots;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StateRecorder::RecordCommand(GenericCommand const& command)
+{
+    if (!m_isRecordingCommands || !IsRecording() || !OpenFrame())
+    {
+        return;
+    }
+
+    String const* payload = std::any_cast<String>(&command.payload);
+
+    sStateRecord record;
+    record.type  = eStateRecordType::COMMAND;
+    record.frame = m_writer.GetFrameNumber();
+    record.flags = payload ? 0 : COMMAND_FLAG_NO_PAYLOAD;
+
+    m_text.assign(command.type, 0, MAX_SHORT_TEXT);
+    record.extra = static_cast<uint16_t>(m_text.size());
+
+    sCommandRecordData data;
+    if (payload)
+    {
+        data.payloadLength = static_cast<uint32_t>(payload->size());
+        m_text += *payload;
+    }
+    StoreRecordData(record, data);
+
+    if (m_writer.AppendWithText(record, COMMAND_TEXT_OFFSET, m_text) == 0)
+    {
+        Fail();
+        return;
+    }
+
+    ++m_frameCommands;
+    ++m_stats.commandRecords;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StateRecorder::RecordSwap(EntityStore const& entities, CameraStateBuffer& cameras, MeshHandleTable const& meshes, bool const isCameraSwapped)
+{
+    if (!IsRecording())
+    {
+        return;
+    }
+
+    auto const recordStart = std::chrono::steady_clock::now();
+    if (!OpenFrame())
+    {
+        return;
+    }
+
+    bool const isFullSnapshot = RecordEntities(entities, meshes, !m_hasFrame);
+    if (!IsRecording())
+    {
+        return;
+    }
+
+    if (isFullSnapshot || isCameraSwapped)
+    {
+        RecordCameras(cameras, isFullSnapshot);
+        if (!IsRecording())
+        {
+            return;
+        }
+    }
+
+    m_activeCameraId = cameras.GetActiveCameraID();
+    CloseFrame(m_activeCameraId, isFullSnapshot);
+    m_hasFrame = true;
+
+    m_stats.lastRecordMs = GetElapsedMs(recordStart, std::chrono::steady_clock::now());
+    m_stats.maxRecordMs  = std::max(m_stats.maxRecordMs, m_stats.lastRecordMs);
+}
+
+//----------------------------------------------------------------------------------------------------
+// RecordEntities
+//
+// Reads the front buffer, which the swap just made current. A MESH record precedes the first ENTITY
+// that uses each handle.
+//----------------------------------------------------------------------------------------------------
+bool StateRecorder::RecordEntities(EntityStore const& entities, MeshHandleTable const& meshes, bool isFullSnapshot)
+{
+    uint64_t const version = entities.GetVersion();
+    if (!isFullSnapshot && version == m_recordedVersion)
+    {
+        return false;
+    }
+
+    sEntityArrays const& front       = entities.GetFront();
+    uint64_t             since       = isFullSnapshot ? 0 : m_recordedVersion;
+    uint32_t const       frameNumber = m_writer.GetFrameNumber();
+    sEntityChangeCursor  cursor;
+    bool                 hasMore = true;
+
+    while (hasMore)
+    {
+        m_changes.clear();
+        if (!entities.CollectChanges(since, cursor, CHANGE_PAGE_SIZE, m_changes, hasMore))
+        {
+            // More entities were destroyed since the last swap than the store keeps tombstones for
+            if (since == 0) break;
+            since          = 0;
+            cursor         = sEntityChangeCursor();
+            isFullSnapshot = true;
+            hasMore        = true;
+            continue;
+        }
+
+        for (sEntityChange const& change : m_changes)
+        {
+            if (change.isRemoved)
+            {
+                sStateRecord* const record = m_writer.Append();
+                if (!record)
+                {
+                    Fail();
+                    return isFullSnapshot;
+                }
+
+                record->type  = eStateRecordType::ENTITY_REMOVED;
+                record->frame = frameNumber;
+                StoreRecordData(*record, sEntityRemovedRecordData{change.entityId});
+                ++m_frameRemoved;
+                ++m_stats.removedRecords;
+                continue;
+            }
+
+            uint32_t const slot       = change.slot;
+            uint32_t const meshHandle = front.meshHandles[slot];
+            if (meshHandle != INVALID_MESH_HANDLE && m_recordedMeshes.insert(meshHandle).second)
+            {
+                sMeshHandleEntry const* entry    = meshes.Find(meshHandle);
+                String const&           meshType = entry ? entry->meshType : front.meshTypes[slot];
+
+                sStateRecord mesh;
+                mesh.type  = eStateRecordType::MESH;
+                mesh.frame = frameNumber;
+                mesh.extra = static_cast<uint16_t>(std::min(meshType.size(), MAX_SHORT_TEXT));
+                StoreRecordData(mesh, sMeshRecordData{meshHandle, entry ? entry->radius : front.radii[slot]});
+
+                if (m_writer.AppendWithText(mesh, MESH_TEXT_OFFSET, meshType.substr(0, mesh.extra)) == 0)
+                {
+                    Fail();
+                    return isFullSnapshot;
+                }
+                ++m_frameMeshes;
+                ++m_stats.meshRecords;
+            }
+
+            sStateRecord* const record = m_writer.Append();
+            if (!record)
+            {
+                Fail();
+                return isFullSnapshot;
+            }
+
+            Vec3 const&        position    = front.positions[slot];
+            EulerAngles const& orientation = front.orientations[slot];
+            Rgba8 const&       color       = front.colors[slot];
+
+            sEntityRecordData data;
+            data.entityId       = change.entityId;
+            data.position[0]    = position.x;
+            data.position[1]    = position.y;
+            data.position[2]    = position.z;
+            data.orientation[0] = orientation.m_yawDegrees;
+            data.orientation[1] = orientation.m_pitchDegrees;
+            data.orientation[2] = orientation.m_rollDegrees;
+            data.color[0]       = color.r;
+            data.color[1]       = color.g;
+            data.color[2]       = color.b;
+            data.color[3]       = color.a;
+            data.radius         = front.radii[slot];
+            data.boundRadius    = front.boundRadii[slot];
+            data.meshHandle     = meshHandle;
+            data.textureId      = front.textureIds[slot];
+
+            record->type  = eStateRecordType::ENTITY;
+            record->frame = frameNumber;
+            record->flags = front.activeFlags[slot] ? ENTITY_FLAG_ACTIVE : 0;
+            record->extra = static_cast<uint16_t>(front.cameraTypeIds[slot]);
+            StoreRecordData(*record, data);
+            ++m_frameEntities;
+            ++m_stats.entityRecords;
+        }
+
+        if (hasMore)
+        {
+            cursor.version = m_changes.back().version;
+            cursor.slot    = m_changes.back().slot;
+        }
+    }
+
+    m_recordedVersion = version;
+    return isFullSnapshot;
+}
+
+//----------------------------------------------------------------------------------------------------
+// RecordCameras
+//
+// Cameras are only ever deactivated (camera.destroy), so a camera missing from the front buffer
+// never needs a removal record.
+//----------------------------------------------------------------------------------------------------
+void StateRecorder::RecordCameras(CameraStateBuffer& cameras, bool const isFullSnapshot)
+{
+    CameraStateMap const* front = cameras.GetFrontBuffer();
+    if (!front)
+    {
+        return;
+    }
+
+    uint32_t const frameNumber = m_writer.GetFrameNumber();
+    for (auto const& [cameraId, state] : *front)
+    {
+        sRecordedCamera packed;
+        packed.camera.type  = eStateRecordType::CAMERA;
+        packed.camera.flags = state.isActive ? CAMERA_FLAG_ACTIVE : 0;
+        packed.camera.extra = static_cast<uint16_t>(state.mode);
+
+        sCameraRecordData cameraData;
+        cameraData.cameraId       = cameraId;
+        cameraData.position[0]    = state.position.x;
+        cameraData.position[1]    = state.position.y;
+        cameraData.position[2]    = state.position.z;
+        cameraData.orientation[0] = state.orientation.m_yawDegrees;
+        cameraData.orientation[1] = state.orientation.m_pitchDegrees;
+        cameraData.orientation[2] = state.orientation.m_rollDegrees;
+        cameraData.perspective[0] = state.perspectiveFOV;
+        cameraData.perspective[1] = state.perspectiveAspect;
+        cameraData.perspective[2] = state.perspectiveNear;
+        cameraData.perspective[3] = state.perspectiveFar;
+        StoreRecordData(packed.camera, cameraData);
+
+        packed.type.assign(state.type, 0, MAX_SHORT_TEXT);
+        packed.view.type  = eStateRecordType::CAMERA_VIEW;
+        packed.view.extra = static_cast<uint16_t>(packed.type.size());
+
+        sCameraViewRecordData viewData;
+        viewData.ortho[0]    = state.orthoLeft;
+        viewData.ortho[1]    = state.orthoBottom;
+        viewData.ortho[2]    = state.orthoRight;
+        viewData.ortho[3]    = state.orthoTop;
+        viewData.ortho[4]    = state.orthoNear;
+        viewData.ortho[5]    = state.orthoFar;
+        viewData.viewport[0] = state.viewport.m_mins.x;
+        viewData.viewport[1] = state.viewport.m_mins.y;
+        viewData.viewport[2] = state.viewport.m_maxs.x;
+        viewData.viewport[3] = state.viewport.m_maxs.y;
+        StoreRecordData(packed.view, viewData);
+
+        auto const recorded = m_recordedCameras.find(cameraId);
+        if (!isFullSnapshot && recorded != m_recordedCameras.end() && recorded->second.type == packed.type &&
+            std::memcmp(&recorded->second.camera, &packed.camera, sizeof(sStateRecord)) == 0 &&
+            std::memcmp(&recorded->second.view, &packed.view, sizeof(sStateRecord)) == 0)
+        {
+            continue;
+        }
+
+        sStateRecord* const record = m_writer.Append();
+        if (!record)
+        {
+            Fail();
+            return;
+        }
+        *record       = packed.camera;
+        record->frame = frameNumber;
+
+        sStateRecord view = packed.view;
+        view.frame        = frameNumber;
+        if (m_writer.AppendWithText(view, CAMERA_VIEW_TEXT_OFFSET, packed.type) == 0)
+        {
+            Fail();
+            return;
+        }
+
+        m_recordedCameras[cameraId] = std::move(packed);
+        ++m_frameCameras;
+        ++m_stats.cameraRecords;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sStateRecorderStats StateRecorder::GetStats() const
+{
+    sStateRecorderStats stats = m_stats;
+    if (IsRecording())
+    {
+        stats.records = m_writer.GetRecordCount();
+        stats.bytes   = m_writer.GetFileBytes();
+    }
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+StateReplayer::StateReplayer(sStateRecordingConfig const& config)
+    : m_config(config)
+{
+    m_stats.path       = config.path;
+    m_stats.isRealTime = config.isRealTime;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool StateReplayer::Start()
+{
+    if (!m_reader.Open(m_config.path))
+    {
+        m_error = m_reader.GetError();
+        DAEMON_LOG(LogApp, eLogVerbosity::Error, Stringf("StateReplayer: %s", m_error.c_str()));
+        return false;
+    }
+
+    uint64_t const frameCount = m_reader.GetFrameCount();
+    if (frameCount == 0)
+    {
+        m_reader.Close();
+        m_error = Stringf("%s holds no frames", m_config.path.c_str());
+        DAEMON_LOG(LogApp, eLogVerbosity::Error, Stringf("StateReplayer: %s", m_error.c_str()));
+        return false;
+    }
+
+    m_stats.isActive       = true;
+    m_stats.isFileComplete = m_reader.IsComplete();
+    m_stats.frameCount     = frameCount;
+
+    double const recordedSeconds = static_cast<double>(GetFrameTimeUs(frameCount - 1) - GetFrameTimeUs(0)) / 1000000.0;
+    DAEMON_LOG(LogApp, eLogVerbosity::Display,
+               Stringf("StateReplayer: %s - %llu frames, %.1f s recorded, %s%s", m_config.path.c_str(), frameCount, recordedSeconds,
+                   m_config.isRealTime ? "real time" : "unthrottled",
+                   m_reader.IsComplete() ? "" : " (no frame index: recorder did not stop cleanly)"));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t StateReplayer::GetFrameTimeUs(uint64_t const frame) const
+{
+    return LoadRecordData<sFrameRecordData>(*m_reader.GetRecord(m_reader.GetFrameRecordIndex(frame))).timeUs;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Update
+//
+// Real time: frame N is due once (recorded time of N - recorded time of frame 0) of wall time has
+// passed since frame 0 was applied; a slow App frame applies every frame it missed. Unthrottled: one
+// recorded frame per call.
+//----------------------------------------------------------------------------------------------------
+void StateReplayer::Update(EntityStore& entities, CameraStateBuffer& cameras, MeshHandleTable& meshes, sStateReplayTick& outTick)
+{
+    outTick = sStateReplayTick();
+    if (m_isFinished || !m_reader.IsOpen())
+    {
+        return;
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+    if (!m_isStarted)
+    {
+        m_isStarted       = true;
+        m_startTime       = now;
+        m_firstUpdateTime = now;
+    }
+    else
+    {
+        m_stats.maxAppFrameMs = std::max(m_stats.maxAppFrameMs, GetElapsedMs(m_lastUpdateTime, now));
+    }
+    m_lastUpdateTime = now;
+    ++m_stats.appFrames;
+
+    uint64_t const frameCount = m_reader.GetFrameCount();
+    if (m_config.isRealTime)
+    {
+        uint64_t const baseUs    = GetFrameTimeUs(0);
+        uint64_t const elapsedUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - m_startTime).count());
+        while (m_nextFrame < frameCount && GetFrameTimeUs(m_nextFrame) - baseUs <= elapsedUs)
+        {
+            ApplyFrame(m_nextFrame++, entities, cameras, meshes, outTick);
+        }
+    }
+    else if (m_nextFrame < frameCount)
+    {
+        ApplyFrame(m_nextFrame++, entities, cameras, meshes, outTick);
+    }
+
+    if (outTick.frames > 0)
+    {
+        m_stats.lastApplyMs = GetElapsedMs(now, std::chrono::steady_clock::now());
+        m_stats.maxApplyMs  = std::max(m_stats.maxApplyMs, m_stats.lastApplyMs);
+    }
+
+    if (m_nextFrame >= frameCount)
+    {
+        if (m_config.isLooping)
+        {
+            // Frame 0 is a full snapshot: it drops whatever the end of the recording left behind
+            m_nextFrame = 0;
+            m_startTime = std::chrono::steady_clock::now();
+            ++m_stats.loops;
+        }
+        else
+        {
+            m_isFinished = true;
+            DAEMON_LOG(LogApp, eLogVerbosity::Display,
+                       Stringf("StateReplayer: finished - %llu frames in %.1f ms over %llu App frames (max apply %.3f ms)",
+                           m_stats.framesApplied, GetElapsedMs(m_firstUpdateTime, now), m_stats.appFrames, m_stats.maxApplyMs));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// ApplyFrame
+//
+// Writes the frame's records into the back buffers the way the GenericCommand handlers do: existing
+// entities are updated in place, new ones (or ones whose mesh changed) go through Create().
+//----------------------------------------------------------------------------------------------------
+void StateReplayer::ApplyFrame(uint64_t const frame, EntityStore& entities, CameraStateBuffer& cameras, MeshHandleTable& meshes,
+                               sStateReplayTick& tick)
+{
+    uint64_t const         first       = m_reader.GetFrameRecordIndex(frame);
+    uint64_t const         end         = m_reader.GetFrameEnd(frame);
+    sStateRecord const&    frameRecord = *m_reader.GetRecord(first);
+    sFrameRecordData const frameData   = LoadRecordData<sFrameRecordData>(frameRecord);
+    bool const             isFull      = (frameRecord.flags & FRAME_FLAG_FULL_SNAPSHOT) != 0;
+
+    if (isFull)
+    {
+        m_snapshotEntities.clear();
+        m_snapshotCameras.clear();
+    }
+
+    CameraStateMap* backCameras = cameras.GetBackBuffer();
+    CameraState     camera;
+    EntityID        cameraId = 0;
+    String          text;
+
+    for (uint64_t index = first + 1; index < end;)
+    {
+        sStateRecord const& record = *m_reader.GetRecord(index);
+        switch (record.type)
+        {
+        case eStateRecordType::ENTITY:
+        {
+            sEntityRecordData const data       = LoadRecordData<sEntityRecordData>(record);
+            auto const              mesh       = m_meshHandles.find(data.meshHandle);
+            MeshHandle const        meshHandle = (mesh != m_meshHandles.end()) ? mesh->second : INVALID_MESH_HANDLE;
+
+            Vec3 const        position(data.position[0], data.position[1], data.position[2]);
+            EulerAngles const orientation(data.orientation[0], data.orientation[1], data.orientation[2]);
+            Rgba8 const       color(data.color[0], data.color[1], data.color[2], data.color[3]);
+            auto const        cameraType = static_cast<eEntityCameraType>(record.extra);
+
+            sEntityArrays& back = entities.GetBack();
+            uint32_t       slot = entities.FindSlot(data.entityId);
+            if (slot == EntityStore::INVALID_SLOT || back.meshHandles[slot] != meshHandle)
+            {
+                sMeshHandleEntry const* entry = meshes.Find(meshHandle);
+
+                EntityState state;
+                state.position    = position;
+                state.orientation = orientation;
+                state.color       = color;
+                state.radius      = data.radius;
+                state.meshType    = entry ? entry->meshType : String();
+                state.isActive    = (record.flags & ENTITY_FLAG_ACTIVE) != 0;
+                state.cameraType  = GetCameraTypeName(cameraType);
+                state.textureId   = 0;
+                slot              = entities.Create(data.entityId, state, meshHandle);
+            }
+            else
+            {
+                back.positions[slot]     = position;
+                back.orientations[slot]  = orientation;
+                back.colors[slot]        = color;
+                back.radii[slot]         = data.radius;
+                back.activeFlags[slot]   = (record.flags & ENTITY_FLAG_ACTIVE) ? 1 : 0;
+                back.cameraTypeIds[slot] = cameraType;
+                entities.MarkDirty(slot);
+            }
+            back.boundRadii[slot] = data.boundRadius;
+
+            if (isFull) m_snapshotEntities.insert(data.entityId);
+            ++index;
+            break;
+        }
+
+        case eStateRecordType::ENTITY_REMOVED:
+            entities.Destroy(LoadRecordData<sEntityRemovedRecordData>(record).entityId);
+            ++index;
+            break;
+
+        case eStateRecordType::MESH:
+        {
+            sMeshRecordData const data = LoadRecordData<sMeshRecordData>(record);
+            uint64_t              next = index;
+            if (m_reader.ReadText(next, MESH_TEXT_OFFSET, record.extra, text))
+            {
+                m_meshHandles[data.meshHandle] = meshes.Intern(text, data.radius);
+            }
+            index = std::max(next, index + 1);
+            break;
+        }
+
+        case eStateRecordType::CAMERA:
+        {
+            sCameraRecordData const data = LoadRecordData<sCameraRecordData>(record);
+            cameraId                     = data.cameraId;
+            camera                       = CameraState();
+            camera.position              = Vec3(data.position[0], data.position[1], data.position[2]);
+            camera.orientation           = EulerAngles(data.orientation[0], data.orientation[1], data.orientation[2]);
+            camera.isActive              = (record.flags & CAMERA_FLAG_ACTIVE) != 0;
+            camera.mode                  = static_cast<decltype(camera.mode)>(record.extra);
+            camera.perspectiveFOV        = data.perspective[0];
+            camera.perspectiveAspect     = data.perspective[1];
+            camera.perspectiveNear       = data.perspective[2];
+            camera.perspectiveFar        = data.perspective[3];
+            ++index;
+            break;
+        }
+
+        case eStateRecordType::CAMERA_VIEW:
+        {
+            sCameraViewRecordData const data = LoadRecordData<sCameraViewRecordData>(record);
+            uint64_t                    next = index;
+            if (cameraId != 0 && backCameras && m_reader.ReadText(next, CAMERA_VIEW_TEXT_OFFSET, record.extra, text))
+            {
+                camera.orthoLeft   = data.ortho[0];
+                camera.orthoBottom = data.ortho[1];
+                camera.orthoRight  = data.ortho[2];
+                camera.orthoTop    = data.ortho[3];
+                camera.orthoNear   = data.ortho[4];
+                camera.orthoFar    = data.ortho[5];
+                camera.viewport    = AABB2(Vec2(data.viewport[0], data.viewport[1]), Vec2(data.viewport[2], data.viewport[3]));
+                camera.type        = text;
+
+                (*backCameras)[cameraId] = camera;
+                cameras.MarkDirty(cameraId);
+                ++tick.cameraMarks;
+
+                if (isFull) m_snapshotCameras.insert(cameraId);
+            }
+            cameraId = 0;
+            index    = std::max(next, index + 1);
+            break;
+        }
+
+        case eStateRecordType::COMMAND:
+            ++m_stats.commandsSkipped;
+            ++index;
+            break;
+
+        default:     // BLOB continuations of skipped records
+            ++index;
+            break;
+        }
+    }
+
+    // A full snapshot lists everything visible: drop what an earlier frame (or the JS startup) left behind
+    if (isFull)
+    {
+        sEntityArrays const& back = entities.GetBack();
+        m_staleEntities.clear();
+        for (uint32_t slot = 0; slot < back.GetSlotCount(); ++slot)
+        {
+            EntityID const entityId = back.ids[slot];
+            if (entities.FindSlot(entityId) == slot && m_snapshotEntities.count(entityId) == 0)
+            {
+                m_staleEntities.push_back(entityId);
+            }
+        }
+        for (EntityID const entityId : m_staleEntities)
+        {
+            entities.Destroy(entityId);
+        }
+
+        if (backCameras)
+        {
+            for (auto& [staleId, state] : *backCameras)
+            {
+                if (state.isActive && m_snapshotCameras.count(staleId) == 0)
+                {
+                    state.isActive = false;
+                    cameras.MarkDirty(staleId);
+                    ++tick.cameraMarks;
+                }
+            }
+        }
+    }
+
+    if (frameData.activeCameraId != 0 && frameData.activeCameraId != cameras.GetActiveCameraID())
+    {
+        cameras.SetActiveCameraID(frameData.activeCameraId);
+        cameras.MarkDirty(frameData.activeCameraId);
+        ++tick.cameraMarks;
+    }
+
+    ++tick.frames;
+    ++m_stats.framesApplied;
+    m_stats.recordsApplied += end - first;
+    m_stats.recordedMs = static_cast<double>(frameData.timeUs) / 1000.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sStateReplayStats StateReplayer::GetStats() const
+{
+    sStateReplayStats stats = m_stats;
+    stats.isFinished        = m_isFinished;
+    stats.nextFrame         = m_nextFrame;
+    stats.elapsedMs         = m_isStarted ? GetElapsedMs(m_firstUpdateTime, m_isFinished ? m_lastUpdateTime : std::chrono::steady_clock::now()) : 0.0;
+    return stats;
+}
@@ -0,0 +1,214 @@
+//----------------------------------------------------------------------------------------------------
+// StateRecorder.hpp
+// Records every state-buffer swap to a .drec file and replays it without running JavaScript
+//
+// Purpose:
+//   Render cost could only be measured with the JS worker producing the frames, so a slower frame
+//   might be script, command or render time. StateRecorder captures what each swap made visible
+//   (EntityStore front-buffer deltas, changed cameras) plus the GenericCommand stream, and
+//   StateReplayer later feeds those frames straight into the back buffers: the JS worker is never
+//   triggered, so a replayed session costs apply + swap + render only (-record / -replay,
+//   Data/Config/Recording.json, game.start_recording / game.stop_recording)
+//
+// Design:
+//   - One frame per App::SwapStateBuffers(): the FRAME record (time since recording start, active
+//     camera, counts), the GenericCommands dispatched since the previous swap, then the deltas
+//   - Entity deltas come from EntityStore::CollectChanges() since the last recorded version; the
+//     first frame (and any frame whose version the change log no longer covers) is a full snapshot
+//     flagged FULL_SNAPSHOT, which the replayer uses to drop entities and cameras it does not list
+//   - Cameras have no change log: after a camera swap each front camera is packed and compared with
+//     the records last written for it; only cameras whose records differ are written
+//   - MeshHandles are process-local, so the first ENTITY using a handle is preceded by a MESH record
+//     (meshType, radius) and the replayer interns its own. textureIds are Texture pointers of the
+//     recording process and replay as 0 (default texture)
+//   - Commands are recorded for analysis (type + JSON payload) but not re-dispatched by the replayer:
+//     their effects are already in the deltas that follow them
+//   - Replay pacing: real time (every frame whose timestamp has passed is applied, then one swap) or
+//     unthrottled (one recorded frame per App frame, as fast as the main loop runs)
+//
+// Thread Safety Model:
+//   - Main thread only (GenericCommand handlers, SwapStateBuffers() and Update() all run there)
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/GenericCommand.hpp"
+#include "Engine/Entity/EntityStateBuffer.hpp"
+#include "Game/Framework/EntityStore.hpp"
+#include "Game/Framework/StateRecordFile.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class CameraStateBuffer;
+class MeshHandleTable;
+
+//----------------------------------------------------------------------------------------------------
+struct sStateRecordingConfig
+{
+    String path                = "Recordings/session.drec";
+    bool   isRecording         = false;     // Record from startup (-record)
+    bool   isRecordingCommands = true;
+    bool   isReplaying         = false;     // Replay instead of running the JS worker (-replay); disables isRecording
+    bool   isRealTime          = true;      // false = one recorded frame per App frame, unthrottled
+    bool   isLooping           = false;
+    bool   isQuitWhenDone      = false;     // Quit after the last frame (ignored while looping)
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sStateRecorderStats
+{
+    bool     isRecording    = false;
+    bool     isFailed       = false;       // The file could not grow; recording stopped
+    String   path;
+    uint64_t frames         = 0;
+    uint64_t records        = 0;
+    uint64_t bytes          = 0;
+    uint64_t entityRecords  = 0;
+    uint64_t removedRecords = 0;
+    uint64_t cameraRecords  = 0;
+    uint64_t meshRecords    = 0;
+    uint64_t commandRecords = 0;
+    uint64_t fullSnapshots  = 0;
+    double   lastRecordMs   = 0.0;         // RecordSwap() cost
+    double   maxRecordMs    = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class StateRecorder
+{
+public:
+    explicit StateRecorder(String const& path, bool isRecordingCommands = true);
+    ~StateRecorder();
+
+    StateRecorder(StateRecorder const&)            = delete;
+    StateRecorder& operator=(StateRecorder const&) = delete;
+
+    bool Start();     // False if the file cannot be created
+    void Stop();      // Frame index + truncate; the file is complete
+
+    void RecordCommand(GenericCommand const& command);     // DispatchGenericCommand()
+
+    // After the swaps in App::SwapStateBuffers(); isCameraSwapped = the camera buffer copied anything
+    void RecordSwap(EntityStore const& entities, CameraStateBuffer& cameras, MeshHandleTable const& meshes, bool isCameraSwapped);
+
+    bool                IsRecording() const { return m_writer.IsOpen() && !m_writer.IsFailed(); }
+    String const&       GetPath() const { return m_path; }
+    sStateRecorderStats GetStats() const;
+
+private:
+    // A camera as last written: both records (frame 0, no inline text) and its type string
+    struct sRecordedCamera
+    {
+        sStateRecord camera;
+        sStateRecord view;
+        String       type;
+    };
+
+    bool OpenFrame();
+    void CloseFrame(EntityID activeCameraId, bool isFullSnapshot);
+    // True if it wrote a full snapshot (requested, or the change log no longer covers m_recordedVersion)
+    bool RecordEntities(EntityStore const& entities, MeshHandleTable const& meshes, bool isFullSnapshot);
+    void RecordCameras(CameraStateBuffer& cameras, bool isFullSnapshot);
+    void Fail();
+
+    String m_path;
+    bool   m_isRecordingCommands = true;
+
+    StateRecordWriter                     m_writer;
+    std::chrono::steady_clock::time_point m_startTime;
+    uint64_t                              m_recordedVersion = 0;         // EntityStore version covered so far
+    EntityID                              m_activeCameraId  = 0;         // As of the last swap (Stop() closes with it)
+    bool                                  m_hasFrame        = false;     // A swap was recorded (else full snapshot)
+
+    std::unordered_set<uint32_t>                  m_recordedMeshes;     // MeshHandles with a MESH record
+    std::unordered_map<EntityID, sRecordedCamera> m_recordedCameras;
+    std::vector<sEntityChange>                    m_changes;            // CollectChanges() scratch
+    String                                        m_text;               // Command text scratch
+
+    uint32_t            m_frameEntities = 0;     // Counts of the open frame
+    uint32_t            m_frameRemoved  = 0;
+    uint32_t            m_frameCameras  = 0;
+    uint32_t            m_frameMeshes   = 0;
+    uint32_t            m_frameCommands = 0;
+    sStateRecorderStats m_stats;
+};
+
+//----------------------------------------------------------------------------------------------------
+// What one StateReplayer::Update() applied. Camera marks go into App's swap counter; EntityStore
+// tracks its own dirty slots
+//----------------------------------------------------------------------------------------------------
+struct sStateReplayTick
+{
+    uint32_t frames      = 0;     // Recorded frames applied (0 = nothing due, no swap needed)
+    uint32_t cameraMarks = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sStateReplayStats
+{
+    bool     isActive        = false;
+    bool     isFinished      = false;
+    bool     isRealTime      = true;
+    bool     isFileComplete  = false;     // Frame index present (the recorder was stopped cleanly)
+    String   path;
+    uint64_t frameCount      = 0;
+    uint64_t nextFrame       = 0;
+    uint64_t framesApplied   = 0;
+    uint64_t recordsApplied  = 0;
+    uint64_t commandsSkipped = 0;         // Recorded commands (not re-dispatched)
+    uint64_t loops           = 0;
+    uint64_t appFrames       = 0;         // Update() calls while replaying
+    double   elapsedMs       = 0.0;       // Wall time since the first Update()
+    double   recordedMs      = 0.0;       // Recorded time of the last applied frame
+    double   lastApplyMs     = 0.0;
+    double   maxApplyMs      = 0.0;
+    double   maxAppFrameMs   = 0.0;       // Longest interval between Update() calls
+};
+
+//----------------------------------------------------------------------------------------------------
+class StateReplayer
+{
+public:
+    explicit StateReplayer(sStateRecordingConfig const& config);
+
+    StateReplayer(StateReplayer const&)            = delete;
+    StateReplayer& operator=(StateReplayer const&) = delete;
+
+    bool          Start();     // False (GetError()) if the file cannot be opened or holds no frames
+    String const& GetError() const { return m_error; }
+
+    // Once per App frame, instead of triggering the JS worker: applies the frames that are due to the
+    // back buffers. The caller swaps when outTick.frames > 0
+    void Update(EntityStore& entities, CameraStateBuffer& cameras, MeshHandleTable& meshes, sStateReplayTick& outTick);
+
+    bool              IsFinished() const { return m_isFinished; }
+    bool              IsQuitWhenDone() const { return m_config.isQuitWhenDone && !m_config.isLooping; }
+    sStateReplayStats GetStats() const;
+
+private:
+    void     ApplyFrame(uint64_t frame, EntityStore& entities, CameraStateBuffer& cameras, MeshHandleTable& meshes, sStateReplayTick& tick);
+    uint64_t GetFrameTimeUs(uint64_t frame) const;
+
+    sStateRecordingConfig m_config;
+    StateRecordReader     m_reader;
+    String                m_error;
+
+    std::unordered_map<uint32_t, uint32_t> m_meshHandles;           // Recorded MeshHandle -> this process's
+    std::unordered_set<EntityID>           m_snapshotEntities;      // Full-snapshot scratch
+    std::unordered_set<EntityID>           m_snapshotCameras;
+    std::vector<EntityID>                  m_staleEntities;
+
+    bool                                  m_isStarted  = false;     // First Update() seen
+    bool                                  m_isFinished = false;
+    uint64_t                              m_nextFrame  = 0;
+    std::chrono::steady_clock::time_point m_startTime;               // Wall time of the current loop's frame 0
+    std::chrono::steady_clock::time_point m_firstUpdateTime;
+    std::chrono::steady_clock::time_point m_lastUpdateTime;
+    sStateReplayStats                     m_stats;
+};
@@ -0,0 +1,259 @@
+//----------------------------------------------------------------------------------------------------
+// TypedCommandBuffer.cpp
+// Fixed-layout binary fast path for high-frequency GenericCommands
+//----------------------------------------------------------------------------------------------------
+
+#include "Game/Framework/TypedCommandBuffer.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/LogSubsystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+// Suppress V8 header warnings (unreferenced formal parameters, etc.)
+#pragma warning(push)
+#pragma warning(disable: 4100)  // 'identifier': unreferenced formal parameter
+#pragma warning(disable: 4127)  // conditional expression is constant
+#pragma warning(disable: 4324)  // 'structname': structure was padded due to alignment specifier
+#include <v8.h>
+#pragma warning(pop)
+
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------
+TypedCommandBuffer::TypedCommandBuffer(uint32_t const recordCapacity)
+    : m_capacity(recordCapacity)
+{
+    if (m_capacity == 0)
+    {
+        ERROR_AND_DIE("TypedCommandBuffer: recordCapacity must be greater than zero");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TypedCommandBuffer::~TypedCommandBuffer()
+{
+    // BackingStore releases the memory once the JS ArrayBuffer is also collected
+    m_data = nullptr;
+    m_backingStore.reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+// InstallScriptBuffer
+//
+// The ArrayBuffer is allocated by V8 so it lives inside the sandbox; C++ keeps the BackingStore
+// shared_ptr and reads/writes the same bytes through m_data.
+//----------------------------------------------------------------------------------------------------
+bool TypedCommandBuffer::InstallScriptBuffer(v8::Isolate* isolate, char const* globalName)
+{
+    if (isolate == nullptr || globalName == nullptr)
+    {
+        return false;
+    }
+
+    v8::Locker                locker(isolate);
+    v8::Isolate::Scope        isolateScope(isolate);
+    v8::HandleScope           handleScope(isolate);
+    v8::Local<v8::Context> const context = isolate->GetCurrentContext();
+
+    if (context.IsEmpty())
+    {
+        DAEMON_LOG(LogScript, eLogVerbosity::Warning, "TypedCommandBuffer::InstallScriptBuffer - No V8 context, typed fast path disabled");
+        return false;
+    }
+
+    v8::Context::Scope contextScope(context);
+
+    size_t const                     byteLength  = HEADER_SIZE_BYTES + static_cast<size_t>(m_capacity) * sizeof(sTypedCommandRecord);
+    v8::Local<v8::ArrayBuffer> const arrayBuffer = v8::ArrayBuffer::New(isolate, byteLength);
+
+    m_backingStore = arrayBuffer->GetBackingStore();
+    m_data         = static_cast<uint8_t*>(m_backingStore->Data());
+
+    std::memset(m_data, 0, byteLength);
+    uint32_t* header = GetHeader();
+    header[0]        = TYPED_COMMAND_BUFFER_VERSION;
+    header[2]        = m_capacity;
+
+    v8::Local<v8::String> const name = v8::String::NewFromUtf8(isolate, globalName).ToLocalChecked();
+    if (context->Global()->Set(context, name, arrayBuffer).IsNothing())
+    {
+        m_data = nullptr;
+        m_backingStore.reset();
+        return false;
+    }
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log, Stringf("TypedCommandBuffer: globalThis.%s installed (%u records, %zu bytes)", globalName, m_capacity, byteLength));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TypedCommandBuffer::RegisterHandler(eTypedCommand const opcode, TypedHandler handler)
+{
+    uint32_t const index = static_cast<uint32_t>(opcode);
+
+    if (index == 0 || index >= static_cast<uint32_t>(eTypedCommand::COUNT))
+    {
+        ERROR_AND_DIE(Stringf("TypedCommandBuffer::RegisterHandler - invalid opcode %u", index));
+    }
+
+    m_handlers[index] = std::move(handler);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TypedCommandBuffer::Execute(sTypedCommandRecord const& record) const
+{
+    if (record.opcode == 0 || record.opcode >= static_cast<uint32_t>(eTypedCommand::COUNT))
+    {
+        return false;
+    }
+
+    TypedHandler const& handler = m_handlers[record.opcode];
+    if (!handler)
+    {
+        return false;
+    }
+
+    handler(record);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Drain
+//
+// recordCount is clamped to capacity: JavaScript is trusted to stay in bounds, but a stale or
+// corrupted header must never let the main thread read past the BackingStore.
+//----------------------------------------------------------------------------------------------------
+uint32_t TypedCommandBuffer::Drain()
+{
+    m_lastDrainCount = 0;
+
+    if (m_data == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t* header      = GetHeader();
+    uint32_t  recordCount = header[1];
+    if (recordCount > m_capacity)
+    {
+        recordCount = m_capacity;
+    }
+
+    auto const*    records       = reinterpret_cast<sTypedCommandRecord const*>(m_data + HEADER_SIZE_BYTES);
+    uint32_t const overflowCount = header[3];
+
+    header[1] = 0;
+    header[3] = 0;
+
+    return ExecuteRecords(records, recordCount, overflowCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t TypedCommandBuffer::Capture(sTypedCommandFrame& frame)
+{
+    frame.records.clear();
+    frame.overflowCount = 0;
+
+    if (m_data == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t* header      = GetHeader();
+    uint32_t  recordCount = header[1];
+    if (recordCount > m_capacity)
+    {
+        recordCount = m_capacity;
+    }
+
+    auto const* records = reinterpret_cast<sTypedCommandRecord const*>(m_data + HEADER_SIZE_BYTES);
+    frame.records.assign(records, records + recordCount);
+    frame.overflowCount = header[3];
+
+    header[1] = 0;
+    header[3] = 0;
+
+    return recordCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t TypedCommandBuffer::Apply(sTypedCommandFrame const& frame)
+{
+    return ExecuteRecords(frame.records.data(), static_cast<uint32_t>(frame.records.size()), frame.overflowCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+void TypedCommandBuffer::AddFlushedRecords(sTypedCommandRecord const* records, uint32_t const recordCount)
+{
+    m_flushedRecords.insert(m_flushedRecords.end(), records, records + recordCount);
+    m_totalFlushed += recordCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TypedCommandBuffer::IsAwaitingFlushedRecords(sTypedCommandFrame const& frame) const
+{
+    if (frame.records.empty() || frame.records.front().opcode != static_cast<uint32_t>(eTypedCommand::FLUSHED_RECORDS))
+    {
+        return false;
+    }
+
+    return static_cast<size_t>(frame.records.front().targetId) > m_flushedRecords.size() - m_flushedReadIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t TypedCommandBuffer::ExecuteRecords(sTypedCommandRecord const* records, uint32_t const recordCount, uint32_t const overflowCount)
+{
+    uint32_t appliedCount = recordCount;
+
+    for (uint32_t i = 0; i < recordCount; ++i)
+    {
+        if (records[i].opcode == static_cast<uint32_t>(eTypedCommand::FLUSHED_RECORDS))
+        {
+            appliedCount += ApplyFlushedRecords(static_cast<uint32_t>(records[i].targetId));
+            --appliedCount;
+            continue;
+        }
+
+        if (!Execute(records[i]))
+        {
+            ++m_totalInvalid;
+        }
+    }
+
+    m_totalOverflows += overflowCount;
+    m_totalRecords += appliedCount;
+    m_lastDrainCount = appliedCount;
+
+    return appliedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// ApplyFlushedRecords
+//
+// typed.flush commands arrive in frame order, so the oldest queued records always belong to the
+// marker being applied. A flush lost before reaching C++ leaves the queue short; the marker then
+// applies what is there and the next flushes realign once the queue empties.
+//----------------------------------------------------------------------------------------------------
+uint32_t TypedCommandBuffer::ApplyFlushedRecords(uint32_t const recordCount)
+{
+    size_t const available  = m_flushedRecords.size() - m_flushedReadIndex;
+    size_t const applyCount = (recordCount < available) ? recordCount : available;
+
+    for (size_t i = 0; i < applyCount; ++i)
+    {
+        if (!Execute(m_flushedRecords[m_flushedReadIndex + i]))
+        {
+            ++m_totalInvalid;
+        }
+    }
+
+    m_flushedReadIndex += applyCount;
+    if (m_flushedReadIndex == m_flushedRecords.size())
+    {
+        m_flushedRecords.clear();
+        m_flushedReadIndex = 0;
+    }
+
+    return static_cast<uint32_t>(applyCount);
+}
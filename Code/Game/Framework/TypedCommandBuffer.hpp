@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------------------------------
+// TypedCommandBuffer.hpp
+// Fixed-layout binary fast path for high-frequency GenericCommands
+//
+// Purpose:
+//   Per-frame transform commands (entity.update_position, entity.move_by, camera.update, ...) are
+//   the bulk of GenericCommand traffic. On the JSON path every one of them pays JSON.stringify on
+//   the worker thread and nlohmann::json::parse on the main thread. This buffer lets JavaScript
+//   write packed 48-byte records into a shared ArrayBuffer instead; C++ handlers receive a POD
+//   view of each record with no parse step. The JSON pipeline stays the fallback for everything
+//   else (tool/KADI commands, lifecycle commands with callbacks).
+//
+// Overflow:
+//   When the buffer fills mid-frame, JS sends the records written so far as one typed.flush JSON
+//   command and restarts the buffer with a FLUSHED_RECORDS record. AddFlushedRecords() queues the
+//   flushed records and the marker applies them in place, so typed records stay in write order and
+//   never land after (and overwrite) newer ones. overflowCount only counts records the flush itself
+//   could not carry.
+//
+// Memory Layout (little-endian, mirrored in Run/Data/Scripts/Interface/CommandQueue.js):
+//   Header (16 bytes):
+//     uint32 [0] version        - TYPED_COMMAND_BUFFER_VERSION (written by C++)
+//     uint32 [1] recordCount    - Records written this frame (written by JS, reset by C++)
+//     uint32 [2] capacity       - Maximum records (written by C++)
+//     uint32 [3] overflowCount  - Records JS could not fit or flush and sent as JSON (reset by C++)
+//   Records (48 bytes each, starting at byte 16):
+//     uint32 opcode   @ +0      - eTypedCommand
+//     uint32 reserved @ +4
+//     double targetId @ +8      - EntityID / camera ID / SoundID (JS number, exact up to 2^53)
+//     float  values[6]@ +16     - Opcode-specific arguments (see eTypedCommand)
+//     uint32 padding[2] @ +40
+//
+// Thread Safety Model:
+//   - Worker Thread: JavaScript appends records while JSGameLogicJob executes a frame
+//   - Main Thread: Drain() runs only after JSGameLogicJob::IsFrameComplete() returned true and
+//     before TriggerNextFrame(), so the frame mutex handshake orders every access. No atomics needed.
+//   - Records are applied after the JSON commands consumed earlier in the same main-thread frame.
+//   - Pipelined mode (JSFramePipeline): the worker Capture()s each finished frame into a ring slot
+//     under the v8::Locker, and the main thread Apply()s the copy - the shared bytes never cross threads.
+//----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Forward Declarations
+//----------------------------------------------------------------------------------------------------
+namespace v8
+{
+class BackingStore;
+class Isolate;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t constexpr TYPED_COMMAND_BUFFER_VERSION = 1;
+
+//----------------------------------------------------------------------------------------------------
+// eTypedCommand
+//
+// Opcode values are part of the JS contract (CommandQueue.js TypedCommand) — append only.
+//----------------------------------------------------------------------------------------------------
+enum class eTypedCommand : uint32_t
+{
+    NONE                      = 0,
+    ENTITY_UPDATE_POSITION    = 1,     // values: x, y, z
+    ENTITY_MOVE_BY            = 2,     // values: dx, dy, dz
+    ENTITY_UPDATE_ORIENTATION = 3,     // values: yaw, pitch, roll
+    ENTITY_UPDATE_COLOR       = 4,     // values: r, g, b, a (0-255)
+    CAMERA_UPDATE             = 5,     // values: posX, posY, posZ, yaw, pitch, roll
+    CAMERA_UPDATE_POSITION    = 6,     // values: x, y, z
+    CAMERA_UPDATE_ORIENTATION = 7,     // values: yaw, pitch, roll
+    CAMERA_MOVE_BY            = 8,     // values: dx, dy, dz
+    AUDIO_UPDATE_3D_POSITION  = 9,     // values: x, y, z
+    FLUSHED_RECORDS           = 10,    // targetId: records flushed as typed.flush so far this frame
+                                       // (written by CommandQueue.js at index 0, handled internally)
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sTypedCommandRecord
+{
+    uint32_t opcode;
+    uint32_t reserved;
+    double   targetId;
+    float    values[6];
+    uint32_t padding[2];
+};
+
+static_assert(sizeof(sTypedCommandRecord) == 48, "sTypedCommandRecord layout is shared with CommandQueue.js");
+
+//----------------------------------------------------------------------------------------------------
+// One JS frame's records, copied out of the shared buffer (pipelined mode)
+//----------------------------------------------------------------------------------------------------
+struct sTypedCommandFrame
+{
+    std::vector<sTypedCommandRecord> records;
+    uint32_t                         overflowCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class TypedCommandBuffer
+{
+public:
+    using TypedHandler = std::function<void(sTypedCommandRecord const& record)>;
+
+    static size_t constexpr HEADER_SIZE_BYTES = 16;
+
+    explicit TypedCommandBuffer(uint32_t recordCapacity);
+    ~TypedCommandBuffer();
+
+    TypedCommandBuffer(TypedCommandBuffer const&)            = delete;
+    TypedCommandBuffer& operator=(TypedCommandBuffer const&) = delete;
+
+    // Allocate the ArrayBuffer inside the V8 heap (sandbox-safe) and publish it as globalThis[globalName].
+    // Thread Safety: Main thread only, before JSGameLogicJob is submitted
+    bool InstallScriptBuffer(v8::Isolate* isolate, char const* globalName);
+
+    // Register the POD handler for one opcode (mirrors GenericCommandExecutor::RegisterHandler)
+    void RegisterHandler(eTypedCommand opcode, TypedHandler handler);
+
+    // Dispatch one record to its handler; returns false for unknown or unregistered opcodes
+    bool Execute(sTypedCommandRecord const& record) const;
+
+    // Apply every record JavaScript wrote during the last frame, then reset the buffer
+    // Thread Safety: Main thread only, between IsFrameComplete() and TriggerNextFrame()
+    uint32_t Drain();
+
+    // Copy the records of the frame that just finished into frame (reusing its capacity), then reset
+    // Thread Safety: Worker thread, v8::Locker held so no other thread can run JavaScript meanwhile
+    uint32_t Capture(sTypedCommandFrame& frame);
+
+    // Apply a frame previously Capture()d; same handlers and counters as Drain()
+    // Thread Safety: Main thread only
+    uint32_t Apply(sTypedCommandFrame const& frame);
+
+    // Queue records from a typed.flush command; applied by the frame's FLUSHED_RECORDS record
+    // Thread Safety: Main thread only
+    void AddFlushedRecords(sTypedCommandRecord const* records, uint32_t recordCount);
+
+    // True when frame's FLUSHED_RECORDS marker expects more records than the typed.flush commands
+    // consumed so far delivered (pipelined mode: process GenericCommands again before Apply())
+    bool IsAwaitingFlushedRecords(sTypedCommandFrame const& frame) const;
+
+    bool     IsInstalled() const { return m_data != nullptr; }
+    uint32_t GetCapacity() const { return m_capacity; }
+    uint32_t GetLastDrainCount() const { return m_lastDrainCount; }
+    uint64_t GetTotalRecords() const { return m_totalRecords; }
+    uint64_t GetTotalOverflows() const { return m_totalOverflows; }
+    uint64_t GetTotalFlushed() const { return m_totalFlushed; }
+    uint64_t GetTotalInvalid() const { return m_totalInvalid; }
+
+private:
+    uint32_t* GetHeader() const { return reinterpret_cast<uint32_t*>(m_data); }
+    uint32_t  ExecuteRecords(sTypedCommandRecord const* records, uint32_t recordCount, uint32_t overflowCount);
+    uint32_t  ApplyFlushedRecords(uint32_t recordCount);
+
+    std::shared_ptr<v8::BackingStore> m_backingStore;     // Keeps the JS-visible memory alive
+    uint8_t*                          m_data     = nullptr;
+    uint32_t                          m_capacity = 0;
+
+    std::array<TypedHandler, static_cast<size_t>(eTypedCommand::COUNT)> m_handlers;
+
+    std::vector<sTypedCommandRecord> m_flushedRecords;          // FIFO across frames, oldest first
+    size_t                           m_flushedReadIndex = 0;
+
+    uint32_t m_lastDrainCount = 0;
+    uint64_t m_totalRecords   = 0;
+    uint64_t m_totalOverflows = 0;
+    uint64_t m_totalInvalid   = 0;
+    uint64_t m_totalFlushed   = 0;
+};
@@ -19,11 +19,72 @@
 #include "Engine/Script/ScriptSubsystem.hpp"
 #include "ThirdParty/imgui/imgui.h"
 
+// Suppress V8 header warnings (unreferenced formal parameters, etc.)
+#pragma warning(push)
+#pragma warning(disable: 4100)  // 'identifier': unreferenced formal parameter
+#pragma warning(disable: 4127)  // conditional expression is constant
+#pragma warning(disable: 4324)  // 'structname': structure was padded due to alignment specifier
+#include <v8.h>
+#pragma warning(pop)
+
 #include <any>
+#include <chrono>
 #include <typeinfo>
 
+//----------------------------------------------------------------------------------------------------
+// sJSEngineBindings
+//
+// JSEngine.update / JSEngine.render resolved once into persistent handles, so the worker frame calls
+// them directly instead of compiling an eval string (plus a typeof check) for each call. The handles
+// are re-resolved only when globalThis.__hotReload.engineEpoch changes; main.js bumps it through
+// HotReloadRegistry.bumpEngineEpoch() whenever it replaces globalThis.JSEngine.
+//----------------------------------------------------------------------------------------------------
+struct sJSEngineBindings
+{
+    v8::Global<v8::Object>   engineObject;
+    v8::Global<v8::Function> updateFunction;
+    v8::Global<v8::Function> renderFunction;
+    v8::Global<v8::String>   hotReloadKey;      // "__hotReload"
+    v8::Global<v8::String>   epochKey;          // "engineEpoch"
+    uint32_t                 boundEpoch = 0;
+    bool                     isBound    = false;
+
+    void Reset()
+    {
+        engineObject.Reset();
+        updateFunction.Reset();
+        renderFunction.Reset();
+        hotReloadKey.Reset();
+        epochKey.Reset();
+        isBound = false;
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Smoothing factor for the worker call-time moving averages (~20 frame window)
+static double constexpr JS_CALL_TIME_EMA_ALPHA = 0.05;
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t ReadJSEngineEpoch(v8::Isolate* isolate, v8::Local<v8::Context> const& context, sJSEngineBindings const& bindings)
+{
+    v8::Local<v8::Value> hotReload;
+    if (!context->Global()->Get(context, bindings.hotReloadKey.Get(isolate)).ToLocal(&hotReload) || !hotReload->IsObject())
+    {
+        return 0;
+    }
+
+    v8::Local<v8::Value> epoch;
+    if (!hotReload.As<v8::Object>()->Get(context, bindings.epochKey.Get(isolate)).ToLocal(&epoch) || !epoch->IsNumber())
+    {
+        return 0;
+    }
+
+    return epoch->Uint32Value(context).FromMaybe(0);
+}
+
 //----------------------------------------------------------------------------------------------------
 Game::Game()
+    : m_jsBindings(std::make_unique<sJSEngineBindings>())
 {
     DAEMON_LOG(LogGame, eLogVerbosity::Log, "(Game::Game)");
 }
@@ -32,6 +93,9 @@ Game::Game()
 Game::~Game()
 {
     DAEMON_LOG(LogGame, eLogVerbosity::Log, "(Game::~Game)");
+
+    // Worker thread has exited by now; the isolate must still be alive to release the Globals
+    ReleaseJSEngineBindings();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -524,23 +588,33 @@ void Game::UpdateJSWorkerThread(float deltaTime)
         return;
     }
 
-    if (IsJSEngineReady("update"))
-    {
-        ExecuteJavaScriptCommand(StringFormat("globalThis.JSEngine.update({});", std::to_string(deltaTime)));
-    }
-    else
-    {
-        // Throttled warning (once per second)
-        static float lastWarningTime = 0.0f;
-        float currentTime = static_cast<float>(Clock::GetSystemClock().GetTotalSeconds());
+    auto const callStart = std::chrono::steady_clock::now();
 
-        if (currentTime - lastWarningTime >= 1.0f)
+    bool const isDirect = m_isDirectJSCallEnabled.load(std::memory_order_relaxed) && CallJSEngineFunction(true, deltaTime);
+
+    if (!isDirect)
+    {
+        if (IsJSEngineReady("update"))
         {
-            DAEMON_LOG(LogScript, eLogVerbosity::Warning,
-                "UpdateJSWorkerThread: globalThis.JSEngine not initialized - skipping JavaScript update");
-            lastWarningTime = currentTime;
+            ExecuteJavaScriptCommand(StringFormat("globalThis.JSEngine.update({});", std::to_string(deltaTime)));
+        }
+        else
+        {
+            // Throttled warning (once per second)
+            static float lastWarningTime = 0.0f;
+            float currentTime = static_cast<float>(Clock::GetSystemClock().GetTotalSeconds());
+
+            if (currentTime - lastWarningTime >= 1.0f)
+            {
+                DAEMON_LOG(LogScript, eLogVerbosity::Warning,
+                    "UpdateJSWorkerThread: globalThis.JSEngine not initialized - skipping JavaScript update");
+                lastWarningTime = currentTime;
+            }
         }
     }
+
+    auto const callEnd = std::chrono::steady_clock::now();
+    RecordJSWorkerCallTime(true, isDirect, std::chrono::duration<double, std::milli>(callEnd - callStart).count());
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -551,11 +625,19 @@ void Game::RenderJSWorkerThread(float deltaTime)
         return;
     }
 
-    if (IsJSEngineReady("render"))
+    auto const callStart = std::chrono::steady_clock::now();
+
+    bool const isDirect = m_isDirectJSCallEnabled.load(std::memory_order_relaxed) && CallJSEngineFunction(false, deltaTime);
+
+    if (!isDirect && IsJSEngineReady("render"))
     {
         ExecuteJavaScriptCommand("globalThis.JSEngine.render();");
     }
+
+    auto const callEnd = std::chrono::steady_clock::now();
+    RecordJSWorkerCallTime(false, isDirect, std::chrono::duration<double, std::milli>(callEnd - callStart).count());
 }
+
 //----------------------------------------------------------------------------------------------------
 void Game::HandleJSException(char const* errorMessage, char const* stackTrace)
 {
@@ -604,3 +686,162 @@ bool Game::IsJSEngineReady(char const* methodName) const
 
     return false;
 }
+
+//----------------------------------------------------------------------------------------------------
+sJSWorkerCallStats Game::GetJSWorkerCallStats() const
+{
+    sJSWorkerCallStats stats;
+    stats.lastUpdateMs    = m_lastUpdateCallMs.load(std::memory_order_relaxed);
+    stats.lastRenderMs    = m_lastRenderCallMs.load(std::memory_order_relaxed);
+    stats.avgDirectMs     = m_avgDirectCallMs.load(std::memory_order_relaxed);
+    stats.avgEvalMs       = m_avgEvalCallMs.load(std::memory_order_relaxed);
+    stats.directFrames    = m_directCallFrames.load(std::memory_order_relaxed);
+    stats.evalFrames      = m_evalCallFrames.load(std::memory_order_relaxed);
+    stats.rebindCount     = m_jsRebindCount.load(std::memory_order_relaxed);
+    stats.isDirectEnabled = m_isDirectJSCallEnabled.load(std::memory_order_relaxed);
+    stats.isBound         = m_isJSEngineBound.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BindJSEngineFunctions (Worker Thread)
+//
+// Cheap per-frame check: one property read of __hotReload.engineEpoch. Only when the epoch moved (or
+// nothing is bound yet) are JSEngine, JSEngine.update and JSEngine.render looked up again.
+// Returns false when JSEngine is not usable yet; the caller falls back to the eval path.
+//----------------------------------------------------------------------------------------------------
+bool Game::BindJSEngineFunctions()
+{
+    v8::Isolate* isolate = g_scriptSubsystem->GetIsolate();
+    if (isolate == nullptr)
+    {
+        return false;
+    }
+
+    v8::HandleScope              handleScope(isolate);
+    v8::Local<v8::Context> const context = isolate->GetCurrentContext();
+    if (context.IsEmpty())
+    {
+        return false;
+    }
+
+    sJSEngineBindings& bindings = *m_jsBindings;
+    if (bindings.hotReloadKey.IsEmpty())
+    {
+        bindings.hotReloadKey.Reset(isolate, v8::String::NewFromUtf8Literal(isolate, "__hotReload", v8::NewStringType::kInternalized));
+        bindings.epochKey.Reset(isolate, v8::String::NewFromUtf8Literal(isolate, "engineEpoch", v8::NewStringType::kInternalized));
+    }
+
+    uint32_t const epoch = ReadJSEngineEpoch(isolate, context, bindings);
+    if (bindings.isBound && epoch == bindings.boundEpoch)
+    {
+        return true;
+    }
+
+    bindings.isBound = false;
+    m_isJSEngineBound.store(false, std::memory_order_relaxed);
+
+    v8::Local<v8::Value> engineValue;
+    if (!context->Global()->Get(context, v8::String::NewFromUtf8Literal(isolate, "JSEngine")).ToLocal(&engineValue) || !engineValue->IsObject())
+    {
+        return false;
+    }
+
+    v8::Local<v8::Object> const engine = engineValue.As<v8::Object>();
+    v8::Local<v8::Value>        updateValue;
+    v8::Local<v8::Value>        renderValue;
+    if (!engine->Get(context, v8::String::NewFromUtf8Literal(isolate, "update")).ToLocal(&updateValue) || !updateValue->IsFunction() ||
+        !engine->Get(context, v8::String::NewFromUtf8Literal(isolate, "render")).ToLocal(&renderValue) || !renderValue->IsFunction())
+    {
+        return false;
+    }
+
+    bindings.engineObject.Reset(isolate, engine);
+    bindings.updateFunction.Reset(isolate, updateValue.As<v8::Function>());
+    bindings.renderFunction.Reset(isolate, renderValue.As<v8::Function>());
+    bindings.boundEpoch = epoch;
+    bindings.isBound    = true;
+
+    m_isJSEngineBound.store(true, std::memory_order_relaxed);
+    uint64_t const rebindCount = m_jsRebindCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    DAEMON_LOG(LogScript, eLogVerbosity::Log,
+        StringFormat("(Game::BindJSEngineFunctions) JSEngine.update/render bound (epoch {}, bind #{})", epoch, rebindCount));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// CallJSEngineFunction (Worker Thread)
+//
+// Called inside JSGameLogicJob::ExecuteJavaScriptFrame(), which holds the v8::Locker and a TryCatch:
+// a JavaScript exception thrown here is reported through HandleJSException() like any other worker
+// exception. Returns false only if the call could not be made (not bound), never on a JS throw.
+//----------------------------------------------------------------------------------------------------
+bool Game::CallJSEngineFunction(bool const isUpdate, float const deltaTime)
+{
+    // Re-check binding once per frame (update runs first); render reuses the same handles
+    if (isUpdate || !m_jsBindings->isBound)
+    {
+        if (!BindJSEngineFunctions())
+        {
+            return false;
+        }
+    }
+
+    v8::Isolate*                 isolate = g_scriptSubsystem->GetIsolate();
+    v8::HandleScope              handleScope(isolate);
+    v8::Local<v8::Context> const context = isolate->GetCurrentContext();
+    v8::Context::Scope           contextScope(context);
+
+    sJSEngineBindings const&      bindings = *m_jsBindings;
+    v8::Local<v8::Function> const function = isUpdate ? bindings.updateFunction.Get(isolate) : bindings.renderFunction.Get(isolate);
+    v8::Local<v8::Value>          argv[1]  = {v8::Number::New(isolate, static_cast<double>(deltaTime))};
+
+    // Result is unused; an empty MaybeLocal means the TryCatch in JSGameLogicJob captured the exception
+    (void)function->Call(context, bindings.engineObject.Get(isolate), isUpdate ? 1 : 0, argv);
+
+    // No-op under the default auto microtask policy; drains promise jobs if the isolate runs explicit
+    isolate->PerformMicrotaskCheckpoint();
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Game::ReleaseJSEngineBindings()
+{
+    if (!m_jsBindings || g_scriptSubsystem == nullptr || g_scriptSubsystem->GetIsolate() == nullptr)
+    {
+        return;
+    }
+
+    v8::Isolate*       isolate = g_scriptSubsystem->GetIsolate();
+    v8::Locker         locker(isolate);
+    v8::Isolate::Scope isolateScope(isolate);
+
+    m_jsBindings->Reset();
+    m_isJSEngineBound.store(false, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+// RecordJSWorkerCallTime (Worker Thread)
+//
+// A frame counts toward avgDirectMs or avgEvalMs by the path its render call took; the frame cost is
+// the update call plus the render call, so the two averages compare like for like.
+//----------------------------------------------------------------------------------------------------
+void Game::RecordJSWorkerCallTime(bool const isUpdate, bool const isDirect, double const elapsedMs)
+{
+    if (isUpdate)
+    {
+        m_lastUpdateCallMs.store(elapsedMs, std::memory_order_relaxed);
+        return;
+    }
+
+    m_lastRenderCallMs.store(elapsedMs, std::memory_order_relaxed);
+
+    double const           frameMs = m_lastUpdateCallMs.load(std::memory_order_relaxed) + elapsedMs;
+    std::atomic<double>&   average = isDirect ? m_avgDirectCallMs : m_avgEvalCallMs;
+    std::atomic<uint64_t>& frames  = isDirect ? m_directCallFrames : m_evalCallFrames;
+    double const           prevAvg = average.load(std::memory_order_relaxed);
+    uint64_t const         count   = frames.fetch_add(1, std::memory_order_relaxed);
+
+    average.store((count == 0) ? frameMs : prevAvg + JS_CALL_TIME_EMA_ALPHA * (frameMs - prevAvg), std::memory_order_relaxed);
+}
@@ -8,6 +8,30 @@
 #include "Engine/Script/IJSGameLogicContext.hpp"
 
 #include <atomic>
+#include <memory>
+
+//----------------------------------------------------------------------------------------------------
+struct sJSEngineBindings;   // Persistent V8 handles for JSEngine.update/render (defined in Game.cpp)
+
+//----------------------------------------------------------------------------------------------------
+// sJSWorkerCallStats
+//
+// Worker-thread cost of the per-frame JSEngine.update + render calls. avgDirectMs / avgEvalMs are
+// exponential moving averages of the same work through the cached function handles and through
+// the legacy eval strings, so toggling the call mode yields the per-frame saving directly.
+//----------------------------------------------------------------------------------------------------
+struct sJSWorkerCallStats
+{
+    double   lastUpdateMs    = 0.0;
+    double   lastRenderMs    = 0.0;
+    double   avgDirectMs     = 0.0;
+    double   avgEvalMs       = 0.0;
+    uint64_t directFrames    = 0;
+    uint64_t evalFrames      = 0;
+    uint64_t rebindCount     = 0;
+    bool     isDirectEnabled = true;
+    bool     isBound         = false;
+};
 
 //----------------------------------------------------------------------------------------------------
 class Game : public IJSGameLogicContext
@@ -38,11 +62,32 @@ public:
     bool     HasJSExceptions() const { return m_jsExceptionCount.load(std::memory_order_relaxed) > 0; }
     void     ResetJSExceptionCount() { m_jsExceptionCount.store(0, std::memory_order_relaxed); }
 
+    // JSEngine call path: cached v8::Function handles (direct) or per-frame eval strings (fallback)
+    void               SetDirectJSCallsEnabled(bool enabled) { m_isDirectJSCallEnabled.store(enabled, std::memory_order_relaxed); }
+    sJSWorkerCallStats GetJSWorkerCallStats() const;
+
 private:
     void InitializeJavaScriptFramework();
     bool IsScriptSubsystemReady() const;
     bool IsJSEngineReady(char const* methodName) const;
 
+    // Worker thread only (caller holds the v8::Locker and an entered context)
+    bool BindJSEngineFunctions();
+    bool CallJSEngineFunction(bool isUpdate, float deltaTime);
+    void ReleaseJSEngineBindings();
+    void RecordJSWorkerCallTime(bool isUpdate, bool isDirect, double elapsedMs);
+
     bool                    m_showDemoWindow = true;
     std::atomic<uint64_t>   m_jsExceptionCount{0};
+
+    std::unique_ptr<sJSEngineBindings> m_jsBindings;
+    std::atomic<bool>                  m_isDirectJSCallEnabled{true};
+    std::atomic<bool>                  m_isJSEngineBound{false};
+    std::atomic<double>                m_lastUpdateCallMs{0.0};
+    std::atomic<double>                m_lastRenderCallMs{0.0};
+    std::atomic<double>                m_avgDirectCallMs{0.0};
+    std::atomic<double>                m_avgEvalCallMs{0.0};
+    std::atomic<uint64_t>              m_directCallFrames{0};
+    std::atomic<uint64_t>              m_evalCallFrames{0};
+    std::atomic<uint64_t>              m_jsRebindCount{0};
 };
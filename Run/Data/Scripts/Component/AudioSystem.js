@@ -4,6 +4,7 @@
 import { Subsystem } from '../Core/Subsystem.js';
 import { EventTypes } from '../Event/EventTypes.js';
 import { audioAPI } from '../Interface/AudioAPI.js';  // Async audio via GenericCommand pipeline
+import { hotReloadRegistry } from '../Core/HotReloadRegistry.js';
 
 /**
  * AudioSystem - Audio subsystem using GenericCommand pipeline
@@ -287,4 +288,10 @@ export class AudioSystem extends Subsystem {
 // Export for ES6 module system
 export default AudioSystem;
 
+// Reload boundary: JSEngine upgrades the live system from HotReloadRegistry
+hotReloadRegistry.register('AudioSystem', AudioSystem, {
+    modulePath: './Component/AudioSystem.js',
+    parentClass: 'Subsystem'
+});
+
 console.log('AudioSystem: Component loaded (Phase 4 ES6)');
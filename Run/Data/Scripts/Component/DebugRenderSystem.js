@@ -4,6 +4,7 @@
 
 import { Subsystem } from '../Core/Subsystem.js';
 import { DebugRenderAPI } from '../Interface/DebugRenderAPI.js';
+import { hotReloadRegistry } from '../Core/HotReloadRegistry.js';
 
 /**
  * DebugRenderSystem - JavaScript wrapper for debug visualization
@@ -173,4 +174,10 @@ export class DebugRenderSystem extends Subsystem
 // Export to globalThis for hot-reload detection
 globalThis.DebugRenderSystem = DebugRenderSystem;
 
+// Reload boundary: JSEngine upgrades the live system from HotReloadRegistry
+hotReloadRegistry.register('DebugRenderSystem', DebugRenderSystem, {
+    modulePath: './Component/DebugRenderSystem.js',
+    parentClass: 'Subsystem'
+});
+
 console.log('DebugRenderSystem: Component loaded (GenericCommand pipeline)');
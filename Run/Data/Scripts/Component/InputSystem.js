@@ -12,6 +12,7 @@ import {GameState} from "../JSGame.js";
 import {jsGameInstance} from "../main.js";
 import {EventTypes} from "../Event/EventTypes.js";
 import {GameStateChangedEvent} from "../Event/GameStateChangedEvent.js";
+import {hotReloadRegistry} from "../Core/HotReloadRegistry.js";
 
 /**
  * InputState - Local input state maintained by draining FrameEventQueue.
@@ -183,4 +184,10 @@ export default InputSystem;
 // Export to globalThis for hot-reload detection
 globalThis.InputSystem = InputSystem;
 
+// Reload boundary: JSEngine upgrades the live system from HotReloadRegistry
+hotReloadRegistry.register('InputSystem', InputSystem, {
+    modulePath: './Component/InputSystem.js',
+    parentClass: 'Subsystem'
+});
+
 console.log('InputSystem: Component loaded (FrameEventQueue architecture)');
@@ -4,6 +4,7 @@
 //----------------------------------------------------------------------------------------------------
 
 import {BehaviorComponent} from './BehaviorComponent.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * PulseColorBehavior - Pulsates mesh color using sin wave
@@ -89,4 +90,10 @@ export default PulseColorBehavior;
 // Export to globalThis for hot-reload detection
 globalThis.PulseColorBehavior = PulseColorBehavior;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('PulseColorBehavior', PulseColorBehavior, {
+    modulePath: './Component/behavior/PulseColorBehavior.js',
+    parentClass: 'BehaviorComponent'
+});
+
 console.log('PulseColorBehavior: Loaded (Phase 4 - Prop Migration)');
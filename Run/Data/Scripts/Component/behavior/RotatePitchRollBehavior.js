@@ -4,6 +4,7 @@
 //----------------------------------------------------------------------------------------------------
 
 import {BehaviorComponent} from './BehaviorComponent.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * RotatePitchRollBehavior - Rotates pitch and roll continuously
@@ -58,4 +59,10 @@ export default RotatePitchRollBehavior;
 // Export to globalThis for hot-reload detection
 globalThis.RotatePitchRollBehavior = RotatePitchRollBehavior;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('RotatePitchRollBehavior', RotatePitchRollBehavior, {
+    modulePath: './Component/behavior/RotatePitchRollBehavior.js',
+    parentClass: 'BehaviorComponent'
+});
+
 console.log('RotatePitchRollBehavior: Loaded (Phase 4 - Prop Migration)');
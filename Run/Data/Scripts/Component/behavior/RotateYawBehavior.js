@@ -4,6 +4,7 @@
 //----------------------------------------------------------------------------------------------------
 
 import {BehaviorComponent} from './BehaviorComponent.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * RotateYawBehavior - Rotates yaw continuously
@@ -56,4 +57,10 @@ export default RotateYawBehavior;
 // Export to globalThis for hot-reload detection
 globalThis.RotateYawBehavior = RotateYawBehavior;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('RotateYawBehavior', RotateYawBehavior, {
+    modulePath: './Component/behavior/RotateYawBehavior.js',
+    parentClass: 'BehaviorComponent'
+});
+
 console.log('RotateYawBehavior: Loaded (Phase 4 - Prop Migration)');
@@ -4,6 +4,7 @@
 //----------------------------------------------------------------------------------------------------
 
 import {BehaviorComponent} from './BehaviorComponent.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * StaticBehavior - No behavior, prop remains static
@@ -45,4 +46,10 @@ export default StaticBehavior;
 // Export to globalThis for hot-reload detection
 globalThis.StaticBehavior = StaticBehavior;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('StaticBehavior', StaticBehavior, {
+    modulePath: './Component/behavior/StaticBehavior.js',
+    parentClass: 'BehaviorComponent'
+});
+
 console.log('StaticBehavior: Loaded (Phase 4 - Prop Migration)');
@@ -5,6 +5,7 @@
 
 import {Component} from '../../Core/Component.js';
 import {CameraAPI} from '../../Interface/CameraAPI.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * CameraComponent - Manages world camera lifecycle using Phase 2b CameraAPI
@@ -247,4 +248,10 @@ export default CameraComponent;
 // Export to globalThis for hot-reload detection
 globalThis.CameraComponent = CameraComponent;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('CameraComponent', CameraComponent, {
+    modulePath: './Component/camera/CameraComponent.js',
+    parentClass: 'Component'
+});
+
 console.log('CameraComponent: Loaded (Phase 2b - CameraAPI Migration)');
@@ -6,6 +6,7 @@
 import {InputComponent} from './InputComponent.js';
 import {InputInterface} from '../../Interface/InputInterface.js';
 import {KEYCODE_LEFT, KEYCODE_RIGHT, KEYCODE_UP, KEYCODE_DOWN, KEYCODE_SPACE, KEYCODE_W, KEYCODE_A, KEYCODE_S, KEYCODE_D, KEYCODE_Z, KEYCODE_C, KEYCODE_Q, KEYCODE_E, KEYCODE_SHIFT} from '../../InputSystemCommon.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * KeyboardInputComponent - Keyboard input implementation
@@ -131,4 +132,10 @@ export default KeyboardInputComponent;
 // Export to globalThis for hot-reload detection
 globalThis.KeyboardInputComponent = KeyboardInputComponent;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('KeyboardInputComponent', KeyboardInputComponent, {
+    modulePath: './Component/input/KeyboardInputComponent.js',
+    parentClass: 'InputComponent'
+});
+
 console.log('KeyboardInputComponent: Loaded (Phase 1 - Foundation Layer)');
@@ -10,6 +10,7 @@
 
 import {Component} from '../../Core/Component.js';
 import {InputInterface} from '../../Interface/InputInterface.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * FlyingMovementComponent - 3D flying camera movement
@@ -330,5 +331,11 @@ export default FlyingMovementComponent;
 // Export to globalThis for hot-reload detection
 globalThis.FlyingMovementComponent = FlyingMovementComponent;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('FlyingMovementComponent', FlyingMovementComponent, {
+    modulePath: './Component/movement/FlyingMovementComponent.js',
+    parentClass: 'Component'
+});
+
 console.log('FlyingMovementComponent: Loaded (Phase 2 + Phase 3 - Complete Movement System)');
 console.log('FlyingMovementComponent: [HOT-RELOAD VERIFICATION] Using C++ EulerAngles formulas: forward=(cy*cp, sy*cp, -sp), left=(full 3D formula with roll)');
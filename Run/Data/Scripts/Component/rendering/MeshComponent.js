@@ -6,6 +6,7 @@
 
 import {Component} from '../../Core/Component.js';
 import {EntityAPI} from '../../Interface/EntityAPI.js';
+import {hotReloadRegistry} from '../../Core/HotReloadRegistry.js';
 
 /**
  * MeshComponent - Manages entity creation and state synchronization (Phase 2)
@@ -296,4 +297,10 @@ export default MeshComponent;
 // Export to globalThis for hot-reload detection
 globalThis.MeshComponent = MeshComponent;
 
+// Reload boundary: GameObject.upgradeComponents() re-points live components at the new class
+hotReloadRegistry.register('MeshComponent', MeshComponent, {
+    modulePath: './Component/rendering/MeshComponent.js',
+    parentClass: 'Component'
+});
+
 console.log(`MeshComponent: Loaded (Phase 2 - High-Level Entity API, version ${MeshComponent.version})`);
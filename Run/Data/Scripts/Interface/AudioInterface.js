@@ -23,6 +23,8 @@
  * - stop_sound(soundId) → callback(resultId)
  * - set_volume(soundId, volume) → callback(resultId)
  * - update_3d_position(soundId, position) → callback(resultId)
+ * - audio.update_sources({ids, positions, volumes, entityIds, offsets, listener, listenerEntityId})
+ * - audio.get_source_stats() → callback(stats)
  *
  * Usage Example:
  * ```javascript
@@ -34,6 +36,8 @@
  * });
  * ```
  */
+import { TypedCommand } from './CommandQueue.js';
+
 export class AudioInterface
 {
     constructor()
@@ -213,7 +217,7 @@ export class AudioInterface
      * @param {number} y - Y coordinate
      * @param {number} z - Z coordinate
      * @param {Function} [callback] - Optional callback(soundId) when queued
-     * @returns {number} callbackId
+     * @returns {number} callbackId (0 when sent through the typed fast path without callback)
      */
     update3DPositionAsync(soundId, x, y, z, callback = null)
     {
@@ -225,6 +229,13 @@ export class AudioInterface
             return 0;
         }
 
+        // Per-frame position updates without a callback skip JSON entirely
+        if (!callback && typeof commandQueue.submitTyped === 'function' &&
+            commandQueue.submitTyped(TypedCommand.AUDIO_UPDATE_3D_POSITION, soundId, x, y, z))
+        {
+            return 0;
+        }
+
         const callbackId = commandQueue.submit(
             'update_3d_position',
             { soundId, position: [x, y, z] },
@@ -240,6 +251,68 @@ export class AudioInterface
 
         return callbackId;
     }
+
+    /**
+     * Stage many 3D source updates (and the listener) in one command; applied once per frame.
+     * All arrays are parallel to ids: positions [3n], volumes [n], entityIds [n] (attach the source to
+     * an entity, 0 = detach), offsets [3n] (added to the entity position).
+     * @param {Object} batch - {ids, positions?, volumes?, entityIds?, offsets?, listener?, listenerEntityId?}
+     *   listener: {position: [x,y,z], forward?: [x,y,z], up?: [x,y,z]}; listenerEntityId follows an entity (0 = detach)
+     * @param {Function} [callback] - Optional callback(success) when applied to the batch
+     * @returns {number} callbackId
+     */
+    updateSources(batch, callback = null)
+    {
+        const commandQueue = globalThis.CommandQueueAPI;
+        if (!commandQueue || !commandQueue.isAvailable())
+        {
+            console.log('AudioInterface: ERROR - updateSources requires CommandQueue');
+            if (callback) callback(false);
+            return 0;
+        }
+
+        return commandQueue.submit(
+            'audio.update_sources',
+            batch,
+            'audio-interface',
+            (result) =>
+            {
+                if (callback)
+                {
+                    callback(result.success);
+                }
+            }
+        );
+    }
+
+    /**
+     * Get audio batch counters and voice usage against maxChannels
+     * @param {Function} callback - callback(stats) with the handler result object (null on failure)
+     * @returns {number} callbackId
+     */
+    getSourceStatsAsync(callback)
+    {
+        const commandQueue = globalThis.CommandQueueAPI;
+        if (!commandQueue || !commandQueue.isAvailable())
+        {
+            console.log('AudioInterface: ERROR - getSourceStatsAsync requires CommandQueue');
+            if (callback) callback(null);
+            return 0;
+        }
+
+        return commandQueue.submit(
+            'audio.get_source_stats',
+            {},
+            'audio-interface',
+            (result) =>
+            {
+                if (callback)
+                {
+                    callback(result.success ? result : null);
+                }
+            }
+        );
+    }
 }
 
 // Export for ES6 module system
@@ -34,7 +34,7 @@
  * - camera.update_type(cameraId, type) → callback(success)
  * - camera.destroy(cameraId) → callback(success)
  *
- * Updates (fire-and-forget):
+ * Updates (fire-and-forget, typed binary fast path with JSON fallback; look_at stays JSON):
  * - camera.update(cameraId, posX, posY, posZ, yaw, pitch, roll) [RECOMMENDED - atomic]
  * - camera.update_position(cameraId, x, y, z)
  * - camera.update_orientation(cameraId, yaw, pitch, roll)
@@ -63,6 +63,8 @@
  * });
  * ```
  */
+import { TypedCommand } from './CommandQueue.js';
+
 export class CameraAPI
 {
     constructor()
@@ -282,6 +284,8 @@ export class CameraAPI
      */
     async update(cameraId, posX, posY, posZ, yaw, pitch, roll)
     {
+        if (this._submitTyped(TypedCommand.CAMERA_UPDATE, cameraId, posX, posY, posZ, yaw, pitch, roll)) return;
+
         return this._submit('camera.update', { cameraId, posX, posY, posZ, yaw, pitch, roll });
     }
 
@@ -300,6 +304,8 @@ export class CameraAPI
             return;
         }
 
+        if (this._submitTyped(TypedCommand.CAMERA_UPDATE_POSITION, cameraId, position[0], position[1], position[2])) return;
+
         return this._submit('camera.update_position', { cameraId, x: position[0], y: position[1], z: position[2] });
     }
 
@@ -318,6 +324,8 @@ export class CameraAPI
             return;
         }
 
+        if (this._submitTyped(TypedCommand.CAMERA_UPDATE_ORIENTATION, cameraId, orientation[0], orientation[1], orientation[2])) return;
+
         return this._submit('camera.update_orientation', { cameraId, yaw: orientation[0], pitch: orientation[1], roll: orientation[2] });
     }
 
@@ -336,6 +344,8 @@ export class CameraAPI
             return;
         }
 
+        if (this._submitTyped(TypedCommand.CAMERA_MOVE_BY, cameraId, delta[0], delta[1], delta[2])) return;
+
         return this._submit('camera.move_by', { cameraId, dx: delta[0], dy: delta[1], dz: delta[2] });
     }
 
@@ -362,6 +372,18 @@ export class CameraAPI
     // Private Helper
     //----------------------------------------------------------------------------------------------------
 
+    /**
+     * Submit a fire-and-forget update through the typed binary buffer
+     * @returns {boolean} true if queued; false to fall back to _submit()
+     * @private
+     */
+    _submitTyped(opcode, targetId, v0, v1, v2, v3, v4, v5)
+    {
+        const commandQueue = globalThis.CommandQueueAPI;
+        return !!commandQueue && typeof commandQueue.submitTyped === 'function' &&
+            commandQueue.submitTyped(opcode, targetId, v0, v1, v2, v3, v4, v5);
+    }
+
     /**
      * Submit a command through the GenericCommand pipeline with Promise wrapping
      * @param {string} commandType - GenericCommand type (e.g. 'camera.update_position')
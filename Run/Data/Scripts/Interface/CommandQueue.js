@@ -34,6 +34,27 @@
  *   - unregisterHandler(type): boolean
  *   - getRegisteredTypes(): string (JSON array)
  *
+ * Typed Fast Path:
+ *   submitTyped(opcode, targetId, v0..v5) writes a packed 48-byte record into the shared
+ *   globalThis.typedCommandBuffer (C++ TypedCommandBuffer). No JSON, no callback; C++ applies the
+ *   records once the JS frame completes. When the buffer fills mid-frame, the records written so far
+ *   are flushed as one typed.flush command and a FLUSHED_RECORDS marker restarts the buffer, so C++
+ *   applies them in place and last-write-wins holds across the overflow. Returns false only when the
+ *   buffer is missing or the flush failed, so the caller can fall back to submit().
+ *   Layout must match Code/Game/Framework/TypedCommandBuffer.hpp.
+ *
+ * Structured Results:
+ *   submitStructured(type, payload, agentId, callback) is submit() for the high-frequency queries
+ *   (game.get_entity_list, game.query_entities_radius, game.raycast_entities). C++ writes the result
+ *   into globalThis.callbackResultRing (C++ CallbackResultRing) and processResultRing() decodes it
+ *   with typed-array views into pooled objects shaped like the JSON result - no resultJson string,
+ *   no JSON.parse. The command is submitted without a C++ callback, so nothing goes through the
+ *   CallbackQueue: handlers answer every outcome, errors included, with a ring record, and a token
+ *   that gets no record within RESULT_TOKEN_TIMEOUT_FRAMES (submission dropped before a handler saw
+ *   it) fails with ERR_TIMEOUT. Pooled results are only valid until the callback returns; copy what
+ *   you keep (async callers such as KADI tools should stay on submit()).
+ *   Layout must match Code/Game/Framework/CallbackResultRing.hpp.
+ *
  * Usage Example:
  * ```javascript
  * const commandQueue = new CommandQueue();
@@ -51,6 +72,58 @@
  * console.log('Available command types:', types);
  * ```
  */
+
+/**
+ * Opcodes for CommandQueue.submitTyped() - mirrors eTypedCommand in TypedCommandBuffer.hpp
+ */
+export const TypedCommand = Object.freeze({
+    ENTITY_UPDATE_POSITION:    1,   // values: x, y, z
+    ENTITY_MOVE_BY:            2,   // values: dx, dy, dz
+    ENTITY_UPDATE_ORIENTATION: 3,   // values: yaw, pitch, roll
+    ENTITY_UPDATE_COLOR:       4,   // values: r, g, b, a
+    CAMERA_UPDATE:             5,   // values: posX, posY, posZ, yaw, pitch, roll
+    CAMERA_UPDATE_POSITION:    6,   // values: x, y, z
+    CAMERA_UPDATE_ORIENTATION: 7,   // values: yaw, pitch, roll
+    CAMERA_MOVE_BY:            8,   // values: dx, dy, dz
+    AUDIO_UPDATE_3D_POSITION:  9,   // values: x, y, z
+    FLUSHED_RECORDS:           10   // Written by submitTyped() only; targetId: records sent as typed.flush
+});
+
+const TYPED_BUFFER_VERSION      = 1;
+const TYPED_HEADER_BYTES        = 16;
+const TYPED_RECORD_BYTES        = 48;
+const TYPED_HEADER_RECORD_COUNT = 1;
+const TYPED_HEADER_CAPACITY     = 2;
+const TYPED_HEADER_OVERFLOW     = 3;
+const TYPED_RECORD_VALUES       = 8;     // typed.flush: opcode, targetId, v0..v5 per record
+
+/**
+ * Record kinds of the structured result ring - mirrors eCallbackResultKind in CallbackResultRing.hpp
+ */
+export const ResultKind = Object.freeze({
+    ERROR:        0,
+    ENTITY_LIST:  1,
+    ENTITY_QUERY: 2,
+    RAYCAST:      3,
+    MESH_TYPES:   4
+});
+
+const RESULT_RING_VERSION          = 2;
+const RESULT_HEADER_BYTES          = 32;
+const RESULT_RECORD_HEADER_BYTES   = 16;
+const RESULT_HEADER_RECORD_COUNT   = 1;
+const RESULT_HEADER_USED_BYTES     = 2;
+const RESULT_HEADER_MESH_TYPES     = 6;
+const RESULT_ENTITY_LIST_STRIDE    = 11;
+const RESULT_ENTITY_QUERY_STRIDE   = 6;
+const RESULT_ENTITY_LIST_FULL      = 1;     // ENTITY_LIST trailer flags
+const RESULT_ENTITY_LIST_HAS_MORE  = 2;
+const RESULT_ERROR_NAMES           = ['ERR_UNKNOWN', 'ERR_NOT_AVAILABLE', 'ERR_INVALID_PARAM', 'ERR_RESULT_TOO_LARGE'];
+const RESULT_TOKEN_TIMEOUT_FRAMES  = 300;   // processResultRing() calls before an unanswered token fails
+const MAX_RESULT_TOKEN             = 0x7FFFFFFF;
+const RESULT_CAMERA_TYPE_NAMES     = ['world', 'screen', 'other'];
+const INVALID_MESH_HANDLE          = 0xFFFFFFFF;
+
 export class CommandQueue
 {
     // Version tracking for hot-reload detection
@@ -70,6 +143,31 @@ export class CommandQueue
         // Callback registry for async command results
         this.callbackRegistry = new Map(); // Maps callbackId → callback function
 
+        // Typed fast path views (bound lazily to globalThis.typedCommandBuffer)
+        this.typedU32 = null;
+        this.typedF32 = null;
+        this.typedF64 = null;
+        this.typedCapacity = 0;
+
+        // Structured result ring (bound lazily to globalThis.callbackResultRing)
+        this.resultU32 = null;
+        this.resultU8 = null;
+        this.resultF64 = null;
+        this.structuredCallbacks = new Map(); // Maps resultToken → callback function
+        this.nextResultToken = 1;
+        this.resultFrame = 0;
+        this.resultTokenMarks = new Uint32Array(RESULT_TOKEN_TIMEOUT_FRAMES); // First token issued per recent frame
+        this.meshTypeNames = [];              // MeshHandle → meshType, sent once by C++
+
+        // Pooled result objects (reused every callback; see Structured Results above)
+        this.entityListResult = { success: true, version: 0, sinceVersion: 0, isFullSnapshot: true, hasMore: false, cursor: '',
+                                  entities: [], count: 0, removed: [], removedCount: 0 };
+        this.entityQueryResult = { success: true, entities: [], count: 0, totalMatches: 0 };
+        this.raycastResult = { success: true, hit: false, entityId: 0, type: '', distance: 0, point: [0, 0, 0] };
+        this.errorResult = { success: false, error: '', resultId: 0 };
+        this.entityListPool = [];
+        this.entityQueryPool = [];
+
         // Make instance globally accessible for JSEngine callback routing
         globalThis.CommandQueueAPI = this;
 
@@ -226,6 +324,491 @@ export class CommandQueue
         }
     }
 
+    /**
+     * Submit a fire-and-forget command through the typed binary buffer (no JSON, no callback)
+     *
+     * @param {number} opcode - TypedCommand opcode
+     * @param {number} targetId - Entity / camera / sound ID
+     * @param {number} [v0..v5] - Opcode-specific float arguments (see TypedCommand)
+     * @returns {boolean} true if queued; false if unavailable or full (caller should use submit())
+     */
+    submitTyped(opcode, targetId, v0 = 0, v1 = 0, v2 = 0, v3 = 0, v4 = 0, v5 = 0)
+    {
+        if (this.typedU32 === null && !this._bindTypedBuffer())
+        {
+            return false;
+        }
+
+        const u32 = this.typedU32;
+        let count = u32[TYPED_HEADER_RECORD_COUNT];
+        if (count >= this.typedCapacity)
+        {
+            if (!this._flushTypedRecords(count))
+            {
+                u32[TYPED_HEADER_OVERFLOW]++;
+                return false;
+            }
+            count = u32[TYPED_HEADER_RECORD_COUNT];
+        }
+
+        this._writeTypedRecord(count, opcode, targetId, v0, v1, v2, v3, v4, v5);
+        u32[TYPED_HEADER_RECORD_COUNT] = count + 1;
+        return true;
+    }
+
+    /**
+     * @private
+     */
+    _writeTypedRecord(index, opcode, targetId, v0, v1, v2, v3, v4, v5)
+    {
+        const byteOffset = TYPED_HEADER_BYTES + index * TYPED_RECORD_BYTES;
+        const u32Index   = byteOffset >> 2;
+        const f32        = this.typedF32;
+
+        this.typedU32[u32Index] = opcode;
+        this.typedF64[(byteOffset + 8) >> 3] = targetId;
+        f32[u32Index + 4] = v0;
+        f32[u32Index + 5] = v1;
+        f32[u32Index + 6] = v2;
+        f32[u32Index + 7] = v3;
+        f32[u32Index + 8] = v4;
+        f32[u32Index + 9] = v5;
+    }
+
+    /**
+     * Send the records of a full buffer as one typed.flush command and restart the buffer with a
+     * FLUSHED_RECORDS marker holding the running total for this frame. C++ queues the flushed
+     * records and applies them when it reaches the marker, i.e. before everything written after it.
+     * Buffer overflow is rare, so the JSON cost is only paid then.
+     * @returns {boolean} false if the flush could not be submitted (buffer left unchanged)
+     * @private
+     */
+    _flushTypedRecords(count)
+    {
+        if (this.typedCapacity < 2 || !this.cppCommandQueue || !this.cppCommandQueue.submit)
+        {
+            return false;
+        }
+
+        const u32 = this.typedU32;
+        const f32 = this.typedF32;
+        const f64 = this.typedF64;
+
+        // A marker from an earlier flush this frame stays out of the payload; its total carries over
+        const hasMarker = u32[TYPED_HEADER_BYTES >> 2] === TypedCommand.FLUSHED_RECORDS;
+        const first = hasMarker ? 1 : 0;
+        const flushedBefore = hasMarker ? f64[(TYPED_HEADER_BYTES + 8) >> 3] : 0;
+
+        const records = new Array((count - first) * TYPED_RECORD_VALUES);
+        let out = 0;
+        for (let i = first; i < count; i++)
+        {
+            const byteOffset = TYPED_HEADER_BYTES + i * TYPED_RECORD_BYTES;
+            const u32Index   = byteOffset >> 2;
+
+            records[out++] = u32[u32Index];
+            records[out++] = f64[(byteOffset + 8) >> 3];
+            for (let v = 0; v < 6; v++)
+            {
+                records[out++] = f32[u32Index + 4 + v];
+            }
+        }
+
+        try
+        {
+            this.cppCommandQueue.submit('typed.flush', JSON.stringify({ records }), 'command-queue');
+        }
+        catch (error)
+        {
+            console.log(`CommandQueue: ERROR - typed.flush exception: ${error.message}`);
+            return false;
+        }
+
+        this._writeTypedRecord(0, TypedCommand.FLUSHED_RECORDS, flushedBefore + count - first, 0, 0, 0, 0, 0, 0);
+        u32[TYPED_HEADER_RECORD_COUNT] = 1;
+        return true;
+    }
+
+    /**
+     * Bind typed array views to the C++-owned ArrayBuffer
+     * @returns {boolean} true if the typed fast path is usable
+     * @private
+     */
+    _bindTypedBuffer()
+    {
+        const buffer = globalThis.typedCommandBuffer;
+        if (!(buffer instanceof ArrayBuffer) || buffer.byteLength < TYPED_HEADER_BYTES)
+        {
+            return false;
+        }
+
+        const u32 = new Uint32Array(buffer);
+        if (u32[0] !== TYPED_BUFFER_VERSION)
+        {
+            console.log(`CommandQueue: typedCommandBuffer version ${u32[0]} != ${TYPED_BUFFER_VERSION}, typed fast path disabled`);
+            return false;
+        }
+
+        this.typedU32      = u32;
+        this.typedF32      = new Float32Array(buffer);
+        this.typedF64      = new Float64Array(buffer);
+        this.typedCapacity = u32[TYPED_HEADER_CAPACITY];
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------------
+    // Structured Results (binary result ring)
+    //----------------------------------------------------------------------------------------------------
+
+    /**
+     * Submit a query whose result is delivered through the binary result ring
+     * Falls back to submit() (JSON result, same shape, not pooled) when the ring is unavailable.
+     *
+     * @param {string} type - Command type (handler must support resultToken, see file header)
+     * @param {Object} payload - Command payload
+     * @param {string} agentId - Identifier of the submitting agent/system
+     * @param {Function} callback - Receives a pooled result object, valid until it returns
+     * @returns {number} resultToken (0 if submission failed)
+     */
+    submitStructured(type, payload, agentId, callback)
+    {
+        // The ring has one consumer: JSEngine drains it through globalThis.CommandQueueAPI
+        const owner = globalThis.CommandQueueAPI;
+        if (owner && owner !== this)
+        {
+            return owner.submitStructured(type, payload, agentId, callback);
+        }
+
+        // Anything submit() would reject goes through submit() so the callback still sees the error
+        const isValid = typeof callback === 'function' && typeof type === 'string' && type !== '' &&
+                        typeof agentId === 'string' && agentId !== '' &&
+                        (payload === null || payload === undefined || (typeof payload === 'object' && !Array.isArray(payload)));
+
+        if (!isValid || !this.cppCommandQueue || !this.cppCommandQueue.submit ||
+            (this.resultU32 === null && !this._bindResultRing()))
+        {
+            return this.submit(type, payload, agentId, callback);
+        }
+
+        const token = this.nextResultToken;
+        this.nextResultToken = (token >= MAX_RESULT_TOKEN) ? 1 : token + 1;
+
+        // The ring record is the only reply: no C++ callback is attached, so a success costs no
+        // CallbackQueue entry. The token goes in front of the serialized payload (no object copy).
+        const payloadJson = JSON.stringify(payload || {});
+        const tokenJson = (payloadJson.length > 2)
+            ? `{"resultToken":${token},${payloadJson.slice(1)}`
+            : `{"resultToken":${token}}`;
+
+        this.structuredCallbacks.set(token, callback);
+        try
+        {
+            this.cppCommandQueue.submit(type, tokenJson, agentId);
+        }
+        catch (error)
+        {
+            this._failStructured(token, error.message);
+            return 0;
+        }
+        return token;
+    }
+
+    /**
+     * Deliver an error to a structured callback that is still waiting (no-op once settled)
+     * @private
+     */
+    _failStructured(token, errorMessage)
+    {
+        const callback = this.structuredCallbacks.get(token);
+        if (!callback)
+        {
+            return;
+        }
+        this.structuredCallbacks.delete(token);
+
+        const result = this.errorResult;
+        result.error = errorMessage || RESULT_ERROR_NAMES[0];
+        try
+        {
+            callback(result);
+        }
+        catch (error)
+        {
+            console.log(`CommandQueue: Error executing structured callback ${token}: ${error.message}`);
+        }
+    }
+
+    /**
+     * Decode every record C++ published this frame and run the matching callbacks
+     * Called by JSEngine.processCallbacks() before the CallbackQueue is drained.
+     */
+    processResultRing()
+    {
+        if (this.resultU32 === null && !this._bindResultRing())
+        {
+            return;
+        }
+
+        const u32 = this.resultU32;
+        const recordCount = u32[RESULT_HEADER_RECORD_COUNT];
+        const usedBytes = u32[RESULT_HEADER_USED_BYTES];
+
+        let offset = RESULT_HEADER_BYTES;
+        const end = RESULT_HEADER_BYTES + usedBytes;
+
+        for (let i = 0; i < recordCount && offset + RESULT_RECORD_HEADER_BYTES <= end; i++)
+        {
+            const base = offset >> 2;
+            const token = u32[base];
+            const kind = u32[base + 1];
+            const count = u32[base + 2];
+            const byteLength = u32[base + 3];
+            const valueIndex = (offset + RESULT_RECORD_HEADER_BYTES) >> 3;
+
+            offset += RESULT_RECORD_HEADER_BYTES + byteLength;
+
+            if (kind === ResultKind.MESH_TYPES)
+            {
+                this._decodeMeshTypes(token, count, offset - byteLength);
+                continue;
+            }
+
+            const callback = this.structuredCallbacks.get(token);
+            if (!callback)
+            {
+                continue;
+            }
+            this.structuredCallbacks.delete(token);
+
+            try
+            {
+                callback(this._decodeResult(kind, count, valueIndex));
+            }
+            catch (error)
+            {
+                console.log(`CommandQueue: Error executing structured callback ${token}: ${error.message}`);
+            }
+        }
+
+        // Consumed: C++ appends from the start again; report the name cache so a reload resyncs it
+        u32[RESULT_HEADER_RECORD_COUNT] = 0;
+        u32[RESULT_HEADER_USED_BYTES] = 0;
+        u32[RESULT_HEADER_MESH_TYPES] = this.meshTypeNames.length;
+
+        this._expireStructured();
+    }
+
+    /**
+     * Fail tokens issued RESULT_TOKEN_TIMEOUT_FRAMES ago that never got a record (the submission was
+     * dropped before a handler saw it). Tokens are inserted in increasing order, so the walk stops
+     * at the first recent one.
+     * @private
+     */
+    _expireStructured()
+    {
+        const markIndex = this.resultFrame % RESULT_TOKEN_TIMEOUT_FRAMES;
+        const staleBefore = this.resultTokenMarks[markIndex];
+        this.resultTokenMarks[markIndex] = this.nextResultToken;
+        this.resultFrame++;
+
+        // staleBefore 0: fewer frames than the timeout so far; above the next token: tokens wrapped
+        if (staleBefore === 0 || staleBefore > this.nextResultToken || this.structuredCallbacks.size === 0)
+        {
+            return;
+        }
+
+        for (const token of this.structuredCallbacks.keys())
+        {
+            if (token >= staleBefore)
+            {
+                break;
+            }
+            this._failStructured(token, 'ERR_TIMEOUT');
+        }
+    }
+
+    /**
+     * Fill the pooled result object for one record
+     * @private
+     */
+    _decodeResult(kind, count, valueIndex)
+    {
+        const f64 = this.resultF64;
+
+        switch (kind)
+        {
+            case ResultKind.ENTITY_LIST:
+            {
+                const result = this.entityListResult;
+                const entities = result.entities;
+                entities.length = count;
+
+                for (let i = 0; i < count; i++)
+                {
+                    const v = valueIndex + i * RESULT_ENTITY_LIST_STRIDE;
+                    let entity = this.entityListPool[i];
+                    if (entity === undefined)
+                    {
+                        entity = { entityId: 0, type: '', position: [0, 0, 0], orientation: [0, 0, 0], scale: 1, color: [0, 0, 0, 0], cameraType: '' };
+                        this.entityListPool[i] = entity;
+                    }
+
+                    const rgba = f64[v + 8];
+                    entity.entityId = f64[v];
+                    entity.position[0] = f64[v + 1];
+                    entity.position[1] = f64[v + 2];
+                    entity.position[2] = f64[v + 3];
+                    entity.orientation[0] = f64[v + 4];
+                    entity.orientation[1] = f64[v + 5];
+                    entity.orientation[2] = f64[v + 6];
+                    entity.scale = f64[v + 7];
+                    entity.color[0] = rgba & 0xFF;
+                    entity.color[1] = (rgba >>> 8) & 0xFF;
+                    entity.color[2] = (rgba >>> 16) & 0xFF;
+                    entity.color[3] = (rgba >>> 24) & 0xFF;
+                    entity.type = this._meshTypeName(f64[v + 9]);
+                    entity.cameraType = RESULT_CAMERA_TYPE_NAMES[f64[v + 10]] || 'other';
+                    entities[i] = entity;
+                }
+
+                // Page trailer, then the removed IDs (same page fields as the JSON result)
+                const t = valueIndex + count * RESULT_ENTITY_LIST_STRIDE;
+                const flags = f64[t + 2];
+                const removedCount = f64[t + 5];
+                const removed = result.removed;
+                removed.length = removedCount;
+                for (let i = 0; i < removedCount; i++)
+                {
+                    removed[i] = f64[t + 6 + i];
+                }
+
+                result.version = f64[t];
+                result.sinceVersion = f64[t + 1];
+                result.isFullSnapshot = (flags & RESULT_ENTITY_LIST_FULL) !== 0;
+                result.hasMore = (flags & RESULT_ENTITY_LIST_HAS_MORE) !== 0;
+                result.cursor = result.hasMore ? `${f64[t + 3]}.${f64[t + 4]}` : '';
+                result.count = count;
+                result.removedCount = removedCount;
+                return result;
+            }
+
+            case ResultKind.ENTITY_QUERY:
+            {
+                const result = this.entityQueryResult;
+                const entities = result.entities;
+                entities.length = count;
+
+                for (let i = 0; i < count; i++)
+                {
+                    const v = valueIndex + i * RESULT_ENTITY_QUERY_STRIDE;
+                    let entity = this.entityQueryPool[i];
+                    if (entity === undefined)
+                    {
+                        entity = { entityId: 0, type: '', position: [0, 0, 0], distance: 0 };
+                        this.entityQueryPool[i] = entity;
+                    }
+
+                    entity.entityId = f64[v];
+                    entity.position[0] = f64[v + 1];
+                    entity.position[1] = f64[v + 2];
+                    entity.position[2] = f64[v + 3];
+                    entity.distance = f64[v + 4];
+                    entity.type = this._meshTypeName(f64[v + 5]);
+                    entities[i] = entity;
+                }
+
+                result.count = count;
+                result.totalMatches = f64[valueIndex + count * RESULT_ENTITY_QUERY_STRIDE];
+                return result;
+            }
+
+            case ResultKind.RAYCAST:
+            {
+                const result = this.raycastResult;
+                result.hit = count > 0;
+                if (result.hit)
+                {
+                    result.entityId = f64[valueIndex];
+                    result.distance = f64[valueIndex + 1];
+                    result.point[0] = f64[valueIndex + 2];
+                    result.point[1] = f64[valueIndex + 3];
+                    result.point[2] = f64[valueIndex + 4];
+                    result.type = this._meshTypeName(f64[valueIndex + 5]);
+                }
+                return result;
+            }
+
+            default:
+            {
+                const result = this.errorResult;
+                const code = (kind === ResultKind.ERROR && count > 0) ? f64[valueIndex] : 0;
+                result.error = RESULT_ERROR_NAMES[code] || RESULT_ERROR_NAMES[0];
+                return result;
+            }
+        }
+    }
+
+    /**
+     * @private
+     */
+    _meshTypeName(handle)
+    {
+        if (handle === INVALID_MESH_HANDLE)
+        {
+            return '';
+        }
+        const name = this.meshTypeNames[handle];
+        return (name === undefined) ? '' : name;
+    }
+
+    /**
+     * Cache meshType names for handles firstHandle.. ('\0'-terminated ASCII, decoded once per handle)
+     * @private
+     */
+    _decodeMeshTypes(firstHandle, nameCount, byteOffset)
+    {
+        const u8 = this.resultU8;
+        let index = byteOffset;
+
+        for (let n = 0; n < nameCount; n++)
+        {
+            let name = '';
+            while (u8[index] !== 0)
+            {
+                name += String.fromCharCode(u8[index]);
+                index++;
+            }
+            index++;
+            this.meshTypeNames[firstHandle + n] = name;
+        }
+    }
+
+    /**
+     * Bind typed array views to the C++-owned result ring
+     * @returns {boolean} true if structured results are usable
+     * @private
+     */
+    _bindResultRing()
+    {
+        const buffer = globalThis.callbackResultRing;
+        if (!(buffer instanceof ArrayBuffer) || buffer.byteLength < RESULT_HEADER_BYTES)
+        {
+            return false;
+        }
+
+        const u32 = new Uint32Array(buffer);
+        if (u32[0] !== RESULT_RING_VERSION)
+        {
+            console.log(`CommandQueue: callbackResultRing version ${u32[0]} != ${RESULT_RING_VERSION}, structured results disabled`);
+            return false;
+        }
+
+        this.resultU32 = u32;
+        this.resultU8  = new Uint8Array(buffer);
+        this.resultF64 = new Float64Array(buffer);
+        return true;
+    }
+
     //----------------------------------------------------------------------------------------------------
     // Handler Registration (for future JS-side handlers)
     //----------------------------------------------------------------------------------------------------
@@ -353,6 +936,10 @@ export class CommandQueue
             available: this.isAvailable(),
             cppInterfaceType: typeof this.cppCommandQueue,
             pendingCallbacks: this.callbackRegistry.size,
+            typedFastPath: this.typedU32 !== null,
+            typedCapacity: this.typedCapacity,
+            structuredResults: this.resultU32 !== null,
+            pendingStructured: this.structuredCallbacks.size,
             hasMethods: this.cppCommandQueue ? {
                 submit: typeof this.cppCommandQueue.submit === 'function',
                 registerHandler: typeof this.cppCommandQueue.registerHandler === 'function',
@@ -368,5 +955,7 @@ export default CommandQueue;
 
 // Export to globalThis for hot-reload detection
 globalThis.CommandQueue = CommandQueue;
+globalThis.TypedCommand = TypedCommand;
+globalThis.ResultKind = ResultKind;
 
 console.log('CommandQueue: GenericCommand facade loaded (Interface Layer)');
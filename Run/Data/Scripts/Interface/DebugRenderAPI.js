@@ -25,6 +25,8 @@
  *                 debug_render.add_world_arrow, debug_render.add_world_text,
  *                 debug_render.add_billboard_text, debug_render.add_world_basis
  * Screen Geometry: debug_render.add_screen_text, debug_render.add_message
+ * Batched / Retained: debug_render.add_batch, debug_render.show_layer, debug_render.hide_layer,
+ *                     debug_render.clear_layer, debug_render.list_layers
  */
 export class DebugRenderAPI
 {
@@ -246,6 +248,65 @@ export class DebugRenderAPI
         return this._submit('debug_render.add_message', { text, duration, r, g, b, a });
     }
 
+    //----------------------------------------------------------------------------------------------------
+    // Batched and Retained Methods
+    //----------------------------------------------------------------------------------------------------
+
+    /**
+     * Submit many primitives as one command (packed arrays, one JSON parse)
+     * Lines/points with duration 0 and USE_DEPTH are merged into a single draw; with options.layer they
+     * replace (or, with options.append, extend) that retained layer, drawn every frame until cleared.
+     * @param {Object} batch - { lines?, points?, arrows?, texts? }
+     *   lines/arrows: { positions: [x1,y1,z1,x2,y2,z2, ...], colors?: [r,g,b,a, ...], radius? }
+     *   points: { positions: [x,y,z, ...], colors?, radius? }
+     *   texts: { positions: [x,y,z, ...], strings: [...], colors?, textHeight? } (billboards)
+     * @param {Object} [options] - { layer?, append?, duration?, mode?, r?, g?, b?, a? } (default color)
+     * @returns {Promise<Object>} { lines, points, arrows, texts, merged, layer?, layerVertexCount? }
+     */
+    async addBatch(batch, options = {})
+    {
+        return this._submit('debug_render.add_batch', { ...options, ...batch });
+    }
+
+    /**
+     * Show a retained layer
+     * @param {string} layer - Layer id given to addBatch
+     * @returns {Promise<Object>}
+     */
+    async showLayer(layer)
+    {
+        return this._submit('debug_render.show_layer', { layer });
+    }
+
+    /**
+     * Hide a retained layer (keeps its GPU buffer)
+     * @param {string} layer - Layer id given to addBatch
+     * @returns {Promise<Object>}
+     */
+    async hideLayer(layer)
+    {
+        return this._submit('debug_render.hide_layer', { layer });
+    }
+
+    /**
+     * Delete a retained layer and release its GPU buffer
+     * @param {string} layer - Layer id given to addBatch
+     * @returns {Promise<Object>}
+     */
+    async clearLayer(layer)
+    {
+        return this._submit('debug_render.clear_layer', { layer });
+    }
+
+    /**
+     * List retained layers
+     * @returns {Promise<Object>} { layers: [{ id, isVisible, vertexCount, gpuBytes }] }
+     */
+    async listLayers()
+    {
+        return this._submit('debug_render.list_layers', {});
+    }
+
     //----------------------------------------------------------------------------------------------------
     // Utility Methods
     //----------------------------------------------------------------------------------------------------
@@ -279,7 +340,7 @@ export class DebugRenderAPI
      * Submit a command through the GenericCommand pipeline with Promise wrapping
      * @param {string} commandType - GenericCommand type (e.g. 'debug_render.add_world_line')
      * @param {Object} params - Command parameters
-     * @returns {Promise<void>} Resolves on success, rejects on failure
+     * @returns {Promise<Object>} Resolves with the handler result on success, rejects on failure
      * @private
      */
     async _submit(commandType, params)
@@ -299,7 +360,7 @@ export class DebugRenderAPI
                 'debug-render-api',
                 (result) =>
                 {
-                    if (result && result.success) { resolve(); }
+                    if (result && result.success) { resolve(result); }
                     else { reject(new Error(result?.error || `${commandType} failed`)); }
                 }
             );
@@ -23,13 +23,22 @@
  * - +Y = left
  * - +Z = up
  *
+ * Per-frame Updates (coalesced):
+ * - updatePosition / updateOrientation / updateColor only stage the latest value per entity and
+ *   resolve immediately. JSEngine calls flushTransforms() once per frame, which sends the staged
+ *   values through the typed binary fast path (CommandQueue.submitTyped) or, as a fallback, one
+ *   entity.update_transforms SoA command for the whole frame.
+ * - moveBy folds into a staged position when one exists; otherwise it is sent immediately.
+ *
  * GenericCommand Operations:
  * - create_mesh(meshType, properties) → callback(entityId)
  * - entity.update_position(entityId, x, y, z) → callback(success)
  * - entity.move_by(entityId, dx, dy, dz) → callback(success)
  * - entity.update_orientation(entityId, yaw, pitch, roll) → callback(success)
  * - entity.update_color(entityId, r, g, b, a) → callback(success)
+ * - entity.update_transforms({ids, mask, positions, orientations, colors}) → fire-and-forget batch
  * - entity.destroy(entityId) → callback(success)
+ * - entity.set_worker_behavior(entityId, behavior) → callback(shardIndex) (JSWorkerPool)
  *
  * Usage Example:
  * ```javascript
@@ -48,10 +57,24 @@
  * });
  * ```
  */
+import { TypedCommand } from './CommandQueue.js';
+
+// flushTransforms() mask bits (must match App.cpp "entity.update_transforms")
+const TRANSFORM_POSITION    = 0x1;
+const TRANSFORM_ORIENTATION = 0x2;
+const TRANSFORM_COLOR       = 0x4;
+
+// Staged transforms are shared by every EntityAPI instance (and survive hot-reload) so a single
+// per-frame flush from JSEngine covers all callers
+if (!(globalThis.EntityPendingTransforms instanceof Map))
+{
+    globalThis.EntityPendingTransforms = new Map(); // entityId → { mask, position, orientation, color }
+}
+
 export class EntityAPI
 {
     // Version tracking for hot-reload detection
-    static version = 6; // FULLY FLATTENED API - All methods now use individual primitive arguments (createMesh, updatePosition, updateOrientation, updateColor, moveBy)
+    static version = 7; // Per-frame transform coalescing (flushTransforms → typed fast path / entity.update_transforms)
 
     constructor()
     {
@@ -62,6 +85,9 @@ export class EntityAPI
             return globalThis.EntityAPI;
         }
 
+        // Staged per-frame transform updates (shared map, flushed by EntityAPI.flushTransforms)
+        this.pendingTransforms = globalThis.EntityPendingTransforms;
+
         // Make instance globally accessible for JSEngine callback routing
         globalThis.EntityAPI = this;
 
@@ -134,11 +160,11 @@ export class EntityAPI
 
     /**
      * Update entity position (absolute)
-     * Uses CommandQueue.submit("entity.update_position") via GenericCommand pipeline.
+     * Staged until flushTransforms(); the last value written this frame wins.
      *
      * @param {number} entityId - Entity ID to update
      * @param {Array<number>} position - [x, y, z] new position (X-forward, Y-left, Z-up)
-     * @returns {Promise<void>} Resolves on success, rejects on failure
+     * @returns {Promise<void>} Resolves once staged
      */
     async updatePosition(entityId, position)
     {
@@ -148,12 +174,15 @@ export class EntityAPI
             return;
         }
 
-        return this._submit('entity.update_position', { entityId, x: position[0], y: position[1], z: position[2] });
+        const pending = this._stageTransform(entityId, TRANSFORM_POSITION);
+        pending.position[0] = position[0];
+        pending.position[1] = position[1];
+        pending.position[2] = position[2];
     }
 
     /**
      * Move entity by relative delta
-     * Uses CommandQueue.submit("entity.move_by") via GenericCommand pipeline.
+     * Folds into a staged position if one exists, otherwise submits entity.move_by immediately.
      *
      * @param {number} entityId - Entity ID to move
      * @param {Array<number>} delta - [dx, dy, dz] movement delta (X-forward, Y-left, Z-up)
@@ -167,16 +196,27 @@ export class EntityAPI
             return;
         }
 
+        const pending = this.pendingTransforms.get(entityId);
+        if (pending && (pending.mask & TRANSFORM_POSITION))
+        {
+            pending.position[0] += delta[0];
+            pending.position[1] += delta[1];
+            pending.position[2] += delta[2];
+            return;
+        }
+
+        if (this._submitTyped(TypedCommand.ENTITY_MOVE_BY, entityId, delta[0], delta[1], delta[2])) return;
+
         return this._submit('entity.move_by', { entityId, dx: delta[0], dy: delta[1], dz: delta[2] });
     }
 
     /**
      * Update entity orientation
-     * Uses CommandQueue.submit("entity.update_orientation") via GenericCommand pipeline.
+     * Staged until flushTransforms(); the last value written this frame wins.
      *
      * @param {number} entityId - Entity ID to update
      * @param {Array<number>} orientation - [yaw, pitch, roll] in degrees
-     * @returns {Promise<void>} Resolves on success, rejects on failure
+     * @returns {Promise<void>} Resolves once staged
      */
     async updateOrientation(entityId, orientation)
     {
@@ -186,16 +226,19 @@ export class EntityAPI
             return;
         }
 
-        return this._submit('entity.update_orientation', { entityId, yaw: orientation[0], pitch: orientation[1], roll: orientation[2] });
+        const pending = this._stageTransform(entityId, TRANSFORM_ORIENTATION);
+        pending.orientation[0] = orientation[0];
+        pending.orientation[1] = orientation[1];
+        pending.orientation[2] = orientation[2];
     }
 
     /**
      * Update entity color
-     * Uses CommandQueue.submit("entity.update_color") via GenericCommand pipeline.
+     * Staged until flushTransforms(); the last value written this frame wins.
      *
      * @param {number} entityId - Entity ID to update
      * @param {Array<number>} color - [r, g, b, a] color (0-255)
-     * @returns {Promise<void>} Resolves on success, rejects on failure
+     * @returns {Promise<void>} Resolves once staged
      */
     async updateColor(entityId, color)
     {
@@ -205,7 +248,11 @@ export class EntityAPI
             return;
         }
 
-        return this._submit('entity.update_color', { entityId, r: color[0], g: color[1], b: color[2], a: color[3] });
+        const pending = this._stageTransform(entityId, TRANSFORM_COLOR);
+        pending.color[0] = color[0];
+        pending.color[1] = color[1];
+        pending.color[2] = color[2];
+        pending.color[3] = color[3];
     }
 
     /**
@@ -217,13 +264,145 @@ export class EntityAPI
      */
     async destroyEntity(entityId)
     {
+        this.pendingTransforms.delete(entityId);
         return this._submit('entity.destroy', { entityId });
     }
 
+    /**
+     * Hand an entity's behavior to the C++ JSWorkerPool (sharded worker isolates)
+     * The shard runs Workers/ShardRuntime.js for it; stop driving the entity from this isolate.
+     *
+     * @param {number} entityId - Entity ID to hand off
+     * @param {string} behaviorType - 'rotate-yaw', 'rotate-pitch-roll', 'pulse-color', or 'none' to release
+     * @returns {Promise<number>} Resolves with the owning shard index, rejects if the pool is disabled
+     */
+    async setWorkerBehavior(entityId, behaviorType)
+    {
+        this.pendingTransforms.delete(entityId);
+        return this._submit('entity.set_worker_behavior', { entityId, behavior: behaviorType });
+    }
+
+    //----------------------------------------------------------------------------------------------------
+    // Per-frame Transform Batching
+    //----------------------------------------------------------------------------------------------------
+
+    /**
+     * Send every staged transform update for this frame (called once per frame by JSEngine)
+     * Typed fast path first; whatever does not fit goes out as one entity.update_transforms command.
+     *
+     * @returns {number} Number of entities flushed
+     */
+    static flushTransforms()
+    {
+        const pendingTransforms = globalThis.EntityPendingTransforms;
+        const entityCount       = pendingTransforms.size;
+        if (entityCount === 0)
+        {
+            return 0;
+        }
+
+        const commandQueue = globalThis.CommandQueueAPI;
+        if (!commandQueue || !commandQueue.isAvailable())
+        {
+            pendingTransforms.clear();
+            return 0;
+        }
+
+        const typedAvailable = typeof commandQueue.submitTyped === 'function';
+        let batch = null;
+
+        for (const [entityId, pending] of pendingTransforms)
+        {
+            if (typedAvailable && EntityAPI._flushTyped(commandQueue, entityId, pending))
+            {
+                continue;
+            }
+
+            if (!batch)
+            {
+                batch = { ids: [], mask: [], positions: [], orientations: [], colors: [] };
+            }
+
+            batch.ids.push(entityId);
+            batch.mask.push(pending.mask);
+            batch.positions.push(pending.position[0], pending.position[1], pending.position[2]);
+            batch.orientations.push(pending.orientation[0], pending.orientation[1], pending.orientation[2]);
+            batch.colors.push(pending.color[0], pending.color[1], pending.color[2], pending.color[3]);
+        }
+
+        pendingTransforms.clear();
+
+        if (batch)
+        {
+            commandQueue.submit('entity.update_transforms', batch, 'entity-api');
+        }
+
+        return entityCount;
+    }
+
+    /**
+     * Write one staged entity through the typed buffer
+     * @returns {boolean} false if the buffer filled up (caller batches the entity as JSON instead)
+     * @private
+     */
+    static _flushTyped(commandQueue, entityId, pending)
+    {
+        const mask = pending.mask;
+
+        if ((mask & TRANSFORM_POSITION) &&
+            !commandQueue.submitTyped(TypedCommand.ENTITY_UPDATE_POSITION, entityId, pending.position[0], pending.position[1], pending.position[2]))
+        {
+            return false;
+        }
+
+        if ((mask & TRANSFORM_ORIENTATION) &&
+            !commandQueue.submitTyped(TypedCommand.ENTITY_UPDATE_ORIENTATION, entityId, pending.orientation[0], pending.orientation[1], pending.orientation[2]))
+        {
+            return false;
+        }
+
+        if ((mask & TRANSFORM_COLOR) &&
+            !commandQueue.submitTyped(TypedCommand.ENTITY_UPDATE_COLOR, entityId, pending.color[0], pending.color[1], pending.color[2], pending.color[3]))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Get (or create) the staged transform entry for an entity and mark a field dirty
+     * @private
+     */
+    _stageTransform(entityId, fieldBit)
+    {
+        let pending = this.pendingTransforms.get(entityId);
+        if (!pending)
+        {
+            pending = { mask: 0, position: [0, 0, 0], orientation: [0, 0, 0], color: [255, 255, 255, 255] };
+            this.pendingTransforms.set(entityId, pending);
+        }
+
+        pending.mask |= fieldBit;
+        return pending;
+    }
+
     //----------------------------------------------------------------------------------------------------
     // Private Helper
     //----------------------------------------------------------------------------------------------------
 
+    /**
+     * Submit a fire-and-forget update through the typed binary buffer
+     * @returns {boolean} true if queued; false to fall back to _submit()
+     * @private
+     */
+    _submitTyped(opcode, targetId, v0, v1, v2, v3, v4, v5)
+    {
+        const commandQueue = globalThis.CommandQueueAPI;
+        return !!commandQueue && typeof commandQueue.submitTyped === 'function' &&
+            commandQueue.submitTyped(opcode, targetId, v0, v1, v2, v3, v4, v5);
+    }
+
     /**
      * Submit a command through the GenericCommand pipeline with Promise wrapping
      * @param {string} commandType - GenericCommand type (e.g. 'entity.update_position')
@@ -277,6 +456,7 @@ export class EntityAPI
         return {
             available: this.isAvailable(),
             pipeline: 'GenericCommand',
+            pendingTransforms: this.pendingTransforms.size,
             commandQueueAvailable: globalThis.CommandQueueAPI !== undefined
         };
     }
@@ -288,4 +468,7 @@ export default EntityAPI;
 // Export to globalThis for hot-reload detection
 globalThis.EntityAPI = EntityAPI;
 
+// Per-frame flush hook used by JSEngine.render() (re-bound on hot-reload)
+globalThis.flushEntityTransforms = () => EntityAPI.flushTransforms();
+
 console.log('EntityAPI: High-level entity wrapper loaded (Phase 2 Interface Layer)');
@@ -4,6 +4,7 @@
 
 // === Global Setup ===
 import { EventBus } from './Event/EventBus.js';  // Event system for dependency inversion
+import { hotReloadRegistry } from './core/HotReloadRegistry.js';
 
 /**
  * JSEngine - Core JavaScript engine with system registration framework
@@ -34,7 +35,7 @@ export class JSEngine {
         this.renderSystems = [];
         this.pendingOperations = [];
 
-        // C++ Hot-Reload System (handled by C++ FileWatcher + ScriptReloader)
+        // C++ Hot-Reload System (ScriptHotReloader re-runs changed modules, or the Engine FileWatcher)
         this.hotReloadEnabled = true; // C++ hot-reload system availability flag
 
         // Event System (Phase 4.5: Dependency Inversion Principle)
@@ -220,7 +221,10 @@ export class JSEngine {
 
     /**
      * Check for hot-reloads and upgrade system instances automatically
-     * Called every frame to detect when C++ has reloaded module files
+     * Called every frame: with the Engine ScriptReloader a re-run module only republishes
+     * its class on globalThis, so the constructor comparison is the only signal. C++
+     * ScriptHotReloader also calls it right after re-running modules, so upgraded methods
+     * are live before the next frame
      */
     checkForHotReloads() {
         for (const [id, system] of this.registeredSystems) {
@@ -228,9 +232,9 @@ export class JSEngine {
             if (!instance) continue; // Skip legacy systems
 
             try {
-                // Get the class name and try to find it in global scope
+                // Registered classes first (hot-reloadable modules), then the legacy global scope
                 const className = instance.constructor.name;
-                const GlobalClass = globalThis[className];
+                const GlobalClass = hotReloadRegistry.getClass(className) || globalThis[className];
 
                 if (!GlobalClass) continue; // Class not in global scope
 
@@ -291,6 +295,15 @@ export class JSEngine {
      * Called at start of update() to ensure callbacks processed early in frame
      */
     processCallbacks() {
+        // Structured results (binary CallbackResultRing) need no CallbackQueue round-trip
+        if (globalThis.CommandQueueAPI && typeof globalThis.CommandQueueAPI.processResultRing === 'function') {
+            try {
+                globalThis.CommandQueueAPI.processResultRing();
+            } catch (error) {
+                console.log(`JSEngine: Error processing result ring: ${error.message}`);
+            }
+        }
+
         // Check if callbackQueue is available (exposed by CallbackQueueScriptInterface)
         if (typeof globalThis.callbackQueue === 'undefined' || !globalThis.callbackQueue) {
             // CallbackQueue not yet registered - skip processing
@@ -404,12 +417,32 @@ export class JSEngine {
             jsGameInstance.gameClock.advance(systemDeltaSeconds);
         }
 
+        // Work shedding policy from the C++ frame watchdog (JSFrameWatchdog.hpp)
+        const shedInterval = this.getShedInterval();
+        const gameDeltaSeconds = jsGameInstance.gameClock.getDeltaSeconds();
+
         // Execute all registered update systems
         for (const system of this.updateSystems) {
             if (system.enabled && system.update) {
+                // Shed systems bank their deltas and catch up when they next run
+                const isShed = this.isShedPriority(system, shedInterval);
+                let gameDelta = gameDeltaSeconds;
+                let systemDelta = systemDeltaSeconds;
+                if (isShed || system.shedGameDelta) {
+                    system.shedGameDelta = (system.shedGameDelta || 0) + gameDeltaSeconds;
+                    system.shedSystemDelta = (system.shedSystemDelta || 0) + systemDeltaSeconds;
+                    if (isShed && this.frameCount % shedInterval !== 0) {
+                        continue;
+                    }
+                    gameDelta = system.shedGameDelta;
+                    systemDelta = system.shedSystemDelta;
+                    system.shedGameDelta = 0;
+                    system.shedSystemDelta = 0;
+                }
+
                 try {
                     // Pass both gameDeltaSeconds and systemDeltaSeconds to allow systems to choose
-                    system.update(jsGameInstance.gameClock.getDeltaSeconds(), systemDeltaSeconds);
+                    system.update(gameDelta, systemDelta);
 
                 } catch (error) {
                     // Enhanced error logging with multiple fallbacks
@@ -434,9 +467,15 @@ export class JSEngine {
             return;
         }
 
+        const shedInterval = this.getShedInterval();
+
         // Execute all registered render systems
         for (const system of this.renderSystems) {
             if (system.enabled && system.render) {
+                if (this.isShedPriority(system, shedInterval) && this.frameCount % shedInterval !== 0) {
+                    continue;
+                }
+
                 try {
                     system.render();
                 } catch (error) {
@@ -451,6 +490,36 @@ export class JSEngine {
                 }
             }
         }
+
+        // Send this frame's coalesced entity transforms as one batch (EntityAPI.flushTransforms)
+        if (typeof globalThis.flushEntityTransforms === 'function') {
+            try {
+                globalThis.flushEntityTransforms();
+            } catch (error) {
+                console.log(`JSEngine: Error flushing entity transforms: ${error.message}`);
+            }
+        }
+    }
+
+    // ============================================================================
+    // WORK SHEDDING (C++ JSFrameWatchdog)
+    // ============================================================================
+
+    /**
+     * Frames between runs of shed systems (1 = no shedding)
+     * globalThis.__workShed = {level, interval, minPriority} is set by JSGameLogicJob when the
+     * watchdog changes stage: 0 none, 1 throttle, 2 reduce
+     */
+    getShedInterval() {
+        const shed = globalThis.__workShed;
+        return (shed && shed.interval > 1) ? shed.interval : 1;
+    }
+
+    /**
+     * Low-priority systems (priority >= minPriority) are the ones shed under overrun
+     */
+    isShedPriority(system, shedInterval) {
+        return shedInterval > 1 && system.priority >= globalThis.__workShed.minPriority;
     }
 
     /**
@@ -465,6 +534,7 @@ export class JSEngine {
             updateSystemCount: this.updateSystems.length,
             renderSystemCount: this.renderSystems.length,
             pendingOperations: this.pendingOperations.length,
+            workShed: globalThis.__workShed || null,
             hotReloadEnabled: this.hotReloadEnabled // C++ hot-reload system status
         };
     }
@@ -123,6 +123,7 @@ export class JSGame
         // Track versions for Player and Prop classes to detect hot-reloads
         this.playerVersion = hotReloadRegistry.getVersion('Player');
         this.propVersion = hotReloadRegistry.getVersion('Prop');
+        this.hotReloadGeneration = hotReloadRegistry.getGeneration(); // Component upgrades (GameObject.upgradeComponents)
 
         console.log('(JSGame::constructor)(end) - All components registered');
     }
@@ -463,6 +464,18 @@ export class JSGame
                     this.propVersion = newVersion;
                 }
 
+                // === HOT-RELOAD DETECTION: Component modules re-registered their classes ===
+                const hotReloadGeneration = hotReloadRegistry.getGeneration();
+                if (hotReloadGeneration !== this.hotReloadGeneration)
+                {
+                    this.playerGameObject?.upgradeComponents();
+                    for (const prop of this.propGameObjects || [])
+                    {
+                        prop?.upgradeComponents();
+                    }
+                    this.hotReloadGeneration = hotReloadGeneration;
+                }
+
                 // New component-based Player GameObject
                 if (this.playerGameObject)
                 {
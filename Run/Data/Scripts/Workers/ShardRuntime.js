@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------------------------------
+// ShardRuntime.js
+// Behavior runtime for JSWorkerPool shard isolates (classic script, NOT an ES6 module)
+//----------------------------------------------------------------------------------------------------
+
+/**
+ * ShardRuntime - Runs prop behaviors for the entities assigned to one worker isolate
+ *
+ * Loaded once per shard by Code/Game/Framework/JSWorkerPool.cpp. Shard isolates do not share
+ * anything with the main isolate: no imports, no CommandQueueAPI, no engine script interfaces.
+ * Available globals:
+ * - shardIndex / shardCount: this shard's partition (entityId % shardCount === shardIndex)
+ * - typedCommandBuffer: ArrayBuffer with the TypedCommandBuffer layout (see CommandQueue.js)
+ * - console.log: routed to the C++ log
+ * - submitCommand(type, payload): fire-and-forget GenericCommand (payload object or JSON string),
+ *   run on the main thread after the pool frame; returns false if rate limited or the queue is full.
+ *   Absent when GenericCommand.json externalQueueCapacity is 0
+ *
+ * C++ → JS contract:
+ * - ShardRuntime.assign(entityId, behaviorType, x, y, z, yaw, pitch, roll, r, g, b, a)
+ * - ShardRuntime.release(entityId)
+ * - ShardRuntime.update(deltaSeconds)   // once per pool frame
+ *
+ * Output: entity.update_orientation / entity.update_color typed records for owned entities only.
+ * Records for other entities (or non-entity opcodes) are dropped by C++ as partition violations;
+ * use submitCommand for those writes instead.
+ * Records that do not fit in the buffer are counted as overflows (there is no JSON fallback here).
+ */
+(function ()
+{
+    'use strict';
+
+    // Layout mirrors Code/Game/Framework/TypedCommandBuffer.hpp
+    const TYPED_HEADER_BYTES  = 16;
+    const TYPED_RECORD_BYTES  = 48;
+    const HEADER_RECORD_COUNT = 1;
+    const HEADER_CAPACITY     = 2;
+    const HEADER_OVERFLOW     = 3;
+
+    const ENTITY_UPDATE_ORIENTATION = 3;
+    const ENTITY_UPDATE_COLOR       = 4;
+
+    const buffer   = globalThis.typedCommandBuffer;
+    const u32      = new Uint32Array(buffer);
+    const f32      = new Float32Array(buffer);
+    const f64      = new Float64Array(buffer);
+    const capacity = u32[HEADER_CAPACITY];
+
+    function writeRecord(opcode, entityId, v0, v1, v2, v3)
+    {
+        const count = u32[HEADER_RECORD_COUNT];
+        if (count >= capacity)
+        {
+            u32[HEADER_OVERFLOW]++;
+            return false;
+        }
+
+        const byteOffset = TYPED_HEADER_BYTES + count * TYPED_RECORD_BYTES;
+        const f32Index   = (byteOffset + 16) >> 2;
+
+        u32[byteOffset >> 2]       = opcode;
+        u32[(byteOffset + 4) >> 2] = 0;
+        f64[(byteOffset + 8) >> 3] = entityId;
+        f32[f32Index]              = v0;
+        f32[f32Index + 1]          = v1;
+        f32[f32Index + 2]          = v2;
+        f32[f32Index + 3]          = v3;
+        f32[f32Index + 4]          = 0;
+        f32[f32Index + 5]          = 0;
+
+        u32[HEADER_RECORD_COUNT] = count + 1;
+        return true;
+    }
+
+    // Same rates as Component/behavior/*Behavior.js (deltaSeconds here is already in seconds)
+    const Behaviors = {
+        'rotate-yaw': (entity, deltaSeconds) =>
+        {
+            entity.yaw += 45.0 * deltaSeconds;
+            writeRecord(ENTITY_UPDATE_ORIENTATION, entity.id, entity.yaw, entity.pitch, entity.roll, 0);
+        },
+        'rotate-pitch-roll': (entity, deltaSeconds) =>
+        {
+            entity.pitch += 30.0 * deltaSeconds;
+            entity.roll += 30.0 * deltaSeconds;
+            writeRecord(ENTITY_UPDATE_ORIENTATION, entity.id, entity.yaw, entity.pitch, entity.roll, 0);
+        },
+        'pulse-color': (entity, deltaSeconds) =>
+        {
+            entity.elapsed += deltaSeconds;
+            const pulse = (Math.sin(entity.elapsed) + 1.0) * 0.5;
+            writeRecord(ENTITY_UPDATE_COLOR, entity.id,
+                Math.floor(entity.r * pulse), Math.floor(entity.g * pulse), Math.floor(entity.b * pulse), entity.a);
+        }
+    };
+
+    const entities = new Map();   // entityId → entity state
+
+    globalThis.ShardRuntime = {
+        assign(entityId, behaviorType, x, y, z, yaw, pitch, roll, r, g, b, a)
+        {
+            const behavior = Behaviors[behaviorType];
+            if (!behavior)
+            {
+                console.log(`ShardRuntime: unknown behavior '${behaviorType}' for entity ${entityId}`);
+                entities.delete(entityId);
+                return;
+            }
+
+            entities.set(entityId, {id: entityId, behavior, x, y, z, yaw, pitch, roll, r, g, b, a, elapsed: 0});
+        },
+
+        release(entityId)
+        {
+            entities.delete(entityId);
+        },
+
+        update(deltaSeconds)
+        {
+            for (const entity of entities.values())
+            {
+                entity.behavior(entity, deltaSeconds);
+            }
+        },
+
+        getCount()
+        {
+            return entities.size;
+        }
+    };
+
+    console.log(`ShardRuntime: shard ${shardIndex}/${shardCount} loaded (${capacity} typed records)`);
+})();
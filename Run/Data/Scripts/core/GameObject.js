@@ -5,6 +5,7 @@
 //----------------------------------------------------------------------------------------------------
 
 import {Component} from './Component.js';
+import {hotReloadRegistry} from './HotReloadRegistry.js';
 
 /**
  * Base GameObject class - Container for components
@@ -135,6 +136,31 @@ export class GameObject
         }
     }
 
+    /**
+     * Re-point components at their hot-reloaded class (component modules are reload boundaries)
+     * State stays on the instance; only the prototype, i.e. the methods, is replaced
+     * @returns {number} Number of components upgraded
+     */
+    upgradeComponents()
+    {
+        let upgradedCount = 0;
+        for (const [type, component] of this.components)
+        {
+            const ReloadedClass = hotReloadRegistry.getClass(component.constructor.name);
+            if (ReloadedClass && component.constructor !== ReloadedClass)
+            {
+                Object.setPrototypeOf(component, ReloadedClass.prototype);
+                upgradedCount++;
+            }
+        }
+
+        if (upgradedCount > 0)
+        {
+            console.log(`GameObject: ${this.name} upgraded ${upgradedCount} hot-reloaded component(s)`);
+        }
+        return upgradedCount;
+    }
+
     /**
      * Set GameObject active state
      * @param {boolean} active - Active state
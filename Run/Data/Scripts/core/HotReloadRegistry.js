@@ -28,6 +28,8 @@ class HotReloadRegistry {
         if (!globalThis.__hotReload) {
             globalThis.__hotReload = {
                 version: 1,
+                engineEpoch: 0,          // Bumped when globalThis.JSEngine is replaced (C++ re-binds update/render)
+                generation: 0,           // Bumped by every register() (JSGame upgrades components only then)
                 classes: new Map(),      // className → {class, version, timestamp}
                 instances: new WeakMap(), // instance → metadata
                 modules: new Map(),      // modulePath → {exports, version, timestamp}
@@ -42,6 +44,26 @@ class HotReloadRegistry {
         this.registry = globalThis.__hotReload;
     }
 
+    /**
+     * Signal C++ that globalThis.JSEngine was (re)assigned
+     * Game.cpp caches JSEngine.update/render as persistent function handles and only
+     * re-resolves them when this epoch changes
+     * @returns {number} New engine epoch
+     */
+    bumpEngineEpoch() {
+        this.registry.engineEpoch = (this.registry.engineEpoch || 0) + 1;
+        return this.registry.engineEpoch;
+    }
+
+    /**
+     * Registration generation - changes whenever any class is (re)registered
+     * JSGame compares it once per frame instead of walking every GameObject's components
+     * @returns {number} Current generation
+     */
+    getGeneration() {
+        return this.registry.generation || 0;
+    }
+
     /**
      * Register a class for hot-reload tracking
      * @param {string} className - Unique class name
@@ -60,7 +82,11 @@ class HotReloadRegistry {
             parentClass: options.parentClass || null
         });
 
+        this.registry.generation = (this.registry.generation || 0) + 1;
         this.registry.stats.registrations++;
+        if (existing) {
+            this.registry.stats.reloads++;
+        }
 
         console.log(`HotReloadRegistry: Registered '${className}' (v${version})`);
     }
@@ -129,7 +129,13 @@ export class DevelopmentToolHandler
                 await this.handleRunScriptTest(requestId, parsedArgs);
                 break;
             case 'get_entity_list':
-                await this.handleGetEntityList(requestId);
+                await this.handleGetEntityList(requestId, parsedArgs);
+                break;
+            case 'query_entities_radius':
+                await this.handleQueryEntitiesRadius(requestId, parsedArgs);
+                break;
+            case 'raycast_entities':
+                await this.handleRaycastEntities(requestId, parsedArgs);
                 break;
             case 'get_engine_metrics':
                 await this.handleGetEngineMetrics(requestId);
@@ -444,6 +450,10 @@ export class DevelopmentToolHandler
         {
             payload.filename = args.filename;
         }
+        if (args.keepFile === false)
+        {
+            payload.keepFile = false;
+        }
 
         const resultObj = await this._submitCommand('game.capture_screenshot', payload);
 
@@ -1057,9 +1067,53 @@ export class DevelopmentToolHandler
         kadi.sendToolResult(requestId, JSON.stringify(resultObj));
     }
 
-    async handleGetEntityList(requestId)
+    async handleGetEntityList(requestId, args = {})
     {
-        const resultObj = await this._submitCommand('game.get_entity_list', {});
+        args = args || {};
+        const payload = {};
+        if (args.sinceVersion !== undefined) payload.sinceVersion = args.sinceVersion;
+        if (args.cursor) payload.cursor = args.cursor;
+        if (args.limit !== undefined) payload.limit = args.limit;
+        if (Array.isArray(args.fields)) payload.fields = args.fields;
+        if (args.encoding) payload.encoding = args.encoding;
+
+        const resultObj = await this._submitCommand('game.get_entity_list', payload);
+        kadi.sendToolResult(requestId, JSON.stringify(resultObj));
+    }
+
+    async handleQueryEntitiesRadius(requestId, args)
+    {
+        if (!Array.isArray(args.center) || args.center.length !== 3)
+        {
+            this.sendError(requestId, 'Invalid center: must be [x, y, z]');
+            return;
+        }
+
+        const payload = { center: args.center };
+        if (args.radius !== undefined) payload.radius = args.radius;
+        if (args.limit !== undefined) payload.limit = args.limit;
+
+        const resultObj = await this._submitCommand('game.query_entities_radius', payload);
+        kadi.sendToolResult(requestId, JSON.stringify(resultObj));
+    }
+
+    async handleRaycastEntities(requestId, args)
+    {
+        if (!Array.isArray(args.origin) || args.origin.length !== 3)
+        {
+            this.sendError(requestId, 'Invalid origin: must be [x, y, z]');
+            return;
+        }
+        if (!Array.isArray(args.direction) || args.direction.length !== 3)
+        {
+            this.sendError(requestId, 'Invalid direction: must be [x, y, z]');
+            return;
+        }
+
+        const payload = { origin: args.origin, direction: args.direction };
+        if (args.maxDistance !== undefined) payload.maxDistance = args.maxDistance;
+
+        const resultObj = await this._submitCommand('game.raycast_entities', payload);
         kadi.sendToolResult(requestId, JSON.stringify(resultObj));
     }
 
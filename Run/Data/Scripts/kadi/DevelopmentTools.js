@@ -217,6 +217,11 @@ export const DevelopmentTools = [
                 filename: {
                     type: "string",
                     description: "Optional filename (without extension). If omitted, auto-generates timestamp-based name"
+                },
+                keepFile: {
+                    type: "boolean",
+                    default: true,
+                    description: "Keep the file in Screenshots/ after encoding (default: true). false returns the image only"
                 }
             },
             required: []
@@ -329,13 +334,100 @@ export const DevelopmentTools = [
     },
     {
         name: "get_entity_list",
-        description: "Enumerate all active entities in the game scene with their ID, mesh type, position, orientation, scale, color, and camera type. Reads from the C++ EntityStateBuffer (authoritative render state).",
+        description: "Enumerate active entities in the game scene with their ID, change version, mesh type, position, orientation, scale, color, and camera type. Reads from the C++ EntityStore (authoritative render state). Results are versioned pages: call with sinceVersion 0 for a full snapshot, follow 'cursor' while 'hasMore' is true, then poll with sinceVersion set to the returned 'version' to get only changed entities plus 'removed' IDs. If 'isFullSnapshot' comes back true for a delta request, the delta was no longer available: rebuild from the page.",
         inputSchema: {
             type: "object",
-            properties: {},
+            properties: {
+                sinceVersion: {
+                    type: "integer",
+                    minimum: 0,
+                    default: 0,
+                    description: "Only entities changed or removed after this version (0 = full snapshot)"
+                },
+                cursor: {
+                    type: "string",
+                    description: "Continue a paged result: the 'cursor' returned by the previous page (same sinceVersion)"
+                },
+                limit: {
+                    type: "integer",
+                    minimum: 1,
+                    default: 1000,
+                    description: "Maximum entities plus removals per page (default: 1000)"
+                },
+                fields: {
+                    type: "array",
+                    items: { type: "string", enum: ["position", "orientation", "scale", "color", "type", "cameraType"] },
+                    description: "Fields to include besides entityId and version (default: all)"
+                },
+                encoding: {
+                    type: "string",
+                    enum: ["json", "binary"],
+                    default: "json",
+                    description: "'binary' returns entities and removals as base64 little-endian records in 'data' (layout in EntitySnapshot.hpp)"
+                }
+            },
             required: []
         }
     },
+    {
+        name: "query_entities_radius",
+        description: "Find active entities whose bounding sphere overlaps a sphere. Uses the C++ entity spatial grid, so cost scales with nearby entities rather than scene size. Returns entity ID, mesh type, position, and distance from the center.",
+        inputSchema: {
+            type: "object",
+            properties: {
+                center: {
+                    type: "array",
+                    items: { type: "number" },
+                    minItems: 3,
+                    maxItems: 3,
+                    description: "Query center [x, y, z] in world space"
+                },
+                radius: {
+                    type: "number",
+                    minimum: 0,
+                    default: 10,
+                    description: "Query radius in world units (default: 10)"
+                },
+                limit: {
+                    type: "integer",
+                    minimum: 1,
+                    default: 1000,
+                    description: "Maximum entities returned (default: 1000)"
+                }
+            },
+            required: ["center"]
+        }
+    },
+    {
+        name: "raycast_entities",
+        description: "Cast a ray against entity bounding spheres and return the nearest hit (entity ID, mesh type, distance, hit point). Uses the C++ entity spatial grid.",
+        inputSchema: {
+            type: "object",
+            properties: {
+                origin: {
+                    type: "array",
+                    items: { type: "number" },
+                    minItems: 3,
+                    maxItems: 3,
+                    description: "Ray origin [x, y, z] in world space"
+                },
+                direction: {
+                    type: "array",
+                    items: { type: "number" },
+                    minItems: 3,
+                    maxItems: 3,
+                    description: "Ray direction [x, y, z] (normalized by the engine)"
+                },
+                maxDistance: {
+                    type: "number",
+                    minimum: 0,
+                    default: 1000,
+                    description: "Maximum hit distance (default: 1000)"
+                }
+            },
+            required: ["origin", "direction"]
+        }
+    },
     {
         name: "get_engine_metrics",
         description: "Get current engine performance metrics: FPS, entity count, process memory usage (MB), and total frame count.",
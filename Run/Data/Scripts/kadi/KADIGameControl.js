@@ -11,6 +11,7 @@ import {BuildToolHandler} from './BuildToolHandler.js';
 import {CommandQueue} from '../Interface/CommandQueue.js';
 import {DevelopmentTools} from './DevelopmentTools.js';
 import {BuildTools} from './BuildTools.js';
+import {hotReloadRegistry} from '../Core/HotReloadRegistry.js';
 
 /**
  * KADIGameControl - Subsystem for KADI game control integration
@@ -292,4 +293,10 @@ export class KADIGameControl extends Subsystem
 // Export for hot-reload
 globalThis.KADIGameControl = KADIGameControl;
 
+// Reload boundary: JSEngine upgrades the live system from HotReloadRegistry
+hotReloadRegistry.register('KADIGameControl', KADIGameControl, {
+    modulePath: './kadi/KADIGameControl.js',
+    parentClass: 'Subsystem'
+});
+
 console.log('KADIGameControl: Subsystem module loaded');
@@ -24,6 +24,7 @@ import './InputSystemCommon.js'; // Global key code constants
 import { JSEngine } from './JSEngine.js';
 import { JSGame } from './JSGame.js';
 import { CommandQueue } from './Interface/CommandQueue.js';  // GenericCommand facade
+import { hotReloadRegistry } from './core/HotReloadRegistry.js';
 
 console.log('(main.js)(start) - JavaScript Framework Entry Point');
 
@@ -80,6 +81,9 @@ jsEngineInstance.setGame(jsGameInstance);
 // REQUIRED: C++ calls JSEngine.update() and JSEngine.render() through globalThis
 globalThis.JSEngine = jsEngineInstance;
 
+// REQUIRED: C++ caches JSEngine.update/render handles - bump the epoch so they are re-bound
+hotReloadRegistry.bumpEngineEpoch();
+
 // REQUIRED: Hot-reload system needs global reference to JSGame instance
 globalThis.jsGameInstance = jsGameInstance;
 